@@ -1,7 +1,7 @@
 // Apps/DemoApp/UltraCanvasLayoutExamples.cpp
 // Layout system demonstration examples for UltraCanvas Demo Application
-// Version: 2.0.0
-// Last Modified: 2026-06-01
+// Version: 2.2.0
+// Last Modified: 2026-10-18
 // Author: UltraCanvas Framework
 
 #include "UltraCanvasDemo.h"
@@ -38,6 +38,12 @@ namespace UltraCanvas {
 
     // Provided by UltraCanvasLabelPlacementExamples.cpp
     std::shared_ptr<UltraCanvasUIElement> CreateLabelPlacementLayoutTab();
+    // Provided by UltraCanvasLayerCacheExamples.cpp
+    std::shared_ptr<UltraCanvasUIElement> CreateLayerCacheLayoutTab();
+    // Provided by UltraCanvasTiledRasterExamples.cpp
+    std::shared_ptr<UltraCanvasUIElement> CreateTiledRasterLayoutTab();
+    // Provided by UltraCanvasFrameProfilerExamples.cpp
+    std::shared_ptr<UltraCanvasUIElement> CreateFrameProfilerLayoutTab();
 
     static std::shared_ptr<UltraCanvasUIElement> CreateBoxGridFlexLayoutTab() {
         auto mainContainer = std::make_shared<UltraCanvasContainer>("LayoutExamples", 0, 0, 1020, 1670);
@@ -330,6 +336,9 @@ namespace UltraCanvas {
         tabs->SetTabStyle(TabStyle::Modern);
         tabs->AddTab("Box / Grid / Flex", CreateBoxGridFlexLayoutTab());
         tabs->AddTab("Label placement", CreateLabelPlacementLayoutTab());
+        tabs->AddTab("Layer caching", CreateLayerCacheLayoutTab());
+        tabs->AddTab("Tiled rasterization", CreateTiledRasterLayoutTab());
+        tabs->AddTab("Frame profiler", CreateFrameProfilerLayoutTab());
         return tabs;
     }
 
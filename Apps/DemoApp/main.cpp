@@ -1,6 +1,6 @@
 // UltraCanvas Framework Demonstration Program Entry Point
-// Version: 1.0.0
-// Last Modified: 2024-12-19
+// Version: 1.1.0
+// Last Modified: 2026-10-18
 // Author: UltraCanvas Framework
 
 #include <iostream>
@@ -9,6 +9,8 @@
 #include <string>
 #include <thread>
 #include <chrono>
+#include <cstdlib>
+#include <algorithm>
 
 // UltraCanvas Core Headers
 #include "UltraCanvasDemo.h"
@@ -65,6 +67,43 @@ void SignalHandler(int signal) {
 }
 #endif
 
+// ===== PRESENTATION BENCHMARK =====
+#ifdef __linux__
+// --present-bench N: repaint the main window N times in full and N times in a
+// 256 px square, waiting for the X server after every frame, and print the
+// cost of the presentation path chosen with ULTRACANVAS_X11_PRESENT
+// (xlib | putimage | shm). Meant for side-by-side runs under Xvfb.
+static void RunPresentBenchmark(UltraCanvasApplication& app, int frames) {
+    if (app.GetWindows().empty() || frames <= 0) return;
+    auto* window = dynamic_cast<UltraCanvasWindow*>(app.GetWindows().front().get());
+    if (!window) return;
+
+    const int w = static_cast<int>(window->GetWidth());
+    const int h = static_cast<int>(window->GetHeight());
+    auto timeFrames = [&](auto dirtyForFrame) {
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < frames; i++) {
+            window->AddDirtyRectangle(dirtyForFrame(i));
+            window->UpdateAndRender();
+            XSync(app.GetDisplay(), False);
+        }
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / frames;
+    };
+
+    const double fullMs = timeFrames([&](int) { return Rect2Di(0, 0, w, h); });
+    const double partialMs = timeFrames([&](int i) {
+        return Rect2Di((i * 37) % std::max(1, w - 256), (i * 23) % std::max(1, h - 256), 256, 256);
+    });
+
+    const X11PresentStats stats = window->GetPresentStats();
+    std::cout << "present-bench mode=" << X11PresentModeName(window->GetPresentMode())
+              << " window=" << w << "x" << h << " frames=" << frames
+              << " full=" << fullMs << "ms partial=" << partialMs << "ms"
+              << " uploaded=" << (stats.bytes / (1024 * 1024)) << "MiB"
+              << " bufferWaits=" << stats.bufferWaits << std::endl;
+}
+#endif
+
 // ===== SYSTEM INITIALIZATION =====
 bool InitializeSystem(UltraCanvasApplication& g_app, const std::string& aName) {
     debugOutput << "=== UltraCanvas Framework Demonstration Program ===" << std::endl;
@@ -139,6 +178,7 @@ int main(int argc, char* argv[]) {
         bool verboseMode = false;
         bool testMode = false;
         std::string startupComponent = "";
+        int presentBenchFrames = 0;
 
         for (int i = 1; i < argc; i++) {
             std::string arg = argv[i];
@@ -154,6 +194,10 @@ int main(int argc, char* argv[]) {
                     startupComponent = argv[++i];
                     debugOutput << "Startup component: " << startupComponent << std::endl;
                 }
+            } else if (arg == "--present-bench") {
+                if (i + 1 < argc) {
+                    presentBenchFrames = std::atoi(argv[++i]);
+                }
             } else if (arg == "--help" || arg == "-h") {
                 debugOutput << "UltraCanvas Demo Application" << std::endl;
                 debugOutput << "Usage: " << argv[0] << " [options]" << std::endl;
@@ -161,6 +205,7 @@ int main(int argc, char* argv[]) {
                 debugOutput << "  -v, --verbose     Enable verbose output" << std::endl;
                 debugOutput << "  -t, --test        Run in test mode" << std::endl;
                 debugOutput << "  -c, --component   Start with specific component selected" << std::endl;
+                debugOutput << "  --present-bench N Time N full and N partial repaints, print, exit (Linux)" << std::endl;
                 debugOutput << "  -h, --help        Show this help message" << std::endl;
                 return 0;
             } else {
@@ -195,6 +240,16 @@ int main(int argc, char* argv[]) {
             g_demoApp->DisplayDemoItem(startupComponent);
         }
 
+#ifdef __linux__
+        if (presentBenchFrames > 0) {
+            // Give the window time to map before timing it.
+            g_app.StartTimer(500, false, [&g_app, presentBenchFrames](TimerId) {
+                RunPresentBenchmark(g_app, presentBenchFrames);
+                g_app.RequestExit();
+            });
+        }
+#endif
+
         debugOutput << std::endl;
         debugOutput << "=== Demo Application Ready ===" << std::endl;
         debugOutput << "Instructions:" << std::endl;
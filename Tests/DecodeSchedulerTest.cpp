@@ -0,0 +1,275 @@
+// Tests/DecodeSchedulerTest.cpp
+// Unit tests for the decode service's scheduler with a stub decode:
+// priority and touch ordering, de-duplication by key, cancellation,
+// off-screen cancellation, one job per resource at a time, and that a
+// request is never dropped just for not having been drawn lately.
+// Version: 1.0.0
+// Last Modified: 2026-10-18
+// Author: UltraCanvas Framework
+
+#include "UltraCanvasDecodeScheduler.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace UltraCanvas;
+
+static int failures = 0;
+static int checks = 0;
+
+#define CHECK(cond) do { \
+    ++checks; \
+    if (!(cond)) { \
+        ++failures; \
+        std::printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+    } \
+} while (0)
+
+enum class StubStatus { Ready, Failed, Cancelled };
+
+struct StubResult {
+    StubStatus status = StubStatus::Failed;
+    std::string value;
+};
+
+using Scheduler = UCDecodeScheduler<StubResult>;
+
+// What the stub decodes ran and what the callbacks saw, in order.
+struct Log {
+    std::mutex mutex;
+    std::condition_variable cond;
+    std::vector<std::string> decoded;
+    std::vector<std::string> delivered;
+
+    void Decoded(const std::string& what) {
+        std::lock_guard<std::mutex> lk(mutex);
+        decoded.push_back(what);
+    }
+    Scheduler::Callback Deliver(const std::string& who) {
+        return [this, who](const StubResult& r) {
+            std::lock_guard<std::mutex> lk(mutex);
+            delivered.push_back(who + (r.status == StubStatus::Cancelled ? ":cancelled"
+                                                                         : ":" + r.value));
+            cond.notify_all();
+        };
+    }
+    bool WaitDelivered(size_t count) {
+        std::unique_lock<std::mutex> lk(mutex);
+        return cond.wait_for(lk, std::chrono::seconds(30),
+                             [&] { return delivered.size() >= count; });
+    }
+};
+
+// Holds the single worker inside a job until released, so everything
+// submitted meanwhile is queued and ordered by the scheduler alone.
+struct Gate {
+    std::mutex mutex;
+    std::condition_variable cond;
+    bool entered = false;
+    bool open = false;
+
+    Scheduler::Work Work() {
+        return [this]() {
+            std::unique_lock<std::mutex> lk(mutex);
+            entered = true;
+            cond.notify_all();
+            cond.wait(lk, [this] { return open; });
+            return StubResult{StubStatus::Ready, "gate"};
+        };
+    }
+    void WaitEntered() {
+        std::unique_lock<std::mutex> lk(mutex);
+        cond.wait(lk, [this] { return entered; });
+    }
+    void Open() {
+        std::lock_guard<std::mutex> lk(mutex);
+        open = true;
+        cond.notify_all();
+    }
+};
+
+static Scheduler::Work Stub(Log& log, const std::string& value, bool ok = true) {
+    return [&log, value, ok]() {
+        log.Decoded(value);
+        return StubResult{ok ? StubStatus::Ready : StubStatus::Failed, value};
+    };
+}
+
+static std::unique_ptr<Scheduler> MakeScheduler(int workers) {
+    auto s = std::make_unique<Scheduler>(
+            StubResult{StubStatus::Cancelled, {}},
+            [](const StubResult& r) { return r.status == StubStatus::Ready; },
+            nullptr);
+    s->SetWorkerCount(workers);
+    return s;
+}
+
+static void TestPriorityOrder() {
+    Log log;
+    Gate gate;
+    auto sched = MakeScheduler(1);
+    sched->Submit("gate", "gate", 0, gate.Work(), nullptr);
+    gate.WaitEntered();
+
+    sched->Submit("bg", "bg", 2, Stub(log, "bg"), log.Deliver("bg"));
+    sched->Submit("pre", "pre", 1, Stub(log, "pre"), log.Deliver("pre"));
+    sched->Submit("vis1", "vis1", 0, Stub(log, "vis1"), log.Deliver("vis1"));
+    auto vis2 = sched->Submit("vis2", "vis2", 0, Stub(log, "vis2"), log.Deliver("vis2"));
+    auto late = sched->Submit("late", "late", 2, Stub(log, "late"), log.Deliver("late"));
+    // Within a class the most recent draw (a submit counts) goes first:
+    // vis2, drawn again last, then late, raised to Visible after vis1 was
+    // submitted, then vis1 — all ahead of the Prefetch and Background jobs.
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    sched->SetPriority(late, 0);
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    sched->Touch(vis2);
+
+    gate.Open();
+    CHECK(log.WaitDelivered(5));
+    CHECK((log.decoded == std::vector<std::string>{"vis2", "late", "vis1", "pre", "bg"}));
+}
+
+static void TestDeduplication() {
+    Log log;
+    Gate gate;
+    auto sched = MakeScheduler(1);
+    sched->Submit("gate", "gate", 0, gate.Work(), nullptr);
+    gate.WaitEntered();
+
+    // Same key: one decode, both requesters answered.
+    sched->Submit("photo?w:100h:100", "photo", 2, Stub(log, "first"), log.Deliver("a"));
+    sched->Submit("photo?w:100h:100", "photo", 0, Stub(log, "second"), log.Deliver("b"));
+    // Another size of the same file is its own job.
+    sched->Submit("photo?w:200h:200", "photo", 1, Stub(log, "other"), log.Deliver("c"));
+
+    gate.Open();
+    CHECK(log.WaitDelivered(3));
+    // The joined job took the more urgent class and ran first, once.
+    CHECK((log.decoded == std::vector<std::string>{"first", "other"}));
+    CHECK((log.delivered == std::vector<std::string>{"a:first", "b:first", "c:other"}));
+    auto stats = sched->GetStats();
+    CHECK(stats.requested == 4);
+    CHECK(stats.shared == 1);
+    CHECK(stats.decoded == 3);
+}
+
+static void TestCancel() {
+    Log log;
+    Gate gate;
+    auto sched = MakeScheduler(1);
+    sched->Submit("gate", "gate", 0, gate.Work(), nullptr);
+    gate.WaitEntered();
+
+    auto solo = sched->Submit("solo", "solo", 0, Stub(log, "solo"), log.Deliver("solo"));
+    auto a = sched->Submit("shared", "shared", 0, Stub(log, "shared"), log.Deliver("a"));
+    sched->Submit("shared", "shared", 0, Stub(log, "shared"), log.Deliver("b"));
+    sched->Submit("last", "last", 1, Stub(log, "last", false), log.Deliver("last"));
+    sched->Cancel(solo);
+    sched->Cancel(a);
+    sched->Cancel(a);                               // twice: harmless
+    sched->Cancel(Scheduler::InvalidTicket);
+
+    gate.Open();
+    CHECK(log.WaitDelivered(2));
+    // The cancelled job never ran; the shared one ran for its other waiter.
+    CHECK((log.decoded == std::vector<std::string>{"shared", "last"}));
+    CHECK((log.delivered == std::vector<std::string>{"b:shared", "last:last"}));
+    auto stats = sched->GetStats();
+    CHECK(stats.cancelled == 1);
+    CHECK(stats.failed == 1);
+    CHECK(stats.queued == 0 && stats.running == 0);
+
+    sched->Shutdown();
+    CHECK(sched->Submit("after", "after", 0, Stub(log, "after"), log.Deliver("after")) ==
+          Scheduler::InvalidTicket);
+}
+
+static void TestCancelOffscreen() {
+    Log log;
+    Gate gate;
+    auto sched = MakeScheduler(1);
+    sched->Submit("gate", "gate", 0, gate.Work(), nullptr);
+    gate.WaitEntered();
+
+    bool leftVisible = true;
+    bool rightVisible = true;
+    int asked = 0;
+    sched->Submit("left", "left", 0, Stub(log, "left"), log.Deliver("left"),
+                  [&] { ++asked; return leftVisible; });
+    sched->Submit("right", "right", 0, Stub(log, "right"), log.Deliver("right"),
+                  [&] { ++asked; return rightVisible; });
+    sched->Submit("nocheck", "nocheck", 0, Stub(log, "nocheck"), log.Deliver("nocheck"));
+
+    // Everything still on screen: nothing happens.
+    sched->CancelOffscreen();
+    CHECK(asked == 2);
+    CHECK(log.delivered.empty());
+
+    // The right element scrolled away: cancelled at once, on this thread.
+    rightVisible = false;
+    sched->CancelOffscreen();
+    CHECK((log.delivered == std::vector<std::string>{"right:cancelled"}));
+    CHECK(sched->GetStats().offscreen == 1);
+    CHECK(sched->GetStats().cancelled == 1);
+
+    gate.Open();
+    CHECK(log.WaitDelivered(3));
+    CHECK((log.decoded == std::vector<std::string>{"nocheck", "left"}));
+}
+
+static void TestOneJobPerResource() {
+    auto sched = MakeScheduler(3);
+    std::atomic<int> inFlight{0};
+    std::atomic<bool> overlapped{false};
+    Log log;
+    for (int i = 0; i < 6; ++i) {
+        const std::string key = "file.png?w:" + std::to_string(i);
+        sched->Submit(key, "file.png", 0, [&]() {
+            if (inFlight.fetch_add(1) != 0) overlapped = true;
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            inFlight.fetch_sub(1);
+            return StubResult{StubStatus::Ready, "ok"};
+        }, log.Deliver(key));
+    }
+    CHECK(log.WaitDelivered(6));
+    CHECK(!overlapped.load());
+}
+
+static void TestNoDropForOldRequests() {
+    // An element outside every dirty rect never draws, so it never touches
+    // its request. Fresh submits elsewhere must not push it out of the queue.
+    Log log;
+    Gate gate;
+    auto sched = MakeScheduler(1);
+    sched->Submit("gate", "gate", 0, gate.Work(), nullptr);
+    gate.WaitEntered();
+
+    sched->Submit("quiet", "quiet", 0, Stub(log, "quiet"), log.Deliver("quiet"));
+    std::this_thread::sleep_for(std::chrono::milliseconds(800));
+    sched->Submit("fresh", "fresh", 0, Stub(log, "fresh"), log.Deliver("fresh"));
+
+    gate.Open();
+    CHECK(log.WaitDelivered(2));
+    CHECK((log.delivered == std::vector<std::string>{"fresh:fresh", "quiet:quiet"}));
+    CHECK(sched->GetStats().cancelled == 0);
+}
+
+int main() {
+    TestPriorityOrder();
+    TestDeduplication();
+    TestCancel();
+    TestCancelOffscreen();
+    TestOneJobPerResource();
+    TestNoDropForOldRequests();
+
+    std::printf("%s: %d checks, %d failures\n",
+                failures == 0 ? "PASS" : "FAIL", checks, failures);
+    return failures == 0 ? 0 : 1;
+}
@@ -1,17 +1,20 @@
 // Tests/DiagramRoutingTest.cpp
 // Unit tests for the shared diagram router: cardinal L/Z routing, the obstacle
 // test, A* pathfinding with turn penalty and side-locked endpoints, label
-// anchoring, arrow angles and multi-edge anchor distribution.
+// anchoring, arrow angles, multi-edge anchor distribution, and the indexed /
+// batch / incremental routing added in 1.1.0.
 //
 // Exercises the real UltraCanvasDiagramRouter with no UI stack and no link
 // dependencies beyond the one source file under test.
 //
-// Version: 1.0.0
-// Last Modified: 2026-07-30
+// Version: 1.1.0
+// Last Modified: 2026-10-18
 // Author: UltraCanvas Framework
 
 #include "Plugins/Diagrams/UltraCanvasDiagramRouting.h"
 
+#include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <cstdio>
 #include <random>
@@ -289,6 +292,249 @@ static void TestRoutingInvariants() {
     CHECK(duplicateFailures == 0, "no duplicated consecutive waypoints");
 }
 
+
+// A flowchart-like scene: `cols` x `rows` boxes on a jittered lattice, and
+// connections between random pairs of nearby boxes, attached at the facing
+// sides. Each request names its own boxes as the obstacles it may enter.
+struct Scene {
+    std::vector<DiagramObstacle> boxes;
+    std::vector<DiagramRouteRequest> requests;
+    DiagramRoutingOptions options;
+};
+
+static DiagramRouteRequest Connect(const std::vector<DiagramObstacle>& boxes, int a, int b) {
+    const Rect2Dd& sa = boxes[a].bounds;
+    const Rect2Dd& sb = boxes[b].bounds;
+    Point2Dd ca(sa.x + sa.width * 0.5, sa.y + sa.height * 0.5);
+    Point2Dd cb(sb.x + sb.width * 0.5, sb.y + sb.height * 0.5);
+    DiagramRouteRequest r;
+    r.sourceSide = UltraCanvasDiagramRouter::GetCardinalSide(ca, cb);
+    r.targetSide = UltraCanvasDiagramRouter::GetCardinalSide(cb, ca);
+    r.start = UltraCanvasDiagramRouter::GetCardinalPoint(sa, r.sourceSide);
+    r.end = UltraCanvasDiagramRouter::GetCardinalPoint(sb, r.targetSide);
+    r.sourceObstacle = a;
+    r.targetObstacle = b;
+    return r;
+}
+
+static Scene MakeScene(int cols, int rows, int edges, unsigned seed) {
+    std::mt19937 rng(seed);
+    Scene scene;
+    for (int y = 0; y < rows; ++y) {
+        for (int x = 0; x < cols; ++x) {
+            scene.boxes.emplace_back(60 + x * 200.0 + rng() % 40, 60 + y * 140.0 + rng() % 30,
+                                     90 + rng() % 50, 50 + rng() % 30);
+        }
+    }
+    scene.options = MakeOptions(cols * 200.0 + 120, rows * 140.0 + 120, 20.0);
+    const int n = cols * rows;
+    for (int e = 0; e < edges; ++e) {
+        int a = static_cast<int>(rng() % n);
+        int dx = static_cast<int>(rng() % 7) - 3, dy = static_cast<int>(rng() % 7) - 3;
+        int bx = std::clamp(a % cols + dx, 0, cols - 1);
+        int by = std::clamp(a / cols + dy, 0, rows - 1);
+        int b = by * cols + bx;
+        if (b == a) b = (a + 1) % n;
+        scene.requests.push_back(Connect(scene.boxes, a, b));
+    }
+    return scene;
+}
+
+// The per-call entry point over the list the request's own boxes filtered out.
+static std::vector<Point2Dd> RoutePerCall(const Scene& scene, const DiagramRouteRequest& r) {
+    std::vector<DiagramObstacle> filtered;
+    filtered.reserve(scene.boxes.size());
+    for (size_t i = 0; i < scene.boxes.size(); ++i) {
+        if (static_cast<int>(i) == r.sourceObstacle || static_cast<int>(i) == r.targetObstacle) continue;
+        filtered.push_back(scene.boxes[i]);
+    }
+    return UltraCanvasDiagramRouter::ComputeOrthogonalPath(
+        r.start, r.end, r.sourceSide, r.targetSide, filtered, scene.options);
+}
+
+static bool SamePath(const std::vector<Point2Dd>& a, const std::vector<Point2Dd>& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].x != b[i].x || a[i].y != b[i].y) return false;
+    }
+    return true;
+}
+
+static void TestIndexMatchesPerCall() {
+    std::printf("Indexed routing matches per-call routing\n");
+
+    int mismatches = 0, astarMismatches = 0, routed = 0, detoured = 0;
+    for (unsigned seed = 1; seed <= 12; ++seed) {
+        Scene scene = MakeScene(8, 6, 60, seed);
+        // Odd padding and inset so the raster is tested off the cell lattice.
+        scene.options.obstaclePaddingCells = 0.37 + 0.05 * seed;
+        scene.options.gridSize = 12.0 + seed;
+        DiagramObstacleIndex index(scene.boxes, scene.options);
+
+        for (const auto& r : scene.requests) {
+            auto expected = RoutePerCall(scene, r);
+            auto actual = UltraCanvasDiagramRouter::ComputeOrthogonalPath(r, index);
+            if (!SamePath(expected, actual)) ++mismatches;
+            if (expected.size() > 4) ++detoured;
+
+            std::vector<DiagramObstacle> filtered;
+            for (size_t i = 0; i < scene.boxes.size(); ++i) {
+                if (static_cast<int>(i) != r.sourceObstacle && static_cast<int>(i) != r.targetObstacle)
+                    filtered.push_back(scene.boxes[i]);
+            }
+            auto a1 = UltraCanvasDiagramRouter::RouteAStar(r.start, r.end, r.sourceSide, r.targetSide,
+                                                           filtered, scene.options);
+            auto a2 = UltraCanvasDiagramRouter::RouteAStar(r, index);
+            if (!SamePath(a1, a2)) ++astarMismatches;
+            ++routed;
+        }
+    }
+    std::printf("  (%d connections, %d routed around obstacles)\n", routed, detoured);
+    CHECK(detoured > 0, "the scenes exercise A*");
+    CHECK(mismatches == 0, "indexed ComputeOrthogonalPath == per-call result");
+    CHECK(astarMismatches == 0, "indexed RouteAStar == per-call RouteAStar");
+}
+
+static void TestBatchRouting() {
+    std::printf("Batch routing\n");
+
+    Scene scene = MakeScene(10, 8, 200, 99);
+    DiagramObstacleIndex index(scene.boxes, scene.options);
+    auto serial = UltraCanvasDiagramRouter::RouteBatch(scene.requests, index, 1);
+    auto parallel = UltraCanvasDiagramRouter::RouteBatch(scene.requests, index, 4);
+
+    bool sameAsSerial = serial.size() == scene.requests.size() && parallel.size() == serial.size();
+    bool sameAsSingle = sameAsSerial;
+    for (size_t i = 0; sameAsSerial && i < serial.size(); ++i) {
+        sameAsSerial = SamePath(serial[i], parallel[i]);
+        sameAsSingle = sameAsSingle &&
+            SamePath(serial[i], UltraCanvasDiagramRouter::ComputeOrthogonalPath(scene.requests[i], index));
+    }
+    CHECK(sameAsSerial, "result does not depend on the thread count");
+    CHECK(sameAsSingle, "batch result == one-at-a-time result");
+    CHECK(UltraCanvasDiagramRouter::RouteBatch({}, index).empty(), "empty batch");
+
+    // Moving an obstacle in the index == rebuilding the index.
+    DiagramObstacleIndex moved = index;
+    Rect2Dd target(scene.boxes[11].bounds.x + 70, scene.boxes[11].bounds.y + 45, 120, 80);
+    moved.UpdateObstacle(11, target);
+    auto boxes = scene.boxes;
+    boxes[11].bounds = target;
+    DiagramObstacleIndex rebuilt(boxes, scene.options);
+    bool sameCells = true;
+    for (int y = 0; y < rebuilt.GridHeight() && sameCells; ++y) {
+        for (int x = 0; x < rebuilt.GridWidth() && sameCells; ++x) {
+            sameCells = moved.IsCellBlocked(x, y) == rebuilt.IsCellBlocked(x, y) &&
+                        moved.IsCellBlocked(x, y, 11) == rebuilt.IsCellBlocked(x, y, 11);
+        }
+    }
+    CHECK(sameCells, "UpdateObstacle == rebuild (cells)");
+    bool sameSegments = true;
+    for (const auto& r : scene.requests) {
+        auto cheap = UltraCanvasDiagramRouter::ComputeCardinalPath(r.start, r.end, r.sourceSide, r.targetSide);
+        sameSegments = sameSegments &&
+            moved.PathHasObstacles(cheap, r.sourceObstacle, r.targetObstacle) ==
+            rebuilt.PathHasObstacles(cheap, r.sourceObstacle, r.targetObstacle);
+    }
+    CHECK(sameSegments, "UpdateObstacle == rebuild (segments)");
+}
+
+static void TestIncrementalRouter() {
+    std::printf("Incremental batch router\n");
+
+    Scene scene = MakeScene(10, 8, 200, 7);
+    DiagramBatchRouter router(scene.options);
+    router.SetObstacles(scene.boxes);
+    router.SetConnections(scene.requests);
+    CHECK(router.Route() == scene.requests.size(), "first Route() routes everything");
+    CHECK(router.Route() == 0, "nothing changed -> nothing re-routed");
+
+    // Drag one box; the app re-anchors that box's connections.
+    const int dragged = 35;
+    Rect2Dd b = scene.boxes[dragged].bounds;
+    b.x += 60;
+    b.y += 40;
+    router.MoveObstacle(dragged, b);
+    scene.boxes[dragged].bounds = b;
+    auto before = router.GetPaths();
+    for (size_t i = 0; i < scene.requests.size(); ++i) {
+        auto& r = scene.requests[i];
+        if (r.sourceObstacle == dragged || r.targetObstacle == dragged) {
+            r = Connect(scene.boxes, r.sourceObstacle, r.targetObstacle);
+            router.SetConnection(i, r);
+        }
+    }
+    size_t rerouted = router.Route();
+    std::printf("  (%zu of %zu connections re-routed)\n", rerouted, scene.requests.size());
+    CHECK(rerouted > 0 && rerouted < scene.requests.size() / 2, "a drag re-routes only nearby connections");
+
+    // Every connection that was re-routed matches a from-scratch route; every
+    // other one kept its path and stays clear of the moved box.
+    DiagramObstacleIndex fresh(scene.boxes, scene.options);
+    bool reroutedMatch = true, othersClear = true;
+    for (size_t i = 0; i < scene.requests.size(); ++i) {
+        const auto& r = scene.requests[i];
+        const auto& path = router.GetPath(i);
+        if (SamePath(path, before[i]) && r.sourceObstacle != dragged && r.targetObstacle != dragged) {
+            std::vector<DiagramObstacle> only{DiagramObstacle(b)};
+            if (UltraCanvasDiagramRouter::PathHasObstacles(path, only, scene.options.obstacleInset)) {
+                othersClear = false;
+            }
+        } else {
+            reroutedMatch = reroutedMatch && SamePath(path, UltraCanvasDiagramRouter::ComputeOrthogonalPath(r, fresh));
+        }
+    }
+    CHECK(reroutedMatch, "re-routed connections == fresh routes");
+    CHECK(othersClear, "kept paths do not cross the moved box");
+
+    router.SetObstacles(scene.boxes);
+    CHECK(router.Route() == scene.requests.size(), "SetObstacles re-routes everything");
+}
+
+static void BenchmarkBatchRouting() {
+    std::printf("Batch routing benchmark\n");
+
+    // ~2k connections over a 1.2k-box chart.
+    Scene scene = MakeScene(40, 30, 2000, 3);
+    using Clock = std::chrono::steady_clock;
+    auto ms = [](Clock::time_point a, Clock::time_point b) {
+        return std::chrono::duration<double, std::milli>(b - a).count();
+    };
+
+    // Per-call routing (filtered copy per connection) on a sample, scaled up.
+    const size_t sample = 100;
+    auto t0 = Clock::now();
+    for (size_t i = 0; i < sample; ++i) RoutePerCall(scene, scene.requests[i]);
+    auto t1 = Clock::now();
+    double perCallEstimate = ms(t0, t1) * scene.requests.size() / sample;
+
+    auto t2 = Clock::now();
+    DiagramObstacleIndex index(scene.boxes, scene.options);
+    auto t3 = Clock::now();
+    auto serial = UltraCanvasDiagramRouter::RouteBatch(scene.requests, index, 1);
+    auto t4 = Clock::now();
+    auto parallel = UltraCanvasDiagramRouter::RouteBatch(scene.requests, index, 0);
+    auto t5 = Clock::now();
+
+    DiagramBatchRouter router(scene.options);
+    router.SetObstacles(scene.boxes);
+    router.SetConnections(scene.requests);
+    router.Route();
+    Rect2Dd b = scene.boxes[615].bounds;
+    b.x += 40;
+    auto t6 = Clock::now();
+    router.MoveObstacle(615, b);
+    size_t rerouted = router.Route();
+    auto t7 = Clock::now();
+
+    std::printf("  %zu connections, %zu boxes: per-call ~%.0f ms; index build %.1f ms, "
+                "batch %.1f ms (1 thread) / %.1f ms (all threads); drag %.2f ms (%zu re-routed)\n",
+                scene.requests.size(), scene.boxes.size(), perCallEstimate, ms(t2, t3),
+                ms(t3, t4), ms(t4, t5), ms(t6, t7), rerouted);
+    CHECK(serial.size() == scene.requests.size() && parallel.size() == serial.size(),
+          "benchmark routed every connection");
+}
+
 // =============================================================================
 
 int main() {
@@ -302,6 +548,10 @@ int main() {
     TestGeometryHelpers();
     TestDistributedAnchors();
     TestRoutingInvariants();
+    TestIndexMatchesPerCall();
+    TestBatchRouting();
+    TestIncrementalRouter();
+    BenchmarkBatchRouting();
 
     std::printf("\n%s (%d failure%s)\n", g_failures == 0 ? "PASSED" : "FAILED",
                 g_failures, g_failures == 1 ? "" : "s");
@@ -0,0 +1,249 @@
+// Tests/EBookSearchIndexTest.cpp
+// Unit tests for EBookSearchIndex: word, prefix and phrase queries, case
+// handling, snippets, substring and CJK queries, parallel builds,
+// persistence and a large-book timing.
+// Version: 1.0.0
+// Last Modified: 2026-10-18
+// Author: UltraCanvas Framework
+
+#include "EBookSearchIndex.h"
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace UltraCanvas;
+namespace fs = std::filesystem;
+
+static int failures = 0;
+static int checks = 0;
+
+#define CHECK(cond) do { \
+    ++checks; \
+    if (!(cond)) { \
+        ++failures; \
+        std::printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+    } \
+} while (0)
+
+static const std::vector<std::string> kChapters = {
+    "The quick brown fox jumps over the lazy dog.",
+    "Lazy, dogged days. The DOG sleeps; the lazy dog dreams.",
+    "Caf\xC3\xA9 au lait \xE2\x80\x94 d\xC3\xA9j\xC3\xA0 vu at the caf\xC3\xA9.",
+};
+
+static EBookSearchIndex BuildSample(unsigned threads = 0) {
+    EBookSearchIndex index;
+    index.Build(static_cast<int>(kChapters.size()),
+                [](int i) { return kChapters[static_cast<size_t>(i)]; }, threads);
+    return index;
+}
+
+static void TestWordsAndPhrases() {
+    EBookSearchIndex index = BuildSample();
+    CHECK(index.IsBuilt());
+    CHECK(index.GetChapterCount() == 3);
+
+    // Case-folded phrase; punctuation between words is ignored. The last
+    // word matches as a prefix, so "dogged" counts too.
+    auto r = index.Search("LAZY DOG");
+    CHECK(r.size() == 3);
+    if (r.size() == 3) {
+        CHECK(r[0].chapterIndex == 0 && r[0].matchedText == "lazy dog");
+        CHECK(r[1].chapterIndex == 1 && r[1].matchedText == "Lazy, dog");
+        CHECK(r[1].offsetInPage == 0);
+        CHECK(r[2].chapterIndex == 1 && r[2].matchedText == "lazy dog");
+        CHECK(r[0].contextBefore == "The quick brown fox jumps over the ");
+        CHECK(r[0].contextAfter == ".");
+    }
+
+    // Quoted: exact words only.
+    r = index.Search("\"lazy dog\"");
+    CHECK(r.size() == 2);
+
+    // Explicit prefixes on any word.
+    r = index.Search("qu* bro*");
+    CHECK(r.size() == 1 && r[0].matchedText == "quick bro");
+    CHECK(index.Search("\"qu brown\"").empty());
+
+    // Single words, in reading order across chapters.
+    r = index.Search("\"dog\"");
+    CHECK(r.size() == 3);
+    if (r.size() == 3) CHECK(r[1].matchedText == "DOG");
+
+    CHECK(index.Search("cat").empty());
+    CHECK(index.Search("").empty());
+    CHECK(index.Search("  ,.; ").empty());
+    CHECK(index.Search("the", false, 2).size() == 2);
+}
+
+static void TestCaseSensitive() {
+    EBookSearchIndex index = BuildSample();
+    CHECK(index.Search("LAZY DOG", true).empty());
+    CHECK(index.Search("lazy dog", true).size() == 2);
+    auto r = index.Search("\"DOG\"", true);
+    CHECK(r.size() == 1 && r[0].chapterIndex == 1);
+}
+
+static void TestUtf8() {
+    EBookSearchIndex index = BuildSample();
+    auto r = index.Search("caf\xC3\xA9");
+    CHECK(r.size() == 2);
+    r = index.Search("d\xC3\xA9j\xC3\xA0 vu");
+    CHECK(r.size() == 1);
+
+    // Snippets never split a multi-byte character.
+    std::string text(kChapters[2]);
+    for (int i = 0; i < 40; ++i) text = "\xC3\xA9" + text;
+    EBookSearchIndex wide;
+    wide.Build(1, [&](int) { return text; });
+    r = wide.Search("\"lait\"");
+    CHECK(r.size() == 1);
+    if (r.size() == 1) {
+        const unsigned char lead = static_cast<unsigned char>(r[0].contextBefore.front());
+        CHECK((lead & 0xC0) != 0x80);
+        CHECK(r[0].contextBefore.size() <= EBookSearchIndex::kSnippetContext);
+    }
+}
+
+static void TestSubstringAndCJK() {
+    // Unquoted queries find what a plain substring search finds; CJK text
+    // has no spaces, so its terms sit mid-"word".
+    const std::string text =
+        "The running dog was singing. \xE6\x9D\xB1\xE4\xBA\xAC\xE9\x83\xBD\xE3\x81\xAB\xE4\xBD\x8F\xE3\x82\x93\xE3\x81\xA7\xE3\x81\x84\xE3\x81\xBE\xE3\x81\x99\xE3\x80\x82\xE7\xA7\x81\xE3\x81\xAF\xE6\x9D\xB1\xE4\xBA\xAC\xE3\x82\xBF\xE3\x83\xAF\xE3\x83\xBC\xE3\x81\x8C\xE5\xA5\xBD\xE3\x81\x8D\xE3\x81\xA7\xE3\x81\x99\xE3\x80\x82";
+    EBookSearchIndex index;
+    index.Build(1, [&](int) { return text; });
+
+    auto r = index.Search("ing");
+    CHECK(r.size() == 3);                   // running, sing+ing
+    for (const auto& m : r) CHECK(m.matchedText == "ing");
+    r = index.Search("ning dog");
+    CHECK(r.size() == 1 && r[0].matchedText == "ning dog");
+    CHECK(index.Search("ning cat").empty());
+    CHECK(index.Search("\"ing\"").empty());
+    CHECK(index.Search("Running", true).empty());
+    CHECK(index.Search("running", true).size() == 1);
+
+    r = index.Search("\xE6\x9D\xB1\xE4\xBA\xAC");    // Tokyo: in Tokyo-to and Tokyo Tower
+    CHECK(r.size() == 2);
+    if (r.size() == 2) {
+        CHECK(r[0].matchedText == "\xE6\x9D\xB1\xE4\xBA\xAC");
+        CHECK(r[0].offsetInPage == static_cast<int>(text.find("\xE6\x9D\xB1\xE4\xBA\xAC")));
+        CHECK(r[1].offsetInPage == static_cast<int>(text.rfind("\xE6\x9D\xB1\xE4\xBA\xAC")));
+    }
+    CHECK(index.Search("\xE4\xBA\xAC\xE9\x83\xBD").size() == 1);     // Kyoto, inside Tokyo-to
+    CHECK(index.Search("\xE4\xBD\x8F\xE3\x82\x93\xE3\x81\xA7").size() == 1);     // "live", mid-sentence
+    CHECK(index.Search("\xE5\xA4\xA7\xE9\x98\xAA").empty());         // Osaka
+}
+
+static void TestParallelBuildMatchesSerial() {
+    std::vector<std::string> book;
+    for (int i = 0; i < 64; ++i) {
+        book.push_back("chapter " + std::to_string(i) + " alpha beta gamma " +
+                       std::to_string(i % 7) + " delta alpha beta");
+    }
+    auto text = [&](int i) { return book[static_cast<size_t>(i)]; };
+    EBookSearchIndex serial, parallel;
+    serial.Build(64, text, 1);
+    parallel.Build(64, text, 8);
+    CHECK(serial.GetTermCount() == parallel.GetTermCount());
+    CHECK(serial.GetPostingCount() == parallel.GetPostingCount());
+    auto a = serial.Search("alpha beta", false, 10000);
+    auto b = parallel.Search("alpha beta", false, 10000);
+    CHECK(a.size() == 128 && b.size() == 128);
+    bool same = a.size() == b.size();
+    for (size_t i = 0; same && i < a.size(); ++i) {
+        same = a[i].chapterIndex == b[i].chapterIndex && a[i].offsetInPage == b[i].offsetInPage;
+    }
+    CHECK(same);
+}
+
+static void TestPersistence(const fs::path& work) {
+    EBookSearchIndex index = BuildSample();
+    const std::string path = (work / "sub" / "book.idx").string();
+    CHECK(index.Save(path, "key-1"));
+
+    EBookSearchIndex loaded;
+    CHECK(!loaded.Load(path, "key-2"));
+    CHECK(!loaded.IsBuilt());
+    CHECK(loaded.Load(path, "key-1"));
+    CHECK(loaded.GetTermCount() == index.GetTermCount());
+    auto r = loaded.Search("lazy dog");
+    CHECK(r.size() == 3);
+    if (!r.empty()) CHECK(r[0].contextBefore == "The quick brown fox jumps over the ");
+
+    // A truncated file is rejected, not half-loaded.
+    {
+        std::ifstream in(path, std::ios::binary);
+        std::string data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(data.data(), static_cast<std::streamsize>(data.size() - 5));
+    }
+    CHECK(!loaded.Load(path, "key-1"));
+    CHECK(!loaded.IsBuilt());
+    CHECK(!loaded.Load((work / "missing.idx").string(), "key-1"));
+
+    // Cache location.
+    EBookSearchIndex::SetCacheDirectory(work.string());
+    CHECK(EBookSearchIndex::CachePathFor("abc") == (work / "abc.idx").string());
+    EBookSearchIndex::SetCacheDirectory("");
+    CHECK(EBookSearchIndex::CachePathFor("").empty());
+
+    const uint8_t bytes[] = {1, 2, 3};
+    CHECK(EBookSearchIndex::ContentKey(bytes, 3) == EBookSearchIndex::ContentKey(bytes, 3));
+    CHECK(EBookSearchIndex::ContentKey(bytes, 3) != EBookSearchIndex::ContentKey(bytes, 2));
+}
+
+// Roughly a 3000-page book: searches must stay well inside a frame.
+static void TestLargeBook() {
+    const char* words[] = {"river", "mountain", "silver", "lantern", "harbor", "meadow",
+                           "whisper", "thunder", "garden", "shadow", "ember", "voyage"};
+    std::vector<std::string> book(300);
+    uint32_t seed = 12345;
+    for (auto& chapter : book) {
+        for (int w = 0; w < 5000; ++w) {
+            seed = seed * 1103515245u + 12345u;
+            chapter += words[(seed >> 16) % 12];
+            chapter += (w % 12 == 11) ? ". " : " ";
+        }
+    }
+    EBookSearchIndex index;
+    const auto t0 = std::chrono::steady_clock::now();
+    index.Build(static_cast<int>(book.size()), [&](int i) { return book[static_cast<size_t>(i)]; });
+    const auto t1 = std::chrono::steady_clock::now();
+    auto r = index.Search("silver lantern harbor");
+    auto p = index.Search("sha");
+    const auto t2 = std::chrono::steady_clock::now();
+    CHECK(!r.empty());
+    CHECK(p.size() == EBookSearchIndex::kDefaultMaxResults);
+    const double buildMs = std::chrono::duration<double, std::milli>(t1 - t0).count();
+    const double searchMs = std::chrono::duration<double, std::milli>(t2 - t1).count();
+    std::printf("large book: %zu postings, build %.1f ms, two searches %.2f ms\n",
+                index.GetPostingCount(), buildMs, searchMs);
+    CHECK(searchMs < 250.0);   // generous: sanitizer / debug builds
+}
+
+int main() {
+    const fs::path work = fs::temp_directory_path() /
+            ("uc_ebookindex_" + std::to_string(std::chrono::steady_clock::now()
+                                                   .time_since_epoch().count()));
+    fs::create_directories(work);
+
+    TestWordsAndPhrases();
+    TestCaseSensitive();
+    TestUtf8();
+    TestSubstringAndCJK();
+    TestParallelBuildMatchesSerial();
+    TestPersistence(work);
+    TestLargeBook();
+
+    std::error_code ec;
+    fs::remove_all(work, ec);
+
+    std::printf("%s: %d checks, %d failures\n",
+                failures == 0 ? "PASS" : "FAIL", checks, failures);
+    return failures == 0 ? 0 : 1;
+}
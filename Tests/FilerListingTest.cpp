@@ -0,0 +1,183 @@
+// Tests/FilerListingTest.cpp
+// Unit tests for the filer's listing model: sort order, the folder watch's
+// delta merge (removal, re-stat, binary insertion) and burst coalescing.
+// Version: 1.0.0
+// Last Modified: 2026-10-18
+// Author: UltraCanvas Framework
+
+#include "UltraCanvasFilerListing.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+using namespace UltraCanvas;
+
+static int failures = 0;
+static int checks = 0;
+
+#define CHECK(cond) do { \
+    ++checks; \
+    if (!(cond)) { \
+        ++failures; \
+        std::printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+    } \
+} while (0)
+
+// A fake folder: what restat finds for each path.
+using Folder = std::map<std::string, FilerEntry>;
+
+static FilerEntry Entry(const std::string& name, uint64_t size = 0, bool dir = false) {
+    FilerEntry e;
+    e.name = name;
+    e.path = "/d/" + name;
+    e.size = size;
+    e.isDirectory = dir;
+    return e;
+}
+
+static std::vector<FilerEntry> Listing(const Folder& folder, FilerSortField field,
+                                       bool ascending) {
+    std::vector<FilerEntry> out;
+    for (const auto& [path, e] : folder) out.push_back(e);
+    std::stable_sort(out.begin(), out.end(),
+                     [field, ascending](const FilerEntry& a, const FilerEntry& b) {
+                         return FilerEntrySortsBefore(a, b, field, ascending);
+                     });
+    return out;
+}
+
+static std::vector<std::string> Names(const std::vector<FilerEntry>& entries) {
+    std::vector<std::string> out;
+    for (const FilerEntry& e : entries) out.push_back(e.name);
+    return out;
+}
+
+static FilerRestatFunc Restat(const Folder& folder) {
+    return [&folder](const std::string& path, FilerEntry& out) {
+        auto it = folder.find(path);
+        if (it == folder.end()) return false;
+        out = it->second;
+        return true;
+    };
+}
+
+static void TestSortOrder() {
+    const FilerEntry dir = Entry("zeta", 0, true);
+    const FilerEntry a = Entry("Alpha", 5);
+    const FilerEntry b = Entry("beta", 5);
+    // Folders first in both directions.
+    CHECK(FilerEntrySortsBefore(dir, a, FilerSortField::Name, true));
+    CHECK(FilerEntrySortsBefore(dir, a, FilerSortField::Name, false));
+    // Names compare without case.
+    CHECK(FilerEntrySortsBefore(a, b, FilerSortField::Name, true));
+    CHECK(!FilerEntrySortsBefore(b, a, FilerSortField::Name, true));
+    CHECK(FilerCompareNoCase("ABC", "abc") == 0);
+    CHECK(FilerCompareNoCase("ab", "abc") < 0);
+    // Equal sizes fall back to the name, so the order stays total.
+    CHECK(FilerEntrySortsBefore(a, b, FilerSortField::Size, true));
+    CHECK(FilerEntrySortsBefore(b, a, FilerSortField::Size, false));
+    CHECK(!FilerEntrySortsBefore(a, a, FilerSortField::Size, true));
+}
+
+static void TestMergeMatchesFullSort() {
+    Folder folder;
+    for (const char* name : {"b", "d", "f", "h"})
+        folder["/d/" + std::string(name)] = Entry(name, 10);
+    folder["/d/sub"] = Entry("sub", 0, true);
+
+    for (bool ascending : {true, false}) {
+        std::vector<FilerEntry> entries = Listing(folder, FilerSortField::Name, ascending);
+        Folder after = folder;
+        after.erase("/d/d");                           // deleted
+        after["/d/a"] = Entry("a", 1);                 // created
+        after["/d/z"] = Entry("z", 1);                 // created at the end
+        after["/d/new"] = Entry("new", 0, true);       // a new folder
+        after["/d/f"].size = 99;                       // modified in place
+        const std::unordered_set<std::string> touched = {
+                "/d/d", "/d/a", "/d/z", "/d/new", "/d/f", "/d/gone"};
+
+        size_t inserted = MergeFilerWatchDelta(entries, touched, Restat(after),
+                                               FilerSortField::Name, ascending);
+        CHECK(inserted == 4);
+        CHECK(Names(entries) == Names(Listing(after, FilerSortField::Name, ascending)));
+        auto f = std::find_if(entries.begin(), entries.end(),
+                              [](const FilerEntry& e) { return e.name == "f"; });
+        CHECK(f != entries.end() && f->size == 99);
+    }
+}
+
+static void TestMergeMovesResortedEntry() {
+    // Sorted by size: a file that grows must move, not stay where it was.
+    Folder folder;
+    folder["/d/a"] = Entry("a", 1);
+    folder["/d/b"] = Entry("b", 2);
+    folder["/d/c"] = Entry("c", 3);
+    std::vector<FilerEntry> entries = Listing(folder, FilerSortField::Size, true);
+    folder["/d/a"].size = 10;
+    MergeFilerWatchDelta(entries, {"/d/a"}, Restat(folder), FilerSortField::Size, true);
+    CHECK((Names(entries) == std::vector<std::string>{"b", "c", "a"}));
+
+    // Untouched entries keep their order even when they tie with an insert.
+    folder["/d/x"] = Entry("b", 2);   // same name and size as /d/b
+    folder["/d/x"].path = "/d/x";
+    MergeFilerWatchDelta(entries, {"/d/x"}, Restat(folder), FilerSortField::Size, true);
+    CHECK(entries.size() == 4);
+    CHECK(entries[0].path == "/d/b" && entries[1].path == "/d/x");
+
+    // Touching nothing that restats only removes.
+    MergeFilerWatchDelta(entries, {"/d/c"}, [](const std::string&, FilerEntry&) {
+        return false;
+    }, FilerSortField::Size, true);
+    CHECK((Names(entries) == std::vector<std::string>{"b", "b", "a"}));
+}
+
+static void TestBurst() {
+    using Clock = FilerWatchBurst::Clock;
+    using std::chrono::milliseconds;
+    FilerWatchBurst burst(milliseconds(100), milliseconds(400));
+    const Clock::time_point t0 = Clock::now();
+
+    CHECK(!burst.IsOpen());
+    CHECK(burst.PollTimeoutMs(t0) == -1);
+    CHECK(!burst.TakeDue(t0));
+
+    // Quiet delay: delivered 100 ms after the last event.
+    burst.Touch(t0);
+    CHECK(burst.IsOpen());
+    CHECK(burst.PollTimeoutMs(t0) == 101);
+    CHECK(!burst.TakeDue(t0 + milliseconds(99)));
+    CHECK(burst.TakeDue(t0 + milliseconds(100)));
+    CHECK(!burst.IsOpen());
+    CHECK(!burst.TakeDue(t0 + milliseconds(200)));   // delivered once
+
+    // Events keep the burst open until the latency cap.
+    const Clock::time_point t1 = t0 + milliseconds(1000);
+    for (int ms = 0; ms < 400; ms += 50) {
+        burst.Touch(t1 + milliseconds(ms));
+        CHECK(!burst.TakeDue(t1 + milliseconds(ms)));
+    }
+    burst.Touch(t1 + milliseconds(399));
+    CHECK(burst.PollTimeoutMs(t1 + milliseconds(399)) == 2);
+    CHECK(burst.TakeDue(t1 + milliseconds(400)));
+    CHECK(burst.PollTimeoutMs(t1 + milliseconds(400)) == -1);
+
+    // An overdue burst asks for an immediate wake-up.
+    burst.Touch(t1 + milliseconds(500));
+    CHECK(burst.PollTimeoutMs(t1 + milliseconds(700)) == 0);
+}
+
+int main() {
+    TestSortOrder();
+    TestMergeMatchesFullSort();
+    TestMergeMovesResortedEntry();
+    TestBurst();
+
+    std::printf("%s: %d checks, %d failures\n",
+                failures == 0 ? "PASS" : "FAIL", checks, failures);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,358 @@
+// Tests/ForceLayoutTest.cpp
+// Unit tests for the node-diagram force layout solver: agreement with the
+// all-pairs simulation it replaced, Barnes-Hut accuracy, pinned nodes,
+// convergence, overlap removal, cancellation and a 50k-node benchmark.
+// Version: 1.0.0
+// Last Modified: 2026-10-18
+// Author: UltraCanvas Framework
+
+#include "Plugins/Diagrams/UltraCanvasForceLayout.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using namespace UltraCanvas;
+
+static int failures = 0;
+static int checks = 0;
+
+#define CHECK(cond) do { \
+    ++checks; \
+    if (!(cond)) { \
+        ++failures; \
+        std::printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+    } \
+} while (0)
+
+// Random graph: a spanning tree plus `extraLinks` random edges, 60px nodes
+// scattered over the area.
+static ForceLayoutGraph RandomGraph(size_t n, size_t extraLinks, double area, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> pos(0.0, area);
+    ForceLayoutGraph g;
+    g.Reserve(n, n + extraLinks);
+    for (size_t i = 0; i < n; ++i) g.AddNode(pos(rng), pos(rng), 60.0, 60.0);
+    for (size_t i = 1; i < n; ++i) {
+        g.AddLink(static_cast<uint32_t>(rng() % i), static_cast<uint32_t>(i));
+    }
+    for (size_t e = 0; e < extraLinks; ++e) {
+        g.AddLink(static_cast<uint32_t>(rng() % n), static_cast<uint32_t>(rng() % n));
+    }
+    return g;
+}
+
+// The 2.2.0 simulation loop, kept here as the reference the solver must
+// reproduce when it computes repulsion exactly.
+static void LegacySimulation(ForceLayoutGraph& g, const ForceLayoutOptions& o) {
+    const size_t n = g.Size();
+    std::vector<double> vx(n), vy(n);
+    double centerX = o.width / 2.0, centerY = o.height / 2.0;
+    for (int iter = 0; iter < o.iterations; ++iter) {
+        double t = static_cast<double>(iter) / static_cast<double>(o.iterations);
+        double temperature = 1.0 - 0.95 * t;
+        std::fill(vx.begin(), vx.end(), 0.0);
+        std::fill(vy.begin(), vy.end(), 0.0);
+        for (size_t l = 0; l < g.linkSource.size(); ++l) {
+            uint32_t s = g.linkSource[l], d = g.linkTarget[l];
+            double dx = g.x[d] - g.x[s], dy = g.y[d] - g.y[s];
+            double dist = std::sqrt(dx * dx + dy * dy);
+            if (dist < 0.1) dist = 0.1;
+            double force = (dist - o.linkDistance) * o.linkStrength;
+            if (!g.pinned[s]) { vx[s] += dx / dist * force; vy[s] += dy / dist * force; }
+            if (!g.pinned[d]) { vx[d] -= dx / dist * force; vy[d] -= dy / dist * force; }
+        }
+        for (size_t i = 0; i < n; ++i) {
+            if (g.pinned[i]) continue;
+            for (size_t j = 0; j < n; ++j) {
+                if (i == j) continue;
+                double dx = g.x[j] - g.x[i], dy = g.y[j] - g.y[i];
+                double distSq = dx * dx + dy * dy;
+                if (distSq < 1.0) distSq = 1.0;
+                double force = o.chargeStrength / distSq;
+                double invDist = 1.0 / std::sqrt(distSq);
+                vx[i] += dx * invDist * force;
+                vy[i] += dy * invDist * force;
+            }
+        }
+        for (size_t i = 0; i < n; ++i) {
+            if (g.pinned[i]) continue;
+            vx[i] += (centerX - (g.x[i] + g.w[i] * 0.5)) * o.centerPull;
+            vy[i] += (centerY - (g.y[i] + g.h[i] * 0.5)) * o.centerPull;
+        }
+        for (size_t i = 0; i < n; ++i) {
+            if (g.pinned[i]) continue;
+            double maxStep = 30.0 * temperature + 2.0;
+            g.x[i] = std::clamp(g.x[i] + std::clamp(vx[i], -maxStep, maxStep), 30.0, o.width - 30.0);
+            g.y[i] = std::clamp(g.y[i] + std::clamp(vy[i], -maxStep, maxStep), 30.0, o.height - 30.0);
+        }
+    }
+}
+
+static bool AnyOverlap(const ForceLayoutGraph& g, double margin) {
+    for (size_t i = 0; i < g.Size(); ++i) {
+        for (size_t j = i + 1; j < g.Size(); ++j) {
+            double dx = (g.x[j] + g.w[j] * 0.5) - (g.x[i] + g.w[i] * 0.5);
+            double dy = (g.y[j] + g.h[j] * 0.5) - (g.y[i] + g.h[i] * 0.5);
+            double minDist = std::max(g.w[i], g.h[i]) * 0.5 + std::max(g.w[j], g.h[j]) * 0.5 + margin;
+            if (std::sqrt(dx * dx + dy * dy) < minDist - 1e-6) return true;
+        }
+    }
+    return false;
+}
+
+static void TestEmptyAndSingle() {
+    ForceLayoutSolver empty(ForceLayoutGraph{}, ForceLayoutOptions{});
+    CHECK(empty.Finished());
+    CHECK(!empty.Step());
+    CHECK(empty.Run());
+
+    ForceLayoutGraph g;
+    g.AddNode(0, 0, 60, 60);
+    ForceLayoutSolver one(g, ForceLayoutOptions{});
+    CHECK(one.Run());
+    CHECK(std::isfinite(one.Graph().x[0]) && std::isfinite(one.Graph().y[0]));
+}
+
+static void TestMatchesLegacyLoop() {
+    // Small graphs take the exact path, so the solver must reproduce the old
+    // loop step for step (initial ring included).
+    ForceLayoutGraph g = RandomGraph(24, 10, 800.0, 1);
+    g.pinned[5] = 1;
+    ForceLayoutOptions o;
+    o.convergenceThreshold = 0.0;
+    o.overlapPasses = 0;
+
+    ForceLayoutSolver solver(g, o);
+    ForceLayoutGraph reference = solver.Graph();   // After ring placement
+    CHECK(reference.x[5] == g.x[5] && reference.y[5] == g.y[5]);
+    LegacySimulation(reference, o);
+    CHECK(solver.Run());
+    CHECK(solver.Iteration() == o.iterations);
+
+    double maxDiff = 0.0;
+    for (size_t i = 0; i < g.Size(); ++i) {
+        maxDiff = std::max(maxDiff, std::abs(solver.Graph().x[i] - reference.x[i]));
+        maxDiff = std::max(maxDiff, std::abs(solver.Graph().y[i] - reference.y[i]));
+    }
+    CHECK(maxDiff < 1e-9);
+}
+
+static void TestBarnesHutAccuracy() {
+    // One step from identical positions with repulsion only: each node's
+    // displacement is its repulsion force. Compare it with the all-pairs sum
+    // computed here. The nodes sit well inside the area and boundsMargin is
+    // 0, and the charge keeps every force far below the per-step cap, so no
+    // node is clamped and nothing hides the error.
+    ForceLayoutGraph g = RandomGraph(2000, 500, 4000.0, 2);
+    for (size_t i = 0; i < g.Size(); ++i) {
+        g.x[i] += 1000.0;
+        g.y[i] += 1000.0;
+    }
+    ForceLayoutOptions o;
+    o.width = o.height = 6000.0;
+    o.boundsMargin = 0.0;
+    o.initialPlacement = false;
+    o.iterations = 1;
+    o.overlapPasses = 0;
+    o.linkStrength = 0.0;
+    o.centerPull = 0.0;
+    o.chargeStrength = -2.0;
+
+    const size_t n = g.Size();
+    std::vector<double> ex(n, 0.0), ey(n, 0.0);
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            if (i == j) continue;
+            double dx = g.x[j] - g.x[i], dy = g.y[j] - g.y[i];
+            double distSq = std::max(dx * dx + dy * dy, 1.0);
+            double force = o.chargeStrength / distSq / std::sqrt(distSq);
+            ex[i] += dx * force;
+            ey[i] += dy * force;
+        }
+    }
+
+    // Relative error of the solver's step against the exact forces: summed
+    // over all nodes, and the worst single node (relative to the mean force,
+    // since a node whose forces nearly cancel has no meaningful ratio).
+    auto compare = [&](double theta, double& total, double& worst) {
+        o.theta = theta;
+        ForceLayoutSolver solver(g, o);
+        solver.Step();
+        double errSum = 0.0, forceSum = 0.0, maxErr = 0.0;
+        for (size_t i = 0; i < n; ++i) {
+            double sx = solver.Graph().x[i] - g.x[i];
+            double sy = solver.Graph().y[i] - g.y[i];
+            double err = std::hypot(sx - ex[i], sy - ey[i]);
+            errSum += err;
+            forceSum += std::hypot(ex[i], ey[i]);
+            maxErr = std::max(maxErr, err);
+        }
+        total = errSum / forceSum;
+        worst = maxErr / (forceSum / static_cast<double>(n));
+    };
+
+    double total = 0.0, worst = 0.0;
+    compare(0.0, total, worst);
+    CHECK(total < 1e-9);
+    compare(0.5, total, worst);
+    std::printf("Barnes-Hut theta 0.5: relative force error %.4f total, %.4f worst node\n",
+                total, worst);
+    CHECK(total > 0.0);             // The approximation really ran
+    CHECK(total < 0.005);
+    CHECK(worst < 0.03);
+}
+
+static void TestPinnedNodesStay() {
+    ForceLayoutGraph g = RandomGraph(300, 100, 2000.0, 3);
+    for (size_t i = 0; i < g.Size(); i += 7) g.pinned[i] = 1;
+    ForceLayoutGraph before = g;
+    ForceLayoutOptions o;
+    o.width = o.height = 2000.0;
+    ForceLayoutSolver solver(g, o);
+    solver.Run();
+    bool pinnedStayed = true, othersMoved = false;
+    for (size_t i = 0; i < g.Size(); ++i) {
+        bool same = solver.Graph().x[i] == before.x[i] && solver.Graph().y[i] == before.y[i];
+        if (g.pinned[i] && !same) pinnedStayed = false;
+        if (!g.pinned[i] && !same) othersMoved = true;
+    }
+    CHECK(pinnedStayed);
+    CHECK(othersMoved);
+}
+
+static void TestConvergesEarly() {
+    // Two linked nodes reach their rest distance long before the budget.
+    ForceLayoutGraph g;
+    g.AddNode(100, 300, 40, 40);
+    g.AddNode(700, 300, 40, 40);
+    g.AddLink(0, 1);
+    ForceLayoutOptions o;
+    o.iterations = 5000;
+    ForceLayoutSolver solver(g, o);
+    CHECK(solver.Run());
+    CHECK(solver.Converged());
+    CHECK(solver.Iteration() < o.iterations);
+    CHECK(solver.LastMeanStep() < o.convergenceThreshold);
+
+    // Everything pinned: nothing can move, so the run is over at once.
+    ForceLayoutGraph pinned;
+    pinned.AddNode(10, 10, 40, 40, true);
+    pinned.AddNode(20, 20, 40, 40, true);
+    ForceLayoutSolver frozen(pinned, o);
+    frozen.Run();
+    CHECK(frozen.Iteration() <= 1);
+    CHECK(frozen.Graph().x[0] == 10 && frozen.Graph().x[1] == 20);
+}
+
+static void TestResolveOverlaps() {
+    // A tight block of mixed-size nodes, some exactly on top of each other,
+    // with no simulation steps: the overlap pass alone must pull it apart.
+    ForceLayoutGraph g;
+    for (int row = 0; row < 5; ++row) {
+        for (int col = 0; col < 5; ++col) {
+            double size = (row + col) % 3 == 0 ? 90.0 : 50.0;
+            g.AddNode(900 + col * 35.0, 900 + row * 35.0, size, size);
+        }
+    }
+    for (int i = 0; i < 3; ++i) g.AddNode(1000, 1000, 40, 40);
+    g.pinned[12] = 1;
+    CHECK(AnyOverlap(g, 6.0));
+
+    ForceLayoutOptions o;
+    o.width = o.height = 2000.0;
+    o.initialPlacement = false;
+    o.iterations = 0;
+    o.overlapPasses = 100;
+    ForceLayoutSolver solver(g, o);
+    CHECK(solver.Run());
+    CHECK(!AnyOverlap(solver.Graph(), o.overlapMargin));
+    CHECK(solver.Graph().x[12] == g.x[12] && solver.Graph().y[12] == g.y[12]);
+}
+
+static void TestCancelAndProgress() {
+    ForceLayoutGraph g = RandomGraph(500, 100, 2000.0, 5);
+    ForceLayoutOptions o;
+    o.width = o.height = 2000.0;
+    o.convergenceThreshold = 0.0;
+
+    int calls = 0;
+    ForceLayoutSolver solver(g, o);
+    bool completed = solver.Run(nullptr, [&](const ForceLayoutSolver& s) {
+        ++calls;
+        CHECK(s.Iteration() % 25 == 0);
+        return s.Iteration() < 100;
+    }, 25);
+    CHECK(!completed);
+    CHECK(calls == 4);
+    CHECK(solver.Iteration() == 100);
+
+    std::atomic<bool> cancel{true};
+    ForceLayoutSolver cancelled(g, o);
+    CHECK(!cancelled.Run(&cancel));
+    CHECK(cancelled.Iteration() == 0);
+}
+
+static void BenchmarkLargeGraph() {
+    // The 50k-node target. ULTRACANVAS_BENCH_NODES overrides the size.
+    size_t n = 50000;
+    if (const char* env = std::getenv("ULTRACANVAS_BENCH_NODES")) {
+        n = static_cast<size_t>(std::max(1000L, std::atol(env)));
+    }
+    const int iterations = 20;
+    ForceLayoutGraph g = RandomGraph(n, n / 2, 1.0, 6);
+    ForceLayoutOptions o;
+    o.width = o.height = std::sqrt(static_cast<double>(n)) * o.linkDistance * 0.5;
+    o.iterations = iterations;
+    o.convergenceThreshold = 0.0;
+
+    auto ms = [](auto a, auto b) { return std::chrono::duration<double, std::milli>(b - a).count(); };
+    ForceLayoutSolver solver(g, o);
+    auto t0 = std::chrono::steady_clock::now();
+    while (solver.Step()) {}
+    auto t1 = std::chrono::steady_clock::now();
+    solver.ResolveOverlaps();
+    auto t2 = std::chrono::steady_clock::now();
+
+    // Exact repulsion on a slice of the graph, scaled up quadratically.
+    const size_t sample = 2000;
+    ForceLayoutGraph small = RandomGraph(sample, sample / 2, 1.0, 7);
+    ForceLayoutOptions so = o;
+    so.theta = 0.0;
+    so.iterations = 1;
+    ForceLayoutSolver exact(small, so);
+    auto t3 = std::chrono::steady_clock::now();
+    exact.Step();
+    auto t4 = std::chrono::steady_clock::now();
+    double ratio = static_cast<double>(n) / static_cast<double>(sample);
+
+    bool finite = true;
+    for (size_t i = 0; i < n; ++i) {
+        finite = finite && std::isfinite(solver.Graph().x[i]) && std::isfinite(solver.Graph().y[i]);
+    }
+    std::printf("Force layout over %zu nodes: %.1f ms/iteration (Barnes-Hut, theta %.1f), "
+                "overlap pass %.1f ms; all-pairs estimate %.0f ms/iteration\n",
+                n, ms(t0, t1) / iterations, o.theta, ms(t1, t2), ms(t3, t4) * ratio * ratio);
+    CHECK(solver.Iteration() == iterations);
+    CHECK(finite);
+}
+
+int main() {
+    TestEmptyAndSingle();
+    TestMatchesLegacyLoop();
+    TestBarnesHutAccuracy();
+    TestPinnedNodesStay();
+    TestConvergesEarly();
+    TestResolveOverlaps();
+    TestCancelAndProgress();
+    BenchmarkLargeGraph();
+
+    std::printf("%s: %d checks, %d failures\n",
+                failures == 0 ? "PASS" : "FAIL", checks, failures);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,186 @@
+// Tests/FrameProfilerTest.cpp
+// Unit tests for the frame profiler: scope nesting and self time, draw-call
+// and text-layout attribution, dirty-rect area, the disabled path and the
+// Chrome trace export.
+// Version: 1.0.0
+// Last Modified: 2026-10-18
+// Author: UltraCanvas Framework
+
+#include "UltraCanvasFrameProfiler.h"
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+
+using namespace UltraCanvas;
+
+static int failures = 0;
+static int checks = 0;
+
+#define CHECK(cond) do { \
+    ++checks; \
+    if (!(cond)) { \
+        ++failures; \
+        std::printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+    } \
+} while (0)
+
+static void Spin(int ms) {
+    const auto until = std::chrono::steady_clock::now() + std::chrono::milliseconds(ms);
+    while (std::chrono::steady_clock::now() < until) {}
+}
+
+static const ProfileElementStats* Find(const ProfileFrameStats& frame, const std::string& id) {
+    for (const auto& e : frame.elements) {
+        if (e.id == id) return &e;
+    }
+    return nullptr;
+}
+
+static void TestDisabled() {
+    auto& profiler = UltraCanvasFrameProfiler::GetInstance();
+    profiler.SetEnabled(false);
+    const uint64_t before = profiler.GetFrameCount();
+    {
+        UCProfileFrame frame;
+        const std::string id = "ignored";
+        UCProfileScope scope(ProfileKind::Render, &id, &id);
+    }
+    CHECK(!UltraCanvasFrameProfiler::IsActive());
+    CHECK(profiler.GetFrameCount() == before);
+    CHECK(profiler.GetTraceEventCount() == 0);
+}
+
+static void TestNestingAndSelfTime() {
+    auto& profiler = UltraCanvasFrameProfiler::GetInstance();
+    profiler.SetEnabled(true);
+    const std::string rootId = "root", childId = "child";
+    int root = 0, child = 0;
+    {
+        UCProfileFrame frame;
+        {
+            UCProfileScope arrange(ProfileKind::Arrange, &root, &rootId);
+            UCProfileScope measure(ProfileKind::Measure, &child, &childId);
+            Spin(2);
+        }
+        {
+            UCProfileScope rootScope(ProfileKind::Render, &root, &rootId);
+            UltraCanvasFrameProfiler::CountDrawCall();
+            Spin(4);
+            {
+                UCProfileScope childScope(ProfileKind::Render, &child, &childId);
+                UltraCanvasFrameProfiler::CountDrawCall();
+                UltraCanvasFrameProfiler::CountDrawCall();
+                UltraCanvasFrameProfiler::CountTextLayout(true);
+                UltraCanvasFrameProfiler::CountTextLayout(false);
+                Spin(8);
+            }
+        }
+    }
+
+    const ProfileFrameStats& f = profiler.GetLastFrame();
+    CHECK(f.drawCalls == 3);
+    CHECK(f.textLayoutHits == 1);
+    CHECK(f.textLayoutMisses == 1);
+    CHECK(f.renderMs >= 12.0);
+    CHECK(f.layoutMs >= 2.0);
+    CHECK(f.frameMs >= f.renderMs + f.layoutMs);
+
+    const auto* r = Find(f, rootId);
+    const auto* c = Find(f, childId);
+    CHECK(r && c);
+    if (r && c) {
+        CHECK(r->drawCalls == 1);
+        CHECK(c->drawCalls == 2);
+        CHECK(r->renders == 1 && c->renders == 1);
+        CHECK(r->arranges == 1 && c->measures == 1);
+        // Self time excludes the child; inclusive time does not.
+        CHECK(c->renderMs >= 8.0);
+        CHECK(r->renderMs >= 4.0 && r->renderMs < c->renderMs);
+        CHECK(r->renderTotalMs >= r->renderMs + c->renderMs - 0.01);
+        // Arrange's self time excludes the nested measure.
+        CHECK(r->layoutMs < c->layoutMs);
+        // Most expensive first.
+        CHECK(&f.elements.front() == c);
+    }
+    CHECK(profiler.GetOverlayLines().size() >= 5);
+}
+
+static void TestScopesOutsideFrame() {
+    auto& profiler = UltraCanvasFrameProfiler::GetInstance();
+    profiler.SetEnabled(true);
+    const size_t events = profiler.GetTraceEventCount();
+    const std::string id = "stray";
+    {
+        UCProfileScope scope(ProfileKind::Render, &id, &id);
+    }
+    CHECK(profiler.GetTraceEventCount() == events);
+
+    // Scopes from another thread during a frame are ignored too.
+    {
+        UCProfileFrame frame;
+        std::thread worker([&id]() {
+            UCProfileScope scope(ProfileKind::Render, &id, &id);
+        });
+        worker.join();
+        // A nested frame is not a second frame.
+        const uint64_t count = profiler.GetFrameCount();
+        {
+            UCProfileFrame nested;
+        }
+        CHECK(profiler.GetFrameCount() == count);
+    }
+    CHECK(Find(profiler.GetLastFrame(), id) == nullptr);
+}
+
+static void TestDirtyRects() {
+    auto& profiler = UltraCanvasFrameProfiler::GetInstance();
+    profiler.SetEnabled(true);
+    {
+        UCProfileFrame frame;
+        profiler.AddDirtyRects({Rect2Di(0, 0, 10, 20), Rect2Di(5, 5, 0, 7), Rect2Di(100, 100, 3, 3)});
+    }
+    CHECK(profiler.GetLastFrame().dirtyRects == 2);
+    CHECK(profiler.GetLastFrame().dirtyArea == 209);
+}
+
+static void TestChromeTrace() {
+    auto& profiler = UltraCanvasFrameProfiler::GetInstance();
+    profiler.SetEnabled(true);
+    profiler.ClearTrace();
+    const std::string id = "quote\"back\\slash\nline";
+    {
+        UCProfileFrame frame;
+        UCProfileScope scope(ProfileKind::Render, &id, &id);
+    }
+    CHECK(profiler.GetTraceEventCount() == 2);
+    const std::string json = profiler.ToChromeTraceJson();
+    CHECK(json.rfind("{\"traceEvents\":[", 0) == 0);
+    CHECK(json.find("\"name\":\"quote\\\"back\\\\slash\\nline\"") != std::string::npos);
+    CHECK(json.find("\"cat\":\"render\"") != std::string::npos);
+    CHECK(json.find("\"cat\":\"frame\"") != std::string::npos);
+    CHECK(json.find("\"ph\":\"X\"") != std::string::npos);
+    CHECK(json.find("\"displayTimeUnit\":\"ms\"") != std::string::npos);
+
+    // The trace buffer is bounded: oldest events go first.
+    profiler.SetTraceCapacity(3);
+    for (int i = 0; i < 5; i++) {
+        UCProfileFrame frame;
+    }
+    CHECK(profiler.GetTraceEventCount() == 3);
+    profiler.SetTraceCapacity(UltraCanvasFrameProfiler::kDefaultTraceCapacity);
+    profiler.SetEnabled(false);
+}
+
+int main() {
+    TestDisabled();
+    TestNestingAndSelfTime();
+    TestScopesOutsideFrame();
+    TestDirtyRects();
+    TestChromeTrace();
+
+    std::printf("%s: %d checks, %d failures\n",
+                failures == 0 ? "PASS" : "FAIL", checks, failures);
+    return failures == 0 ? 0 : 1;
+}
@@ -1,23 +1,26 @@
 // Tests/GitGraphLayoutTest.cpp
 // Unit tests for the Git commit-graph layout core: commit ordering, lane
 // assignment under both strategies, merge/octopus handling, multiple roots,
-// swimlane banding and edge routing.
+// swimlane banding and edge routing, plus the incremental (paged) lane layout
+// and a 500k-commit paging benchmark.
 //
 // Exercises the real UltraCanvasGitGraphLayout code with no UI stack and no
 // link dependencies beyond the one source file under test.
 //
-// Version: 1.0.0
-// Last Modified: 2026-07-30
+// Version: 1.1.0
+// Last Modified: 2026-10-18
 // Author: UltraCanvas Framework
 
 #include "Plugins/Diagrams/UltraCanvasGitGraphLayout.h"
 
 #include <algorithm>
+#include <chrono>
 #include <cstdio>
 #include <map>
 #include <random>
 #include <set>
 #include <string>
+#include <tuple>
 #include <vector>
 
 using namespace UltraCanvas;
@@ -65,6 +68,44 @@ static const GitGraphPlacedEdge* FindEdge(const GitGraphLayoutResult& result,
     return nullptr;
 }
 
+// Placement and edge set of a layout, independent of edge emission order.
+struct LayoutShape {
+    std::vector<std::tuple<std::string, int, int, bool>> commits;
+    std::set<std::tuple<std::string, std::string, int, int, int, int, int, int, bool>> edges;
+
+    explicit LayoutShape(const GitGraphLayoutResult& result) {
+        for (const GitGraphPlacedCommit& placed : result.commits) {
+            commits.emplace_back(placed.sha, placed.row, placed.lane, placed.isBoundary);
+        }
+        for (const GitGraphPlacedEdge& edge : result.edges) {
+            edges.emplace(edge.childSha, edge.parentSha, edge.fromRow, edge.fromLane,
+                          edge.toRow, edge.toLane, edge.colorLane,
+                          static_cast<int>(edge.kind), edge.turnAtChild);
+        }
+    }
+
+    bool operator==(const LayoutShape& other) const {
+        return commits == other.commits && edges == other.edges;
+    }
+};
+
+// Feeds `commits` to an incremental layout `pageSize` commits at a time.
+static GitGraphLayoutResult LayOutInPages(const std::vector<GitGraphCommit>& commits,
+                                          const std::vector<GitGraphRef>& refs,
+                                          const GitGraphLayoutOptions& options,
+                                          size_t pageSize) {
+    UltraCanvasGitGraphIncrementalLayout incremental;
+    incremental.Reset(options, refs);
+    GitGraphLayoutResult result;
+    std::vector<GitGraphCommit> loaded;
+    for (const GitGraphCommit& commit : commits) {
+        loaded.push_back(commit);
+        if (loaded.size() % pageSize == 0) incremental.Append(loaded, result.commits.size(), result);
+    }
+    incremental.Append(loaded, result.commits.size(), result);
+    return result;
+}
+
 // Every placement invariant a well-formed layout must satisfy.
 static void CheckInvariants(const GitGraphLayoutResult& result,
                             const std::vector<GitGraphCommit>& commits,
@@ -883,6 +924,220 @@ static void TestLanePriorityBeatsCrossingReduction() {
           "the requested order survives the crossing-reduction pass");
 }
 
+static void TestIncrementalMatchesCompute() {
+    std::printf("Incremental layout (matches Compute, independent of page size)\n");
+
+    std::mt19937 rng(20261018u);
+    int mismatches = 0, pageMismatches = 0;
+
+    for (int iteration = 0; iteration < 200; ++iteration) {
+        const int count = 5 + static_cast<int>(rng() % 60);
+        std::vector<GitGraphCommit> commits;
+        for (int i = 0; i < count; ++i) {
+            std::vector<std::string> parents;
+            if (i > 0) {
+                parents.push_back("c" + std::to_string(rng() % static_cast<unsigned>(i)));
+                if (i > 2 && (rng() % 4) == 0) {
+                    const std::string extra = "c" + std::to_string(rng() % static_cast<unsigned>(i));
+                    if (extra != parents.front()) parents.push_back(extra);
+                }
+            }
+            commits.push_back(MakeCommit("c" + std::to_string(i), parents, i * 10));
+            if (i > 4 && (rng() % 9) == 0) {
+                commits.back().cherryPickSource = "c" + std::to_string(rng() % static_cast<unsigned>(i));
+            }
+        }
+        std::reverse(commits.begin(), commits.end());
+
+        for (GitGraphLaneStrategy strategy : {GitGraphLaneStrategy::Compact,
+                                              GitGraphLaneStrategy::Stable}) {
+            // Without a pinned trunk nothing depends on history not yet loaded,
+            // so a complete history must lay out exactly as Compute() does.
+            GitGraphLayoutOptions options;
+            options.laneStrategy = strategy;
+            options.trunkBranch  = "";
+            const LayoutShape full(UltraCanvasGitGraphLayout(options).Compute(commits, {}));
+            if (!(LayoutShape(LayOutInPages(commits, {}, options, commits.size())) == full)) {
+                ++mismatches;
+            }
+
+            options.trunkBranch = "main";
+            std::vector<GitGraphRef> refs = {MakeBranch("main", commits.front().sha)};
+            const LayoutShape whole(LayOutInPages(commits, refs, options, commits.size()));
+            for (size_t pageSize : {1, 3, 17}) {
+                if (!(LayoutShape(LayOutInPages(commits, refs, options, pageSize)) == whole)) {
+                    ++pageMismatches;
+                }
+            }
+        }
+    }
+
+    CHECK(mismatches == 0, "a complete history lays out exactly as Compute() does");
+    CHECK(pageMismatches == 0, "the result does not depend on the page size");
+    CHECK(UltraCanvasGitGraphIncrementalLayout::Supports(GitGraphLayoutOptions()),
+          "the default options are append-only");
+
+    GitGraphLayoutOptions sorted;
+    sorted.orderMode = GitGraphOrderMode::CommitDate;
+    CHECK(!UltraCanvasGitGraphIncrementalLayout::Supports(sorted),
+          "a reordering option needs the full Compute()");
+}
+
+static void TestIncrementalBoundaryResolution() {
+    std::printf("Incremental layout (parents arriving in a later page)\n");
+
+    //  m3 merges f1 into the trunk; f1 forks from m1 and cherry-picks m1b.
+    std::vector<GitGraphCommit> commits = {
+        MakeCommit("m3", {"m2", "f1"}, 50),
+        MakeCommit("f1", {"m1"}, 40),
+        MakeCommit("m2", {"m1b"}, 30),
+        MakeCommit("m1b", {"m1"}, 20),
+        MakeCommit("m1", {}, 10),
+    };
+    commits[1].cherryPickSource = "m1b";
+    std::vector<GitGraphRef> refs = {MakeBranch("main", "m3")};
+
+    GitGraphLayoutOptions options;
+    UltraCanvasGitGraphIncrementalLayout incremental;
+    incremental.Reset(options, refs);
+    GitGraphLayoutResult result;
+
+    std::vector<GitGraphCommit> loaded(commits.begin(), commits.begin() + 2);
+    incremental.Append(loaded, 0, result);
+    CHECK(result.commits.size() == 2 && result.rowCount == 2, "the first page is placed");
+    CHECK(result.Find("m3")->isBoundary && result.Find("f1")->isBoundary,
+          "commits with unloaded parents are boundary for now");
+    CHECK(FindEdge(result, "m3", "f1") && !FindEdge(result, "m3", "m2"),
+          "only edges between loaded commits exist");
+    CHECK(result.Find("m3")->lane == 0 && result.Find("f1")->lane == 1,
+          "the trunk tip takes lane 0, the merged branch lane 1");
+    CHECK(incremental.GetOpenLaneCount() == 2, "both lines stay open for their parents");
+
+    loaded.push_back(commits[2]);
+    loaded.push_back(commits[3]);
+    incremental.Append(loaded, 2, result);
+    CHECK(!result.Find("m3")->isBoundary, "the merge resolves once both parents arrive");
+    CHECK(result.Find("f1")->isBoundary, "the branch still waits for its fork point");
+    const GitGraphPlacedEdge* cherry = FindEdge(result, "f1", "m1b");
+    CHECK(cherry && cherry->kind == GitGraphEdgeKind::CherryPick,
+          "a cherry-pick edge attaches when its source arrives");
+
+    loaded.push_back(commits[4]);
+    incremental.Append(loaded, 4, result);
+    bool anyBoundary = false;
+    for (const GitGraphPlacedCommit& placed : result.commits) anyBoundary |= placed.isBoundary;
+    CHECK(!anyBoundary && incremental.GetAwaitedCount() == 0, "the complete history has no boundary");
+
+    bool trunkOnLaneZero = true;
+    for (const char* sha : {"m3", "m2", "m1b", "m1"}) {
+        trunkOnLaneZero &= (result.Find(sha)->lane == 0);
+    }
+    CHECK(trunkOnLaneZero, "the first-parent chain of main stays on lane 0");
+    const GitGraphPlacedEdge* fork = FindEdge(result, "f1", "m1");
+    CHECK(fork && fork->fromLane == 1 && fork->toLane == 0, "the branch runs into the trunk at its fork point");
+    CheckInvariants(result, commits, "after the last page");
+
+    GitGraphLayoutOptions stable = options;
+    stable.laneStrategy = GitGraphLaneStrategy::Compact;
+    CHECK(incremental.IsCompatible(options, refs), "the same options and trunk can carry on");
+    CHECK(!incremental.IsCompatible(stable, refs), "a different lane strategy needs a reset");
+    CHECK(!incremental.IsCompatible(options, {MakeBranch("main", "m4")}),
+          "a moved trunk tip needs a reset");
+}
+
+// A repository-shaped history, newest first: a trunk with feature branches
+// forking off and merging back, a few of them left open.
+static std::vector<GitGraphCommit> MakeLargeHistory(size_t count) {
+    std::mt19937 rng(500000u);
+    std::vector<GitGraphCommit> commits;
+    commits.reserve(count);
+
+    std::string trunk;
+    std::vector<std::string> features;
+    for (size_t i = 0; i < count; ++i) {
+        const std::string sha = "c" + std::to_string(i);
+        std::vector<std::string> parents;
+        const unsigned roll = rng() % 100;
+        if (trunk.empty()) {
+            trunk = sha;
+        } else if ((roll < 6 && features.size() < 12) || features.empty()) {
+            parents.push_back(trunk);                           // New branch off the trunk
+            features.push_back(sha);
+        } else if (roll < 60) {
+            const size_t f = rng() % features.size();           // Work on a branch
+            parents.push_back(features[f]);
+            features[f] = sha;
+        } else if (roll < 66 && features.size() > 1) {
+            const size_t f = rng() % features.size();           // Merge a branch back
+            parents = {trunk, features[f]};
+            features.erase(features.begin() + f);
+            trunk = sha;
+        } else {
+            parents.push_back(trunk);
+            trunk = sha;
+        }
+        commits.push_back(MakeCommit(sha, parents, static_cast<int64_t>(i)));
+    }
+    std::reverse(commits.begin(), commits.end());
+    return commits;
+}
+
+static void BenchmarkIncrementalPaging() {
+    std::printf("Paging benchmark (500k commits, 500 per page)\n");
+
+    const size_t total = 500000, pageSize = 500;
+    const std::vector<GitGraphCommit> history = MakeLargeHistory(total);
+    std::vector<GitGraphRef> refs = {MakeBranch("main", history.front().sha)};
+    GitGraphLayoutOptions options;
+
+    using Clock = std::chrono::steady_clock;
+    auto ms = [](Clock::time_point since) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - since).count();
+    };
+
+    // Pages arrive the way WalkMore() hands them to the element: appended to
+    // the commit list, then laid out.
+    UltraCanvasGitGraphIncrementalLayout incremental;
+    incremental.Reset(options, refs);
+    GitGraphLayoutResult result;
+    std::vector<GitGraphCommit> loaded;
+    loaded.reserve(total);
+
+    double slowestPage = 0.0;
+    const Clock::time_point begin = Clock::now();
+    for (size_t offset = 0; offset < total; offset += pageSize) {
+        loaded.insert(loaded.end(), history.begin() + offset,
+                      history.begin() + std::min(total, offset + pageSize));
+        const Clock::time_point pageBegin = Clock::now();
+        incremental.Append(loaded, offset, result);
+        slowestPage = std::max(slowestPage, ms(pageBegin));
+    }
+    const double pagedMs = ms(begin);
+
+    // Re-running Compute() per page costs the sum of every prefix, i.e. about
+    // pages / 2 full layouts.
+    const Clock::time_point computeBegin = Clock::now();
+    const GitGraphLayoutResult full = UltraCanvasGitGraphLayout(options).Compute(history, refs);
+    const double fullMs = ms(computeBegin);
+    const double pages = static_cast<double>(total / pageSize);
+
+    std::printf("       incremental: %.0f ms for %.0f pages (slowest page %.2f ms)\n",
+                pagedMs, pages, slowestPage);
+    std::printf("       one Compute(): %.0f ms; Compute() per page would be ~%.0f s\n",
+                fullMs, fullMs * (pages + 1) / 2.0 / 1000.0);
+
+    size_t parentEdges = 0;
+    for (const GitGraphCommit& commit : history) parentEdges += commit.parents.size();
+    bool anyBoundary = false;
+    for (const GitGraphPlacedCommit& placed : result.commits) anyBoundary |= placed.isBoundary;
+
+    CHECK(result.commits.size() == total && result.rowCount == static_cast<int>(total),
+          "every paged commit is placed");
+    CHECK(result.edges.size() == parentEdges && !anyBoundary && incremental.GetAwaitedCount() == 0,
+          "every parent edge is attached by the last page");
+    CHECK(full.commits.size() == total, "the full layout places the same commits");
+}
+
 // ---------------------------------------------------------------------------
 
 int main() {
@@ -911,6 +1166,9 @@ int main() {
     TestLanePriority();
     TestLanePriorityBeatsCrossingReduction();
     TestRandomHistories();
+    TestIncrementalMatchesCompute();
+    TestIncrementalBoundaryResolution();
+    BenchmarkIncrementalPaging();
 
     std::printf("\n%s (%d failure%s)\n",
                 g_failures == 0 ? "ALL TESTS PASSED" : "TESTS FAILED",
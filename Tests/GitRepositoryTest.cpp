@@ -8,16 +8,26 @@
 // argv[1] - so packfiles, deltas and packed-refs are exercised for real rather
 // than against a synthetic fixture.
 //
-// Version: 1.0.0
-// Last Modified: 2026-07-30
+// The commit-graph, delta-base cache and threaded-walk tests need a graph that
+// covers the history, which a checkout rarely has, so they build a fixture
+// repository in the temp directory with the git executable (fast-import, repack,
+// commit-graph write) and skip when git is not available.
+//
+// Version: 1.1.0
+// Last Modified: 2026-10-18
 // Author: UltraCanvas Framework
 
 #include "UltraCanvasGitRepository.h"
 
 #include <algorithm>
+#include <chrono>
 #include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
 #include <memory>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -299,6 +309,371 @@ static void TestFailureModes() {
     CHECK(repository.ReadRefs().empty(), "a closed repository has no refs");
 }
 
+// ---------------------------------------------------------------------------
+// Fixture repository (needs the git executable)
+// ---------------------------------------------------------------------------
+
+namespace fs = std::filesystem;
+
+static bool RunShell(const std::string& command) {
+#if defined(_WIN32)
+    (void)command;
+    return false;                       // The fixture script is POSIX shell
+#else
+    return std::system((command + " >/dev/null 2>&1").c_str()) == 0;
+#endif
+}
+
+static std::string Quote(const fs::path& path) {
+    return "'" + path.string() + "'";
+}
+
+// A fast-import stream: `count` commits on main, a feature branch merged back
+// every 40 commits, one octopus merge (three parents, so the commit-graph needs
+// its EDGE chunk) and a file that grows every commit, so repack produces real
+// delta chains. Commit times repeat in places to exercise the walk's tie-break.
+// `continueFrom` appends to an existing main instead of starting a new one.
+static void WriteHistory(const fs::path& file, int count, int firstIndex, bool continueFrom) {
+    std::ofstream out(file, std::ios::binary);
+    int mark = 0;
+    std::string growing;
+    for (int i = 0; i < firstIndex; ++i) growing += "line " + std::to_string(i) + "\n";
+
+    auto commit = [&](const std::string& ref, const std::vector<std::string>& parents,
+                      int64_t time, int index) {
+        ++mark;
+        const std::string message = "commit " + std::to_string(index) + "\n";
+        growing += "line " + std::to_string(index) + "\n";
+        out << "commit " << ref << "\nmark :" << mark << "\n"
+            << "committer Fixture <fixture@example.com> " << time << " +0000\n"
+            << "data " << message.size() << "\n" << message;
+        for (size_t p = 0; p < parents.size(); ++p) {
+            out << (p == 0 ? "from " : "merge ") << parents[p] << "\n";
+        }
+        out << "M 644 inline growing.txt\ndata " << growing.size() << "\n" << growing << "\n";
+        return ":" + std::to_string(mark);
+    };
+
+    std::string main = continueFrom ? "refs/heads/main^0" : std::string();
+    int64_t time = 1500000000 + static_cast<int64_t>(firstIndex) * 60;
+    for (int i = firstIndex; i < firstIndex + count; ++i) {
+        time += (i % 5 == 0) ? 0 : 60;
+        if (i == firstIndex + count / 2) {
+            const std::string a = commit("refs/heads/octo-a", {main}, time, i * 10 + 5);
+            const std::string b = commit("refs/heads/octo-b", {main}, time, i * 10 + 6);
+            main = commit("refs/heads/main", {main, a, b}, time + 1, i);
+        } else if (i > firstIndex && i % 40 == 0) {
+            std::string feature = main;
+            for (int f = 0; f < 3; ++f) {
+                feature = commit("refs/heads/feature", {feature}, time + f * 7, i * 10 + f);
+            }
+            main = commit("refs/heads/main", {main, feature}, time + 30, i);
+        } else {
+            main = commit("refs/heads/main",
+                          main.empty() ? std::vector<std::string>() : std::vector<std::string>{main},
+                          time, i);
+        }
+    }
+}
+
+// Builds the fixture; `split` writes a two-layer commit-graph chain instead
+// of a single file. Returns an empty path when git is unavailable.
+static fs::path BuildFixture(const std::string& name, int commits, bool split) {
+    if (!RunShell("git --version")) return fs::path();
+
+    const fs::path directory = fs::temp_directory_path() / name;
+    std::error_code ec;
+    fs::remove_all(directory, ec);
+    fs::create_directories(directory, ec);
+
+    const fs::path stream = directory / "history.stream";
+    const std::string git = "git -C " + Quote(directory) + " ";
+    const int firstHalf = split ? commits / 2 : commits;
+
+    WriteHistory(stream, firstHalf, 0, false);
+    bool ok = RunShell("git init -q " + Quote(directory)) &&
+              RunShell(git + "fast-import --quiet < " + Quote(stream)) &&
+              RunShell(git + "repack -adq");
+    if (ok && split) {
+        ok = RunShell(git + "commit-graph write --reachable --split") &&
+             (WriteHistory(stream, commits - firstHalf, firstHalf, true), true) &&
+             RunShell(git + "fast-import --quiet < " + Quote(stream)) &&
+             RunShell(git + "repack -adq") &&
+             RunShell(git + "commit-graph write --reachable --split=no-merge");
+    } else if (ok) {
+        ok = RunShell(git + "commit-graph write --reachable");
+    }
+    fs::remove(stream, ec);
+
+    if (!ok) {
+        fs::remove_all(directory, ec);
+        return fs::path();
+    }
+    return directory;
+}
+
+static std::vector<GitGraphCommit> WalkAll(UltraCanvasGitRepository& repository,
+                                           GitWalkDetail detail) {
+    std::vector<GitGraphCommit> all;
+    repository.RestartWalk();
+    while (true) {
+        std::vector<GitGraphCommit> chunk = repository.WalkMore(1000, detail);
+        if (chunk.empty()) break;
+        all.insert(all.end(), chunk.begin(), chunk.end());
+    }
+    return all;
+}
+
+static bool SameTopology(const std::vector<GitGraphCommit>& a,
+                         const std::vector<GitGraphCommit>& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].sha != b[i].sha || a[i].parents != b[i].parents ||
+            a[i].commitDate != b[i].commitDate) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void TestCommitGraph(const fs::path& fixture, const char* label) {
+    std::printf("Commit-graph (%s)\n", label);
+
+    UltraCanvasGitRepository withGraph, withoutGraph;
+    CHECK(withGraph.Open(fixture.string()) && withoutGraph.Open(fixture.string()),
+          "the fixture opens");
+    withoutGraph.SetUseCommitGraph(false);
+
+    CHECK(withGraph.HasCommitGraph(), "the commit-graph is found");
+    CHECK(!withoutGraph.HasCommitGraph(), "SetUseCommitGraph(false) ignores it");
+
+    const std::vector<GitGraphCommit> reference = WalkAll(withoutGraph, GitWalkDetail::Full);
+    CHECK(withGraph.GetCommitGraphSize() == reference.size(),
+          "the graph covers every commit");
+
+    withGraph.ResetStats();
+    const std::vector<GitGraphCommit> full = WalkAll(withGraph, GitWalkDetail::Full);
+    CHECK(SameTopology(full, reference), "a full walk with the graph matches the object walk");
+    bool messages = !full.empty();
+    for (size_t i = 0; i < full.size() && messages; ++i) {
+        if (full[i].subject != reference[i].subject) messages = false;
+    }
+    CHECK(messages, "a full walk still reads every subject");
+    const size_t fullInflated = withGraph.GetStats().objectsInflated;
+
+    withGraph.ResetStats();
+    const std::vector<GitGraphCommit> topology = WalkAll(withGraph, GitWalkDetail::Topology);
+    const GitRepositoryStats stats = withGraph.GetStats();
+    CHECK(SameTopology(topology, reference), "a topology walk matches the object walk");
+    CHECK(stats.commitGraphHits == reference.size(), "every commit came from the graph");
+    CHECK(stats.objectsInflated < 16,
+          "a topology walk inflates no commits (only ref tips are peeled)");
+    std::printf("       (%zu commits; objects inflated: full walk %zu, topology walk %zu)\n",
+                reference.size(), fullInflated, stats.objectsInflated);
+
+    bool octopus = false, entries = true, generations = true;
+    std::unordered_map<std::string, uint32_t> generationOf;
+    for (const GitGraphCommit& commit : reference) {
+        GitCommitGraphEntry entry;
+        if (!withGraph.ReadCommitGraphEntry(commit.sha, entry) ||
+            entry.parents != commit.parents || entry.commitDate != commit.commitDate) {
+            entries = false;
+            continue;
+        }
+        generationOf[commit.sha] = entry.generation;
+        if (entry.parents.size() > 2) octopus = true;
+    }
+    for (const GitGraphCommit& commit : reference) {
+        for (const std::string& parent : commit.parents) {
+            if (generationOf[parent] >= generationOf[commit.sha]) generations = false;
+        }
+    }
+    CHECK(entries, "ReadCommitGraphEntry matches every commit object");
+    CHECK(octopus, "an octopus merge reads all its parents (EDGE chunk)");
+    CHECK(generations, "a parent's generation is below its child's");
+
+    GitCommitGraphEntry missing;
+    CHECK(!withGraph.ReadCommitGraphEntry("0000000000000000000000000000000000000000", missing),
+          "an unknown sha is not in the graph");
+}
+
+static void TestDeltaBaseCache(const fs::path& fixture) {
+    std::printf("Delta-base cache\n");
+
+    UltraCanvasGitRepository cached, uncached;
+    cached.Open(fixture.string());
+    uncached.Open(fixture.string());
+    uncached.SetDeltaBaseCacheLimit(0);
+
+    // Every version of growing.txt: the repack stores them as a delta chain.
+    std::vector<std::string> blobs;
+    for (const GitGraphCommit& commit : cached.ReadCommits(400)) {
+        std::string body, type;
+        if (!cached.ReadObject(commit.sha, "commit", body, type)) continue;
+        std::string tree, treeType;
+        if (!cached.ReadObject(body.substr(5, 40), "tree", tree, treeType)) continue;
+        const size_t name = tree.find("growing.txt");
+        if (name == std::string::npos || name + 12 + 20 > tree.size()) continue;
+        static const char* digits = "0123456789abcdef";
+        std::string sha;
+        for (size_t i = 0; i < 20; ++i) {
+            const uint8_t byte = static_cast<uint8_t>(tree[name + 12 + i]);
+            sha.push_back(digits[byte >> 4]);
+            sha.push_back(digits[byte & 0x0F]);
+        }
+        blobs.push_back(sha);
+    }
+    CHECK(blobs.size() > 100, "the fixture blobs are found");
+
+    cached.ResetStats();
+    uncached.ResetStats();
+    bool identical = true;
+    for (const std::string& sha : blobs) {
+        std::string a, b, typeA, typeB;
+        if (!cached.ReadObject(sha, "blob", a, typeA) ||
+            !uncached.ReadObject(sha, "blob", b, typeB) || a != b) {
+            identical = false;
+        }
+    }
+    const GitRepositoryStats hot  = cached.GetStats();
+    const GitRepositoryStats cold = uncached.GetStats();
+    CHECK(identical, "cached and uncached reads return the same bytes");
+    CHECK(hot.deltaBaseHits > 0, "delta bases are served from the cache");
+    CHECK(hot.objectsInflated < cold.objectsInflated, "the cache saves inflates");
+    CHECK(hot.deltaBaseBytes <= cached.GetDeltaBaseCacheLimit(), "the cache stays within its limit");
+    std::printf("       (%zu blobs: %zu inflates cached vs %zu uncached, %zu hits)\n",
+                blobs.size(), hot.objectsInflated, cold.objectsInflated, hot.deltaBaseHits);
+
+    cached.SetDeltaBaseCacheLimit(64 * 1024);
+    CHECK(cached.GetStats().deltaBaseBytes <= 64 * 1024, "lowering the limit evicts");
+}
+
+static void TestThreadedWalk(const fs::path& fixture) {
+    std::printf("Walk on a worker thread\n");
+
+    auto repository = std::make_shared<UltraCanvasGitRepository>();
+    repository->Open(fixture.string());
+    const std::vector<GitGraphCommit> reference = WalkAll(*repository, GitWalkDetail::Full);
+
+    // Page on a worker while this thread keeps reading single objects, the
+    // way the element walks in the background while the UI shows a diff.
+    UltraCanvasGitRepositorySource source(repository);
+    repository->RestartWalk();
+    std::vector<GitGraphCommit> paged;
+    std::thread worker([&]() {
+        for (size_t offset = 0;; offset += 250) {
+            std::vector<GitGraphCommit> page = source.FetchCommits(offset, 250);
+            paged.insert(paged.end(), page.begin(), page.end());
+            if (page.size() < 250) break;
+        }
+    });
+    bool reads = true;
+    for (size_t i = 0; i < reference.size(); i += 7) {
+        GitGraphCommit commit;
+        if (!repository->ReadCommit(reference[i].sha, commit) ||
+            commit.subject != reference[i].subject) {
+            reads = false;
+        }
+    }
+    worker.join();
+
+    CHECK(SameTopology(paged, reference), "paging on a worker thread yields the full walk");
+    CHECK(reads, "concurrent single-commit reads are unaffected");
+}
+
+// Overwrites bucket 0x10 of the fanout table at `fanoutOffset` with a count
+// larger than the last one, so the table decreases.
+static bool CorruptFanout(const fs::path& file, size_t fanoutOffset) {
+    std::error_code ec;
+    fs::permissions(file, fs::perms::owner_write, fs::perm_options::add, ec);
+    std::fstream stream(file, std::ios::in | std::ios::out | std::ios::binary);
+    if (!stream) return false;
+    stream.seekp(static_cast<std::streamoff>(fanoutOffset + 0x10 * 4));
+    const char huge[4] = {'\x7F', '\xFF', '\xFF', '\xFF'};
+    stream.write(huge, sizeof(huge));
+    return stream.good();
+}
+
+// Offset of the OIDF chunk in a commit-graph file, 0 when not found.
+static size_t CommitGraphFanoutOffset(const fs::path& file) {
+    std::ifstream stream(file, std::ios::binary);
+    std::string raw((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+    if (raw.size() < 8) return 0;
+    const size_t chunks = static_cast<unsigned char>(raw[6]);
+    for (size_t i = 0; i < chunks && 8 + i * 12 + 12 <= raw.size(); ++i) {
+        const size_t entry = 8 + i * 12;
+        if (raw.compare(entry, 4, "OIDF") != 0) continue;
+        uint64_t offset = 0;
+        for (size_t b = 0; b < 8; ++b) {
+            offset = (offset << 8) | static_cast<unsigned char>(raw[entry + 4 + b]);
+        }
+        return static_cast<size_t>(offset);
+    }
+    return 0;
+}
+
+static void TestCorruptFanout(const fs::path& fixture) {
+    std::printf("Corrupt fanout tables\n");
+
+    const fs::path copy = fs::temp_directory_path() / "ultracanvas-git-fixture-corrupt";
+    std::error_code ec;
+    fs::remove_all(copy, ec);
+    fs::copy(fixture, copy, fs::copy_options::recursive, ec);
+
+    std::vector<GitGraphCommit> reference;
+    {
+        UltraCanvasGitRepository intact;
+        if (intact.Open(copy.string())) reference = WalkAll(intact, GitWalkDetail::Topology);
+    }
+
+    bool corrupted = !ec && !reference.empty();
+    for (const auto& entry : fs::directory_iterator(copy / ".git" / "objects" / "pack", ec)) {
+        if (entry.path().extension() == ".idx") corrupted = corrupted && CorruptFanout(entry.path(), 8);
+    }
+    const fs::path graphFile = copy / ".git" / "objects" / "info" / "commit-graph";
+    const size_t graphFanout = CommitGraphFanoutOffset(graphFile);
+    corrupted = corrupted && graphFanout > 0 && CorruptFanout(graphFile, graphFanout);
+    CHECK(corrupted, "the fixture copy is corrupted");
+
+    UltraCanvasGitRepository repository;
+    CHECK(repository.Open(copy.string()), "the repository still opens");
+    CHECK(!repository.HasCommitGraph(), "a commit-graph with a decreasing fanout is rejected");
+    bool found = false;
+    for (size_t i = 0; i < reference.size() && i < 200; ++i) {
+        GitGraphCommit commit;
+        if (repository.ReadCommit(reference[i].sha, commit)) found = true;
+    }
+    CHECK(!found, "a pack whose index has a decreasing fanout is skipped, reads fail cleanly");
+
+    fs::remove_all(copy, ec);
+}
+
+static void BenchmarkWalk(const fs::path& fixture) {
+    std::printf("Walk benchmark\n");
+
+    auto time = [](UltraCanvasGitRepository& repository, GitWalkDetail detail, size_t& count) {
+        const auto begin = std::chrono::steady_clock::now();
+        count = WalkAll(repository, detail).size();
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin)
+            .count();
+    };
+
+    UltraCanvasGitRepository plain, graph;
+    plain.Open(fixture.string());
+    plain.SetUseCommitGraph(false);
+    plain.SetDeltaBaseCacheLimit(0);
+    graph.Open(fixture.string());
+
+    size_t plainCount = 0, fullCount = 0, topologyCount = 0;
+    const double plainMs    = time(plain, GitWalkDetail::Full, plainCount);
+    const double fullMs     = time(graph, GitWalkDetail::Full, fullCount);
+    const double topologyMs = time(graph, GitWalkDetail::Topology, topologyCount);
+    std::printf("       %zu commits: objects only %.1f ms, graph + full %.1f ms, "
+                "graph topology %.1f ms\n", plainCount, plainMs, fullMs, topologyMs);
+    CHECK(plainCount == topologyCount && fullCount == topologyCount,
+          "every mode walks the same commits");
+}
+
 // ---------------------------------------------------------------------------
 
 int main(int argc, char** argv) {
@@ -328,6 +703,23 @@ int main(int argc, char** argv) {
     TestDataSource(repository);
     TestFailureModes();
 
+    const fs::path fixture = BuildFixture("ultracanvas-git-fixture", 4000, false);
+    const fs::path chained = BuildFixture("ultracanvas-git-fixture-split", 1200, true);
+    if (fixture.empty() || chained.empty()) {
+        std::printf("Commit-graph fixtures\n");
+        SKIP("git is not available to build the commit-graph fixtures");
+    } else {
+        TestCommitGraph(fixture, "single file");
+        TestCommitGraph(chained, "split chain");
+        TestDeltaBaseCache(fixture);
+        TestThreadedWalk(fixture);
+        TestCorruptFanout(fixture);
+        BenchmarkWalk(fixture);
+    }
+    std::error_code ec;
+    if (!fixture.empty()) fs::remove_all(fixture, ec);
+    if (!chained.empty()) fs::remove_all(chained, ec);
+
     std::printf("\n%s (%d failure%s, %d skipped)\n",
                 g_failures == 0 ? "ALL TESTS PASSED" : "TESTS FAILED",
                 g_failures, g_failures == 1 ? "" : "s", g_skipped);
@@ -0,0 +1,131 @@
+// Tests/RasterTilesTest.cpp
+// Unit tests for the screen-tile partitioning used by tiled rasterization:
+// coverage, disjointness, grid alignment and HiDPI mapping.
+// Version: 1.0.0
+// Last Modified: 2026-10-18
+// Author: UltraCanvas Framework
+
+#include "UltraCanvasRasterTiles.h"
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace UltraCanvas;
+
+static int failures = 0;
+static int checks = 0;
+
+#define CHECK(cond) do { \
+    ++checks; \
+    if (!(cond)) { \
+        ++failures; \
+        std::printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+    } \
+} while (0)
+
+static bool Overlap(const Rect2Di& a, const Rect2Di& b) {
+    return a.x < b.x + b.width && b.x < a.x + a.width &&
+           a.y < b.y + b.height && b.y < a.y + a.height;
+}
+
+static bool Covered(const std::vector<Rect2Di>& tiles, int px, int py) {
+    for (const auto& t : tiles) {
+        if (px >= t.x && px < t.x + t.width && py >= t.y && py < t.y + t.height) return true;
+    }
+    return false;
+}
+
+static void TestDeviceMapping() {
+    CHECK(LogicalToDeviceRect(Rect2Di(10, 20, 30, 40), 1.0f) == Rect2Di(10, 20, 30, 40));
+    CHECK(LogicalToDeviceRect(Rect2Di(10, 20, 30, 40), 2.0f) == Rect2Di(20, 40, 60, 80));
+    // Fractional scales round outwards so no partly covered pixel is lost.
+    CHECK(LogicalToDeviceRect(Rect2Di(1, 1, 1, 1), 1.5f) == Rect2Di(1, 1, 2, 2));
+    CHECK(LogicalToDeviceRect(Rect2Di(0, 0, 5, 5), 0.0f) == Rect2Di(0, 0, 5, 5));
+}
+
+static void TestFullFrame() {
+    const Size2Di surface(1000, 600);
+    auto tiles = BuildRasterTiles({Rect2Di(0, 0, 1000, 600)}, 1.0f, surface, 256);
+    CHECK(tiles.size() == 4u * 3u);
+    CHECK(tiles.front() == Rect2Di(0, 0, 256, 256));
+    // Edge tiles are clipped to the surface.
+    CHECK(tiles.back() == Rect2Di(768, 512, 232, 88));
+    long area = 0;
+    for (const auto& t : tiles) area += static_cast<long>(t.width) * t.height;
+    CHECK(area == 1000L * 600L);
+}
+
+static void TestSparseRegions() {
+    const Size2Di surface(2048, 2048);
+    // A small region inside one cell and one straddling four cells.
+    auto tiles = BuildRasterTiles({Rect2Di(10, 10, 20, 20), Rect2Di(500, 500, 30, 30)}, 1.0f, surface, 256);
+    CHECK(tiles.size() == 1u + 4u);
+    for (const auto& t : tiles) {
+        CHECK(t.x % 256 == 0 && t.y % 256 == 0);
+    }
+    // Touching a cell edge exactly does not pull in the neighbour.
+    CHECK(BuildRasterTiles({Rect2Di(0, 0, 256, 256)}, 1.0f, surface, 256).size() == 1u);
+    // Off-surface and empty regions produce nothing.
+    CHECK(BuildRasterTiles({Rect2Di(5000, 5000, 10, 10), Rect2Di(10, 10, 0, 0)}, 1.0f, surface, 256).empty());
+    CHECK(BuildRasterTiles({Rect2Di(0, 0, 10, 10)}, 1.0f, Size2Di(0, 0), 256).empty());
+}
+
+static void TestHiDpi() {
+    // 500x300 logical at 2x is 1000x600 device pixels.
+    auto tiles = BuildRasterTiles({Rect2Di(100, 100, 100, 100)}, 2.0f, Size2Di(1000, 600), 256);
+    // Device rect 200..400 spans cells 0 and 1 on both axes.
+    CHECK(tiles.size() == 4u);
+    CHECK(Covered(tiles, 200, 200) && Covered(tiles, 399, 399));
+}
+
+// Random region sets: tiles are disjoint, grid-aligned and cover every
+// device pixel of every region.
+static void TestRandomCoverage() {
+    std::mt19937 rng(11);
+    const Size2Di surface(1600, 1200);
+    for (int iter = 0; iter < 200; iter++) {
+        const float scale = (iter % 3 == 0) ? 1.25f : (iter % 3 == 1 ? 1.0f : 2.0f);
+        std::vector<Rect2Di> regions;
+        const int n = 1 + static_cast<int>(rng() % 6);
+        for (int i = 0; i < n; i++) {
+            regions.emplace_back(static_cast<int>(rng() % 900), static_cast<int>(rng() % 700),
+                                 1 + static_cast<int>(rng() % 300), 1 + static_cast<int>(rng() % 300));
+        }
+        auto tiles = BuildRasterTiles(regions, scale, surface, 128);
+
+        bool disjoint = true, aligned = true, covered = true;
+        for (size_t i = 0; i < tiles.size(); i++) {
+            if (tiles[i].x % 128 || tiles[i].y % 128) aligned = false;
+            for (size_t j = i + 1; j < tiles.size(); j++) {
+                if (Overlap(tiles[i], tiles[j])) disjoint = false;
+            }
+        }
+        const Rect2Di surfaceRect(0, 0, surface.width, surface.height);
+        for (const auto& region : regions) {
+            const Rect2Di d = LogicalToDeviceRect(region, scale).Intersection(surfaceRect);
+            if (d.width <= 0 || d.height <= 0) continue;
+            // Corners and centre are enough: tiles are whole grid cells.
+            const int xs[] = {d.x, d.x + d.width - 1, d.x + d.width / 2};
+            const int ys[] = {d.y, d.y + d.height - 1, d.y + d.height / 2};
+            for (int px : xs) for (int py : ys) {
+                if (!Covered(tiles, px, py)) covered = false;
+            }
+        }
+        CHECK(disjoint);
+        CHECK(aligned);
+        CHECK(covered);
+    }
+}
+
+int main() {
+    TestDeviceMapping();
+    TestFullFrame();
+    TestSparseRegions();
+    TestHiDpi();
+    TestRandomCoverage();
+
+    std::printf("%s: %d checks, %d failures\n",
+                failures == 0 ? "PASS" : "FAIL", checks, failures);
+    return failures == 0 ? 0 : 1;
+}
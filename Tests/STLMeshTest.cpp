@@ -0,0 +1,300 @@
+// Tests/STLMeshTest.cpp
+// Unit tests for the STL pipeline: memory-mapped loading, parallel ASCII and
+// binary parsing, vertex welding, quadric decimation and LOD chains.
+// Version: 1.0.0
+// Last Modified: 2026-10-18
+// Author: UltraCanvas Framework
+
+#include "UltraCanvasSTLLoader.h"
+#include "UltraCanvasMeshDecimator.h"
+#include "UltraCanvasMappedFile.h"
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace UltraCanvas;
+namespace fs = std::filesystem;
+
+static int failures = 0;
+static int checks = 0;
+
+#define CHECK(cond) do { \
+    ++checks; \
+    if (!(cond)) { \
+        ++failures; \
+        std::printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+    } \
+} while (0)
+
+// Closed, indexed torus: rings * sides vertices, twice as many triangles.
+static Mesh3D MakeTorus(int rings, int sides) {
+    const float pi = 3.14159265358979f;
+    Mesh3D mesh;
+    mesh.name = "torus";
+    for (int i = 0; i < rings; ++i) {
+        const float u = 2.0f * pi * i / rings;
+        for (int j = 0; j < sides; ++j) {
+            const float v = 2.0f * pi * j / sides;
+            const float r = 2.0f + 0.5f * std::cos(v);
+            mesh.positions.push_back({r * std::cos(u), r * std::sin(u), 0.5f * std::sin(v)});
+        }
+    }
+    for (int i = 0; i < rings; ++i) {
+        for (int j = 0; j < sides; ++j) {
+            const uint32_t a = i * sides + j;
+            const uint32_t b = ((i + 1) % rings) * sides + j;
+            const uint32_t c = ((i + 1) % rings) * sides + (j + 1) % sides;
+            const uint32_t d = i * sides + (j + 1) % sides;
+            mesh.indices.insert(mesh.indices.end(), {a, b, c, a, c, d});
+        }
+    }
+    mesh.RecomputeNormals();
+    mesh.ComputeBounds();
+    return mesh;
+}
+
+static bool SamePositions(const Mesh3D& a, const Mesh3D& b) {
+    if (a.positions.size() != b.positions.size() || a.indices != b.indices) return false;
+    return std::memcmp(a.positions.data(), b.positions.data(), a.positions.size() * sizeof(Vec3)) == 0;
+}
+
+static std::vector<uint8_t> ReadFile(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::vector<uint8_t>((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+}
+
+static void TestParallelParsing(const fs::path& work) {
+    const Mesh3D torus = MakeTorus(64, 32);
+    for (STLFormat format : {STLFormat::Binary, STLFormat::ASCII}) {
+        const std::string path = (work / (format == STLFormat::Binary ? "t.stl" : "ta.stl")).string();
+        CHECK(UltraCanvasSTLLoader::Save(path, torus, format));
+
+        STLLoadOptions serialOpts;
+        serialOpts.threads = 1;
+        STLLoadOptions parallelOpts;
+        parallelOpts.threads = 7;
+        Mesh3D serial, parallel;
+        CHECK(UltraCanvasSTLLoader::Load(path, serial, serialOpts));
+        CHECK(UltraCanvasSTLLoader::Load(path, parallel, parallelOpts));
+        CHECK(serial.TriangleCount() == torus.TriangleCount());
+        CHECK(serial.positions.size() == torus.TriangleCount() * 3);    // unwelded soup
+        CHECK(serial.normals.size() == serial.positions.size());
+        CHECK(SamePositions(serial, parallel));
+        CHECK(serial.normals.size() == parallel.normals.size() &&
+              std::memcmp(serial.normals.data(), parallel.normals.data(),
+                          serial.normals.size() * sizeof(Vec3)) == 0);
+        if (format == STLFormat::ASCII) CHECK(serial.name == "torus");
+
+        // Default overload still matches.
+        Mesh3D plain;
+        CHECK(UltraCanvasSTLLoader::Load(path, plain));
+        CHECK(SamePositions(serial, plain));
+    }
+}
+
+static void TestAsciiEdgeCases() {
+    const std::string text =
+        "solid part\n"
+        "facet normal 0 0 0\n outer loop\n"
+        "  vertex 0 0 0\n  vertex +1 0 0\n  vertex 0 1e0 0\n"
+        " endloop\nendfacet\n"
+        "facet normal 0 0 1\n outer loop\n  vertex 0 0 1\n  vertex oops\n";
+    Mesh3D mesh;
+    std::string error;
+    STLLoadOptions opts;
+    opts.threads = 4;
+    CHECK(UltraCanvasSTLLoader::LoadFromMemory(reinterpret_cast<const uint8_t*>(text.data()),
+                                               text.size(), mesh, opts, &error));
+    CHECK(mesh.TriangleCount() == 1);
+    CHECK(mesh.name == "part");
+    // A zero facet normal is replaced by the geometric one.
+    if (!mesh.normals.empty()) CHECK(std::abs(mesh.normals[0].z - 1.0f) < 1e-6f);
+
+    const std::string empty = "solid nothing\nendsolid nothing\n";
+    CHECK(!UltraCanvasSTLLoader::LoadFromMemory(reinterpret_cast<const uint8_t*>(empty.data()),
+                                                empty.size(), mesh, opts, &error));
+    CHECK(!error.empty());
+
+    // Binary whose header starts with "solid" is still detected by size.
+    std::vector<uint8_t> binary(84 + 50, 0);
+    std::memcpy(binary.data(), "solid binary", 12);
+    binary[80] = 1;
+    const float verts[9] = {0, 0, 0, 1, 0, 0, 0, 1, 0};
+    std::memcpy(binary.data() + 84 + 12, verts, sizeof(verts));
+    CHECK(UltraCanvasSTLLoader::LooksLikeBinary(binary.data(), binary.size()));
+    CHECK(UltraCanvasSTLLoader::LoadFromMemory(binary, mesh));
+    CHECK(mesh.TriangleCount() == 1);
+
+    binary.resize(100);
+    binary[80] = 2;
+    CHECK(!UltraCanvasSTLLoader::LoadFromMemory(binary, mesh, &error));
+}
+
+static void TestWelding(const fs::path& work) {
+    const Mesh3D torus = MakeTorus(64, 32);
+    const std::string path = (work / "t.stl").string();
+
+    STLLoadOptions opts;
+    opts.weld = true;
+    Mesh3D welded, weldedSerial;
+    CHECK(UltraCanvasSTLLoader::Load(path, welded, opts));
+    CHECK(welded.positions.size() == torus.positions.size());
+    CHECK(welded.TriangleCount() == torus.TriangleCount());
+    CHECK(welded.normals.size() == welded.positions.size());
+    opts.threads = 1;
+    CHECK(UltraCanvasSTLLoader::Load(path, weldedSerial, opts));
+    CHECK(SamePositions(welded, weldedSerial));
+
+    opts.computeNormals = false;
+    CHECK(UltraCanvasSTLLoader::Load(path, welded, opts));
+    CHECK(welded.normals.empty());
+
+    // Saving a welded mesh writes facet normals, and reloads to the same soup.
+    const std::string resaved = (work / "resaved.stl").string();
+    CHECK(UltraCanvasSTLLoader::Save(resaved, welded, STLFormat::Binary));
+    Mesh3D original, reloaded;
+    CHECK(UltraCanvasSTLLoader::Load(path, original));
+    CHECK(UltraCanvasSTLLoader::Load(resaved, reloaded));
+    CHECK(reloaded.TriangleCount() == original.TriangleCount());
+    bool normalsMatch = reloaded.normals.size() == original.normals.size();
+    for (size_t i = 0; normalsMatch && i < original.normals.size(); ++i) {
+        normalsMatch = (original.normals[i] - reloaded.normals[i]).Length() < 1e-4f;
+    }
+    CHECK(normalsMatch);
+
+    // Jittered soup: exact welding keeps the cracks, tolerance closes them.
+    Mesh3D jittered = original;
+    uint32_t seed = 7;
+    for (auto& p : jittered.positions) {
+        seed = seed * 1103515245u + 12345u;
+        p.x += ((seed >> 16) % 100) * 1e-7f;
+    }
+    Mesh3D exact = jittered;
+    UltraCanvasSTLLoader::WeldVertices(exact);
+    CHECK(exact.positions.size() > torus.positions.size());
+    Mesh3D loose = jittered;
+    UltraCanvasSTLLoader::WeldVertices(loose, 1e-3f);
+    CHECK(loose.positions.size() == torus.positions.size());
+    CHECK(loose.TriangleCount() == torus.TriangleCount());
+
+    // -0 and +0 weld; triangles collapsed by the weld are dropped.
+    Mesh3D tiny;
+    tiny.positions = {{0, 0, 0}, {1, 0, 0}, {0, 1, 0}, {-0.0f, 0, 0}, {0.001f, 0, 0}, {0, 1, 0}};
+    tiny.indices = {0, 1, 2, 3, 4, 5};
+    UltraCanvasSTLLoader::WeldVertices(tiny, 0.01f);
+    CHECK(tiny.TriangleCount() == 1);
+    CHECK(tiny.positions.size() == 3);
+}
+
+static void TestDecimation() {
+    const Mesh3D torus = MakeTorus(128, 64);     // 16384 triangles
+    Mesh3D coarse;
+    CHECK(UltraCanvasMeshDecimator::Decimate(torus, 2000, coarse));
+    CHECK(coarse.TriangleCount() <= 2000 && coarse.TriangleCount() > 1500);
+    CHECK(coarse.positions.size() < torus.positions.size());
+    CHECK(coarse.normals.size() == coarse.positions.size());
+    bool indicesValid = true;
+    for (uint32_t idx : coarse.indices) indicesValid = indicesValid && idx < coarse.positions.size();
+    CHECK(indicesValid);
+    // The shape survives: bounds within a few percent of the radius.
+    const float radius = torus.bounds.Radius();
+    CHECK((coarse.bounds.min - torus.bounds.min).Length() < 0.05f * radius);
+    CHECK((coarse.bounds.max - torus.bounds.max).Length() < 0.05f * radius);
+    // Every simplified vertex stays near the original surface.
+    float worst = 0.0f;
+    for (const Vec3& p : coarse.positions) {
+        const float ring = std::sqrt(p.x * p.x + p.y * p.y) - 2.0f;
+        worst = std::max(worst, std::abs(std::sqrt(ring * ring + p.z * p.z) - 0.5f));
+    }
+    CHECK(worst < 0.05f);
+
+    auto lods = UltraCanvasMeshDecimator::BuildLODs(torus, 500);
+    CHECK(!lods.empty());
+    bool shrinking = true;
+    size_t previous = torus.TriangleCount();
+    for (const auto& level : lods) {
+        shrinking = shrinking && level.TriangleCount() < previous;
+        previous = level.TriangleCount();
+    }
+    CHECK(shrinking);
+    if (!lods.empty()) CHECK(lods.back().TriangleCount() <= 500);
+    CHECK(UltraCanvasMeshDecimator::BuildLODs(torus, torus.TriangleCount()).empty());
+
+    std::atomic<bool> cancel{true};
+    CHECK(!UltraCanvasMeshDecimator::Decimate(torus, 10, coarse, &cancel));
+    CHECK(UltraCanvasMeshDecimator::BuildLODs(torus, 500, &cancel).empty());
+
+    // Open borders stay put.
+    Mesh3D grid;
+    const int n = 40;
+    for (int y = 0; y <= n; ++y)
+        for (int x = 0; x <= n; ++x)
+            grid.positions.push_back({x / float(n), y / float(n), 0.0f});
+    for (int y = 0; y < n; ++y) {
+        for (int x = 0; x < n; ++x) {
+            const uint32_t a = y * (n + 1) + x, b = a + 1, c = a + n + 2, d = a + n + 1;
+            grid.indices.insert(grid.indices.end(), {a, b, c, a, c, d});
+        }
+    }
+    grid.ComputeBounds();
+    CHECK(UltraCanvasMeshDecimator::Decimate(grid, 200, coarse));
+    CHECK(coarse.TriangleCount() <= 200);
+    CHECK((coarse.bounds.min - grid.bounds.min).Length() < 1e-3f);
+    CHECK((coarse.bounds.max - grid.bounds.max).Length() < 1e-3f);
+}
+
+static void TestMappedFile(const fs::path& work) {
+    const std::string path = (work / "t.stl").string();
+    UltraCanvasMappedFile file;
+    CHECK(file.Open(path));
+    CHECK(file.IsOpen());
+    CHECK(file.Size() == fs::file_size(path));
+    const auto bytes = ReadFile(path);
+    CHECK(file.Data() && std::memcmp(file.Data(), bytes.data(), bytes.size()) == 0);
+
+    UltraCanvasMappedFile moved(std::move(file));
+    CHECK(moved.IsOpen() && !file.IsOpen());
+    CHECK(moved.Size() == bytes.size());
+    moved.Close();
+    CHECK(!moved.IsOpen() && moved.Data() == nullptr);
+
+    const std::string empty = (work / "empty.stl").string();
+    std::ofstream(empty).close();
+    CHECK(file.Open(empty));
+    CHECK(file.Size() == 0);
+    Mesh3D mesh;
+    std::string error;
+    CHECK(!UltraCanvasSTLLoader::Load(empty, mesh, &error));
+
+    CHECK(!file.Open((work / "missing.stl").string()));
+    CHECK(!file.GetLastError().empty());
+    CHECK(!UltraCanvasSTLLoader::Load((work / "missing.stl").string(), mesh, &error));
+    CHECK(!error.empty());
+}
+
+int main() {
+    const fs::path work = fs::temp_directory_path() /
+            ("uc_stlmesh_" + std::to_string(std::chrono::steady_clock::now()
+                                                .time_since_epoch().count()));
+    fs::create_directories(work);
+
+    TestParallelParsing(work);
+    TestAsciiEdgeCases();
+    TestWelding(work);
+    TestDecimation();
+    TestMappedFile(work);
+
+    std::error_code ec;
+    fs::remove_all(work, ec);
+
+    std::printf("%s: %d checks, %d failures\n",
+                failures == 0 ? "PASS" : "FAIL", checks, failures);
+    return failures == 0 ? 0 : 1;
+}
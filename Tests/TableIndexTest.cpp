@@ -0,0 +1,277 @@
+// Tests/TableIndexTest.cpp
+// Unit tests for the table view's columnar keys and display-order builder
+// (numeric / text sort, stability, filter, cancellation, key and index
+// edits against a full rebuild, snapshots, background builds).
+// Version: 1.0.0
+// Last Modified: 2026-10-18
+// Author: UltraCanvas Framework
+
+#include "UltraCanvasTableIndex.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <vector>
+
+using namespace UltraCanvas;
+
+static int failures = 0;
+static int checks = 0;
+
+#define CHECK(cond) do { \
+    ++checks; \
+    if (!(cond)) { \
+        ++failures; \
+        std::printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+    } \
+} while (0)
+
+static std::shared_ptr<TableColumnKeys> Keys(const std::vector<std::string>& cells) {
+    return TableColumnKeys::Build(cells.size(), [&cells](size_t row) { return cells[row]; });
+}
+
+static std::vector<int32_t> Order(const std::vector<std::string>& cells, bool ascending,
+                                  const std::string& filter = {}) {
+    auto keys = Keys(cells);
+    std::vector<int32_t> out;
+    BuildTableDisplayIndex(cells.size(), keys.get(), ascending, filter, {keys.get()}, out);
+    return out;
+}
+
+static void TestKeys() {
+    auto keys = Keys({"12", " 3.5", "abc", "", "7kg"});
+    CHECK(keys->Size() == 5);
+    CHECK(keys->Text(0) == "12");
+    CHECK(keys->Text(2) == "abc");
+    CHECK(keys->Text(3).empty());
+    CHECK(keys->IsNumber(0) && keys->Number(0) == 12.0);
+    CHECK(keys->IsNumber(1) && keys->Number(1) == 3.5);
+    CHECK(!keys->IsNumber(2));
+    CHECK(!keys->IsNumber(3));
+    CHECK(keys->IsNumber(4) && keys->Number(4) == 7.0);    // numeric prefix, as std::stod
+}
+
+static void TestSort() {
+    // Numbers by value (not "10" < "9"), ahead of text.
+    CHECK((Order({"10", "9", "b", "100", "a"}, true) == std::vector<int32_t>{1, 0, 3, 4, 2}));
+    CHECK((Order({"10", "9", "b", "100", "a"}, false) == std::vector<int32_t>{2, 4, 3, 0, 1}));
+
+    // Stable: equal keys keep model order in both directions.
+    CHECK((Order({"x", "a", "x", "a"}, true) == std::vector<int32_t>{1, 3, 0, 2}));
+    CHECK((Order({"x", "a", "x", "a"}, false) == std::vector<int32_t>{0, 2, 1, 3}));
+
+    // No sort keys: model order.
+    std::vector<int32_t> out;
+    BuildTableDisplayIndex(3, nullptr, true, {}, {}, out);
+    CHECK((out == std::vector<int32_t>{0, 1, 2}));
+}
+
+static void TestFilter() {
+    std::vector<std::string> name = {"alpha", "beta", "gamma", "delta"};
+    std::vector<std::string> city = {"Oslo", "Rome", "Paris", "Bern"};
+    auto n = Keys(name);
+    auto c = Keys(city);
+    std::vector<int32_t> out;
+
+    // Any column matches, case-sensitively.
+    BuildTableDisplayIndex(4, nullptr, true, "ta", {n.get(), c.get()}, out);
+    CHECK((out == std::vector<int32_t>{1, 3}));
+    BuildTableDisplayIndex(4, nullptr, true, "R", {n.get(), c.get()}, out);
+    CHECK((out == std::vector<int32_t>{1}));
+
+    // Filter, then sort what is left.
+    BuildTableDisplayIndex(4, c.get(), true, "a", {n.get(), c.get()}, out);
+    CHECK((out == std::vector<int32_t>{3, 0, 2, 1}));
+    BuildTableDisplayIndex(4, n.get(), false, "e", {n.get(), c.get()}, out);
+    CHECK((out == std::vector<int32_t>{3, 1}));
+
+    CHECK(Order({"a", "b"}, true, "zz").empty());
+}
+
+static void TestCancel() {
+    std::atomic<bool> cancel{true};
+    const size_t rows = 100000;
+    auto keys = TableColumnKeys::Build(rows, [](size_t row) { return std::to_string(row); }, &cancel);
+    CHECK(keys == nullptr);
+
+    keys = TableColumnKeys::Build(rows, [](size_t row) { return std::to_string(rows - row); });
+    std::vector<int32_t> out;
+    CHECK(!BuildTableDisplayIndex(rows, keys.get(), true, {}, {}, out, &cancel));
+    cancel = false;
+    CHECK(BuildTableDisplayIndex(rows, keys.get(), true, {}, {}, out, &cancel));
+    CHECK(out.size() == rows && out.front() == static_cast<int32_t>(rows - 1) && out.back() == 0);
+}
+
+// Every row's text, read back through the keys
+static std::vector<std::string> Texts(const TableColumnKeys& keys) {
+    std::vector<std::string> out;
+    keys.ForEachRow([&out](size_t, std::string_view text, double) { out.emplace_back(text); });
+    return out;
+}
+
+static void TestKeyEdits() {
+    // Enough rows for several chunks, so edits cross chunk boundaries.
+    const size_t rows = TableColumnKeys::kChunkRows * 3 + 17;
+    std::vector<std::string> cells(rows);
+    for (size_t row = 0; row < rows; ++row) cells[row] = "r" + std::to_string(row);
+    auto keys = Keys(cells);
+
+    auto snapshot = keys->Snapshot();
+    const std::vector<std::string> before = Texts(*snapshot);
+
+    keys->Set(5, "42");
+    cells[5] = "42";
+    keys->Set(TableColumnKeys::kChunkRows, "");
+    cells[TableColumnKeys::kChunkRows] = "";
+    keys->Insert(0, "first");
+    cells.insert(cells.begin(), "first");
+    keys->Insert(cells.size(), "last");
+    cells.push_back("last");
+    keys->Remove(TableColumnKeys::kChunkRows * 2);
+    cells.erase(cells.begin() + TableColumnKeys::kChunkRows * 2);
+    // Grow one chunk past the split point.
+    for (size_t i = 0; i < TableColumnKeys::kChunkRows + 5; ++i) {
+        keys->Insert(100, "x" + std::to_string(i));
+        cells.insert(cells.begin() + 100, "x" + std::to_string(i));
+    }
+    // Empty a whole chunk.
+    for (size_t i = 0; i < TableColumnKeys::kChunkRows + 200; ++i) {
+        keys->Remove(cells.size() - 1);
+        cells.pop_back();
+    }
+
+    CHECK(keys->Size() == cells.size());
+    CHECK(Texts(*keys) == cells);
+    CHECK(keys->IsNumber(6) && keys->Number(6) == 42.0);
+    CHECK(!keys->IsNumber(0));
+    CHECK(keys->Text(101) == "x" + std::to_string(TableColumnKeys::kChunkRows + 3));
+    // The snapshot did not see any of it.
+    CHECK(snapshot->Size() == rows);
+    CHECK(Texts(*snapshot) == before);
+
+    // Out of range: ignored.
+    keys->Set(cells.size(), "z");
+    keys->Remove(cells.size());
+    keys->Insert(cells.size() + 1, "z");
+    CHECK(keys->Size() == cells.size());
+
+    TableColumnKeys empty;
+    empty.Insert(0, "7");
+    CHECK(empty.Size() == 1 && empty.Number(0) == 7.0);
+    empty.Remove(0);
+    CHECK(empty.Size() == 0 && Texts(empty).empty());
+}
+
+static void TestRowRemoved() {
+    std::vector<int32_t> index = {3, 0, 2};     // row 1 filtered out
+    TableIndexRowRemoved(index, 0);
+    CHECK((index == std::vector<int32_t>{2, 1}));
+    TableIndexRowRemoved(index, 0);             // not displayed: renumber only
+    CHECK((index == std::vector<int32_t>{1, 0}));
+}
+
+// Random inserts, removes and edits on two columns, each patched into the
+// index, which must always equal a full rebuild from the same keys.
+static void TestIndexEditsMatchRebuild() {
+    for (int mode = 0; mode < 4; ++mode) {
+        const bool sorted = mode != 1;
+        const bool ascending = mode != 2;
+        const std::string filter = mode == 0 ? std::string() : "1";
+        std::vector<std::string> name, size;
+        for (int row = 0; row < 300; ++row) {
+            name.push_back("n" + std::to_string((row * 37) % 101));
+            size.push_back(row % 7 == 0 ? "big" : std::to_string((row * 13) % 50));
+        }
+        auto nameKeys = Keys(name);
+        auto sizeKeys = Keys(size);
+        TableIndexView view;
+        view.sortKeys = sorted ? sizeKeys.get() : nullptr;
+        view.ascending = ascending;
+        view.filter = filter;
+        view.filterColumns = {nameKeys.get(), sizeKeys.get()};
+
+        auto rebuild = [&]() {
+            std::vector<int32_t> out;
+            BuildTableDisplayIndex(name.size(), view.sortKeys, ascending, filter,
+                                   view.filterColumns, out);
+            return out;
+        };
+        std::vector<int32_t> index = rebuild();
+        bool same = true;
+        uint32_t seed = 12345;
+        auto next = [&seed](uint32_t n) { seed = seed * 1103515245u + 12345u; return (seed >> 8) % n; };
+        for (int step = 0; step < 400; ++step) {
+            const int32_t row = static_cast<int32_t>(next(static_cast<uint32_t>(name.size())));
+            const std::string text = std::to_string(next(60));
+            switch (next(3)) {
+                case 0:
+                    name.insert(name.begin() + row, "n" + text);
+                    size.insert(size.begin() + row, text);
+                    nameKeys->Insert(row, "n" + text);
+                    sizeKeys->Insert(row, text);
+                    TableIndexRowInserted(index, row, view);
+                    break;
+                case 1:
+                    name.erase(name.begin() + row);
+                    size.erase(size.begin() + row);
+                    nameKeys->Remove(row);
+                    sizeKeys->Remove(row);
+                    TableIndexRowRemoved(index, row);
+                    break;
+                default:
+                    size[row] = text;
+                    sizeKeys->Set(row, text);
+                    TableIndexRowChanged(index, row, view);
+                    break;
+            }
+            if (index != rebuild()) same = false;
+        }
+        CHECK(same);
+    }
+}
+
+static void TestWorker() {
+    const size_t rows = 50000;
+    std::vector<std::string> cells(rows);
+    for (size_t row = 0; row < rows; ++row) cells[row] = std::to_string((row * 7919) % rows);
+
+    TableIndexRequest request;
+    request.rowCount = rows;
+    request.sortKeys = Keys(cells);
+    request.filter = "1";
+    request.filterColumns = {request.sortKeys};
+    std::vector<int32_t> expected;
+    CHECK(BuildTableDisplayIndex(request, expected));
+
+    std::mutex mutex;
+    std::condition_variable cond;
+    std::shared_ptr<std::vector<int32_t>> result;
+    {
+        TableIndexWorker worker;
+        worker.Submit(request, [&](std::shared_ptr<std::vector<int32_t>> index) {
+            std::lock_guard<std::mutex> lock(mutex);
+            result = std::move(index);
+            cond.notify_all();
+        });
+        std::unique_lock<std::mutex> lock(mutex);
+        cond.wait_for(lock, std::chrono::seconds(30), [&] { return result != nullptr; });
+    }
+    CHECK(result && *result == expected);
+}
+
+int main() {
+    TestKeys();
+    TestSort();
+    TestFilter();
+    TestCancel();
+    TestKeyEdits();
+    TestRowRemoved();
+    TestIndexEditsMatchRebuild();
+    TestWorker();
+
+    std::printf("%s: %d checks, %d failures\n",
+                failures == 0 ? "PASS" : "FAIL", checks, failures);
+    return failures == 0 ? 0 : 1;
+}
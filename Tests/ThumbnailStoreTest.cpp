@@ -0,0 +1,189 @@
+// Tests/ThumbnailStoreTest.cpp
+// Unit tests for the persistent XDG thumbnail store (naming, tEXt stamping,
+// validation against the source file, failure cache).
+// Version: 1.0.0
+// Last Modified: 2026-10-18
+// Author: UltraCanvas Framework
+
+#include "UltraCanvasThumbnailStore.h"
+
+#include "miniz.h"
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+namespace TS = UltraCanvas::ThumbnailStore;
+
+static int failures = 0;
+static int checks = 0;
+
+#define CHECK(cond) do { \
+    ++checks; \
+    if (!(cond)) { \
+        ++failures; \
+        std::printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+    } \
+} while (0)
+
+static std::vector<uint8_t> MakePng(int w, int h) {
+    std::vector<uint8_t> rgba(static_cast<size_t>(w) * h * 4, 0x80);
+    size_t len = 0;
+    void* raw = tdefl_write_image_to_png_file_in_memory(rgba.data(), w, h, 4, &len);
+    std::vector<uint8_t> png(static_cast<uint8_t*>(raw), static_cast<uint8_t*>(raw) + len);
+    mz_free(raw);
+    return png;
+}
+
+static void WriteFile(const fs::path& p, const std::string& content) {
+    std::ofstream f(p, std::ios::binary | std::ios::trunc);
+    f << content;
+}
+
+static void TestMd5() {
+    // RFC 1321 test suite
+    CHECK(TS::Md5Hex("") == "d41d8cd98f00b204e9800998ecf8427e");
+    CHECK(TS::Md5Hex("abc") == "900150983cd24fb0d6963f7d28e17f72");
+    CHECK(TS::Md5Hex("message digest") == "f96b697d7cb7938d525a2f31aaf161d0");
+    CHECK(TS::Md5Hex("12345678901234567890123456789012345678901234567890123456789012345678901234567890")
+          == "57edf4a22be3c955ac49da2e2107b67a");
+}
+
+static void TestUriAndLayout() {
+    CHECK(TS::FileUri("/home/jens/photos/x.png") == "file:///home/jens/photos/x.png");
+    CHECK(TS::FileUri("/tmp/a b#c%.jpg") == "file:///tmp/a%20b%23c%25.jpg");
+    CHECK(TS::FileUri("/tmp/(1)+@x.jpg") == "file:///tmp/(1)+@x.jpg");
+    CHECK(TS::FileUri("/tmp/\xC3\xA4.png") == "file:///tmp/%C3%A4.png");
+
+    TS::Flavor f;
+    CHECK(TS::FlavorForEdge(100, f) && f == TS::Flavor::Normal);
+    CHECK(TS::FlavorForEdge(129, f) && f == TS::Flavor::Large);
+    CHECK(TS::FlavorForEdge(1024, f) && f == TS::Flavor::XXLarge);
+    CHECK(!TS::FlavorForEdge(1025, f));
+    CHECK(TS::FlavorEdge(TS::Flavor::XLarge) == 512);
+    CHECK(std::string(TS::FlavorDirectory(TS::Flavor::XXLarge)) == "xx-large");
+
+    TS::SetCacheRoot("/cache/thumbnails");
+    CHECK(TS::ThumbnailPathFor("/home/jens/photos/x.png", TS::Flavor::Large) ==
+          "/cache/thumbnails/large/" + TS::Md5Hex("file:///home/jens/photos/x.png") + ".png");
+}
+
+static void TestPngText() {
+    std::vector<uint8_t> png = MakePng(4, 3);
+    int w = 0, h = 0;
+    CHECK(TS::ReadPngSize(png, w, h) && w == 4 && h == 3);
+
+    std::vector<uint8_t> stamped = TS::WithPngText(png, {{"Thumb::URI", "file:///a"},
+                                                         {"Thumb::MTime", "42"}});
+    CHECK(!stamped.empty());
+    std::vector<std::pair<std::string, std::string>> text;
+    CHECK(TS::ReadPngText(stamped, text));
+    CHECK(text.size() == 2);
+    CHECK(text.size() == 2 && text[0].first == "Thumb::URI" && text[0].second == "file:///a");
+
+    // Restamping replaces keys instead of duplicating them
+    std::vector<uint8_t> again = TS::WithPngText(stamped, {{"Thumb::MTime", "43"}});
+    text.clear();
+    CHECK(TS::ReadPngText(again, text));
+    CHECK(text.size() == 2);
+    int mtimes = 0;
+    for (auto& kv : text) if (kv.first == "Thumb::MTime") { ++mtimes; CHECK(kv.second == "43"); }
+    CHECK(mtimes == 1);
+
+    int dw = 0, dh = 0;
+    CHECK(TS::ReadPngSize(again, dw, dh) && dw == 4 && dh == 3);
+
+    std::vector<uint8_t> notPng = {1, 2, 3};
+    CHECK(TS::WithPngText(notPng, {{"k", "v"}}).empty());
+    CHECK(!TS::ReadPngText(notPng, text));
+}
+
+static void TestStoreAndLookup(const fs::path& work) {
+    const fs::path root = work / "thumbnails";
+    TS::SetCacheRoot(root.string());
+    const fs::path source = work / "photo one.jpg";
+    WriteFile(source, "not really a jpeg");
+
+    std::vector<uint8_t> out;
+    CHECK(!TS::Lookup(source.string(), 128, out));
+
+    CHECK(TS::Store(source.string(), TS::Flavor::Large, MakePng(256, 192), 4000, 3000));
+    CHECK(fs::exists(TS::ThumbnailPathFor(source.string(), TS::Flavor::Large)));
+    auto perms = fs::status(root / "large").permissions();
+    CHECK((perms & (fs::perms::group_all | fs::perms::others_all)) == fs::perms::none);
+    perms = fs::status(TS::ThumbnailPathFor(source.string(), TS::Flavor::Large)).permissions();
+    CHECK((perms & (fs::perms::group_all | fs::perms::others_all)) == fs::perms::none);
+    // The temp file was renamed into place, not left behind.
+    size_t files = 0;
+    for (const auto& entry : fs::directory_iterator(root / "large")) {
+        (void)entry;
+        ++files;
+    }
+    CHECK(files == 1);
+
+    // A smaller request is served by the larger flavor
+    TS::ThumbnailInfo info;
+    CHECK(TS::Lookup(source.string(), 100, out, &info));
+    CHECK(info.uri == TS::FileUri(fs::absolute(source).string()));
+    CHECK(info.imageWidth == 4000 && info.imageHeight == 3000);
+    int w = 0, h = 0;
+    CHECK(TS::ReadPngSize(out, w, h) && w == 256 && h == 192);
+    // A larger one is not
+    CHECK(!TS::Lookup(source.string(), 300, out));
+
+    // Small originals are whole in a small thumbnail
+    const fs::path icon = work / "icon.png";
+    WriteFile(icon, "tiny");
+    CHECK(TS::Store(icon.string(), TS::Flavor::XLarge, MakePng(48, 48), 48, 48));
+    CHECK(TS::Lookup(icon.string(), 400, out));
+
+    // Touching the file invalidates the thumbnail
+    fs::last_write_time(source, fs::last_write_time(source) + std::chrono::seconds(5));
+    CHECK(!TS::Lookup(source.string(), 100, out));
+
+    TS::SetEnabled(false);
+    CHECK(!TS::Store(source.string(), TS::Flavor::Normal, MakePng(8, 8)));
+    TS::SetEnabled(true);
+
+    TS::Remove(icon.string());
+    CHECK(!TS::Lookup(icon.string(), 48, out));
+}
+
+static void TestFailureCache(const fs::path& work) {
+    TS::SetCacheRoot((work / "thumbnails").string());
+    const fs::path broken = work / "broken.pdf";
+    WriteFile(broken, "%PDF-garbage");
+    CHECK(!TS::HasFailed(broken.string()));
+    // Just written: possibly incomplete, so not marked yet
+    TS::MarkFailed(broken.string());
+    CHECK(!TS::HasFailed(broken.string()));
+    fs::last_write_time(broken, fs::last_write_time(broken) - std::chrono::seconds(60));
+    TS::MarkFailed(broken.string());
+    CHECK(TS::HasFailed(broken.string()));
+    fs::last_write_time(broken, fs::last_write_time(broken) + std::chrono::seconds(5));
+    CHECK(!TS::HasFailed(broken.string()));
+}
+
+int main() {
+    const fs::path work = fs::temp_directory_path() /
+            ("uc_thumbstore_" + std::to_string(std::chrono::steady_clock::now()
+                                                   .time_since_epoch().count()));
+    fs::create_directories(work);
+
+    TestMd5();
+    TestUriAndLayout();
+    TestPngText();
+    TestStoreAndLookup(work);
+    TestFailureCache(work);
+
+    std::error_code ec;
+    fs::remove_all(work, ec);
+
+    std::printf("%s: %d checks, %d failures\n",
+                failures == 0 ? "PASS" : "FAIL", checks, failures);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,231 @@
+// Tests/TimerQueueTest.cpp
+// Unit tests for the application's deadline-ordered timer queue (ordering,
+// stop, periodic re-arm, coalescing) plus a 10k-timer scale check.
+// Version: 1.0.0
+// Last Modified: 2026-10-18
+// Author: UltraCanvas Framework
+
+#include "UltraCanvasTimer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace UltraCanvas;
+using Clock = UltraCanvasTimerQueue::Clock;
+using std::chrono::milliseconds;
+
+static int failures = 0;
+static int checks = 0;
+
+#define CHECK(cond) do { \
+    ++checks; \
+    if (!(cond)) { \
+        ++failures; \
+        std::printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+    } \
+} while (0)
+
+static UltraCanvasTimer MakeTimer(TimerId id, Clock::time_point fire, int intervalMs = 0,
+                                  bool periodic = false) {
+    UltraCanvasTimer t;
+    t.id = id;
+    t.nextFire = fire;
+    t.interval = milliseconds(intervalMs);
+    t.periodic = periodic;
+    return t;
+}
+
+static std::vector<TimerId> Ids(const UltraCanvasTimerQueue::DueList& due) {
+    std::vector<TimerId> ids;
+    for (const auto& d : due) ids.push_back(d.first);
+    return ids;
+}
+
+static void TestOrderAndStop() {
+    const Clock::time_point t0 = Clock::now();
+    UltraCanvasTimerQueue q;
+    q.SetCoalescingSlack(milliseconds(0));
+    CHECK(q.NextDeadline() == Clock::time_point::max());
+
+    q.Add(MakeTimer(1, t0 + milliseconds(30)));
+    q.Add(MakeTimer(2, t0 + milliseconds(10)));
+    q.Add(MakeTimer(3, t0 + milliseconds(20)));
+    q.Add(MakeTimer(4, t0 + milliseconds(10)));
+    CHECK(q.Size() == 4);
+    CHECK(q.NextDeadline() == t0 + milliseconds(10));
+
+    CHECK(q.Remove(2));
+    CHECK(!q.Remove(2));
+    CHECK(!q.Contains(2));
+    CHECK(q.NextDeadline() == t0 + milliseconds(10));   // timer 4
+
+    UltraCanvasTimerQueue::DueList due;
+    q.CollectDue(t0 + milliseconds(5), due);
+    CHECK(due.empty());
+    q.CollectDue(t0 + milliseconds(25), due);
+    CHECK((Ids(due) == std::vector<TimerId>{4, 3}));
+    CHECK(q.Size() == 1);
+    CHECK(q.NextDeadline() == t0 + milliseconds(30));
+}
+
+static void TestCallbacks() {
+    const Clock::time_point t0 = Clock::now();
+    UltraCanvasTimerQueue q;
+    int fired = 0;
+    auto t = MakeTimer(7, t0);
+    t.callback = [&fired](TimerId id) { fired += static_cast<int>(id); };
+    q.Add(std::move(t));
+
+    UltraCanvasTimerQueue::DueList due;
+    q.CollectDue(t0, due);
+    CHECK(due.size() == 1 && due[0].second);
+    if (!due.empty() && due[0].second) due[0].second(due[0].first);
+    CHECK(fired == 7);
+    CHECK(q.Empty());
+}
+
+static void TestPeriodic() {
+    const Clock::time_point t0 = Clock::now();
+    UltraCanvasTimerQueue q;
+    q.SetCoalescingSlack(milliseconds(0));
+    q.Add(MakeTimer(1, t0 + milliseconds(10), 10, true));
+
+    UltraCanvasTimerQueue::DueList due;
+    q.CollectDue(t0 + milliseconds(10), due);
+    CHECK(due.size() == 1);
+    CHECK(q.NextDeadline() == t0 + milliseconds(20));
+
+    // Fell behind by several periods: fires once, then re-arms in the future
+    // on the original cadence.
+    due.clear();
+    q.CollectDue(t0 + milliseconds(55), due);
+    CHECK(due.size() == 1);
+    CHECK(q.NextDeadline() == t0 + milliseconds(60));
+
+    // A zero period must not spin.
+    q.Add(MakeTimer(2, t0, 0, true));
+    due.clear();
+    q.CollectDue(t0 + milliseconds(55), due);
+    CHECK(due.size() == 1);
+}
+
+static void TestCoalescing() {
+    const Clock::time_point t0 = Clock::now();
+    UltraCanvasTimerQueue q;
+    q.SetCoalescingSlack(milliseconds(2));
+    q.Add(MakeTimer(1, t0 + milliseconds(10)));
+    q.Add(MakeTimer(2, t0 + std::chrono::microseconds(10500)));
+    q.Add(MakeTimer(3, t0 + milliseconds(12)));
+    q.Add(MakeTimer(4, t0 + std::chrono::microseconds(12100)));
+
+    // One wake-up at the first deadline runs everything within the slack.
+    UltraCanvasTimerQueue::DueList due;
+    q.CollectDue(t0 + milliseconds(10), due);
+    CHECK((Ids(due) == std::vector<TimerId>{1, 2, 3}));
+    CHECK(q.Size() == 1);
+}
+
+// Randomized against a sorted reference: every operation mix must yield the
+// same firing order.
+static void TestAgainstReference() {
+    const Clock::time_point t0 = Clock::now();
+    std::mt19937 rng(42);
+    UltraCanvasTimerQueue q;
+    q.SetCoalescingSlack(milliseconds(0));
+    std::vector<std::pair<Clock::time_point, TimerId>> reference;
+
+    for (TimerId id = 1; id <= 2000; id++) {
+        auto fire = t0 + milliseconds(rng() % 500);
+        q.Add(MakeTimer(id, fire));
+        reference.emplace_back(fire, id);
+        if (id % 3 == 0) {
+            const TimerId victim = 1 + rng() % id;
+            const bool had = q.Remove(victim);
+            auto it = std::find_if(reference.begin(), reference.end(),
+                                   [victim](const auto& r) { return r.second == victim; });
+            CHECK(had == (it != reference.end()));
+            if (it != reference.end()) reference.erase(it);
+        }
+    }
+    std::sort(reference.begin(), reference.end());
+
+    UltraCanvasTimerQueue::DueList due;
+    for (int ms = 0; ms < 500; ms += 7) q.CollectDue(t0 + milliseconds(ms), due);
+    q.CollectDue(t0 + milliseconds(500), due);
+
+    std::vector<TimerId> expected;
+    for (const auto& r : reference) expected.push_back(r.second);
+    CHECK(Ids(due) == expected);
+    CHECK(q.Empty());
+}
+
+static double ElapsedMs(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// 10k concurrent timers: a typical dashboard mix of 16 ms animations, 250 ms
+// pollers and 500 ms carets, plus steady stop / restart churn. Prints the
+// per-operation cost; the ceilings only guard against losing the heap.
+static void TestScale() {
+    const int kTimers = 10000;
+    const Clock::time_point t0 = Clock::now();
+    UltraCanvasTimerQueue q;
+    std::mt19937 rng(7);
+    const int periods[] = {16, 250, 500};
+
+    auto start = Clock::now();
+    for (int i = 0; i < kTimers; i++) {
+        const int period = periods[i % 3];
+        q.Add(MakeTimer(static_cast<TimerId>(i + 1), t0 + milliseconds(1 + rng() % period), period, true));
+    }
+    const double addMs = ElapsedMs(start);
+
+    // An idle loop only asks for the next deadline.
+    start = Clock::now();
+    Clock::time_point sink = Clock::time_point::min();
+    for (int i = 0; i < 100000; i++) sink = std::max(sink, q.NextDeadline());
+    const double peekMs = ElapsedMs(start);
+    CHECK(sink != Clock::time_point::max());
+
+    // Two simulated seconds of 1 ms loop iterations.
+    start = Clock::now();
+    size_t fired = 0;
+    UltraCanvasTimerQueue::DueList due;
+    for (int ms = 1; ms <= 2000; ms++) {
+        due.clear();
+        q.CollectDue(t0 + milliseconds(ms), due);
+        fired += due.size();
+        // Stop and restart a few timers per iteration (carets, hovers).
+        for (int k = 0; k < 5; k++) {
+            const TimerId id = 1 + rng() % kTimers;
+            q.Remove(id);
+            q.Add(MakeTimer(id, t0 + milliseconds(ms + 1 + rng() % 100), periods[id % 3], true));
+        }
+    }
+    const double runMs = ElapsedMs(start);
+    CHECK(q.Size() == static_cast<size_t>(kTimers));
+    CHECK(fired > static_cast<size_t>(kTimers));
+
+    std::printf("  10k timers: add %.2f ms, 100k next-deadline %.2f ms, "
+                "2000 loop iterations (%zu fires, 10k stop/start) %.2f ms\n",
+                addMs, peekMs, fired, runMs);
+    CHECK(addMs < 500.0);
+    CHECK(peekMs < 500.0);
+    CHECK(runMs < 5000.0);
+}
+
+int main() {
+    TestOrderAndStop();
+    TestCallbacks();
+    TestPeriodic();
+    TestCoalescing();
+    TestAgainstReference();
+    TestScale();
+
+    std::printf("%s: %d checks, %d failures\n",
+                failures == 0 ? "PASS" : "FAIL", checks, failures);
+    return failures == 0 ? 0 : 1;
+}
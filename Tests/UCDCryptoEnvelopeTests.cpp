@@ -194,6 +194,76 @@ int main() {
           "a 512 KiB body can be opened");
     Check(largeOpened == large, "a 512 KiB body round-trips exactly");
 
+    // ===== Streaming envelope (version 2) =====
+    std::printf("Streaming envelope\n");
+    std::vector<uint8_t> bigBody(300 * 1024 + 17);
+    for (size_t i = 0; i < bigBody.size(); ++i) bigBody[i] = static_cast<uint8_t>(i * 31 + (i >> 9));
+
+    size_t readPos = 0;
+    std::vector<uint8_t> streamed;
+    UltraCryptStreamReader reader = [&](uint8_t* buffer, size_t capacity, size_t& outRead) {
+        outRead = std::min(capacity, bigBody.size() - readPos);
+        std::memcpy(buffer, bigBody.data() + readPos, outRead);
+        readPos += outRead;
+        return true;
+    };
+    UltraCryptStreamWriter writer = [&](const uint8_t* data, size_t size) {
+        streamed.insert(streamed.end(), data, data + size);
+        return true;
+    };
+    Check(UCDCrypto::SealStream(reader, writer, password, header, error),
+          "SealStream succeeds: " + error);
+    Check(streamed[4] == 2, "streaming envelope version is 2");
+    Check(streamed.size() == UCDCrypto::GetStreamEnvelopeHeaderSize() +
+                                 UltraCrypt_GetStreamSize(bigBody.size(), 64 * 1024),
+          "streaming envelope is header + UltraCrypt stream");
+    Check(std::search(streamed.begin(), streamed.end(), bigBody.begin(), bigBody.begin() + 256) ==
+              streamed.end(),
+          "the plaintext does not appear in the streaming envelope");
+
+    std::vector<uint8_t> streamOpened;
+    Check(UCDCrypto::Open(streamed, password, header, streamOpened, error),
+          "Open reads a streaming envelope: " + error);
+    Check(streamOpened == bigBody, "the streaming envelope round-trips through Open");
+
+    size_t openPos = 0;
+    std::vector<uint8_t> streamOut;
+    UltraCryptStreamReader envelopeReader = [&](uint8_t* buffer, size_t capacity, size_t& outRead) {
+        outRead = std::min(capacity, streamed.size() - openPos);
+        std::memcpy(buffer, streamed.data() + openPos, outRead);
+        openPos += outRead;
+        return true;
+    };
+    UltraCryptStreamWriter outWriter = [&](const uint8_t* data, size_t size) {
+        streamOut.insert(streamOut.end(), data, data + size);
+        return true;
+    };
+    Check(UCDCrypto::OpenStream(envelopeReader, outWriter, password, header, error),
+          "OpenStream succeeds: " + error);
+    Check(streamOut == bigBody, "the streaming envelope round-trips through OpenStream");
+
+    std::string streamWrongPassword;
+    Check(!UCDCrypto::Open(streamed, "wrong password", header, out, streamWrongPassword),
+          "a wrong password is rejected by the streaming envelope");
+    Check(out.empty(), "a rejected streaming envelope yields no output");
+    Check(streamWrongPassword == wrongPasswordError,
+          "the streaming envelope reports the same undifferentiated message");
+
+    std::vector<uint8_t> s1 = streamed;
+    s1[s1.size() / 2] ^= 0x01;
+    expectRejected(s1, header, "a flipped bit in a streamed chunk");
+
+    std::vector<uint8_t> s2 = streamed;
+    s2[20] ^= 0x01;                       // inside the salt
+    expectRejected(s2, header, "a flipped salt bit in a streaming envelope");
+
+    const size_t chunkEnd = UCDCrypto::GetStreamEnvelopeHeaderSize() +
+                            UltraCrypt_GetStreamHeaderSize() + 2 * (64 * 1024 + 16);
+    std::vector<uint8_t> s3(streamed.begin(), streamed.begin() + chunkEnd);
+    expectRejected(s3, header, "a streaming envelope cut at a chunk boundary");
+
+    expectRejected(streamed, FileHeader(2, 1), "a streaming envelope with a modified file header");
+
     std::printf("\n%d checks, %d failure(s)\n", g_checks, g_failures);
     return g_failures == 0 ? 0 : 1;
 }
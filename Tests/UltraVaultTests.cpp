@@ -9,13 +9,22 @@
 //    persistence across Shutdown/Initialize, wrong passphrase and a tampered
 //    file both reported as AccessDenied with identical messages (no oracle),
 //    fresh-vault creation, Delete persistence
+//  - batches: staging order, all-or-nothing commits
+//  - append-only log: appends leave written bytes untouched, truncation at
+//    every offset opens at a commit boundary or is refused, torn and
+//    zero-filled tails, damaged and dropped records, background and explicit
+//    compaction, v1 migration, and a bulk-import timing print
 //
 // Author: UltraCanvas Framework / ULTRA OS
 #include "UltraVault/UltraVault.h"
 #include "UltraCrypt/UltraCryptCore.h"
 
+#include <algorithm>
+#include <chrono>
 #include <cstdio>
 #include <fstream>
+#include <iterator>
+#include <map>
 #include <string>
 #include <vector>
 
@@ -173,14 +182,295 @@ static void TestFileBackend(const std::string& vaultPath) {
     std::remove(vaultPath.c_str());
 }
 
+static void TestBatches() {
+    std::printf("batches\n");
+    UltraVault::Config config;
+    config.backend = UltraVault::Backend::Memory;
+    UltraVault::Initialize(config);
+
+    UltraVault::Batch batch;
+    batch.Put("app.one", UltraVault::SecretValue::FromString("1"));
+    batch.Put("app.two", UltraVault::SecretValue::FromString("2"));
+    batch.Put("app.gone", UltraVault::SecretValue::FromString("x"));
+    batch.Delete("app.gone");                  // applies in staging order
+    Check(batch.GetSize() == 4, "batch stages operations");
+    Check(UltraVault::Commit(batch).IsOk(), "Commit");
+    Check(batch.IsEmpty(), "a committed batch is cleared");
+    Check(UltraVault::List("app.").size() == 2, "batch applied");
+
+    // All or nothing: a failing operation undoes the ones before it.
+    batch.Put("app.one", UltraVault::SecretValue::FromString("changed"));
+    batch.Put("app.three", UltraVault::SecretValue::FromString("3"));
+    batch.Delete("app.missing");
+    Check(UltraVault::Commit(batch).code == UltraVault::ResultCode::NotFound,
+          "Delete of a missing key fails the batch");
+    Check(batch.GetSize() == 3, "a failed batch is left for the caller");
+    UltraVault::SecretValue value;
+    UltraVault::Get("app.one", value);
+    Check(value.AsString() == "1" &&
+              UltraVault::Get("app.three", value).code == UltraVault::ResultCode::NotFound,
+          "a failed batch changes nothing");
+    batch.Clear();
+    batch.Put("bad key", UltraVault::SecretValue::FromString("x"));
+    Check(UltraVault::Commit(batch).code == UltraVault::ResultCode::InvalidKey,
+          "batch keys are validated");
+    UltraVault::Shutdown();
+    batch.Clear();
+    batch.Put("app.one", UltraVault::SecretValue::FromString("x"));
+    Check(UltraVault::Commit(batch).code == UltraVault::ResultCode::Locked,
+          "Commit on a closed vault is Locked");
+}
+
+static UltraVault::Result OpenFileVault(const std::string& path) {
+    UltraVault::Config config;
+    config.backend    = UltraVault::Backend::File;
+    config.filePath   = path;
+    config.passphrase = "correct horse";
+    return UltraVault::Initialize(config);
+}
+
+static std::vector<uint8_t> ReadAll(const std::string& path) {
+    std::ifstream f(path, std::ios::binary);
+    return std::vector<uint8_t>((std::istreambuf_iterator<char>(f)),
+                                std::istreambuf_iterator<char>());
+}
+
+static void WriteAll(const std::string& path, const std::vector<uint8_t>& bytes) {
+    std::ofstream f(path, std::ios::binary | std::ios::trunc);
+    f.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+}
+
+// Key -> value of every secret in the open vault.
+static std::map<std::string, std::string> Snapshot() {
+    std::map<std::string, std::string> out;
+    for (const auto& key : UltraVault::List()) {
+        UltraVault::SecretValue value;
+        UltraVault::Get(key, value);
+        out[key] = value.AsString();
+    }
+    return out;
+}
+
+static void TestFileLog(const std::string& vaultPath) {
+    std::printf("file backend: append-only log and crash recovery\n");
+    std::remove(vaultPath.c_str());
+    OpenFileVault(vaultPath);
+
+    // Each commit appends; the bytes already written never change.
+    std::vector<size_t> ends;                             // file size after each commit
+    std::vector<std::map<std::string, std::string>> states;
+    auto committed = [&]() {
+        ends.push_back(ReadAll(vaultPath).size());
+        states.push_back(Snapshot());
+    };
+    UltraVault::Put("ai.a.key", UltraVault::SecretValue::FromString("alpha"));
+    committed();
+    const std::vector<uint8_t> first = ReadAll(vaultPath);
+    UltraVault::Put("ai.b.key", UltraVault::SecretValue::FromString("bravo"));
+    committed();
+    const std::vector<uint8_t> second = ReadAll(vaultPath);
+    Check(second.size() > first.size() &&
+              std::equal(first.begin(), first.end(), second.begin()),
+          "a Put appends to the file instead of rewriting it");
+    UltraVault::Batch batch;
+    batch.Put("ai.c.key", UltraVault::SecretValue::FromString("charlie"));
+    batch.Put("ai.d.key", UltraVault::SecretValue::FromString("delta"));
+    batch.Delete("ai.a.key");
+    UltraVault::Commit(batch);
+    committed();
+    UltraVault::Put("ai.b.key", UltraVault::SecretValue::FromString("bravo-2"));
+    committed();
+    UltraVault::Delete("ai.c.key");
+    committed();
+    UltraVault::Shutdown();
+
+    OpenFileVault(vaultPath);
+    Check(Snapshot() == states.back(), "the log replays to the last state");
+    UltraVault::Shutdown();
+
+    // Truncate the log everywhere a crash could: every open either fails
+    // (the snapshot record is incomplete) or shows exactly the commits that
+    // were wholly written.
+    const std::vector<uint8_t> full = ReadAll(vaultPath);
+    bool allConsistent = true;
+    int opened = 0, refused = 0;
+    for (size_t cut = 0; cut < full.size(); cut += (cut < ends[0] ? 23 : 7)) {
+        WriteAll(vaultPath, std::vector<uint8_t>(full.begin(), full.begin() + static_cast<long>(cut)));
+        UltraVault::Result r = OpenFileVault(vaultPath);
+        if (cut < ends[0]) {
+            allConsistent &= r.code == UltraVault::ResultCode::AccessDenied;
+            ++refused;
+        } else {
+            size_t k = 0;
+            while (k + 1 < ends.size() && ends[k + 1] <= cut) ++k;
+            allConsistent &= r.IsOk() && Snapshot() == states[k];
+            ++opened;
+        }
+        UltraVault::Shutdown();
+    }
+    Check(allConsistent, "every truncation opens at a commit boundary or is refused");
+    Check(opened > 10 && refused > 3, "truncation covered both the snapshot and the commits");
+
+    // After a torn append the next commit cuts the torn bytes off first.
+    WriteAll(vaultPath, std::vector<uint8_t>(full.begin(), full.begin() + static_cast<long>(ends[2] + 9)));
+    OpenFileVault(vaultPath);
+    Check(UltraVault::Put("ai.e.key", UltraVault::SecretValue::FromString("echo")).IsOk(),
+          "Put after a torn append");
+    UltraVault::Shutdown();
+    OpenFileVault(vaultPath);
+    auto expected = states[2];
+    expected["ai.e.key"] = "echo";
+    Check(Snapshot() == expected, "the torn record is replaced, not replayed");
+    UltraVault::Shutdown();
+
+    // A zero-filled tail (crash after the size grew) is also a torn append.
+    std::vector<uint8_t> zeroTail = full;
+    zeroTail.insert(zeroTail.end(), 40, 0);
+    WriteAll(vaultPath, zeroTail);
+    Check(OpenFileVault(vaultPath).IsOk() && Snapshot() == states.back(),
+          "a zero-filled tail is ignored");
+    UltraVault::Shutdown();
+
+    // A damaged complete record is tampering, wherever it is.
+    std::vector<uint8_t> damaged = full;
+    damaged[ends[1] + 40] ^= 0x01;
+    WriteAll(vaultPath, damaged);
+    Check(OpenFileVault(vaultPath).code == UltraVault::ResultCode::AccessDenied,
+          "a flipped bit in a middle record is AccessDenied");
+    std::vector<uint8_t> swapped(full.begin(), full.begin() + static_cast<long>(ends[0]));
+    swapped.insert(swapped.end(), full.begin() + static_cast<long>(ends[1]), full.begin() + static_cast<long>(ends[2]));
+    WriteAll(vaultPath, swapped);
+    Check(OpenFileVault(vaultPath).code == UltraVault::ResultCode::AccessDenied,
+          "a dropped record is AccessDenied");
+    std::remove(vaultPath.c_str());
+}
+
+static void TestCompaction(const std::string& vaultPath) {
+    std::printf("file backend: compaction\n");
+    std::remove(vaultPath.c_str());
+    OpenFileVault(vaultPath);
+
+    // 20 keys rewritten 40 times: 800 KiB appended, 20 KiB live.
+    const std::string filler(1024, 'v');
+    std::map<std::string, std::string> expected;
+    for (int round = 0; round < 40; ++round) {
+        for (int k = 0; k < 20; ++k) {
+            const std::string key = "app.key" + std::to_string(k);
+            const std::string value = filler + std::to_string(round);
+            UltraVault::Put(key, UltraVault::SecretValue::FromString(value));
+            expected[key] = value;
+        }
+    }
+    UltraVault::Shutdown();      // waits for a running compaction
+    const size_t grown = ReadAll(vaultPath).size();
+    Check(grown < 200 * 1024, "background compaction bounds the log");
+
+    OpenFileVault(vaultPath);
+    Check(Snapshot() == expected, "state survives background compaction");
+    Check(UltraVault::Compact().IsOk(), "Compact");
+    const size_t compacted = ReadAll(vaultPath).size();
+    Check(compacted < 24 * 1024 && compacted <= grown, "Compact leaves only the live records");
+    UltraVault::Put("app.after", UltraVault::SecretValue::FromString("x"));
+    expected["app.after"] = "x";
+    UltraVault::Shutdown();
+    OpenFileVault(vaultPath);
+    Check(Snapshot() == expected, "state survives Compact and later appends");
+    UltraVault::Shutdown();
+    std::remove(vaultPath.c_str());
+}
+
+// A vault written by v0.1 (single sealed payload) still opens, and the
+// first change rewrites it as a log.
+static void TestV1Migration(const std::string& vaultPath) {
+    std::printf("file backend: v1 migration\n");
+    UltraCryptKdfParams kdf = UltraCrypt_RecommendedKdfParams();
+    UltraCryptSecureBuffer key;
+    UltraCryptSecureBuffer pass("correct horse", 13);
+    UltraCrypt_DeriveKeyFromPassword(pass, kdf, key);
+    auto u32 = [](std::vector<uint8_t>& out, uint32_t v) {
+        for (int i = 0; i < 4; ++i) out.push_back(static_cast<uint8_t>(v >> (8 * i)));
+    };
+    auto str = [&u32](std::vector<uint8_t>& out, const std::string& s) {
+        u32(out, static_cast<uint32_t>(s.size()));
+        out.insert(out.end(), s.begin(), s.end());
+    };
+    std::vector<uint8_t> payload;
+    u32(payload, 1);
+    str(payload, "ai.legacy.key");
+    str(payload, "text/plain");
+    str(payload, "old-secret");
+    str(payload, "");
+    u32(payload, 0);
+    payload.push_back(0);
+
+    UltraCryptAeadParams aead;
+    aead.nonce.resize(UltraCrypt_GetNonceSize(aead.algorithm));
+    UltraCrypt_RandomBytes(aead.nonce.data(), aead.nonce.size());
+    std::vector<uint8_t> file = {'U', 'V', 'L', 'T', 1};
+    u32(file, kdf.iterations);
+    u32(file, kdf.memoryKiB);
+    file.push_back(static_cast<uint8_t>(kdf.salt.size()));
+    file.insert(file.end(), kdf.salt.begin(), kdf.salt.end());
+    file.push_back(static_cast<uint8_t>(aead.nonce.size()));
+    file.insert(file.end(), aead.nonce.begin(), aead.nonce.end());
+    aead.associatedData = file;
+    std::vector<uint8_t> ciphertext;
+    UltraCrypt_AeadSeal(key, aead, payload.data(), payload.size(), ciphertext);
+    file.insert(file.end(), ciphertext.begin(), ciphertext.end());
+    WriteAll(vaultPath, file);
+
+    Check(OpenFileVault(vaultPath).IsOk(), "a v1 vault opens");
+    UltraVault::SecretValue value;
+    Check(UltraVault::Get("ai.legacy.key", value).IsOk() && value.AsString() == "old-secret",
+          "v1 secrets are readable");
+    UltraVault::Put("ai.new.key", UltraVault::SecretValue::FromString("new"));
+    UltraVault::Shutdown();
+    Check(ReadAll(vaultPath)[4] == 2, "the first change rewrites the file as v2");
+    OpenFileVault(vaultPath);
+    Check(UltraVault::List().size() == 2, "migrated vault keeps every secret");
+    UltraVault::Shutdown();
+    std::remove(vaultPath.c_str());
+}
+
+static void BenchmarkBulkImport(const std::string& vaultPath) {
+    std::printf("file backend: bulk import\n");
+    std::remove(vaultPath.c_str());
+    OpenFileVault(vaultPath);
+    const auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < 1000; ++i) {
+        UltraVault::Put("import.single" + std::to_string(i),
+                        UltraVault::SecretValue::FromString("otpauth://totp/secret" + std::to_string(i)));
+    }
+    const auto t1 = std::chrono::steady_clock::now();
+    UltraVault::Batch batch;
+    for (int i = 0; i < 10000; ++i) {
+        batch.Put("import.batch" + std::to_string(i),
+                  UltraVault::SecretValue::FromString("otpauth://totp/secret" + std::to_string(i)));
+    }
+    Check(UltraVault::Commit(batch).IsOk(), "10k-entry batch commits");
+    const auto t2 = std::chrono::steady_clock::now();
+    Check(UltraVault::List("import.").size() == 11000, "every imported secret is listed");
+    UltraVault::Shutdown();
+    auto ms = [](auto a, auto b) { return std::chrono::duration<double, std::milli>(b - a).count(); };
+    std::printf("  1000 single Puts %.1f ms (%.3f ms each), one 10k batch %.1f ms, "
+                "log %zu KiB\n", ms(t0, t1), ms(t0, t1) / 1000.0, ms(t1, t2),
+                ReadAll(vaultPath).size() / 1024);
+    std::remove(vaultPath.c_str());
+}
+
 int main() {
     std::printf("UltraVault tests\n");
 
     TestMemoryBackend();
+    TestBatches();
 
     UltraCrypt_Initialize();
     if (UltraCrypt_IsAvailable()) {
         TestFileBackend("ultravault_test.vault");
+        TestFileLog("ultravault_test.vault");
+        TestCompaction("ultravault_test.vault");
+        TestV1Migration("ultravault_test.vault");
+        BenchmarkBulkImport("ultravault_test.vault");
     } else {
         std::printf("file backend: SKIPPED (UltraCrypt backend "
                     "unavailable — built without libsodium)\n");
@@ -0,0 +1,212 @@
+// Tests/VectorSpatialIndexTest.cpp
+// Unit tests for the vector renderer's BVH: rectangle and point queries
+// against brute force, result order, unbounded items and degenerate inputs.
+// Version: 1.0.0
+// Last Modified: 2026-10-18
+// Author: UltraCanvas Framework
+
+#include "UltraCanvasVectorSpatialIndex.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace UltraCanvas;
+
+static int failures = 0;
+static int checks = 0;
+
+#define CHECK(cond) do { \
+    ++checks; \
+    if (!(cond)) { \
+        ++failures; \
+        std::printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+    } \
+} while (0)
+
+static bool IsUnbounded(const Rect2Dd& r) {
+    return r.x == 0 && r.y == 0 && r.width == 0 && r.height == 0;
+}
+
+static std::vector<uint32_t> BruteForce(const std::vector<Rect2Dd>& rects, const Rect2Dd& q) {
+    std::vector<uint32_t> out;
+    for (uint32_t i = 0; i < rects.size(); ++i) {
+        const Rect2Dd& r = rects[i];
+        if (IsUnbounded(r) ||
+            !(r.x + r.width < q.x || r.y + r.height < q.y || r.x > q.x + q.width || r.y > q.y + q.height))
+            out.push_back(i);
+    }
+    return out;
+}
+
+static std::vector<Rect2Dd> RandomRects(size_t count, double extent, double maxSize, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> pos(0.0, extent);
+    std::uniform_real_distribution<double> size(0.5, maxSize);
+    std::vector<Rect2Dd> rects(count);
+    for (auto& r : rects) r = Rect2Dd(pos(rng), pos(rng), size(rng), size(rng));
+    return rects;
+}
+
+static void TestEmpty() {
+    VectorBVH bvh;
+    bvh.Build({});
+    std::vector<uint32_t> out{42};
+    bvh.Query(Rect2Dd(0, 0, 100, 100), out);
+    CHECK(out.empty());
+    CHECK(bvh.GetItemCount() == 0);
+    CHECK(bvh.GetNodeCount() == 0);
+}
+
+static void TestAgainstBruteForce() {
+    const auto rects = RandomRects(5000, 10000.0, 200.0, 7);
+    VectorBVH bvh;
+    bvh.Build(rects);
+    CHECK(bvh.GetItemCount() == rects.size());
+    CHECK(bvh.GetNodeCount() > 1);
+
+    const Rect2Dd bounds = bvh.GetBounds();
+    bool allInside = true;
+    for (const auto& r : rects) {
+        allInside &= r.x >= bounds.x && r.y >= bounds.y &&
+                     r.x + r.width <= bounds.x + bounds.width + 1e-9 &&
+                     r.y + r.height <= bounds.y + bounds.height + 1e-9;
+    }
+    CHECK(allInside);
+
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<double> pos(-500.0, 10500.0);
+    std::uniform_real_distribution<double> size(0.0, 3000.0);
+    bool allMatch = true, allSorted = true;
+    uint32_t visited = 0;
+    std::vector<uint32_t> out;
+    for (int q = 0; q < 200; ++q) {
+        const Rect2Dd query(pos(rng), pos(rng), size(rng), size(rng));
+        bvh.Query(query, out, &visited);
+        allSorted &= std::is_sorted(out.begin(), out.end());
+        allMatch &= out == BruteForce(rects, query);
+    }
+    CHECK(allMatch);
+    CHECK(allSorted);
+    CHECK(visited > 0);
+
+    // A query covering everything returns every item exactly once.
+    bvh.Query(Rect2Dd(-1e6, -1e6, 2e6, 2e6), out);
+    CHECK(out.size() == rects.size());
+    CHECK(std::adjacent_find(out.begin(), out.end()) == out.end());
+
+    // A small query visits a small part of the tree.
+    visited = 0;
+    bvh.Query(Rect2Dd(5000, 5000, 10, 10), out, &visited);
+    CHECK(visited < bvh.GetNodeCount() / 4);
+}
+
+static void TestPointQuery() {
+    const std::vector<Rect2Dd> rects = {
+        Rect2Dd(0, 0, 10, 10),
+        Rect2Dd(5, 5, 10, 10),
+        Rect2Dd(20, 20, 5, 5),
+        Rect2Dd(9, 0, 1, 1),
+    };
+    VectorBVH bvh;
+    bvh.Build(rects);
+    std::vector<uint32_t> out;
+    bvh.QueryPoint(Point2Dd(7, 7), out);
+    CHECK((out == std::vector<uint32_t>{0, 1}));
+    bvh.QueryPoint(Point2Dd(10, 0), out);             // edges count
+    CHECK((out == std::vector<uint32_t>{0, 3}));
+    bvh.QueryPoint(Point2Dd(17, 17), out);
+    CHECK(out.empty());
+    CHECK(bvh.GetItemBounds(2).x == 20);
+}
+
+static void TestUnboundedItems() {
+    auto rects = RandomRects(100, 1000.0, 20.0, 3);
+    rects[17] = Rect2Dd();
+    rects[64] = Rect2Dd();
+    VectorBVH bvh;
+    bvh.Build(rects);
+    std::vector<uint32_t> out;
+    bvh.Query(Rect2Dd(-100, -100, 1, 1), out);         // nowhere near any bounded item
+    CHECK((out == std::vector<uint32_t>{17, 64}));
+    bvh.Query(Rect2Dd(0, 0, 1000, 1000), out);
+    CHECK(out == BruteForce(rects, Rect2Dd(0, 0, 1000, 1000)));
+    CHECK(std::is_sorted(out.begin(), out.end()));
+
+    // Only unbounded items: no tree, but they are still reported.
+    VectorBVH onlyUnbounded;
+    onlyUnbounded.Build({Rect2Dd(), Rect2Dd()});
+    onlyUnbounded.Query(Rect2Dd(0, 0, 1, 1), out);
+    CHECK(out.size() == 2);
+    CHECK(onlyUnbounded.GetNodeCount() == 0);
+}
+
+static void TestDegenerate() {
+    // Identical rects cannot be separated by a split; the build must still
+    // terminate and report all of them.
+    std::vector<Rect2Dd> rects(1000, Rect2Dd(50, 50, 10, 10));
+    VectorBVH bvh;
+    bvh.Build(rects);
+    std::vector<uint32_t> out;
+    bvh.Query(Rect2Dd(55, 55, 1, 1), out);
+    CHECK(out.size() == rects.size());
+    bvh.Query(Rect2Dd(0, 0, 10, 10), out);
+    CHECK(out.empty());
+
+    // Zero-area lines are bounded and found.
+    bvh.Build({Rect2Dd(0, 5, 100, 0), Rect2Dd(5, 0, 0, 100)});
+    bvh.QueryPoint(Point2Dd(5, 5), out);
+    CHECK((out == std::vector<uint32_t>{0, 1}));
+
+    // Rebuilding replaces the previous content.
+    bvh.Build({Rect2Dd(1, 1, 1, 1)});
+    CHECK(bvh.GetItemCount() == 1);
+    bvh.Query(Rect2Dd(0, 0, 1000, 1000), out);
+    CHECK(out.size() == 1);
+    bvh.Clear();
+    CHECK(bvh.GetItemCount() == 0);
+}
+
+static void BenchmarkLargeDocument() {
+    // A dense drawing (100k shapes) viewed at high zoom: the BVH should
+    // return the ~hundred visible shapes without touching the rest.
+    const auto rects = RandomRects(100000, 20000.0, 40.0, 5);
+    VectorBVH bvh;
+    auto t0 = std::chrono::steady_clock::now();
+    bvh.Build(rects);
+    auto t1 = std::chrono::steady_clock::now();
+
+    std::vector<uint32_t> out;
+    size_t found = 0;
+    uint32_t visited = 0;
+    for (int i = 0; i < 1000; ++i) {
+        bvh.Query(Rect2Dd(i * 19.0, i * 17.0, 800, 600), out, &visited);
+        found += out.size();
+    }
+    auto t2 = std::chrono::steady_clock::now();
+    size_t bruteFound = 0;
+    for (int i = 0; i < 1000; i += 100) bruteFound += BruteForce(rects, Rect2Dd(i * 19.0, i * 17.0, 800, 600)).size();
+    auto t3 = std::chrono::steady_clock::now();
+
+    auto ms = [](auto a, auto b) { return std::chrono::duration<double, std::milli>(b - a).count(); };
+    std::printf("BVH over %zu rects: build %.1f ms, 1000 viewport queries %.1f ms "
+                "(%zu hits, %u nodes visited), linear scan %.3f ms/query\n",
+                rects.size(), ms(t0, t1), ms(t1, t2), found, visited, ms(t2, t3) / 10.0);
+    CHECK(found > 0);
+    CHECK(bruteFound > 0);
+}
+
+int main() {
+    TestEmpty();
+    TestAgainstBruteForce();
+    TestPointQuery();
+    TestUnboundedItems();
+    TestDegenerate();
+    BenchmarkLargeDocument();
+
+    std::printf("%s: %d checks, %d failures\n",
+                failures == 0 ? "PASS" : "FAIL", checks, failures);
+    return failures == 0 ? 0 : 1;
+}
@@ -3,7 +3,7 @@
 // (BERT-family or decoder LLMs), no network, no credentials. Registered as
 // provider "llama-cpp".
 // Version: 0.1.0
-// Last Modified: 2026-08-21
+// Last Modified: 2026-10-18
 // Author: UltraAI Module
 #pragma once
 
@@ -22,6 +22,8 @@ namespace UltraAI {
 //   providerOptions["n_ctx"]         — context size (int, 0 = model default)
 //   providerOptions["n_threads"]     — decode threads (int, 0 = auto)
 //   providerOptions["n_gpu_layers"]  — layers to offload (int, default 0)
+//   providerOptions["n_seq_max"]     — inputs packed per batch (int,
+//                                      default 32, at most 64)
 //
 // Behavior:
 //  - Mean pooling over the sequence, L2-normalized output (cosine-ready,
@@ -29,8 +31,10 @@ namespace UltraAI {
 //  - EmbeddingRequest::dimensions truncates the native vector and
 //    re-normalizes (the text-embedding-3 convention); asking for more
 //    dimensions than the model has fails with InvalidRequest.
-//  - Inputs are processed sequentially; calls are serialized on an
-//    internal mutex (one llama_context per adapter instance).
+//  - Inputs are packed into shared batches, one sequence id each, up to
+//    n_ctx tokens or n_seq_max inputs per llama_encode / llama_decode.
+//    Calls are serialized on an internal mutex (one llama_context per
+//    adapter instance).
 std::unique_ptr<IEmbeddings> CreateLlamaEmbeddings(
     const EmbeddingsConfig& config, Error* outError = nullptr);
 
@@ -2,7 +2,7 @@
 // Local llama.cpp ITextLLM adapter: in-process GGUF inference, no network,
 // no credentials. Registered as provider "llama-cpp".
 // Version: 0.1.0
-// Last Modified: 2026-08-21
+// Last Modified: 2026-10-18
 // Author: UltraAI Module
 #pragma once
 
@@ -21,6 +21,8 @@ namespace UltraAI {
 //   providerOptions["n_ctx"]         — context size (int, 0 = model default)
 //   providerOptions["n_threads"]     — decode threads (int, 0 = auto)
 //   providerOptions["n_gpu_layers"]  — layers to offload (int, default 0)
+//   providerOptions["reuse_prefix"]  — keep the KV cache between calls
+//                                      (bool, default true)
 //
 // v0.1 scope: chat + streaming + exact CountTokens + grammar-constrained
 // output: ResponseFormat::JsonSchema compiles the request's schema to GBNF
@@ -29,6 +31,11 @@ namespace UltraAI {
 // universal valid-JSON grammar applies).
 // Tool calling is not supported yet and fails with InvalidRequest.
 //
+// Multi-turn chat: the KV cache is kept between calls. A request whose
+// templated prompt starts with the tokens already in the cache (same
+// system prompt, same earlier turns) decodes only the new suffix;
+// usage.cachedInputTokens reports how many prompt tokens were reused.
+//
 // Lifetime: keep the adapter alive until every ChatStream has delivered
 // its terminal Done/Error event (streams generate on a worker thread that
 // uses the adapter's llama context).
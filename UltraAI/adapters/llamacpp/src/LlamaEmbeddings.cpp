@@ -1,9 +1,10 @@
 // UltraAI/adapters/llamacpp/src/LlamaEmbeddings.cpp
 // llama.cpp IEmbeddings adapter: mean-pooled, L2-normalized sequence
 // embeddings from a local GGUF model. Encoder-only models (BERT family)
-// go through llama_encode, decoder models through llama_decode.
+// go through llama_encode, decoder models through llama_decode; a request's
+// inputs share batches as separate sequences.
 // Version: 0.1.0
-// Last Modified: 2026-08-21
+// Last Modified: 2026-10-18
 // Author: UltraAI Module
 
 #include "UltraAILlamaEmbeddings.h"
@@ -87,10 +88,17 @@ public:
             : static_cast<uint32_t>(std::min<int32_t>(
                   std::max(llama_model_n_ctx_train(model_), 1), 4096));
 
+        // Several inputs share one batch as separate sequences; a unified
+        // KV cache lets any of them use the whole context instead of an
+        // n_ctx / n_seq_max slice.
+        const int64_t nSeqOpt = OptionInt(config_.providerOptions, "n_seq_max", 32);
+
         llama_context_params cparams = llama_context_default_params();
         cparams.n_ctx        = nCtx;
         cparams.n_batch      = nCtx;
         cparams.n_ubatch     = nCtx;
+        cparams.n_seq_max    = static_cast<uint32_t>(std::clamp<int64_t>(nSeqOpt, 1, 64));
+        cparams.kv_unified   = true;
         cparams.embeddings   = true;
         cparams.pooling_type = LLAMA_POOLING_TYPE_MEAN;
         const int64_t threads =
@@ -151,13 +159,33 @@ public:
             dims = *request.dimensions;
         }
 
-        for (const std::string& text : request.input) {
-            EmbeddingVector v;
-            if (!EmbedOne(text, dims, v, out.usage, out.error)) {
-                out.embeddings.clear();
+        // Tokenize everything first so a bad input fails the request before
+        // any decoding happens.
+        const int32_t nBatch = static_cast<int32_t>(llama_n_batch(ctx_));
+        std::vector<std::vector<llama_token>> tokenized;
+        tokenized.reserve(request.input.size());
+        for (size_t i = 0; i < request.input.size(); ++i) {
+            tokenized.push_back(Tokenize(request.input[i]));
+            const auto& tokens = tokenized.back();
+            if (tokens.empty()) {
+                out.error.code    = ErrorCode::InvalidRequest;
+                out.error.message = "input " + std::to_string(i) +
+                                    " tokenized to zero tokens";
+                return out;
+            }
+            if (static_cast<int32_t>(tokens.size()) > nBatch) {
+                out.error.code    = ErrorCode::ContextLengthExceeded;
+                out.error.message = "input " + std::to_string(i) + " (" +
+                                    std::to_string(tokens.size()) +
+                                    " tokens) exceeds context size " +
+                                    std::to_string(nBatch);
                 return out;
             }
-            out.embeddings.push_back(std::move(v));
+        }
+
+        out.embeddings.resize(request.input.size());
+        if (!EmbedPacked(tokenized, dims, out.embeddings, out.usage, out.error)) {
+            out.embeddings.clear();
         }
         return out;
     }
@@ -188,70 +216,74 @@ private:
         return tokens;
     }
 
-    // Caller holds mutex_. Appends token usage; truncates the pooled vector
-    // to `dims` and L2-normalizes.
-    bool EmbedOne(const std::string& text, int32_t dims, EmbeddingVector& outV,
-                  TokenUsage& usage, Error& error) {
-        std::vector<llama_token> tokens = Tokenize(text);
-        if (tokens.empty()) {
-            error.code    = ErrorCode::InvalidRequest;
-            error.message = "input tokenized to zero tokens";
-            return false;
-        }
-        const int32_t nCtx = static_cast<int32_t>(llama_n_ctx(ctx_));
-        if (static_cast<int32_t>(tokens.size()) > nCtx) {
-            error.code    = ErrorCode::ContextLengthExceeded;
-            error.message = "input (" + std::to_string(tokens.size()) +
-                            " tokens) exceeds context size " +
-                            std::to_string(nCtx);
-            return false;
-        }
-
-        llama_memory_clear(llama_get_memory(ctx_), /*data=*/true);
+    // Caller holds mutex_. Packs consecutive inputs into one llama_batch,
+    // one sequence id each, until the batch holds n_batch tokens or
+    // n_seq_max sequences, then pools every sequence from that single
+    // encode/decode. Each vector is truncated to `dims` and L2-normalized.
+    bool EmbedPacked(const std::vector<std::vector<llama_token>>& tokenized,
+                     int32_t dims, std::vector<EmbeddingVector>& outV,
+                     TokenUsage& usage, Error& error) {
+        const int32_t nBatch = static_cast<int32_t>(llama_n_batch(ctx_));
+        const size_t  nSeq   = std::max<uint32_t>(llama_n_seq_max(ctx_), 1);
+        const bool encoderOnly = llama_model_has_encoder(model_) &&
+                                 !llama_model_has_decoder(model_);
 
         // Pooled embeddings need an output for every token, which
         // llama_batch_get_one does not request — build the batch manually.
-        llama_batch batch =
-            llama_batch_init(static_cast<int32_t>(tokens.size()), 0, 1);
-        for (size_t i = 0; i < tokens.size(); ++i) {
-            batch.token[i]     = tokens[i];
-            batch.pos[i]       = static_cast<llama_pos>(i);
-            batch.n_seq_id[i]  = 1;
-            batch.seq_id[i][0] = 0;
-            batch.logits[i]    = true;
-        }
-        batch.n_tokens = static_cast<int32_t>(tokens.size());
-
-        const bool encoderOnly = llama_model_has_encoder(model_) &&
-                                 !llama_model_has_decoder(model_);
-        const int32_t rc = encoderOnly ? llama_encode(ctx_, batch)
-                                       : llama_decode(ctx_, batch);
-        llama_batch_free(batch);
-        if (rc != 0) {
-            error.code    = ErrorCode::ProviderError;
-            error.message = std::string(encoderOnly ? "llama_encode"
-                                                    : "llama_decode") +
-                            " failed";
-            return false;
-        }
+        llama_batch batch = llama_batch_init(nBatch, 0, 1);
+        bool ok = true;
+        for (size_t next = 0; ok && next < tokenized.size();) {
+            const size_t first = next;
+            batch.n_tokens = 0;
+            while (next < tokenized.size() && next - first < nSeq &&
+                   batch.n_tokens + static_cast<int32_t>(tokenized[next].size()) <= nBatch) {
+                const auto seq = static_cast<llama_seq_id>(next - first);
+                for (size_t i = 0; i < tokenized[next].size(); ++i) {
+                    const int32_t at = batch.n_tokens++;
+                    batch.token[at]     = tokenized[next][i];
+                    batch.pos[at]       = static_cast<llama_pos>(i);
+                    batch.n_seq_id[at]  = 1;
+                    batch.seq_id[at][0] = seq;
+                    batch.logits[at]    = true;
+                }
+                ++next;
+            }
 
-        const float* embd = llama_get_embeddings_seq(ctx_, 0);
-        if (!embd) {
-            error.code    = ErrorCode::ProviderError;
-            error.message = "no pooled embedding produced (model may not "
-                            "support sequence embeddings)";
-            return false;
-        }
+            llama_memory_clear(llama_get_memory(ctx_), /*data=*/true);
+            const int32_t rc = encoderOnly ? llama_encode(ctx_, batch)
+                                           : llama_decode(ctx_, batch);
+            if (rc != 0) {
+                error.code    = ErrorCode::ProviderError;
+                error.message = std::string(encoderOnly ? "llama_encode"
+                                                        : "llama_decode") +
+                                " failed";
+                ok = false;
+                break;
+            }
 
-        outV.values.assign(embd, embd + dims);
-        double norm = 0.0;
-        for (float x : outV.values) norm += static_cast<double>(x) * x;
-        if (norm > 0.0) {
-            const float inv = static_cast<float>(1.0 / std::sqrt(norm));
-            for (float& x : outV.values) x *= inv;
+            for (size_t i = first; i < next; ++i) {
+                const float* embd = llama_get_embeddings_seq(
+                    ctx_, static_cast<llama_seq_id>(i - first));
+                if (!embd) {
+                    error.code    = ErrorCode::ProviderError;
+                    error.message = "no pooled embedding produced (model may "
+                                    "not support sequence embeddings)";
+                    ok = false;
+                    break;
+                }
+                std::vector<float>& values = outV[i].values;
+                values.assign(embd, embd + dims);
+                double norm = 0.0;
+                for (float x : values) norm += static_cast<double>(x) * x;
+                if (norm > 0.0) {
+                    const float inv = static_cast<float>(1.0 / std::sqrt(norm));
+                    for (float& x : values) x *= inv;
+                }
+                usage.inputTokens += static_cast<int32_t>(tokenized[i].size());
+            }
         }
-        usage.inputTokens += static_cast<int32_t>(tokens.size());
-        return true;
+        llama_batch_free(batch);
+        return ok;
     }
 
     EmbeddingsConfig config_;
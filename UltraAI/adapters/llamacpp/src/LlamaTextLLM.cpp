@@ -2,9 +2,10 @@
 // llama.cpp ITextLLM adapter: chat-template prompting, sampler-chain
 // generation, streaming with cancellation, exact token counting, and
 // GBNF-constrained JSON output. One llama_context per adapter instance;
-// calls are serialized on an internal mutex.
+// calls are serialized on an internal mutex. The KV cache outlives a call,
+// so a follow-up turn only decodes what follows the shared token prefix.
 // Version: 0.1.0
-// Last Modified: 2026-08-21
+// Last Modified: 2026-10-18
 // Author: UltraAI Module
 
 #include "UltraAILlamaTextLLM.h"
@@ -20,6 +21,7 @@
 #include <nlohmann/json.hpp>
 #endif
 
+#include <algorithm>
 #include <atomic>
 #include <cstring>
 #include <future>
@@ -172,6 +174,10 @@ public:
             return false;
         }
         vocab_ = llama_model_get_vocab(model_);
+        const auto reuse = config_.providerOptions.find("reuse_prefix");
+        if (reuse != config_.providerOptions.end()) {
+            if (const auto* b = std::get_if<bool>(&reuse->second)) reusePrefix_ = *b;
+        }
         return true;
     }
 
@@ -374,8 +380,24 @@ private:
         }
         usage.inputTokens = static_cast<int32_t>(tokens.size());
 
-        // Stateless calls: reset the context memory between requests.
-        llama_memory_clear(llama_get_memory(ctx_), /*data=*/true);
+        // Keep the KV entries of the longest prefix this prompt shares with
+        // what the context already holds (system prompt, earlier turns) and
+        // decode only the rest. The last prompt token is always decoded:
+        // sampling needs its logits.
+        size_t reused = 0;
+        if (reusePrefix_) {
+            const size_t limit = std::min(cachedTokens_.size(), tokens.size() - 1);
+            while (reused < limit && cachedTokens_[reused] == tokens[reused]) ++reused;
+        }
+        llama_memory_t memory = llama_get_memory(ctx_);
+        if (reused == 0 ||
+            !llama_memory_seq_rm(memory, 0, static_cast<llama_pos>(reused), -1)) {
+            // Some memory types (recurrent models) cannot drop a suffix.
+            llama_memory_clear(memory, /*data=*/true);
+            reused = 0;
+        }
+        cachedTokens_.resize(reused);
+        usage.cachedInputTokens = static_cast<int32_t>(reused);
 
         // Sampler chain: grammar (optional) -> top_p -> temp -> dist.
         llama_sampler* chain =
@@ -407,8 +429,28 @@ private:
             llama_sampler_chain_add(chain, llama_sampler_init_dist(seed));
         }
 
-        llama_batch batch =
-            llama_batch_get_one(tokens.data(), static_cast<int32_t>(tokens.size()));
+        // Prefill the new suffix in n_batch chunks; the last chunk is
+        // decoded by the loop below so its logits feed the first sample.
+        const size_t nBatch = std::max<uint32_t>(llama_n_batch(ctx_), 1);
+        size_t at = reused;
+        while (tokens.size() - at > nBatch) {
+            llama_batch chunk = llama_batch_get_one(tokens.data() + at,
+                                                    static_cast<int32_t>(nBatch));
+            if (llama_decode(ctx_, chunk) != 0) {
+                error.code    = ErrorCode::ProviderError;
+                error.message = "llama_decode failed";
+                finish = FinishReason::Error;
+                llama_memory_clear(memory, true);
+                cachedTokens_.clear();
+                llama_sampler_free(chain);
+                return;
+            }
+            cachedTokens_.insert(cachedTokens_.end(), tokens.begin() + at,
+                                 tokens.begin() + at + nBatch);
+            at += nBatch;
+        }
+        llama_batch batch = llama_batch_get_one(
+            tokens.data() + at, static_cast<int32_t>(tokens.size() - at));
 
         std::string generated;
         finish = FinishReason::Length;
@@ -418,8 +460,14 @@ private:
                 error.code    = ErrorCode::ProviderError;
                 error.message = "llama_decode failed";
                 finish = FinishReason::Error;
+                // The context may hold part of the batch: start clean.
+                llama_memory_clear(memory, true);
+                cachedTokens_.clear();
                 break;
             }
+            // Track exactly what the KV cache holds for the next call.
+            cachedTokens_.insert(cachedTokens_.end(), batch.token,
+                                 batch.token + batch.n_tokens);
             llama_token tok = llama_sampler_sample(chain, ctx_, -1);
             if (llama_vocab_is_eog(vocab_, tok)) {
                 finish = FinishReason::Stop;
@@ -454,6 +502,8 @@ private:
     llama_context* ctx_   = nullptr;
     const llama_vocab* vocab_ = nullptr;
     llama_token nextToken_ = 0;
+    std::vector<llama_token> cachedTokens_;     // what seq 0 of the KV holds
+    bool reusePrefix_ = true;
     std::mutex mutex_;
 };
 
@@ -10,6 +10,7 @@
 #include "UltraAIRouting.h"
 #include "UltraAITextLLM.h"
 #include "UltraAIEmbeddings.h"
+#include "UltraAIEmbeddingCache.h"
 #include "UltraAISpeechToText.h"
 #include "UltraAITextToSpeech.h"
 #include "UltraAIImageGen.h"
@@ -18,6 +19,7 @@
 #include "UltraAIVideoGen.h"
 #include "UltraAIMusicGen.h"
 #include "UltraAICodeAssist.h"
+#include "UltraAIVectorIndex.h"
 
 #define ULTRA_AI_VERSION_MAJOR 0
 #define ULTRA_AI_VERSION_MINOR 1
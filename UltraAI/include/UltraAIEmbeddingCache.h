@@ -0,0 +1,99 @@
+// UltraAI/include/UltraAIEmbeddingCache.h
+// IEmbeddings wrapper that remembers every vector it has fetched and
+// coalesces concurrent requests into provider-sized batches.
+//
+// Cache keys are content addresses: a 128-bit hash of (provider, model,
+// task type, dimensions, text). A text embedded once is never sent again,
+// across runs when a store path is given. The hash is fast, not
+// cryptographic; the cache trusts the texts it is given.
+//
+// Misses are not sent one request per caller. They queue for a short
+// window and leave as one provider call of up to maxBatchSize inputs.
+// Concurrent callers asking for the same text share one slot in the call.
+// Requests with non-empty `options` bypass both the cache and the
+// batching, because options may change the vectors.
+// Version: 0.1.0
+// Last Modified: 2026-10-18
+// Author: UltraAI Module
+#pragma once
+
+#include "UltraAIEmbeddings.h"
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace UltraAI {
+
+struct EmbeddingCacheOptions {
+    // Append-only store of cached vectors, reloaded on construction. Empty
+    // keeps the cache in memory only.
+    std::string path;
+    size_t maxEntries = 100000;                 // LRU bound; 0 -> unbounded
+
+    bool batching = true;
+    int32_t maxBatchSize = 0;                   // 0 -> provider maxBatchSize
+    std::chrono::milliseconds batchWindow{2};   // wait for more inputs
+    int32_t dispatchThreads = 2;                // provider calls in flight
+
+    // Key namespace; empty -> GetCapabilities().providerId. Set it when two
+    // configurations of one provider have different default models.
+    std::string providerId;
+};
+
+struct EmbeddingCacheStats {
+    uint64_t inputs = 0;            // texts asked for
+    uint64_t hits = 0;              // answered from the cache
+    uint64_t shared = 0;            // joined a call already in flight
+    uint64_t misses = 0;            // sent to the provider
+    uint64_t bypassed = 0;          // requests with options, passed through
+    uint64_t providerCalls = 0;
+    uint64_t largestBatch = 0;
+    uint64_t entries = 0;           // vectors currently cached
+    uint64_t storeBytes = 0;        // size of the store file
+
+    double HitRate() const {
+        return inputs ? double(hits + shared) / double(inputs) : 0.0;
+    }
+    double AverageBatchSize() const {
+        return providerCalls ? double(misses) / double(providerCalls) : 0.0;
+    }
+};
+
+class CachedEmbeddings : public IEmbeddings {
+public:
+    ~CachedEmbeddings() override;
+
+    EmbeddingProviderCapabilities GetCapabilities() const override;
+    EmbeddingResponse Embed(const EmbeddingRequest& request) override;
+    std::future<EmbeddingResponse> EmbedAsync(const EmbeddingRequest& request) override;
+    void* RawProvider() override;
+
+    IEmbeddings& Inner() const;
+    EmbeddingCacheStats GetStats() const;
+    void ResetStats();
+
+    // Writes pending records and, when most of the store is superseded,
+    // rewrites it with only the live entries.
+    Error Flush();
+    // Drops every cached vector, in memory and on disk.
+    Error Clear();
+
+private:
+    friend std::unique_ptr<CachedEmbeddings> CreateCachedEmbeddings(
+        std::shared_ptr<IEmbeddings>, const EmbeddingCacheOptions&, Error*);
+    CachedEmbeddings();
+
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+// Wraps `inner`. Returns nullptr (with *outError set) when `inner` is null
+// or the store cannot be opened. A damaged tail in the store is dropped.
+std::unique_ptr<CachedEmbeddings> CreateCachedEmbeddings(
+    std::shared_ptr<IEmbeddings> inner,
+    const EmbeddingCacheOptions& options = {},
+    Error* outError = nullptr);
+
+} // namespace UltraAI
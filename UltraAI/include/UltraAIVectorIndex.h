@@ -0,0 +1,110 @@
+// UltraAI/include/UltraAIVectorIndex.h
+// Local approximate nearest-neighbour index over embedding vectors (HNSW),
+// for semantic search without a loop over every stored vector.
+// Version: 0.1.0
+// Last Modified: 2026-10-18
+// Author: UltraAI Module
+#pragma once
+
+#include "UltraAIEmbeddings.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace UltraAI {
+
+// =====================================================================
+// Options / results
+// =====================================================================
+
+enum class VectorMetric {
+    Cosine,         // vectors are normalised on insert and query
+    InnerProduct    // raw dot product (vectors already normalised, or MIPS)
+};
+
+enum class VectorQuantization {
+    None,           // float32 storage, exact distances
+    Int8            // one signed byte per dimension plus a per-vector scale:
+                    // 4x less memory, approximate scores
+};
+
+struct VectorIndexOptions {
+    int32_t dimensions = 0;             // 0 -> taken from the first vector
+    VectorMetric metric = VectorMetric::Cosine;
+    VectorQuantization quantization = VectorQuantization::None;
+
+    // HNSW graph parameters (Malkov & Yashunin). Higher values raise recall
+    // at the cost of memory and insert / query time.
+    int32_t m = 16;                     // links per node (2*m on layer 0)
+    int32_t efConstruction = 200;       // candidate list while inserting
+    int32_t efSearch = 64;              // default candidate list per query
+    uint64_t seed = 0x5EED;             // level assignment, for reproducible graphs
+};
+
+struct VectorSearchHit {
+    uint64_t id = 0;
+    float score = 0.0f;                 // similarity; higher is closer
+};
+
+// =====================================================================
+// VectorIndex
+// =====================================================================
+// Searches may run concurrently with each other; Add / Remove / Save take
+// an exclusive lock. Removal marks the vector deleted: it stops appearing in
+// results but keeps routing searches until the index is rebuilt, which is
+// how HNSW stays connected under deletes.
+//
+// On-disk format: one file, little-endian, sections 64-byte aligned.
+// Load() memory-maps it; vectors and the layer-0 graph are read in place,
+// so a large index opens without reading it. The first Add or Remove after
+// Load copies the mapped sections into memory.
+
+class VectorIndex {
+public:
+    explicit VectorIndex(const VectorIndexOptions& options = {});
+    ~VectorIndex();
+    VectorIndex(VectorIndex&&) noexcept;
+    VectorIndex& operator=(VectorIndex&&) noexcept;
+    VectorIndex(const VectorIndex&) = delete;
+    VectorIndex& operator=(const VectorIndex&) = delete;
+
+    // Inserts `vector` under `id`; an existing id is replaced.
+    Error Add(uint64_t id, const EmbeddingVector& vector);
+    Error Add(uint64_t id, const float* values, size_t count);
+    bool Remove(uint64_t id);
+    bool Contains(uint64_t id) const;
+    void Reserve(size_t count);
+
+    size_t Size() const;                // live vectors
+    size_t DeletedCount() const;        // removed, still in the graph
+    int32_t Dimensions() const;
+    const VectorIndexOptions& Options() const;
+
+    // Up to k hits, best first. `ef` 0 -> Options().efSearch; it is raised
+    // to k when smaller.
+    std::vector<VectorSearchHit> Search(const EmbeddingVector& query, size_t k,
+                                        int32_t ef = 0) const;
+    std::vector<VectorSearchHit> Search(const float* query, size_t count,
+                                        size_t k, int32_t ef = 0) const;
+
+    // Brute-force scan with the same kernels and storage: the exact answer
+    // for this index's (possibly quantized) vectors.
+    std::vector<VectorSearchHit> SearchExact(const float* query, size_t count,
+                                             size_t k) const;
+
+    Error Save(const std::string& path) const;
+    static std::unique_ptr<VectorIndex> Load(const std::string& path,
+                                             Error* outError = nullptr);
+
+    // Dot-product kernel chosen for this CPU: "avx2", "neon" or "scalar".
+    static const char* KernelName();
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+} // namespace UltraAI
@@ -0,0 +1,632 @@
+// UltraAI/src/EmbeddingCache.cpp
+// Content-addressed embedding cache with an append-only store and a
+// micro-batching dispatcher in front of any IEmbeddings.
+// Version: 0.1.0
+// Last Modified: 2026-10-18
+// Author: UltraAI Module
+
+#include "UltraAIEmbeddingCache.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+namespace UltraAI {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// =====================================================================
+// Keys
+// =====================================================================
+
+struct Key {
+    uint64_t lo = 0;
+    uint64_t hi = 0;
+    bool operator==(const Key& o) const { return lo == o.lo && hi == o.hi; }
+};
+
+struct KeyHash {
+    size_t operator()(const Key& k) const { return static_cast<size_t>(k.lo); }
+};
+
+uint64_t Mix64(uint64_t x) {
+    x ^= x >> 30; x *= 0xBF58476D1CE4E5B9ULL;
+    x ^= x >> 27; x *= 0x94D049BB133111EBULL;
+    x ^= x >> 31;
+    return x;
+}
+
+// Two cross-fed 64-bit lanes over 8-byte words. Fields are length-prefixed
+// so ("ab","c") and ("a","bc") hash apart.
+class Hasher128 {
+public:
+    void Bytes(const void* data, size_t size) {
+        Word(size);
+        const auto* p = static_cast<const uint8_t*>(data);
+        for (; size >= 8; p += 8, size -= 8) {
+            uint64_t w;
+            std::memcpy(&w, p, 8);
+            Word(w);
+        }
+        if (size > 0) {
+            uint64_t w = 0;
+            std::memcpy(&w, p, size);
+            Word(w ^ (uint64_t(size) << 56));
+        }
+    }
+    void String(const std::string& s) { Bytes(s.data(), s.size()); }
+    void Word(uint64_t w) {
+        a_ = Mix64(a_ ^ w);
+        b_ = Mix64(b_ + w * 0x9FB21C651E98DF25ULL) ^ ((a_ << 29) | (a_ >> 35));
+    }
+    Key Finish() const { return {Mix64(a_ ^ b_), Mix64(b_ + 0x9E3779B97F4A7C15ULL)}; }
+
+private:
+    uint64_t a_ = 0x243F6A8885A308D3ULL;
+    uint64_t b_ = 0x13198A2E03707344ULL;
+};
+
+// =====================================================================
+// Store format
+// =====================================================================
+// header: "UAEC" | u32 version | u64 reserved
+// record: u32 dims | u64 key.lo | u64 key.hi | f32[dims] | u64 check
+// `check` hashes the record bytes before it; the first record that is
+// short or fails its check ends the log (a torn write) and is cut off.
+
+constexpr char     kStoreMagic[4] = {'U', 'A', 'E', 'C'};
+constexpr uint32_t kStoreVersion  = 1;
+constexpr size_t   kStoreHeader   = 16;
+constexpr size_t   kRecordFixed   = 4 + 8 + 8 + 8;
+constexpr uint32_t kMaxStoredDims = 1u << 16;
+
+uint64_t RecordCheck(const uint8_t* record, size_t size) {
+    Hasher128 h;
+    h.Bytes(record, size);
+    return h.Finish().lo;
+}
+
+void AppendRecord(std::string& out, const Key& key, const std::vector<float>& values) {
+    const size_t start = out.size();
+    const uint32_t dims = static_cast<uint32_t>(values.size());
+    out.append(reinterpret_cast<const char*>(&dims), 4);
+    out.append(reinterpret_cast<const char*>(&key.lo), 8);
+    out.append(reinterpret_cast<const char*>(&key.hi), 8);
+    out.append(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(float));
+    const uint64_t check = RecordCheck(reinterpret_cast<const uint8_t*>(out.data()) + start,
+                                       out.size() - start);
+    out.append(reinterpret_cast<const char*>(&check), 8);
+}
+
+std::string StoreHeader() {
+    std::string h(kStoreHeader, '\0');
+    std::memcpy(h.data(), kStoreMagic, 4);
+    std::memcpy(h.data() + 4, &kStoreVersion, 4);
+    return h;
+}
+
+Error MakeError(ErrorCode code, const std::string& message) {
+    Error e;
+    e.code = code;
+    e.message = message;
+    return e;
+}
+
+// One embedded text as seen by every request waiting on it.
+struct Slot {
+    EmbeddingVector vector;
+    Error error;
+    std::string model;
+    TokenUsage usage;       // this input's share of the provider call
+};
+
+} // namespace
+
+// =====================================================================
+// Impl
+// =====================================================================
+
+struct CachedEmbeddings::Impl {
+    std::shared_ptr<IEmbeddings> inner;
+    EmbeddingCacheOptions options;
+    std::string ns;
+    size_t maxBatch = 64;
+    std::string defaultModel;
+
+    struct Entry {
+        Key key;
+        std::vector<float> values;
+    };
+    struct Pending {
+        std::string group;          // inputs with equal groups share a call
+        std::string model;
+        EmbeddingTaskType taskType = EmbeddingTaskType::Default;
+        std::optional<int32_t> dimensions;
+        std::string text;
+        Key key;
+        std::promise<Slot> promise;
+        Clock::time_point enqueued;
+    };
+
+    // Cache, in-flight table, queue and stats.
+    mutable std::mutex mu;
+    std::condition_variable queueCv;
+    std::list<Entry> lru;                                   // front = newest
+    std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> entries;
+    std::unordered_map<Key, std::shared_future<Slot>, KeyHash> inFlight;
+    std::deque<std::unique_ptr<Pending>> queue;
+    std::vector<std::thread> workers;
+    bool stopping = false;
+    EmbeddingCacheStats stats;
+
+    // Store file; taken before `mu` when both are needed.
+    std::mutex storeMu;
+    std::FILE* store = nullptr;
+    uint64_t storeRecords = 0;
+    uint64_t storeBytes = 0;
+
+    ~Impl() {
+        if (store) std::fclose(store);
+    }
+
+    Key KeyFor(const std::string& model, EmbeddingTaskType task,
+               std::optional<int32_t> dims, const std::string& text) const {
+        Hasher128 h;
+        h.String(ns);
+        h.String(model);
+        h.Word(static_cast<uint64_t>(task));
+        h.Word(static_cast<uint64_t>(static_cast<uint32_t>(dims.value_or(0))));
+        h.String(text);
+        return h.Finish();
+    }
+
+    // ---- cache (mu held) ----
+
+    const Entry* Lookup(const Key& key) {
+        auto it = entries.find(key);
+        if (it == entries.end()) return nullptr;
+        lru.splice(lru.begin(), lru, it->second);
+        return &*it->second;
+    }
+
+    void Insert(const Key& key, std::vector<float> values) {
+        if (auto it = entries.find(key); it != entries.end()) {
+            it->second->values = std::move(values);
+            lru.splice(lru.begin(), lru, it->second);
+            return;
+        }
+        lru.push_front({key, std::move(values)});
+        entries[key] = lru.begin();
+        if (options.maxEntries > 0 && entries.size() > options.maxEntries) {
+            entries.erase(lru.back().key);
+            lru.pop_back();
+        }
+    }
+
+    // ---- store ----
+
+    Error OpenStore() {
+        namespace fs = std::filesystem;
+        std::string data;
+        {
+            std::ifstream in(options.path, std::ios::binary);
+            if (in) data.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        }
+        size_t good = 0;
+        if (!data.empty()) {
+            if (data.size() < kStoreHeader || std::memcmp(data.data(), kStoreMagic, 4) != 0) {
+                return MakeError(ErrorCode::UnsupportedFormat,
+                                 "not an embedding cache: " + options.path);
+            }
+            uint32_t version = 0;
+            std::memcpy(&version, data.data() + 4, 4);
+            if (version != kStoreVersion) {
+                return MakeError(ErrorCode::UnsupportedFormat,
+                                 "unsupported embedding cache version: " + options.path);
+            }
+            good = kStoreHeader;
+            const auto* bytes = reinterpret_cast<const uint8_t*>(data.data());
+            while (data.size() - good >= kRecordFixed) {
+                uint32_t dims = 0;
+                std::memcpy(&dims, bytes + good, 4);
+                if (dims > kMaxStoredDims) break;
+                const size_t body = 4 + 16 + size_t(dims) * sizeof(float);
+                if (data.size() - good < body + 8) break;
+                uint64_t check = 0;
+                std::memcpy(&check, bytes + good + body, 8);
+                if (check != RecordCheck(bytes + good, body)) break;
+                Key key;
+                std::memcpy(&key.lo, bytes + good + 4, 8);
+                std::memcpy(&key.hi, bytes + good + 12, 8);
+                std::vector<float> values(dims);
+                std::memcpy(values.data(), bytes + good + 20, size_t(dims) * sizeof(float));
+                Insert(key, std::move(values));
+                ++storeRecords;
+                good += body + 8;
+            }
+        }
+
+        std::error_code ec;
+        if (data.empty()) {
+            std::FILE* f = std::fopen(options.path.c_str(), "wb");
+            const std::string header = StoreHeader();
+            const bool ok = f && std::fwrite(header.data(), 1, header.size(), f) == header.size();
+            if (f) std::fclose(f);
+            if (!ok) return MakeError(ErrorCode::InvalidRequest,
+                                      "cannot create embedding cache: " + options.path);
+            good = kStoreHeader;
+        } else if (good < data.size()) {
+            fs::resize_file(options.path, good, ec);   // drop the torn tail
+            if (ec) return MakeError(ErrorCode::InvalidRequest,
+                                     "cannot repair embedding cache: " + options.path);
+        }
+        store = std::fopen(options.path.c_str(), "ab");
+        if (!store) return MakeError(ErrorCode::InvalidRequest,
+                                     "cannot open embedding cache: " + options.path);
+        storeBytes = good;
+        return {};
+    }
+
+    // Rewrites the store with only the cached entries, oldest first so a
+    // reload rebuilds the same LRU order. storeMu held.
+    Error CompactLocked() {
+        std::string out = StoreHeader();
+        uint64_t records = 0;
+        {
+            std::lock_guard<std::mutex> lock(mu);
+            for (auto it = lru.rbegin(); it != lru.rend(); ++it) {
+                AppendRecord(out, it->key, it->values);
+                ++records;
+            }
+        }
+        const std::string tmp = options.path + ".tmp";
+        std::FILE* f = std::fopen(tmp.c_str(), "wb");
+        bool ok = f && std::fwrite(out.data(), 1, out.size(), f) == out.size();
+        if (f) ok = (std::fclose(f) == 0) && ok;
+        if (!ok) {
+            std::remove(tmp.c_str());
+            return MakeError(ErrorCode::ProviderError, "cannot write " + tmp);
+        }
+        if (store) std::fclose(store);
+        store = nullptr;
+        std::error_code ec;
+        std::filesystem::rename(tmp, options.path, ec);
+        store = std::fopen(options.path.c_str(), "ab");
+        if (ec || !store) {
+            return MakeError(ErrorCode::ProviderError, "cannot replace " + options.path);
+        }
+        storeRecords = records;
+        storeBytes = out.size();
+        return {};
+    }
+
+    void Persist(const std::vector<std::pair<Key, const std::vector<float>*>>& fresh) {
+        if (options.path.empty() || fresh.empty()) return;
+        std::string out;
+        for (const auto& [key, values] : fresh) AppendRecord(out, key, *values);
+        std::lock_guard<std::mutex> lock(storeMu);
+        if (!store) return;
+        // One write and one flush per provider call.
+        if (std::fwrite(out.data(), 1, out.size(), store) == out.size() && std::fflush(store) == 0) {
+            storeRecords += fresh.size();
+            storeBytes += out.size();
+        }
+    }
+
+    // ---- dispatch ----
+
+    void RunBatch(std::vector<std::unique_ptr<Pending>>& batch) {
+        EmbeddingRequest req;
+        req.model = batch.front()->model;
+        req.taskType = batch.front()->taskType;
+        req.dimensions = batch.front()->dimensions;
+        req.input.reserve(batch.size());
+        for (const auto& p : batch) req.input.push_back(p->text);
+
+        EmbeddingResponse resp = inner->Embed(req);
+        if (resp.error.IsOk() && resp.embeddings.size() != batch.size()) {
+            resp.error = MakeError(ErrorCode::ProviderError,
+                                   "provider returned " + std::to_string(resp.embeddings.size()) +
+                                   " embeddings for " + std::to_string(batch.size()) + " inputs");
+        }
+
+        // Split the call's usage across its inputs by text length.
+        size_t totalChars = 0;
+        for (const auto& p : batch) totalChars += p->text.size();
+        std::vector<Slot> slots(batch.size());
+        int32_t tokensLeft = resp.usage.inputTokens;
+        for (size_t i = 0; i < batch.size(); ++i) {
+            Slot& s = slots[i];
+            s.error = resp.error;
+            s.model = resp.model;
+            s.usage.units = resp.error.IsOk() ? 1 : 0;
+            const int32_t share = i + 1 == batch.size() || totalChars == 0
+                ? tokensLeft
+                : static_cast<int32_t>(int64_t(resp.usage.inputTokens) *
+                                       int64_t(batch[i]->text.size()) / int64_t(totalChars));
+            s.usage.inputTokens = std::min(share, tokensLeft);
+            tokensLeft -= s.usage.inputTokens;
+            if (resp.error.IsOk()) s.vector = std::move(resp.embeddings[i]);
+        }
+
+        std::vector<std::pair<Key, const std::vector<float>*>> fresh;
+        {
+            std::lock_guard<std::mutex> lock(mu);
+            ++stats.providerCalls;
+            stats.largestBatch = std::max<uint64_t>(stats.largestBatch, batch.size());
+            if (resp.error.IsOk() && !resp.model.empty() && req.model.empty()) defaultModel = resp.model;
+            for (size_t i = 0; i < batch.size(); ++i) {
+                if (resp.error.IsOk()) {
+                    Insert(batch[i]->key, slots[i].vector.values);
+                    fresh.emplace_back(batch[i]->key, &slots[i].vector.values);
+                }
+                inFlight.erase(batch[i]->key);
+            }
+        }
+        Persist(fresh);
+        for (size_t i = 0; i < batch.size(); ++i) batch[i]->promise.set_value(std::move(slots[i]));
+    }
+
+    // Pulls up to maxBatch queued inputs that can share a call with the
+    // oldest one. mu held.
+    std::vector<std::unique_ptr<Pending>> TakeBatch() {
+        std::vector<std::unique_ptr<Pending>> batch;
+        const std::string group = queue.front()->group;
+        for (auto it = queue.begin(); it != queue.end() && batch.size() < maxBatch;) {
+            if ((*it)->group == group) {
+                batch.push_back(std::move(*it));
+                it = queue.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        return batch;
+    }
+
+    bool FrontBatchFull() const {
+        const std::string& group = queue.front()->group;
+        size_t count = 0;
+        for (const auto& p : queue) {
+            if (p->group == group && ++count >= maxBatch) return true;
+        }
+        return false;
+    }
+
+    void WorkerLoop() {
+        std::unique_lock<std::mutex> lock(mu);
+        for (;;) {
+            queueCv.wait(lock, [&] { return stopping || !queue.empty(); });
+            if (queue.empty()) return;                  // stopping, drained
+            // Hold the oldest input for the batch window unless a full
+            // batch is already waiting.
+            while (!stopping && !queue.empty() && !FrontBatchFull()) {
+                const auto deadline = queue.front()->enqueued + options.batchWindow;
+                if (Clock::now() >= deadline) break;
+                queueCv.wait_until(lock, deadline);
+            }
+            if (queue.empty()) continue;
+            auto batch = TakeBatch();
+            lock.unlock();
+            RunBatch(batch);
+            lock.lock();
+        }
+    }
+
+    void StopWorkers() {
+        {
+            std::lock_guard<std::mutex> lock(mu);
+            stopping = true;
+        }
+        queueCv.notify_all();
+        for (auto& t : workers) t.join();
+        workers.clear();
+    }
+};
+
+// =====================================================================
+// CachedEmbeddings
+// =====================================================================
+
+CachedEmbeddings::CachedEmbeddings() : impl_(std::make_unique<Impl>()) {}
+
+CachedEmbeddings::~CachedEmbeddings() {
+    impl_->StopWorkers();
+    Flush();
+}
+
+EmbeddingProviderCapabilities CachedEmbeddings::GetCapabilities() const {
+    return impl_->inner->GetCapabilities();
+}
+
+void* CachedEmbeddings::RawProvider() {
+    return impl_->inner->RawProvider();
+}
+
+IEmbeddings& CachedEmbeddings::Inner() const {
+    return *impl_->inner;
+}
+
+EmbeddingResponse CachedEmbeddings::Embed(const EmbeddingRequest& request) {
+    Impl& d = *impl_;
+    if (!request.options.empty() || request.input.empty()) {
+        {
+            std::lock_guard<std::mutex> lock(d.mu);
+            ++d.stats.bypassed;
+        }
+        return d.inner->Embed(request);
+    }
+
+    const size_t n = request.input.size();
+    EmbeddingResponse resp;
+    resp.embeddings.resize(n);
+    std::vector<std::shared_future<Slot>> waits(n);
+    std::vector<bool> mine(n, false);
+    std::vector<std::unique_ptr<Impl::Pending>> fresh;
+
+    std::string group = request.model;
+    group += '\x1f';
+    group += std::to_string(static_cast<int>(request.taskType));
+    group += '\x1f';
+    group += std::to_string(request.dimensions.value_or(0));
+    const auto now = Clock::now();
+
+    {
+        std::lock_guard<std::mutex> lock(d.mu);
+        d.stats.inputs += n;
+        for (size_t i = 0; i < n; ++i) {
+            const Key key = d.KeyFor(request.model, request.taskType, request.dimensions,
+                                     request.input[i]);
+            if (const auto* hit = d.Lookup(key)) {
+                resp.embeddings[i].values = hit->values;
+                ++d.stats.hits;
+            } else if (auto it = d.inFlight.find(key); it != d.inFlight.end()) {
+                waits[i] = it->second;
+                ++d.stats.shared;
+            } else {
+                auto p = std::make_unique<Impl::Pending>();
+                p->group = group;
+                p->model = request.model;
+                p->taskType = request.taskType;
+                p->dimensions = request.dimensions;
+                p->text = request.input[i];
+                p->key = key;
+                p->enqueued = now;
+                waits[i] = p->promise.get_future().share();
+                d.inFlight.emplace(key, waits[i]);
+                mine[i] = true;
+                ++d.stats.misses;
+                fresh.push_back(std::move(p));
+            }
+        }
+        if (d.options.batching && !fresh.empty()) {
+            for (auto& p : fresh) d.queue.push_back(std::move(p));
+            fresh.clear();
+            if (d.workers.empty()) {
+                const int threads = std::max(1, d.options.dispatchThreads);
+                for (int t = 0; t < threads; ++t) d.workers.emplace_back([&d] { d.WorkerLoop(); });
+            }
+        }
+    }
+    if (d.options.batching) {
+        d.queueCv.notify_all();
+    } else {
+        for (size_t at = 0; at < fresh.size(); at += d.maxBatch) {
+            std::vector<std::unique_ptr<Impl::Pending>> batch;
+            for (size_t i = at; i < std::min(fresh.size(), at + d.maxBatch); ++i) {
+                batch.push_back(std::move(fresh[i]));
+            }
+            d.RunBatch(batch);
+        }
+    }
+
+    for (size_t i = 0; i < n; ++i) {
+        if (!waits[i].valid()) continue;
+        const Slot& slot = waits[i].get();
+        if (!slot.error.IsOk()) {
+            if (resp.error.IsOk()) resp.error = slot.error;
+            continue;
+        }
+        resp.embeddings[i].values = slot.vector.values;
+        if (resp.model.empty()) resp.model = slot.model;
+        if (mine[i]) {
+            resp.usage.inputTokens += slot.usage.inputTokens;
+            resp.usage.units += slot.usage.units;
+        }
+    }
+    if (!resp.error.IsOk()) resp.embeddings.clear();
+    if (resp.model.empty()) {
+        std::lock_guard<std::mutex> lock(d.mu);
+        resp.model = request.model.empty() ? d.defaultModel : request.model;
+    }
+    return resp;
+}
+
+std::future<EmbeddingResponse> CachedEmbeddings::EmbedAsync(const EmbeddingRequest& request) {
+    return std::async(std::launch::async, [this, request]() { return Embed(request); });
+}
+
+EmbeddingCacheStats CachedEmbeddings::GetStats() const {
+    EmbeddingCacheStats s;
+    {
+        std::lock_guard<std::mutex> lock(impl_->mu);
+        s = impl_->stats;
+        s.entries = impl_->entries.size();
+    }
+    std::lock_guard<std::mutex> lock(impl_->storeMu);
+    s.storeBytes = impl_->storeBytes;
+    return s;
+}
+
+void CachedEmbeddings::ResetStats() {
+    std::lock_guard<std::mutex> lock(impl_->mu);
+    impl_->stats = {};
+}
+
+Error CachedEmbeddings::Flush() {
+    Impl& d = *impl_;
+    if (d.options.path.empty()) return {};
+    std::lock_guard<std::mutex> storeLock(d.storeMu);
+    size_t live = 0;
+    {
+        std::lock_guard<std::mutex> lock(d.mu);
+        live = d.entries.size();
+    }
+    // Compact once superseded and evicted records outnumber live ones.
+    if (d.storeRecords > 2 * live + 1024) return d.CompactLocked();
+    if (d.store && std::fflush(d.store) != 0) {
+        return MakeError(ErrorCode::ProviderError, "cannot write " + d.options.path);
+    }
+    return {};
+}
+
+Error CachedEmbeddings::Clear() {
+    Impl& d = *impl_;
+    std::lock_guard<std::mutex> storeLock(d.storeMu);
+    {
+        std::lock_guard<std::mutex> lock(d.mu);
+        d.entries.clear();
+        d.lru.clear();
+    }
+    return d.options.path.empty() ? Error{} : d.CompactLocked();
+}
+
+std::unique_ptr<CachedEmbeddings> CreateCachedEmbeddings(
+    std::shared_ptr<IEmbeddings> inner, const EmbeddingCacheOptions& options, Error* outError) {
+    Error tmp;
+    Error* err = outError ? outError : &tmp;
+    if (!inner) {
+        *err = MakeError(ErrorCode::InvalidRequest, "no embeddings provider to cache");
+        return nullptr;
+    }
+    std::unique_ptr<CachedEmbeddings> cached(new CachedEmbeddings());
+    CachedEmbeddings::Impl& d = *cached->impl_;
+    const EmbeddingProviderCapabilities caps = inner->GetCapabilities();
+    d.inner = std::move(inner);
+    d.options = options;
+    d.ns = options.providerId.empty() ? caps.providerId : options.providerId;
+    d.maxBatch = static_cast<size_t>(options.maxBatchSize > 0 ? options.maxBatchSize
+                                     : caps.maxBatchSize > 0 ? caps.maxBatchSize : 64);
+    if (!caps.models.empty()) d.defaultModel = caps.models.front().id;
+    if (!options.path.empty()) {
+        Error e = d.OpenStore();
+        if (!e.IsOk()) {
+            d.options.path.clear();             // nothing to flush on the way out
+            *err = e;
+            return nullptr;
+        }
+    }
+    *err = {};
+    return cached;
+}
+
+} // namespace UltraAI
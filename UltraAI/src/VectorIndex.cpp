@@ -0,0 +1,933 @@
+// UltraAI/src/VectorIndex.cpp
+// HNSW index over embedding vectors with SIMD dot-product kernels, optional
+// int8 storage and a memory-mapped file format.
+// Version: 0.1.0
+// Last Modified: 2026-10-18
+// Author: UltraAI Module
+
+#include "UltraAIVectorIndex.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <queue>
+#include <random>
+#include <shared_mutex>
+#include <unordered_map>
+#include <utility>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define ULTRAAI_VECTOR_AVX2 1
+#include <immintrin.h>
+#endif
+#if defined(__aarch64__) || defined(_M_ARM64)
+#define ULTRAAI_VECTOR_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace UltraAI {
+
+namespace {
+
+// =====================================================================
+// Kernels
+// =====================================================================
+
+using DotF32Fn = float (*)(const float*, const float*, size_t);
+using DotI8Fn  = int32_t (*)(const int8_t*, const int8_t*, size_t);
+
+float DotF32Scalar(const float* a, const float* b, size_t n) {
+    float s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        s0 += a[i] * b[i];
+        s1 += a[i + 1] * b[i + 1];
+        s2 += a[i + 2] * b[i + 2];
+        s3 += a[i + 3] * b[i + 3];
+    }
+    for (; i < n; ++i) s0 += a[i] * b[i];
+    return (s0 + s1) + (s2 + s3);
+}
+
+int32_t DotI8Scalar(const int8_t* a, const int8_t* b, size_t n) {
+    int32_t s = 0;
+    for (size_t i = 0; i < n; ++i) s += int32_t(a[i]) * int32_t(b[i]);
+    return s;
+}
+
+#ifdef ULTRAAI_VECTOR_AVX2
+__attribute__((target("avx2,fma")))
+float DotF32Avx2(const float* a, const float* b, size_t n) {
+    __m256 acc0 = _mm256_setzero_ps(), acc1 = _mm256_setzero_ps();
+    __m256 acc2 = _mm256_setzero_ps(), acc3 = _mm256_setzero_ps();
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i),      _mm256_loadu_ps(b + i),      acc0);
+        acc1 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i + 8),  _mm256_loadu_ps(b + i + 8),  acc1);
+        acc2 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i + 16), _mm256_loadu_ps(b + i + 16), acc2);
+        acc3 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i + 24), _mm256_loadu_ps(b + i + 24), acc3);
+    }
+    for (; i + 8 <= n; i += 8) {
+        acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), acc0);
+    }
+    const __m256 acc = _mm256_add_ps(_mm256_add_ps(acc0, acc1), _mm256_add_ps(acc2, acc3));
+    __m128 s = _mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1));
+    s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+    s = _mm_add_ss(s, _mm_shuffle_ps(s, s, 1));
+    float sum = _mm_cvtss_f32(s);
+    for (; i < n; ++i) sum += a[i] * b[i];
+    return sum;
+}
+
+// Sign-extends 16 bytes at a time to int16 and multiply-adds pairs into
+// int32 lanes; |a*b| <= 127*128, so pair sums cannot overflow.
+__attribute__((target("avx2")))
+int32_t DotI8Avx2(const int8_t* a, const int8_t* b, size_t n) {
+    __m256i acc0 = _mm256_setzero_si256(), acc1 = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        const __m256i a0 = _mm256_cvtepi8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i)));
+        const __m256i b0 = _mm256_cvtepi8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i)));
+        const __m256i a1 = _mm256_cvtepi8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i + 16)));
+        const __m256i b1 = _mm256_cvtepi8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i + 16)));
+        acc0 = _mm256_add_epi32(acc0, _mm256_madd_epi16(a0, b0));
+        acc1 = _mm256_add_epi32(acc1, _mm256_madd_epi16(a1, b1));
+    }
+    const __m256i acc = _mm256_add_epi32(acc0, acc1);
+    __m128i s = _mm_add_epi32(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+    s = _mm_add_epi32(s, _mm_shuffle_epi32(s, _MM_SHUFFLE(1, 0, 3, 2)));
+    s = _mm_add_epi32(s, _mm_shuffle_epi32(s, _MM_SHUFFLE(2, 3, 0, 1)));
+    int32_t sum = _mm_cvtsi128_si32(s);
+    for (; i < n; ++i) sum += int32_t(a[i]) * int32_t(b[i]);
+    return sum;
+}
+#endif
+
+#ifdef ULTRAAI_VECTOR_NEON
+float DotF32Neon(const float* a, const float* b, size_t n) {
+    float32x4_t acc0 = vdupq_n_f32(0), acc1 = vdupq_n_f32(0);
+    float32x4_t acc2 = vdupq_n_f32(0), acc3 = vdupq_n_f32(0);
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        acc0 = vfmaq_f32(acc0, vld1q_f32(a + i),      vld1q_f32(b + i));
+        acc1 = vfmaq_f32(acc1, vld1q_f32(a + i + 4),  vld1q_f32(b + i + 4));
+        acc2 = vfmaq_f32(acc2, vld1q_f32(a + i + 8),  vld1q_f32(b + i + 8));
+        acc3 = vfmaq_f32(acc3, vld1q_f32(a + i + 12), vld1q_f32(b + i + 12));
+    }
+    for (; i + 4 <= n; i += 4) acc0 = vfmaq_f32(acc0, vld1q_f32(a + i), vld1q_f32(b + i));
+    float sum = vaddvq_f32(vaddq_f32(vaddq_f32(acc0, acc1), vaddq_f32(acc2, acc3)));
+    for (; i < n; ++i) sum += a[i] * b[i];
+    return sum;
+}
+
+int32_t DotI8Neon(const int8_t* a, const int8_t* b, size_t n) {
+    int32x4_t acc = vdupq_n_s32(0);
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        const int8x16_t va = vld1q_s8(a + i), vb = vld1q_s8(b + i);
+        acc = vpadalq_s16(acc, vmull_s8(vget_low_s8(va), vget_low_s8(vb)));
+        acc = vpadalq_s16(acc, vmull_s8(vget_high_s8(va), vget_high_s8(vb)));
+    }
+    int32_t sum = vaddvq_s32(acc);
+    for (; i < n; ++i) sum += int32_t(a[i]) * int32_t(b[i]);
+    return sum;
+}
+#endif
+
+struct Kernels {
+    DotF32Fn dotF32 = DotF32Scalar;
+    DotI8Fn  dotI8  = DotI8Scalar;
+    const char* name = "scalar";
+};
+
+const Kernels& ActiveKernels() {
+    static const Kernels kernels = []() {
+        Kernels k;
+#if defined(ULTRAAI_VECTOR_AVX2)
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+            k.dotF32 = DotF32Avx2;
+            k.dotI8  = DotI8Avx2;
+            k.name   = "avx2";
+        }
+#elif defined(ULTRAAI_VECTOR_NEON)
+        k.dotF32 = DotF32Neon;
+        k.dotI8  = DotI8Neon;
+        k.name   = "neon";
+#endif
+        return k;
+    }();
+    return kernels;
+}
+
+// =====================================================================
+// File mapping
+// =====================================================================
+
+class MappedRegion {
+public:
+    MappedRegion() = default;
+    MappedRegion(const MappedRegion&) = delete;
+    MappedRegion& operator=(const MappedRegion&) = delete;
+    ~MappedRegion() { Close(); }
+
+    bool Open(const std::string& path) {
+        Close();
+#if defined(_WIN32)
+        const int wideLen = MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, nullptr, 0);
+        std::wstring widePath(wideLen > 0 ? wideLen - 1 : 0, L'\0');
+        if (wideLen > 1) MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, widePath.data(), wideLen);
+        HANDLE file = CreateFileW(widePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                  OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) return false;
+        LARGE_INTEGER fileSize{};
+        if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+            CloseHandle(file);
+            return false;
+        }
+        HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+        if (mapping) CloseHandle(mapping);
+        CloseHandle(file);
+        if (!view) return false;
+        data_ = static_cast<const uint8_t*>(view);
+        size_ = static_cast<size_t>(fileSize.QuadPart);
+        return true;
+#else
+        const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) return false;
+        struct stat st{};
+        if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+            ::close(fd);
+            return false;
+        }
+        void* view = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (view == MAP_FAILED) return false;
+        data_ = static_cast<const uint8_t*>(view);
+        size_ = static_cast<size_t>(st.st_size);
+        return true;
+#endif
+    }
+
+    void Close() {
+        if (data_) {
+#if defined(_WIN32)
+            UnmapViewOfFile(data_);
+#else
+            munmap(const_cast<uint8_t*>(data_), size_);
+#endif
+        }
+        data_ = nullptr;
+        size_ = 0;
+    }
+
+    // Takes over `other`'s view, leaving it empty.
+    void Adopt(MappedRegion& other) {
+        Close();
+        std::swap(data_, other.data_);
+        std::swap(size_, other.size_);
+    }
+
+    const uint8_t* Data() const { return data_; }
+    size_t Size() const { return size_; }
+
+private:
+    const uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+// =====================================================================
+// File format
+// =====================================================================
+// header (kHeaderSize bytes), then sections padded to 64 bytes:
+//   labels u64[n] | levels u8[n] | deleted u8[n] |
+//   vectors f32[n*d]  or  codes i8[n*d] + scales f32[n] |
+//   layer-0 links u32[n * (1 + 2m)] |
+//   upper links u32[...]: for each node with level > 0, in node order,
+//                         level * (1 + m) slots
+// A link list is a count followed by its fixed number of slots.
+
+constexpr char     kFileMagic[4] = {'U', 'A', 'V', 'I'};
+constexpr uint32_t kFileVersion  = 1;
+constexpr size_t   kHeaderSize   = 64;
+constexpr uint32_t kNoNode       = 0xFFFFFFFFu;
+constexpr int      kMaxLevel     = 16;
+
+struct FileHeader {
+    char     magic[4];
+    uint32_t version;
+    uint32_t dimensions;
+    uint8_t  metric;
+    uint8_t  quantization;
+    uint16_t reserved;
+    uint32_t m;
+    uint32_t efConstruction;
+    uint32_t efSearch;
+    uint32_t entryPoint;
+    int32_t  maxLevel;
+    uint64_t nodeCount;
+    uint64_t upperSlots;
+    uint64_t seed;
+};
+static_assert(sizeof(FileHeader) <= kHeaderSize, "header must fit its slot");
+
+size_t Align64(size_t n) { return (n + 63) & ~size_t(63); }
+
+Error MakeError(ErrorCode code, const std::string& message) {
+    Error e;
+    e.code = code;
+    e.message = message;
+    return e;
+}
+
+// Per-thread visit marks: a node is visited when its mark equals the
+// current generation, so no clearing between searches.
+struct VisitList {
+    std::vector<uint32_t> marks;
+    uint32_t generation = 0;
+
+    void Begin(size_t nodes) {
+        if (marks.size() < nodes) marks.resize(nodes, 0);
+        if (++generation == 0) {
+            std::fill(marks.begin(), marks.end(), 0);
+            generation = 1;
+        }
+    }
+    bool Visit(uint32_t node) {
+        if (marks[node] == generation) return false;
+        marks[node] = generation;
+        return true;
+    }
+};
+
+VisitList& ThreadVisitList() {
+    thread_local VisitList list;
+    return list;
+}
+
+// (distance, node); smaller distance is closer.
+using Candidate = std::pair<float, uint32_t>;
+struct CloserFirst {
+    bool operator()(const Candidate& a, const Candidate& b) const { return a.first > b.first; }
+};
+using MinHeap = std::priority_queue<Candidate, std::vector<Candidate>, CloserFirst>;
+using MaxHeap = std::priority_queue<Candidate>;
+
+} // namespace
+
+// =====================================================================
+// Impl
+// =====================================================================
+
+struct VectorIndex::Impl {
+    VectorIndexOptions options;
+    size_t dims = 0;
+    size_t slots0 = 0;          // 1 + 2m
+    size_t slotsUp = 0;         // 1 + m
+    double levelMult = 0.0;
+    std::mt19937_64 rng;
+
+    // Storage: either owned vectors or pointers into `mapping`.
+    MappedRegion mapping;
+    bool mapped = false;
+    const float*    mappedVectors = nullptr;
+    const int8_t*   mappedCodes   = nullptr;
+    const float*    mappedScales  = nullptr;
+    const uint32_t* mappedLinks0  = nullptr;
+    std::vector<float>    vectors;
+    std::vector<int8_t>   codes;
+    std::vector<float>    scales;
+    std::vector<uint32_t> links0;
+
+    std::vector<std::vector<uint32_t>> upper;   // per node: level * slotsUp
+    std::vector<uint64_t> labels;
+    std::vector<uint8_t>  levels;
+    std::vector<uint8_t>  deleted;
+    std::unordered_map<uint64_t, uint32_t> idToNode;
+    uint32_t entry = kNoNode;
+    int maxLevel = -1;
+    size_t deletedCount = 0;
+
+    mutable std::shared_mutex lock;
+
+    explicit Impl(const VectorIndexOptions& o) : options(o) {
+        options.m = std::max(2, options.m);
+        options.efConstruction = std::max(options.m, options.efConstruction);
+        options.efSearch = std::max(1, options.efSearch);
+        dims = options.dimensions > 0 ? static_cast<size_t>(options.dimensions) : 0;
+        slots0 = 1 + 2 * static_cast<size_t>(options.m);
+        slotsUp = 1 + static_cast<size_t>(options.m);
+        levelMult = 1.0 / std::log(static_cast<double>(options.m));
+        rng.seed(options.seed);
+    }
+
+    bool Quantized() const { return options.quantization == VectorQuantization::Int8; }
+    size_t NodeCount() const { return labels.size(); }
+
+    const float* Vec(uint32_t n) const {
+        return (mapped ? mappedVectors : vectors.data()) + n * dims;
+    }
+    const int8_t* Code(uint32_t n) const {
+        return (mapped ? mappedCodes : codes.data()) + n * dims;
+    }
+    float Scale(uint32_t n) const { return (mapped ? mappedScales : scales.data())[n]; }
+
+    const uint32_t* Links(uint32_t n, int level) const {
+        if (level == 0) return (mapped ? mappedLinks0 : links0.data()) + n * slots0;
+        return upper[n].data() + (level - 1) * slotsUp;
+    }
+    uint32_t* MutableLinks(uint32_t n, int level) {
+        if (level == 0) return links0.data() + n * slots0;
+        return upper[n].data() + (level - 1) * slotsUp;
+    }
+    size_t MaxLinks(int level) const { return level == 0 ? slots0 - 1 : slotsUp - 1; }
+
+    // A query in storage form: normalised floats, or int8 codes + scale.
+    struct Query {
+        std::vector<float>  values;
+        std::vector<int8_t> code;
+        float scale = 0.0f;
+    };
+
+    bool Prepare(const float* in, Query& q) const {
+        q.values.assign(in, in + dims);
+        if (options.metric == VectorMetric::Cosine) {
+            const float norm = std::sqrt(ActiveKernels().dotF32(in, in, dims));
+            if (!(norm > 0.0f) || !std::isfinite(norm)) return false;
+            for (auto& v : q.values) v /= norm;
+        }
+        if (Quantized()) {
+            float maxAbs = 0.0f;
+            for (float v : q.values) maxAbs = std::max(maxAbs, std::fabs(v));
+            q.scale = maxAbs > 0.0f ? maxAbs / 127.0f : 1.0f;
+            q.code.resize(dims);
+            for (size_t i = 0; i < dims; ++i) {
+                q.code[i] = static_cast<int8_t>(std::lround(q.values[i] / q.scale));
+            }
+        }
+        return true;
+    }
+
+    // Smaller is closer: the negated similarity.
+    float Distance(const Query& q, uint32_t n) const {
+        if (Quantized()) {
+            return -q.scale * Scale(n) *
+                   static_cast<float>(ActiveKernels().dotI8(q.code.data(), Code(n), dims));
+        }
+        return -ActiveKernels().dotF32(q.values.data(), Vec(n), dims);
+    }
+    float Distance(uint32_t a, uint32_t b) const {
+        if (Quantized()) {
+            return -Scale(a) * Scale(b) *
+                   static_cast<float>(ActiveKernels().dotI8(Code(a), Code(b), dims));
+        }
+        return -ActiveKernels().dotF32(Vec(a), Vec(b), dims);
+    }
+
+    uint32_t Greedy(const Query& q, uint32_t from, int level) const {
+        uint32_t cur = from;
+        float curDist = Distance(q, cur);
+        for (bool improved = true; improved;) {
+            improved = false;
+            const uint32_t* links = Links(cur, level);
+            for (uint32_t i = 1; i <= links[0]; ++i) {
+                const float d = Distance(q, links[i]);
+                if (d < curDist) {
+                    curDist = d;
+                    cur = links[i];
+                    improved = true;
+                }
+            }
+        }
+        return cur;
+    }
+
+    // Best-first search of one layer. Deleted nodes route the search but
+    // only enter the result set when `includeDeleted` (graph building).
+    MaxHeap SearchLayer(const Query& q, uint32_t from, size_t ef, int level,
+                        bool includeDeleted) const {
+        VisitList& visited = ThreadVisitList();
+        visited.Begin(NodeCount());
+        MinHeap candidates;
+        MaxHeap results;
+        const float d0 = Distance(q, from);
+        visited.Visit(from);
+        candidates.emplace(d0, from);
+        if (includeDeleted || !deleted[from]) results.emplace(d0, from);
+        float bound = results.empty() ? INFINITY : d0;
+
+        while (!candidates.empty()) {
+            const Candidate c = candidates.top();
+            if (c.first > bound && results.size() >= ef) break;
+            candidates.pop();
+            const uint32_t* links = Links(c.second, level);
+            for (uint32_t i = 1; i <= links[0]; ++i) {
+                const uint32_t n = links[i];
+                if (!visited.Visit(n)) continue;
+                const float d = Distance(q, n);
+                if (results.size() < ef || d < bound) {
+                    candidates.emplace(d, n);
+                    if (includeDeleted || !deleted[n]) {
+                        results.emplace(d, n);
+                        if (results.size() > ef) results.pop();
+                        bound = results.top().first;
+                    }
+                }
+            }
+        }
+        return results;
+    }
+
+    // HNSW neighbour-selection heuristic: keep a candidate only when it is
+    // closer to the base than to every neighbour already kept, which spreads
+    // links across directions instead of clustering them.
+    std::vector<uint32_t> SelectNeighbors(std::vector<Candidate> candidates, size_t maxCount) const {
+        std::sort(candidates.begin(), candidates.end());
+        std::vector<uint32_t> kept;
+        kept.reserve(maxCount);
+        for (const auto& [dist, node] : candidates) {
+            if (kept.size() >= maxCount) break;
+            bool good = true;
+            for (uint32_t k : kept) {
+                if (Distance(node, k) < dist) { good = false; break; }
+            }
+            if (good) kept.push_back(node);
+        }
+        return kept;
+    }
+
+    void Connect(uint32_t from, uint32_t to, int level) {
+        uint32_t* links = MutableLinks(from, level);
+        const size_t cap = MaxLinks(level);
+        if (links[0] < cap) {
+            links[++links[0]] = to;
+            return;
+        }
+        std::vector<Candidate> all;
+        all.reserve(cap + 1);
+        all.emplace_back(Distance(from, to), to);
+        for (uint32_t i = 1; i <= links[0]; ++i) all.emplace_back(Distance(from, links[i]), links[i]);
+        const std::vector<uint32_t> kept = SelectNeighbors(std::move(all), cap);
+        links[0] = static_cast<uint32_t>(kept.size());
+        std::copy(kept.begin(), kept.end(), links + 1);
+    }
+
+    void MakeWritable() {
+        if (!mapped) return;
+        const size_t n = NodeCount();
+        if (Quantized()) {
+            codes.assign(mappedCodes, mappedCodes + n * dims);
+            scales.assign(mappedScales, mappedScales + n);
+        } else {
+            vectors.assign(mappedVectors, mappedVectors + n * dims);
+        }
+        links0.assign(mappedLinks0, mappedLinks0 + n * slots0);
+        mapped = false;
+        mappedVectors = mappedScales = nullptr;
+        mappedCodes = nullptr;
+        mappedLinks0 = nullptr;
+        mapping.Close();
+    }
+
+    void Insert(uint64_t id, const Query& q) {
+        MakeWritable();
+        if (auto it = idToNode.find(id); it != idToNode.end()) {
+            deleted[it->second] = 1;
+            ++deletedCount;
+            idToNode.erase(it);
+        }
+
+        const uint32_t node = static_cast<uint32_t>(NodeCount());
+        std::uniform_real_distribution<double> uniform(0.0, 1.0);
+        const double u = std::max(uniform(rng), 1e-12);
+        const int level = std::min(kMaxLevel, static_cast<int>(-std::log(u) * levelMult));
+
+        labels.push_back(id);
+        levels.push_back(static_cast<uint8_t>(level));
+        deleted.push_back(0);
+        if (Quantized()) {
+            codes.insert(codes.end(), q.code.begin(), q.code.end());
+            scales.push_back(q.scale);
+        } else {
+            vectors.insert(vectors.end(), q.values.begin(), q.values.end());
+        }
+        links0.resize(links0.size() + slots0, 0);
+        upper.emplace_back(static_cast<size_t>(level) * slotsUp, 0);
+        idToNode[id] = node;
+
+        if (entry == kNoNode) {
+            entry = node;
+            maxLevel = level;
+            return;
+        }
+
+        uint32_t cur = entry;
+        for (int l = maxLevel; l > level; --l) cur = Greedy(q, cur, l);
+        for (int l = std::min(level, maxLevel); l >= 0; --l) {
+            MaxHeap found = SearchLayer(q, cur, static_cast<size_t>(options.efConstruction), l, true);
+            std::vector<Candidate> candidates;
+            candidates.reserve(found.size());
+            while (!found.empty()) {
+                candidates.push_back(found.top());
+                found.pop();
+            }
+            cur = candidates.back().second;        // the closest
+            const std::vector<uint32_t> neighbors =
+                SelectNeighbors(candidates, static_cast<size_t>(options.m));
+            uint32_t* links = MutableLinks(node, l);
+            links[0] = static_cast<uint32_t>(neighbors.size());
+            std::copy(neighbors.begin(), neighbors.end(), links + 1);
+            for (uint32_t n : neighbors) Connect(n, node, l);
+        }
+        if (level > maxLevel) {
+            entry = node;
+            maxLevel = level;
+        }
+    }
+
+    std::vector<VectorSearchHit> ToHits(std::vector<Candidate>& best, size_t k) const {
+        std::sort(best.begin(), best.end());
+        if (best.size() > k) best.resize(k);
+        std::vector<VectorSearchHit> hits;
+        hits.reserve(best.size());
+        for (const auto& [dist, node] : best) hits.push_back({labels[node], -dist});
+        return hits;
+    }
+};
+
+// =====================================================================
+// VectorIndex
+// =====================================================================
+
+VectorIndex::VectorIndex(const VectorIndexOptions& options)
+    : impl_(std::make_unique<Impl>(options)) {}
+VectorIndex::~VectorIndex() = default;
+VectorIndex::VectorIndex(VectorIndex&&) noexcept = default;
+VectorIndex& VectorIndex::operator=(VectorIndex&&) noexcept = default;
+
+Error VectorIndex::Add(uint64_t id, const EmbeddingVector& vector) {
+    return Add(id, vector.values.data(), vector.values.size());
+}
+
+Error VectorIndex::Add(uint64_t id, const float* values, size_t count) {
+    std::unique_lock<std::shared_mutex> lock(impl_->lock);
+    if (count == 0 || !values) {
+        return MakeError(ErrorCode::InvalidRequest, "empty vector");
+    }
+    if (impl_->dims == 0) {
+        impl_->dims = count;
+        impl_->options.dimensions = static_cast<int32_t>(count);
+    }
+    if (count != impl_->dims) {
+        return MakeError(ErrorCode::InvalidRequest,
+                         "vector has " + std::to_string(count) + " dimensions, index has " +
+                         std::to_string(impl_->dims));
+    }
+    if (impl_->NodeCount() >= kNoNode - 1) {
+        return MakeError(ErrorCode::QuotaExceeded, "vector index is full");
+    }
+    Impl::Query q;
+    if (!impl_->Prepare(values, q)) {
+        return MakeError(ErrorCode::InvalidRequest, "zero or non-finite vector");
+    }
+    impl_->Insert(id, q);
+    return {};
+}
+
+bool VectorIndex::Remove(uint64_t id) {
+    std::unique_lock<std::shared_mutex> lock(impl_->lock);
+    auto it = impl_->idToNode.find(id);
+    if (it == impl_->idToNode.end()) return false;
+    impl_->MakeWritable();
+    impl_->deleted[it->second] = 1;
+    ++impl_->deletedCount;
+    impl_->idToNode.erase(it);
+    return true;
+}
+
+bool VectorIndex::Contains(uint64_t id) const {
+    std::shared_lock<std::shared_mutex> lock(impl_->lock);
+    return impl_->idToNode.count(id) != 0;
+}
+
+void VectorIndex::Reserve(size_t count) {
+    std::unique_lock<std::shared_mutex> lock(impl_->lock);
+    impl_->MakeWritable();
+    impl_->labels.reserve(count);
+    impl_->levels.reserve(count);
+    impl_->deleted.reserve(count);
+    impl_->upper.reserve(count);
+    impl_->links0.reserve(count * impl_->slots0);
+    impl_->idToNode.reserve(count);
+    if (impl_->dims > 0) {
+        if (impl_->Quantized()) {
+            impl_->codes.reserve(count * impl_->dims);
+            impl_->scales.reserve(count);
+        } else {
+            impl_->vectors.reserve(count * impl_->dims);
+        }
+    }
+}
+
+size_t VectorIndex::Size() const {
+    std::shared_lock<std::shared_mutex> lock(impl_->lock);
+    return impl_->idToNode.size();
+}
+
+size_t VectorIndex::DeletedCount() const {
+    std::shared_lock<std::shared_mutex> lock(impl_->lock);
+    return impl_->deletedCount;
+}
+
+int32_t VectorIndex::Dimensions() const {
+    std::shared_lock<std::shared_mutex> lock(impl_->lock);
+    return static_cast<int32_t>(impl_->dims);
+}
+
+const VectorIndexOptions& VectorIndex::Options() const {
+    return impl_->options;
+}
+
+std::vector<VectorSearchHit> VectorIndex::Search(const EmbeddingVector& query, size_t k,
+                                                 int32_t ef) const {
+    return Search(query.values.data(), query.values.size(), k, ef);
+}
+
+std::vector<VectorSearchHit> VectorIndex::Search(const float* query, size_t count,
+                                                 size_t k, int32_t ef) const {
+    std::shared_lock<std::shared_mutex> lock(impl_->lock);
+    const Impl& d = *impl_;
+    if (k == 0 || d.entry == kNoNode || count != d.dims || !query) return {};
+    Impl::Query q;
+    if (!d.Prepare(query, q)) return {};
+
+    uint32_t cur = d.entry;
+    for (int l = d.maxLevel; l > 0; --l) cur = d.Greedy(q, cur, l);
+    const size_t width = std::max(k, static_cast<size_t>(ef > 0 ? ef : d.options.efSearch));
+    MaxHeap found = d.SearchLayer(q, cur, width, 0, false);
+    std::vector<Candidate> best;
+    best.reserve(found.size());
+    while (!found.empty()) {
+        best.push_back(found.top());
+        found.pop();
+    }
+    return d.ToHits(best, k);
+}
+
+std::vector<VectorSearchHit> VectorIndex::SearchExact(const float* query, size_t count,
+                                                      size_t k) const {
+    std::shared_lock<std::shared_mutex> lock(impl_->lock);
+    const Impl& d = *impl_;
+    if (k == 0 || count != d.dims || !query || d.NodeCount() == 0) return {};
+    Impl::Query q;
+    if (!d.Prepare(query, q)) return {};
+    MaxHeap best;
+    for (uint32_t n = 0; n < d.NodeCount(); ++n) {
+        if (d.deleted[n]) continue;
+        const float dist = d.Distance(q, n);
+        if (best.size() < k) best.emplace(dist, n);
+        else if (dist < best.top().first) {
+            best.pop();
+            best.emplace(dist, n);
+        }
+    }
+    std::vector<Candidate> out;
+    out.reserve(best.size());
+    while (!best.empty()) {
+        out.push_back(best.top());
+        best.pop();
+    }
+    return d.ToHits(out, k);
+}
+
+const char* VectorIndex::KernelName() {
+    return ActiveKernels().name;
+}
+
+// =====================================================================
+// Persistence
+// =====================================================================
+
+Error VectorIndex::Save(const std::string& path) const {
+    std::shared_lock<std::shared_mutex> lock(impl_->lock);
+    const Impl& d = *impl_;
+    const size_t n = d.NodeCount();
+
+    FileHeader h{};
+    std::memcpy(h.magic, kFileMagic, 4);
+    h.version        = kFileVersion;
+    h.dimensions     = static_cast<uint32_t>(d.dims);
+    h.metric         = static_cast<uint8_t>(d.options.metric);
+    h.quantization   = static_cast<uint8_t>(d.options.quantization);
+    h.m              = static_cast<uint32_t>(d.options.m);
+    h.efConstruction = static_cast<uint32_t>(d.options.efConstruction);
+    h.efSearch       = static_cast<uint32_t>(d.options.efSearch);
+    h.entryPoint     = d.entry;
+    h.maxLevel       = d.maxLevel;
+    h.nodeCount      = n;
+    h.seed           = d.options.seed;
+    for (uint32_t i = 0; i < n; ++i) h.upperSlots += d.levels[i] * d.slotsUp;
+
+    const std::string tmpPath = path + ".tmp";
+    std::FILE* f = std::fopen(tmpPath.c_str(), "wb");
+    if (!f) return MakeError(ErrorCode::ProviderError, "cannot write " + tmpPath);
+    size_t written = 0;
+    bool ok = true;
+    auto write = [&](const void* p, size_t bytes) {
+        ok = ok && (bytes == 0 || std::fwrite(p, 1, bytes, f) == bytes);
+        written += bytes;
+    };
+    auto pad = [&]() {
+        static const uint8_t zeros[64] = {};
+        write(zeros, Align64(written) - written);
+    };
+    uint8_t headerBytes[kHeaderSize] = {};
+    std::memcpy(headerBytes, &h, sizeof(h));
+    write(headerBytes, kHeaderSize);
+    write(d.labels.data(), n * sizeof(uint64_t));          pad();
+    write(d.levels.data(), n);                             pad();
+    write(d.deleted.data(), n);                            pad();
+    if (d.Quantized()) {
+        write(d.Code(0), n * d.dims);                      pad();
+        write(d.mapped ? d.mappedScales : d.scales.data(), n * sizeof(float));
+    } else {
+        write(d.Vec(0), n * d.dims * sizeof(float));
+    }
+    pad();
+    write(d.Links(0, 0), n * d.slots0 * sizeof(uint32_t)); pad();
+    for (uint32_t i = 0; i < n; ++i) write(d.upper[i].data(), d.upper[i].size() * sizeof(uint32_t));
+    ok = (std::fclose(f) == 0) && ok;
+    if (!ok || std::rename(tmpPath.c_str(), path.c_str()) != 0) {
+        std::remove(tmpPath.c_str());
+        return MakeError(ErrorCode::ProviderError, "cannot write " + path);
+    }
+    return {};
+}
+
+std::unique_ptr<VectorIndex> VectorIndex::Load(const std::string& path, Error* outError) {
+    Error tmp;
+    Error* err = outError ? outError : &tmp;
+    auto fail = [&](const std::string& message) -> std::unique_ptr<VectorIndex> {
+        *err = MakeError(ErrorCode::UnsupportedFormat, message + ": " + path);
+        return nullptr;
+    };
+
+    MappedRegion region;
+    if (!region.Open(path)) return fail("cannot map vector index");
+    FileHeader h{};
+    if (region.Size() < kHeaderSize) return fail("truncated vector index");
+    std::memcpy(&h, region.Data(), sizeof(h));
+    if (std::memcmp(h.magic, kFileMagic, 4) != 0 || h.version != kFileVersion) {
+        return fail("not a vector index");
+    }
+    if (h.dimensions == 0 || h.m < 2 || h.metric > 1 || h.quantization > 1 ||
+        h.nodeCount >= kNoNode || h.maxLevel > kMaxLevel) {
+        return fail("corrupt vector index header");
+    }
+
+    VectorIndexOptions o;
+    o.dimensions     = static_cast<int32_t>(h.dimensions);
+    o.metric         = static_cast<VectorMetric>(h.metric);
+    o.quantization   = static_cast<VectorQuantization>(h.quantization);
+    o.m              = static_cast<int32_t>(h.m);
+    o.efConstruction = static_cast<int32_t>(h.efConstruction);
+    o.efSearch       = static_cast<int32_t>(h.efSearch);
+    o.seed           = h.seed;
+    auto index = std::make_unique<VectorIndex>(o);
+    Impl& d = *index->impl_;
+    const size_t n = static_cast<size_t>(h.nodeCount);
+
+    // Section offsets; every size is checked against the file before use.
+    size_t offset = kHeaderSize;
+    auto section = [&](size_t bytes) -> const uint8_t* {
+        const size_t at = offset;
+        if (at > region.Size() || bytes > region.Size() - at) return nullptr;
+        offset = Align64(at + bytes);
+        return region.Data() + at;
+    };
+    const uint8_t* labels  = section(n * sizeof(uint64_t));
+    const uint8_t* levels  = section(n);
+    const uint8_t* deleted = section(n);
+    const uint8_t* vecs = nullptr;
+    const uint8_t* scales = nullptr;
+    if (d.Quantized()) {
+        vecs = section(n * d.dims);
+        scales = section(n * sizeof(float));
+    } else {
+        vecs = section(n * d.dims * sizeof(float));
+    }
+    const uint8_t* links0 = section(n * d.slots0 * sizeof(uint32_t));
+    const uint8_t* upper  = section(static_cast<size_t>(h.upperSlots) * sizeof(uint32_t));
+    if (!labels || !levels || !deleted || !vecs || (d.Quantized() && !scales) || !links0 || !upper) {
+        return fail("truncated vector index");
+    }
+
+    d.labels.resize(n);
+    std::memcpy(d.labels.data(), labels, n * sizeof(uint64_t));
+    d.levels.assign(levels, levels + n);
+    d.deleted.assign(deleted, deleted + n);
+    d.upper.resize(n);
+    const uint32_t* up = reinterpret_cast<const uint32_t*>(upper);
+    size_t upperUsed = 0;
+    for (size_t i = 0; i < n; ++i) {
+        if (d.levels[i] > kMaxLevel) return fail("corrupt vector index levels");
+        const size_t slots = d.levels[i] * d.slotsUp;
+        if (upperUsed + slots > h.upperSlots) return fail("corrupt vector index links");
+        d.upper[i].assign(up + upperUsed, up + upperUsed + slots);
+        upperUsed += slots;
+        if (d.deleted[i]) ++d.deletedCount;
+        else d.idToNode[d.labels[i]] = static_cast<uint32_t>(i);
+    }
+    // Links must stay inside the graph: a damaged file must not make a
+    // search read out of bounds.
+    const uint32_t* l0 = reinterpret_cast<const uint32_t*>(links0);
+    for (size_t i = 0; i < n; ++i) {
+        const uint32_t* list = l0 + i * d.slots0;
+        if (list[0] > d.slots0 - 1) return fail("corrupt vector index links");
+        for (uint32_t j = 1; j <= list[0]; ++j) {
+            if (list[j] >= n) return fail("corrupt vector index links");
+        }
+        for (int l = 1; l <= d.levels[i]; ++l) {
+            const uint32_t* ul = d.upper[i].data() + (l - 1) * d.slotsUp;
+            if (ul[0] > d.slotsUp - 1) return fail("corrupt vector index links");
+            for (uint32_t j = 1; j <= ul[0]; ++j) {
+                if (ul[j] >= n || d.levels[ul[j]] < l) return fail("corrupt vector index links");
+            }
+        }
+    }
+    if ((n == 0) != (h.entryPoint == kNoNode) ||
+        (n > 0 && (h.entryPoint >= n || d.levels[h.entryPoint] != h.maxLevel))) {
+        return fail("corrupt vector index entry point");
+    }
+
+    d.entry = h.entryPoint;
+    d.maxLevel = h.maxLevel;
+    d.mapped = true;
+    d.mappedLinks0 = l0;
+    if (d.Quantized()) {
+        d.mappedCodes  = reinterpret_cast<const int8_t*>(vecs);
+        d.mappedScales = reinterpret_cast<const float*>(scales);
+    } else {
+        d.mappedVectors = reinterpret_cast<const float*>(vecs);
+    }
+    // The mapping moves into the index; the pointers above stay valid.
+    d.mapping.Adopt(region);
+    d.rng.seed(o.seed ^ n);
+    *err = {};
+    return index;
+}
+
+} // namespace UltraAI
@@ -0,0 +1,283 @@
+// UltraAI/tests/test_embedding_cache.cpp
+// CachedEmbeddings over the mock adapter: hits and key separation,
+// coalescing of concurrent requests, error handling, the persistent store
+// (reload, torn tail, foreign file) and the LRU bound.
+
+#include "UltraAI.h"
+#include "UltraAIMockEmbeddings.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace UltraAI;
+
+namespace {
+
+#define EXPECT_TRUE(cond) do { \
+    if (!(cond)) { std::cerr << "FAIL: " #cond " at " << __FILE__ << ":" \
+                  << __LINE__ << std::endl; std::abort(); } \
+} while (0)
+
+#define EXPECT_EQ(a, b) do { \
+    if (!((a) == (b))) { std::cerr << "FAIL: " #a " == " #b " at " \
+                  << __FILE__ << ":" << __LINE__ << std::endl; std::abort(); } \
+} while (0)
+
+std::string TempPath(const char* name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+EmbeddingRequest Request(std::vector<std::string> input) {
+    EmbeddingRequest req;
+    req.input = std::move(input);
+    return req;
+}
+
+void TestHitsAndKeys() {
+    auto mock = std::make_shared<MockEmbeddings>();
+    EmbeddingCacheOptions opts;
+    opts.batching = false;
+    auto cached = CreateCachedEmbeddings(mock, opts);
+    EXPECT_TRUE(cached != nullptr);
+    EXPECT_EQ(cached->GetCapabilities().providerId, std::string("mock"));
+
+    auto r1 = cached->Embed(Request({"alpha", "beta", "gamma"}));
+    EXPECT_TRUE(r1.error.IsOk());
+    EXPECT_EQ(r1.embeddings.size(), size_t{3});
+    EXPECT_EQ(r1.model, std::string("mock-embed-1"));
+    EXPECT_EQ(mock->CallCount(), 1);
+
+    // Only "delta" reaches the provider; vectors match an uncached call.
+    auto r2 = cached->Embed(Request({"alpha", "delta", "gamma"}));
+    EXPECT_EQ(mock->CallCount(), 2);
+    MockEmbeddings direct;
+    auto ref = direct.Embed(Request({"alpha", "delta", "gamma"}));
+    for (size_t i = 0; i < 3; ++i) EXPECT_TRUE(r2.embeddings[i].values == ref.embeddings[i].values);
+    EXPECT_EQ(r2.model, std::string("mock-embed-1"));
+    EXPECT_EQ(r2.usage.units, 1);           // only the miss is billed
+
+    auto stats = cached->GetStats();
+    EXPECT_EQ(stats.inputs, uint64_t{6});
+    EXPECT_EQ(stats.hits, uint64_t{2});
+    EXPECT_EQ(stats.misses, uint64_t{4});
+    EXPECT_EQ(stats.providerCalls, uint64_t{2});
+    EXPECT_EQ(stats.entries, uint64_t{4});
+    EXPECT_TRUE(stats.HitRate() > 0.33 && stats.HitRate() < 0.34);
+    EXPECT_EQ(stats.AverageBatchSize(), 2.0);
+
+    // Task type, dimensions and model are part of the key.
+    EmbeddingRequest query = Request({"alpha"});
+    query.taskType = EmbeddingTaskType::SearchQuery;
+    cached->Embed(query);
+    EmbeddingRequest small = Request({"alpha"});
+    small.dimensions = 4;
+    EXPECT_EQ(cached->Embed(small).embeddings[0].values.size(), size_t{4});
+    EmbeddingRequest other = Request({"alpha"});
+    other.model = "mock-embed-2";
+    cached->Embed(other);
+    EXPECT_EQ(mock->CallCount(), 5);
+    cached->Embed(small);
+    EXPECT_EQ(mock->CallCount(), 5);
+
+    // Options may change the vectors: no caching.
+    EmbeddingRequest withOptions = Request({"alpha"});
+    withOptions.options["normalize"] = true;
+    cached->Embed(withOptions);
+    cached->Embed(withOptions);
+    EXPECT_EQ(mock->CallCount(), 7);
+    EXPECT_EQ(cached->GetStats().bypassed, uint64_t{2});
+
+    // A duplicate inside one request is fetched once.
+    cached->ResetStats();
+    auto dup = cached->Embed(Request({"eps", "eps", "eps"}));
+    EXPECT_EQ(mock->CallCount(), 8);
+    EXPECT_TRUE(dup.embeddings[0].values == dup.embeddings[2].values);
+    EXPECT_EQ(cached->GetStats().misses, uint64_t{1});
+    EXPECT_EQ(cached->GetStats().shared, uint64_t{2});
+}
+
+void TestBatchSplitting() {
+    auto mock = std::make_shared<MockEmbeddings>();
+    EmbeddingCacheOptions opts;
+    opts.batching = false;
+    opts.maxBatchSize = 4;
+    auto cached = CreateCachedEmbeddings(mock, opts);
+    std::vector<std::string> input;
+    for (int i = 0; i < 10; ++i) input.push_back("item-" + std::to_string(i));
+    auto resp = cached->Embed(Request(input));
+    EXPECT_EQ(resp.embeddings.size(), size_t{10});
+    EXPECT_EQ(mock->CallCount(), 3);
+    EXPECT_EQ(cached->GetStats().largestBatch, uint64_t{4});
+}
+
+void TestCoalescing() {
+    auto mock = std::make_shared<MockEmbeddings>();
+    mock->SetDimensions(16);
+    EmbeddingCacheOptions opts;
+    opts.batchWindow = std::chrono::milliseconds(50);
+    opts.dispatchThreads = 1;
+    auto cached = CreateCachedEmbeddings(mock, opts);
+
+    // 24 single-text callers at once, plus 8 asking for a text already
+    // in flight.
+    std::vector<std::future<EmbeddingResponse>> futures;
+    for (int i = 0; i < 24; ++i) {
+        futures.push_back(cached->EmbedAsync(Request({"concurrent-" + std::to_string(i)})));
+    }
+    for (int i = 0; i < 8; ++i) futures.push_back(cached->EmbedAsync(Request({"concurrent-0"})));
+    MockEmbeddings direct;
+    direct.SetDimensions(16);
+    for (size_t i = 0; i < futures.size(); ++i) {
+        auto resp = futures[i].get();
+        EXPECT_TRUE(resp.error.IsOk());
+        const std::string text = "concurrent-" + std::to_string(i < 24 ? i : 0);
+        EXPECT_TRUE(resp.embeddings[0].values == direct.Embed(Request({text})).embeddings[0].values);
+    }
+    const auto stats = cached->GetStats();
+    EXPECT_EQ(stats.inputs, uint64_t{32});
+    EXPECT_EQ(stats.misses + stats.hits + stats.shared, uint64_t{32});
+    EXPECT_EQ(stats.misses, uint64_t{24});
+    // Far fewer calls than callers; timing decides the exact split.
+    EXPECT_TRUE(stats.providerCalls <= 6);
+    EXPECT_TRUE(stats.largestBatch >= 4);
+    std::cout << "coalescing: 32 callers -> " << stats.providerCalls
+              << " provider calls, average batch " << stats.AverageBatchSize()
+              << ", hit rate " << stats.HitRate() << std::endl;
+
+    // A full batch leaves without waiting for the window.
+    EmbeddingCacheOptions full;
+    full.batchWindow = std::chrono::seconds(30);
+    full.maxBatchSize = 8;
+    auto eager = CreateCachedEmbeddings(std::make_shared<MockEmbeddings>(), full);
+    std::vector<std::string> eight;
+    for (int i = 0; i < 8; ++i) eight.push_back("x" + std::to_string(i));
+    const auto t0 = std::chrono::steady_clock::now();
+    EXPECT_TRUE(eager->Embed(Request(eight)).error.IsOk());
+    EXPECT_TRUE(std::chrono::steady_clock::now() - t0 < std::chrono::seconds(10));
+}
+
+void TestErrors() {
+    auto mock = std::make_shared<MockEmbeddings>();
+    auto cached = CreateCachedEmbeddings(mock);
+    Error rate;
+    rate.code = ErrorCode::RateLimited;
+    rate.message = "slow down";
+    mock->EnqueueError(rate);
+    auto failed = cached->Embed(Request({"a", "b"}));
+    EXPECT_EQ(failed.error.code, ErrorCode::RateLimited);
+    EXPECT_TRUE(failed.embeddings.empty());
+    EXPECT_EQ(cached->GetStats().entries, uint64_t{0});
+
+    // Nothing was cached, so a retry goes back to the provider.
+    auto retry = cached->Embed(Request({"a", "b"}));
+    EXPECT_TRUE(retry.error.IsOk());
+    EXPECT_EQ(mock->CallCount(), 2);
+
+    // A provider that drops inputs is an error, not a short answer.
+    EmbeddingResponse shortResp;
+    shortResp.embeddings.resize(1);
+    mock->EnqueueResponse(shortResp);
+    EXPECT_EQ(cached->Embed(Request({"c", "d"})).error.code, ErrorCode::ProviderError);
+
+    Error err;
+    EXPECT_TRUE(CreateCachedEmbeddings(nullptr, {}, &err) == nullptr);
+    EXPECT_EQ(err.code, ErrorCode::InvalidRequest);
+}
+
+void TestPersistence() {
+    const std::string path = TempPath("ultraai_test_embedding_cache.bin");
+    std::remove(path.c_str());
+    EmbeddingCacheOptions opts;
+    opts.path = path;
+    std::vector<std::string> texts;
+    for (int i = 0; i < 50; ++i) texts.push_back("message " + std::to_string(i));
+    std::vector<EmbeddingVector> first;
+    {
+        auto mock = std::make_shared<MockEmbeddings>();
+        auto cached = CreateCachedEmbeddings(mock, opts);
+        EXPECT_TRUE(cached != nullptr);
+        first = cached->Embed(Request(texts)).embeddings;
+        EXPECT_TRUE(cached->GetStats().storeBytes > 50 * 8 * sizeof(float));
+    }
+    {
+        // Re-indexing after a restart costs no provider calls.
+        auto mock = std::make_shared<MockEmbeddings>();
+        auto cached = CreateCachedEmbeddings(mock, opts);
+        EXPECT_TRUE(cached != nullptr);
+        EXPECT_EQ(cached->GetStats().entries, uint64_t{50});
+        auto again = cached->Embed(Request(texts));
+        EXPECT_EQ(mock->CallCount(), 0);
+        for (size_t i = 0; i < texts.size(); ++i) EXPECT_TRUE(again.embeddings[i].values == first[i].values);
+        cached->Embed(Request({"one more"}));
+    }
+
+    // A torn final record is dropped; the rest survive.
+    const auto size = std::filesystem::file_size(path);
+    std::filesystem::resize_file(path, size - 5);
+    {
+        auto mock = std::make_shared<MockEmbeddings>();
+        auto cached = CreateCachedEmbeddings(mock, opts);
+        EXPECT_TRUE(cached != nullptr);
+        EXPECT_EQ(cached->GetStats().entries, uint64_t{50});
+        cached->Embed(Request({"one more", "message 7"}));
+        EXPECT_EQ(mock->CallCount(), 1);
+    }
+    {
+        auto cached = CreateCachedEmbeddings(std::make_shared<MockEmbeddings>(), opts);
+        EXPECT_EQ(cached->GetStats().entries, uint64_t{51});
+        EXPECT_TRUE(cached->Clear().IsOk());
+        EXPECT_EQ(cached->GetStats().entries, uint64_t{0});
+    }
+    {
+        auto cached = CreateCachedEmbeddings(std::make_shared<MockEmbeddings>(), opts);
+        EXPECT_EQ(cached->GetStats().entries, uint64_t{0});
+    }
+
+    // Someone else's file is refused, not overwritten.
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out << "definitely not a cache";
+    }
+    Error err;
+    EXPECT_TRUE(CreateCachedEmbeddings(std::make_shared<MockEmbeddings>(), opts, &err) == nullptr);
+    EXPECT_EQ(err.code, ErrorCode::UnsupportedFormat);
+    EXPECT_EQ(std::filesystem::file_size(path), uintmax_t{22});
+    std::remove(path.c_str());
+}
+
+void TestLruBound() {
+    auto mock = std::make_shared<MockEmbeddings>();
+    EmbeddingCacheOptions opts;
+    opts.maxEntries = 2;
+    opts.batching = false;
+    auto cached = CreateCachedEmbeddings(mock, opts);
+    cached->Embed(Request({"a"}));
+    cached->Embed(Request({"b"}));
+    cached->Embed(Request({"a"}));          // a is now newest
+    cached->Embed(Request({"c"}));          // evicts b
+    EXPECT_EQ(mock->CallCount(), 3);
+    cached->Embed(Request({"a"}));
+    EXPECT_EQ(mock->CallCount(), 3);
+    cached->Embed(Request({"b"}));
+    EXPECT_EQ(mock->CallCount(), 4);
+    EXPECT_EQ(cached->GetStats().entries, uint64_t{2});
+}
+
+} // namespace
+
+int main() {
+    TestHitsAndKeys();
+    TestBatchSplitting();
+    TestCoalescing();
+    TestErrors();
+    TestPersistence();
+    TestLruBound();
+    std::cout << "OK: ultraai_test_embedding_cache" << std::endl;
+    return 0;
+}
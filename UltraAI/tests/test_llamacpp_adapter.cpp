@@ -161,6 +161,95 @@ int main() {
         tooBig.dimensions = ecaps.models[0].outputDimensions + 1;
         EXPECT_TRUE(embeds->Embed(tooBig).error.code ==
                     ErrorCode::InvalidRequest);
+
+        // Packed batches: many inputs share llama_decode calls as separate
+        // sequences and still pool to the same vectors as one-at-a-time.
+        EmbeddingRequest many;
+        for (int i = 0; i < 64; ++i) {
+            many.input.push_back("document number " + std::to_string(i) +
+                                 " talks about topic " + std::to_string(i % 7));
+        }
+        const auto t0 = std::chrono::steady_clock::now();
+        EmbeddingResponse packed = embeds->Embed(many);
+        const auto t1 = std::chrono::steady_clock::now();
+        EXPECT_TRUE(packed.error.IsOk());
+        EXPECT_TRUE(packed.embeddings.size() == many.input.size());
+        int32_t singleTokens = 0;
+        for (size_t i = 0; i < many.input.size(); ++i) {
+            EmbeddingRequest one;
+            one.input = {many.input[i]};
+            EmbeddingResponse r = embeds->Embed(one);
+            EXPECT_TRUE(r.error.IsOk());
+            singleTokens += r.usage.inputTokens;
+            EXPECT_TRUE(IEmbeddings::CosineSimilarity(r.embeddings[0],
+                                                      packed.embeddings[i]) > 0.999);
+        }
+        const auto t2 = std::chrono::steady_clock::now();
+        EXPECT_TRUE(singleTokens == packed.usage.inputTokens);
+        const double packedSec = std::chrono::duration<double>(t1 - t0).count();
+        const double singleSec = std::chrono::duration<double>(t2 - t1).count();
+        std::cout << "embeddings: " << packed.usage.inputTokens << " tokens, packed "
+                  << packed.usage.inputTokens / packedSec << " tok/s, one-by-one "
+                  << singleTokens / singleSec << " tok/s" << std::endl;
+    }
+
+    // Multi-turn chat reuses the KV cache for the shared prompt prefix.
+    {
+        auto firstTokenMs = [](ITextLLM& model, const ChatRequest& r,
+                               ChatResponse& out) {
+            const auto start = std::chrono::steady_clock::now();
+            double ttft = -1.0;
+            bool finished = false;
+            auto h = model.ChatStream(r, [&](const StreamEvent& ev) {
+                if (ev.kind == StreamEventKind::TextDelta) {
+                    if (ttft < 0) {
+                        ttft = std::chrono::duration<double, std::milli>(
+                            std::chrono::steady_clock::now() - start).count();
+                    }
+                    out.text += ev.textDelta;
+                }
+                if (ev.kind == StreamEventKind::Done) {
+                    out.usage = ev.usage;
+                    finished = true;
+                }
+            });
+            while (!h->IsDone()) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            EXPECT_TRUE(finished);
+            return ttft;
+        };
+
+        TextLLMConfig coldCfg = cfg;
+        coldCfg.providerOptions["reuse_prefix"] = false;
+        auto cold = CreateTextLLM(coldCfg, &err);
+        EXPECT_TRUE(cold != nullptr);
+
+        ChatRequest turn;
+        turn.sampling.maxOutputTokens = 16;
+        turn.sampling.temperature     = 0.0;
+        Message sys; sys.role = Role::System;
+        for (int i = 0; i < 20; ++i) sys.text += "You are a patient storyteller. ";
+        turn.messages.push_back(sys);
+        Message user; user.role = Role::User; user.text = "Tell me about a dragon.";
+        turn.messages.push_back(user);
+
+        ChatResponse first;
+        firstTokenMs(*llm, turn, first);
+        Message reply; reply.role = Role::Assistant; reply.text = first.text;
+        turn.messages.push_back(reply);
+        Message follow; follow.role = Role::User; follow.text = "And then?";
+        turn.messages.push_back(follow);
+
+        ChatResponse warm, coldResp;
+        const double warmMs = firstTokenMs(*llm, turn, warm);
+        const double coldMs = firstTokenMs(*cold, turn, coldResp);
+        EXPECT_TRUE(warm.usage.cachedInputTokens > 0);
+        EXPECT_TRUE(warm.usage.cachedInputTokens < warm.usage.inputTokens);
+        EXPECT_TRUE(coldResp.usage.cachedInputTokens == 0);
+        std::cout << "chat turn 2: " << warm.usage.cachedInputTokens << "/"
+                  << warm.usage.inputTokens << " prompt tokens reused, TTFT "
+                  << warmMs << " ms (cold " << coldMs << " ms)" << std::endl;
     }
 
     std::cout << "test_llamacpp_adapter: all checks passed ("
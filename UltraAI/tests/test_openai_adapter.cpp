@@ -15,6 +15,12 @@
 
 #include <nlohmann/json.hpp>
 
+#ifdef ULTRAAI_HAS_CASSETTE
+#include "UltraAICassette.h"
+#include <filesystem>
+#include <future>
+#endif
+
 #include <iostream>
 #include <memory>
 #include <string>
@@ -497,6 +503,62 @@ void TestEmbeddingsErrors() {
     EXPECT_EQ(r2.error.code, ErrorCode::AuthenticationFailed);
 }
 
+#ifdef ULTRAAI_HAS_CASSETTE
+void TestEmbeddingCacheOverCassette() {
+    // Record one batched embeddings exchange, then replay it from disk under
+    // CachedEmbeddings: two concurrent callers must share that single HTTP
+    // call, and a repeat must not reach the transport at all.
+    auto server = std::make_shared<ScriptedTransport>();
+    server->ScriptResponse(JsonResponse(200, json{
+        {"model", "text-embedding-3-small"},
+        {"data", json::array({
+            json{{"index", 0}, {"embedding", json::array({1.0, 0.0})}},
+            json{{"index", 1}, {"embedding", json::array({0.0, 1.0})}}})},
+        {"usage", {{"prompt_tokens", 6}, {"total_tokens", 6}}}}));
+    auto recorder = std::make_shared<RecordingTransport>(server);
+    {
+        auto live = CreateOpenAIEmbeddings(EmbedConfig(), nullptr, recorder);
+        EmbeddingRequest req;
+        req.input = {"north", "east"};
+        EXPECT_TRUE(live->Embed(req).error.IsOk());
+    }
+    const std::string path =
+        (std::filesystem::temp_directory_path() / "ultraai_test_embed_cache_cassette.json").string();
+    EXPECT_TRUE(recorder->Save(path));
+
+    auto replay = std::make_shared<ScriptedTransport>();
+    EXPECT_TRUE(LoadCassette(path, *replay));
+    std::remove(path.c_str());
+
+    EmbeddingCacheOptions opts;
+    opts.batchWindow = std::chrono::milliseconds(200);
+    auto cached = CreateCachedEmbeddings(
+        CreateOpenAIEmbeddings(EmbedConfig(), nullptr, replay), opts);
+    EXPECT_TRUE(cached != nullptr);
+
+    EmbeddingRequest north;
+    north.input = {"north"};
+    EmbeddingRequest east;
+    east.input = {"east"};
+    auto f1 = cached->EmbedAsync(north);
+    auto f2 = cached->EmbedAsync(east);
+    EmbeddingResponse r1 = f1.get();
+    EmbeddingResponse r2 = f2.get();
+    EXPECT_TRUE(r1.error.IsOk());
+    EXPECT_TRUE(r2.error.IsOk());
+    EXPECT_EQ(replay->Requests().size(), static_cast<size_t>(1));
+    EXPECT_EQ(json::parse(replay->Requests()[0].body)["input"].size(),
+              static_cast<size_t>(2));
+    EXPECT_EQ(r1.usage.inputTokens + r2.usage.inputTokens, 6);
+    EXPECT_TRUE(IEmbeddings::CosineSimilarity(r1.embeddings[0], r2.embeddings[0]) < 0.001);
+
+    EmbeddingResponse again = cached->Embed(north);
+    EXPECT_TRUE(again.embeddings[0].values == r1.embeddings[0].values);
+    EXPECT_EQ(replay->Requests().size(), static_cast<size_t>(1));
+    EXPECT_EQ(cached->GetStats().providerCalls, static_cast<uint64_t>(1));
+}
+#endif
+
 } // namespace
 
 int main() {
@@ -512,6 +574,9 @@ int main() {
     TestEmbeddings();
     TestEmbeddingsDefaultModel();
     TestEmbeddingsErrors();
+#ifdef ULTRAAI_HAS_CASSETTE
+    TestEmbeddingCacheOverCassette();
+#endif
     std::cout << "test_openai_adapter: all checks passed" << std::endl;
     return 0;
 }
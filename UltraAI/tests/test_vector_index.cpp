@@ -0,0 +1,275 @@
+// UltraAI/tests/test_vector_index.cpp
+// HNSW vector index: recall against brute force on mock embeddings, deletes
+// and replacement, int8 storage, and a Save / mapped Load round trip.
+// Set ULTRAAI_BENCH_VECTORS (e.g. 1000000) to scale the benchmark corpus.
+
+#include "UltraAI.h"
+#include "UltraAIMockEmbeddings.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <set>
+#include <string>
+
+using namespace UltraAI;
+
+namespace {
+
+#define EXPECT_TRUE(cond) do { \
+    if (!(cond)) { std::cerr << "FAIL: " #cond " at " << __FILE__ << ":" \
+                  << __LINE__ << std::endl; std::abort(); } \
+} while (0)
+
+#define EXPECT_EQ(a, b) do { \
+    if (!((a) == (b))) { std::cerr << "FAIL: " #a " == " #b " at " \
+                  << __FILE__ << ":" << __LINE__ << std::endl; std::abort(); } \
+} while (0)
+
+std::vector<EmbeddingVector> MockCorpus(size_t count, int32_t dims, const std::string& prefix) {
+    MockEmbeddings emb;
+    emb.SetDimensions(dims);
+    EmbeddingRequest req;
+    for (size_t i = 0; i < count; ++i) req.input.push_back(prefix + std::to_string(i));
+    std::vector<EmbeddingVector> out;
+    for (size_t at = 0; at < req.input.size(); at += 1000) {
+        EmbeddingRequest part;
+        part.input.assign(req.input.begin() + at,
+                          req.input.begin() + std::min(at + 1000, req.input.size()));
+        auto resp = emb.Embed(part);
+        EXPECT_EQ(resp.error.code, ErrorCode::None);
+        for (auto& e : resp.embeddings) out.push_back(std::move(e));
+    }
+    return out;
+}
+
+// Clustered vectors: real embedding sets are far from uniform, and HNSW is
+// tuned for that shape.
+std::vector<std::vector<float>> ClusteredCorpus(size_t count, size_t dims, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::normal_distribution<float> gauss(0.0f, 1.0f);
+    std::vector<std::vector<float>> centers(256, std::vector<float>(dims));
+    for (auto& c : centers) for (auto& v : c) v = gauss(rng);
+    std::vector<std::vector<float>> out(count, std::vector<float>(dims));
+    for (size_t i = 0; i < count; ++i) {
+        const auto& c = centers[rng() % centers.size()];
+        for (size_t d = 0; d < dims; ++d) out[i][d] = c[d] + 0.35f * gauss(rng);
+    }
+    return out;
+}
+
+double Recall(const VectorIndex& index, const std::vector<const float*>& queries,
+              size_t dims, size_t k, int32_t ef) {
+    size_t found = 0, total = 0;
+    for (const float* q : queries) {
+        const auto exact = index.SearchExact(q, dims, k);
+        const auto approx = index.Search(q, dims, k, ef);
+        std::set<uint64_t> want;
+        for (const auto& h : exact) want.insert(h.id);
+        for (const auto& h : approx) found += want.count(h.id);
+        total += exact.size();
+    }
+    return total ? double(found) / double(total) : 1.0;
+}
+
+void TestBasics() {
+    VectorIndex index;
+    EXPECT_EQ(index.Size(), size_t{0});
+    EXPECT_TRUE(index.Search(EmbeddingVector{{1.0f, 0.0f}}, 5).empty());
+
+    EXPECT_TRUE(index.Add(1, EmbeddingVector{{1.0f, 0.0f, 0.0f}}).IsOk());
+    EXPECT_EQ(index.Dimensions(), 3);
+    EXPECT_TRUE(index.Add(2, EmbeddingVector{{0.0f, 2.0f, 0.0f}}).IsOk());
+    EXPECT_TRUE(index.Add(3, EmbeddingVector{{0.7f, 0.7f, 0.0f}}).IsOk());
+
+    // Dimension mismatch and zero vectors are rejected.
+    EXPECT_EQ(index.Add(4, EmbeddingVector{{1.0f, 0.0f}}).code, ErrorCode::InvalidRequest);
+    EXPECT_EQ(index.Add(4, EmbeddingVector{{0.0f, 0.0f, 0.0f}}).code, ErrorCode::InvalidRequest);
+    EXPECT_EQ(index.Size(), size_t{3});
+
+    // Cosine: the scale of a vector does not matter.
+    auto hits = index.Search(EmbeddingVector{{0.0f, 5.0f, 0.0f}}, 2);
+    EXPECT_EQ(hits.size(), size_t{2});
+    EXPECT_EQ(hits[0].id, uint64_t{2});
+    EXPECT_TRUE(std::fabs(hits[0].score - 1.0f) < 1e-5f);
+    EXPECT_EQ(hits[1].id, uint64_t{3});
+    EXPECT_TRUE(hits[0].score >= hits[1].score);
+
+    // Replacing an id moves it; removal hides it.
+    EXPECT_TRUE(index.Add(2, EmbeddingVector{{0.0f, 0.0f, 1.0f}}).IsOk());
+    EXPECT_EQ(index.Size(), size_t{3});
+    EXPECT_EQ(index.DeletedCount(), size_t{1});
+    hits = index.Search(EmbeddingVector{{0.0f, 0.0f, 1.0f}}, 1);
+    EXPECT_EQ(hits[0].id, uint64_t{2});
+    EXPECT_TRUE(index.Remove(2));
+    EXPECT_TRUE(!index.Remove(2));
+    EXPECT_TRUE(!index.Contains(2));
+    hits = index.Search(EmbeddingVector{{0.0f, 0.0f, 1.0f}}, 10);
+    EXPECT_EQ(hits.size(), size_t{2});
+    for (const auto& h : hits) EXPECT_TRUE(h.id != 2);
+}
+
+void TestRecallAndDeletes() {
+    const int32_t dims = 64;
+    const auto corpus = MockCorpus(8000, dims, "doc-");
+    VectorIndexOptions opts;
+    opts.efConstruction = 100;
+    VectorIndex index(opts);
+    index.Reserve(corpus.size());
+    for (size_t i = 0; i < corpus.size(); ++i) EXPECT_TRUE(index.Add(i, corpus[i]).IsOk());
+    EXPECT_EQ(index.Size(), corpus.size());
+
+    const auto queryVecs = MockCorpus(200, dims, "query-");
+    std::vector<const float*> queries;
+    for (const auto& q : queryVecs) queries.push_back(q.values.data());
+
+    // Uniform random vectors are the hard case for any graph index.
+    const double recall = Recall(index, queries, dims, 10, 128);
+    std::printf("mock embeddings %zux%d: recall@10 %.3f (ef 128)\n", corpus.size(), dims, recall);
+    EXPECT_TRUE(recall >= 0.90);
+    EXPECT_TRUE(Recall(index, queries, dims, 10, 256) >= recall - 0.01);
+
+    // A stored vector finds itself.
+    auto self = index.Search(corpus[1234], 1);
+    EXPECT_EQ(self.size(), size_t{1});
+    EXPECT_EQ(self[0].id, uint64_t{1234});
+
+    // Delete every third vector: they vanish from results and recall holds.
+    for (size_t i = 0; i < corpus.size(); i += 3) EXPECT_TRUE(index.Remove(i));
+    EXPECT_EQ(index.DeletedCount(), (corpus.size() + 2) / 3);
+    bool noDeleted = true;
+    for (const float* q : queries) {
+        for (const auto& h : index.Search(q, dims, 10)) noDeleted &= (h.id % 3) != 0;
+    }
+    EXPECT_TRUE(noDeleted);
+    EXPECT_TRUE(Recall(index, queries, dims, 10, 128) >= 0.85);
+}
+
+void TestInt8AndPersistence() {
+    const size_t dims = 96;
+    const auto corpus = ClusteredCorpus(6000, dims, 17);
+    VectorIndexOptions opts;
+    opts.quantization = VectorQuantization::Int8;
+    opts.efConstruction = 100;
+    VectorIndex index(opts);
+    for (size_t i = 0; i < corpus.size(); ++i) {
+        EXPECT_TRUE(index.Add(1000 + i, corpus[i].data(), dims).IsOk());
+    }
+    index.Remove(1000);
+
+    std::vector<const float*> queries;
+    for (size_t i = 1; i < corpus.size(); i += 30) queries.push_back(corpus[i].data());
+    const double recall = Recall(index, queries, dims, 10, 64);
+    EXPECT_TRUE(recall >= 0.95);
+
+    // Quantized scores stay close to the float ones.
+    const double exact = IEmbeddings::CosineSimilarity(
+        EmbeddingVector{corpus[1]}, EmbeddingVector{corpus[2]});
+    bool found = false;
+    for (const auto& h : index.SearchExact(corpus[1].data(), dims, corpus.size())) {
+        if (h.id == 1002) {
+            found = true;
+            EXPECT_TRUE(std::fabs(h.score - exact) < 0.02);
+        }
+    }
+    EXPECT_TRUE(found);
+
+    const std::string path = "ultraai_test_vector_index.uavi";
+    EXPECT_TRUE(index.Save(path).IsOk());
+
+    Error err;
+    auto loaded = VectorIndex::Load(path, &err);
+    EXPECT_TRUE(loaded != nullptr);
+    EXPECT_TRUE(err.IsOk());
+    EXPECT_EQ(loaded->Size(), index.Size());
+    EXPECT_EQ(loaded->DeletedCount(), size_t{1});
+    EXPECT_EQ(loaded->Options().quantization, VectorQuantization::Int8);
+    EXPECT_TRUE(!loaded->Contains(1000));
+
+    // The mapped index answers exactly like the one it was saved from.
+    bool same = true;
+    for (const float* q : queries) {
+        const auto a = index.Search(q, dims, 10);
+        const auto b = loaded->Search(q, dims, 10);
+        same &= a.size() == b.size();
+        for (size_t i = 0; same && i < a.size(); ++i) same &= a[i].id == b[i].id && a[i].score == b[i].score;
+    }
+    EXPECT_TRUE(same);
+
+    // Mutating a loaded index copies it out of the mapping first.
+    EXPECT_TRUE(loaded->Add(1, corpus[5].data(), dims).IsOk());
+    EXPECT_TRUE(loaded->Remove(1001));
+    auto hits = loaded->Search(corpus[5].data(), dims, 2);
+    EXPECT_TRUE(hits.size() == 2 && (hits[0].id == 1 || hits[0].id == 1005));
+
+    // Damaged files are rejected, not searched.
+    {
+        std::FILE* f = std::fopen(path.c_str(), "r+b");
+        EXPECT_TRUE(f != nullptr);
+        std::fseek(f, 0, SEEK_END);
+        const long size = std::ftell(f);
+        std::fclose(f);
+        std::FILE* t = std::fopen((path + ".cut").c_str(), "wb");
+        std::FILE* s = std::fopen(path.c_str(), "rb");
+        std::vector<char> bytes(static_cast<size_t>(size));
+        EXPECT_EQ(std::fread(bytes.data(), 1, bytes.size(), s), bytes.size());
+        std::fwrite(bytes.data(), 1, bytes.size() / 2, t);
+        std::fclose(s);
+        std::fclose(t);
+    }
+    EXPECT_TRUE(VectorIndex::Load(path + ".cut", &err) == nullptr);
+    EXPECT_EQ(err.code, ErrorCode::UnsupportedFormat);
+    EXPECT_TRUE(VectorIndex::Load("does-not-exist.uavi", &err) == nullptr);
+    std::remove(path.c_str());
+    std::remove((path + ".cut").c_str());
+}
+
+void Benchmark() {
+    size_t count = 20000;
+    if (const char* env = std::getenv("ULTRAAI_BENCH_VECTORS")) count = std::strtoull(env, nullptr, 10);
+    const size_t dims = 128;
+    const auto corpus = ClusteredCorpus(count, dims, 99);
+    VectorIndexOptions opts;
+    opts.efConstruction = 100;
+    VectorIndex index(opts);
+    index.Reserve(count);
+
+    using Clock = std::chrono::steady_clock;
+    auto seconds = [](Clock::time_point a, Clock::time_point b) {
+        return std::chrono::duration<double>(b - a).count();
+    };
+    const auto t0 = Clock::now();
+    for (size_t i = 0; i < count; ++i) index.Add(i, corpus[i].data(), dims);
+    const auto t1 = Clock::now();
+
+    std::vector<const float*> queries;
+    for (size_t i = 0; i < 500 && i < count; ++i) queries.push_back(corpus[(i * 7919) % count].data());
+    size_t sink = 0;
+    const auto t2 = Clock::now();
+    for (const float* q : queries) sink += index.Search(q, dims, 10).size();
+    const auto t3 = Clock::now();
+    for (size_t i = 0; i < 20 && i < queries.size(); ++i) sink += index.SearchExact(queries[i], dims, 10).size();
+    const auto t4 = Clock::now();
+    const double recall = Recall(index, std::vector<const float*>(queries.begin(), queries.begin() + 20),
+                                 dims, 10, 0);
+
+    std::printf("%zu x %zu (%s): build %.1f s, HNSW %.0f qps, brute force %.0f qps, recall@10 %.3f\n",
+                count, dims, VectorIndex::KernelName(), seconds(t0, t1),
+                queries.size() / seconds(t2, t3), 20 / seconds(t3, t4), recall);
+    EXPECT_TRUE(sink > 0);
+    EXPECT_TRUE(recall >= 0.9);
+}
+
+} // namespace
+
+int main() {
+    TestBasics();
+    TestRecallAndDeletes();
+    TestInt8AndPersistence();
+    Benchmark();
+    std::cout << "OK: ultraai_test_vector_index" << std::endl;
+    return 0;
+}
@@ -1,7 +1,7 @@
 // OS/Linux/UltraCanvasLinuxApplication.cpp
 // Complete Linux application implementation with all methods
-// Version: 1.8.0 - Wheel delta normalized to +/-1 per notch
-// Last Modified: 2026-07-20
+// Version: 1.9.0 - Coalesced X events, frame pacing at the XRandR refresh rate
+// Last Modified: 2026-10-18
 // Author: UltraCanvas Framework
 
 #include "UltraCanvasWindow.h"
@@ -18,6 +18,7 @@
 #include <errno.h>
 #include <clocale>  // For setlocale
 #include <fontconfig/fontconfig.h>
+#include <X11/extensions/Xrandr.h>
 #include "UltraCanvasDebug.h"
 
 namespace UltraCanvas {
@@ -70,7 +71,11 @@ namespace UltraCanvas {
             // STEP 5: Initialize wakeup mechanism for cross-thread signaling
             InitializeWakeUp();
 
-            // STEP 6: Mark as initialized
+            // STEP 6: Pace repaints to the display refresh
+            SetFrameRate(QueryRefreshRate());
+            SetFramePacing(true);
+
+            // STEP 7: Mark as initialized
             initialized = true;
             running = false;
 
@@ -223,8 +228,8 @@ namespace UltraCanvas {
             ProcessXEvent(xEvent);
         }
 
-        // 2. Compute wait timeout from timer system
-        auto timeout = GetTimeUntilNextTimer();
+        // 2. Compute wait timeout from timers, queued work and the next frame
+        auto timeout = GetEventLoopTimeout();
 
         // 3. Build select() fd_set with X11 fd, wakeup fd, and any external fd
         //    watches (AddFdWatch) — e.g. a host integration's IPC sockets.
@@ -293,6 +298,21 @@ namespace UltraCanvas {
     }
 
     // ===== WAKEUP MECHANISM =====
+    double UltraCanvasLinuxApplication::QueryRefreshRate() {
+        double rate = 0.0;
+        if (display) {
+            XRRScreenConfiguration* config = XRRGetScreenInfo(display, rootWindow);
+            if (config) {
+                rate = XRRConfigCurrentRate(config);
+                XRRFreeScreenConfigInfo(config);
+            }
+        }
+        // Nested/virtual servers often report 0.
+        if (rate < 1.0) rate = 60.0;
+        debugOutput << "UltraCanvas: Display refresh rate " << rate << " Hz" << std::endl;
+        return rate;
+    }
+
     void UltraCanvasLinuxApplication::InitializeWakeUp() {
         wakeupFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
         if (wakeupFd < 0) {
@@ -397,7 +417,7 @@ namespace UltraCanvas {
             UCEvent ucEvent = ConvertXEventToUCEvent(xEvent);
 
             if (ucEvent.type != UCEventType::Unknown) {
-                PushEvent(ucEvent);
+                PushEventCoalesced(ucEvent);
             }
         }
     }
@@ -1,7 +1,7 @@
 // OS/Linux/UltraCanvasLinuxApplication.h
 // Complete Linux platform implementation for UltraCanvas Framework
-// Version: 1.4.0
-// Last Modified: 2026-05-10
+// Version: 1.5.0
+// Last Modified: 2026-10-18
 // Author: UltraCanvas Framework
 
 #pragma once
@@ -194,6 +194,8 @@ namespace UltraCanvas {
         void InitializeAtoms();
         bool InitializeXIM();
         void ShutdownXIM();
+        // Current XRandR refresh rate of the default screen; 60 if unknown.
+        double QueryRefreshRate();
 
         // ===== EVENT PROCESSING INTERNALS =====
         void EventThreadFunction();
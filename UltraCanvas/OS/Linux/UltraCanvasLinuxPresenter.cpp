@@ -0,0 +1,270 @@
+// OS/Linux/UltraCanvasLinuxPresenter.cpp
+// Client-side frame presentation for X11 windows: MIT-SHM with XPutImage fallback
+// Version: 1.0.0
+// Last Modified: 2026-10-18
+// Author: UltraCanvas Framework
+
+#include "UltraCanvasLinuxPresenter.h"
+#include "UltraCanvasDebug.h"
+
+#include <sys/ipc.h>
+#include <sys/shm.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+namespace UltraCanvas {
+
+    const char* X11PresentModeName(X11PresentMode mode) {
+        switch (mode) {
+            case X11PresentMode::Xlib:     return "xlib";
+            case X11PresentMode::PutImage: return "putimage";
+            case X11PresentMode::Shm:      return "shm";
+        }
+        return "unknown";
+    }
+
+    X11PresentMode X11RequestedPresentMode() {
+        const char* env = std::getenv("ULTRACANVAS_X11_PRESENT");
+        if (!env) return X11PresentMode::Shm;
+        const std::string value(env);
+        if (value == "xlib") return X11PresentMode::Xlib;
+        if (value == "putimage") return X11PresentMode::PutImage;
+        return X11PresentMode::Shm;
+    }
+
+    // XShmAttach failures (BadAccess from a server on another host, BadRequest
+    // from one without the extension) arrive asynchronously through the
+    // global error handler. Trap just those while attaching.
+    static constexpr int kShmAttachMinorOpcode = 1;     // X_ShmAttach (shmproto.h)
+    static int g_ShmMajorOpcode = 0;
+    static bool g_ShmAttachFailed = false;
+    static XErrorHandler g_PreviousErrorHandler = nullptr;
+
+    static int TrapShmAttachError(Display* display, XErrorEvent* error) {
+        if (error->request_code == g_ShmMajorOpcode && error->minor_code == kShmAttachMinorOpcode) {
+            g_ShmAttachFailed = true;
+            return 0;
+        }
+        return g_PreviousErrorHandler ? g_PreviousErrorHandler(display, error) : 0;
+    }
+
+    UltraCanvasLinuxPresenter::UltraCanvasLinuxPresenter(Display* display, Window window, Visual* visual, int depth)
+            : display(display), window(window), visual(visual), depth(depth) {
+    }
+
+    UltraCanvasLinuxPresenter::~UltraCanvasLinuxPresenter() {
+        DestroyBuffers();
+        if (gc) XFreeGC(display, gc);
+    }
+
+    bool UltraCanvasLinuxPresenter::IsVisualSupported(Visual* visual, int depth) {
+        if (!visual || (depth != 24 && depth != 32)) return false;
+        return visual->c_class == TrueColor &&
+               visual->red_mask == 0xff0000 && visual->green_mask == 0x00ff00 && visual->blue_mask == 0x0000ff;
+    }
+
+    bool UltraCanvasLinuxPresenter::Create(int physW, int physH, X11PresentMode preferred) {
+        DestroyBuffers();
+        if (!display || !window || physW <= 0 || physH <= 0) return false;
+        if (!IsVisualSupported(visual, depth)) {
+            debugOutput << "UltraCanvasLinuxPresenter: unsupported visual (depth " << depth << ")" << std::endl;
+            return false;
+        }
+        // cairo stores pixels as native-endian 32-bit words; the server must
+        // read them the same way.
+        const uint32_t probe = 1;
+        const bool hostLSBFirst = *reinterpret_cast<const unsigned char*>(&probe) == 1;
+        if ((ImageByteOrder(display) == LSBFirst) != hostLSBFirst) {
+            debugOutput << "UltraCanvasLinuxPresenter: server byte order differs from host" << std::endl;
+            return false;
+        }
+
+        if (!gc) gc = XCreateGC(display, window, 0, nullptr);
+
+        surface = cairo_image_surface_create(depth == 32 ? CAIRO_FORMAT_ARGB32 : CAIRO_FORMAT_RGB24, physW, physH);
+        if (cairo_surface_status(surface) != CAIRO_STATUS_SUCCESS) {
+            debugOutput << "UltraCanvasLinuxPresenter: can't create image surface" << std::endl;
+            DestroyBuffers();
+            return false;
+        }
+        width = physW;
+        height = physH;
+
+        surfaceImage = XCreateImage(display, visual, depth, ZPixmap, 0,
+                                    reinterpret_cast<char*>(cairo_image_surface_get_data(surface)),
+                                    physW, physH, 32, cairo_image_surface_get_stride(surface));
+        if (!surfaceImage || surfaceImage->bits_per_pixel != 32) {
+            debugOutput << "UltraCanvasLinuxPresenter: XCreateImage failed" << std::endl;
+            DestroyBuffers();
+            return false;
+        }
+
+        mode = X11PresentMode::PutImage;
+        if (preferred == X11PresentMode::Shm) {
+            if (XShmQueryExtension(display) && CreateShmBuffer(shmBuffers[0]) && CreateShmBuffer(shmBuffers[1])) {
+                mode = X11PresentMode::Shm;
+            } else {
+                DestroyShmBuffer(shmBuffers[0]);
+                DestroyShmBuffer(shmBuffers[1]);
+                debugOutput << "UltraCanvasLinuxPresenter: MIT-SHM unavailable, using XPutImage" << std::endl;
+            }
+        }
+        nextShmBuffer = 0;
+        return true;
+    }
+
+    bool UltraCanvasLinuxPresenter::CreateShmBuffer(ShmBuffer& buffer) {
+        buffer = ShmBuffer();
+        buffer.image = XShmCreateImage(display, visual, depth, ZPixmap, nullptr, &buffer.info, width, height);
+        if (!buffer.image) return false;
+        if (buffer.image->bits_per_pixel != 32) {
+            XDestroyImage(buffer.image);
+            buffer.image = nullptr;
+            return false;
+        }
+
+        const size_t bytes = static_cast<size_t>(buffer.image->bytes_per_line) * buffer.image->height;
+        buffer.info.shmid = shmget(IPC_PRIVATE, bytes, IPC_CREAT | 0600);
+        if (buffer.info.shmid < 0) {
+            XDestroyImage(buffer.image);
+            buffer.image = nullptr;
+            return false;
+        }
+        buffer.info.shmaddr = static_cast<char*>(shmat(buffer.info.shmid, nullptr, 0));
+        if (buffer.info.shmaddr == reinterpret_cast<char*>(-1)) {
+            shmctl(buffer.info.shmid, IPC_RMID, nullptr);
+            XDestroyImage(buffer.image);
+            buffer.image = nullptr;
+            return false;
+        }
+        buffer.image->data = buffer.info.shmaddr;
+        buffer.info.readOnly = False;
+
+        int firstEvent = 0, firstError = 0;
+        XQueryExtension(display, "MIT-SHM", &g_ShmMajorOpcode, &firstEvent, &firstError);
+        g_ShmAttachFailed = false;
+        g_PreviousErrorHandler = XSetErrorHandler(TrapShmAttachError);
+        const bool attached = XShmAttach(display, &buffer.info) != 0;
+        XSync(display, False);
+        XSetErrorHandler(g_PreviousErrorHandler);
+        g_PreviousErrorHandler = nullptr;
+
+        // Marked for removal now: the segment goes away once both this
+        // process and the server have detached, even if we crash.
+        shmctl(buffer.info.shmid, IPC_RMID, nullptr);
+
+        if (!attached || g_ShmAttachFailed) {
+            shmdt(buffer.info.shmaddr);
+            buffer.image->data = nullptr;
+            XDestroyImage(buffer.image);
+            buffer = ShmBuffer();
+            return false;
+        }
+        return true;
+    }
+
+    void UltraCanvasLinuxPresenter::DestroyShmBuffer(ShmBuffer& buffer) {
+        if (!buffer.image) return;
+        if (buffer.info.shmaddr) {
+            XShmDetach(display, &buffer.info);
+            // The server must be done with the segment before it is unmapped.
+            XSync(display, False);
+            shmdt(buffer.info.shmaddr);
+        }
+        buffer.image->data = nullptr;
+        XDestroyImage(buffer.image);
+        buffer = ShmBuffer();
+    }
+
+    void UltraCanvasLinuxPresenter::DestroyBuffers() {
+        DestroyShmBuffer(shmBuffers[0]);
+        DestroyShmBuffer(shmBuffers[1]);
+        if (surfaceImage) {
+            surfaceImage->data = nullptr;   // cairo owns the pixels
+            XDestroyImage(surfaceImage);
+            surfaceImage = nullptr;
+        }
+        if (surface) {
+            cairo_surface_destroy(surface);
+            surface = nullptr;
+        }
+        width = height = 0;
+    }
+
+    UltraCanvasLinuxPresenter::ShmBuffer& UltraCanvasLinuxPresenter::AcquireShmBuffer() {
+        ShmBuffer& buffer = shmBuffers[nextShmBuffer];
+        nextShmBuffer ^= 1;
+        if (buffer.pending) {
+            // The completion event of the buffer's last upload tells Xlib the
+            // server got past that request; read whatever has arrived.
+            XEventsQueued(display, QueuedAfterReading);
+            if (LastKnownRequestProcessed(display) < buffer.pendingSerial) {
+                XSync(display, False);
+                stats.bufferWaits++;
+            }
+            buffer.pending = false;
+        }
+        return buffer;
+    }
+
+    void UltraCanvasLinuxPresenter::Present(const std::vector<Rect2Di>& damage) {
+        if (!surface || damage.empty()) return;
+        const auto start = std::chrono::steady_clock::now();
+
+        double sx = 1.0, sy = 1.0;
+        cairo_surface_get_device_scale(surface, &sx, &sy);
+        deviceRects.clear();
+        for (const auto& r : damage) {
+            const int x0 = std::max(0, static_cast<int>(std::floor(r.x * sx)));
+            const int y0 = std::max(0, static_cast<int>(std::floor(r.y * sy)));
+            const int x1 = std::min(width, static_cast<int>(std::ceil((r.x + r.width) * sx)));
+            const int y1 = std::min(height, static_cast<int>(std::ceil((r.y + r.height) * sy)));
+            if (x1 > x0 && y1 > y0) deviceRects.emplace_back(x0, y0, x1 - x0, y1 - y0);
+        }
+        if (deviceRects.empty()) return;
+
+        cairo_surface_flush(surface);
+        uint64_t bytes = 0;
+        if (mode == X11PresentMode::Shm) {
+            ShmBuffer& buffer = AcquireShmBuffer();
+            const unsigned char* src = cairo_image_surface_get_data(surface);
+            const int srcStride = cairo_image_surface_get_stride(surface);
+            const int dstStride = buffer.image->bytes_per_line;
+            for (const auto& r : deviceRects) {
+                const size_t rowBytes = static_cast<size_t>(r.width) * 4u;
+                for (int y = r.y; y < r.y + r.height; y++) {
+                    std::memcpy(buffer.image->data + static_cast<size_t>(y) * dstStride + r.x * 4,
+                                src + static_cast<size_t>(y) * srcStride + r.x * 4, rowBytes);
+                }
+            }
+            for (size_t i = 0; i < deviceRects.size(); i++) {
+                const auto& r = deviceRects[i];
+                // Only the last upload asks for a completion event: the
+                // server handles requests in order, so it covers them all.
+                const bool last = i + 1 == deviceRects.size();
+                XShmPutImage(display, window, gc, buffer.image, r.x, r.y, r.x, r.y,
+                             r.width, r.height, last ? True : False);
+                bytes += static_cast<uint64_t>(r.width) * r.height * 4u;
+            }
+            buffer.pendingSerial = NextRequest(display) - 1;
+            buffer.pending = true;
+        } else {
+            for (const auto& r : deviceRects) {
+                XPutImage(display, window, gc, surfaceImage, r.x, r.y, r.x, r.y, r.width, r.height);
+                bytes += static_cast<uint64_t>(r.width) * r.height * 4u;
+            }
+        }
+        XFlush(display);
+
+        stats.presents++;
+        stats.rects += deviceRects.size();
+        stats.bytes += bytes;
+        stats.presentMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+} // namespace UltraCanvas
@@ -0,0 +1,124 @@
+// OS/Linux/UltraCanvasLinuxPresenter.h
+// Client-side frame presentation for X11 windows: MIT-SHM with XPutImage fallback
+// Version: 1.0.0
+// Last Modified: 2026-10-18
+// Author: UltraCanvas Framework
+#pragma once
+
+#ifndef ULTRACANVAS_LINUX_PRESENTER_H
+#define ULTRACANVAS_LINUX_PRESENTER_H
+
+#include "UltraCanvasCommonTypes.h"
+
+#include <X11/Xlib.h>
+#include <X11/Xutil.h>
+#include <X11/extensions/XShm.h>
+#include <cairo/cairo.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace UltraCanvas {
+
+    // How a Linux window's frames reach the X server.
+    enum class X11PresentMode {
+        Xlib,       // cairo-xlib surface on the window: every cairo call is X protocol
+        PutImage,   // client-side image surface, changed areas sent with XPutImage
+        Shm         // client-side image surface, changed areas sent with XShmPutImage
+    };
+
+    const char* X11PresentModeName(X11PresentMode mode);
+
+    // Mode asked for with ULTRACANVAS_X11_PRESENT=xlib|putimage|shm; Shm when
+    // unset or unrecognised.
+    X11PresentMode X11RequestedPresentMode();
+
+    struct X11PresentStats {
+        uint64_t presents = 0;
+        uint64_t rects = 0;
+        uint64_t bytes = 0;             // pixel bytes handed to the server
+        uint64_t bufferWaits = 0;       // presents that had to wait for the server to release a buffer
+        double presentMs = 0;           // client-side time spent in Present()
+    };
+
+    // ===== X11 PRESENTER =====
+    // Owns the window's drawing surface when it is not a cairo-xlib surface:
+    // a client-side cairo image surface at physical size. The window composes
+    // each frame into it as usual; Present() then sends only the changed
+    // rectangles to the X window.
+    //
+    // With MIT-SHM the pixels travel through two shared-memory segments used
+    // alternately. XShmPutImage is asynchronous — the server reads the segment
+    // some time after the call — so a frame is copied into the segment the
+    // server is not reading, and the previous frame's upload is never
+    // overwritten half-way (no torn frames). Only when the server is more than
+    // one frame behind does Present() wait for it.
+    //
+    // Without SHM (remote display, extension missing, attach refused) the same
+    // rectangles go through XPutImage straight from the image surface; Xlib
+    // copies them into the request stream, so no second buffer is needed.
+    //
+    // Requires a 24- or 32-bit TrueColor visual with the standard 8-8-8 masks
+    // and host byte order; Create() fails otherwise and the window keeps the
+    // cairo-xlib path. UI thread only.
+    class UltraCanvasLinuxPresenter {
+    public:
+        UltraCanvasLinuxPresenter(Display* display, Window window, Visual* visual, int depth);
+        ~UltraCanvasLinuxPresenter();
+
+        UltraCanvasLinuxPresenter(const UltraCanvasLinuxPresenter&) = delete;
+        UltraCanvasLinuxPresenter& operator=(const UltraCanvasLinuxPresenter&) = delete;
+
+        // (Re)allocates the surface and buffers at physW × physH device
+        // pixels. `mode` is the preferred transport; Shm degrades to PutImage
+        // when shared memory can't be set up. Returns false when the visual
+        // is unsupported or allocation failed.
+        bool Create(int physW, int physH, X11PresentMode mode);
+
+        // The surface to compose frames into. Owned by the presenter; callers
+        // that keep it take their own cairo reference.
+        cairo_surface_t* GetSurface() const { return surface; }
+
+        // Sends `damage` (logical window coordinates, scaled by the surface's
+        // device scale and clipped to it) to the window.
+        void Present(const std::vector<Rect2Di>& damage);
+
+        X11PresentMode GetMode() const { return mode; }
+        const X11PresentStats& GetStats() const { return stats; }
+        void ResetStats() { stats = X11PresentStats(); }
+
+        static bool IsVisualSupported(Visual* visual, int depth);
+
+    private:
+        struct ShmBuffer {
+            XShmSegmentInfo info{};
+            XImage* image = nullptr;
+            unsigned long pendingSerial = 0;    // request serial of its last XShmPutImage
+            bool pending = false;
+        };
+
+        bool CreateShmBuffer(ShmBuffer& buffer);
+        void DestroyShmBuffer(ShmBuffer& buffer);
+        void DestroyBuffers();
+        ShmBuffer& AcquireShmBuffer();
+
+        Display* display;
+        Window window;
+        Visual* visual;
+        int depth;
+        GC gc = nullptr;
+
+        X11PresentMode mode = X11PresentMode::PutImage;
+        int width = 0, height = 0;
+        cairo_surface_t* surface = nullptr;
+        XImage* surfaceImage = nullptr;         // XPutImage view of `surface`'s pixels
+        ShmBuffer shmBuffers[2];
+        int nextShmBuffer = 0;
+
+        std::vector<Rect2Di> deviceRects;       // scratch
+        X11PresentStats stats;
+    };
+
+} // namespace UltraCanvas
+
+#endif // ULTRACANVAS_LINUX_PRESENTER_H
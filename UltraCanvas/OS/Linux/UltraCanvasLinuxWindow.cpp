@@ -1,7 +1,7 @@
 // OS/Linux/UltraCanvasLinuxWindow.cpp
 // Complete Linux window implementation with all methods
-// Version: 1.2.0 - per-monitor HiDPI: physical surface/window, hybrid DPI detect
-// Last Modified: 2026-07-03
+// Version: 1.3.0 - client-side surface presented through MIT-SHM / XPutImage
+// Last Modified: 2026-10-18
 // Author: UltraCanvas Framework
 
 #include "UltraCanvasApplication.h"
@@ -283,10 +283,31 @@ namespace UltraCanvas {
         const int physW = LogicalToPhysical(config_.width);
         const int physH = LogicalToPhysical(config_.height);
 
-        nativeSurface = cairo_xlib_surface_create(
-                display, xWindow, visual,
-                physW, physH
-        );
+        // Preferred: compose into client memory and upload only the changed
+        // rectangles (see UltraCanvasLinuxPresenter). The cairo-xlib surface
+        // remains for ULTRACANVAS_X11_PRESENT=xlib and visuals the presenter
+        // can't handle.
+        const X11PresentMode wantedMode = X11RequestedPresentMode();
+        if (wantedMode != X11PresentMode::Xlib) {
+            if (!presenter) {
+                presenter = std::make_unique<UltraCanvasLinuxPresenter>(display, xWindow, visual,
+                                                                        application->GetDepth());
+            }
+            if (presenter->Create(physW, physH, wantedMode)) {
+                nativeSurface = cairo_surface_reference(presenter->GetSurface());
+                debugOutput << "UltraCanvas Linux: presenting through "
+                            << X11PresentModeName(presenter->GetMode()) << std::endl;
+            } else {
+                presenter.reset();
+            }
+        }
+
+        if (!nativeSurface) {
+            nativeSurface = cairo_xlib_surface_create(
+                    display, xWindow, visual,
+                    physW, physH
+            );
+        }
 
         if (!nativeSurface) {
             debugOutput << "UltraCanvas Linux: cairo_xlib_surface_create failed" << std::endl;
@@ -408,7 +429,9 @@ namespace UltraCanvas {
         std::lock_guard<std::mutex> lock(cairoMutex);
 
         auto old = nativeSurface;
+        nativeSurface = nullptr;
         if (!CreateNativeCairoSurface()) {
+            nativeSurface = old;
             return false;
         }
         if (old) {
@@ -495,6 +518,7 @@ namespace UltraCanvas {
             cairo_surface_destroy(static_cast<cairo_surface_t *>(nativeSurface));
             nativeSurface = nullptr;
         }
+        presenter.reset();
     }
 
     void UltraCanvasLinuxWindow::DestroyNative() {
@@ -882,6 +906,11 @@ namespace UltraCanvas {
     }
 
     void UltraCanvasLinuxWindow::InvalidateWindowNative() {
+        // cairo-xlib surfaces draw straight into the window; a client-side
+        // surface has to be uploaded.
+        if (presenter && !frameDamage.empty()) {
+            presenter->Present(frameDamage);
+        }
 //        cairo_surface_t *ctxSurface = static_cast<cairo_surface_t *>(renderContext->GetSurface());
 //        cairo_surface_flush(stagingSurface);
 //        // Copy staging surface to window surface
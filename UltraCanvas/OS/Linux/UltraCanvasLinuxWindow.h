@@ -1,7 +1,7 @@
 // OS/Linux/UltraCanvasX11Window.h
 // Linux platform implementation for UltraCanvas Framework
-// Version: 1.1.0 - per-monitor HiDPI (deviceScale) support
-// Last Modified: 2026-07-03
+// Version: 1.2.0 - client-side surface presented through MIT-SHM / XPutImage
+// Last Modified: 2026-10-18
 // Author: UltraCanvas Framework
 #pragma once
 
@@ -22,6 +22,7 @@
 #include <pango/pangocairo.h>
 
 #include "UltraCanvasLinuxDragDrop.h"
+#include "UltraCanvasLinuxPresenter.h"
 
 // ===== STANDARD INCLUDES =====
 #include <memory>
@@ -46,6 +47,10 @@ namespace UltraCanvas {
 
         UltraCanvasLinuxDragDrop dragDropHandler;
 
+        // Client-side surface + MIT-SHM/XPutImage upload; null on the
+        // cairo-xlib path (ULTRACANVAS_X11_PRESENT=xlib or unsupported visual).
+        std::unique_ptr<UltraCanvasLinuxPresenter> presenter;
+
         bool CreateNative() override;
         void DestroyNative() override;
         std::mutex cairoMutex;  // Add this
@@ -90,6 +95,15 @@ namespace UltraCanvas {
         Window GetXWindow() const { return xWindow; }
         XIC GetXIC() const { return xic; }
 
+        // How frames reach the X server; chosen from ULTRACANVAS_X11_PRESENT
+        // when the surface is created. Stats stay zero on the xlib path.
+        X11PresentMode GetPresentMode() const {
+            return presenter ? presenter->GetMode() : X11PresentMode::Xlib;
+        }
+        X11PresentStats GetPresentStats() const {
+            return presenter ? presenter->GetStats() : X11PresentStats();
+        }
+
 
         bool HandleXEvent(const XEvent& event);
 
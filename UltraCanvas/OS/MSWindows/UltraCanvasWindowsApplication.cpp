@@ -234,8 +234,8 @@ namespace UltraCanvas {
             DispatchMessageW(&msg);
         }
 
-        // 2. Compute wait timeout from timer system
-        auto timeout = GetTimeUntilNextTimer();
+        // 2. Compute wait timeout from timers and queued work
+        auto timeout = GetEventLoopTimeout();
         DWORD waitMs = (timeout == std::chrono::milliseconds::max())
                        ? INFINITE
                        : static_cast<DWORD>(timeout.count());
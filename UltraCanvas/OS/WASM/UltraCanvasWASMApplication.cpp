@@ -9,6 +9,7 @@
 #include "UltraCanvasWASMWindow.h"
 #include "../../include/UltraCanvasClipboard.h"
 #include "../../include/UltraCanvasImage.h"
+#include "../../include/UltraCanvasImageDecodeService.h"
 #include "../../include/UltraCanvasDebug.h"
 
 #include <fontconfig/fontconfig.h>
@@ -110,6 +111,8 @@ namespace UltraCanvas {
 
         ShutdownClipboard();
         ShutdownNative();
+        // Decode workers use libvips: stop them before it goes away.
+        UCImageDecodeService::GetInstance().Shutdown();
         UCImage::ShutdownImageSubsysterm();
 
         emscripten_cancel_main_loop();
@@ -1,7 +1,7 @@
 // Plugins/Diagrams/UltraCanvasDiagramRouting.cpp
 // Shared orthogonal connection routing for the diagram family
-// Version: 1.0.0
-// Last Modified: 2026-07-30
+// Version: 1.1.0
+// Last Modified: 2026-10-18
 // Author: UltraCanvas Framework
 //
 // Extraction of the router developed in UltraCanvasFlowChart.cpp (2.1.4
@@ -12,10 +12,12 @@
 #include "Plugins/Diagrams/UltraCanvasDiagramRouting.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <cstdint>
 #include <limits>
-#include <queue>
+#include <thread>
+#include <functional>
 #include <unordered_map>
 
 namespace UltraCanvas {
@@ -165,6 +167,260 @@ std::vector<Point2Dd> Orthogonalize(const std::vector<Point2Dd>& points,
     return out;
 }
 
+// Per-search working memory. Owned by the caller so a batch worker can keep
+// the allocations from one connection to the next.
+//
+// Best-g bookkeeping is a hash map by default. A batch worker switches it to
+// a flat per-(cell, direction) table with UseDenseTable(): no hashing, and a
+// generation stamp instead of clearing the table between searches.
+struct AStarScratch {
+    std::vector<AStarNode> visited;
+    std::vector<AStarOpenEntry> open;               // binary heap (min on f)
+    std::unordered_map<uint64_t, double> bestG;
+
+    int denseWidth = 0;                             // 0 -> use bestG
+    std::vector<double> denseG;
+    std::vector<uint32_t> denseStamp;
+    uint32_t generation = 0;
+
+    void UseDenseTable(int gridW, int gridH) {
+        size_t size = static_cast<size_t>(gridW) * static_cast<size_t>(gridH) * 4;
+        denseWidth = gridW;
+        if (denseG.size() != size) {
+            denseG.assign(size, 0.0);
+            denseStamp.assign(size, 0);
+            generation = 0;
+        }
+    }
+
+    void Reset() {
+        visited.clear();
+        open.clear();
+        bestG.clear();
+        if (denseWidth > 0 && ++generation == 0) {
+            std::fill(denseStamp.begin(), denseStamp.end(), 0);
+            generation = 1;
+        }
+    }
+
+    // Cells passed in are always inside the grid: the search only steps onto
+    // cells the blocked test accepted, and that test rejects the outside.
+    bool FindBest(int x, int y, int d, double& g) const {
+        if (denseWidth > 0) {
+            size_t i = (static_cast<size_t>(y) * denseWidth + x) * 4 + d;
+            if (denseStamp[i] != generation) return false;
+            g = denseG[i];
+            return true;
+        }
+        auto it = bestG.find(PackCellDir(x, y, d));
+        if (it == bestG.end()) return false;
+        g = it->second;
+        return true;
+    }
+
+    void StoreBest(int x, int y, int d, double g) {
+        if (denseWidth > 0) {
+            size_t i = (static_cast<size_t>(y) * denseWidth + x) * 4 + d;
+            denseStamp[i] = generation;
+            denseG[i] = g;
+            return;
+        }
+        bestG[PackCellDir(x, y, d)] = g;
+    }
+};
+
+inline int GridExtent(double extent, double gridSize) {
+    return std::max(2, static_cast<int>(std::ceil(extent / gridSize)));
+}
+
+// The A* search behind RouteAStar. `cellBlocked(cx, cy)` decides which grid
+// cells are free; everything else - anchoring, costs, tie-breaking, path
+// clean-up - is shared by the per-call and the indexed entry points, so both
+// return the same path for the same obstacles.
+template <typename CellBlocked>
+std::vector<Point2Dd> SearchGrid(const Point2Dd& start, const Point2Dd& end,
+                                 DiagramCardinalSide sourceSide, DiagramCardinalSide targetSide,
+                                 const DiagramRoutingOptions& options,
+                                 const CellBlocked& cellBlocked, AStarScratch& scratch) {
+    const double gridSize = options.gridSize > 0.0 ? options.gridSize : 20.0;
+    const Rect2Dd& area = options.routingArea;
+
+    auto worldToCell = [&](const Point2Dd& p) -> std::pair<int, int> {
+        return {
+            static_cast<int>(std::floor((p.x - area.x) / gridSize)),
+            static_cast<int>(std::floor((p.y - area.y) / gridSize))
+        };
+    };
+
+    auto srcCell = worldToCell(start);
+    auto tgtCell = worldToCell(end);
+    auto srcOff  = SideOffset(sourceSide);
+    auto tgtOff  = SideOffset(targetSide);
+
+    // Step ONE cell outside the source/target so the start/goal of the search
+    // sit in free space (the cells inside those boxes are blocked for everyone
+    // else, but we are using them as anchors).
+    int sx = srcCell.first  + srcOff.first;
+    int sy = srcCell.second + srcOff.second;
+    int gx = tgtCell.first  + tgtOff.first;
+    int gy = tgtCell.second + tgtOff.second;
+
+    if (cellBlocked(sx, sy) || cellBlocked(gx, gy)) {
+        return {};  // Anchor cells themselves are blocked: A* cannot start.
+    }
+
+    const int initialDir = SideDir(sourceSide);
+    const int goalDir    = RequiredApproachDir(targetSide);
+
+    // 4-connected grid moves: dx, dy per direction (0=N, 1=E, 2=S, 3=W).
+    static const int DX[4] = { 0, 1, 0, -1};
+    static const int DY[4] = {-1, 0, 1,  0};
+
+    auto manhattan = [&](int x, int y) -> double {
+        return static_cast<double>(std::abs(x - gx) + std::abs(y - gy));
+    };
+
+    scratch.Reset();
+    std::vector<AStarNode>& visited = scratch.visited;
+    std::vector<AStarOpenEntry>& open = scratch.open;
+    visited.reserve(256);
+
+    // `open` is a heap maintained with the same comparator std::priority_queue
+    // would use, so the expansion order - and the path on ties - matches it.
+    auto pushOpen = [&](const AStarOpenEntry& e) {
+        open.push_back(e);
+        std::push_heap(open.begin(), open.end(), std::less<AStarOpenEntry>());
+    };
+
+    AStarNode startNode{sx, sy, initialDir, 0.0, manhattan(sx, sy), -1};
+    visited.push_back(startNode);
+    pushOpen({startNode.f, 0});
+    scratch.StoreBest(sx, sy, initialDir, 0.0);
+
+    const double turnPenalty = options.turnPenalty;
+    const int maxExpansions = options.maxExpansions;
+    int expansions = 0;
+    int goalIdx = -1;
+
+    while (!open.empty() && expansions < maxExpansions) {
+        std::pop_heap(open.begin(), open.end(), std::less<AStarOpenEntry>());
+        AStarOpenEntry top = open.back();
+        open.pop_back();
+        ++expansions;
+
+        // NOTE: a *copy*, not a reference. The expansion loop below pushes into
+        // `visited`, and a reallocation would leave a reference dangling — a
+        // use-after-free that FlowChart 2.2.0 shipped with and that fires as
+        // soon as the search outgrows the reserved capacity.
+        const AStarNode cur = visited[top.idx];
+
+        // Goal: cell matches AND we arrived facing the right way.
+        if (cur.x == gx && cur.y == gy && cur.dirFromParent == goalDir) {
+            goalIdx = top.idx;
+            break;
+        }
+
+        // Stale entry (a better g was already found): skip.
+        double bestCur;
+        if (scratch.FindBest(cur.x, cur.y, cur.dirFromParent, bestCur) &&
+            cur.g > bestCur + 0.001) continue;
+
+        for (int d = 0; d < 4; ++d) {
+            int nx = cur.x + DX[d];
+            int ny = cur.y + DY[d];
+            if (cellBlocked(nx, ny)) continue;
+
+            double stepCost = 1.0;
+            if (cur.dirFromParent != -1 && d != cur.dirFromParent) {
+                stepCost += turnPenalty;
+            }
+            double ng = cur.g + stepCost;
+            double bestNext;
+            if (scratch.FindBest(nx, ny, d, bestNext) && ng >= bestNext - 0.001) continue;
+            scratch.StoreBest(nx, ny, d, ng);
+
+            int parentIdx = top.idx;
+            AStarNode nn{nx, ny, d, ng, ng + manhattan(nx, ny), parentIdx};
+            visited.push_back(nn);
+            pushOpen({nn.f, static_cast<int>(visited.size()) - 1});
+        }
+    }
+
+    if (goalIdx < 0) return {};
+
+    // Reconstruct the cell path (goal -> start, then reverse).
+    std::vector<std::pair<int, int>> cellPath;
+    int idx = goalIdx;
+    while (idx != -1) {
+        const AStarNode& n = visited[idx];
+        cellPath.emplace_back(n.x, n.y);
+        idx = n.parentIdx;
+    }
+    std::reverse(cellPath.begin(), cellPath.end());
+
+    // Convert to world waypoints (cell centres), keeping only corners so long
+    // straight runs collapse to a single segment.
+    std::vector<Point2Dd> raw;
+    raw.reserve(cellPath.size());
+    for (auto& c : cellPath) {
+        raw.push_back(Point2Dd(area.x + (c.first  + 0.5) * gridSize,
+                               area.y + (c.second + 0.5) * gridSize));
+    }
+
+    std::vector<Point2Dd> simplified;
+    simplified.push_back(raw.front());
+    for (size_t i = 1; i + 1 < raw.size(); ++i) {
+        double dx1 = raw[i].x - raw[i - 1].x, dy1 = raw[i].y - raw[i - 1].y;
+        double dx2 = raw[i + 1].x - raw[i].x, dy2 = raw[i + 1].y - raw[i].y;
+        // Collinear iff both steps run on the same axis with the same sign.
+        bool h1 = std::abs(dx1) > 0.5, h2 = std::abs(dx2) > 0.5;
+        bool sameSign = (h1 ? (dx1 * dx2 > 0.0) : (dy1 * dy2 > 0.0));
+        if (h1 == h2 && sameSign) continue;
+        simplified.push_back(raw[i]);
+    }
+    if (raw.size() > 1) simplified.push_back(raw.back());
+
+    // Stitch the exact endpoints onto the simplified cell path, then insert
+    // whatever corners are needed to keep every segment axis-aligned. The
+    // orthogonalizer forces the first segment onto the source side's axis and
+    // the last onto the target side's, so the path still meets both boxes
+    // head-on.
+    std::vector<Point2Dd> stitched;
+    stitched.reserve(simplified.size() + 2);
+    stitched.push_back(start);
+    for (const auto& p : simplified) stitched.push_back(p);
+    stitched.push_back(end);
+
+    return NormalizePath(Orthogonalize(stitched, sourceSide, targetSide));
+}
+
+// Same-cell test RouteAStar has always used: the cell centre lies inside the
+// obstacle grown by `pad`.
+inline bool CellCentreInside(const Rect2Dd& o, double wx, double wy, double pad) {
+    return wx >= o.x - pad && wx <= o.x + o.width + pad &&
+           wy >= o.y - pad && wy <= o.y + o.height + pad;
+}
+
+// PathHasObstacles' per-obstacle test, shared with the indexed variant.
+inline bool SegmentHitsObstacle(const Point2Dd& a, const Point2Dd& c,
+                                const Rect2Dd& o, double inset) {
+    double l = o.x + inset, r = o.x + o.width - inset;
+    double t = o.y + inset, b = o.y + o.height - inset;
+    if (std::abs(a.y - c.y) < 0.5) {
+        // Horizontal segment at y = a.y.
+        double y = a.y;
+        if (y < t || y > b) return false;
+        return std::max(a.x, c.x) >= l && std::min(a.x, c.x) <= r;
+    }
+    if (std::abs(a.x - c.x) < 0.5) {
+        // Vertical segment at x = a.x.
+        double x = a.x;
+        if (x < l || x > r) return false;
+        return std::max(a.y, c.y) >= t && std::min(a.y, c.y) <= b;
+    }
+    return false;
+}
+
 } // namespace
 
 // =============================================================================
@@ -311,29 +567,9 @@ bool UltraCanvasDiagramRouter::PathHasObstacles(const std::vector<Point2Dd>& pat
     if (path.size() < 2) return false;
 
     for (const auto& obstacle : obstacles) {
-        const Rect2Dd& o = obstacle.bounds;
-        double l = o.x + inset, r = o.x + o.width - inset;
-        double t = o.y + inset, b = o.y + o.height - inset;
-
+        // All segments are axis-aligned by construction.
         for (size_t i = 1; i < path.size(); ++i) {
-            const Point2Dd& a = path[i - 1];
-            const Point2Dd& c = path[i];
-            // All segments are axis-aligned by construction.
-            if (std::abs(a.y - c.y) < 0.5) {
-                // Horizontal segment at y = a.y.
-                double y = a.y;
-                if (y < t || y > b) continue;
-                double xMin = std::min(a.x, c.x);
-                double xMax = std::max(a.x, c.x);
-                if (xMax >= l && xMin <= r) return true;
-            } else if (std::abs(a.x - c.x) < 0.5) {
-                // Vertical segment at x = a.x.
-                double x = a.x;
-                if (x < l || x > r) continue;
-                double yMin = std::min(a.y, c.y);
-                double yMax = std::max(a.y, c.y);
-                if (yMax >= t && yMin <= b) return true;
-            }
+            if (SegmentHitsObstacle(path[i - 1], path[i], obstacle.bounds, inset)) return true;
         }
     }
     return false;
@@ -352,8 +588,8 @@ std::vector<Point2Dd> UltraCanvasDiagramRouter::RouteAStar(
     const Rect2Dd& area = options.routingArea;
 
     // Grid extent in world coordinates, relative to the routing area origin.
-    int gridW = std::max(2, static_cast<int>(std::ceil(area.width  / gridSize)));
-    int gridH = std::max(2, static_cast<int>(std::ceil(area.height / gridSize)));
+    int gridW = GridExtent(area.width,  gridSize);
+    int gridH = GridExtent(area.height, gridSize);
 
     const double pad = gridSize * options.obstaclePaddingCells;
 
@@ -364,175 +600,384 @@ std::vector<Point2Dd> UltraCanvasDiagramRouter::RouteAStar(
         double wx = area.x + (cx + 0.5) * gridSize;
         double wy = area.y + (cy + 0.5) * gridSize;
         for (const auto& obstacle : obstacles) {
-            const Rect2Dd& o = obstacle.bounds;
-            if (wx >= o.x - pad && wx <= o.x + o.width + pad &&
-                wy >= o.y - pad && wy <= o.y + o.height + pad) {
-                return true;
-            }
+            if (CellCentreInside(obstacle.bounds, wx, wy, pad)) return true;
         }
         return false;
     };
 
-    auto worldToCell = [&](const Point2Dd& p) -> std::pair<int, int> {
-        return {
-            static_cast<int>(std::floor((p.x - area.x) / gridSize)),
-            static_cast<int>(std::floor((p.y - area.y) / gridSize))
-        };
-    };
-
-    auto srcCell = worldToCell(start);
-    auto tgtCell = worldToCell(end);
-    auto srcOff  = SideOffset(sourceSide);
-    auto tgtOff  = SideOffset(targetSide);
+    AStarScratch scratch;
+    return SearchGrid(start, end, sourceSide, targetSide, options, cellBlocked, scratch);
+}
 
-    // Step ONE cell outside the source/target so the start/goal of the search
-    // sit in free space (the cells inside those boxes are blocked for everyone
-    // else, but we are using them as anchors).
-    int sx = srcCell.first  + srcOff.first;
-    int sy = srcCell.second + srcOff.second;
-    int gx = tgtCell.first  + tgtOff.first;
-    int gy = tgtCell.second + tgtOff.second;
+// =============================================================================
+// TOP-LEVEL ENTRY POINT
+// =============================================================================
 
-    if (cellBlocked(sx, sy) || cellBlocked(gx, gy)) {
-        return {};  // Anchor cells themselves are blocked: A* cannot start.
+std::vector<Point2Dd> UltraCanvasDiagramRouter::ComputeOrthogonalPath(
+        const Point2Dd& start, const Point2Dd& end,
+        DiagramCardinalSide sourceSide, DiagramCardinalSide targetSide,
+        const std::vector<DiagramObstacle>& obstacles,
+        const DiagramRoutingOptions& options) {
+    auto cheap = ComputeCardinalPath(start, end, sourceSide, targetSide);
+    if (!PathHasObstacles(cheap, obstacles, options.obstacleInset)) {
+        return cheap;
+    }
+    auto astar = RouteAStar(start, end, sourceSide, targetSide, obstacles, options);
+    if (astar.empty()) {
+        return cheap;  // silent fallback: a visible connection beats none
     }
+    return astar;
+}
 
-    const int initialDir = SideDir(sourceSide);
-    const int goalDir    = RequiredApproachDir(targetSide);
+// =============================================================================
+// OBSTACLE INDEX
+// =============================================================================
 
-    // 4-connected grid moves: dx, dy per direction (0=N, 1=E, 2=S, 3=W).
-    static const int DX[4] = { 0, 1, 0, -1};
-    static const int DY[4] = {-1, 0, 1,  0};
+namespace {
 
-    auto manhattan = [&](int x, int y) -> double {
-        return static_cast<double>(std::abs(x - gx) + std::abs(y - gy));
-    };
+inline uint64_t PackBucket(int64_t bx, int64_t by) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(bx)) << 32)
+         | static_cast<uint64_t>(static_cast<uint32_t>(by));
+}
 
-    std::vector<AStarNode> visited;
-    visited.reserve(256);
-    std::priority_queue<AStarOpenEntry> open;
-    std::unordered_map<uint64_t, double> bestG;
+inline int64_t BucketCoord(double v, double bucketSize) {
+    return static_cast<int64_t>(std::floor(v / bucketSize));
+}
 
-    AStarNode startNode{sx, sy, initialDir, 0.0, manhattan(sx, sy), -1};
-    visited.push_back(startNode);
-    open.push({startNode.f, 0});
-    bestG[PackCellDir(sx, sy, initialDir)] = 0.0;
+} // namespace
 
-    const double turnPenalty = options.turnPenalty;
-    const int maxExpansions = options.maxExpansions;
-    int expansions = 0;
-    int goalIdx = -1;
+void DiagramObstacleIndex::Build(const std::vector<DiagramObstacle>& newObstacles,
+                                 const DiagramRoutingOptions& newOptions) {
+    options = newOptions;
+    obstacles = newObstacles;
+    gridSize = options.gridSize > 0.0 ? options.gridSize : 20.0;
+    pad = gridSize * options.obstaclePaddingCells;
+    gridW = GridExtent(options.routingArea.width,  gridSize);
+    gridH = GridExtent(options.routingArea.height, gridSize);
+    coverage.assign(static_cast<size_t>(gridW) * static_cast<size_t>(gridH), 0);
+
+    // Buckets a few obstacles wide: a segment then tests the handful of
+    // obstacles it passes, and an obstacle lands in a handful of buckets.
+    double meanExtent = 0.0;
+    for (const auto& o : obstacles) {
+        meanExtent += std::max(o.bounds.width, o.bounds.height);
+    }
+    if (!obstacles.empty()) meanExtent /= static_cast<double>(obstacles.size());
+    bucketSize = std::max(gridSize * 4.0, meanExtent * 2.0);
+    buckets.clear();
 
-    while (!open.empty() && expansions < maxExpansions) {
-        AStarOpenEntry top = open.top();
-        open.pop();
-        ++expansions;
+    for (size_t i = 0; i < obstacles.size(); ++i) {
+        Rasterize(i, 1);
+        Bucket(i, true);
+    }
+}
 
-        // NOTE: a *copy*, not a reference. The expansion loop below pushes into
-        // `visited`, and a reallocation would leave a reference dangling — a
-        // use-after-free that FlowChart 2.2.0 shipped with and that fires as
-        // soon as the search outgrows the reserved capacity.
-        const AStarNode cur = visited[top.idx];
+void DiagramObstacleIndex::UpdateObstacle(size_t index, const Rect2Dd& bounds) {
+    if (index >= obstacles.size()) return;
+    Rasterize(index, -1);
+    Bucket(index, false);
+    obstacles[index].bounds = bounds;
+    Rasterize(index, 1);
+    Bucket(index, true);
+}
 
-        // Goal: cell matches AND we arrived facing the right way.
-        if (cur.x == gx && cur.y == gy && cur.dirFromParent == goalDir) {
-            goalIdx = top.idx;
-            break;
+bool DiagramObstacleIndex::CoversCell(int obstacle, int cx, int cy) const {
+    if (obstacle < 0 || static_cast<size_t>(obstacle) >= obstacles.size()) return false;
+    const Rect2Dd& area = options.routingArea;
+    double wx = area.x + (cx + 0.5) * gridSize;
+    double wy = area.y + (cy + 0.5) * gridSize;
+    return CellCentreInside(obstacles[obstacle].bounds, wx, wy, pad);
+}
+
+// Adds `delta` to every cell whose centre the padded obstacle covers. The
+// candidate range is widened by a cell each way and every candidate re-tested
+// with the exact predicate, so rounding can never make the raster disagree
+// with RouteAStar's per-cell test.
+void DiagramObstacleIndex::Rasterize(size_t index, int delta) {
+    const Rect2Dd& o = obstacles[index].bounds;
+    const Rect2Dd& area = options.routingArea;
+    int x0 = static_cast<int>(std::floor((o.x - pad - area.x) / gridSize - 0.5)) - 1;
+    int x1 = static_cast<int>(std::ceil((o.x + o.width + pad - area.x) / gridSize - 0.5)) + 1;
+    int y0 = static_cast<int>(std::floor((o.y - pad - area.y) / gridSize - 0.5)) - 1;
+    int y1 = static_cast<int>(std::ceil((o.y + o.height + pad - area.y) / gridSize - 0.5)) + 1;
+    x0 = std::max(x0, 0);
+    y0 = std::max(y0, 0);
+    x1 = std::min(x1, gridW - 1);
+    y1 = std::min(y1, gridH - 1);
+
+    for (int cy = y0; cy <= y1; ++cy) {
+        double wy = area.y + (cy + 0.5) * gridSize;
+        for (int cx = x0; cx <= x1; ++cx) {
+            double wx = area.x + (cx + 0.5) * gridSize;
+            if (!CellCentreInside(o, wx, wy, pad)) continue;
+            uint32_t& c = coverage[static_cast<size_t>(cy) * gridW + cx];
+            c = static_cast<uint32_t>(static_cast<int64_t>(c) + delta);
         }
+    }
+}
 
-        // Stale entry (a better g was already found): skip.
-        uint64_t curKey = PackCellDir(cur.x, cur.y, cur.dirFromParent);
-        auto itG = bestG.find(curKey);
-        if (itG != bestG.end() && cur.g > itG->second + 0.001) continue;
+void DiagramObstacleIndex::Bucket(size_t index, bool add) {
+    const Rect2Dd& o = obstacles[index].bounds;
+    int64_t bx0 = BucketCoord(o.x, bucketSize), bx1 = BucketCoord(o.x + o.width,  bucketSize);
+    int64_t by0 = BucketCoord(o.y, bucketSize), by1 = BucketCoord(o.y + o.height, bucketSize);
+    for (int64_t by = by0; by <= by1; ++by) {
+        for (int64_t bx = bx0; bx <= bx1; ++bx) {
+            uint64_t key = PackBucket(bx, by);
+            if (add) {
+                buckets[key].push_back(static_cast<uint32_t>(index));
+                continue;
+            }
+            auto it = buckets.find(key);
+            if (it == buckets.end()) continue;
+            auto& ids = it->second;
+            ids.erase(std::remove(ids.begin(), ids.end(), static_cast<uint32_t>(index)), ids.end());
+            if (ids.empty()) buckets.erase(it);
+        }
+    }
+}
 
-        for (int d = 0; d < 4; ++d) {
-            int nx = cur.x + DX[d];
-            int ny = cur.y + DY[d];
-            if (cellBlocked(nx, ny)) continue;
+bool DiagramObstacleIndex::IsCellBlocked(int cx, int cy, int excludeA, int excludeB) const {
+    if (cx < 0 || cy < 0 || cx >= gridW || cy >= gridH) return true;
+    int64_t count = coverage[static_cast<size_t>(cy) * gridW + cx];
+    if (count == 0) return false;
+    if (CoversCell(excludeA, cx, cy)) --count;
+    if (excludeB != excludeA && CoversCell(excludeB, cx, cy)) --count;
+    return count > 0;
+}
 
-            double stepCost = 1.0;
-            if (cur.dirFromParent != -1 && d != cur.dirFromParent) {
-                stepCost += turnPenalty;
-            }
-            double ng = cur.g + stepCost;
-            uint64_t nkey = PackCellDir(nx, ny, d);
-            auto itB = bestG.find(nkey);
-            if (itB != bestG.end() && ng >= itB->second - 0.001) continue;
-            bestG[nkey] = ng;
+bool DiagramObstacleIndex::PathHasObstacles(const std::vector<Point2Dd>& path,
+                                            int excludeA, int excludeB) const {
+    if (path.size() < 2) return false;
+    const double inset = options.obstacleInset;
+
+    auto testBucket = [&](int64_t bx, int64_t by, const Point2Dd& a, const Point2Dd& c) {
+        auto it = buckets.find(PackBucket(bx, by));
+        if (it == buckets.end()) return false;
+        for (uint32_t id : it->second) {
+            if (static_cast<int>(id) == excludeA || static_cast<int>(id) == excludeB) continue;
+            if (SegmentHitsObstacle(a, c, obstacles[id].bounds, inset)) return true;
+        }
+        return false;
+    };
 
-            int parentIdx = top.idx;
-            AStarNode nn{nx, ny, d, ng, ng + manhattan(nx, ny), parentIdx};
-            visited.push_back(nn);
-            open.push({nn.f, static_cast<int>(visited.size()) - 1});
+    for (size_t i = 1; i < path.size(); ++i) {
+        const Point2Dd& a = path[i - 1];
+        const Point2Dd& c = path[i];
+        // Walk the buckets along the segment; any obstacle it crosses is
+        // registered in one of them.
+        if (std::abs(a.y - c.y) < 0.5) {
+            int64_t by = BucketCoord(a.y, bucketSize);
+            int64_t bx0 = BucketCoord(std::min(a.x, c.x), bucketSize);
+            int64_t bx1 = BucketCoord(std::max(a.x, c.x), bucketSize);
+            for (int64_t bx = bx0; bx <= bx1; ++bx) {
+                if (testBucket(bx, by, a, c)) return true;
+            }
+        } else if (std::abs(a.x - c.x) < 0.5) {
+            int64_t bx = BucketCoord(a.x, bucketSize);
+            int64_t by0 = BucketCoord(std::min(a.y, c.y), bucketSize);
+            int64_t by1 = BucketCoord(std::max(a.y, c.y), bucketSize);
+            for (int64_t by = by0; by <= by1; ++by) {
+                if (testBucket(bx, by, a, c)) return true;
+            }
         }
     }
+    return false;
+}
 
-    if (goalIdx < 0) return {};
+// =============================================================================
+// INDEXED / BATCH ROUTING
+// =============================================================================
 
-    // Reconstruct the cell path (goal -> start, then reverse).
-    std::vector<std::pair<int, int>> cellPath;
-    int idx = goalIdx;
-    while (idx != -1) {
-        const AStarNode& n = visited[idx];
-        cellPath.emplace_back(n.x, n.y);
-        idx = n.parentIdx;
-    }
-    std::reverse(cellPath.begin(), cellPath.end());
+namespace {
 
-    // Convert to world waypoints (cell centres), keeping only corners so long
-    // straight runs collapse to a single segment.
-    std::vector<Point2Dd> raw;
-    raw.reserve(cellPath.size());
-    for (auto& c : cellPath) {
-        raw.push_back(Point2Dd(area.x + (c.first  + 0.5) * gridSize,
-                               area.y + (c.second + 0.5) * gridSize));
+std::vector<Point2Dd> RouteIndexed(const DiagramRouteRequest& request,
+                                   const DiagramObstacleIndex& index,
+                                   AStarScratch& scratch) {
+    auto cheap = UltraCanvasDiagramRouter::ComputeCardinalPath(
+        request.start, request.end, request.sourceSide, request.targetSide);
+    if (!index.PathHasObstacles(cheap, request.sourceObstacle, request.targetObstacle)) {
+        return cheap;
+    }
+    auto cellBlocked = [&](int cx, int cy) {
+        return index.IsCellBlocked(cx, cy, request.sourceObstacle, request.targetObstacle);
+    };
+    auto astar = SearchGrid(request.start, request.end, request.sourceSide, request.targetSide,
+                            index.Options(), cellBlocked, scratch);
+    if (astar.empty()) {
+        return cheap;  // same fallback as ComputeOrthogonalPath
     }
+    return astar;
+}
 
-    std::vector<Point2Dd> simplified;
-    simplified.push_back(raw.front());
-    for (size_t i = 1; i + 1 < raw.size(); ++i) {
-        double dx1 = raw[i].x - raw[i - 1].x, dy1 = raw[i].y - raw[i - 1].y;
-        double dx2 = raw[i + 1].x - raw[i].x, dy2 = raw[i + 1].y - raw[i].y;
-        // Collinear iff both steps run on the same axis with the same sign.
-        bool h1 = std::abs(dx1) > 0.5, h2 = std::abs(dx2) > 0.5;
-        bool sameSign = (h1 ? (dx1 * dx2 > 0.0) : (dy1 * dy2 > 0.0));
-        if (h1 == h2 && sameSign) continue;
-        simplified.push_back(raw[i]);
+// Routes requests[jobs[k]] into results[jobs[k]] for every k, spreading the
+// jobs over `threads` workers that pull the next job from a shared counter.
+void RouteJobs(const std::vector<DiagramRouteRequest>& requests,
+               const std::vector<size_t>& jobs,
+               const DiagramObstacleIndex& index, int threads,
+               std::vector<std::vector<Point2Dd>>& results) {
+    if (jobs.empty()) return;
+    size_t workerCount = threads > 0 ? static_cast<size_t>(threads)
+                                     : std::max(1u, std::thread::hardware_concurrency());
+    workerCount = std::min(workerCount, jobs.size());
+
+    // 12 bytes per (cell, direction); larger grids keep the hash map.
+    constexpr size_t kDenseTableLimit = size_t(4) << 20;
+    const size_t cells = static_cast<size_t>(index.GridWidth()) * index.GridHeight();
+
+    std::atomic<size_t> next{0};
+    auto work = [&]() {
+        AStarScratch scratch;
+        if (cells * 4 <= kDenseTableLimit) {
+            scratch.UseDenseTable(index.GridWidth(), index.GridHeight());
+        }
+        for (size_t k = next.fetch_add(1); k < jobs.size(); k = next.fetch_add(1)) {
+            size_t i = jobs[k];
+            results[i] = RouteIndexed(requests[i], index, scratch);
+        }
+    };
+
+    if (workerCount <= 1) {
+        work();
+        return;
     }
-    if (raw.size() > 1) simplified.push_back(raw.back());
+    std::vector<std::thread> workers;
+    workers.reserve(workerCount - 1);
+    for (size_t t = 1; t < workerCount; ++t) workers.emplace_back(work);
+    work();
+    for (auto& w : workers) w.join();
+}
 
-    // Stitch the exact endpoints onto the simplified cell path, then insert
-    // whatever corners are needed to keep every segment axis-aligned. The
-    // orthogonalizer forces the first segment onto the source side's axis and
-    // the last onto the target side's, so the path still meets both boxes
-    // head-on.
-    std::vector<Point2Dd> stitched;
-    stitched.reserve(simplified.size() + 2);
-    stitched.push_back(start);
-    for (const auto& p : simplified) stitched.push_back(p);
-    stitched.push_back(end);
+} // namespace
 
-    return NormalizePath(Orthogonalize(stitched, sourceSide, targetSide));
+std::vector<Point2Dd> UltraCanvasDiagramRouter::ComputeOrthogonalPath(
+        const DiagramRouteRequest& request, const DiagramObstacleIndex& index) {
+    AStarScratch scratch;
+    return RouteIndexed(request, index, scratch);
+}
+
+std::vector<Point2Dd> UltraCanvasDiagramRouter::RouteAStar(
+        const DiagramRouteRequest& request, const DiagramObstacleIndex& index) {
+    auto cellBlocked = [&](int cx, int cy) {
+        return index.IsCellBlocked(cx, cy, request.sourceObstacle, request.targetObstacle);
+    };
+    AStarScratch scratch;
+    return SearchGrid(request.start, request.end, request.sourceSide, request.targetSide,
+                      index.Options(), cellBlocked, scratch);
+}
+
+std::vector<std::vector<Point2Dd>> UltraCanvasDiagramRouter::RouteBatch(
+        const std::vector<DiagramRouteRequest>& requests,
+        const DiagramObstacleIndex& index, int threads) {
+    std::vector<std::vector<Point2Dd>> results(requests.size());
+    std::vector<size_t> jobs(requests.size());
+    for (size_t i = 0; i < jobs.size(); ++i) jobs[i] = i;
+    RouteJobs(requests, jobs, index, threads, results);
+    return results;
 }
 
 // =============================================================================
-// TOP-LEVEL ENTRY POINT
+// INCREMENTAL BATCH ROUTER
 // =============================================================================
 
-std::vector<Point2Dd> UltraCanvasDiagramRouter::ComputeOrthogonalPath(
-        const Point2Dd& start, const Point2Dd& end,
-        DiagramCardinalSide sourceSide, DiagramCardinalSide targetSide,
-        const std::vector<DiagramObstacle>& obstacles,
-        const DiagramRoutingOptions& options) {
-    auto cheap = ComputeCardinalPath(start, end, sourceSide, targetSide);
-    if (!PathHasObstacles(cheap, obstacles, options.obstacleInset)) {
-        return cheap;
+DiagramBatchRouter::DiagramBatchRouter(const DiagramRoutingOptions& newOptions)
+    : options(newOptions) {
+    index.Build(obstacles, options);
+}
+
+void DiagramBatchRouter::SetOptions(const DiagramRoutingOptions& newOptions) {
+    options = newOptions;
+    index.Build(obstacles, options);
+    allPending = true;
+}
+
+void DiagramBatchRouter::SetObstacles(const std::vector<DiagramObstacle>& newObstacles) {
+    obstacles = newObstacles;
+    index.Build(obstacles, options);
+    movedRegions.clear();
+    movedObstacles.assign(obstacles.size(), 0);
+    allPending = true;
+}
+
+void DiagramBatchRouter::MoveObstacle(size_t obstacle, const Rect2Dd& bounds) {
+    if (obstacle >= obstacles.size()) return;
+    // Grow both rectangles by the A* padding: a cell next to the obstacle
+    // changes state too.
+    const double gridSize = options.gridSize > 0.0 ? options.gridSize : 20.0;
+    const double pad = gridSize * options.obstaclePaddingCells;
+    auto padded = [pad](const Rect2Dd& r) {
+        return Rect2Dd(r.x - pad, r.y - pad, r.width + pad * 2.0, r.height + pad * 2.0);
+    };
+    movedRegions.push_back(padded(obstacles[obstacle].bounds));
+    movedRegions.push_back(padded(bounds));
+    if (movedObstacles.size() < obstacles.size()) movedObstacles.resize(obstacles.size(), 0);
+    movedObstacles[obstacle] = 1;
+
+    obstacles[obstacle].bounds = bounds;
+    index.UpdateObstacle(obstacle, bounds);
+}
+
+void DiagramBatchRouter::SetConnections(const std::vector<DiagramRouteRequest>& newRequests) {
+    requests = newRequests;
+    paths.assign(requests.size(), {});
+    corridors.assign(requests.size(), Rect2Dd(0, 0, 0, 0));
+    pending.assign(requests.size(), 1);
+}
+
+void DiagramBatchRouter::SetConnection(size_t connection, const DiagramRouteRequest& request) {
+    if (connection >= requests.size()) {
+        requests.resize(connection + 1);
+        paths.resize(connection + 1);
+        corridors.resize(connection + 1, Rect2Dd(0, 0, 0, 0));
+        pending.resize(connection + 1, 1);
     }
-    auto astar = RouteAStar(start, end, sourceSide, targetSide, obstacles, options);
-    if (astar.empty()) {
-        return cheap;  // silent fallback: a visible connection beats none
+    requests[connection] = request;
+    pending[connection] = 1;
+}
+
+Rect2Dd DiagramBatchRouter::CorridorOf(const std::vector<Point2Dd>& path) const {
+    if (path.empty()) return Rect2Dd(0, 0, 0, 0);
+    double minX = path.front().x, maxX = minX;
+    double minY = path.front().y, maxY = minY;
+    for (const auto& p : path) {
+        minX = std::min(minX, p.x);
+        maxX = std::max(maxX, p.x);
+        minY = std::min(minY, p.y);
+        maxY = std::max(maxY, p.y);
     }
-    return astar;
+    const double slack = options.gridSize > 0.0 ? options.gridSize : 20.0;
+    return Rect2Dd(minX - slack, minY - slack,
+                   maxX - minX + slack * 2.0, maxY - minY + slack * 2.0);
+}
+
+size_t DiagramBatchRouter::Route(int threads) {
+    std::vector<size_t> jobs;
+    jobs.reserve(requests.size());
+
+    auto attachesToMoved = [&](int obstacle) {
+        return obstacle >= 0 && static_cast<size_t>(obstacle) < movedObstacles.size() &&
+               movedObstacles[obstacle];
+    };
+
+    for (size_t i = 0; i < requests.size(); ++i) {
+        bool reroute = allPending || pending[i] ||
+                       attachesToMoved(requests[i].sourceObstacle) ||
+                       attachesToMoved(requests[i].targetObstacle);
+        for (size_t r = 0; !reroute && r < movedRegions.size(); ++r) {
+            reroute = corridors[i].Intersects(movedRegions[r]);
+        }
+        if (reroute) jobs.push_back(i);
+    }
+
+    RouteJobs(requests, jobs, index, threads, paths);
+    for (size_t i : jobs) {
+        corridors[i] = CorridorOf(paths[i]);
+        pending[i] = 0;
+    }
+
+    movedRegions.clear();
+    std::fill(movedObstacles.begin(), movedObstacles.end(), 0);
+    allPending = false;
+    return jobs.size();
 }
 
 } // namespace UltraCanvas
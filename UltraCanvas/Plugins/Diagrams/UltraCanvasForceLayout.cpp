@@ -0,0 +1,471 @@
+// Plugins/Diagrams/UltraCanvasForceLayout.cpp
+// Headless force-directed layout solver - Barnes-Hut repulsion over SoA arrays
+// Version: 1.0.0
+// Last Modified: 2026-10-18
+// Author: UltraCanvas Framework
+
+#include "Plugins/Diagrams/UltraCanvasForceLayout.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <unordered_map>
+
+namespace UltraCanvas {
+
+namespace {
+
+// Bodies per quadtree leaf. Leaves are summed exactly, so a few bodies per
+// leaf is cheaper than descending to one-body cells.
+constexpr uint32_t kLeafSize = 8;
+// Coincident nodes cannot be separated by splitting; stop at this depth.
+constexpr int kMaxDepth = 24;
+// Below this many nodes the quadtree costs more than it saves.
+constexpr size_t kExactRepulsionLimit = 64;
+// Graphs smaller than this start on a ring (the 2.0.4 placement); larger ones
+// on a sunflower spiral.
+constexpr size_t kRingPlacementLimit = 1000;
+
+} // namespace
+
+ForceLayoutSolver::ForceLayoutSolver(ForceLayoutGraph graph, const ForceLayoutOptions& options)
+    : graph_(std::move(graph)), options_(options) {
+    const size_t n = graph_.Size();
+    graph_.w.resize(n, 0.0);
+    graph_.h.resize(n, 0.0);
+    graph_.pinned.resize(n, 0);
+    fx_.assign(n, 0.0);
+    fy_.assign(n, 0.0);
+    iterationBudget_ = std::max(options_.iterations, 0);
+    if (n == 0) converged_ = true;
+    if (options_.initialPlacement) PlaceInitial();
+}
+
+void ForceLayoutSolver::PlaceInitial() {
+    const size_t n = graph_.Size();
+    if (n == 0) return;
+    const double centerX = options_.width  * 0.5;
+    const double centerY = options_.height * 0.5;
+    const double extent  = std::min(options_.width, options_.height) * 0.30;
+
+    if (n < kRingPlacementLimit) {
+        double radius = std::max(extent, 50.0);
+        const double TWO_PI = 6.28318530717958647692;
+        for (size_t i = 0; i < n; ++i) {
+            if (graph_.pinned[i]) continue;
+            double angle = (static_cast<double>(i) / static_cast<double>(n)) * TWO_PI;
+            graph_.x[i] = centerX + radius * std::cos(angle);
+            graph_.y[i] = centerY + radius * std::sin(angle);
+        }
+        return;
+    }
+
+    // Vogel's spiral: evenly spread points filling a disc of radius `extent`.
+    const double GOLDEN_ANGLE = 2.39996322972865332;
+    const double spacing = extent / std::sqrt(static_cast<double>(n));
+    for (size_t i = 0; i < n; ++i) {
+        if (graph_.pinned[i]) continue;
+        double r = spacing * std::sqrt(static_cast<double>(i) + 0.5);
+        double angle = static_cast<double>(i) * GOLDEN_ANGLE;
+        graph_.x[i] = centerX + r * std::cos(angle);
+        graph_.y[i] = centerY + r * std::sin(angle);
+    }
+}
+
+// =============================================================================
+// QUADTREE
+// =============================================================================
+
+void ForceLayoutSolver::BuildTree() {
+    const size_t n = graph_.Size();
+    cells_.clear();
+    order_.resize(n);
+    for (size_t i = 0; i < n; ++i) order_[i] = static_cast<uint32_t>(i);
+
+    double minX = std::numeric_limits<double>::max(), minY = minX;
+    double maxX = std::numeric_limits<double>::lowest(), maxY = maxX;
+    for (size_t i = 0; i < n; ++i) {
+        minX = std::min(minX, graph_.x[i]);
+        maxX = std::max(maxX, graph_.x[i]);
+        minY = std::min(minY, graph_.y[i]);
+        maxY = std::max(maxY, graph_.y[i]);
+    }
+    double half = std::max(maxX - minX, maxY - minY) * 0.5 + 1.0;
+    BuildCell(0, static_cast<uint32_t>(n), (minX + maxX) * 0.5, (minY + maxY) * 0.5, half, 0);
+}
+
+int32_t ForceLayoutSolver::BuildCell(uint32_t begin, uint32_t end, double cx, double cy,
+                                     double half, int depth) {
+    const int32_t index = static_cast<int32_t>(cells_.size());
+    cells_.emplace_back();
+    {
+        Cell& cell = cells_.back();
+        cell.cx = cx;
+        cell.cy = cy;
+        cell.half = half;
+        cell.begin = begin;
+        cell.end = end;
+    }
+
+    if (end - begin <= kLeafSize || depth >= kMaxDepth) {
+        double sx = 0.0, sy = 0.0;
+        for (uint32_t k = begin; k < end; ++k) {
+            sx += graph_.x[order_[k]];
+            sy += graph_.y[order_[k]];
+        }
+        Cell& cell = cells_[index];
+        cell.mass = static_cast<double>(end - begin);
+        cell.mx = sx / cell.mass;
+        cell.my = sy / cell.mass;
+        return index;
+    }
+
+    // Split the body range into quadrants: [top-left, top-right, bottom-left,
+    // bottom-right], each contiguous in order_.
+    auto first = order_.begin() + begin;
+    auto last  = order_.begin() + end;
+    auto midY = std::partition(first, last, [&](uint32_t i) { return graph_.y[i] < cy; });
+    auto midTop = std::partition(first, midY, [&](uint32_t i) { return graph_.x[i] < cx; });
+    auto midBottom = std::partition(midY, last, [&](uint32_t i) { return graph_.x[i] < cx; });
+
+    const uint32_t bounds[5] = {
+        begin,
+        static_cast<uint32_t>(midTop - order_.begin()),
+        static_cast<uint32_t>(midY - order_.begin()),
+        static_cast<uint32_t>(midBottom - order_.begin()),
+        end
+    };
+    const double q = half * 0.5;
+    const double offsets[4][2] = {{-q, -q}, {q, -q}, {-q, q}, {q, q}};
+
+    double mass = 0.0, sx = 0.0, sy = 0.0;
+    int32_t children[4] = {-1, -1, -1, -1};
+    for (int c = 0; c < 4; ++c) {
+        if (bounds[c] == bounds[c + 1]) continue;
+        int32_t child = BuildCell(bounds[c], bounds[c + 1],
+                                  cx + offsets[c][0], cy + offsets[c][1], q, depth + 1);
+        children[c] = child;
+        const Cell& cc = cells_[child];
+        mass += cc.mass;
+        sx += cc.mx * cc.mass;
+        sy += cc.my * cc.mass;
+    }
+
+    Cell& cell = cells_[index];     // cells_ may have grown - re-fetch
+    cell.leaf = false;
+    std::copy(children, children + 4, cell.child);
+    cell.mass = mass;
+    cell.mx = sx / mass;
+    cell.my = sy / mass;
+    return index;
+}
+
+void ForceLayoutSolver::AccumulateExactRepulsion() {
+    const size_t n = graph_.Size();
+    const double charge = options_.chargeStrength;
+    for (size_t i = 0; i < n; ++i) {
+        if (graph_.pinned[i]) continue;
+        const double xi = graph_.x[i], yi = graph_.y[i];
+        double ax = 0.0, ay = 0.0;
+        for (size_t j = 0; j < n; ++j) {
+            if (i == j) continue;
+            double dx = graph_.x[j] - xi;
+            double dy = graph_.y[j] - yi;
+            double distSq = dx * dx + dy * dy;
+            if (distSq < 1.0) distSq = 1.0;
+            double force = charge / distSq;
+            double invDist = 1.0 / std::sqrt(distSq);
+            ax += dx * invDist * force;
+            ay += dy * invDist * force;
+        }
+        fx_[i] += ax;
+        fy_[i] += ay;
+    }
+}
+
+void ForceLayoutSolver::AccumulateRepulsion() {
+    const size_t n = graph_.Size();
+    if (options_.theta <= 0.0 || n < kExactRepulsionLimit) {
+        AccumulateExactRepulsion();
+        return;
+    }
+
+    BuildTree();
+    const double charge = options_.chargeStrength;
+    const double thetaSq = options_.theta * options_.theta;
+
+    for (size_t i = 0; i < n; ++i) {
+        if (graph_.pinned[i]) continue;
+        const double xi = graph_.x[i], yi = graph_.y[i];
+        double ax = 0.0, ay = 0.0;
+
+        stack_.clear();
+        stack_.push_back(0);
+        while (!stack_.empty()) {
+            const Cell& cell = cells_[stack_.back()];
+            stack_.pop_back();
+
+            if (cell.leaf) {
+                for (uint32_t k = cell.begin; k < cell.end; ++k) {
+                    uint32_t j = order_[k];
+                    if (j == i) continue;
+                    double dx = graph_.x[j] - xi;
+                    double dy = graph_.y[j] - yi;
+                    double distSq = dx * dx + dy * dy;
+                    if (distSq < 1.0) distSq = 1.0;
+                    double force = charge / distSq;
+                    double invDist = 1.0 / std::sqrt(distSq);
+                    ax += dx * invDist * force;
+                    ay += dy * invDist * force;
+                }
+                continue;
+            }
+
+            double dx = cell.mx - xi;
+            double dy = cell.my - yi;
+            double distSq = dx * dx + dy * dy;
+            double size = cell.half * 2.0;
+            if (size * size < thetaSq * distSq) {
+                // Far enough: the whole cell acts as one body at its centre
+                // of mass.
+                double force = charge * cell.mass / distSq;
+                double invDist = 1.0 / std::sqrt(distSq);
+                ax += dx * invDist * force;
+                ay += dy * invDist * force;
+                continue;
+            }
+            for (int c = 0; c < 4; ++c) {
+                if (cell.child[c] >= 0) stack_.push_back(cell.child[c]);
+            }
+        }
+        fx_[i] += ax;
+        fy_[i] += ay;
+    }
+}
+
+// =============================================================================
+// SIMULATION
+// =============================================================================
+
+bool ForceLayoutSolver::Step() {
+    if (Finished()) return false;
+
+    const size_t n = graph_.Size();
+    auto& X = graph_.x;
+    auto& Y = graph_.y;
+    const auto& W = graph_.w;
+    const auto& H = graph_.h;
+    const auto& P = graph_.pinned;
+
+    // Cool from 1.0 down to 0.05 over the budget.
+    double t = static_cast<double>(iteration_) / static_cast<double>(iterationBudget_);
+    double temperature = 1.0 - 0.95 * t;
+
+    std::fill(fx_.begin(), fx_.end(), 0.0);
+    std::fill(fy_.begin(), fy_.end(), 0.0);
+
+    // Spring force from links
+    const size_t linkCount = std::min(graph_.linkSource.size(), graph_.linkTarget.size());
+    for (size_t l = 0; l < linkCount; ++l) {
+        uint32_t s = graph_.linkSource[l];
+        uint32_t d = graph_.linkTarget[l];
+        if (s >= n || d >= n) continue;
+
+        double dx = X[d] - X[s];
+        double dy = Y[d] - Y[s];
+        double dist = std::sqrt(dx * dx + dy * dy);
+        if (dist < 0.1) dist = 0.1;
+
+        double force = (dist - options_.linkDistance) * options_.linkStrength;
+        double fx = (dx / dist) * force;
+        double fy = (dy / dist) * force;
+        if (!P[s]) { fx_[s] += fx; fy_[s] += fy; }
+        if (!P[d]) { fx_[d] -= fx; fy_[d] -= fy; }
+    }
+
+    AccumulateRepulsion();
+
+    // Centre pull keeps disconnected components from drifting off-screen.
+    const double centerX = options_.width  * 0.5;
+    const double centerY = options_.height * 0.5;
+    for (size_t i = 0; i < n; ++i) {
+        if (P[i]) continue;
+        fx_[i] += (centerX - (X[i] + W[i] * 0.5)) * options_.centerPull;
+        fy_[i] += (centerY - (Y[i] + H[i] * 0.5)) * options_.centerPull;
+    }
+
+    // Group cohesion: pull members toward their group's centroid.
+    if (options_.groupCohesion > 0.0) {
+        for (const auto& group : graph_.groups) {
+            if (group.size() < 2) continue;
+            double sumX = 0.0, sumY = 0.0;
+            int count = 0;
+            for (uint32_t i : group) {
+                if (i >= n) continue;
+                sumX += X[i] + W[i] * 0.5;
+                sumY += Y[i] + H[i] * 0.5;
+                ++count;
+            }
+            if (count < 2) continue;
+            double gcx = sumX / count;
+            double gcy = sumY / count;
+            for (uint32_t i : group) {
+                if (i >= n || P[i]) continue;
+                fx_[i] += (gcx - (X[i] + W[i] * 0.5)) * options_.groupCohesion;
+                fy_[i] += (gcy - (Y[i] + H[i] * 0.5)) * options_.groupCohesion;
+            }
+        }
+    }
+
+    // Apply with the per-step cap (absolute, so early steps keep their swing)
+    // and measure how far the nodes actually moved.
+    const double maxStep = 30.0 * temperature + 2.0;
+    const double margin = options_.boundsMargin;
+    const double loX = margin, hiX = std::max(margin, options_.width  - margin);
+    const double loY = margin, hiY = std::max(margin, options_.height - margin);
+    double moved = 0.0;
+    size_t movable = 0;
+    for (size_t i = 0; i < n; ++i) {
+        if (P[i]) continue;
+        double vx = std::clamp(fx_[i], -maxStep, maxStep);
+        double vy = std::clamp(fy_[i], -maxStep, maxStep);
+        double nx = std::clamp(X[i] + vx, loX, hiX);
+        double ny = std::clamp(Y[i] + vy, loY, hiY);
+        moved += std::abs(nx - X[i]) + std::abs(ny - Y[i]);
+        X[i] = nx;
+        Y[i] = ny;
+        ++movable;
+    }
+
+    ++iteration_;
+    lastMeanStep_ = movable ? moved / static_cast<double>(movable) : 0.0;
+
+    if (movable == 0) {
+        converged_ = true;
+    } else if (options_.convergenceThreshold > 0.0) {
+        quietSteps_ = lastMeanStep_ < options_.convergenceThreshold ? quietSteps_ + 1 : 0;
+        if (quietSteps_ >= std::max(options_.convergenceWindow, 1)) converged_ = true;
+    }
+    return !Finished();
+}
+
+bool ForceLayoutSolver::Run(const std::atomic<bool>* cancel,
+                            const std::function<bool(const ForceLayoutSolver&)>& onProgress,
+                            int progressInterval) {
+    const int interval = std::max(progressInterval, 1);
+    while (!Finished()) {
+        if (cancel && cancel->load(std::memory_order_relaxed)) return false;
+        Step();
+        if (onProgress && iteration_ % interval == 0 && !onProgress(*this)) return false;
+    }
+    if (cancel && cancel->load(std::memory_order_relaxed)) return false;
+    ResolveOverlaps();
+    return true;
+}
+
+// =============================================================================
+// OVERLAP RESOLUTION
+// =============================================================================
+
+// Pushes overlapping pairs apart by their bounding-box radii plus a margin,
+// a few passes since separating A-B can create B-C. Candidate pairs come from
+// a uniform grid with cells as wide as the largest node, so each node only
+// meets its neighbours; within a node the pairs are visited in index order,
+// which keeps small graphs identical to an all-pairs sweep.
+void ForceLayoutSolver::ResolveOverlaps() {
+    const size_t n = graph_.Size();
+    if (n < 2 || options_.overlapPasses <= 0) return;
+
+    auto& X = graph_.x;
+    auto& Y = graph_.y;
+    const auto& W = graph_.w;
+    const auto& H = graph_.h;
+    const auto& P = graph_.pinned;
+    const double kMargin = options_.overlapMargin;
+    const double margin = options_.boundsMargin;
+    const double hiX = std::max(margin, options_.width  - margin);
+    const double hiY = std::max(margin, options_.height - margin);
+
+    double maxRadius = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        maxRadius = std::max(maxRadius, std::max(W[i], H[i]) * 0.5);
+    }
+    const double cellSize = std::max(2.0 * maxRadius + kMargin, 1.0);
+
+    auto cellKey = [](int64_t cx, int64_t cy) -> uint64_t {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(cx)) << 32) |
+                static_cast<uint32_t>(cy);
+    };
+
+    std::unordered_map<uint64_t, std::vector<uint32_t>> grid;
+    std::vector<uint32_t> candidates;
+
+    for (int pass = 0; pass < options_.overlapPasses; ++pass) {
+        grid.clear();
+        grid.reserve(n);
+        for (size_t i = 0; i < n; ++i) {
+            int64_t cx = static_cast<int64_t>(std::floor((X[i] + W[i] * 0.5) / cellSize));
+            int64_t cy = static_cast<int64_t>(std::floor((Y[i] + H[i] * 0.5) / cellSize));
+            grid[cellKey(cx, cy)].push_back(static_cast<uint32_t>(i));
+        }
+
+        bool anyOverlap = false;
+        for (size_t i = 0; i < n; ++i) {
+            // The grid holds positions from the start of the pass; a pair
+            // that a push carried out of reach is caught on the next pass.
+            int64_t cx = static_cast<int64_t>(std::floor((X[i] + W[i] * 0.5) / cellSize));
+            int64_t cy = static_cast<int64_t>(std::floor((Y[i] + H[i] * 0.5) / cellSize));
+            candidates.clear();
+            for (int64_t gy = cy - 1; gy <= cy + 1; ++gy) {
+                for (int64_t gx = cx - 1; gx <= cx + 1; ++gx) {
+                    auto it = grid.find(cellKey(gx, gy));
+                    if (it == grid.end()) continue;
+                    for (uint32_t j : it->second) {
+                        if (j > i) candidates.push_back(j);
+                    }
+                }
+            }
+            std::sort(candidates.begin(), candidates.end());
+
+            for (uint32_t j : candidates) {
+                double ar = std::max(W[i], H[i]) * 0.5;
+                double br = std::max(W[j], H[j]) * 0.5;
+                double minDist = ar + br + kMargin;
+
+                double dx = (X[j] + W[j] * 0.5) - (X[i] + W[i] * 0.5);
+                double dy = (Y[j] + H[j] * 0.5) - (Y[i] + H[i] * 0.5);
+                double dist = std::sqrt(dx * dx + dy * dy);
+                if (dist >= minDist) continue;
+
+                anyOverlap = true;
+                double pushX, pushY;
+                if (dist < 0.001) {
+                    pushX = 1.0;
+                    pushY = 0.0;
+                } else {
+                    pushX = dx / dist;
+                    pushY = dy / dist;
+                }
+                double push = (minDist - dist) * 0.5;
+                bool aPinned = P[i] != 0;
+                bool bPinned = P[j] != 0;
+                if (aPinned && bPinned) continue;
+                double aWeight = aPinned ? 0.0 : (bPinned ? 2.0 : 1.0);
+                double bWeight = bPinned ? 0.0 : (aPinned ? 2.0 : 1.0);
+                X[i] -= pushX * push * aWeight;
+                Y[i] -= pushY * push * aWeight;
+                X[j] += pushX * push * bWeight;
+                Y[j] += pushY * push * bWeight;
+            }
+        }
+
+        for (size_t i = 0; i < n; ++i) {
+            if (P[i]) continue;
+            X[i] = std::clamp(X[i], margin, hiX);
+            Y[i] = std::clamp(Y[i], margin, hiY);
+        }
+        if (!anyOverlap) break;
+    }
+}
+
+} // namespace UltraCanvas
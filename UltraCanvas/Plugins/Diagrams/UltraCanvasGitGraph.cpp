@@ -1,12 +1,13 @@
 // Plugins/Diagrams/UltraCanvasGitGraph.cpp
 // Git commit-graph element implementation.
 //
-// Version: 1.0.0
-// Last Modified: 2026-07-30
+// Version: 1.1.0
+// Last Modified: 2026-10-18
 // Author: UltraCanvas Framework
 
 #include "Plugins/Diagrams/UltraCanvasGitGraph.h"
 #include "Plugins/Diagrams/UltraCanvasGitGraphMermaid.h"
+#include "UltraCanvasApplication.h"     // PostToUIThread for background chunks
 
 #include <algorithm>
 #include <cmath>
@@ -72,6 +73,11 @@ UltraCanvasGitGraph::UltraCanvasGitGraph(const std::string& id,
     layoutEngine.SetOptions(layoutOptions);
 }
 
+UltraCanvasGitGraph::~UltraCanvasGitGraph() {
+    alive->store(false);
+    if (fetchThread.joinable()) fetchThread.join();
+}
+
 // =============================================================================
 // DATA
 // =============================================================================
@@ -84,6 +90,9 @@ void UltraCanvasGitGraph::AddCommit(const GitGraphCommit& commit) {
         commitIndex[commit.sha] = commits.size();
         commits.push_back(commit);
     }
+    // An authored commit is newer than the laid-out rows, a replaced one
+    // changes them; only AcceptChunk() knows commits extend the old end.
+    incrementalLayoutValid = false;
     needsLayout = true;
 }
 
@@ -163,12 +172,14 @@ void UltraCanvasGitGraph::Clear() {
     annotations.clear();
     commitIndex.clear();
     layout.Clear();
+    incrementalLayoutValid = false;
     selectedShas.clear();
     hoveredSha.clear();
     branchTips.clear();
     currentBranch = layoutOptions.trunkBranch.empty() ? "main" : layoutOptions.trunkBranch;
     syntheticShaCounter = 0;
     dataSourceExhausted = false;
+    CancelBackgroundFetch();
     needsLayout = true;
     RequestRedraw();
 }
@@ -355,6 +366,7 @@ bool UltraCanvasGitGraph::SaveToMermaid(const std::string& filePath) const {
 
 void UltraCanvasGitGraph::SetDataSource(std::shared_ptr<IGitGraphDataSource> source,
                                         size_t newChunkSize) {
+    CancelBackgroundFetch();
     dataSource = std::move(source);
     chunkSize = std::max<size_t>(1, newChunkSize);
     dataSourceExhausted = false;
@@ -376,15 +388,59 @@ void UltraCanvasGitGraph::SetPrefetchRows(int rows) {
 
 bool UltraCanvasGitGraph::LoadMoreCommits() {
     if (!dataSource || dataSourceExhausted) return false;
+    if (fetchRunning) return false;             // A chunk is already on its way
+
+    if (asyncLoading && UltraCanvasApplicationBase::GetCurrent()) {
+        StartBackgroundFetch();
+        return false;
+    }
+    if (fetchThread.joinable()) fetchThread.join();     // A cancelled fetch still running
+    return AcceptChunk(dataSource->FetchCommits(commits.size(), chunkSize), chunkSize);
+}
+
+void UltraCanvasGitGraph::StartBackgroundFetch() {
+    UltraCanvasApplicationBase* app = UltraCanvasApplicationBase::GetCurrent();
+
+    // The previous fetch has posted its chunk (or been cancelled) by now;
+    // joining keeps two threads from ever calling the source at once.
+    if (fetchThread.joinable()) fetchThread.join();
 
-    const size_t offset = commits.size();
-    const std::vector<GitGraphCommit> chunk = dataSource->FetchCommits(offset, chunkSize);
+    const uint64_t generation = ++fetchGeneration;
+    fetchRunning = true;
 
+    fetchThread = std::thread([this, app, source = dataSource, offset = commits.size(),
+                               count = chunkSize, aliveFlag = alive, generation]() {
+        auto chunk = std::make_shared<const std::vector<GitGraphCommit>>(
+            source->FetchCommits(offset, count));
+        if (!aliveFlag->load()) return;
+        app->PostToUIThread([this, aliveFlag, generation, chunk, count]() {
+            if (!aliveFlag->load() || generation != fetchGeneration) return;
+            fetchRunning = false;
+            AcceptChunk(*chunk, count);
+        });
+    });
+}
+
+void UltraCanvasGitGraph::CancelBackgroundFetch() {
+    // Not joined here: the worker only touches the source, and its chunk is
+    // dropped on arrival. The next StartBackgroundFetch() or the destructor
+    // waits for it.
+    ++fetchGeneration;
+    fetchRunning = false;
+}
+
+bool UltraCanvasGitGraph::AcceptChunk(const std::vector<GitGraphCommit>& chunk,
+                                      size_t requested) {
     // A short (or empty) chunk means the source has nothing left.
-    if (chunk.size() < chunkSize) dataSourceExhausted = true;
+    if (chunk.size() < requested) dataSourceExhausted = true;
     if (chunk.empty()) return false;
 
+    // A chunk continues the walk, so the incremental layout carries on -
+    // unless it replaced commits that were already laid out.
+    const bool extendLayout = incrementalLayoutValid;
+    const size_t previousCount = commits.size();
     AddCommits(chunk);
+    incrementalLayoutValid = extendLayout && commits.size() == previousCount + chunk.size();
     needsLayout = true;
 
     if (onChunkLoaded) onChunkLoaded(commits.size(), dataSource->GetTotalCommitCount());
@@ -562,7 +618,6 @@ void UltraCanvasGitGraph::SetRowsAreNewestFirst(bool newestFirst) {
 }
 
 void UltraCanvasGitGraph::PerformLayout() {
-    RebuildCommitIndex();
     if (filter.IsActive()) {
         // Commits may have arrived since the filter was set (lazy loading).
         layoutOptions.hiddenCommits.clear();
@@ -571,7 +626,23 @@ void UltraCanvasGitGraph::PerformLayout() {
         }
     }
     layoutEngine.SetOptions(layoutOptions);
-    layout = layoutEngine.Compute(commits, refs);
+
+    // A data source only ever appends older commits, so with append-only
+    // options each chunk just extends the lanes where the last one stopped.
+    if (dataSource && UltraCanvasGitGraphIncrementalLayout::Supports(layoutOptions)) {
+        if (!incrementalLayoutValid ||
+            !incrementalLayout.IsCompatible(layoutOptions, refs) ||
+            layout.commits.size() > commits.size()) {
+            incrementalLayout.Reset(layoutOptions, refs);
+            layout.Clear();
+        }
+        incrementalLayout.Append(commits, layout.commits.size(), layout);
+        incrementalLayoutValid = true;
+    } else {
+        RebuildCommitIndex();
+        layout = layoutEngine.Compute(commits, refs);
+        incrementalLayoutValid = false;
+    }
     UpdateContentExtent();
     needsLayout = false;
     if (onLayoutComplete) onLayoutComplete();
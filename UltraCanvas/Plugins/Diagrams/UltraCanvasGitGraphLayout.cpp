@@ -2,8 +2,8 @@
 // Commit ordering, lane assignment and edge routing for UltraCanvasGitGraph.
 // Pure geometry - no rendering dependencies.
 //
-// Version: 1.0.0
-// Last Modified: 2026-07-30
+// Version: 1.1.0
+// Last Modified: 2026-10-18
 // Author: UltraCanvas Framework
 
 #include "Plugins/Diagrams/UltraCanvasGitGraphLayout.h"
@@ -13,6 +13,7 @@
 #include <cstdlib>
 #include <deque>
 #include <functional>
+#include <limits>
 #include <set>
 #include <tuple>
 
@@ -20,11 +21,14 @@ namespace UltraCanvas {
 
 namespace {
 
+// Sentinel for a lane that is not waiting for any particular commit.
+constexpr int64_t kNoCommit = std::numeric_limits<int64_t>::min();
+
 // One slot in the active-lane table used by the sweep.
 struct LaneSlot {
-    bool        active    = false;
-    bool        reserved  = false;      // Lane 0 when a trunk branch is pinned
-    std::string expecting;              // Sha this lane is waiting to place
+    bool    active    = false;
+    bool    reserved  = false;          // Lane 0 when a trunk branch is pinned
+    int64_t expecting = kNoCommit;      // Commit this lane is waiting to place
 };
 
 // Leftmost free slot (Compact) or the first slot with nothing active to its
@@ -34,7 +38,8 @@ struct LaneSlot {
 // lane). When set, Compact takes the free slot closest to it instead of the
 // leftmost, which keeps a merged-in branch beside the commit that merges it
 // and removes crossings at no cost.
-int AllocateLane(std::vector<LaneSlot>& lanes, GitGraphLaneStrategy strategy,
+template <typename Slot>
+int AllocateLane(std::vector<Slot>& lanes, GitGraphLaneStrategy strategy,
                  int hint = -1) {
     if (strategy == GitGraphLaneStrategy::Compact) {
         int best = -1;
@@ -52,7 +57,7 @@ int AllocateLane(std::vector<LaneSlot>& lanes, GitGraphLaneStrategy strategy,
         }
         if (best >= 0) {
             lanes[best].active = true;
-            lanes[best].expecting.clear();
+            lanes[best].expecting = kNoCommit;
             return best;
         }
     } else {
@@ -63,18 +68,67 @@ int AllocateLane(std::vector<LaneSlot>& lanes, GitGraphLaneStrategy strategy,
         }
     }
 
-    lanes.push_back(LaneSlot{true, false, std::string()});
+    lanes.push_back(Slot{true, false, kNoCommit});
     return static_cast<int>(lanes.size()) - 1;
 }
 
-void FreeLane(std::vector<LaneSlot>& lanes, int lane) {
+template <typename Slot>
+void FreeLane(std::vector<Slot>& lanes, int lane) {
     if (lane < 0 || lane >= static_cast<int>(lanes.size())) return;
     lanes[lane].active = false;
-    lanes[lane].expecting.clear();
+    lanes[lane].expecting = kNoCommit;
+}
+
+template <typename Slot>
+bool IsExpected(const std::vector<Slot>& lanes, int64_t id) {
+    for (const Slot& slot : lanes) {
+        if (slot.active && slot.expecting == id) return true;
+    }
+    return false;
+}
+
+// The sweep records which lanes were set to wait for a commit instead of
+// scanning the whole lane table per row - Stable allocation leaves long runs of
+// idle slots on a big history. Entries go stale when a lane is freed or
+// retargeted, so they are re-checked here. Leftmost first.
+template <typename Slot>
+std::vector<int> LanesStillWaiting(const std::vector<Slot>& lanes,
+                                   const std::vector<int>& recorded, int64_t id) {
+    std::vector<int> waiting;
+    for (int lane : recorded) {
+        if (lane < static_cast<int>(lanes.size()) &&
+            lanes[lane].active && lanes[lane].expecting == id) {
+            waiting.push_back(lane);
+        }
+    }
+    std::sort(waiting.begin(), waiting.end());
+    waiting.erase(std::unique(waiting.begin(), waiting.end()), waiting.end());
+    return waiting;
 }
 
 } // namespace
 
+struct UltraCanvasGitGraphLayout::ParentTable {
+    std::vector<size_t>  offsets;       // commits.size() + 1 entries
+    std::vector<int64_t> indices;       // Parent commit index, -1 when absent
+
+    ParentTable(const std::vector<GitGraphCommit>& commits,
+                const std::unordered_map<std::string, size_t>& bySha) {
+        offsets.reserve(commits.size() + 1);
+        offsets.push_back(0);
+        for (const GitGraphCommit& commit : commits) {
+            for (const std::string& parent : commit.parents) {
+                auto it = bySha.find(parent);
+                indices.push_back(it == bySha.end() ? -1 : static_cast<int64_t>(it->second));
+            }
+            offsets.push_back(indices.size());
+        }
+    }
+
+    size_t Count(size_t commit) const { return offsets[commit + 1] - offsets[commit]; }
+    int64_t At(size_t commit, size_t p) const { return indices[offsets[commit] + p]; }
+};
+
 // ===== ORDERING =====
 
 std::vector<size_t> UltraCanvasGitGraphLayout::ResolveOrder(
@@ -201,7 +255,7 @@ std::vector<size_t> UltraCanvasGitGraphLayout::ResolveOrder(
 void UltraCanvasGitGraphLayout::AssignLanes(
         const std::vector<GitGraphCommit>& commits,
         const std::vector<size_t>& order,
-        const std::unordered_map<std::string, size_t>& bySha,
+        const ParentTable& parents,
         const std::vector<bool>& onTrunk,
         GitGraphLayoutResult& result) const {
 
@@ -210,20 +264,27 @@ void UltraCanvasGitGraphLayout::AssignLanes(
 
     std::vector<LaneSlot> lanes;
     if (trunkPinned) {
-        lanes.push_back(LaneSlot{false, true, std::string()});   // Lane 0 = trunk
+        lanes.push_back(LaneSlot{false, true, kNoCommit});   // Lane 0 = trunk
     }
+    result.commits.reserve(order.size());
+    result.indexBySha.reserve(order.size());
+
+    // Per commit index, the lanes set to wait for it (see LanesStillWaiting).
+    std::vector<std::vector<int>> recorded(commits.size());
+    auto expect = [&](int lane, int64_t parent) {
+        lanes[lane].expecting = parent;
+        lanes[lane].active = true;
+        recorded[parent].push_back(lane);
+    };
 
     for (size_t row = 0; row < order.size(); ++row) {
         const size_t idx = order[row];
         const GitGraphCommit& commit = commits[idx];
 
         // Lanes waiting for this commit; the leftmost keeps it, the rest end here.
-        std::vector<int> matched;
-        for (size_t i = 0; i < lanes.size(); ++i) {
-            if (lanes[i].active && lanes[i].expecting == commit.sha) {
-                matched.push_back(static_cast<int>(i));
-            }
-        }
+        const std::vector<int> matched =
+            LanesStillWaiting(lanes, recorded[idx], static_cast<int64_t>(idx));
+        std::vector<int>().swap(recorded[idx]);
 
         int lane;
         if (trunkPinned && onTrunk[idx]) {
@@ -241,14 +302,14 @@ void UltraCanvasGitGraphLayout::AssignLanes(
 
         // The first parent continues this lane; a missing or trunk-bound first
         // parent ends it (the branch line runs into the trunk instead).
+        const size_t parentCount = parents.Count(idx);
         bool laneContinues = false;
-        if (!commit.parents.empty()) {
-            auto it = bySha.find(commit.parents.front());
-            if (it != bySha.end()) {
-                const bool parentOnTrunk = trunkPinned && onTrunk[it->second];
+        if (parentCount > 0) {
+            const int64_t first = parents.At(idx, 0);
+            if (first >= 0) {
+                const bool parentOnTrunk = trunkPinned && onTrunk[first];
                 if (!parentOnTrunk || lane == 0) {
-                    lanes[lane].expecting = commit.parents.front();
-                    lanes[lane].active = true;
+                    expect(lane, first);
                     laneContinues = true;
                 }
             }
@@ -257,23 +318,13 @@ void UltraCanvasGitGraphLayout::AssignLanes(
 
         // Reserve a lane for every additional parent so the merged-in branch is
         // already in place by the time we reach it.
-        for (size_t p = 1; p < commit.parents.size(); ++p) {
-            const std::string& parentSha = commit.parents[p];
-            auto it = bySha.find(parentSha);
-            if (it == bySha.end()) continue;
-            if (trunkPinned && onTrunk[it->second]) continue;
-
-            bool alreadyExpected = false;
-            for (const LaneSlot& slot : lanes) {
-                if (slot.active && slot.expecting == parentSha) {
-                    alreadyExpected = true;
-                    break;
-                }
-            }
-            if (alreadyExpected) continue;
+        for (size_t p = 1; p < parentCount; ++p) {
+            const int64_t parent = parents.At(idx, p);
+            if (parent < 0) continue;
+            if (trunkPinned && onTrunk[parent]) continue;
+            if (!LanesStillWaiting(lanes, recorded[parent], parent).empty()) continue;
 
-            const int mergeLane = AllocateLane(lanes, options.laneStrategy, lane);
-            lanes[mergeLane].expecting = parentSha;
+            expect(AllocateLane(lanes, options.laneStrategy, lane), parent);
         }
 
         GitGraphPlacedCommit placed;
@@ -864,6 +915,8 @@ GitGraphLayoutResult UltraCanvasGitGraphLayout::Compute(
     if (options.layoutMode == GitGraphLayoutMode::Swimlane) {
         effective.AssignSwimlanes(commits, order, bySha, refs, result);
     } else {
+        const ParentTable parents(commits, bySha);
+
         // Trunk membership: the first-parent chain from the pinned branch's tip.
         std::vector<bool> onTrunk(commits.size(), false);
         if (!options.trunkBranch.empty()) {
@@ -882,19 +935,16 @@ GitGraphLayoutResult UltraCanvasGitGraphLayout::Compute(
                 }
             }
 
-            std::string cursor = tip;
-            while (!cursor.empty()) {
-                auto it = bySha.find(cursor);
-                if (it == bySha.end()) break;
-                if (onTrunk[it->second]) break;          // Guard against cycles
-                onTrunk[it->second] = true;
-                cursor = commits[it->second].parents.empty()
-                             ? std::string()
-                             : commits[it->second].parents.front();
+            auto it = tip.empty() ? bySha.end() : bySha.find(tip);
+            int64_t cursor = (it == bySha.end()) ? -1 : static_cast<int64_t>(it->second);
+            while (cursor >= 0) {
+                if (onTrunk[cursor]) break;              // Guard against cycles
+                onTrunk[cursor] = true;
+                cursor = parents.Count(cursor) > 0 ? parents.At(cursor, 0) : -1;
             }
         }
 
-        effective.AssignLanes(commits, order, bySha, onTrunk, result);
+        effective.AssignLanes(commits, order, parents, onTrunk, result);
     }
 
     for (GitGraphPlacedCommit& placed : result.commits) {
@@ -926,4 +976,256 @@ GitGraphLayoutResult UltraCanvasGitGraphLayout::Compute(
     return result;
 }
 
+// ===== INCREMENTAL LANES =====
+
+namespace {
+
+GitGraphPlacedEdge MakeParentEdge(const GitGraphPlacedCommit& child,
+                                  const GitGraphPlacedCommit& parent, size_t p) {
+    GitGraphPlacedEdge edge;
+    edge.childSha    = child.sha;
+    edge.parentSha   = parent.sha;
+    edge.fromRow     = child.row;
+    edge.fromLane    = child.lane;
+    edge.toRow       = parent.row;
+    edge.toLane      = parent.lane;
+    edge.kind        = (p == 0) ? GitGraphEdgeKind::Parent : GitGraphEdgeKind::Merge;
+    edge.turnAtChild = (p > 0);
+    edge.colorLane   = (p == 0) ? child.lane : parent.lane;
+    return edge;
+}
+
+GitGraphPlacedEdge MakeCherryPickEdge(const GitGraphPlacedCommit& child,
+                                      const GitGraphPlacedCommit& source) {
+    GitGraphPlacedEdge edge;
+    edge.childSha    = child.sha;
+    edge.parentSha   = source.sha;
+    edge.fromRow     = child.row;
+    edge.fromLane    = child.lane;
+    edge.toRow       = source.row;
+    edge.toLane      = source.lane;
+    edge.kind        = GitGraphEdgeKind::CherryPick;
+    edge.turnAtChild = true;
+    edge.colorLane   = child.lane;
+    return edge;
+}
+
+std::string FindTrunkTip(const GitGraphLayoutOptions& options,
+                         const std::vector<GitGraphRef>& refs) {
+    if (options.trunkBranch.empty()) return std::string();
+    for (const GitGraphRef& ref : refs) {
+        if ((ref.type == GitGraphRefType::LocalBranch ||
+             ref.type == GitGraphRefType::RemoteBranch) &&
+            ref.name == options.trunkBranch) {
+            return ref.sha;
+        }
+    }
+    return std::string();
+}
+
+} // namespace
+
+bool UltraCanvasGitGraphIncrementalLayout::Supports(const GitGraphLayoutOptions& options) {
+    return options.orderMode == GitGraphOrderMode::AsGiven &&
+           options.layoutMode == GitGraphLayoutMode::Lanes &&
+           options.hiddenCommits.empty() &&
+           !options.collapseLinearRuns &&
+           !options.parallelCommits &&
+           !options.reduceCrossings &&
+           options.lanePriority.empty();
+}
+
+void UltraCanvasGitGraphIncrementalLayout::Reset(const GitGraphLayoutOptions& newOptions,
+                                                 const std::vector<GitGraphRef>& refs) {
+    options     = newOptions;
+    trunkTip    = FindTrunkTip(options, refs);
+    trunkNext   = trunkTip;
+    trunkPinned = !trunkTip.empty();
+
+    lanes.clear();
+    if (trunkPinned) lanes.push_back(Slot{false, true, kNoCommit});   // Lane 0 = trunk
+
+    awaited.clear();
+    missingParents.clear();
+    nextAwaitedId = -1;
+    placedCount   = 0;
+}
+
+bool UltraCanvasGitGraphIncrementalLayout::IsCompatible(
+        const GitGraphLayoutOptions& newOptions,
+        const std::vector<GitGraphRef>& refs) const {
+    return Supports(newOptions) &&
+           newOptions.laneStrategy == options.laneStrategy &&
+           newOptions.trunkBranch == options.trunkBranch &&
+           FindTrunkTip(newOptions, refs) == trunkTip;
+}
+
+size_t UltraCanvasGitGraphIncrementalLayout::GetOpenLaneCount() const {
+    size_t open = 0;
+    for (const Slot& slot : lanes) {
+        if (slot.active) ++open;
+    }
+    return open;
+}
+
+UltraCanvasGitGraphIncrementalLayout::Awaited* UltraCanvasGitGraphIncrementalLayout::Await(
+        const std::string& sha, const GitGraphLayoutResult& result) {
+    if (result.indexBySha.count(sha) > 0) return nullptr;
+
+    auto [it, inserted] = awaited.try_emplace(sha);
+    if (inserted) it->second.id = nextAwaitedId--;
+    return &it->second;
+}
+
+void UltraCanvasGitGraphIncrementalLayout::Expect(int lane, Awaited& parent) {
+    lanes[lane].active    = true;
+    lanes[lane].expecting = parent.id;
+    parent.lanes.push_back(lane);
+}
+
+std::vector<int> UltraCanvasGitGraphIncrementalLayout::LanesWaitingFor(
+        const Awaited& commit) const {
+    return LanesStillWaiting(lanes, commit.lanes, commit.id);
+}
+
+void UltraCanvasGitGraphIncrementalLayout::Append(const std::vector<GitGraphCommit>& commits,
+                                                  size_t first,
+                                                  GitGraphLayoutResult& result) {
+    if (first >= commits.size()) return;
+
+    // Per parent: its row when placed (only in a history that is not
+    // child-first), else its awaited entry.
+    std::vector<int64_t>  parentRows;
+    std::vector<Awaited*> parentEntries;
+
+    for (size_t i = first; i < commits.size(); ++i) {
+        const GitGraphCommit& commit = commits[i];
+        const int row = static_cast<int>(placedCount);
+
+        // Only an awaited commit can have lanes waiting for it; anything else
+        // starts a new line of development.
+        std::vector<PendingEdge> arrivals;
+        std::vector<int> matched;
+        auto awaitedIt = awaited.find(commit.sha);
+        if (awaitedIt != awaited.end()) {
+            matched  = LanesWaitingFor(awaitedIt->second);
+            arrivals = std::move(awaitedIt->second.edges);
+            awaited.erase(awaitedIt);
+        }
+
+        const bool onTrunk = trunkPinned && commit.sha == trunkNext;
+        int lane;
+        if (onTrunk) {
+            lane = 0;
+            lanes[0].active = true;
+            trunkNext = commit.parents.empty() ? std::string() : commit.parents.front();
+        } else if (!matched.empty()) {
+            lane = matched.front();
+        } else {
+            lane = AllocateLane(lanes, options.laneStrategy);
+        }
+        for (int other : matched) {
+            if (other != lane) FreeLane(lanes, other);
+        }
+
+        GitGraphPlacedCommit placed;
+        placed.sha     = commit.sha;
+        placed.row     = row;
+        placed.lane    = lane;
+        placed.isMerge = commit.IsMerge();
+        placed.isRoot  = commit.IsRoot();
+        placed.branch  = commit.branch;
+        result.indexBySha[placed.sha] = result.commits.size();
+        result.commits.push_back(std::move(placed));
+        result.maxLane = std::max(result.maxLane, lane);
+        ++placedCount;
+
+        parentRows.clear();
+        parentEntries.clear();
+        for (const std::string& parent : commit.parents) {
+            Awaited* entry = Await(parent, result);
+            parentEntries.push_back(entry);
+            parentRows.push_back(entry ? -1 : static_cast<int64_t>(result.indexBySha[parent]));
+        }
+
+        // A parent is known to be on the trunk only once the trunk cursor has
+        // reached it; until then the branch keeps its own lane.
+        auto parentOnTrunk = [&](size_t p) {
+            if (!trunkPinned) return false;
+            if (!parentEntries[p]) return result.commits[parentRows[p]].lane == 0;
+            return commit.parents[p] == trunkNext;
+        };
+        auto expect = [&](int target, size_t p) {
+            if (parentEntries[p]) {
+                Expect(target, *parentEntries[p]);
+            } else {
+                lanes[target].active    = true;
+                lanes[target].expecting = parentRows[p];
+            }
+        };
+
+        if (!parentEntries.empty() && (!parentOnTrunk(0) || lane == 0)) {
+            expect(lane, 0);
+        } else {
+            FreeLane(lanes, lane);
+        }
+
+        for (size_t p = 1; p < parentEntries.size(); ++p) {
+            if (parentOnTrunk(p)) continue;
+            const bool expected = parentEntries[p]
+                                      ? !LanesWaitingFor(*parentEntries[p]).empty()
+                                      : IsExpected(lanes, parentRows[p]);
+            if (expected) continue;
+            expect(AllocateLane(lanes, options.laneStrategy, lane), p);
+        }
+
+        // Edges to placed parents go out now; the rest wait for their parent
+        // and mark this commit boundary until it arrives.
+        for (size_t p = 0; p < parentEntries.size(); ++p) {
+            if (std::find(commit.parents.begin(), commit.parents.begin() + p,
+                          commit.parents[p]) != commit.parents.begin() + p) {
+                continue;                               // Duplicate parent
+            }
+            if (!parentEntries[p]) {
+                result.edges.push_back(MakeParentEdge(result.commits[row],
+                                                      result.commits[parentRows[p]], p));
+            } else {
+                parentEntries[p]->edges.push_back(PendingEdge{row, static_cast<int>(p), false});
+                ++missingParents[row];
+                result.commits[row].isBoundary = true;
+            }
+        }
+
+        if (!commit.cherryPickSource.empty()) {
+            Awaited* source = Await(commit.cherryPickSource, result);
+            if (!source) {
+                result.edges.push_back(MakeCherryPickEdge(
+                    result.commits[row],
+                    result.commits[result.indexBySha[commit.cherryPickSource]]));
+            } else {
+                source->edges.push_back(PendingEdge{row, 0, true});
+            }
+        }
+
+        // Children loaded in earlier pages that were waiting for this commit.
+        for (const PendingEdge& pending : arrivals) {
+            GitGraphPlacedCommit& child = result.commits[pending.childRow];
+            if (pending.cherryPick) {
+                result.edges.push_back(MakeCherryPickEdge(child, result.commits[row]));
+                continue;
+            }
+            result.edges.push_back(MakeParentEdge(child, result.commits[row],
+                                                  static_cast<size_t>(pending.parentIndex)));
+            auto missing = missingParents.find(pending.childRow);
+            if (missing != missingParents.end() && --missing->second == 0) {
+                missingParents.erase(missing);
+                child.isBoundary = false;
+            }
+        }
+    }
+
+    result.rowCount = static_cast<int>(placedCount);
+    result.minLane  = 0;
+}
+
 } // namespace UltraCanvas
@@ -1,18 +1,21 @@
 // Plugins/Diagrams/UltraCanvasNodeDiagram.cpp
 // Interactive Node Diagram component implementation
-// Version: 2.0.7
-// Last Modified: 2026-05-09
+// Version: 2.3.0
+// Last Modified: 2026-10-18
 // Author: UltraCanvas Framework
 //
 // See header for full changelog (2.0.6 + 2.0.5 + 2.0.4 + 2.0.3 + 2.0.2 + 2.0.1 patches + 2.0.0 mayor).
 
 #include "Plugins/Diagrams/UltraCanvasNodeDiagram.h"
+#include "UltraCanvasApplication.h"
 #include <sstream>
 #include <iomanip>
 #include <cmath>
 #include <algorithm>
 #include <random>
 #include <cstdio>
+#include <chrono>
+#include <unordered_map>
 
 namespace UltraCanvas {
 
@@ -35,6 +38,11 @@ UltraCanvasNodeDiagram::UltraCanvasNodeDiagram(const std::string& id,
     ApplyDefaultTheme();
 }
 
+UltraCanvasNodeDiagram::~UltraCanvasNodeDiagram() {
+    alive->store(false);
+    CancelLayout();
+}
+
 // =============================================================================
 // NODE MANAGEMENT - SIMPLE API
 // =============================================================================
@@ -376,6 +384,12 @@ void UltraCanvasNodeDiagram::RunLayout() {
 
     switch (layout) {
         case NodeDiagramLayout::ForceDirected:
+            if (asyncLayout) {
+                // 2.3.0: FitView runs when the worker delivers the result.
+                StartForceDirectedLayout(style.iterations);
+                RequestRedraw();
+                return;
+            }
             RunForceDirectedLayout(style.iterations);
             break;
         case NodeDiagramLayout::Circular:
@@ -402,8 +416,134 @@ void UltraCanvasNodeDiagram::RunLayout() {
 }
 
 void UltraCanvasNodeDiagram::RunForceDirectedLayout(int iterations) {
+    CancelLayout();
     if (nodes.empty()) return;
-    
+
+    // 2.3.0: the simulation itself lives in UltraCanvasForceLayout (SoA arrays,
+    // Barnes-Hut repulsion, early stop). The forces, the annealing schedule,
+    // the initial ring and the final overlap pass are the ones this function
+    // has used since 2.0.4 / 2.0.6 / 2.2.0.
+    std::vector<std::string> ids;
+    ForceLayoutSolver solver(BuildForceLayoutGraph(ids),
+                             BuildForceLayoutOptions(iterations, nodes.size()));
+    solver.Run();
+    ApplyForceLayoutPositions(ids, solver.Graph().x, solver.Graph().y);
+}
+
+void UltraCanvasNodeDiagram::StartForceDirectedLayout(int iterations) {
+    CancelLayout();
+    if (nodes.empty()) return;
+
+    UltraCanvasApplicationBase* app = UltraCanvasApplicationBase::GetCurrent();
+    if (!app) {
+        // No event loop to post frames to - lay out synchronously.
+        std::vector<std::string> ids;
+        ForceLayoutSolver solver(BuildForceLayoutGraph(ids),
+                                 BuildForceLayoutOptions(iterations, nodes.size()));
+        solver.Run();
+        ApplyForceLayoutPositions(ids, solver.Graph().x, solver.Graph().y);
+        if (autoFitOnLayout) FitView();
+        if (onLayoutFinished) onLayoutFinished(solver.Converged(), solver.Iteration());
+        RequestRedraw();
+        return;
+    }
+
+    std::vector<std::string> ids;
+    ForceLayoutGraph graph = BuildForceLayoutGraph(ids);
+    ForceLayoutOptions options = BuildForceLayoutOptions(iterations, nodes.size());
+    auto nodeIds = std::make_shared<const std::vector<std::string>>(std::move(ids));
+    auto frameInterval = std::chrono::milliseconds(std::max(style.layoutFrameInterval, 1));
+
+    const uint64_t generation = ++layoutGeneration;
+    auto cancel = std::make_shared<std::atomic<bool>>(false);
+    layoutCancel = cancel;
+    layoutRunning = true;
+
+    layoutThread = std::thread([this, app, graph = std::move(graph), options, nodeIds, cancel,
+                                aliveFlag = alive, generation, frameInterval]() mutable {
+        ForceLayoutSolver solver(std::move(graph), options);
+
+        // Copies the current positions and hands them to the UI thread.
+        auto post = [&](bool final) {
+            auto xs = std::make_shared<std::vector<double>>(solver.Graph().x);
+            auto ys = std::make_shared<std::vector<double>>(solver.Graph().y);
+            bool converged = solver.Converged();
+            int iterationsRun = solver.Iteration();
+            app->PostToUIThread([this, aliveFlag, generation, nodeIds, xs, ys, final,
+                                 converged, iterationsRun]() {
+                if (!aliveFlag->load() || generation != layoutGeneration) return;
+                ApplyForceLayoutPositions(*nodeIds, *xs, *ys);
+                if (final) {
+                    layoutRunning = false;
+                    if (autoFitOnLayout && !nodes.empty()) FitView();
+                    if (onLayoutFinished) onLayoutFinished(converged, iterationsRun);
+                }
+                RequestRedraw();
+            });
+        };
+
+        auto lastFrame = std::chrono::steady_clock::now();
+        bool completed = solver.Run(cancel.get(), [&](const ForceLayoutSolver&) {
+            if (!aliveFlag->load()) return false;
+            auto now = std::chrono::steady_clock::now();
+            if (now - lastFrame >= frameInterval) {
+                lastFrame = now;
+                post(false);
+            }
+            return true;
+        }, 1);
+        if (!completed || cancel->load() || !aliveFlag->load()) return;
+        post(true);
+    });
+}
+
+void UltraCanvasNodeDiagram::CancelLayout() {
+    if (layoutCancel) layoutCancel->store(true);
+    if (layoutThread.joinable()) layoutThread.join();
+    layoutCancel.reset();
+    if (layoutRunning) {
+        // Drop frames the cancelled run already posted.
+        ++layoutGeneration;
+        layoutRunning = false;
+    }
+}
+
+ForceLayoutGraph UltraCanvasNodeDiagram::BuildForceLayoutGraph(std::vector<std::string>& ids) const {
+    ForceLayoutGraph graph;
+    graph.Reserve(nodes.size(), links.size());
+    ids.clear();
+    ids.reserve(nodes.size());
+
+    // Map order, so the initial ring is the same as before 2.3.0.
+    std::unordered_map<std::string, uint32_t> indexOf;
+    indexOf.reserve(nodes.size());
+    for (const auto& pair : nodes) {
+        const auto& node = pair.second;
+        indexOf[pair.first] = graph.AddNode(node.x, node.y, node.width, node.height, node.isPinned);
+        ids.push_back(pair.first);
+    }
+
+    for (const auto& link : links) {
+        auto source = indexOf.find(link.sourceNodeId);
+        auto target = indexOf.find(link.targetNodeId);
+        if (source == indexOf.end() || target == indexOf.end()) continue;
+        graph.AddLink(source->second, target->second);
+    }
+
+    for (const auto& group : groups) {
+        std::vector<uint32_t> members;
+        members.reserve(group.nodeIds.size());
+        for (const auto& nodeId : group.nodeIds) {
+            auto it = indexOf.find(nodeId);
+            if (it != indexOf.end()) members.push_back(it->second);
+        }
+        if (members.size() >= 2) graph.groups.push_back(std::move(members));
+    }
+    return graph;
+}
+
+ForceLayoutOptions UltraCanvasNodeDiagram::BuildForceLayoutOptions(int iterations,
+                                                                   size_t nodeCount) const {
     // 2.0.1: Bounds may not yet be set when the user calls RunLayout() right
     // after AddNode (parent layout pass hasn't run). Use a sane fallback so the
     // simulation always has a finite area to converge in.
@@ -411,228 +551,43 @@ void UltraCanvasNodeDiagram::RunForceDirectedLayout(int iterations) {
     double height = static_cast<double>(finalBounds.height);
     if (width  < 100.0f) width  = 800.0f;
     if (height < 100.0f) height = 600.0f;
-    double centerX = width  / 2.0f;
-    double centerY = height / 2.0f;
-    
-    // 2.0.4: DETERMINISTIC circular initialization. The previous version used
-    // rand() (never seeded -> first call always gave the same arrangement, but
-    // the algorithm sometimes settled into a local minimum with overlapping
-    // nodes). Placing nodes evenly on a ring gives the repulsion forces a
-    // symmetric starting point so they fan out reliably.
-    {
-        size_t n = nodes.size();
-        if (n == 0) return;
-        double initRadius = std::min(width, height) * 0.30f;
-        if (initRadius < 50.0f) initRadius = 50.0f;
-        const double TWO_PI = 6.28318530717958647692f;
-        size_t idx = 0;
-        for (auto& pair : nodes) {
-            if (!pair.second.isPinned) {
-                double angle = (static_cast<double>(idx) / static_cast<double>(n)) * TWO_PI;
-                pair.second.x = centerX + initRadius * std::cos(angle);
-                pair.second.y = centerY + initRadius * std::sin(angle);
-            }
-            idx++;
-        }
-    }
-    
-    // 2.0.4: 2.5x more iterations + simulated annealing temperature factor
-    // that limits how far a node can move per iteration. Starts at 1.0 (full
-    // step) and cools to 0.05 (small adjustments) so the layout settles
-    // instead of oscillating.
-    int iters = std::max(iterations, 250);
-    
-    // 2.0.4: Center-pulling force (very weak) keeps disconnected components
-    // from drifting off-screen.
-    const double kCenterPull = 0.005f;
-    
-    for (int iter = 0; iter < iters; ++iter) {
-        // Cool from 1.0 down to 0.05 over the run
-        double t = static_cast<double>(iter) / static_cast<double>(iters);
-        double temperature = 1.0f - 0.95f * t;
-        
-        // Reset velocities
-        for (auto& pair : nodes) {
-            pair.second.vx = 0;
-            pair.second.vy = 0;
-        }
-        
-        // Spring force from links
-        for (auto& link : links) {
-            auto* source = GetNode(link.sourceNodeId);
-            auto* target = GetNode(link.targetNodeId);
-            if (!source || !target) continue;
-            
-            double dx = target->x - source->x;
-            double dy = target->y - source->y;
-            double dist = std::sqrt(dx * dx + dy * dy);
-            if (dist < 0.1f) dist = 0.1f;
-            
-            double force = (dist - style.linkDistance) * style.linkStrength;
-            double fx = (dx / dist) * force;
-            double fy = (dy / dist) * force;
-            
-            if (!source->isPinned) {
-                source->vx += fx;
-                source->vy += fy;
-            }
-            if (!target->isPinned) {
-                target->vx -= fx;
-                target->vy -= fy;
-            }
-        }
-        
-        // Repulsion (Coulomb-like) between all node pairs
-        for (auto it1 = nodes.begin(); it1 != nodes.end(); ++it1) {
-            if (it1->second.isPinned) continue;
-            
-            for (auto it2 = nodes.begin(); it2 != nodes.end(); ++it2) {
-                if (it1 == it2) continue;
-                
-                double dx = it2->second.x - it1->second.x;
-                double dy = it2->second.y - it1->second.y;
-                double distSq = dx * dx + dy * dy;
-                if (distSq < 1.0f) distSq = 1.0f;
-                
-                double force = style.chargeStrength / distSq;
-                double invDist = 1.0f / std::sqrt(distSq);
-                it1->second.vx += dx * invDist * force;
-                it1->second.vy += dy * invDist * force;
-            }
-        }
-        
-        // 2.0.4: Center-pulling force - prevents drift
-        for (auto& pair : nodes) {
-            if (pair.second.isPinned) continue;
-            double ncx = pair.second.x + pair.second.width  * 0.5f;
-            double ncy = pair.second.y + pair.second.height * 0.5f;
-            pair.second.vx += (centerX - ncx) * kCenterPull;
-            pair.second.vy += (centerY - ncy) * kCenterPull;
-        }
-
-        // 2.2.0: GROUP COHESION.
-        //
-        // Pull every member of a cluster toward that cluster's centroid. Without
-        // it, repulsion scatters group members across the canvas and the cluster
-        // boxes grow until they all overlap - the boxes only read as clusters if
-        // the layout keeps their members together in the first place.
-        if (style.groupCohesion > 0.0 && !groups.empty()) {
-            for (const auto& group : groups) {
-                if (group.nodeIds.size() < 2) continue;
-
-                double sumX = 0.0, sumY = 0.0;
-                int count = 0;
-                for (const auto& nodeId : group.nodeIds) {
-                    auto it = nodes.find(nodeId);
-                    if (it == nodes.end()) continue;
-                    sumX += it->second.x + it->second.width  * 0.5f;
-                    sumY += it->second.y + it->second.height * 0.5f;
-                    ++count;
-                }
-                if (count < 2) continue;
-
-                double gcx = sumX / static_cast<double>(count);
-                double gcy = sumY / static_cast<double>(count);
-
-                for (const auto& nodeId : group.nodeIds) {
-                    auto it = nodes.find(nodeId);
-                    if (it == nodes.end() || it->second.isPinned) continue;
-                    double ncx = it->second.x + it->second.width  * 0.5f;
-                    double ncy = it->second.y + it->second.height * 0.5f;
-                    it->second.vx += (gcx - ncx) * style.groupCohesion;
-                    it->second.vy += (gcy - ncy) * style.groupCohesion;
-                }
-            }
-        }
 
-
-        // Apply velocities with annealing temperature
-        for (auto& pair : nodes) {
-            if (pair.second.isPinned) continue;
-            
-            // Cap per-step movement: heavily limited at high temperature loses
-            // the swing, so we cap by absolute value rather than scaling.
-            double maxStep = 30.0f * temperature + 2.0f;
-            double vx = std::max(-maxStep, std::min(maxStep, pair.second.vx));
-            double vy = std::max(-maxStep, std::min(maxStep, pair.second.vy));
-            
-            pair.second.x += vx;
-            pair.second.y += vy;
-            
-            pair.second.x = std::max(30.0, std::min(width - 30.0, pair.second.x));
-            pair.second.y = std::max(30.0, std::min(height - 30.0, pair.second.y));
-        }
-    }
-    
-    // 2.0.6: ANTI-OVERLAP POST-PROCESS PASS.
-    //
-    // Force-directed simulations with discrete timesteps can leave residual
-    // node overlaps even when the energy minimum has been found - the
-    // repulsive force is continuous and never quite enough to stop two nodes
-    // from clipping when they're already very close. This pass runs after the
-    // main simulation and physically separates any pair of overlapping nodes
-    // by their bounding-box radii plus a small margin. Iterates a few times
-    // because pushing A-B apart may create a new B-C overlap.
-    {
-        const int kSeparationIterations = 8;
-        const double kMargin = 6.0;  // Extra gap between separated nodes
-        for (int sepIter = 0; sepIter < kSeparationIterations; ++sepIter) {
-            bool anyOverlap = false;
-            for (auto it1 = nodes.begin(); it1 != nodes.end(); ++it1) {
-                auto it2 = it1;
-                for (++it2; it2 != nodes.end(); ++it2) {
-                    auto& a = it1->second;
-                    auto& b = it2->second;
-                    
-                    // Use the larger half-dimension as the effective radius
-                    // (covers both circle and rectangular shapes well enough).
-                    double ar = std::max(a.width, a.height) * 0.5f;
-                    double br = std::max(b.width, b.height) * 0.5f;
-                    double minDist = ar + br + kMargin;
-                    
-                    double acx = a.x + a.width  * 0.5f;
-                    double acy = a.y + a.height * 0.5f;
-                    double bcx = b.x + b.width  * 0.5f;
-                    double bcy = b.y + b.height * 0.5f;
-                    double dx = bcx - acx;
-                    double dy = bcy - acy;
-                    double dist = std::sqrt(dx * dx + dy * dy);
-                    
-                    if (dist < minDist) {
-                        anyOverlap = true;
-                        // Compute push direction (handle the dist==0 edge case
-                        // by picking an arbitrary unit vector).
-                        double pushX, pushY;
-                        if (dist < 0.001f) {
-                            pushX = 1.0;
-                            pushY = 0.0;
-                        } else {
-                            pushX = dx / dist;
-                            pushY = dy / dist;
-                        }
-                        // Total push needed to separate them, split half each
-                        double push = (minDist - dist) * 0.5f;
-                        // Skip pinned nodes - all push goes to the other one
-                        bool aPinned = a.isPinned;
-                        bool bPinned = b.isPinned;
-                        if (aPinned && bPinned) continue;  // Can't move either
-                        double aWeight = aPinned ? 0.0 : (bPinned ? 2.0 : 1.0);
-                        double bWeight = bPinned ? 0.0 : (aPinned ? 2.0 : 1.0);
-                        a.x -= pushX * push * aWeight;
-                        a.y -= pushY * push * aWeight;
-                        b.x += pushX * push * bWeight;
-                        b.y += pushY * push * bWeight;
-                    }
-                }
-            }
-            // Re-clamp to bounds after pushing
-            for (auto& pair : nodes) {
-                if (pair.second.isPinned) continue;
-                pair.second.x = std::max(30.0, std::min(width - 30.0, pair.second.x));
-                pair.second.y = std::max(30.0, std::min(height - 30.0, pair.second.y));
-            }
-            if (!anyOverlap) break;  // Stable
-        }
+    // 2.3.0: grow the area so every node has about (linkDistance / 2)^2 of it.
+    // Diagrams that fit the widget are unaffected; a 10k-node graph is no
+    // longer squeezed into 800x600 (FitView brings it back into view).
+    double spacing = std::max(style.linkDistance, 1.0) * 0.5;
+    double needed = static_cast<double>(nodeCount) * spacing * spacing;
+    if (needed > width * height) {
+        double scale = std::sqrt(needed / (width * height));
+        width  *= scale;
+        height *= scale;
+    }
+
+    ForceLayoutOptions options;
+    options.width = width;
+    options.height = height;
+    options.linkDistance = style.linkDistance;
+    options.linkStrength = style.linkStrength;
+    options.chargeStrength = style.chargeStrength;
+    options.groupCohesion = style.groupCohesion;
+    options.theta = style.layoutTheta;
+    options.convergenceThreshold = style.layoutConvergence;
+    // 2.0.4: at least 250 iterations, cooled by simulated annealing.
+    options.iterations = std::max(iterations, 250);
+    return options;
+}
+
+void UltraCanvasNodeDiagram::ApplyForceLayoutPositions(const std::vector<std::string>& ids,
+                                                       const std::vector<double>& xs,
+                                                       const std::vector<double>& ys) {
+    const size_t count = std::min(ids.size(), std::min(xs.size(), ys.size()));
+    for (size_t i = 0; i < count; ++i) {
+        // Nodes removed, pinned or grabbed by the user since the layout
+        // started keep their current position.
+        auto it = nodes.find(ids[i]);
+        if (it == nodes.end() || it->second.isPinned || it->second.isDragging) continue;
+        it->second.x = xs[i];
+        it->second.y = ys[i];
     }
 }
 
@@ -2,12 +2,13 @@
 // Implementation of the UCD password-encryption envelope. See the header for
 // the byte layout and the reasoning behind it.
 //
-// Version: 0.1.0
+// Version: 0.2.0
 // Author: UltraCanvas Framework / ULTRA OS
 #include "Plugins/Documents/UCDCryptoEnvelope.h"
 
 #include "UltraCrypt/UltraCryptCore.h"
 
+#include <algorithm>
 #include <cstring>
 
 namespace UltraCanvas {
@@ -18,7 +19,9 @@ constexpr size_t  kMagicSize    = 4;
 constexpr size_t  kSaltSize     = 16;
 constexpr size_t  kNonceSize    = 24;
 constexpr size_t  kHeaderSize   = 56;
+constexpr size_t  kStreamHeaderSize = 32;   // version 2: no nonce field
 constexpr uint8_t kVersion      = 1;
+constexpr uint8_t kStreamVersion = 2;
 constexpr uint8_t kKdfArgon2id  = 1;
 constexpr uint8_t kAeadXChaCha  = 1;
 const char kMagic[kMagicSize] = {'U', 'C', 'D', 'E'};
@@ -52,6 +55,61 @@ uint32_t ReadUint32LE(const uint8_t* p) {
            (static_cast<uint32_t>(p[3]) << 24);
 }
 
+// The first 32 header bytes, shared by both envelope versions.
+std::vector<uint8_t> BuildKdfHeader(uint8_t version, const UltraCryptKdfParams& kdf) {
+    std::vector<uint8_t> header;
+    header.reserve(kHeaderSize);
+    header.insert(header.end(), kMagic, kMagic + kMagicSize);
+    header.push_back(version);
+    header.push_back(kKdfArgon2id);
+    header.push_back(kAeadXChaCha);
+    header.push_back(0);                       // reserved
+    PutUint32LE(header, kdf.iterations);
+    PutUint32LE(header, kdf.memoryKiB);
+    header.insert(header.end(), kdf.salt.begin(), kdf.salt.end());
+    return header;
+}
+
+// Validates the version 2 header and derives its key.
+bool DeriveStreamKey(const uint8_t* header, const std::string& password,
+                     UltraCryptSecureBuffer& key, std::string& error) {
+    if (std::memcmp(header, kMagic, kMagicSize) != 0) {
+        error = "The document is corrupt (unrecognised encryption envelope).";
+        return false;
+    }
+    if (header[kOffVersion] != kStreamVersion) {
+        error = "This document uses a newer encryption format than this version "
+                "of UltraCanvas supports.";
+        return false;
+    }
+    if (header[kOffKdfId] != kKdfArgon2id || header[kOffAeadId] != kAeadXChaCha) {
+        error = "This document uses an unsupported key-derivation or encryption "
+                "algorithm.";
+        return false;
+    }
+    UltraCryptKdfParams kdf;
+    kdf.algorithm    = UltraCryptKdfAlgorithm::Argon2id;
+    kdf.iterations   = ReadUint32LE(header + kOffIterations);
+    kdf.memoryKiB    = ReadUint32LE(header + kOffMemoryKiB);
+    kdf.parallelism  = 1;
+    kdf.outputLength =
+        UltraCrypt_GetKeySize(UltraCryptAeadAlgorithm::XChaCha20Poly1305);
+    kdf.salt.assign(header + kOffSalt, header + kOffSalt + kSaltSize);
+    if (kdf.iterations == 0 || kdf.iterations > kMaxIterations ||
+        kdf.memoryKiB == 0 || kdf.memoryKiB > kMaxMemoryKiB) {
+        error = "The document declares unreasonable key-derivation parameters "
+                "and was not opened.";
+        return false;
+    }
+    UltraCryptSecureBuffer passwordBuffer(password.data(), password.size());
+    auto derived = UltraCrypt_DeriveKeyFromPassword(passwordBuffer, kdf, key);
+    if (!derived) {
+        error = "Could not derive the decryption key: " + derived.message;
+        return false;
+    }
+    return true;
+}
+
 } // namespace
 
 size_t GetEnvelopeHeaderSize() {
@@ -96,16 +154,7 @@ bool Seal(const std::vector<uint8_t>& plaintext,
         return false;
     }
 
-    std::vector<uint8_t> header;
-    header.reserve(kHeaderSize);
-    header.insert(header.end(), kMagic, kMagic + kMagicSize);
-    header.push_back(kVersion);
-    header.push_back(kKdfArgon2id);
-    header.push_back(kAeadXChaCha);
-    header.push_back(0);                       // reserved
-    PutUint32LE(header, kdf.iterations);
-    PutUint32LE(header, kdf.memoryKiB);
-    header.insert(header.end(), kdf.salt.begin(), kdf.salt.end());
+    std::vector<uint8_t> header = BuildKdfHeader(kVersion, kdf);
     header.insert(header.end(), aead.nonce.begin(), aead.nonce.end());
     if (header.size() != kHeaderSize) {
         error = "Internal error building the encryption envelope.";
@@ -147,6 +196,24 @@ bool Open(const std::vector<uint8_t>& envelope,
                 "be decrypted.";
         return false;
     }
+    if (envelope.size() > kOffVersion && envelope[kOffVersion] == kStreamVersion &&
+        std::memcmp(envelope.data(), kMagic, kMagicSize) == 0) {
+        size_t pos = 0;
+        UltraCryptStreamReader reader = [&](uint8_t* buffer, size_t capacity, size_t& outRead) {
+            outRead = std::min(capacity, envelope.size() - pos);
+            std::memcpy(buffer, envelope.data() + pos, outRead);
+            pos += outRead;
+            return true;
+        };
+        UltraCryptStreamWriter writer = [&](const uint8_t* data, size_t size) {
+            output.insert(output.end(), data, data + size);
+            return true;
+        };
+        if (OpenStream(reader, writer, password, associatedData, error)) return true;
+        UltraCrypt_SecureZero(output.data(), output.size());
+        output.clear();
+        return false;
+    }
     if (envelope.size() <= kHeaderSize) {
         error = "The document is corrupt (the encrypted body is truncated).";
         return false;
@@ -216,5 +283,105 @@ bool Open(const std::vector<uint8_t>& envelope,
     return true;
 }
 
+size_t GetStreamEnvelopeHeaderSize() {
+    return kStreamHeaderSize;
+}
+
+bool SealStream(const UltraCryptStreamReader& read,
+                const UltraCryptStreamWriter& write,
+                const std::string& password,
+                const std::vector<uint8_t>& associatedData,
+                std::string& error) {
+    error.clear();
+
+    if (password.empty()) {
+        error = "Cannot encrypt the document without a password.";
+        return false;
+    }
+    if (!UltraCrypt_IsAvailable()) {
+        error = "This build has no cryptography backend, so the document cannot "
+                "be encrypted.";
+        return false;
+    }
+
+    UltraCryptKdfParams kdf = UltraCrypt_RecommendedKdfParams();
+    UltraCryptSecureBuffer passwordBuffer(password.data(), password.size());
+    UltraCryptSecureBuffer key;
+    auto derived = UltraCrypt_DeriveKeyFromPassword(passwordBuffer, kdf, key);
+    if (!derived) {
+        error = "Could not derive the encryption key: " + derived.message;
+        return false;
+    }
+
+    const std::vector<uint8_t> header = BuildKdfHeader(kStreamVersion, kdf);
+    if (header.size() != kStreamHeaderSize) {
+        error = "Internal error building the encryption envelope.";
+        return false;
+    }
+    if (!write(header.data(), header.size())) {
+        error = "Could not write the encrypted document.";
+        return false;
+    }
+
+    UltraCryptStreamParams stream;    // XChaCha20-Poly1305, 64 KiB chunks
+    stream.associatedData = associatedData;
+    stream.associatedData.insert(stream.associatedData.end(), header.begin(), header.end());
+    auto sealed = UltraCrypt_AeadSealStream(key, stream, read, write);
+    if (!sealed) {
+        error = "Could not encrypt the document: " + sealed.message;
+        return false;
+    }
+    return true;
+}
+
+bool OpenStream(const UltraCryptStreamReader& read,
+                const UltraCryptStreamWriter& write,
+                const std::string& password,
+                const std::vector<uint8_t>& associatedData,
+                std::string& error) {
+    error.clear();
+
+    if (password.empty()) {
+        error = "This document is password-protected; a password is required.";
+        return false;
+    }
+    if (!UltraCrypt_IsAvailable()) {
+        error = "This build has no cryptography backend, so the document cannot "
+                "be decrypted.";
+        return false;
+    }
+
+    uint8_t header[kStreamHeaderSize];
+    size_t got = 0;
+    while (got < kStreamHeaderSize) {
+        size_t n = 0;
+        if (!read(header + got, kStreamHeaderSize - got, n)) {
+            error = "Could not read the encrypted document.";
+            return false;
+        }
+        if (n == 0) break;
+        got += n;
+    }
+    if (got < kStreamHeaderSize) {
+        error = "The document is corrupt (the encrypted body is truncated).";
+        return false;
+    }
+
+    UltraCryptSecureBuffer key;
+    if (!DeriveStreamKey(header, password, key, error)) return false;
+
+    UltraCryptStreamParams stream;
+    stream.associatedData = associatedData;
+    stream.associatedData.insert(stream.associatedData.end(), header, header + kStreamHeaderSize);
+    auto opened = UltraCrypt_AeadOpenStream(key, stream, read, write);
+    if (!opened) {
+        // A malformed stream header and a failed tag alike: same message.
+        error = "Could not decrypt the document — the password may be incorrect, "
+                "or the file may have been altered.";
+        return false;
+    }
+    return true;
+}
+
 } // namespace UCDCrypto
 } // namespace UltraCanvas
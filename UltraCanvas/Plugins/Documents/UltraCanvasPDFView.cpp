@@ -1,7 +1,7 @@
 // Plugins/Documents/UltraCanvasPDFView.cpp
 // UI element rendering a PDF document via the IPDFDocument backend.
-// Version: 1.7.0
-// Last Modified: 2026-08-13
+// Version: 1.8.0
+// Last Modified: 2026-10-18
 // Author: UltraCanvas Framework
 
 #include "Plugins/Documents/UltraCanvasPDFView.h"
@@ -12,11 +12,17 @@
 #include "UltraCanvasMenu.h"                    // built-in context menu
 #include "UltraCanvasFileLoader.h"             // SaveFileDialog for extract/export
 #include "UltraCanvasClipboard.h"              // SetClipboardText for "Copy"
+#include "UltraCanvasApplication.h"            // PostToUIThread for rendered pages
 
 #include <algorithm>
+#include <cmath>
+#include <condition_variable>
 #include <cstring>
+#include <deque>
 #include <fstream>
 #include <limits>
+#include <mutex>
+#include <thread>
 
 namespace UltraCanvas {
 
@@ -43,8 +49,72 @@ ImageFormat FormatForMime(const std::string& mime) {
     if (mime == "image/vnd.adobe.photoshop") return {"psd",  "Photoshop image"};
     return {"png", "PNG image"};
 }
+
+int DpiKey(float dpi) { return static_cast<int>(dpi * 100.0f + 0.5f); }
 } // namespace
 
+// ===== Background page rendering =====
+// One worker renders queued pages in order and posts each finished pixmap to
+// the UI thread. Everything but `owner` is guarded by `mu`; `owner` is only
+// touched on the UI thread (cleared by the view's destructor, which also
+// joins the worker).
+struct UltraCanvasPDFView::PageRenderQueue {
+    struct Job {
+        std::shared_ptr<IPDFDocument> doc;
+        int page = 0;
+        float dpi = 0;
+        int dpiKey = 0;
+        uint64_t generation = 0;
+    };
+
+    UltraCanvasPDFView* owner = nullptr;
+    std::mutex mu;
+    std::condition_variable cv;
+    std::deque<Job> jobs;
+    bool busy = false;
+    Job active;             // valid while busy (its doc is not kept)
+    bool stop = false;
+    std::thread worker;
+
+    bool IsActive(int page, int dpiKey, uint64_t generation) const {
+        return busy && active.page == page && active.dpiKey == dpiKey &&
+               active.generation == generation;
+    }
+
+    static void Run(const std::shared_ptr<PageRenderQueue>& self) {
+        for (;;) {
+            Job job;
+            {
+                std::unique_lock<std::mutex> lock(self->mu);
+                self->cv.wait(lock, [&] { return self->stop || !self->jobs.empty(); });
+                if (self->stop) return;
+                job = std::move(self->jobs.front());
+                self->jobs.pop_front();
+                self->busy = true;
+                self->active = Job{nullptr, job.page, job.dpi, job.dpiKey, job.generation};
+            }
+
+            PDFRenderSettings s;
+            s.dpi = job.dpi;
+            s.zoom = 1.0f;
+            s.antialias = true;
+            s.colorMode = PDFColorMode::RGBA;
+            auto pixmap = MakePixmapFromRGBA(job.doc->RenderPage(job.page, s));
+            job.doc.reset();
+
+            auto* app = UltraCanvasApplicationBase::GetCurrent();
+            if (app) {
+                app->PostToUIThread([self, page = job.page, dpiKey = job.dpiKey,
+                                     generation = job.generation, pixmap]() {
+                    if (self->owner) self->owner->OnPageRendered(page, dpiKey, generation, pixmap);
+                });
+            }
+            std::lock_guard<std::mutex> lock(self->mu);
+            self->busy = false;
+        }
+    }
+};
+
 // ===== ctor / dtor =====
 
 UltraCanvasPDFView::UltraCanvasPDFView(const std::string& id,
@@ -53,7 +123,17 @@ UltraCanvasPDFView::UltraCanvasPDFView(const std::string& id,
     backgroundColor = style_.background;
 }
 
-UltraCanvasPDFView::~UltraCanvasPDFView() = default;
+UltraCanvasPDFView::~UltraCanvasPDFView() {
+    if (!renderQueue_) return;
+    renderQueue_->owner = nullptr;   // pixmaps still in the UI queue are dropped
+    {
+        std::lock_guard<std::mutex> lock(renderQueue_->mu);
+        renderQueue_->stop = true;
+        renderQueue_->jobs.clear();
+    }
+    renderQueue_->cv.notify_all();
+    if (renderQueue_->worker.joinable()) renderQueue_->worker.join();
+}
 
 // ===== Document =====
 
@@ -642,16 +722,23 @@ float UltraCanvasPDFView::ComputeFitScale(int contentW, int contentH,
 // ===== Caching =====
 
 void UltraCanvasPDFView::InvalidateCaches() {
-    pageCache_.clear();
-    pageCacheDpiKey_ = 0;
+    // The scale may have changed. Rendered pages stay: they are drawn scaled
+    // until the page comes back at the new dpi. Renders still queued for the
+    // old scale are dropped; the next frame queues the right ones.
     // Thumbnails are page-only (fixed size), so they survive zoom changes.
+    if (!renderQueue_) return;
+    std::lock_guard<std::mutex> lock(renderQueue_->mu);
+    renderQueue_->jobs.clear();
 }
 
 void UltraCanvasPDFView::InvalidateAllCaches() {
-    // Document (or page content/order) changed: cached thumbnails belong to
-    // the old state and must go too, or the strip keeps showing it.
+    // Document (or page content/order) changed: cached pages and thumbnails
+    // belong to the old state and must go too, or the view keeps showing it.
+    // The generation bump discards renders already in flight.
     InvalidateCaches();
+    pageCache_.clear();
     thumbCache_.clear();
+    ++renderGeneration_;
 }
 
 std::shared_ptr<UCPixmapCairo>
@@ -690,25 +777,90 @@ UltraCanvasPDFView::MakePixmapFromRGBA(const PDFRenderedPage& rp) {
 }
 
 std::shared_ptr<UCPixmapCairo>
-UltraCanvasPDFView::EnsurePageRendered(int page, float dpi) {
+UltraCanvasPDFView::PageForDisplay(int page, float dpi, bool& exact) {
+    exact = false;
     if (!doc_) return {};
-    const int dpiKey = static_cast<int>(dpi * 100.0f + 0.5f);
-    if (pageCacheDpiKey_ != dpiKey) {
-        pageCache_.clear();
-        pageCacheDpiKey_ = dpiKey;
-    }
+    const int dpiKey = DpiKey(dpi);
+    // Settled: rendered at this dpi, or failed with nothing older to show.
+    auto settled = [&](const CachedPage& e) {
+        return e.dpiKey == dpiKey || (e.failedDpiKey == dpiKey && !e.pixmap);
+    };
     auto it = pageCache_.find(page);
-    if (it != pageCache_.end()) return it->second;
-
-    PDFRenderSettings s;
-    s.dpi = dpi;
-    s.zoom = 1.0f;
-    s.antialias = true;
-    s.colorMode = PDFColorMode::RGBA;
-    PDFRenderedPage rp = doc_->RenderPage(page, s);
-    auto pm = MakePixmapFromRGBA(rp);
-    if (pm) pageCache_[page] = pm;
-    return pm;
+    if (it != pageCache_.end() &&
+        (it->second.dpiKey == dpiKey || it->second.failedDpiKey == dpiKey)) {
+        exact = settled(it->second);
+        return it->second.pixmap;
+    }
+
+    if (!UltraCanvasApplicationBase::GetCurrent()) {
+        // No event loop to deliver background results: render in place.
+        PDFRenderSettings s;
+        s.dpi = dpi;
+        s.zoom = 1.0f;
+        s.antialias = true;
+        s.colorMode = PDFColorMode::RGBA;
+        OnPageRendered(page, dpiKey, renderGeneration_,
+                       MakePixmapFromRGBA(doc_->RenderPage(page, s)));
+        it = pageCache_.find(page);
+        if (it == pageCache_.end()) return {};
+        exact = settled(it->second);
+        return it->second.pixmap;
+    }
+
+    RequestPageRenders(dpi);
+    return it != pageCache_.end() ? it->second.pixmap : nullptr;
+}
+
+void UltraCanvasPDFView::RequestPageRenders(float dpi) {
+    if (!doc_) return;
+    const int total = doc_->GetPageCount();
+    const int dpiKey = DpiKey(dpi);
+
+    // The current page first, then the ones a page turn shows next.
+    std::vector<int> wanted;
+    for (int p : {currentPage_, currentPage_ + 1, currentPage_ - 1}) {
+        if (p < 1 || p > total) continue;
+        auto it = pageCache_.find(p);
+        if (it != pageCache_.end() &&
+            (it->second.dpiKey == dpiKey || it->second.failedDpiKey == dpiKey)) continue;
+        wanted.push_back(p);
+    }
+
+    if (!renderQueue_) {
+        if (wanted.empty()) return;
+        renderQueue_ = std::make_shared<PageRenderQueue>();
+        renderQueue_->owner = this;
+        renderQueue_->worker = std::thread(&PageRenderQueue::Run, renderQueue_);
+    }
+    {
+        std::lock_guard<std::mutex> lock(renderQueue_->mu);
+        renderQueue_->jobs.clear();
+        for (int p : wanted) {
+            if (renderQueue_->IsActive(p, dpiKey, renderGeneration_)) continue;
+            renderQueue_->jobs.push_back({doc_, p, dpi, dpiKey, renderGeneration_});
+        }
+        if (renderQueue_->jobs.empty()) return;
+    }
+    renderQueue_->cv.notify_one();
+}
+
+void UltraCanvasPDFView::OnPageRendered(int page, int dpiKey, uint64_t generation,
+                                        std::shared_ptr<UCPixmapCairo> pixmap) {
+    if (generation != renderGeneration_) return;   // older document state
+    CachedPage& entry = pageCache_[page];
+    if (pixmap) {
+        entry.pixmap = std::move(pixmap);
+        entry.dpiKey = dpiKey;
+        entry.failedDpiKey = 0;
+    } else {
+        entry.failedDpiKey = dpiKey;   // keep any older rendering as preview
+    }
+    // Keep only the neighbourhood of the current page.
+    for (auto it = pageCache_.begin(); it != pageCache_.end();) {
+        if (std::abs(it->first - currentPage_) > 2) it = pageCache_.erase(it);
+        else ++it;
+    }
+    if (std::abs(page - currentPage_) <= 1) Repaint();
 }
 
 std::shared_ptr<UCPixmapCairo>
@@ -845,8 +997,22 @@ void UltraCanvasPDFView::DrawPageWithOverlays(IRenderContext* ctx,
         scrollY_ = std::clamp(scrollY_, -maxSY, maxSY);
     }
     const float renderDpi = std::max(8.0f, style_.defaultDpi * ez);
-    auto pm = EnsurePageRendered(currentPage_, renderDpi);
-    if (!pm || !pm->IsValid()) {
+    bool exact = false;
+    auto pm = PageForDisplay(currentPage_, renderDpi, exact);
+    if (pm && !pm->IsValid()) pm.reset();
+
+    // Until the page arrives at this dpi, lay it out at the size it will have
+    // and draw the older rendering (if any) scaled into that rect.
+    int pagePxW = 0, pagePxH = 0;
+    if (exact && pm) {
+        pagePxW = pm->GetWidth();
+        pagePxH = pm->GetHeight();
+    } else {
+        const PDFPageInfo pi = doc_->GetPageInfo(currentPage_);
+        pagePxW = static_cast<int>(std::lround(pi.widthPt  * renderDpi / 72.0f));
+        pagePxH = static_cast<int>(std::lround(pi.heightPt * renderDpi / 72.0f));
+    }
+    if (pagePxW <= 0 || pagePxH <= 0 || (exact && !pm)) {
         ctx->SetFillPaint(Color(220, 80, 80, 255));
         ctx->DrawText("Failed to render page " + std::to_string(currentPage_),
                       Point2Df(area.x + 24, area.y + 24));
@@ -854,8 +1020,7 @@ void UltraCanvasPDFView::DrawPageWithOverlays(IRenderContext* ctx,
         return;
     }
 
-    const Rect2Df pageRect = ComputePageDrawRect(pm->GetWidth(),
-                                                 pm->GetHeight(), area);
+    const Rect2Df pageRect = ComputePageDrawRect(pagePxW, pagePxH, area);
     pageRect_ = pageRect;   // remembered for image hit-testing in OnEvent
 
     // Drop shadow
@@ -866,8 +1031,8 @@ void UltraCanvasPDFView::DrawPageWithOverlays(IRenderContext* ctx,
     // White page underlay (in case the rendered pixmap has transparency)
     ctx->SetFillPaint(style_.pageBackground);
     ctx->FillRectangle(pageRect);
-    // The page
-    ctx->DrawPixmap(*pm, pageRect, ImageFitMode::Fill);
+    // The page (or its scaled preview; blank while the first render runs)
+    if (pm) ctx->DrawPixmap(*pm, pageRect, ImageFitMode::Fill);
 
     // Search hits
     if (!hits_.empty()) {
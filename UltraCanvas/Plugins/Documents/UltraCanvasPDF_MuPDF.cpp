@@ -1,8 +1,9 @@
 // Plugins/Documents/UltraCanvasPDF_MuPDF.cpp
 // MuPDF-backed implementation of IPDFDocument.
 // Built when ULTRACANVAS_PLUGIN_PDF and ULTRACANVAS_PDF_MUPDF are both enabled.
-// Version: 1.3.0
-// Last Modified: 2026-07-15
+// Version: 1.4.0 - cached display lists per page, tiles rasterized on a
+//                 worker pool with cloned contexts
+// Last Modified: 2026-10-18
 // Author: UltraCanvas Framework
 
 #include "Plugins/Documents/UltraCanvasPDF.h"
@@ -15,10 +16,17 @@ extern "C" {
 }
 
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
 #include <cstring>
+#include <deque>
 #include <fstream>
+#include <functional>
+#include <list>
 #include <mutex>
 #include <stdexcept>
+#include <thread>
+#include <unordered_map>
 
 namespace UltraCanvas {
 namespace {
@@ -86,6 +94,88 @@ const char* NativeImageMime(fz_context* ctx, fz_image* image) {
     }
 }
 
+// ===== Multithreaded rendering =====
+
+// MuPDF takes these locks around its shared state (resource store, glyph
+// cache, …) so contexts cloned from one base context can run on other
+// threads. They must outlive every context that uses them.
+struct FzLocks {
+    std::mutex locks[FZ_LOCK_MAX];
+};
+
+void LockFz(void* user, int lock)   { static_cast<FzLocks*>(user)->locks[lock].lock(); }
+void UnlockFz(void* user, int lock) { static_cast<FzLocks*>(user)->locks[lock].unlock(); }
+
+// Output tiles are this many device pixels square; each is one display-list
+// run on one worker, clipped to the tile.
+constexpr int kRenderTileSize = 256;
+// Pages whose display lists stay cached (least recently rendered dropped).
+constexpr size_t kMaxDisplayLists = 24;
+
+// Rasterizes display-list tiles on a few threads. Every worker owns a context
+// cloned from the document's base context; tasks receive it.
+class TileRenderPool {
+public:
+    using Task = std::function<void(fz_context*)>;
+
+    ~TileRenderPool() { Stop(); }
+
+    // Finishes the queued tasks and joins the workers.
+    void Stop() {
+        {
+            std::lock_guard<std::mutex> lock(mu_);
+            stop_ = true;
+        }
+        cv_.notify_all();
+        for (auto& t : workers_) t.join();
+        workers_.clear();
+    }
+
+    // Starts the workers on first use. `base` must be the locked base
+    // context and the caller must hold whatever serializes its use.
+    bool EnsureStarted(fz_context* base) {
+        if (!workers_.empty()) return true;
+        const int hw = static_cast<int>(std::thread::hardware_concurrency());
+        const int count = std::clamp(hw - 1, 1, 8);
+        for (int i = 0; i < count; ++i) {
+            fz_context* clone = fz_clone_context(base);
+            if (!clone) break;
+            workers_.emplace_back([this, clone]() { WorkerMain(clone); });
+        }
+        return !workers_.empty();
+    }
+
+    void Submit(Task task) {
+        {
+            std::lock_guard<std::mutex> lock(mu_);
+            tasks_.push_back(std::move(task));
+        }
+        cv_.notify_one();
+    }
+
+private:
+    void WorkerMain(fz_context* ctx) {
+        for (;;) {
+            Task task;
+            {
+                std::unique_lock<std::mutex> lock(mu_);
+                cv_.wait(lock, [this]() { return stop_ || !tasks_.empty(); });
+                if (tasks_.empty()) break;   // stopping
+                task = std::move(tasks_.front());
+                tasks_.pop_front();
+            }
+            task(ctx);
+        }
+        fz_drop_context(ctx);
+    }
+
+    std::mutex               mu_;
+    std::condition_variable  cv_;
+    std::deque<Task>         tasks_;
+    std::vector<std::thread> workers_;
+    bool                     stop_ = false;
+};
+
 } // namespace
 
 // ===== MuPDF implementation =====
@@ -150,24 +240,48 @@ public:
 private:
     // ----- helpers -----
     bool LoadDocumentInternal(fz_stream* stream, const std::string& password);
-    PDFRenderedPage RenderInternal(int pageNumber, const PDFRenderSettings& settings);
+    // Takes mu_ itself only while it needs ctx_ / doc_; the tiles are
+    // rasterized by the pool without it. Caller must NOT hold mu_.
+    // `cacheList` = false renders from a one-off display list (thumbnails:
+    // a pass over the strip would otherwise flush the pages being read).
+    PDFRenderedPage RenderInternal(int pageNumber, const PDFRenderSettings& settings,
+                                   bool cacheList = true);
+    // Display list of a 0-based page: the cached one, else a new one, cached
+    // when `cache`. Returns a reference the caller drops (with ctx_, under
+    // mu_) or nullptr. Caller holds mu_.
+    fz_display_list* AcquireDisplayList(int pageIndex, bool cache);
+    // Forget every cached display list. Caller holds mu_.
+    void DropDisplayLists();
+    // Page content changed: drop the now-stale display lists too.
+    void MarkDirty() { dirty_ = true; DropDisplayLists(); }
     // Cache of decoded stext pages — accessed via GetPageText/ExtractTextRuns/etc.
     // Returns a *new* fz_stext_page that the caller must drop, or nullptr.
     fz_stext_page* MakeStextPage(int pageNumber);
 
     mutable std::mutex      mu_;
+    std::unique_ptr<FzLocks> locks_;            // declared before ctx_: outlives it
     fz_context*             ctx_  = nullptr;
     fz_document*            doc_  = nullptr;   // generic, may not be pdf_*
     pdf_document*           pdoc_ = nullptr;   // non-null if doc_ is a PDF
     std::string             path_;
     std::vector<uint8_t>    memoryBuffer_;     // kept alive for OpenFromBytes
     bool                    dirty_ = false;
+
+    // 0-based page → display list; the list holds the LRU order, front =
+    // most recently rendered.
+    std::unordered_map<int, fz_display_list*> displayLists_;
+    std::list<int>                            displayListOrder_;
+    TileRenderPool                            tilePool_;   // destroyed before ctx_ is dropped
 };
 
 // ===== ctor/dtor =====
 
-MuPDFDocument::MuPDFDocument() {
-    ctx_ = fz_new_context(nullptr, nullptr, FZ_STORE_DEFAULT);
+MuPDFDocument::MuPDFDocument() : locks_(std::make_unique<FzLocks>()) {
+    fz_locks_context locks;
+    locks.user   = locks_.get();
+    locks.lock   = LockFz;
+    locks.unlock = UnlockFz;
+    ctx_ = fz_new_context(nullptr, &locks, FZ_STORE_DEFAULT);
     if (ctx_) {
         fz_try(ctx_) {
             fz_register_document_handlers(ctx_);
@@ -180,6 +294,7 @@ MuPDFDocument::MuPDFDocument() {
 }
 
 MuPDFDocument::~MuPDFDocument() {
+    tilePool_.Stop();   // the workers' cloned contexts go before the base one
     Close();
     if (ctx_) {
         fz_drop_context(ctx_);
@@ -316,6 +431,7 @@ void MuPDFDocument::Close() {
     // Caller may or may not hold mu_. We lock here only if doc_ is alive
     // and we own it; we accept reentrant Close() from the destructor by
     // checking doc_ first without a lock — destructor is single-threaded.
+    DropDisplayLists();
     if (doc_ && ctx_) {
         fz_drop_document(ctx_, doc_);
     }
@@ -435,13 +551,49 @@ PDFPageInfo MuPDFDocument::GetPageInfo(int pageNumber) const {
 
 // ===== Rendering =====
 
+void MuPDFDocument::DropDisplayLists() {
+    if (ctx_) {
+        for (auto& entry : displayLists_) fz_drop_display_list(ctx_, entry.second);
+    }
+    displayLists_.clear();
+    displayListOrder_.clear();
+}
+
+fz_display_list* MuPDFDocument::AcquireDisplayList(int pageIndex, bool cache) {
+    auto it = displayLists_.find(pageIndex);
+    if (it != displayLists_.end()) {
+        displayListOrder_.remove(pageIndex);
+        displayListOrder_.push_front(pageIndex);
+        return fz_keep_display_list(ctx_, it->second);
+    }
+
+    fz_display_list* list = nullptr;
+    fz_var(list);
+    fz_try(ctx_) {
+        // Same content as fz_run_page: page contents, annotations, widgets.
+        list = fz_new_display_list_from_page_number(ctx_, doc_, pageIndex);
+    } fz_catch(ctx_) {
+        list = nullptr;
+    }
+    if (!list) return nullptr;
+    if (!cache) return list;
+
+    displayLists_[pageIndex] = list;
+    displayListOrder_.push_front(pageIndex);
+    while (displayListOrder_.size() > kMaxDisplayLists) {
+        const int victim = displayListOrder_.back();
+        displayListOrder_.pop_back();
+        fz_drop_display_list(ctx_, displayLists_[victim]);
+        displayLists_.erase(victim);
+    }
+    return fz_keep_display_list(ctx_, list);
+}
+
 PDFRenderedPage MuPDFDocument::RenderInternal(int pageNumber,
-                                              const PDFRenderSettings& settings) {
+                                              const PDFRenderSettings& settings,
+                                              bool cacheList) {
     PDFRenderedPage out;
-    if (!ctx_ || !doc_) return out;
-
-    const int total = fz_count_pages(ctx_, doc_);
-    if (pageNumber < 1 || pageNumber > total) return out;
+    if (!ctx_) return out;
 
     const float dpi   = std::max(1.0f, settings.dpi);
     const float zoom  = std::max(0.01f, settings.zoom);
@@ -450,69 +602,132 @@ PDFRenderedPage MuPDFDocument::RenderInternal(int pageNumber,
     if (settings.rotationDegrees != 0) {
         ctm = fz_concat(ctm, fz_rotate(static_cast<float>(settings.rotationDegrees)));
     }
-
-    fz_pixmap* pix = nullptr;
-    fz_var(pix);
-    fz_try(ctx_) {
-        fz_colorspace* cs =
-            (settings.colorMode == PDFColorMode::Gray)
-                ? fz_device_gray(ctx_)
-                : fz_device_rgb(ctx_);
-        const int alpha = (settings.colorMode == PDFColorMode::RGBA) ? 1 : 0;
-        pix = fz_new_pixmap_from_page_number(ctx_, doc_, pageNumber - 1,
-                                             ctm, cs, alpha);
-    } fz_catch(ctx_) {
-        pix = nullptr;
+    const bool gray  = settings.colorMode == PDFColorMode::Gray;
+    const int  alpha = (settings.colorMode == PDFColorMode::RGBA) ? 1 : 0;
+    const int  n     = (gray ? 1 : 3) + alpha;
+
+    // Under the lock: the page's display list (interpreting the page content
+    // is the part that must stay on one context) and the output size.
+    fz_display_list* list = nullptr;
+    fz_irect bbox = fz_empty_irect;
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        if (!doc_) return out;
+        const int total = fz_count_pages(ctx_, doc_);
+        if (pageNumber < 1 || pageNumber > total) return out;
+        list = AcquireDisplayList(pageNumber - 1, cacheList);
+        if (!list) return out;
+        bbox = fz_round_rect(fz_transform_rect(fz_bound_display_list(ctx_, list), ctm));
+        if (fz_is_empty_irect(bbox) || !tilePool_.EnsureStarted(ctx_)) {
+            fz_drop_display_list(ctx_, list);
+            return out;
+        }
     }
-    if (!pix) return out;
-
-    const int w  = fz_pixmap_width (ctx_, pix);
-    const int h  = fz_pixmap_height(ctx_, pix);
-    const int st = fz_pixmap_stride(ctx_, pix);
-    unsigned char* samples = fz_pixmap_samples(ctx_, pix);
 
+    const int w = bbox.x1 - bbox.x0;
+    const int h = bbox.y1 - bbox.y0;
     out.width     = w;
     out.height    = h;
-    out.stride    = st;
+    out.stride    = w * n;
     out.colorMode = settings.colorMode;
-    out.pixels.assign(samples, samples + static_cast<size_t>(st) * h);
+    out.pixels.resize(static_cast<size_t>(out.stride) * h);
+
+    // Without the lock: every tile is one display-list run, clipped to the
+    // tile, drawn by a worker straight into its part of the output buffer.
+    struct Batch {
+        std::mutex              mu;
+        std::condition_variable cv;
+        int                     remaining = 0;
+        std::atomic<bool>       failed{false};
+    } batch;
+    std::vector<fz_irect> tiles;
+    for (int y = bbox.y0; y < bbox.y1; y += kRenderTileSize) {
+        for (int x = bbox.x0; x < bbox.x1; x += kRenderTileSize) {
+            tiles.push_back(fz_make_irect(x, y, std::min(x + kRenderTileSize, bbox.x1),
+                                          std::min(y + kRenderTileSize, bbox.y1)));
+        }
+    }
+    batch.remaining = static_cast<int>(tiles.size());
+
+    unsigned char* samples = out.pixels.data();
+    const int stride = out.stride;
+    for (const fz_irect& tile : tiles) {
+        tilePool_.Submit([&batch, list, ctm, tile, bbox, samples, stride, gray, alpha, n](fz_context* ctx) {
+            fz_pixmap* pix = nullptr;
+            fz_device* dev = nullptr;
+            fz_var(pix);
+            fz_var(dev);
+            fz_try(ctx) {
+                fz_colorspace* cs = gray ? fz_device_gray(ctx) : fz_device_rgb(ctx);
+                unsigned char* origin = samples + static_cast<size_t>(tile.y0 - bbox.y0) * stride +
+                                        static_cast<size_t>(tile.x0 - bbox.x0) * n;
+                pix = fz_new_pixmap_with_data(ctx, cs, tile.x1 - tile.x0, tile.y1 - tile.y0,
+                                              nullptr, alpha, stride, origin);
+                pix->x = tile.x0;
+                pix->y = tile.y0;
+                // As fz_new_pixmap_from_page_number: transparent with alpha,
+                // white without.
+                if (alpha) fz_clear_pixmap(ctx, pix);
+                else       fz_clear_pixmap_with_value(ctx, pix, 0xff);
+                dev = fz_new_draw_device(ctx, fz_identity, pix);
+                fz_run_display_list(ctx, list, dev, ctm, fz_rect_from_irect(tile), nullptr);
+                fz_close_device(ctx, dev);
+            } fz_always(ctx) {
+                fz_drop_device(ctx, dev);
+                fz_drop_pixmap(ctx, pix);   // the samples belong to the output
+            } fz_catch(ctx) {
+                batch.failed = true;
+            }
+            std::lock_guard<std::mutex> lock(batch.mu);
+            if (--batch.remaining == 0) batch.cv.notify_one();
+        });
+    }
+    {
+        std::unique_lock<std::mutex> lock(batch.mu);
+        batch.cv.wait(lock, [&batch]() { return batch.remaining == 0; });
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        fz_drop_display_list(ctx_, list);
+    }
+    if (batch.failed) return {};
 
-    // Convert RGBA → BGRA premultiplied for Cairo if requested via RGBA mode.
     // MuPDF gives us RGBA non-premultiplied; Cairo expects BGRA premultiplied
     // on little-endian. The widget that wraps this into a UCPixmap is
     // responsible for the byte-order swap; we ship raw RGBA here to keep the
     // engine renderer-agnostic.
-
-    fz_drop_pixmap(ctx_, pix);
     return out;
 }
 
 PDFRenderedPage MuPDFDocument::RenderPage(int pageNumber,
                                           const PDFRenderSettings& settings) {
-    std::lock_guard<std::mutex> lock(mu_);
     return RenderInternal(pageNumber, settings);
 }
 
 PDFRenderedPage MuPDFDocument::RenderThumbnail(int pageNumber, int maxDim) {
     if (maxDim <= 0) maxDim = 200;
-    std::lock_guard<std::mutex> lock(mu_);
+    if (!ctx_) return {};
 
     // First learn the page size so we can pick a DPI that hits maxDim on the
     // long side. Use a cheap fz_bound_page call.
-    if (!ctx_ || !doc_) return {};
-    const int total = fz_count_pages(ctx_, doc_);
-    if (pageNumber < 1 || pageNumber > total) return {};
-
-    fz_page* page = nullptr;
     fz_rect bbox = fz_empty_rect;
-    fz_var(page);
-    fz_try(ctx_) {
-        page = fz_load_page(ctx_, doc_, pageNumber - 1);
-        bbox = fz_bound_page(ctx_, page);
-    } fz_catch(ctx_) {
-        bbox = fz_empty_rect;
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        if (!doc_) return {};
+        const int total = fz_count_pages(ctx_, doc_);
+        if (pageNumber < 1 || pageNumber > total) return {};
+
+        fz_page* page = nullptr;
+        fz_var(page);
+        fz_try(ctx_) {
+            page = fz_load_page(ctx_, doc_, pageNumber - 1);
+            bbox = fz_bound_page(ctx_, page);
+        } fz_catch(ctx_) {
+            bbox = fz_empty_rect;
+        }
+        if (page) fz_drop_page(ctx_, page);
     }
-    if (page) fz_drop_page(ctx_, page);
     const float wpt = bbox.x1 - bbox.x0;
     const float hpt = bbox.y1 - bbox.y0;
     if (wpt <= 0 || hpt <= 0) return {};
@@ -525,7 +740,7 @@ PDFRenderedPage MuPDFDocument::RenderThumbnail(int pageNumber, int maxDim) {
     s.zoom = 1.0f;
     s.antialias = true;
     s.colorMode = PDFColorMode::RGBA;
-    return RenderInternal(pageNumber, s);
+    return RenderInternal(pageNumber, s, false);
 }
 
 // ===== Text =====
@@ -792,7 +1007,7 @@ bool MuPDFDocument::DeletePage(int pageNumber) {
     } fz_catch(ctx_) {
         ok = false;
     }
-    if (ok) dirty_ = true;
+    if (ok) MarkDirty();
     return ok;
 }
 
@@ -822,7 +1037,7 @@ bool MuPDFDocument::MovePage(int fromPage, int toPage) {
     } fz_catch(ctx_) {
         ok = false;
     }
-    if (ok) dirty_ = true;
+    if (ok) MarkDirty();
     return ok;
 }
 
@@ -856,7 +1071,7 @@ bool MuPDFDocument::InsertBlankPage(int at, float widthPt, float heightPt) {
     if (resources) pdf_drop_obj(ctx_, resources);
     if (contents)  fz_drop_buffer(ctx_, contents);
     if (page)      pdf_drop_obj(ctx_, page);
-    if (ok) dirty_ = true;
+    if (ok) MarkDirty();
     return ok;
 }
 
@@ -931,7 +1146,7 @@ bool MuPDFDocument::MergeFrom(IPDFDocument& other,
             ok = false;
         }
         if (gmap) pdf_drop_graft_map(ctx_, gmap);
-        if (ok) dirty_ = true;
+        if (ok) MarkDirty();
         return ok;
     }
 
@@ -974,7 +1189,7 @@ bool MuPDFDocument::MergeFrom(IPDFDocument& other,
     if (gmap)   pdf_drop_graft_map(ctx_, gmap);
     if (tmpDoc) fz_drop_document(ctx_, tmpDoc);
     if (stream) fz_drop_stream(ctx_, stream);
-    if (ok) dirty_ = true;
+    if (ok) MarkDirty();
     return ok;
 }
 
@@ -1004,7 +1219,7 @@ bool MuPDFDocument::AddTextAnnotation(int pageNumber, const Rect2Df& at,
     }
     if (annot) pdf_drop_annot(ctx_, annot);
     if (page)  fz_drop_page(ctx_, &page->super);
-    if (ok) dirty_ = true;
+    if (ok) MarkDirty();
     return ok;
 }
 
@@ -1033,7 +1248,7 @@ bool MuPDFDocument::RedactRect(int pageNumber, const Rect2Df& area) {
     }
     if (annot) pdf_drop_annot(ctx_, annot);
     if (page)  fz_drop_page(ctx_, &page->super);
-    if (ok) dirty_ = true;
+    if (ok) MarkDirty();
     return ok;
 }
 
@@ -1082,7 +1297,7 @@ bool MuPDFDocument::ReplaceText(const PDFTextRun& target,
     if (freetext) pdf_drop_annot(ctx_, freetext);
     if (redact)   pdf_drop_annot(ctx_, redact);
     if (page)     fz_drop_page(ctx_, &page->super);
-    if (ok) dirty_ = true;
+    if (ok) MarkDirty();
     return ok;
 }
 
@@ -1106,7 +1321,7 @@ bool MuPDFDocument::ApplyPendingRedactions(int pageNumber) {
         ok = false;
     }
     if (page) fz_drop_page(ctx_, &page->super);
-    if (ok) dirty_ = true;
+    if (ok) MarkDirty();
     return ok;
 }
 
@@ -1171,7 +1386,7 @@ bool MuPDFDocument::DeleteAnnotation(int pageNumber, int indexOnPage) {
         ok = false;
     }
     if (page) fz_drop_page(ctx_, &page->super);
-    if (ok) dirty_ = true;
+    if (ok) MarkDirty();
     return ok;
 }
 
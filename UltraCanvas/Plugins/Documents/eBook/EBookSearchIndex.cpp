@@ -0,0 +1,544 @@
+// Plugins/Documents/eBook/EBookSearchIndex.cpp
+// Inverted full-text index over a book's chapter text — see the header for
+// the word rules and the query syntax.
+// Version: 1.0.0
+// Last Modified: 2026-10-18
+// Author: UltraCanvas Framework
+
+#include "EBookSearchIndex.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <queue>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+
+namespace fs = std::filesystem;
+
+namespace UltraCanvas {
+
+namespace {
+
+constexpr char kMagic[8] = {'U', 'C', 'E', 'B', 'I', 'X', '0', '1'};
+constexpr uint32_t kFormatVersion = 2;        // 2: CJK characters are words of their own
+
+std::mutex gCacheMutex;
+std::string gCacheOverride;
+std::atomic<bool> gCacheEnabled{true};
+
+inline char Fold(char c) {
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+inline bool IsContinuationByte(char c) {
+    return (static_cast<unsigned char>(c) & 0xC0) == 0x80;
+}
+
+enum class CharKind {
+    Separator,      // ASCII punctuation / space, CJK punctuation
+    Word,           // part of a run: ASCII letters / digits, other non-ASCII
+    Single,         // a word by itself: scripts written without spaces
+};
+
+// Ideographs, kana and Hangul: every character is indexed on its own, so a
+// term in the middle of a sentence is a phrase of single characters.
+inline bool IsSingleCharWord(uint32_t cp) {
+    return (cp >= 0x3040 && cp <= 0x30FF) ||        // hiragana, katakana
+           (cp >= 0x3400 && cp <= 0x4DBF) ||        // CJK extension A
+           (cp >= 0x4E00 && cp <= 0x9FFF) ||        // CJK unified ideographs
+           (cp >= 0xAC00 && cp <= 0xD7AF) ||        // Hangul syllables
+           (cp >= 0xF900 && cp <= 0xFAFF) ||        // CJK compatibility
+           (cp >= 0xFF66 && cp <= 0xFF9F) ||        // halfwidth katakana
+           (cp >= 0x20000 && cp <= 0x3FFFF);        // CJK extensions B+
+}
+
+inline bool IsCJKPunctuation(uint32_t cp) {
+    return (cp >= 0x3000 && cp <= 0x303F) ||        // 、。「」 ...
+           (cp >= 0xFF01 && cp <= 0xFF0F) || (cp >= 0xFF1A && cp <= 0xFF20) ||
+           (cp >= 0xFF3B && cp <= 0xFF40) || (cp >= 0xFF5B && cp <= 0xFF65);
+}
+
+// Kind of the character at text[i]; `length` gets its byte length. Bytes
+// that are not valid UTF-8 count as word bytes of length 1.
+CharKind Classify(const std::string& text, size_t i, size_t& length) {
+    const unsigned char c = static_cast<unsigned char>(text[i]);
+    length = 1;
+    if (c < 0x80) {
+        const bool alnum = (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') ||
+                           (c >= 'A' && c <= 'Z');
+        return alnum ? CharKind::Word : CharKind::Separator;
+    }
+    size_t n = 0;
+    uint32_t cp = 0;
+    if ((c & 0xE0) == 0xC0) { n = 2; cp = c & 0x1F; }
+    else if ((c & 0xF0) == 0xE0) { n = 3; cp = c & 0x0F; }
+    else if ((c & 0xF8) == 0xF0) { n = 4; cp = c & 0x07; }
+    if (n == 0 || i + n > text.size()) return CharKind::Word;
+    for (size_t k = 1; k < n; ++k) {
+        if (!IsContinuationByte(text[i + k])) return CharKind::Word;
+        cp = (cp << 6) | (static_cast<unsigned char>(text[i + k]) & 0x3F);
+    }
+    length = n;
+    if (IsSingleCharWord(cp)) return CharKind::Single;
+    if (IsCJKPunctuation(cp)) return CharKind::Separator;
+    return CharKind::Word;
+}
+
+// End of the word starting at `start`.
+size_t WordEnd(const std::string& text, size_t start) {
+    size_t length = 0;
+    if (start >= text.size() || Classify(text, start, length) == CharKind::Separator) return start;
+    if (Classify(text, start, length) == CharKind::Single) return start + length;
+    size_t i = start;
+    while (i < text.size() && Classify(text, i, length) == CharKind::Word) i += length;
+    return i;
+}
+
+// Calls fn(start, length) for every word of `text`.
+template <typename Fn>
+void ForEachWord(const std::string& text, Fn&& fn) {
+    const size_t n = text.size();
+    size_t i = 0;
+    size_t length = 0;
+    while (i < n) {
+        if (Classify(text, i, length) == CharKind::Separator) {
+            i += length;
+            continue;
+        }
+        const size_t end = WordEnd(text, i);
+        fn(i, end - i);
+        i = end;
+    }
+}
+
+// ---- serialization ----
+
+class Writer {
+public:
+    void U32(uint32_t v) { Bytes(&v, sizeof(v)); }
+    void Str(const std::string& s) {
+        U32(static_cast<uint32_t>(s.size()));
+        Bytes(s.data(), s.size());
+    }
+    void Bytes(const void* p, size_t n) { out.append(static_cast<const char*>(p), n); }
+    std::string out;
+};
+
+class Reader {
+public:
+    Reader(const std::string& data) : data(data) {}
+    bool U32(uint32_t& v) { return Bytes(&v, sizeof(v)); }
+    bool Str(std::string& s) {
+        uint32_t n = 0;
+        if (!U32(n) || n > data.size() - pos) return false;
+        s.assign(data, pos, n);
+        pos += n;
+        return true;
+    }
+    bool Bytes(void* p, size_t n) {
+        if (n > data.size() - pos) return false;
+        std::memcpy(p, data.data() + pos, n);
+        pos += n;
+        return true;
+    }
+    // Guards vector sizes read from the file against what is left of it.
+    bool Fits(uint64_t count, size_t elementSize) const {
+        return count <= (data.size() - pos) / elementSize;
+    }
+    bool AtEnd() const { return pos == data.size(); }
+
+private:
+    const std::string& data;
+    size_t pos = 0;
+};
+
+} // namespace
+
+// ============================================================================
+// BUILD
+// ============================================================================
+
+void EBookSearchIndex::Build(int chapterCount,
+                             const std::function<std::string(int)>& chapterText,
+                             unsigned threads) {
+    Clear();
+    const int n = std::max(chapterCount, 0);
+    chapters.resize(static_cast<size_t>(n));
+
+    // Per chapter: folded term -> word numbers, filled by the workers.
+    std::vector<std::unordered_map<std::string, std::vector<uint32_t>>> local(
+            static_cast<size_t>(n));
+    std::atomic<int> next{0};
+    auto work = [&]() {
+        for (int i = next++; i < n; i = next++) {
+            Chapter& chapter = chapters[static_cast<size_t>(i)];
+            chapter.text = chapterText(i);
+            auto& words = local[static_cast<size_t>(i)];
+            std::string term;
+            ForEachWord(chapter.text, [&](size_t start, size_t length) {
+                term.assign(chapter.text, start, length);
+                for (char& c : term) c = Fold(c);
+                words[term].push_back(static_cast<uint32_t>(chapter.wordStarts.size()));
+                chapter.wordStarts.push_back(static_cast<uint32_t>(start));
+            });
+        }
+    };
+
+    if (threads == 0) threads = std::max(1u, std::min(8u, std::thread::hardware_concurrency()));
+    threads = std::min<unsigned>(threads, static_cast<unsigned>(std::max(n, 1)));
+    std::vector<std::thread> workers;
+    for (unsigned t = 1; t < threads; ++t) workers.emplace_back(work);
+    work();
+    for (auto& w : workers) w.join();
+
+    // Merge in chapter order, so each term's postings come out sorted.
+    std::unordered_map<std::string, std::vector<Posting>> merged;
+    for (int i = 0; i < n; ++i) {
+        for (auto& [term, words] : local[static_cast<size_t>(i)]) {
+            auto& list = merged[term];
+            list.reserve(list.size() + words.size());
+            for (uint32_t w : words) list.push_back({static_cast<uint32_t>(i), w});
+        }
+        local[static_cast<size_t>(i)].clear();
+    }
+
+    terms.reserve(merged.size());
+    for (auto& entry : merged) terms.push_back(entry.first);
+    std::sort(terms.begin(), terms.end());
+    termPostings.reserve(terms.size() + 1);
+    for (const auto& term : terms) {
+        termPostings.push_back(static_cast<uint32_t>(postings.size()));
+        const auto& list = merged[term];
+        postings.insert(postings.end(), list.begin(), list.end());
+    }
+    termPostings.push_back(static_cast<uint32_t>(postings.size()));
+    built = true;
+}
+
+void EBookSearchIndex::Clear() {
+    built = false;
+    chapters.clear();
+    terms.clear();
+    termPostings.clear();
+    postings.clear();
+}
+
+size_t EBookSearchIndex::WordLength(const Chapter& chapter, uint32_t word) const {
+    const size_t start = chapter.wordStarts[word];
+    return WordEnd(chapter.text, start) - start;
+}
+
+// ============================================================================
+// SEARCH
+// ============================================================================
+
+std::vector<EBookSearchResult> EBookSearchIndex::Search(const std::string& query,
+                                                        bool caseSensitive,
+                                                        size_t maxResults) const {
+    std::vector<EBookSearchResult> results;
+    if (!built || maxResults == 0) return results;
+
+    struct QueryWord {
+        std::string raw;
+        std::string folded;
+        bool prefix = false;
+    };
+    std::vector<QueryWord> words;
+    ForEachWord(query, [&](size_t start, size_t length) {
+        QueryWord w;
+        w.raw = query.substr(start, length);
+        w.folded = w.raw;
+        for (char& c : w.folded) c = Fold(c);
+        w.prefix = start + length < query.size() && query[start + length] == '*';
+        words.push_back(std::move(w));
+    });
+    if (words.empty()) return results;
+    // Unquoted, the query is found anywhere a substring search would find
+    // it: the first word may also start inside a word ("ing" finds
+    // "running"), and must then end that word when more words follow.
+    const bool exact = query.find('"') != std::string::npos;
+    if (!exact) words.back().prefix = true;
+    const QueryWord& first = words.front();
+
+    // Offsets where the first query word matches inside `word` (a folded
+    // term, or the text of a word in a chapter).
+    auto firstOffsets = [&](std::string_view word, std::string_view needle,
+                            std::vector<size_t>& offsets) {
+        offsets.clear();
+        if (word.size() < needle.size()) return;
+        if (exact) {
+            if (word.compare(0, needle.size(), needle) == 0 &&
+                (first.prefix || word.size() == needle.size())) {
+                offsets.push_back(0);
+            }
+        } else if (first.prefix) {
+            // Non-overlapping, as the old substring scan counted them.
+            for (size_t pos = word.find(needle); pos != std::string_view::npos;
+                 pos = word.find(needle, pos + needle.size())) {
+                offsets.push_back(pos);
+            }
+        } else if (word.compare(word.size() - needle.size(), needle.size(), needle) == 0) {
+            offsets.push_back(word.size() - needle.size());
+        }
+    };
+
+    // Candidates: postings of every term the first word matches.
+    std::vector<size_t> candidates;
+    std::vector<size_t> offsets;
+    if (exact) {
+        auto it = std::lower_bound(terms.begin(), terms.end(), first.folded);
+        for (; it != terms.end() && it->compare(0, first.folded.size(), first.folded) == 0; ++it) {
+            firstOffsets(*it, first.folded, offsets);
+            if (!offsets.empty()) candidates.push_back(static_cast<size_t>(it - terms.begin()));
+            if (!first.prefix) break;
+        }
+    } else {
+        for (size_t t = 0; t < terms.size(); ++t) {
+            firstOffsets(terms[t], first.folded, offsets);
+            if (!offsets.empty()) candidates.push_back(t);
+        }
+    }
+    if (candidates.empty()) return results;
+
+    auto matchesWord = [&](const Chapter& chapter, uint32_t word, const QueryWord& q) {
+        if (word >= chapter.wordStarts.size()) return false;
+        const size_t start = chapter.wordStarts[word];
+        const size_t length = WordLength(chapter, word);
+        if (q.prefix ? length < q.raw.size() : length != q.raw.size()) return false;
+        if (caseSensitive) return chapter.text.compare(start, q.raw.size(), q.raw) == 0;
+        for (size_t k = 0; k < q.folded.size(); ++k) {
+            if (Fold(chapter.text[start + k]) != q.folded[k]) return false;
+        }
+        return true;
+    };
+
+    std::string folded;
+    auto emit = [&](const Posting& p) {
+        const Chapter& chapter = chapters[p.chapter];
+        const std::string& text = chapter.text;
+        for (size_t i = 1; i < words.size(); ++i) {
+            if (!matchesWord(chapter, p.word + static_cast<uint32_t>(i), words[i])) return;
+        }
+        const size_t wordStart = chapter.wordStarts[p.word];
+        const std::string_view word(text.data() + wordStart, WordLength(chapter, p.word));
+        if (caseSensitive) {
+            firstOffsets(word, first.raw, offsets);
+        } else {
+            folded.assign(word);
+            for (char& c : folded) c = Fold(c);
+            firstOffsets(folded, first.folded, offsets);
+        }
+
+        for (size_t offset : offsets) {
+            if (results.size() >= maxResults) return;
+            const size_t start = wordStart + offset;
+            const size_t end = (words.size() == 1
+                                ? start
+                                : chapter.wordStarts[p.word + words.size() - 1]) +
+                               words.back().raw.size();
+
+            // Snippet bounds move to character boundaries.
+            size_t before = start > kSnippetContext ? start - kSnippetContext : 0;
+            while (before < start && IsContinuationByte(text[before])) ++before;
+            size_t after = std::min(text.size(), end + kSnippetContext);
+            while (after > end && after < text.size() && IsContinuationByte(text[after])) --after;
+
+            EBookSearchResult result;
+            result.chapterIndex = static_cast<int>(p.chapter);
+            result.offsetInPage = static_cast<int>(start);
+            result.matchedText = text.substr(start, end - start);
+            result.contextBefore = text.substr(before, start - before);
+            result.contextAfter = text.substr(end, after - end);
+            results.push_back(std::move(result));
+        }
+    };
+
+    // k-way merge of the candidate lists in reading order, stopping once
+    // enough matches are found (a one-letter prefix can cover most postings).
+    struct Cursor {
+        const Posting* at;
+        const Posting* end;
+    };
+    auto later = [](const Cursor& a, const Cursor& b) {
+        return a.at->chapter != b.at->chapter ? a.at->chapter > b.at->chapter
+                                              : a.at->word > b.at->word;
+    };
+    std::priority_queue<Cursor, std::vector<Cursor>, decltype(later)> heap(later);
+    for (size_t t : candidates) {
+        if (termPostings[t] == termPostings[t + 1]) continue;
+        heap.push({postings.data() + termPostings[t], postings.data() + termPostings[t + 1]});
+    }
+    while (!heap.empty() && results.size() < maxResults) {
+        Cursor c = heap.top();
+        heap.pop();
+        emit(*c.at);
+        if (++c.at != c.end) heap.push(c);
+    }
+    return results;
+}
+
+// ============================================================================
+// PERSISTENCE
+// ============================================================================
+
+bool EBookSearchIndex::Save(const std::string& path, const std::string& key) const {
+    if (!built) return false;
+
+    Writer w;
+    w.Bytes(kMagic, sizeof(kMagic));
+    w.U32(kFormatVersion);
+    w.Str(key);
+    w.U32(static_cast<uint32_t>(chapters.size()));
+    for (const auto& chapter : chapters) {
+        w.Str(chapter.text);
+        w.U32(static_cast<uint32_t>(chapter.wordStarts.size()));
+        w.Bytes(chapter.wordStarts.data(), chapter.wordStarts.size() * sizeof(uint32_t));
+    }
+    w.U32(static_cast<uint32_t>(terms.size()));
+    for (const auto& term : terms) w.Str(term);
+    w.Bytes(termPostings.data(), termPostings.size() * sizeof(uint32_t));
+    w.U32(static_cast<uint32_t>(postings.size()));
+    for (const auto& p : postings) {
+        w.U32(p.chapter);
+        w.U32(p.word);
+    }
+
+    std::error_code ec;
+    const fs::path target(path);
+    if (target.has_parent_path()) fs::create_directories(target.parent_path(), ec);
+    const std::string temp = path + ".tmp" +
+            std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+    {
+        std::ofstream f(temp, std::ios::binary | std::ios::trunc);
+        if (!f.is_open()) return false;
+        f.write(w.out.data(), static_cast<std::streamsize>(w.out.size()));
+        if (!f.good()) {
+            f.close();
+            fs::remove(temp, ec);
+            return false;
+        }
+    }
+    fs::rename(temp, target, ec);
+    if (ec) {
+        fs::remove(temp, ec);
+        return false;
+    }
+    return true;
+}
+
+bool EBookSearchIndex::Load(const std::string& path, const std::string& key) {
+    Clear();
+    std::ifstream f(path, std::ios::binary);
+    if (!f.is_open()) return false;
+    const std::string data((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
+
+    Reader r(data);
+    char magic[sizeof(kMagic)];
+    uint32_t version = 0;
+    std::string fileKey;
+    if (!r.Bytes(magic, sizeof(magic)) || std::memcmp(magic, kMagic, sizeof(kMagic)) != 0 ||
+        !r.U32(version) || version != kFormatVersion || !r.Str(fileKey) || fileKey != key) {
+        return false;
+    }
+
+    auto fail = [this]() {
+        Clear();
+        return false;
+    };
+
+    uint32_t chapterCount = 0;
+    if (!r.U32(chapterCount) || !r.Fits(chapterCount, 2 * sizeof(uint32_t))) return fail();
+    chapters.resize(chapterCount);
+    for (auto& chapter : chapters) {
+        uint32_t wordCount = 0;
+        if (!r.Str(chapter.text) || !r.U32(wordCount) || !r.Fits(wordCount, sizeof(uint32_t))) {
+            return fail();
+        }
+        chapter.wordStarts.resize(wordCount);
+        if (!r.Bytes(chapter.wordStarts.data(), wordCount * sizeof(uint32_t))) return fail();
+        for (uint32_t start : chapter.wordStarts) {
+            if (start >= chapter.text.size()) return fail();
+        }
+    }
+
+    uint32_t termCount = 0;
+    if (!r.U32(termCount) || !r.Fits(termCount, sizeof(uint32_t))) return fail();
+    terms.resize(termCount);
+    for (auto& term : terms) {
+        if (!r.Str(term)) return fail();
+    }
+    termPostings.resize(static_cast<size_t>(termCount) + 1);
+    if (!r.Bytes(termPostings.data(), termPostings.size() * sizeof(uint32_t))) return fail();
+
+    uint32_t postingCount = 0;
+    if (!r.U32(postingCount) || !r.Fits(postingCount, 2 * sizeof(uint32_t))) return fail();
+    postings.resize(postingCount);
+    for (auto& p : postings) {
+        if (!r.U32(p.chapter) || !r.U32(p.word)) return fail();
+        if (p.chapter >= chapterCount || p.word >= chapters[p.chapter].wordStarts.size()) return fail();
+    }
+    if (!r.AtEnd() || termPostings.front() != 0 || termPostings.back() != postingCount ||
+        !std::is_sorted(termPostings.begin(), termPostings.end())) {
+        return fail();
+    }
+    built = true;
+    return true;
+}
+
+std::string EBookSearchIndex::ContentKey(const uint8_t* data, size_t size) {
+    uint64_t hash = 0xcbf29ce484222325ull;
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= data[i];
+        hash *= 0x100000001b3ull;
+    }
+    char buf[48];
+    std::snprintf(buf, sizeof(buf), "%016llx-%llx", static_cast<unsigned long long>(hash),
+                  static_cast<unsigned long long>(size));
+    return buf;
+}
+
+// ============================================================================
+// CACHE LOCATION
+// ============================================================================
+
+void EBookSearchIndex::SetCacheDirectory(const std::string& directory) {
+    std::lock_guard<std::mutex> lock(gCacheMutex);
+    gCacheOverride = directory;
+}
+
+std::string EBookSearchIndex::GetCacheDirectory() {
+    {
+        std::lock_guard<std::mutex> lock(gCacheMutex);
+        if (!gCacheOverride.empty()) return gCacheOverride;
+    }
+#ifdef _WIN32
+    if (const char* local = std::getenv("LOCALAPPDATA"); local && *local)
+        return std::string(local) + "\\ultracanvas\\ebook-index";
+    return {};
+#else
+    if (const char* xdg = std::getenv("XDG_CACHE_HOME"); xdg && *xdg == '/')
+        return std::string(xdg) + "/ultracanvas/ebook-index";
+    if (const char* home = std::getenv("HOME"); home && *home)
+        return std::string(home) + "/.cache/ultracanvas/ebook-index";
+    return {};
+#endif
+}
+
+void EBookSearchIndex::SetCacheEnabled(bool enabled) { gCacheEnabled = enabled; }
+
+bool EBookSearchIndex::IsCacheEnabled() { return gCacheEnabled; }
+
+std::string EBookSearchIndex::CachePathFor(const std::string& key) {
+    const std::string dir = GetCacheDirectory();
+    if (dir.empty() || key.empty()) return {};
+    return (fs::path(dir) / (key + ".idx")).string();
+}
+
+} // namespace UltraCanvas
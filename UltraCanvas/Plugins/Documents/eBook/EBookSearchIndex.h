@@ -0,0 +1,99 @@
+// Plugins/Documents/eBook/EBookSearchIndex.h
+// Inverted full-text index over a book's chapter text, persisted per book.
+//
+// EBookEngineBase builds one on the first search (chapters extracted in
+// parallel) and keeps it on disk keyed by a hash of the book file, so later
+// opens of the same book search without touching chapter HTML at all.
+// Version: 1.0.0
+// Last Modified: 2026-10-18
+// Author: UltraCanvas Framework
+#pragma once
+
+#include "UltraCanvasEBookTypes.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace UltraCanvas {
+
+// Words are runs of ASCII letters/digits and non-ASCII (UTF-8) characters,
+// except that every ideograph, kana and Hangul syllable is a word of its own
+// (those scripts do not separate words by spaces). They are indexed
+// ASCII-case-folded. Every word occurrence is a posting (chapter, word
+// number), so a phrase is a run of consecutive word numbers.
+//
+// Query syntax:
+//   lazy dog       found wherever a plain substring search would find it:
+//                  the first word may start inside a word ("ing" finds
+//                  "running"), the last may end inside one ("do" finds
+//                  "dogs"), so a search box works while typing
+//   "lazy dog"     exact phrase: whole words only
+//   laz* do*       '*' makes any word a prefix
+// Punctuation between words is ignored ("lazy, dog" matches "lazy dog").
+// Case-sensitive searches compare the original text of each matched word.
+class EBookSearchIndex {
+public:
+    static constexpr size_t kDefaultMaxResults = 500;
+    static constexpr size_t kSnippetContext = 60;    // bytes either side
+
+    // Indexes `chapterCount` chapters. `chapterText` returns a chapter's
+    // plain text and is called concurrently from up to `threads` workers
+    // (0 = hardware concurrency, capped at 8).
+    void Build(int chapterCount, const std::function<std::string(int)>& chapterText,
+               unsigned threads = 0);
+    void Clear();
+    bool IsBuilt() const { return built; }
+
+    // Matches in reading order (chapter, then offset), at most `maxResults`.
+    // chapterTitle is left for the caller to fill in.
+    std::vector<EBookSearchResult> Search(const std::string& query,
+                                          bool caseSensitive = false,
+                                          size_t maxResults = kDefaultMaxResults) const;
+
+    int GetChapterCount() const { return static_cast<int>(chapters.size()); }
+    size_t GetTermCount() const { return terms.size(); }
+    size_t GetPostingCount() const { return postings.size(); }
+
+    // ===== PERSISTENCE =====
+    // `key` identifies the book (see ContentKey); Load fails on a key or
+    // format mismatch and on a damaged file. Save writes through a temp file
+    // + rename so a reader never sees a partial index.
+    bool Save(const std::string& path, const std::string& key) const;
+    bool Load(const std::string& path, const std::string& key);
+
+    // Hex FNV-1a 64 of the bytes plus their length.
+    static std::string ContentKey(const uint8_t* data, size_t size);
+
+    // $XDG_CACHE_HOME/ultracanvas/ebook-index (~/.cache/... when unset,
+    // %LOCALAPPDATA%\ultracanvas\ebook-index on Windows). Overridable, e.g.
+    // for tests; an empty override restores the default. SetCacheEnabled(false)
+    // keeps indexes in memory only.
+    static void SetCacheDirectory(const std::string& directory);
+    static std::string GetCacheDirectory();
+    static void SetCacheEnabled(bool enabled);
+    static bool IsCacheEnabled();
+    static std::string CachePathFor(const std::string& key);
+
+private:
+    struct Chapter {
+        std::string text;
+        std::vector<uint32_t> wordStarts;   // byte offset of each word
+    };
+    struct Posting {
+        uint32_t chapter;
+        uint32_t word;
+    };
+
+    bool built = false;
+    std::vector<Chapter> chapters;
+    std::vector<std::string> terms;         // sorted, folded
+    std::vector<uint32_t> termPostings;     // terms.size() + 1 offsets into postings
+    std::vector<Posting> postings;          // per term, in reading order
+
+    size_t WordLength(const Chapter& chapter, uint32_t word) const;
+};
+
+} // namespace UltraCanvas
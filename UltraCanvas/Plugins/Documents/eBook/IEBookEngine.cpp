@@ -1,8 +1,8 @@
 // Plugins/Documents/eBook/IEBookEngine.cpp
 // Shared engine functionality: file loading, text extraction, search,
 // and the extension → engine registry.
-// Version: 2.0.0
-// Last Modified: 2026-07-02
+// Version: 2.1.0
+// Last Modified: 2026-10-18
 // Author: UltraCanvas Framework
 
 #include "IEBookEngine.h"
@@ -42,8 +42,12 @@ bool EBookEngineBase::LoadFromFile(const std::string& filePath,
         return false;
     }
 
+    // LoadFromMemory starts with Close(), so the file's identity is set after.
+    const std::string key = EBookSearchIndex::ContentKey(data.data(), data.size());
+    if (!LoadFromMemory(std::move(data), password)) return false;
     documentPath = filePath;
-    return LoadFromMemory(std::move(data), password);
+    contentKey = key;
+    return true;
 }
 
 void EBookEngineBase::ResetBaseState() {
@@ -52,6 +56,9 @@ void EBookEngineBase::ResetBaseState() {
     documentPath.clear();
     metadata = EBookMetadata();
     tableOfContents.clear();
+    contentKey.clear();
+    std::lock_guard<std::mutex> lock(searchIndexMutex);
+    searchIndex.Clear();
 }
 
 void EBookEngineBase::Close() {
@@ -90,48 +97,36 @@ int EBookEngineBase::GetChapterIndexForHref(const std::string& href) const {
     return found;
 }
 
-std::vector<EBookSearchResult> EBookEngineBase::Search(const std::string& query,
-                                                       bool caseSensitive) const {
-    std::vector<EBookSearchResult> results;
-    if (query.empty() || !loaded) return results;
-
-    auto fold = [caseSensitive](std::string s) {
-        if (!caseSensitive) {
-            std::transform(s.begin(), s.end(), s.begin(), [](unsigned char c) {
-                return static_cast<char>(std::tolower(c));
-            });
-        }
-        return s;
-    };
-    const std::string needle = fold(query);
+void EBookEngineBase::PrepareSearchIndex() const {
+    if (!loaded) return;
+    std::lock_guard<std::mutex> lock(searchIndexMutex);
+    if (searchIndex.IsBuilt()) return;
 
     const int chapters = GetChapterCount();
-    for (int chapter = 0; chapter < chapters; ++chapter) {
-        std::string text = ExtractChapterText(chapter);
-        std::string haystack = fold(text);
-
-        size_t pos = 0;
-        while ((pos = haystack.find(needle, pos)) != std::string::npos) {
-            EBookSearchResult result;
-            result.chapterIndex = chapter;
-            result.offsetInPage = static_cast<int>(pos);
-            result.matchedText = text.substr(pos, query.size());
-
-            const size_t kContext = 60;
-            size_t before = pos > kContext ? pos - kContext : 0;
-            size_t afterEnd = std::min(text.size(), pos + query.size() + kContext);
-            result.contextBefore = text.substr(before, pos - before);
-            result.contextAfter = text.substr(pos + query.size(),
-                                              afterEnd - pos - query.size());
-
-            if (chapter < static_cast<int>(tableOfContents.size())) {
-                result.chapterTitle = tableOfContents[chapter].title;
-            }
+    const bool cache = EBookSearchIndex::IsCacheEnabled() && !contentKey.empty();
+    const std::string cachePath = cache ? EBookSearchIndex::CachePathFor(contentKey) : std::string();
+    if (!cachePath.empty() && searchIndex.Load(cachePath, contentKey) &&
+        searchIndex.GetChapterCount() == chapters) {
+        return;
+    }
 
-            results.push_back(std::move(result));
-            pos += query.size();
+    searchIndex.Build(chapters, [this](int index) { return ExtractChapterText(index); });
+    if (!cachePath.empty()) searchIndex.Save(cachePath, contentKey);
+}
 
-            if (results.size() >= 500) return results;   // sanity cap
+std::vector<EBookSearchResult> EBookEngineBase::Search(const std::string& query,
+                                                       bool caseSensitive) const {
+    if (query.empty() || !loaded) return {};
+    PrepareSearchIndex();
+
+    std::vector<EBookSearchResult> results;
+    {
+        std::lock_guard<std::mutex> lock(searchIndexMutex);
+        results = searchIndex.Search(query, caseSensitive);
+    }
+    for (auto& result : results) {
+        if (result.chapterIndex < static_cast<int>(tableOfContents.size())) {
+            result.chapterTitle = tableOfContents[result.chapterIndex].title;
         }
     }
     return results;
@@ -6,16 +6,18 @@
 // is NOT the engine's job: the viewer feeds chapter XHTML into
 // HTML::ElementBuilder, which produces native UltraCanvas elements laid out
 // by the CSSLayout engine.
-// Version: 2.0.0
-// Last Modified: 2026-07-02
+// Version: 2.1.0
+// Last Modified: 2026-10-18
 // Author: UltraCanvas Framework
 #pragma once
 
 #include "UltraCanvasEBookTypes.h"
+#include "EBookSearchIndex.h"
 
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -78,8 +80,11 @@ public:
 
     // ===== TEXT / SEARCH =====
     // Plain text of a chapter (for search and accessibility). Engines get a
-    // tag-stripping default via EBookEngineBase.
+    // tag-stripping default via EBookEngineBase. Must be safe to call from
+    // several threads at once: the search index extracts chapters in parallel.
     virtual std::string ExtractChapterText(int index) const = 0;
+    // Query syntax: see EBookSearchIndex (unquoted queries match like a
+    // substring search, quoted ones whole words; '*' makes a word a prefix).
     virtual std::vector<EBookSearchResult> Search(const std::string& query,
                                                   bool caseSensitive = false) const = 0;
 
@@ -97,8 +102,8 @@ protected:
 // BASE IMPLEMENTATION
 // ============================================================================
 // Owns the common state and provides file loading, tag-stripping text
-// extraction, and a chapter-walking substring search. Engines implement
-// LoadFromMemory + the content accessors.
+// extraction, and indexed search. Engines implement LoadFromMemory + the
+// content accessors.
 
 class EBookEngineBase : public IEBookEngine {
 public:
@@ -126,6 +131,13 @@ public:
     std::vector<EBookSearchResult> Search(const std::string& query,
                                           bool caseSensitive = false) const override;
 
+    // Makes the search index ready: loads it from the on-disk cache when the
+    // book was opened from a file indexed before, otherwise builds it (and
+    // stores it). Search calls this on first use; a viewer may call it from a
+    // worker thread right after loading, as long as it does not Close() the
+    // engine meanwhile.
+    void PrepareSearchIndex() const;
+
 protected:
     bool loaded = false;
     std::string lastError;
@@ -133,6 +145,11 @@ protected:
     EBookMetadata metadata;
     std::vector<EBookTOCEntry> tableOfContents;
 
+    // Identifies the book file for the index cache (empty for memory loads).
+    std::string contentKey;
+    mutable std::mutex searchIndexMutex;
+    mutable EBookSearchIndex searchIndex;
+
     void Fail(const std::string& error) { lastError = error; }
 
     // Shared "close" for the base members; engines call it from Close().
@@ -0,0 +1,363 @@
+// Plugins/Models/STL/UltraCanvasMeshDecimator.cpp
+// Quadric-error-metric mesh simplification and LOD chains for the STL viewer
+// Version: 1.0.0
+// Last Modified: 2026-10-18
+// Author: UltraCanvas Framework
+
+#include "UltraCanvasMeshDecimator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <utility>
+
+namespace UltraCanvas {
+
+namespace {
+
+    // Boundary planes outweigh face planes so open borders don't shrink.
+    constexpr double kBoundaryWeight = 10.0;
+    constexpr uint32_t kCancelPollInterval = 4096;
+
+    // Symmetric 4x4 error quadric, upper triangle:
+    // a00 a01 a02 a03 a11 a12 a13 a22 a23 a33
+    struct Quadric {
+        double q[10] = {};
+
+        static Quadric FromPlane(double nx, double ny, double nz, double d, double weight) {
+            Quadric r;
+            r.q[0] = weight * nx * nx; r.q[1] = weight * nx * ny; r.q[2] = weight * nx * nz;
+            r.q[3] = weight * nx * d;  r.q[4] = weight * ny * ny; r.q[5] = weight * ny * nz;
+            r.q[6] = weight * ny * d;  r.q[7] = weight * nz * nz; r.q[8] = weight * nz * d;
+            r.q[9] = weight * d * d;
+            return r;
+        }
+
+        void Add(const Quadric& o) {
+            for (int i = 0; i < 10; ++i) q[i] += o.q[i];
+        }
+
+        Quadric operator+(const Quadric& o) const {
+            Quadric r = *this;
+            r.Add(o);
+            return r;
+        }
+
+        double Error(const Vec3& p) const {
+            const double x = p.x, y = p.y, z = p.z;
+            return q[0] * x * x + 2 * q[1] * x * y + 2 * q[2] * x * z + 2 * q[3] * x +
+                   q[4] * y * y + 2 * q[5] * y * z + 2 * q[6] * y +
+                   q[7] * z * z + 2 * q[8] * z + q[9];
+        }
+
+        // Position minimising the error; false when the system is singular
+        // (flat or linear neighbourhoods).
+        bool Minimum(Vec3& out) const {
+            const double a = q[0], b = q[1], c = q[2], d = q[4], e = q[5], f = q[7];
+            const double det = a * (d * f - e * e) - b * (b * f - e * c) + c * (b * e - d * c);
+            const double scale = std::abs(a) + std::abs(d) + std::abs(f);
+            if (scale <= 0.0 || std::abs(det) <= 1e-12 * scale * scale * scale) return false;
+            const double rx = -q[3], ry = -q[6], rz = -q[8];
+            const double inv = 1.0 / det;
+            out.x = static_cast<float>(inv * (rx * (d * f - e * e) - b * (ry * f - e * rz) + c * (ry * e - d * rz)));
+            out.y = static_cast<float>(inv * (a * (ry * f - e * rz) - rx * (b * f - e * c) + c * (b * rz - ry * c)));
+            out.z = static_cast<float>(inv * (a * (d * rz - ry * e) - b * (b * rz - ry * c) + rx * (b * e - d * c)));
+            return std::isfinite(out.x) && std::isfinite(out.y) && std::isfinite(out.z);
+        }
+    };
+
+    // Heap entry. `stamp` is the sum of both vertices' versions when the
+    // entry was pushed; versions only grow, so a changed sum means stale.
+    struct EdgeEntry {
+        float cost;
+        uint32_t u;
+        uint32_t v;
+        uint32_t stamp;
+        bool operator>(const EdgeEntry& o) const { return cost > o.cost; }
+    };
+
+    class Simplifier {
+    public:
+        explicit Simplifier(const Mesh3D& mesh) : mesh_(mesh) {}
+
+        bool Run(size_t targetTriangles, Mesh3D& out, const std::atomic<bool>* cancel);
+
+    private:
+        const Mesh3D& mesh_;
+        std::vector<Vec3> pos_;
+        std::vector<Quadric> quadric_;
+        std::vector<uint32_t> root_;        // merged-into vertex (self for live vertices)
+        std::vector<uint32_t> chainNext_;   // circular list of vertices merged into a root
+        std::vector<uint32_t> version_;
+        std::vector<uint32_t> vertexMark_;
+        std::vector<uint32_t> faceOffset_;  // CSR: original vertex -> faces
+        std::vector<uint32_t> faceList_;
+        std::vector<uint32_t> faceMark_;
+        std::vector<uint8_t> faceAlive_;
+        std::vector<EdgeEntry> heap_;
+        uint32_t mark_ = 0;
+        size_t liveFaces_ = 0;
+
+        uint32_t Find(uint32_t v) {
+            while (root_[v] != v) {
+                root_[v] = root_[root_[v]];
+                v = root_[v];
+            }
+            return v;
+        }
+
+        // Visits each live face around root `v` once per mark (callers bump mark_).
+        template <typename Fn>
+        void ForEachFace(uint32_t v, Fn&& fn) {
+            uint32_t w = v;
+            do {
+                for (uint32_t i = faceOffset_[w]; i < faceOffset_[w + 1]; ++i) {
+                    const uint32_t f = faceList_[i];
+                    if (!faceAlive_[f] || faceMark_[f] == mark_) continue;
+                    faceMark_[f] = mark_;
+                    fn(f);
+                }
+                w = chainNext_[w];
+            } while (w != v);
+        }
+
+        void Corners(uint32_t f, uint32_t c[3]) {
+            for (int k = 0; k < 3; ++k) c[k] = Find(mesh_.indices[f * 3 + k]);
+        }
+
+        Vec3 Target(const Quadric& q, uint32_t u, uint32_t v) const {
+            const Vec3 mid = (pos_[u] + pos_[v]) * 0.5f;
+            Vec3 best;
+            if (q.Minimum(best)) {
+                // Near-singular systems can throw the optimum far away.
+                const Vec3 edge = pos_[u] - pos_[v];
+                const Vec3 off = best - mid;
+                if (off.Dot(off) <= 4.0f * edge.Dot(edge)) return best;
+            }
+            best = mid;
+            double bestError = q.Error(mid);
+            for (const Vec3& p : {pos_[u], pos_[v]}) {
+                const double e = q.Error(p);
+                if (e < bestError) { bestError = e; best = p; }
+            }
+            return best;
+        }
+
+        void PushEdge(uint32_t u, uint32_t v) {
+            const Quadric q = quadric_[u] + quadric_[v];
+            const double cost = std::max(0.0, q.Error(Target(q, u, v)));
+            heap_.push_back({static_cast<float>(cost), u, v, version_[u] + version_[v]});
+            std::push_heap(heap_.begin(), heap_.end(), std::greater<>());
+        }
+
+        bool FlipsAFace(uint32_t u, uint32_t v, const Vec3& target);
+        void Collapse(uint32_t u, uint32_t v, const Vec3& target, const Quadric& q);
+        void Init();
+        void Emit(Mesh3D& out);
+    };
+
+    void Simplifier::Init() {
+        const uint32_t vertexCount = static_cast<uint32_t>(mesh_.positions.size());
+        const uint32_t faceCount = static_cast<uint32_t>(mesh_.indices.size() / 3);
+        pos_ = mesh_.positions;
+        quadric_.assign(vertexCount, Quadric{});
+        root_.resize(vertexCount);
+        chainNext_.resize(vertexCount);
+        for (uint32_t v = 0; v < vertexCount; ++v) root_[v] = chainNext_[v] = v;
+        version_.assign(vertexCount, 0);
+        vertexMark_.assign(vertexCount, 0);
+        faceMark_.assign(faceCount, 0);
+        faceAlive_.assign(faceCount, 1);
+
+        faceOffset_.assign(vertexCount + 1, 0);
+        for (uint32_t idx : mesh_.indices) ++faceOffset_[idx + 1];
+        for (uint32_t v = 0; v < vertexCount; ++v) faceOffset_[v + 1] += faceOffset_[v];
+        faceList_.resize(mesh_.indices.size());
+        std::vector<uint32_t> fill(faceOffset_.begin(), faceOffset_.end() - 1);
+
+        struct EdgeRef { uint64_t key; uint32_t face; };
+        std::vector<EdgeRef> edges;
+        edges.reserve(mesh_.indices.size());
+
+        liveFaces_ = 0;
+        for (uint32_t f = 0; f < faceCount; ++f) {
+            const uint32_t* tri = &mesh_.indices[f * 3];
+            for (int k = 0; k < 3; ++k) faceList_[fill[tri[k]]++] = f;
+            if (tri[0] == tri[1] || tri[1] == tri[2] || tri[0] == tri[2]) {
+                faceAlive_[f] = 0;
+                continue;
+            }
+            ++liveFaces_;
+            const Vec3& p0 = pos_[tri[0]];
+            const Vec3 n = (pos_[tri[1]] - p0).Cross(pos_[tri[2]] - p0);
+            const double len = n.Length();
+            if (len > 0.0) {
+                const double nx = n.x / len, ny = n.y / len, nz = n.z / len;
+                const double d = -(nx * p0.x + ny * p0.y + nz * p0.z);
+                const Quadric q = Quadric::FromPlane(nx, ny, nz, d, len * 0.5);
+                for (int k = 0; k < 3; ++k) quadric_[tri[k]].Add(q);
+            }
+            for (int k = 0; k < 3; ++k) {
+                const uint32_t a = std::min(tri[k], tri[(k + 1) % 3]);
+                const uint32_t b = std::max(tri[k], tri[(k + 1) % 3]);
+                edges.push_back({(static_cast<uint64_t>(a) << 32) | b, f});
+            }
+        }
+        std::sort(edges.begin(), edges.end(),
+                  [](const EdgeRef& x, const EdgeRef& y) { return x.key < y.key; });
+
+        heap_.clear();
+        heap_.reserve(edges.size());
+        for (size_t i = 0; i < edges.size();) {
+            size_t j = i + 1;
+            while (j < edges.size() && edges[j].key == edges[i].key) ++j;
+            const uint32_t a = static_cast<uint32_t>(edges[i].key >> 32);
+            const uint32_t b = static_cast<uint32_t>(edges[i].key);
+            if (j - i == 1) {
+                // Boundary edge: plane through the edge, perpendicular to its face.
+                const uint32_t* tri = &mesh_.indices[edges[i].face * 3];
+                const Vec3 faceNormal = (pos_[tri[1]] - pos_[tri[0]]).Cross(pos_[tri[2]] - pos_[tri[0]]);
+                const Vec3 edge = pos_[b] - pos_[a];
+                const Vec3 n = edge.Cross(faceNormal).Normalized();
+                if (n.Length() > 0.0f) {
+                    const double d = -n.Dot(pos_[a]);
+                    const Quadric q = Quadric::FromPlane(n.x, n.y, n.z, d,
+                                                         kBoundaryWeight * edge.Dot(edge));
+                    quadric_[a].Add(q);
+                    quadric_[b].Add(q);
+                }
+            }
+            i = j;
+        }
+        for (size_t i = 0; i < edges.size();) {
+            size_t j = i + 1;
+            while (j < edges.size() && edges[j].key == edges[i].key) ++j;
+            const uint32_t a = static_cast<uint32_t>(edges[i].key >> 32);
+            const uint32_t b = static_cast<uint32_t>(edges[i].key);
+            const Quadric q = quadric_[a] + quadric_[b];
+            heap_.push_back({static_cast<float>(std::max(0.0, q.Error(Target(q, a, b)))), a, b, 0});
+            i = j;
+        }
+        std::make_heap(heap_.begin(), heap_.end(), std::greater<>());
+    }
+
+    bool Simplifier::FlipsAFace(uint32_t u, uint32_t v, const Vec3& target) {
+        ++mark_;
+        bool flips = false;
+        auto check = [&](uint32_t f) {
+            if (flips) return;
+            uint32_t c[3];
+            Corners(f, c);
+            const bool hasU = c[0] == u || c[1] == u || c[2] == u;
+            const bool hasV = c[0] == v || c[1] == v || c[2] == v;
+            if (hasU && hasV) return;   // removed by the collapse
+            Vec3 before[3], after[3];
+            for (int k = 0; k < 3; ++k) {
+                before[k] = pos_[c[k]];
+                after[k] = (c[k] == u || c[k] == v) ? target : before[k];
+            }
+            const Vec3 n0 = (before[1] - before[0]).Cross(before[2] - before[0]);
+            const Vec3 n1 = (after[1] - after[0]).Cross(after[2] - after[0]);
+            if (n0.Dot(n1) <= 0.0f) flips = true;
+        };
+        ForEachFace(u, check);
+        ForEachFace(v, check);
+        return flips;
+    }
+
+    void Simplifier::Collapse(uint32_t u, uint32_t v, const Vec3& target, const Quadric& q) {
+        root_[v] = u;
+        std::swap(chainNext_[u], chainNext_[v]);    // splice the two circles
+        pos_[u] = target;
+        quadric_[u] = q;
+        ++version_[u];
+
+        ++mark_;
+        const uint32_t neighbourMark = mark_;
+        ForEachFace(u, [&](uint32_t f) {
+            uint32_t c[3];
+            Corners(f, c);
+            if (c[0] == c[1] || c[1] == c[2] || c[0] == c[2]) {
+                faceAlive_[f] = 0;
+                --liveFaces_;
+                return;
+            }
+            for (uint32_t w : c) {
+                if (w == u || vertexMark_[w] == neighbourMark) continue;
+                vertexMark_[w] = neighbourMark;
+                PushEdge(u, w);
+            }
+        });
+    }
+
+    void Simplifier::Emit(Mesh3D& out) {
+        out.Clear();
+        out.name = mesh_.name;
+        std::vector<uint32_t> remap(pos_.size(), UINT32_MAX);
+        for (uint32_t f = 0; f < faceAlive_.size(); ++f) {
+            if (!faceAlive_[f]) continue;
+            uint32_t c[3];
+            Corners(f, c);
+            for (uint32_t v : c) {
+                if (remap[v] == UINT32_MAX) {
+                    remap[v] = static_cast<uint32_t>(out.positions.size());
+                    out.positions.push_back(pos_[v]);
+                }
+                out.indices.push_back(remap[v]);
+            }
+        }
+        if (!mesh_.normals.empty()) out.RecomputeNormals();
+        out.ComputeBounds();
+    }
+
+    bool Simplifier::Run(size_t targetTriangles, Mesh3D& out, const std::atomic<bool>* cancel) {
+        Init();
+        uint32_t pops = 0;
+        while (liveFaces_ > targetTriangles && !heap_.empty()) {
+            if (++pops % kCancelPollInterval == 0 && cancel && cancel->load(std::memory_order_relaxed)) {
+                return false;
+            }
+            std::pop_heap(heap_.begin(), heap_.end(), std::greater<>());
+            const EdgeEntry e = heap_.back();
+            heap_.pop_back();
+            if (root_[e.u] != e.u || root_[e.v] != e.v ||
+                version_[e.u] + version_[e.v] != e.stamp) {
+                continue;   // stale
+            }
+            const Quadric q = quadric_[e.u] + quadric_[e.v];
+            const Vec3 target = Target(q, e.u, e.v);
+            if (FlipsAFace(e.u, e.v, target)) continue;
+            Collapse(e.u, e.v, target, q);
+        }
+        Emit(out);
+        return true;
+    }
+
+} // anonymous namespace
+
+bool UltraCanvasMeshDecimator::Decimate(const Mesh3D& in, size_t targetTriangles, Mesh3D& out,
+                                        const std::atomic<bool>* cancel) {
+    if (in.TriangleCount() <= targetTriangles || in.Empty()) {
+        out = in;
+        return true;
+    }
+    Simplifier simplifier(in);
+    return simplifier.Run(targetTriangles, out, cancel);
+}
+
+std::vector<Mesh3D> UltraCanvasMeshDecimator::BuildLODs(const Mesh3D& mesh, size_t triangleBudget,
+                                                        const std::atomic<bool>* cancel) {
+    std::vector<Mesh3D> levels;
+    auto current = [&]() -> const Mesh3D& { return levels.empty() ? mesh : levels.back(); };
+    while (current().TriangleCount() > triangleBudget) {
+        const size_t triangles = current().TriangleCount();
+        Mesh3D next;
+        if (!Decimate(current(), std::max(triangleBudget, triangles / 4), next, cancel)) break;
+        // Stalled (nothing left that collapses without flipping): give up.
+        if (next.TriangleCount() * 10 > triangles * 9) break;
+        levels.push_back(std::move(next));
+    }
+    return levels;
+}
+
+} // namespace UltraCanvas
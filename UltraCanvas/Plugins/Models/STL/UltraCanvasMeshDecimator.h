@@ -0,0 +1,44 @@
+// Plugins/Models/STL/UltraCanvasMeshDecimator.h
+// Quadric-error-metric mesh simplification and LOD chains for the STL viewer
+// Version: 1.0.0
+// Last Modified: 2026-10-18
+// Author: UltraCanvas Framework
+#pragma once
+
+#ifndef ULTRACANVAS_MESH_DECIMATOR_H
+#define ULTRACANVAS_MESH_DECIMATOR_H
+
+#include "UltraCanvas3DTypes.h"
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace UltraCanvas {
+
+// ===== MESH DECIMATOR =====
+// Edge-collapse simplification after Garland & Heckbert: each vertex carries
+// the area-weighted quadric of its faces' planes, the cheapest edge is
+// collapsed to the position minimising the summed quadric, and collapses that
+// would flip a face are rejected. Open borders are kept in place by extra
+// perpendicular planes on boundary edges.
+//
+// Needs an indexed (welded) mesh - a raw STL triangle soup has no shared
+// edges to collapse; see UltraCanvasSTLLoader::WeldVertices.
+    class UltraCanvasMeshDecimator {
+    public:
+        // Simplifies `in` towards `targetTriangles` into `out`. Stops early when
+        // no further collapse is valid. Returns false only when cancelled
+        // (`cancel` is polled periodically and may be null).
+        static bool Decimate(const Mesh3D& in, size_t targetTriangles, Mesh3D& out,
+                             const std::atomic<bool>* cancel = nullptr);
+
+        // Progressively coarser levels, each about a quarter of the previous
+        // one, ending with the first level that fits `triangleBudget`. Empty
+        // when `mesh` already fits. Returns what was built so far on cancel.
+        static std::vector<Mesh3D> BuildLODs(const Mesh3D& mesh, size_t triangleBudget,
+                                             const std::atomic<bool>* cancel = nullptr);
+    };
+
+} // namespace UltraCanvas
+
+#endif // ULTRACANVAS_MESH_DECIMATOR_H
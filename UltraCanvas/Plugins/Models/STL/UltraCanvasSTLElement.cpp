@@ -1,15 +1,18 @@
 // Plugins/Models/STL/UltraCanvasSTLElement.cpp
 // Implementation of the STL viewer element (GL viewer + non-GL fallback)
-// Version: 1.0.0
-// Last Modified: 2026-06-21
+// Version: 1.1.0
+// Last Modified: 2026-10-18
 // Author: UltraCanvas Framework
 
 #include "UltraCanvasSTLElement.h"
+#include "UltraCanvasMeshDecimator.h"
+#include "UltraCanvasApplication.h"   // PostToUIThread for finished LODs
 #include "UltraCanvasDebug.h"
 
 #include <cmath>
 #include <string>
 #include <vector>
+#include <utility>
 
 // GL headers must live at global scope (not inside namespace UltraCanvas).
 // Include strategy matches libspecific/GL/GLFramebuffer.cpp.
@@ -39,23 +42,25 @@ namespace {
     const char* kVertexShader =
         "#version 330 core\n"
         "layout(location = 0) in vec3 aPos;\n"
-        "layout(location = 1) in vec3 aNormal;\n"
         "uniform mat4 uMVP;\n"
         "uniform mat4 uModel;\n"
-        "out vec3 vNormal;\n"
+        "out vec3 vPos;\n"
         "void main() {\n"
         "    gl_Position = uMVP * vec4(aPos, 1.0);\n"
-        "    vNormal = mat3(uModel) * aNormal;\n"
+        "    vPos = (uModel * vec4(aPos, 1.0)).xyz;\n"
         "}\n";
 
+    // Flat shading: the face normal comes from screen-space derivatives of
+    // the position, so welded meshes need no per-vertex normals and keep
+    // STL's hard edges.
     const char* kFragmentShader =
         "#version 330 core\n"
-        "in vec3 vNormal;\n"
+        "in vec3 vPos;\n"
         "uniform vec3 uLightDir;\n"
         "uniform vec3 uColor;\n"
         "out vec4 FragColor;\n"
         "void main() {\n"
-        "    vec3 N = normalize(vNormal);\n"
+        "    vec3 N = normalize(cross(dFdx(vPos), dFdy(vPos)));\n"
         "    vec3 L = normalize(uLightDir);\n"
         "    float diff = abs(dot(N, L));\n"   // two-sided shading
         "    float ambient = 0.28;\n"
@@ -105,32 +110,76 @@ UltraCanvasSTLElement::UltraCanvasSTLElement(const std::string& identifier,
     SetRenderMode(RenderMode::OnDemand);
 }
 
-UltraCanvasSTLElement::~UltraCanvasSTLElement() = default;
+UltraCanvasSTLElement::~UltraCanvasSTLElement() {
+    alive_->store(false);
+    StopLODBuild();
+}
 
 bool UltraCanvasSTLElement::LoadFromFile(const std::string& filePath) {
     Mesh3D mesh;
     std::string error;
-    if (!UltraCanvasSTLLoader::Load(filePath, mesh, &error)) {
+    // Welded so the decimator has shared edges; normals are not needed by
+    // the flat-shading shader.
+    STLLoadOptions options;
+    options.weld = true;
+    options.computeNormals = false;
+    if (!UltraCanvasSTLLoader::Load(filePath, mesh, options, &error)) {
         if (onLoadError) onLoadError(error);
         debugOutput << "[STL] Load failed: " << error << std::endl;
         return false;
     }
-    SetMesh(mesh);
+    SetMesh(std::move(mesh));
     if (onLoadComplete) onLoadComplete();
     return true;
 }
 
-void UltraCanvasSTLElement::SetMesh(const Mesh3D& mesh) {
-    mesh_ = mesh;
-    if (!mesh_.bounds.IsValid()) mesh_.ComputeBounds();
+void UltraCanvasSTLElement::SetMesh(Mesh3D mesh) {
+    StopLODBuild();
+    if (!mesh.bounds.IsValid()) mesh.ComputeBounds();
+    mesh_ = std::make_shared<const Mesh3D>(std::move(mesh));
+    lods_.clear();
     meshDirty_ = true;
+    coarseDirty_ = true;
     ResetCameraToFit();
+    StartLODBuild();
     RequestRender();
 }
 
+void UltraCanvasSTLElement::StartLODBuild() {
+    const uint64_t generation = ++lodGeneration_;
+    if (mesh_->TriangleCount() <= lodBudget_) return;
+
+    auto cancel = std::make_shared<std::atomic<bool>>(false);
+    lodCancel_ = cancel;
+    UltraCanvasApplicationBase* app = UltraCanvasApplicationBase::GetCurrent();
+    if (!app) {
+        lods_ = UltraCanvasMeshDecimator::BuildLODs(*mesh_, lodBudget_, cancel.get());
+        coarseDirty_ = true;
+        return;
+    }
+    lodThread_ = std::thread([this, app, mesh = mesh_, budget = lodBudget_, cancel,
+                              aliveFlag = alive_, generation]() {
+        auto levels = std::make_shared<std::vector<Mesh3D>>(
+                UltraCanvasMeshDecimator::BuildLODs(*mesh, budget, cancel.get()));
+        if (cancel->load() || !aliveFlag->load()) return;
+        app->PostToUIThread([this, aliveFlag, generation, levels]() {
+            if (!aliveFlag->load() || generation != lodGeneration_) return;
+            lods_ = std::move(*levels);
+            coarseDirty_ = true;
+            RequestRender();
+        });
+    });
+}
+
+void UltraCanvasSTLElement::StopLODBuild() {
+    if (lodCancel_) lodCancel_->store(true);
+    if (lodThread_.joinable()) lodThread_.join();
+    lodCancel_.reset();
+}
+
 bool UltraCanvasSTLElement::SaveToFile(const std::string& filePath, STLFormat format,
                                        std::string* outError) const {
-    return UltraCanvasSTLLoader::Save(filePath, mesh_, format, outError);
+    return UltraCanvasSTLLoader::Save(filePath, *mesh_, format, outError);
 }
 
 void UltraCanvasSTLElement::SetAutoRotate(bool enable) {
@@ -163,57 +212,68 @@ void UltraCanvasSTLElement::OnGLInit() {
         uColor_ = glGetUniformLocation(program_, "uColor");
     }
 
-    glGenVertexArrays(1, &vao_);
-    glGenBuffers(1, &vboPositions_);
-    glGenBuffers(1, &vboNormals_);
-    glGenBuffers(1, &ebo_);
-
     glReady_ = (program_ != 0);
     meshDirty_ = true;
+    coarseDirty_ = true;
 }
 
-void UltraCanvasSTLElement::UploadMesh() {
-    if (!glReady_ || mesh_.Empty()) {
-        indexCount_ = 0;
-        meshDirty_ = false;
+void UltraCanvasSTLElement::UploadMesh(GPUMesh& gpu, const Mesh3D& mesh) {
+    if (!glReady_ || mesh.Empty()) {
+        gpu.indexCount = 0;
         return;
     }
+    if (!gpu.vao) {
+        glGenVertexArrays(1, &gpu.vao);
+        glGenBuffers(1, &gpu.vboPositions);
+        glGenBuffers(1, &gpu.ebo);
+    }
 
-    glBindVertexArray(vao_);
+    glBindVertexArray(gpu.vao);
 
-    glBindBuffer(GL_ARRAY_BUFFER, vboPositions_);
+    glBindBuffer(GL_ARRAY_BUFFER, gpu.vboPositions);
     glBufferData(GL_ARRAY_BUFFER,
-                 static_cast<GLsizeiptr>(mesh_.positions.size() * sizeof(Vec3)),
-                 mesh_.positions.data(), GL_STATIC_DRAW);
+                 static_cast<GLsizeiptr>(mesh.positions.size() * sizeof(Vec3)),
+                 mesh.positions.data(), GL_STATIC_DRAW);
     glEnableVertexAttribArray(0);
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vec3), (void*)0);
 
-    glBindBuffer(GL_ARRAY_BUFFER, vboNormals_);
-    glBufferData(GL_ARRAY_BUFFER,
-                 static_cast<GLsizeiptr>(mesh_.normals.size() * sizeof(Vec3)),
-                 mesh_.normals.data(), GL_STATIC_DRAW);
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vec3), (void*)0);
-
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo_);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, gpu.ebo);
     glBufferData(GL_ELEMENT_ARRAY_BUFFER,
-                 static_cast<GLsizeiptr>(mesh_.indices.size() * sizeof(uint32_t)),
-                 mesh_.indices.data(), GL_STATIC_DRAW);
+                 static_cast<GLsizeiptr>(mesh.indices.size() * sizeof(uint32_t)),
+                 mesh.indices.data(), GL_STATIC_DRAW);
 
     glBindVertexArray(0);
 
-    indexCount_ = static_cast<int>(mesh_.indices.size());
-    meshDirty_ = false;
+    gpu.indexCount = static_cast<int>(mesh.indices.size());
+}
+
+void UltraCanvasSTLElement::DeleteGPUMesh(GPUMesh& gpu) {
+    if (gpu.ebo) glDeleteBuffers(1, &gpu.ebo);
+    if (gpu.vboPositions) glDeleteBuffers(1, &gpu.vboPositions);
+    if (gpu.vao) glDeleteVertexArrays(1, &gpu.vao);
+    gpu = GPUMesh{};
 }
 
 void UltraCanvasSTLElement::OnGLRender(const RenderSurfaceInfo& info) {
-    if (meshDirty_) UploadMesh();
+    if (meshDirty_) {
+        UploadMesh(fullMesh_, *mesh_);
+        meshDirty_ = false;
+    }
+    if (coarseDirty_) {
+        if (lods_.empty()) {
+            DeleteGPUMesh(coarseMesh_);
+        } else {
+            UploadMesh(coarseMesh_, lods_.back());
+        }
+        coarseDirty_ = false;
+    }
 
     glViewport(0, 0, info.width, info.height);
     glClearColor(0.12f, 0.13f, 0.16f, 1.0f);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-    if (!glReady_ || indexCount_ == 0) return;
+    const GPUMesh& gpu = (IsInteracting() && coarseMesh_.indexCount > 0) ? coarseMesh_ : fullMesh_;
+    if (!glReady_ || gpu.indexCount == 0) return;
 
     glEnable(GL_DEPTH_TEST);
 
@@ -222,8 +282,9 @@ void UltraCanvasSTLElement::OnGLRender(const RenderSurfaceInfo& info) {
     }
 
     // Model space: center the mesh at the origin and normalize its size.
-    Vec3 center = mesh_.bounds.Center();
-    float radius = mesh_.bounds.Radius();
+    // Bounds of the full mesh, so switching levels never shifts the model.
+    Vec3 center = mesh_->bounds.Center();
+    float radius = mesh_->bounds.Radius();
     float invR = (radius > 1e-6f) ? (1.0f / radius) : 1.0f;
 
     Mat4 normModel = Mat4::Scale(invR) * Mat4::Translation(-center.x, -center.y, -center.z);
@@ -245,17 +306,15 @@ void UltraCanvasSTLElement::OnGLRender(const RenderSurfaceInfo& info) {
     glUniform3f(uLightDir_, 0.4f, 0.7f, 1.0f);
     glUniform3f(uColor_, modelColor_.x, modelColor_.y, modelColor_.z);
 
-    glBindVertexArray(vao_);
-    glDrawElements(GL_TRIANGLES, indexCount_, GL_UNSIGNED_INT, nullptr);
+    glBindVertexArray(gpu.vao);
+    glDrawElements(GL_TRIANGLES, gpu.indexCount, GL_UNSIGNED_INT, nullptr);
     glBindVertexArray(0);
     glUseProgram(0);
 }
 
 void UltraCanvasSTLElement::OnGLCleanup() {
-    if (ebo_) { glDeleteBuffers(1, &ebo_); ebo_ = 0; }
-    if (vboNormals_) { glDeleteBuffers(1, &vboNormals_); vboNormals_ = 0; }
-    if (vboPositions_) { glDeleteBuffers(1, &vboPositions_); vboPositions_ = 0; }
-    if (vao_) { glDeleteVertexArrays(1, &vao_); vao_ = 0; }
+    DeleteGPUMesh(coarseMesh_);
+    DeleteGPUMesh(fullMesh_);
     if (program_) { glDeleteProgram(program_); program_ = 0; }
     glReady_ = false;
 }
@@ -273,6 +332,8 @@ bool UltraCanvasSTLElement::OnEvent(const UCEvent& event) {
         case UCEventType::MouseUp:
             if (event.button == UCMouseButton::Left) {
                 dragging_ = false;
+                // Back to the full-detail mesh.
+                RequestRender();
                 return true;
             }
             break;
@@ -320,13 +381,13 @@ bool UltraCanvasSTLElement::LoadFromFile(const std::string& filePath) {
         if (onLoadError) onLoadError(error);
         return false;
     }
-    SetMesh(mesh);
+    SetMesh(std::move(mesh));
     if (onLoadComplete) onLoadComplete();
     return true;
 }
 
-void UltraCanvasSTLElement::SetMesh(const Mesh3D& mesh) {
-    mesh_ = mesh;
+void UltraCanvasSTLElement::SetMesh(Mesh3D mesh) {
+    mesh_ = std::move(mesh);
     if (!mesh_.bounds.IsValid()) mesh_.ComputeBounds();
 }
 
@@ -3,8 +3,12 @@
 // When built with ULTRACANVAS_ENABLE_GL it renders a shaded 3D model on a
 // UltraCanvasGLSurface with mouse-orbit; otherwise it falls back to a 2D
 // info placeholder so the plugin still builds and loads data everywhere.
-// Version: 1.0.0
-// Last Modified: 2026-06-21
+//
+// Loaded meshes are welded and shaded flat per face. Meshes over the LOD
+// triangle budget get decimated levels built on a worker thread; the
+// coarsest one is drawn while the model is being dragged or auto-rotates.
+// Version: 1.1.0
+// Last Modified: 2026-10-18
 // Author: UltraCanvas Framework
 #pragma once
 
@@ -13,9 +17,12 @@
 
 #include "UltraCanvas3DTypes.h"
 #include "UltraCanvasSTLLoader.h"
+#include <atomic>
 #include <string>
 #include <memory>
 #include <functional>
+#include <thread>
+#include <vector>
 
 #ifdef ULTRACANVAS_ENABLE_GL
     #include "UltraCanvasGLSurface.h"
@@ -36,8 +43,15 @@ namespace UltraCanvas {
 
         // Load mesh data (parsing is done elsewhere by UltraCanvasSTLLoader).
         bool LoadFromFile(const std::string& filePath);
-        void SetMesh(const Mesh3D& mesh);
-        const Mesh3D& GetMesh() const { return mesh_; }
+        void SetMesh(Mesh3D mesh);
+        const Mesh3D& GetMesh() const { return *mesh_; }
+
+        // Meshes above this many triangles get decimated levels for
+        // interaction (default 300k). Applies to the next SetMesh/LoadFromFile.
+        void SetLODTriangleBudget(size_t triangles) { lodBudget_ = triangles; }
+        size_t GetLODTriangleBudget() const { return lodBudget_; }
+        // Levels built so far (0 while building or when the mesh fits the budget).
+        size_t GetLODCount() const { return lods_.size(); }
 
         // Save the currently loaded mesh back to disk.
         bool SaveToFile(const std::string& filePath,
@@ -60,10 +74,24 @@ namespace UltraCanvas {
         void OnGLCleanup() override;
 
     private:
-        void UploadMesh();        // (re)build GPU buffers from mesh_
+        // GPU copy of one mesh level.
+        struct GPUMesh {
+            unsigned int vao = 0;
+            unsigned int vboPositions = 0;
+            unsigned int ebo = 0;
+            int indexCount = 0;
+        };
+
+        void UploadMesh(GPUMesh& gpu, const Mesh3D& mesh);
+        void DeleteGPUMesh(GPUMesh& gpu);
         void ResetCameraToFit();  // frame the model based on its bounds
+        void StartLODBuild();
+        void StopLODBuild();
+        bool IsInteracting() const { return dragging_ || autoRotate_; }
 
-        Mesh3D mesh_;
+        std::shared_ptr<const Mesh3D> mesh_ = std::make_shared<Mesh3D>();
+        std::vector<Mesh3D> lods_;  // finest to coarsest
+        size_t lodBudget_ = 300000;
         Vec3 modelColor_{0.78f, 0.80f, 0.85f};
 
         // Camera / orbit state.
@@ -78,15 +106,19 @@ namespace UltraCanvas {
         int lastMouseX_ = 0;
         int lastMouseY_ = 0;
 
+        // Background LOD build; results are posted back to the UI thread.
+        std::thread lodThread_;
+        std::shared_ptr<std::atomic<bool>> lodCancel_;
+        std::shared_ptr<std::atomic<bool>> alive_ = std::make_shared<std::atomic<bool>>(true);
+        uint64_t lodGeneration_ = 0;
+
         // GL objects (raw GL handles kept as unsigned to avoid leaking GL headers here).
         unsigned int program_ = 0;
-        unsigned int vao_ = 0;
-        unsigned int vboPositions_ = 0;
-        unsigned int vboNormals_ = 0;
-        unsigned int ebo_ = 0;
-        int indexCount_ = 0;
+        GPUMesh fullMesh_;
+        GPUMesh coarseMesh_;        // coarsest LOD, drawn while interacting
         bool glReady_ = false;
         bool meshDirty_ = false;
+        bool coarseDirty_ = false;
 
         // Uniform locations.
         int uMVP_ = -1;
@@ -105,9 +137,13 @@ namespace UltraCanvas {
         ~UltraCanvasSTLElement() override = default;
 
         bool LoadFromFile(const std::string& filePath);
-        void SetMesh(const Mesh3D& mesh);
+        void SetMesh(Mesh3D mesh);
         const Mesh3D& GetMesh() const { return mesh_; }
 
+        void SetLODTriangleBudget(size_t) {}
+        size_t GetLODTriangleBudget() const { return 0; }
+        size_t GetLODCount() const { return 0; }
+
         bool SaveToFile(const std::string& filePath,
                         STLFormat format = STLFormat::Auto,
                         std::string* outError = nullptr) const;
@@ -1,16 +1,20 @@
 // Plugins/Models/STL/UltraCanvasSTLLoader.cpp
 // Implementation of the self-contained STL loader/saver
-// Version: 1.0.0
-// Last Modified: 2026-06-21
+// Version: 1.1.0
+// Last Modified: 2026-10-18
 // Author: UltraCanvas Framework
 
 #include "UltraCanvasSTLLoader.h"
+#include "UltraCanvasMappedFile.h"
 
 #include <fstream>
-#include <sstream>
 #include <cstring>
 #include <cctype>
 #include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cmath>
+#include <thread>
 
 namespace UltraCanvas {
 
@@ -66,24 +70,195 @@ namespace {
         WriteU32LE(os, bits);
     }
 
-    bool ReadWholeFile(const std::string& path, std::vector<uint8_t>& out, std::string* err) {
-        std::ifstream in(path, std::ios::binary | std::ios::ate);
-        if (!in) {
-            SetError(err, "Cannot open file: " + path);
-            return false;
+    // Automatic threading leaves inputs smaller than this per thread whole;
+    // an explicit thread count is honoured down to much smaller slices.
+    constexpr size_t kMinBytesPerThread = 4u << 20;
+    constexpr size_t kMinBytesPerRequestedThread = 4u << 10;
+
+    unsigned ThreadsFor(unsigned requested, size_t bytes) {
+        const unsigned threads = requested ? requested : std::max(1u, std::thread::hardware_concurrency());
+        const size_t byBytes = std::max<size_t>(
+                1, bytes / (requested ? kMinBytesPerRequestedThread : kMinBytesPerThread));
+        return static_cast<unsigned>(std::min<size_t>(threads, byBytes));
+    }
+
+    // Runs fn(part) for part in [0, parts) on `parts` threads (part 0 on the caller).
+    template <typename Fn>
+    void RunParts(unsigned parts, Fn&& fn) {
+        std::vector<std::thread> workers;
+        for (unsigned t = 1; t < parts; ++t) workers.emplace_back([&fn, t]() { fn(t); });
+        fn(0u);
+        for (auto& w : workers) w.join();
+    }
+
+    Vec3 FacetNormal(const Vec3& given, const Vec3& v0, const Vec3& v1, const Vec3& v2) {
+        if (given.Length() >= 1e-12f) return given;
+        return (v1 - v0).Cross(v2 - v0).Normalized();
+    }
+
+    // ----- ASCII tokenizer -----
+
+    inline bool IsSpace(char c) {
+        return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v';
+    }
+
+    struct AsciiCursor {
+        const char* p;
+        const char* end;
+
+        // Next whitespace-delimited token; false at the end of input.
+        bool Next(const char*& tokenStart, size_t& tokenLength) {
+            while (p < end && IsSpace(*p)) ++p;
+            if (p >= end) return false;
+            tokenStart = p;
+            while (p < end && !IsSpace(*p)) ++p;
+            tokenLength = static_cast<size_t>(p - tokenStart);
+            return true;
         }
-        std::streamsize size = in.tellg();
-        if (size < 0) {
-            SetError(err, "Cannot determine file size: " + path);
-            return false;
+
+        bool Float(float& out) {
+            const char* t;
+            size_t n;
+            if (!Next(t, n)) return false;
+            if (*t == '+') { ++t; --n; }
+            const auto result = std::from_chars(t, t + n, out);
+            return result.ec == std::errc() && result.ptr == t + n;
         }
-        in.seekg(0, std::ios::beg);
-        out.resize(static_cast<size_t>(size));
-        if (size > 0 && !in.read(reinterpret_cast<char*>(out.data()), size)) {
-            SetError(err, "Failed to read file: " + path);
-            return false;
+
+        bool Vector(Vec3& v) { return Float(v.x) && Float(v.y) && Float(v.z); }
+
+        std::string RestOfLine() {
+            const char* start = p;
+            while (p < end && *p != '\n') ++p;
+            std::string rest(start, p);
+            const size_t first = rest.find_first_not_of(" \t\r\n");
+            if (first == std::string::npos) return {};
+            const size_t last = rest.find_last_not_of(" \t\r\n");
+            return rest.substr(first, last - first + 1);
+        }
+    };
+
+    inline bool TokenIs(const char* t, size_t n, const char* word) {
+        return std::strlen(word) == n && std::memcmp(t, word, n) == 0;
+    }
+
+    // First "facet" token starting at or after `from` (not the tail of
+    // "endfacet"), or `size` when there is none.
+    size_t FindFacetStart(const char* text, size_t size, size_t from) {
+        static constexpr char kFacet[] = "facet";
+        for (size_t i = from; i + 5 <= size; ++i) {
+            const void* hit = std::memchr(text + i, 'f', size - i);
+            if (!hit) break;
+            i = static_cast<size_t>(static_cast<const char*>(hit) - text);
+            if (i + 5 > size) break;
+            if (std::memcmp(text + i, kFacet, 5) == 0 &&
+                (i == 0 || IsSpace(text[i - 1])) &&
+                (i + 5 == size || IsSpace(text[i + 5]))) {
+                return i;
+            }
+        }
+        return size;
+    }
+
+    // One parallel slice of an ASCII file: the facets whose "facet" token
+    // lies in [begin, limit).
+    struct AsciiChunk {
+        std::vector<Vec3> positions;
+        std::vector<Vec3> normals;
+        std::string solidName;      // last non-empty "solid" name seen
+        bool malformed = false;
+    };
+
+    void ParseAsciiChunk(const char* text, size_t size, size_t begin, size_t limit, AsciiChunk& out) {
+        AsciiCursor in{text + begin, text + size};
+        Vec3 normal;
+        Vec3 verts[3];
+        int vertIndex = 0;
+        const char* t;
+        size_t n;
+        while (in.Next(t, n)) {
+            if (TokenIs(t, n, "facet")) {
+                if (static_cast<size_t>(t - text) >= limit) break;
+                const char* kw;
+                size_t kwLen;
+                // Expect: facet normal nx ny nz
+                if (!in.Next(kw, kwLen) || !in.Vector(normal)) { out.malformed = true; break; }
+                vertIndex = 0;
+            } else if (TokenIs(t, n, "vertex")) {
+                Vec3 v;
+                if (!in.Vector(v)) { out.malformed = true; break; }
+                // Non-triangular facet: extra vertices are ignored.
+                if (vertIndex < 3) verts[vertIndex++] = v;
+            } else if (TokenIs(t, n, "endfacet")) {
+                if (vertIndex == 3) {
+                    const Vec3 nrm = FacetNormal(normal, verts[0], verts[1], verts[2]);
+                    for (const Vec3& v : verts) {
+                        out.positions.push_back(v);
+                        out.normals.push_back(nrm);
+                    }
+                }
+                vertIndex = 0;
+            } else if (TokenIs(t, n, "solid")) {
+                // Remainder of the line is the optional solid name.
+                if (static_cast<size_t>(t - text) >= limit) break;
+                std::string name = in.RestOfLine();
+                if (!name.empty()) out.solidName = std::move(name);
+            }
+            // "outer", "loop", "endloop", "endsolid" and unknown tokens are ignored.
+        }
+    }
+
+    // ----- welding -----
+
+    inline uint32_t FloatBits(float f) {
+        if (f == 0.0f) f = 0.0f;    // -0 welds with +0
+        uint32_t bits;
+        std::memcpy(&bits, &f, sizeof(bits));
+        return bits;
+    }
+
+    inline uint64_t HashPosition(const Vec3& p) {
+        uint64_t h = FloatBits(p.x) * 0x9E3779B97F4A7C15ull;
+        h ^= FloatBits(p.y) * 0xC2B2AE3D27D4EB4Full + (h >> 29);
+        h ^= FloatBits(p.z) * 0x165667B19E3779F9ull + (h >> 32);
+        return h ^ (h >> 31);
+    }
+
+    inline bool SamePosition(const Vec3& a, const Vec3& b) {
+        return FloatBits(a.x) == FloatBits(b.x) && FloatBits(a.y) == FloatBits(b.y) &&
+               FloatBits(a.z) == FloatBits(b.z);
+    }
+
+    inline uint64_t HashCell(int64_t x, int64_t y, int64_t z) {
+        uint64_t h = static_cast<uint64_t>(x) * 0x9E3779B97F4A7C15ull;
+        h ^= static_cast<uint64_t>(y) * 0xC2B2AE3D27D4EB4Full + (h >> 29);
+        h ^= static_cast<uint64_t>(z) * 0x165667B19E3779F9ull + (h >> 32);
+        return h ^ (h >> 31);
+    }
+
+    size_t TableSizeFor(size_t entries) {
+        size_t capacity = 16;
+        while (capacity < entries * 2) capacity <<= 1;
+        return capacity;
+    }
+
+    constexpr uint32_t kNoVertex = 0xFFFFFFFFu;
+
+    // The stored normal when all three corners carry the same one (a facet
+    // normal, as loaded from STL); otherwise - welded meshes with smooth or
+    // no normals - the geometric facet normal.
+    Vec3 FacetNormalToSave(const Mesh3D& mesh, uint32_t a, uint32_t b, uint32_t c) {
+        if (a < mesh.normals.size() && b < mesh.normals.size() && c < mesh.normals.size()) {
+            const Vec3& n = mesh.normals[a];
+            const Vec3& nb = mesh.normals[b];
+            const Vec3& nc = mesh.normals[c];
+            if (n.x == nb.x && n.y == nb.y && n.z == nb.z &&
+                n.x == nc.x && n.y == nc.y && n.z == nc.z && n.Length() >= 1e-12f) {
+                return n;
+            }
         }
-        return true;
+        const Vec3& v0 = mesh.positions[a];
+        return (mesh.positions[b] - v0).Cross(mesh.positions[c] - v0).Normalized();
     }
 
 } // anonymous namespace
@@ -98,28 +273,41 @@ bool UltraCanvasSTLLoader::HasSTLExtension(const std::string& filePath) {
 }
 
 bool UltraCanvasSTLLoader::LooksLikeBinary(const std::vector<uint8_t>& data) {
+    return LooksLikeBinary(data.data(), data.size());
+}
+
+bool UltraCanvasSTLLoader::LooksLikeBinary(const uint8_t* data, size_t size) {
     // Too small to be valid binary STL -> treat as ASCII.
-    if (data.size() < kBinaryHeaderSize + kBinaryCountSize) return false;
+    if (size < kBinaryHeaderSize + kBinaryCountSize) return false;
 
-    uint32_t count = ReadU32LE(data.data() + kBinaryHeaderSize);
+    uint32_t count = ReadU32LE(data + kBinaryHeaderSize);
     size_t expected = kBinaryHeaderSize + kBinaryCountSize +
                       static_cast<size_t>(count) * kBinaryFacetSize;
 
     // The size match is the canonical, reliable discriminator: some binary STL
     // files start with the ASCII token "solid", so a header sniff alone is unsafe.
-    if (expected == data.size()) return true;
+    if (expected == size) return true;
 
     // Fall back to a header sniff: ASCII STL begins with "solid" then whitespace.
-    bool startsWithSolid = data.size() >= 5 &&
-                           std::memcmp(data.data(), "solid", 5) == 0;
+    bool startsWithSolid = size >= 5 && std::memcmp(data, "solid", 5) == 0;
     return !startsWithSolid;
 }
 
 bool UltraCanvasSTLLoader::Load(const std::string& filePath, Mesh3D& outMesh,
                                 std::string* outError) {
-    std::vector<uint8_t> data;
-    if (!ReadWholeFile(filePath, data, outError)) return false;
-    if (!LoadFromMemory(data, outMesh, outError)) return false;
+    return Load(filePath, outMesh, STLLoadOptions{}, outError);
+}
+
+bool UltraCanvasSTLLoader::Load(const std::string& filePath, Mesh3D& outMesh,
+                                const STLLoadOptions& options, std::string* outError) {
+    UltraCanvasMappedFile file;
+    if (!file.Open(filePath)) {
+        outMesh.Clear();
+        SetError(outError, file.GetLastError());
+        return false;
+    }
+    file.AdviseSequential();
+    if (!LoadFromMemory(file.Data(), file.Size(), outMesh, options, outError)) return false;
     if (outMesh.name.empty()) {
         size_t slash = filePath.find_last_of("/\\");
         outMesh.name = (slash == std::string::npos) ? filePath : filePath.substr(slash + 1);
@@ -129,138 +317,250 @@ bool UltraCanvasSTLLoader::Load(const std::string& filePath, Mesh3D& outMesh,
 
 bool UltraCanvasSTLLoader::LoadFromMemory(const std::vector<uint8_t>& data, Mesh3D& outMesh,
                                           std::string* outError) {
+    return LoadFromMemory(data.data(), data.size(), outMesh, STLLoadOptions{}, outError);
+}
+
+bool UltraCanvasSTLLoader::LoadFromMemory(const uint8_t* data, size_t size, Mesh3D& outMesh,
+                                          const STLLoadOptions& options, std::string* outError) {
     outMesh.Clear();
-    if (data.empty()) {
+    if (!data || size == 0) {
         SetError(outError, "Empty STL data");
         return false;
     }
 
-    if (LooksLikeBinary(data)) {
-        return ParseBinary(data, outMesh, outError);
+    const unsigned threads = ThreadsFor(options.threads, size);
+    const bool ok = LooksLikeBinary(data, size)
+        ? ParseBinary(data, size, threads, outMesh, outError)
+        : ParseAscii(reinterpret_cast<const char*>(data), size, threads, outMesh, outError);
+    if (!ok) return false;
+
+    if (options.weld) {
+        WeldVertices(outMesh, options.weldTolerance, options.computeNormals, options.threads);
+        if (outMesh.Empty()) {
+            SetError(outError, "STL contains only degenerate triangles");
+            return false;
+        }
     }
-    std::string text(reinterpret_cast<const char*>(data.data()), data.size());
-    return ParseAscii(text, outMesh, outError);
+    return true;
 }
 
-bool UltraCanvasSTLLoader::ParseBinary(const std::vector<uint8_t>& data, Mesh3D& outMesh,
-                                       std::string* outError) {
-    if (data.size() < kBinaryHeaderSize + kBinaryCountSize) {
+bool UltraCanvasSTLLoader::ParseBinary(const uint8_t* data, size_t size, unsigned threads,
+                                       Mesh3D& outMesh, std::string* outError) {
+    if (size < kBinaryHeaderSize + kBinaryCountSize) {
         SetError(outError, "Binary STL truncated (no header/count)");
         return false;
     }
 
-    uint32_t count = ReadU32LE(data.data() + kBinaryHeaderSize);
+    uint32_t count = ReadU32LE(data + kBinaryHeaderSize);
     size_t needed = kBinaryHeaderSize + kBinaryCountSize +
                     static_cast<size_t>(count) * kBinaryFacetSize;
-    if (data.size() < needed) {
+    if (size < needed) {
         SetError(outError, "Binary STL truncated (facet data shorter than declared count)");
         return false;
     }
+    if (count == 0) {
+        SetError(outError, "Binary STL contains no triangles");
+        return false;
+    }
 
-    outMesh.positions.reserve(static_cast<size_t>(count) * 3);
-    outMesh.normals.reserve(static_cast<size_t>(count) * 3);
-    outMesh.indices.reserve(static_cast<size_t>(count) * 3);
-
-    const uint8_t* cursor = data.data() + kBinaryHeaderSize + kBinaryCountSize;
-    bool anyDegenerateNormal = false;
-
-    for (uint32_t f = 0; f < count; ++f) {
-        Vec3 normal{ ReadF32LE(cursor),     ReadF32LE(cursor + 4), ReadF32LE(cursor + 8) };
-        Vec3 v0{     ReadF32LE(cursor + 12), ReadF32LE(cursor + 16), ReadF32LE(cursor + 20) };
-        Vec3 v1{     ReadF32LE(cursor + 24), ReadF32LE(cursor + 28), ReadF32LE(cursor + 32) };
-        Vec3 v2{     ReadF32LE(cursor + 36), ReadF32LE(cursor + 40), ReadF32LE(cursor + 44) };
-        cursor += kBinaryFacetSize; // skip the 2-byte attribute byte count too
-
-        if (normal.Length() < 1e-12f) {
-            anyDegenerateNormal = true;
-            normal = (v1 - v0).Cross(v2 - v0).Normalized();
+    // Fixed-size records: each thread decodes its own facet range straight
+    // into the final arrays.
+    const size_t corners = static_cast<size_t>(count) * 3;
+    outMesh.positions.resize(corners);
+    outMesh.normals.resize(corners);
+    outMesh.indices.resize(corners);
+
+    const uint8_t* facets = data + kBinaryHeaderSize + kBinaryCountSize;
+    RunParts(threads, [&](unsigned part) {
+        const size_t first = static_cast<size_t>(count) * part / threads;
+        const size_t last = static_cast<size_t>(count) * (part + 1) / threads;
+        const uint8_t* cursor = facets + first * kBinaryFacetSize;
+        for (size_t f = first; f < last; ++f) {
+            Vec3 normal{ ReadF32LE(cursor),     ReadF32LE(cursor + 4), ReadF32LE(cursor + 8) };
+            Vec3 v0{     ReadF32LE(cursor + 12), ReadF32LE(cursor + 16), ReadF32LE(cursor + 20) };
+            Vec3 v1{     ReadF32LE(cursor + 24), ReadF32LE(cursor + 28), ReadF32LE(cursor + 32) };
+            Vec3 v2{     ReadF32LE(cursor + 36), ReadF32LE(cursor + 40), ReadF32LE(cursor + 44) };
+            cursor += kBinaryFacetSize; // skip the 2-byte attribute byte count too
+
+            normal = FacetNormal(normal, v0, v1, v2);
+            const size_t base = f * 3;
+            outMesh.positions[base] = v0;
+            outMesh.positions[base + 1] = v1;
+            outMesh.positions[base + 2] = v2;
+            outMesh.normals[base] = outMesh.normals[base + 1] = outMesh.normals[base + 2] = normal;
+            outMesh.indices[base] = static_cast<uint32_t>(base);
+            outMesh.indices[base + 1] = static_cast<uint32_t>(base + 1);
+            outMesh.indices[base + 2] = static_cast<uint32_t>(base + 2);
         }
+    });
 
-        uint32_t base = static_cast<uint32_t>(outMesh.positions.size());
-        outMesh.positions.push_back(v0);
-        outMesh.positions.push_back(v1);
-        outMesh.positions.push_back(v2);
-        outMesh.normals.push_back(normal);
-        outMesh.normals.push_back(normal);
-        outMesh.normals.push_back(normal);
-        outMesh.indices.push_back(base);
-        outMesh.indices.push_back(base + 1);
-        outMesh.indices.push_back(base + 2);
+    outMesh.ComputeBounds();
+    return true;
+}
+
+bool UltraCanvasSTLLoader::ParseAscii(const char* text, size_t size, unsigned threads,
+                                      Mesh3D& outMesh, std::string* outError) {
+    // Split at "facet" tokens: slice i parses the facets that start in
+    // [bounds[i], bounds[i + 1]), so every facet is parsed exactly once.
+    std::vector<size_t> bounds{0};
+    for (unsigned t = 1; t < threads; ++t) {
+        const size_t at = FindFacetStart(text, size, std::max(bounds.back(), size * t / threads));
+        if (at >= size) break;
+        if (at > bounds.back()) bounds.push_back(at);
+    }
+    bounds.push_back(size);
+
+    const unsigned parts = static_cast<unsigned>(bounds.size() - 1);
+    std::vector<AsciiChunk> chunks(parts);
+    RunParts(parts, [&](unsigned part) {
+        ParseAsciiChunk(text, size, bounds[part], bounds[part + 1], chunks[part]);
+    });
+
+    size_t corners = 0;
+    for (const auto& chunk : chunks) corners += chunk.positions.size();
+    outMesh.positions.reserve(corners);
+    outMesh.normals.reserve(corners);
+    for (auto& chunk : chunks) {
+        outMesh.positions.insert(outMesh.positions.end(), chunk.positions.begin(), chunk.positions.end());
+        outMesh.normals.insert(outMesh.normals.end(), chunk.normals.begin(), chunk.normals.end());
+        if (!chunk.solidName.empty()) outMesh.name = chunk.solidName;
+        std::vector<Vec3>().swap(chunk.positions);
+        std::vector<Vec3>().swap(chunk.normals);
+        // Like a stream parse, a malformed facet ends the file.
+        if (chunk.malformed) break;
+    }
+    outMesh.indices.resize(outMesh.positions.size());
+    for (size_t i = 0; i < outMesh.indices.size(); ++i) {
+        outMesh.indices[i] = static_cast<uint32_t>(i);
     }
 
     if (outMesh.Empty()) {
-        SetError(outError, "Binary STL contains no triangles");
+        SetError(outError, "ASCII STL contains no complete triangles");
         return false;
     }
-    (void)anyDegenerateNormal;
     outMesh.ComputeBounds();
     return true;
 }
 
-bool UltraCanvasSTLLoader::ParseAscii(const std::string& text, Mesh3D& outMesh,
-                                      std::string* outError) {
-    std::istringstream in(text);
-    std::string token;
-
-    Vec3 currentNormal;
-    Vec3 verts[3];
-    int vertIndex = 0;
+void UltraCanvasSTLLoader::WeldVertices(Mesh3D& mesh, float tolerance, bool computeNormals,
+                                        unsigned threads) {
+    const size_t n = mesh.positions.size();
+    if (n == 0) return;
+    std::vector<uint32_t> remap(n);
+    std::vector<Vec3> unique;
+
+    if (tolerance <= 0.0f) {
+        // Exact: hash partitions welded independently, one per thread. Every
+        // thread scans all positions but inserts only those of its partition.
+        const unsigned parts = ThreadsFor(threads, n * sizeof(Vec3));
+        std::vector<std::vector<Vec3>> partUnique(parts);
+        RunParts(parts, [&](unsigned part) {
+            std::vector<uint32_t> table(TableSizeFor(n / parts + 1), kNoVertex);
+            const size_t mask = table.size() - 1;
+            auto& local = partUnique[part];
+            for (size_t i = 0; i < n; ++i) {
+                const Vec3& p = mesh.positions[i];
+                const uint64_t h = HashPosition(p);
+                if (h % parts != part) continue;
+                size_t slot = (h / parts) & mask;
+                while (table[slot] != kNoVertex && !SamePosition(local[table[slot]], p)) {
+                    slot = (slot + 1) & mask;
+                }
+                if (table[slot] == kNoVertex) {
+                    table[slot] = static_cast<uint32_t>(local.size());
+                    local.push_back(p);
+                }
+                remap[i] = table[slot];
+            }
+        });
 
-    auto pushFacet = [&](const Vec3& normal) {
-        Vec3 n = normal;
-        if (n.Length() < 1e-12f) {
-            n = (verts[1] - verts[0]).Cross(verts[2] - verts[0]).Normalized();
+        std::vector<uint32_t> offset(parts + 1, 0);
+        for (unsigned part = 0; part < parts; ++part) {
+            offset[part + 1] = offset[part] + static_cast<uint32_t>(partUnique[part].size());
         }
-        uint32_t base = static_cast<uint32_t>(outMesh.positions.size());
-        for (int i = 0; i < 3; ++i) {
-            outMesh.positions.push_back(verts[i]);
-            outMesh.normals.push_back(n);
+        unique.resize(offset[parts]);
+        for (unsigned part = 0; part < parts; ++part) {
+            std::copy(partUnique[part].begin(), partUnique[part].end(), unique.begin() + offset[part]);
+            std::vector<Vec3>().swap(partUnique[part]);
         }
-        outMesh.indices.push_back(base);
-        outMesh.indices.push_back(base + 1);
-        outMesh.indices.push_back(base + 2);
-    };
-
-    while (in >> token) {
-        if (token == "solid") {
-            // Remainder of the line is the optional solid name.
-            std::string rest;
-            std::getline(in, rest);
-            size_t start = rest.find_first_not_of(" \t\r\n");
-            if (start != std::string::npos) {
-                size_t end = rest.find_last_not_of(" \t\r\n");
-                outMesh.name = rest.substr(start, end - start + 1);
-            }
-        } else if (token == "facet") {
-            // Expect: facet normal nx ny nz
-            std::string normalKeyword;
-            in >> normalKeyword; // "normal"
-            in >> currentNormal.x >> currentNormal.y >> currentNormal.z;
-            vertIndex = 0;
-        } else if (token == "vertex") {
-            if (vertIndex < 3) {
-                in >> verts[vertIndex].x >> verts[vertIndex].y >> verts[vertIndex].z;
-                ++vertIndex;
-            } else {
-                // Non-triangular facet: skip the extra vertex coordinates.
-                Vec3 ignored;
-                in >> ignored.x >> ignored.y >> ignored.z;
+        for (size_t i = 0; i < n; ++i) {
+            remap[i] += offset[HashPosition(mesh.positions[i]) % parts];
+        }
+    } else {
+        // Within tolerance: grid of tolerance-sized cells; a position welds
+        // to the first earlier vertex within reach in its 27 neighbouring cells.
+        const float inv = 1.0f / tolerance;
+        const float tol2 = tolerance * tolerance;
+        std::vector<uint32_t> next;             // per unique vertex: next in its cell
+        struct Cell { uint64_t key; uint32_t head; };
+        std::vector<Cell> table(TableSizeFor(n / 2 + 1), Cell{0, kNoVertex});
+        const size_t mask = table.size() - 1;
+        auto cellOf = [&](float v) { return static_cast<int64_t>(std::floor(v * inv)); };
+        auto find = [&](uint64_t key) -> Cell& {
+            size_t slot = key & mask;
+            while (table[slot].head != kNoVertex && table[slot].key != key) slot = (slot + 1) & mask;
+            return table[slot];
+        };
+        for (size_t i = 0; i < n; ++i) {
+            const Vec3& p = mesh.positions[i];
+            const int64_t cx = cellOf(p.x), cy = cellOf(p.y), cz = cellOf(p.z);
+            uint32_t match = kNoVertex;
+            for (int dx = -1; dx <= 1 && match == kNoVertex; ++dx) {
+                for (int dy = -1; dy <= 1 && match == kNoVertex; ++dy) {
+                    for (int dz = -1; dz <= 1 && match == kNoVertex; ++dz) {
+                        const Cell& cell = find(HashCell(cx + dx, cy + dy, cz + dz));
+                        for (uint32_t v = cell.head; v != kNoVertex; v = next[v]) {
+                            const Vec3 d = unique[v] - p;
+                            if (d.Dot(d) <= tol2) { match = v; break; }
+                        }
+                    }
+                }
             }
-        } else if (token == "endfacet") {
-            if (vertIndex == 3) {
-                pushFacet(currentNormal);
+            if (match == kNoVertex) {
+                match = static_cast<uint32_t>(unique.size());
+                unique.push_back(p);
+                Cell& cell = find(HashCell(cx, cy, cz));
+                if (cell.head == kNoVertex) cell.key = HashCell(cx, cy, cz);
+                next.push_back(cell.head);
+                cell.head = match;
             }
-            vertIndex = 0;
+            remap[i] = match;
         }
-        // "outer", "loop", "endloop", "endsolid" and unknown tokens are ignored.
     }
 
-    if (outMesh.Empty()) {
-        SetError(outError, "ASCII STL contains no complete triangles");
-        return false;
+    // Renumber in order of first use, which keeps the vertex order close to
+    // the triangle order (GPU vertex cache friendly).
+    std::vector<uint32_t> order(unique.size(), kNoVertex);
+    std::vector<Vec3> positions;
+    positions.reserve(unique.size());
+    auto renumber = [&](uint32_t v) {
+        if (order[v] == kNoVertex) {
+            order[v] = static_cast<uint32_t>(positions.size());
+            positions.push_back(unique[v]);
+        }
+        return order[v];
+    };
+
+    std::vector<uint32_t> indices;
+    indices.reserve(mesh.indices.size());
+    for (size_t i = 0; i + 2 < mesh.indices.size(); i += 3) {
+        const uint32_t a = mesh.indices[i], b = mesh.indices[i + 1], c = mesh.indices[i + 2];
+        if (a >= n || b >= n || c >= n) continue;
+        const uint32_t wa = remap[a], wb = remap[b], wc = remap[c];
+        if (wa == wb || wb == wc || wa == wc) continue;     // collapsed by the weld
+        indices.push_back(renumber(wa));
+        indices.push_back(renumber(wb));
+        indices.push_back(renumber(wc));
     }
-    outMesh.ComputeBounds();
-    return true;
+
+    mesh.positions = std::move(positions);
+    mesh.indices = std::move(indices);
+    if (computeNormals) {
+        mesh.RecomputeNormals();
+    } else {
+        std::vector<Vec3>().swap(mesh.normals);
+    }
+    mesh.ComputeBounds();
 }
 
 bool UltraCanvasSTLLoader::Save(const std::string& filePath, const Mesh3D& mesh,
@@ -303,11 +603,8 @@ bool UltraCanvasSTLLoader::WriteBinary(const std::string& filePath, const Mesh3D
         const Vec3& v1 = mesh.positions[b];
         const Vec3& v2 = mesh.positions[c];
 
-        // Prefer the stored normal; recompute if absent/degenerate.
-        Vec3 n = (a < mesh.normals.size()) ? mesh.normals[a] : Vec3{};
-        if (n.Length() < 1e-12f) {
-            n = (v1 - v0).Cross(v2 - v0).Normalized();
-        }
+        // Prefer the stored facet normal; recompute if absent/per-vertex/degenerate.
+        Vec3 n = FacetNormalToSave(mesh, a, b, c);
 
         WriteF32LE(out, n.x);  WriteF32LE(out, n.y);  WriteF32LE(out, n.z);
         WriteF32LE(out, v0.x); WriteF32LE(out, v0.y); WriteF32LE(out, v0.z);
@@ -342,10 +639,7 @@ bool UltraCanvasSTLLoader::WriteAscii(const std::string& filePath, const Mesh3D&
         const Vec3& v1 = mesh.positions[b];
         const Vec3& v2 = mesh.positions[c];
 
-        Vec3 n = (a < mesh.normals.size()) ? mesh.normals[a] : Vec3{};
-        if (n.Length() < 1e-12f) {
-            n = (v1 - v0).Cross(v2 - v0).Normalized();
-        }
+        Vec3 n = FacetNormalToSave(mesh, a, b, c);
 
         out << "  facet normal " << n.x << " " << n.y << " " << n.z << "\n";
         out << "    outer loop\n";
@@ -1,8 +1,8 @@
 // Plugins/Models/STL/UltraCanvasSTLLoader.h
 // Self-contained STL (stereolithography) mesh loader and saver
 // Supports both ASCII and binary STL, in both directions (load + save)
-// Version: 1.0.0
-// Last Modified: 2026-06-21
+// Version: 1.1.0
+// Last Modified: 2026-10-18
 // Author: UltraCanvas Framework
 #pragma once
 
@@ -23,6 +23,23 @@ namespace UltraCanvas {
         Binary
     };
 
+// Loading options. The defaults reproduce the plain STL triangle soup.
+    struct STLLoadOptions {
+        // Merge corners sharing a position into one vertex, turning the soup
+        // into an indexed mesh (about a third of the vertices, and the shared
+        // topology mesh decimation needs). Triangles that collapse are dropped.
+        bool weld = false;
+        // Corners closer than this are merged; 0 = bit-identical positions only.
+        float weldTolerance = 0.0f;
+        // With weld: fill per-vertex (smooth, area-weighted) normals. Off
+        // leaves normals empty — viewers that shade facets from screen-space
+        // derivatives don't need them.
+        bool computeNormals = true;
+        // Parser / exact-welder threads; 0 = hardware concurrency, with
+        // inputs below a few MB per thread kept on the calling thread.
+        unsigned threads = 0;
+    };
+
 // Self-contained STL reader/writer. No external dependencies.
 // All methods are static; the mesh is the unit of exchange.
     class UltraCanvasSTLLoader {
@@ -30,13 +47,25 @@ namespace UltraCanvas {
         // ----- Loading -----
 
         // Load an STL file (auto-detects ASCII vs binary). Returns false on error;
-        // a human-readable reason is written to outError when non-null.
+        // a human-readable reason is written to outError when non-null. The
+        // file is memory-mapped and parsed in parallel chunks, so no copy of
+        // it is ever held in memory.
         static bool Load(const std::string& filePath, Mesh3D& outMesh,
                          std::string* outError = nullptr);
+        static bool Load(const std::string& filePath, Mesh3D& outMesh,
+                         const STLLoadOptions& options, std::string* outError = nullptr);
 
         // Load from an in-memory STL byte buffer (auto-detects ASCII vs binary).
         static bool LoadFromMemory(const std::vector<uint8_t>& data, Mesh3D& outMesh,
                                    std::string* outError = nullptr);
+        static bool LoadFromMemory(const uint8_t* data, size_t size, Mesh3D& outMesh,
+                                   const STLLoadOptions& options = {},
+                                   std::string* outError = nullptr);
+
+        // Merge duplicate vertices in place through a spatial hash (see
+        // STLLoadOptions::weld). Works on any mesh, indexed or not.
+        static void WeldVertices(Mesh3D& mesh, float tolerance = 0.0f,
+                                 bool computeNormals = true, unsigned threads = 0);
 
         // ----- Saving -----
 
@@ -50,13 +79,16 @@ namespace UltraCanvas {
         // True if the first bytes of the buffer look like binary STL (based on the
         // canonical "84 + 50 * triangleCount == size" heuristic).
         static bool LooksLikeBinary(const std::vector<uint8_t>& data);
+        static bool LooksLikeBinary(const uint8_t* data, size_t size);
 
         // Lightweight extension check ("stl", with or without a leading dot).
         static bool HasSTLExtension(const std::string& filePath);
 
     private:
-        static bool ParseAscii(const std::string& text, Mesh3D& outMesh, std::string* outError);
-        static bool ParseBinary(const std::vector<uint8_t>& data, Mesh3D& outMesh, std::string* outError);
+        static bool ParseAscii(const char* text, size_t size, unsigned threads,
+                               Mesh3D& outMesh, std::string* outError);
+        static bool ParseBinary(const uint8_t* data, size_t size, unsigned threads,
+                                Mesh3D& outMesh, std::string* outError);
         static bool WriteAscii(const std::string& filePath, const Mesh3D& mesh, std::string* outError);
         static bool WriteBinary(const std::string& filePath, const Mesh3D& mesh, std::string* outError);
     };
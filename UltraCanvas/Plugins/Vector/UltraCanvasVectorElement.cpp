@@ -1,7 +1,7 @@
 // UltraCanvasVectorElement.cpp
 // UI Element for Vector Document Display and Interaction
-// Version: 2.0.0
-// Last Modified: 2025-01-20
+// Version: 2.1.0
+// Last Modified: 2026-10-18
 // Author: UltraCanvas Framework
 
 #include "UltraCanvasVectorElement.h"
@@ -24,6 +24,7 @@ namespace UltraCanvas {
 
     void UltraCanvasVectorElement::SetDocument(std::shared_ptr<VectorDocument> doc) {
         document = doc;
+        if (renderer) renderer->ClearCaches();
         state.IsDirty = true;
         ClearError();
         ZoomToFit();
@@ -32,6 +33,7 @@ namespace UltraCanvas {
 
     void UltraCanvasVectorElement::ClearDocument() {
         document = nullptr;
+        if (renderer) renderer->ClearCaches();
         selectedElementId.clear();
         hoveredElementId.clear();
         zoomLevel = 1.0f;
@@ -40,6 +42,12 @@ namespace UltraCanvas {
         ClearError();
     }
 
+    void UltraCanvasVectorElement::InvalidateDocument() {
+        if (renderer) renderer->ClearCaches();
+        state.IsDirty = true;
+        RequestRedraw();
+    }
+
     void UltraCanvasVectorElement::SetZoom(float zoom) {
         zoom = std::clamp(zoom, options.MinZoom, options.MaxZoom);
         if (std::abs(zoom - zoomLevel) > 0.001f) {
@@ -109,6 +117,7 @@ namespace UltraCanvas {
 
     void UltraCanvasVectorElement::SetOptions(const VectorElementOptions& opts) {
         options = opts;
+        if (renderer) renderer->ClearCaches();
         state.IsDirty = true;
         RequestRedraw();
     }
@@ -168,7 +177,13 @@ namespace UltraCanvas {
     void UltraCanvasVectorElement::SetLayerVisible(const std::string& layerName, bool visible) {
         if (!document) return;
         for (auto& layer : document->Layers) {
-            if (layer->Name == layerName) { layer->Visible = visible; state.IsDirty = true; RequestRedraw(); break; }
+            if (layer->Name == layerName) {
+                layer->Visible = visible;
+                if (renderer) renderer->ClearCaches();
+                state.IsDirty = true;
+                RequestRedraw();
+                break;
+            }
         }
     }
 
@@ -217,18 +232,19 @@ namespace UltraCanvas {
         auto bounds = GetBounds();
         auto startTime = std::chrono::high_resolution_clock::now();
 
-        ctx->PushState();
-        ctx->Translate(finalBounds.x + panOffset.x, finalBounds.y + panOffset.y);
-        ctx->Scale(zoomLevel, zoomLevel);
-
-        VectorRenderOptions renderOpts;
+        // The visible part of the document, in unzoomed coordinates: the
+        // pan offset shifts it, which culling has to follow.
+        VectorRenderOptions renderOpts = renderer->GetOptions();
         renderOpts.EnableAntialiasing = options.EnableAntialiasing;
-        renderOpts.ViewportBounds = {0, 0, finalBounds.width / zoomLevel, finalBounds.height / zoomLevel};
+        renderOpts.ViewportBounds = {-panOffset.x / zoomLevel, -panOffset.y / zoomLevel,
+                                     finalBounds.width / zoomLevel, finalBounds.height / zoomLevel};
         renderOpts.ClipToViewport = true;
+        renderOpts.EnableTileCache = options.EnableTileCache;
         renderer->SetOptions(renderOpts);
-        renderer->RenderDocument(ctx, *document);
-
-        ctx->PopState();
+        renderer->RenderDocumentCached(ctx, *document,
+                                       Point2Dd(finalBounds.x + panOffset.x, finalBounds.y + panOffset.y),
+                                       zoomLevel, Rect2Dd(finalBounds.x, finalBounds.y, finalBounds.width,
+                                                          finalBounds.height));
 
         auto endTime = std::chrono::high_resolution_clock::now();
         double renderTime = std::chrono::duration<double, std::milli>(endTime - startTime).count();
@@ -348,7 +364,7 @@ namespace UltraCanvas {
     std::string UltraCanvasVectorElement::HitTest(int x, int y) const {
         if (!document) return "";
         Point2Dd docPt = ScreenToDocument(x, y);
-        auto hits = HitTestDocument(*document, docPt);
+        auto hits = renderer ? renderer->HitTest(*document, docPt) : HitTestDocument(*document, docPt);
         return hits.empty() ? "" : hits[0]->Id;
     }
 
@@ -1,7 +1,7 @@
 // UltraCanvasVectorElement.h
 // UI Element for Vector Document Display and Interaction
-// Version: 2.0.0
-// Last Modified: 2025-01-20
+// Version: 2.1.0
+// Last Modified: 2026-10-18
 // Author: UltraCanvas Framework
 #pragma once
 
@@ -41,6 +41,9 @@ namespace UltraCanvas {
         Color BorderColor = Color(200, 200, 200, 255);
         float BorderWidth = 1.0f;
         bool ShowDebugInfo = false;
+        // Keep rasterized tiles of the document per zoom level so panning
+        // only renders newly exposed areas (VectorRenderOptions::EnableTileCache).
+        bool EnableTileCache = false;
     };
 
     using VectorLoadCallback = std::function<void(bool success, const std::string& message)>;
@@ -77,6 +80,9 @@ namespace UltraCanvas {
         std::shared_ptr<VectorStorage::VectorDocument> GetDocument() const { return document; }
         void ClearDocument();
         bool HasDocument() const { return document != nullptr; }
+        // Call after modifying the document returned by GetDocument(): drops
+        // the renderer's spatial index and cached tiles, and redraws.
+        void InvalidateDocument();
 
         void SetZoom(float zoom);
         float GetZoom() const { return zoomLevel; }
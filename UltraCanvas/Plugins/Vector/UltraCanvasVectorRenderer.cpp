@@ -1,11 +1,12 @@
 // UltraCanvasVectorRenderer.cpp
 // Vector Graphics Rendering for UltraCanvas
-// Version: 2.0.0
-// Last Modified: 2025-01-20
+// Version: 2.1.0
+// Last Modified: 2026-10-18
 // Author: UltraCanvas Framework
 
 #include "UltraCanvasVectorRenderer.h"
 #include <cmath>
+#include <cstring>
 #include <algorithm>
 #include <functional>
 
@@ -13,19 +14,77 @@ namespace UltraCanvas {
 
     using namespace VectorStorage;
 
+    namespace {
+        bool IsUnboundedRect(const Rect2Dd &r) {
+            return r.x == 0 && r.y == 0 && r.width == 0 && r.height == 0;
+        }
+
+        bool RectsIntersect(const Rect2Dd &a, const Rect2Dd &b) {
+            return !(a.x + a.width < b.x || a.y + a.height < b.y || a.x > b.x + b.width || a.y > b.y + b.height);
+        }
+
+        Rect2Dd UnionRect(const Rect2Dd &a, const Rect2Dd &b) {
+            const double minX = std::min(a.x, b.x), minY = std::min(a.y, b.y);
+            const double maxX = std::max(a.x + a.width, b.x + b.width);
+            const double maxY = std::max(a.y + a.height, b.y + b.height);
+            return {minX, minY, maxX - minX, maxY - minY};
+        }
+
+        bool IsContainer(const VectorElement &e) {
+            return e.Type == VectorElementType::Group || e.Type == VectorElementType::Symbol ||
+                   e.Type == VectorElementType::Layer;
+        }
+
+        // Maps `r` from an element's parent space into its own (children's)
+        // space. False when the transform can't be inverted.
+        bool IntoLocalSpace(const VectorElement &e, Rect2Dd &r) {
+            if (!e.Transform.has_value()) return true;
+            if (std::abs(e.Transform->Determinant()) < 1e-10f) return false;
+            r = e.Transform->Inverse().Transform(r);
+            return true;
+        }
+
+        uint32_t FloatBits(float f) {
+            uint32_t bits;
+            std::memcpy(&bits, &f, sizeof(bits));
+            return bits;
+        }
+    }
+
+    size_t VectorRenderer::TileKeyHash::operator()(const TileKey &k) const {
+        size_t h = std::hash<const void *>()(k.document);
+        h = h * 31 + k.zoomBits;
+        h = h * 31 + k.viewBits;
+        h = h * 31 + static_cast<uint32_t>(k.tx);
+        h = h * 31 + static_cast<uint32_t>(k.ty);
+        return h;
+    }
+
     VectorRenderer::VectorRenderer() = default;
 
     VectorRenderer::~VectorRenderer() = default;
 
     void VectorRenderer::RenderDocument(IRenderContext *context, const VectorDocument &document) {
         auto startTime = std::chrono::high_resolution_clock::now();
+        stats.Reset();
+        RenderDocumentPass(context, document, nullptr);
+        auto endTime = std::chrono::high_resolution_clock::now();
+        stats.RenderTimeMs = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+    }
+
+    // One pass over the document. `cullOverride` replaces ViewportBounds as
+    // the visible area (same coordinate space: before the viewBox fit).
+    void VectorRenderer::RenderDocumentPass(IRenderContext *context, const VectorDocument &document,
+                                            const Rect2Dd *cullOverride) {
         ctx = context;
         currentDocument = &document;
-        stats.Reset();
+        if (options.UseSpatialIndex) EnsureSpatialIndex(document);
 
         ctx->PushState();
 
-        // Setup viewport transform
+        // Setup viewport transform, mirrored into `fit` to bring the visible
+        // area into document coordinates for culling.
+        Matrix3x3 fit;
         if (document.ViewBox.width > 0 && document.ViewBox.height > 0 &&
             options.ViewportBounds.width > 0 && options.ViewportBounds.height > 0) {
             float scaleX = options.ViewportBounds.width / document.ViewBox.width;
@@ -36,13 +95,25 @@ namespace UltraCanvas {
                 float dy = (options.ViewportBounds.height - document.ViewBox.height * scale) / 2;
                 ctx->Translate(dx, dy);
                 ctx->Scale(scale, scale);
+                fit = fit * Matrix3x3::Translate(dx, dy) * Matrix3x3::Scale(scale, scale);
             } else {
                 ctx->Scale(scaleX, scaleY);
+                fit = fit * Matrix3x3::Scale(scaleX, scaleY);
             }
             ctx->Translate(-document.ViewBox.x, -document.ViewBox.y);
+            fit = fit * Matrix3x3::Translate(-document.ViewBox.x, -document.ViewBox.y);
+        }
+
+        if (options.PixelRatio != 1.0f) {
+            ctx->Scale(options.PixelRatio, options.PixelRatio);
+            fit = fit * Matrix3x3::Scale(options.PixelRatio, options.PixelRatio);
         }
 
-        if (options.PixelRatio != 1.0f) ctx->Scale(options.PixelRatio, options.PixelRatio);
+        const Rect2Dd visible = cullOverride ? *cullOverride : options.ViewportBounds;
+        cullActive = options.EnableCulling && options.ClipToViewport && visible.width > 0 && visible.height > 0 &&
+                     std::abs(fit.Determinant()) >= 1e-10f;
+        cullSuspended = 0;
+        if (cullActive) cullRect = fit.Inverse().Transform(visible);
 
         if (document.BackgroundColor.has_value()) {
             ctx->SetFillPaint(document.BackgroundColor.value());
@@ -55,9 +126,7 @@ namespace UltraCanvas {
 
         ctx->PopState();
         currentDocument = nullptr;
-
-        auto endTime = std::chrono::high_resolution_clock::now();
-        stats.RenderTimeMs = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+        cullActive = false;
     }
 
     void VectorRenderer::RenderLayer(IRenderContext *context, const VectorLayer &layer) {
@@ -69,9 +138,7 @@ namespace UltraCanvas {
         currentOpacity = layerOpacity;
         ctx->SetAlpha(currentOpacity);
 
-        for (const auto &child: layer.Children) {
-            if (child) RenderElement(ctx, *child);
-        }
+        RenderChildren(layer);
 
         currentOpacity = opacityStack.top();
         opacityStack.pop();
@@ -80,11 +147,28 @@ namespace UltraCanvas {
 
     void VectorRenderer::RenderElement(IRenderContext *context, const VectorElement &element) {
         ctx = context;
+        RenderElementImpl(element, true);
+    }
+
+    // `testViewport` is false when the caller already culled the element
+    // through a container's BVH.
+    void VectorRenderer::RenderElementImpl(const VectorElement &element, bool testViewport) {
         if (!IsVisible(element)) return;
 
-        if (options.EnableCulling && options.ClipToViewport && !IsInViewport(element.GetBoundingBox())) {
-            stats.ElementsCulled++;
-            return;
+        if (testViewport && cullActive && cullSuspended == 0) {
+            const Rect2Dd bounds = element.GetBoundingBox();
+            if (!IsUnboundedRect(bounds) && !RectsIntersect(bounds, cullRect)) {
+                stats.ElementsCulled++;
+                return;
+            }
+        }
+
+        // Children are culled in the element's own space.
+        const Rect2Dd savedCull = cullRect;
+        bool suspended = false;
+        if (cullActive && IsContainer(element) && !IntoLocalSpace(element, cullRect)) {
+            cullSuspended++;
+            suspended = true;
         }
 
         ctx->PushState();
@@ -137,6 +221,24 @@ namespace UltraCanvas {
         if (options.ShowBoundingBoxes) RenderDebugBounds(element.GetBoundingBox());
         stats.ElementsRendered++;
         ctx->PopState();
+
+        cullRect = savedCull;
+        if (suspended) cullSuspended--;
+    }
+
+    void VectorRenderer::RenderChildren(const VectorGroup &container) {
+        const ContainerIndex *index = (cullActive && cullSuspended == 0) ? FindIndex(container) : nullptr;
+        if (!index) {
+            for (const auto &child: container.Children) if (child) RenderElementImpl(*child, true);
+            return;
+        }
+
+        std::vector<uint32_t> visible;
+        index->bvh.Query(cullRect, visible, &stats.BVHNodesVisited);
+        stats.ElementsCulledByBVH += static_cast<uint32_t>(container.Children.size() - visible.size());
+        for (uint32_t i: visible) {
+            if (const auto &child = container.Children[i]) RenderElementImpl(*child, false);
+        }
     }
 
     void VectorRenderer::RenderRect(const VectorRect &rect) {
@@ -278,7 +380,7 @@ namespace UltraCanvas {
         opacityStack.push(currentOpacity);
         currentOpacity *= group.Style.Opacity;
         ctx->SetAlpha(currentOpacity);
-        for (const auto &child: group.Children) if (child) RenderElement(ctx, *child);
+        RenderChildren(group);
         currentOpacity = opacityStack.top();
         opacityStack.pop();
     }
@@ -292,7 +394,10 @@ namespace UltraCanvas {
         Rect2Dd rb = ref->GetBoundingBox();
         if (use.Size.width > 0 && use.Size.height > 0 && rb.width > 0 && rb.height > 0)
             ctx->Scale(use.Size.width / rb.width, use.Size.height / rb.height);
-        RenderElement(ctx, *ref);
+        // Definitions live outside the document tree; render them without culling.
+        cullSuspended++;
+        RenderElementImpl(*ref, true);
+        cullSuspended--;
         ctx->PopState();
     }
 
@@ -472,7 +577,235 @@ namespace UltraCanvas {
         ctx->PopState();
     }
 
-    void VectorRenderer::ClearCaches() {}
+    void VectorRenderer::ClearCaches() {
+        spatialIndex.clear();
+        indexedDocument = nullptr;
+        tiles.clear();
+        tileIndex.clear();
+        tileBytes = 0;
+        tilesUnsupported = false;
+    }
+
+    // ===== SPATIAL INDEX =====
+
+    void VectorRenderer::EnsureSpatialIndex(const VectorDocument &document) {
+        if (indexedDocument == &document) return;
+        spatialIndex.clear();
+        indexedDocument = &document;
+        for (const auto &layer: document.Layers) if (layer) IndexContainer(*layer);
+    }
+
+    // Indexes `container` and everything below it; returns the bounds of its
+    // content in the container's own space ({} when unknown). The recursion
+    // computes each group's extent once instead of through the nested
+    // VectorGroup::GetBoundingBox calls.
+    Rect2Dd VectorRenderer::IndexContainer(const VectorGroup &container) {
+        std::vector<Rect2Dd> bounds(container.Children.size());
+        Rect2Dd content;
+        bool unbounded = false, first = true;
+
+        for (size_t i = 0; i < container.Children.size(); ++i) {
+            const auto &child = container.Children[i];
+            if (!child) continue;    // reported as unbounded; RenderChildren skips it
+            Rect2Dd b;
+            if (IsContainer(*child)) {
+                b = IndexContainer(static_cast<const VectorGroup &>(*child));
+                if (!IsUnboundedRect(b) && child->Transform.has_value()) b = child->Transform->Transform(b);
+            } else if (child->Type == VectorElementType::Use) {
+                // The referenced definition's extent isn't known here unless
+                // an explicit size is given.
+                const auto &use = static_cast<const VectorUse &>(*child);
+                if (use.Size.width > 0 && use.Size.height > 0) b = use.GetBoundingBox();
+            } else {
+                b = child->GetBoundingBox();    // includes the element's own transform
+            }
+            if (!IsUnboundedRect(b) && child->Style.Stroke.has_value()) {
+                const double half = child->Style.Stroke->Width * 0.5;
+                b = {b.x - half, b.y - half, b.width + 2 * half, b.height + 2 * half};
+            }
+            bounds[i] = b;
+            if (IsUnboundedRect(b)) {
+                unbounded = true;
+            } else {
+                content = first ? b : UnionRect(content, b);
+                first = false;
+            }
+        }
+
+        if (container.Children.size() >= options.SpatialIndexMinChildren) {
+            ContainerIndex &entry = spatialIndex[&container];
+            entry.childCount = container.Children.size();
+            entry.bvh.Build(bounds);
+        }
+        return unbounded || first ? Rect2Dd() : content;
+    }
+
+    const VectorRenderer::ContainerIndex *VectorRenderer::FindIndex(const VectorGroup &container) const {
+        if (!options.UseSpatialIndex) return nullptr;
+        auto it = spatialIndex.find(&container);
+        if (it == spatialIndex.end() || it->second.childCount != container.Children.size()) return nullptr;
+        return &it->second;
+    }
+
+    std::vector<const VectorElement *> VectorRenderer::HitTest(const VectorDocument &document, const Point2Dd &point) {
+        if (options.UseSpatialIndex) EnsureSpatialIndex(document);
+        std::vector<const VectorElement *> hits;
+        for (auto it = document.Layers.rbegin(); it != document.Layers.rend(); ++it)
+            if (*it && (*it)->Visible) HitTestContainer(**it, point, hits);
+        return hits;
+    }
+
+    void VectorRenderer::HitTestContainer(const VectorGroup &container, const Point2Dd &point,
+                                          std::vector<const VectorElement *> &hits) {
+        auto visit = [&](const VectorElement &child, bool inside) {
+            if (!child.Style.Visible) return;
+            if (inside) hits.push_back(&child);
+            if (!IsContainer(child)) return;
+            Point2Dd local = point;
+            if (child.Transform.has_value()) {
+                if (std::abs(child.Transform->Determinant()) < 1e-10f) return;
+                local = child.Transform->Inverse().Transform(point);
+            }
+            HitTestContainer(static_cast<const VectorGroup &>(child), local, hits);
+        };
+
+        if (const ContainerIndex *index = FindIndex(container)) {
+            std::vector<uint32_t> candidates;
+            index->bvh.QueryPoint(point, candidates);
+            for (auto it = candidates.rbegin(); it != candidates.rend(); ++it) {
+                const auto &child = container.Children[*it];
+                if (!child) continue;
+                // The query already tested the (stroke-inflated) bounds. An
+                // unknown extent is no hit of its own, but its children may be.
+                visit(*child, !IsUnboundedRect(index->bvh.GetItemBounds(*it)));
+            }
+            return;
+        }
+        for (auto it = container.Children.rbegin(); it != container.Children.rend(); ++it) {
+            if (!*it) continue;
+            const bool inside = HitTestElement(**it, point);
+            // Without an index a group is only entered when its bounds hit.
+            if (inside || IsUnboundedRect((*it)->GetBoundingBox()) || !IsContainer(**it)) visit(**it, inside);
+        }
+    }
+
+    // ===== TILE CACHE =====
+
+    void VectorRenderer::RenderDocumentCached(IRenderContext *context, const VectorDocument &document,
+                                              const Point2Dd &canvasOrigin, float zoom, const Rect2Dd &visibleRect) {
+        auto startTime = std::chrono::high_resolution_clock::now();
+        stats.Reset();
+        if (!context || zoom <= 0 || visibleRect.width <= 0 || visibleRect.height <= 0) return;
+
+        const double tileSize = std::max(16, options.TileSize);
+        const bool useTiles = options.EnableTileCache && !tilesUnsupported;
+
+        if (useTiles) {
+            ++tileFrame;
+            // Tiles are laid out on the zoomed document plane, so the same
+            // tiles serve every pan offset at this zoom.
+            const Rect2Dd area(visibleRect.x - canvasOrigin.x, visibleRect.y - canvasOrigin.y,
+                               visibleRect.width, visibleRect.height);
+            const int tx0 = static_cast<int>(std::floor(area.x / tileSize));
+            const int ty0 = static_cast<int>(std::floor(area.y / tileSize));
+            const int tx1 = static_cast<int>(std::ceil((area.x + area.width) / tileSize));
+            const int ty1 = static_cast<int>(std::ceil((area.y + area.height) / tileSize));
+
+            TileKey key{&document, FloatBits(zoom), 0, 0, 0};
+            key.viewBits = FloatBits(static_cast<float>(options.ViewportBounds.width)) * 31u +
+                           FloatBits(static_cast<float>(options.ViewportBounds.height)) * 17u +
+                           FloatBits(options.PixelRatio);
+
+            bool composited = true;
+            for (int ty = ty0; ty < ty1 && composited; ++ty) {
+                for (int tx = tx0; tx < tx1; ++tx) {
+                    key.tx = tx;
+                    key.ty = ty;
+                    Tile *tile = AcquireTile(context, document, key, zoom);
+                    const Point2Dd pos(std::round(canvasOrigin.x + tx * tileSize),
+                                       std::round(canvasOrigin.y + ty * tileSize));
+                    if (!tile || !context->DrawContextSurface(*tile->context, pos)) {
+                        composited = false;
+                        break;
+                    }
+                    stats.TilesComposited++;
+                }
+            }
+            EvictTiles();
+            if (composited) {
+                auto endTime = std::chrono::high_resolution_clock::now();
+                stats.RenderTimeMs = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+                return;
+            }
+            // The backend can't paint offscreen contexts (or the budget is
+            // too small for a single tile): render directly from now on.
+            tilesUnsupported = true;
+            tiles.clear();
+            tileIndex.clear();
+            tileBytes = 0;
+            stats.Reset();
+        }
+
+        context->PushState();
+        context->Translate(canvasOrigin.x, canvasOrigin.y);
+        context->Scale(zoom, zoom);
+        const Rect2Dd visible((visibleRect.x - canvasOrigin.x) / zoom, (visibleRect.y - canvasOrigin.y) / zoom,
+                              visibleRect.width / zoom, visibleRect.height / zoom);
+        RenderDocumentPass(context, document, &visible);
+        context->PopState();
+
+        auto endTime = std::chrono::high_resolution_clock::now();
+        stats.RenderTimeMs = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+    }
+
+    VectorRenderer::Tile *VectorRenderer::AcquireTile(IRenderContext *target, const VectorDocument &document,
+                                                      const TileKey &key, float zoom) {
+        auto found = tileIndex.find(key);
+        if (found != tileIndex.end()) {
+            tiles.splice(tiles.begin(), tiles, found->second);
+            tiles.front().lastFrame = tileFrame;
+            return &tiles.front();
+        }
+
+        const int size = std::max(16, options.TileSize);
+        const double scale = target->GetDeviceScale();
+        const size_t bytes = static_cast<size_t>(std::ceil(size * scale)) *
+                             static_cast<size_t>(std::ceil(size * scale)) * 4u;
+        if (bytes > options.TileCacheBudgetBytes) return nullptr;
+
+        auto tileContext = CreateRenderContext(Size2Di(size, size), target->GetNativeSurface());
+        if (!tileContext) return nullptr;
+
+        tileContext->Clear(Colors::Transparent);
+        tileContext->PushState();
+        tileContext->Translate(-key.tx * static_cast<double>(size), -key.ty * static_cast<double>(size));
+        tileContext->Scale(zoom, zoom);
+        const Rect2Dd area(key.tx * static_cast<double>(size) / zoom, key.ty * static_cast<double>(size) / zoom,
+                           size / static_cast<double>(zoom), size / static_cast<double>(zoom));
+        RenderDocumentPass(tileContext.get(), document, &area);
+        tileContext->PopState();
+        stats.TilesRendered++;
+        ctx = target;
+
+        tiles.emplace_front();
+        Tile &tile = tiles.front();
+        tile.key = key;
+        tile.context = std::move(tileContext);
+        tile.bytes = bytes;
+        tile.lastFrame = tileFrame;
+        tileIndex[key] = tiles.begin();
+        tileBytes += bytes;
+        return &tile;
+    }
+
+    void VectorRenderer::EvictTiles() {
+        // Tiles drawn this frame stay even over budget; they're on screen.
+        while (tileBytes > options.TileCacheBudgetBytes && !tiles.empty() && tiles.back().lastFrame != tileFrame) {
+            tileBytes -= tiles.back().bytes;
+            tileIndex.erase(tiles.back().key);
+            tiles.pop_back();
+        }
+    }
 
     bool HitTestElement(const VectorElement &e, const Point2Dd &p) {
         Rect2Dd b = e.GetBoundingBox();
@@ -1,19 +1,26 @@
 // UltraCanvasVectorRenderer.h
 // Vector Graphics Rendering for UltraCanvas
-// Version: 2.0.0
-// Last Modified: 2025-01-20
+// Version: 2.1.0
+// Last Modified: 2026-10-18
 // Author: UltraCanvas Framework
 //
 // REFACTORED: Removed IVectorRenderer, IVectorVisitor, SoftwareVectorRenderer,
 // HardwareVectorRenderer, CairoVectorRenderer, VectorRendererFactory.
 // Single VectorRenderer class using IRenderContext.
+//
+// 2.1: containers with many children are culled and hit-tested through a
+// BVH (UltraCanvasVectorSpatialIndex.h); RenderDocumentCached can serve
+// repaints from raster tiles kept per zoom level.
 #pragma once
 
 #include "UltraCanvasVectorStorage.h"
+#include "UltraCanvasVectorSpatialIndex.h"
 #include "UltraCanvasRenderContext.h"
 #include <stack>
 #include <memory>
 #include <chrono>
+#include <list>
+#include <unordered_map>
 
 namespace UltraCanvas {
 
@@ -31,16 +38,34 @@ namespace UltraCanvas {
         float PixelRatio = 1.0f;
         bool ShowBoundingBoxes = false;
         Color DebugColor = Color(255, 0, 255, 128);
+
+        // Cull through a BVH in every container with at least this many
+        // children. Indexes are built on the first render of a document;
+        // call ClearCaches() after editing it.
+        bool UseSpatialIndex = true;
+        uint32_t SpatialIndexMinChildren = 32;
+
+        // RenderDocumentCached: keep rasterized tiles per zoom level, so a
+        // pan only renders the newly exposed tiles. Tiles are device pixels
+        // of TileSize x TileSize; the least recently drawn are dropped above
+        // the byte budget.
+        bool EnableTileCache = false;
+        int TileSize = 256;
+        size_t TileCacheBudgetBytes = 64u * 1024u * 1024u;
     };
 
 // ===== RENDER STATISTICS =====
 
     struct VectorRenderStats {
         uint32_t ElementsRendered = 0;
-        uint32_t ElementsCulled = 0;
+        uint32_t ElementsCulled = 0;         // rejected one by one (containers without a BVH)
+        uint32_t ElementsCulledByBVH = 0;    // never visited: skipped by a container's BVH
+        uint32_t BVHNodesVisited = 0;
         uint32_t PathCommandsProcessed = 0;
+        uint32_t TilesComposited = 0;        // RenderDocumentCached: tiles drawn
+        uint32_t TilesRendered = 0;          // ... of which rasterized this frame
         double RenderTimeMs = 0.0;
-        void Reset() { ElementsRendered=0; ElementsCulled=0; PathCommandsProcessed=0; RenderTimeMs=0; }
+        void Reset() { *this = VectorRenderStats(); }
     };
 
 // ===== VECTOR RENDERER =====
@@ -54,12 +79,55 @@ namespace UltraCanvas {
         void RenderElement(IRenderContext* ctx, const VectorElement& element);
         void RenderLayer(IRenderContext* ctx, const VectorLayer& layer);
 
+        // Renders `document` scaled by `zoom` with its origin at `canvasOrigin`
+        // (ctx coordinates), culled to `visibleRect` (ctx coordinates). With
+        // EnableTileCache the visible tiles are composited from the cache and
+        // only missing ones are rasterized; panning keeps canvasOrigin moving
+        // at a fixed zoom and reuses them. Falls back to direct rendering when
+        // the backend can't composite offscreen surfaces.
+        void RenderDocumentCached(IRenderContext* ctx, const VectorDocument& document,
+                                  const Point2Dd& canvasOrigin, float zoom, const Rect2Dd& visibleRect);
+
+        // Elements whose bounds contain `point` (document coordinates), topmost
+        // first, each group before its children. Uses the spatial index.
+        std::vector<const VectorElement*> HitTest(const VectorDocument& document, const Point2Dd& point);
+
         void SetOptions(const VectorRenderOptions& opts) { options = opts; }
         const VectorRenderOptions& GetOptions() const { return options; }
         const VectorRenderStats& GetStats() const { return stats; }
+        size_t GetTileCacheBytes() const { return tileBytes; }
+
+        // Drops spatial indexes and cached tiles. Required after the document
+        // (or anything else that changes its rendering) was modified.
         void ClearCaches();
 
     private:
+        struct ContainerIndex {
+            size_t childCount = 0;
+            VectorBVH bvh;
+        };
+
+        struct TileKey {
+            const VectorDocument* document;
+            uint32_t zoomBits;
+            uint32_t viewBits;          // hash of viewport size / pixel ratio (document fit)
+            int32_t tx;
+            int32_t ty;
+            bool operator==(const TileKey& o) const {
+                return document == o.document && zoomBits == o.zoomBits && viewBits == o.viewBits &&
+                       tx == o.tx && ty == o.ty;
+            }
+        };
+        struct TileKeyHash {
+            size_t operator()(const TileKey& k) const;
+        };
+        struct Tile {
+            TileKey key;
+            std::unique_ptr<IRenderContext> context;
+            size_t bytes = 0;
+            uint64_t lastFrame = 0;
+        };
+
         IRenderContext* ctx = nullptr;
         VectorRenderOptions options;
         VectorRenderStats stats;
@@ -67,6 +135,33 @@ namespace UltraCanvas {
         float currentOpacity = 1.0f;
         const VectorDocument* currentDocument = nullptr;
 
+        // Culling state: the visible area in the current container's space.
+        bool cullActive = false;
+        int cullSuspended = 0;
+        Rect2Dd cullRect;
+
+        std::unordered_map<const VectorGroup*, ContainerIndex> spatialIndex;
+        const VectorDocument* indexedDocument = nullptr;
+
+        std::list<Tile> tiles;      // most recently drawn first
+        std::unordered_map<TileKey, std::list<Tile>::iterator, TileKeyHash> tileIndex;
+        size_t tileBytes = 0;
+        uint64_t tileFrame = 0;
+        bool tilesUnsupported = false;
+
+        void RenderDocumentPass(IRenderContext* context, const VectorDocument& document,
+                                const Rect2Dd* cullOverride);
+        void RenderElementImpl(const VectorElement& element, bool testViewport);
+        void RenderChildren(const VectorGroup& container);
+        void EnsureSpatialIndex(const VectorDocument& document);
+        Rect2Dd IndexContainer(const VectorGroup& container);
+        const ContainerIndex* FindIndex(const VectorGroup& container) const;
+        void HitTestContainer(const VectorGroup& container, const Point2Dd& point,
+                              std::vector<const VectorElement*>& hits);
+        Tile* AcquireTile(IRenderContext* target, const VectorDocument& document, const TileKey& key,
+                          float zoom);
+        void EvictTiles();
+
         void RenderRect(const VectorRect& rect);
         void RenderCircle(const VectorCircle& circle);
         void RenderEllipse(const VectorEllipse& ellipse);
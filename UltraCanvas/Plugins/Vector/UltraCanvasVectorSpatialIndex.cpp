@@ -0,0 +1,126 @@
+// UltraCanvasVectorSpatialIndex.cpp
+// Bounding-volume hierarchy over vector document elements
+// Version: 1.0.0
+// Last Modified: 2026-10-18
+// Author: UltraCanvas Framework
+
+#include "UltraCanvasVectorSpatialIndex.h"
+#include <algorithm>
+
+namespace UltraCanvas {
+
+    namespace {
+        bool IsUnbounded(const Rect2Dd& r) {
+            return r.x == 0 && r.y == 0 && r.width == 0 && r.height == 0;
+        }
+    }
+
+    void VectorBVH::Clear() {
+        nodes.clear();
+        items.clear();
+        itemRects.clear();
+        unbounded.clear();
+        itemCount = 0;
+    }
+
+    void VectorBVH::Build(const std::vector<Rect2Dd>& itemBounds) {
+        Clear();
+        itemCount = itemBounds.size();
+        itemRects = itemBounds;
+        items.reserve(itemCount);
+        for (uint32_t i = 0; i < itemCount; ++i) {
+            if (IsUnbounded(itemBounds[i])) unbounded.push_back(i);
+            else items.push_back(i);
+        }
+        if (items.empty()) return;
+        nodes.reserve(2 * (items.size() / kLeafSize + 1));
+        BuildNode(0, static_cast<uint32_t>(items.size()));
+    }
+
+    uint32_t VectorBVH::BuildNode(uint32_t begin, uint32_t end) {
+        const uint32_t index = static_cast<uint32_t>(nodes.size());
+        nodes.push_back(Node{0, 0, 0, 0, begin, end, 0});
+
+        double minX = itemRects[items[begin]].x, minY = itemRects[items[begin]].y;
+        double maxX = minX, maxY = minY;
+        double cMinX = minX, cMinY = minY, cMaxX = minX, cMaxY = minY;
+        for (uint32_t i = begin; i < end; ++i) {
+            const Rect2Dd& r = itemRects[items[i]];
+            minX = std::min(minX, r.x);
+            minY = std::min(minY, r.y);
+            maxX = std::max(maxX, r.x + r.width);
+            maxY = std::max(maxY, r.y + r.height);
+            const double cx = r.x + r.width * 0.5, cy = r.y + r.height * 0.5;
+            if (i == begin) { cMinX = cMaxX = cx; cMinY = cMaxY = cy; }
+            cMinX = std::min(cMinX, cx); cMaxX = std::max(cMaxX, cx);
+            cMinY = std::min(cMinY, cy); cMaxY = std::max(cMaxY, cy);
+        }
+        nodes[index].minX = minX;
+        nodes[index].minY = minY;
+        nodes[index].maxX = maxX;
+        nodes[index].maxY = maxY;
+
+        if (end - begin <= kLeafSize) return index;
+
+        // Median split across the longer extent of the item centers.
+        const bool splitX = (cMaxX - cMinX) >= (cMaxY - cMinY);
+        const uint32_t mid = begin + (end - begin) / 2;
+        std::nth_element(items.begin() + begin, items.begin() + mid, items.begin() + end,
+                         [&](uint32_t a, uint32_t b) {
+                             const Rect2Dd& ra = itemRects[a];
+                             const Rect2Dd& rb = itemRects[b];
+                             return splitX ? (ra.x * 2 + ra.width) < (rb.x * 2 + rb.width)
+                                           : (ra.y * 2 + ra.height) < (rb.y * 2 + rb.height);
+                         });
+        BuildNode(begin, mid);
+        const uint32_t right = BuildNode(mid, end);
+        nodes[index].right = right;
+        return index;
+    }
+
+    Rect2Dd VectorBVH::GetBounds() const {
+        if (nodes.empty()) return {0, 0, 0, 0};
+        const Node& root = nodes[0];
+        return {root.minX, root.minY, root.maxX - root.minX, root.maxY - root.minY};
+    }
+
+    void VectorBVH::Query(const Rect2Dd& rect, std::vector<uint32_t>& out, uint32_t* nodesVisited) const {
+        out.clear();
+        out.insert(out.end(), unbounded.begin(), unbounded.end());
+        if (!nodes.empty()) {
+            const double qMinX = rect.x, qMinY = rect.y;
+            const double qMaxX = rect.x + rect.width, qMaxY = rect.y + rect.height;
+            uint32_t visited = 0;
+            uint32_t stack[64];
+            int top = 0;
+            stack[top++] = 0;
+            while (top > 0) {
+                const Node& node = nodes[stack[--top]];
+                ++visited;
+                if (node.maxX < qMinX || node.minX > qMaxX || node.maxY < qMinY || node.minY > qMaxY) continue;
+                const bool contained = node.minX >= qMinX && node.maxX <= qMaxX &&
+                                       node.minY >= qMinY && node.maxY <= qMaxY;
+                if (contained) {
+                    out.insert(out.end(), items.begin() + node.itemBegin, items.begin() + node.itemEnd);
+                } else if (node.right == 0) {
+                    for (uint32_t i = node.itemBegin; i < node.itemEnd; ++i) {
+                        const Rect2Dd& r = itemRects[items[i]];
+                        if (r.x + r.width < qMinX || r.x > qMaxX || r.y + r.height < qMinY || r.y > qMaxY) continue;
+                        out.push_back(items[i]);
+                    }
+                } else {
+                    const uint32_t self = static_cast<uint32_t>(&node - nodes.data());
+                    stack[top++] = node.right;
+                    stack[top++] = self + 1;
+                }
+            }
+            if (nodesVisited) *nodesVisited += visited;
+        }
+        std::sort(out.begin(), out.end());
+    }
+
+    void VectorBVH::QueryPoint(const Point2Dd& point, std::vector<uint32_t>& out) const {
+        Query(Rect2Dd(point.x, point.y, 0, 0), out);
+    }
+
+} // namespace UltraCanvas
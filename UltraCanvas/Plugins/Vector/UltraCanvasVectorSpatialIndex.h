@@ -0,0 +1,58 @@
+// UltraCanvasVectorSpatialIndex.h
+// Bounding-volume hierarchy over vector document elements
+// Version: 1.0.0
+// Last Modified: 2026-10-18
+// Author: UltraCanvas Framework
+#pragma once
+
+#include "UltraCanvasCommonTypes.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace UltraCanvas {
+
+// ===== BOUNDING-VOLUME HIERARCHY =====
+// Static BVH over a list of rectangles (a container's children), built top
+// down by median splits. Queries return item indices in ascending order, so
+// a renderer can draw the hits in paint order and a hit-tester can walk them
+// back to front. Items with unknown extent (an all-zero rect) are always
+// reported.
+
+    class VectorBVH {
+    public:
+        static constexpr uint32_t kLeafSize = 8;
+
+        void Build(const std::vector<Rect2Dd>& itemBounds);
+        void Clear();
+
+        size_t GetItemCount() const { return itemCount; }
+        size_t GetNodeCount() const { return nodes.size(); }
+        Rect2Dd GetBounds() const;
+        const Rect2Dd& GetItemBounds(uint32_t item) const { return itemRects[item]; }
+
+        // Items whose rect intersects `rect` (edges touching count), sorted.
+        // `nodesVisited`, when given, is increased by the nodes tested.
+        void Query(const Rect2Dd& rect, std::vector<uint32_t>& out, uint32_t* nodesVisited = nullptr) const;
+        void QueryPoint(const Point2Dd& point, std::vector<uint32_t>& out) const;
+
+    private:
+        // A subtree's items are the contiguous range [itemBegin, itemEnd) of
+        // `items`. Inner nodes have their left child right after them.
+        struct Node {
+            double minX, minY, maxX, maxY;
+            uint32_t itemBegin;
+            uint32_t itemEnd;
+            uint32_t right;     // 0 for leaves (the root is never a right child)
+        };
+
+        std::vector<Node> nodes;
+        std::vector<uint32_t> items;         // bounded item ids, grouped by subtree
+        std::vector<Rect2Dd> itemRects;      // by item id
+        std::vector<uint32_t> unbounded;
+        size_t itemCount = 0;
+
+        uint32_t BuildNode(uint32_t begin, uint32_t end);
+    };
+
+} // namespace UltraCanvas
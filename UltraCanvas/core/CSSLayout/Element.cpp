@@ -1,5 +1,6 @@
 // core/CSSLayout/Element.cpp
 // Element base: measure-cache wrapper, default block layout, arrange dispatch.
+// Version: 1.6.0 - Measure reports cache misses to the installed LayoutProbe.
 // Version: 1.5.2 - position:fixed children in ArrangeBlock go through
 //                 ArrangeFixedChild so their finalBounds stay parent-relative
 //                 (no double ancestor offset for a fixed element below the root).
@@ -8,7 +9,7 @@
 //                 size, so a stretched/grown container reports and lays out its
 //                 children against its used size. Single-axis Exact (block fill
 //                 hint) still lets an explicit size win.
-// Last Modified: 2026-07-13
+// Last Modified: 2026-10-18
 // Author: UltraCanvas Framework
 
 #include "CSSLayout/CSSLayout.h"
@@ -203,6 +204,8 @@ namespace UltraCanvas {
             // its stale cached size. (Constraint-only keying was correct only while
             // resolveDimension ignored ctx.)
             if (measured.valid && measured.key == c && measured.ctxKey == ctx) return;
+            LayoutProbe* probe = LayoutProbe::Installed();
+            const bool probed = probe && probe->BeginMeasure(*this);
             if (!intrinsic.valid) {
                 ComputeIntrinsicSizes(ctx);
                 intrinsic.valid = true;
@@ -232,6 +235,7 @@ namespace UltraCanvas {
             measured.key = c;
             measured.ctxKey = ctx;
             measured.valid = true;
+            if (probed) probe->EndMeasure(*this);
         }
 
         void Element::ComputeIntrinsicSizes(const LayoutContext& /*ctx*/) {
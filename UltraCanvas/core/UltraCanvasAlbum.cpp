@@ -1,8 +1,10 @@
 // core/UltraCanvasAlbum.cpp
 // Photo / video / music album widget with selectable layout designs, per-item
 // crop / zoom / stretch fitting, action icons and visitor / edit / admin modes.
-// Version: 1.7.0
-// Last Modified: 2026-08-11
+// Version: 1.8.0
+// Last Modified: 2026-10-18
+// V1.8.0: Poster frames go through the persistent XDG thumbnail store when
+//   AlbumConfig::persistentVideoPosters is on.
 // V1.7.0: Video tiles extract their own poster frame (AlbumConfig::
 //   videoPosterFrames) — a Video item with no thumbnailPath gets one frame of
 //   the clip decoded on a background worker and cached in memory, so the tile
@@ -57,7 +59,10 @@
 #include "UltraCanvasTooltipManager.h"
 #include "UltraCanvasVideoHoverPreview.h"
 #include "UltraCanvasVideoThumbnail.h"
+#include "UltraCanvasVideoDevices.h"
 #include "UltraCanvasImageAnimation.h"
+#include "UltraCanvasThumbnailStore.h"
+#include "../libspecific/Cairo/PngPixmapCodec.h"
 #include <algorithm>
 #include <cmath>
 
@@ -371,6 +376,7 @@ namespace UltraCanvas {
         req.path    = item.mediaPath;
         req.maxSize = std::max(16, config.videoPosterMaxSize);
         req.timeSec = config.videoPosterTimeSec;
+        req.persistent = config.persistentVideoPosters;
 
         std::lock_guard<std::mutex> lk(posterMutex);
         auto it = posterSlots.find(req.path);
@@ -422,12 +428,9 @@ namespace UltraCanvas {
 
             // The expensive part, outside the lock. Returns null with the null
             // video backend (ULTRACANVAS_ENABLE_VIDEO=OFF) or an undecodable
-            // source — recorded as Failed so it is asked for only once.
-            VideoThumbnailRequest vreq;
-            vreq.maxWidth    = req.maxSize;
-            vreq.maxHeight   = req.maxSize;
-            vreq.timeSeconds = req.timeSec;
-            std::shared_ptr<UCPixmap> pm = CaptureVideoThumbnailPixmap(req.path, vreq);
+            // source — recorded as Failed so it is asked for only once per
+            // session (only the latter goes into the persistent fail cache).
+            std::shared_ptr<UCPixmap> pm = ProducePosterPixmap(req);
             const bool ready = pm && pm->IsValid() &&
                                pm->GetWidth() > 0 && pm->GetHeight() > 0;
 
@@ -446,6 +449,47 @@ namespace UltraCanvas {
         }
     }
 
+    std::shared_ptr<UCPixmap> UltraCanvasAlbum::ProducePosterPixmap(
+            const PosterRequest& req) const {
+        VideoThumbnailRequest vreq;
+        vreq.maxWidth    = req.maxSize;
+        vreq.maxHeight   = req.maxSize;
+        vreq.timeSeconds = req.timeSec;
+        ThumbnailStore::Flavor flavor;
+        if (!req.persistent || req.timeSec >= 0.0f ||
+            !ThumbnailStore::FlavorForEdge(req.maxSize, flavor)) {
+            return CaptureVideoThumbnailPixmap(req.path, vreq);
+        }
+
+        // Stored frames are larger than the poster box; shrink them without
+        // polluting the shared pixmap cache (one-shot in-memory images).
+        auto fromPng = [&req](const std::vector<uint8_t>& png) -> std::shared_ptr<UCPixmap> {
+            auto stored = UCImage::LoadFromMemory(png);
+            if (!stored || !stored->IsValid()) return nullptr;
+            return stored->CreatePixmap(req.maxSize, req.maxSize, ImageFitMode::ScaleDown);
+        };
+        std::vector<uint8_t> png;
+        if (ThumbnailStore::Lookup(req.path, req.maxSize, png)) {
+            if (auto pm = fromPng(png)) return pm;
+        }
+        if (ThumbnailStore::HasFailed(req.path)) return nullptr;
+
+        // Miss: grab the frame at the flavor's size, which is what the cache
+        // (and every other reader of it) expects, then derive the poster.
+        vreq.maxWidth = vreq.maxHeight = ThumbnailStore::FlavorEdge(flavor);
+        std::shared_ptr<UCPixmap> frame = CaptureVideoThumbnailPixmap(req.path, vreq);
+        if (!frame || !frame->IsValid()) {
+            // Without a video backend nothing was decoded, so nothing failed.
+            if (UltraCanvasVideoDevices::IsAvailable()) ThumbnailStore::MarkFailed(req.path);
+            return nullptr;
+        }
+        png = PngEncodePixmap(*frame);
+        if (png.empty()) return frame;
+        ThumbnailStore::Store(req.path, flavor, png);
+        auto pm = fromPng(png);
+        return pm ? pm : frame;
+    }
+
     void UltraCanvasAlbum::DropVideoPosters() {
         // Called when the item list is replaced wholesale, so cached frames for
         // clips that are gone do not hold memory for the album's lifetime. A
@@ -1,7 +1,7 @@
 // UltraCanvasApplication.cpp
 // Main UltraCanvas App
-// Version: 1.5.2 - modal fixes: close transient children with parent, ignore unmapped modals, raise modal on outside click
-// Last Modified: 2026-07-21
+// Version: 1.6.0 - frame pacing (refresh-capped repaints, frame budget, frame stats) and event coalescing
+// Last Modified: 2026-10-18
 // Author: UltraCanvas Framework
 
 #include <algorithm>
@@ -14,6 +14,7 @@
 #include "UltraCanvasApplication.h"
 #include "UltraCanvasClipboard.h"
 #include "UltraCanvasTooltipManager.h"
+#include "UltraCanvasImageDecodeService.h"
 #include "UltraCanvasModalDialog.h"
 #include "UltraCanvasConfig.h"
 #include "UltraCanvasUtils.h"
@@ -80,9 +81,21 @@ namespace UltraCanvas {
             std::lock_guard<std::mutex> lk(postedTasksMutex_);
             local.swap(postedTasks_);
         }
-        for (auto& fn : local) {
+        const bool budgeted = workDeadline_ != std::chrono::steady_clock::time_point::max();
+        for (size_t i = 0; i < local.size(); i++) {
+            if (budgeted && i > 0 && std::chrono::steady_clock::now() > workDeadline_) {
+                // Frame budget spent: the rest runs next frame, in order and
+                // ahead of anything posted meanwhile. GetEventLoopTimeout sees
+                // the non-empty queue and does not block.
+                std::lock_guard<std::mutex> lk(postedTasksMutex_);
+                postedTasks_.insert(postedTasks_.begin(),
+                                    std::make_move_iterator(local.begin() + i),
+                                    std::make_move_iterator(local.end()));
+                frameStats_.deferredTasks += local.size() - i;
+                break;
+            }
             try {
-                fn();
+                local[i]();
             } catch (const std::exception& e) {
                 std::cerr << "UltraCanvas PostToUIThread task threw: "
                           << e.what() << std::endl;
@@ -509,6 +522,13 @@ namespace UltraCanvas {
         // Factored out of Run() so a host embedding UltraCanvas under its own event
         // loop (e.g. Ladybird's Core::EventLoop bridge) can drive one iteration.
         CollectAndProcessNativeEvents();
+
+        // With frame pacing, this iteration renders only when the next frame
+        // is due; otherwise GetEventLoopTimeout wakes the loop for it.
+        const auto iterationStart = std::chrono::steady_clock::now();
+        const bool frameDue = !framePacing_ || iterationStart >= nextFrameTime_;
+        if (framePacing_) workDeadline_ = iterationStart + frameBudget_;
+
         ProcessEvents();
         ProcessTimers();
         ProcessPostedTasks();
@@ -517,12 +537,15 @@ namespace UltraCanvas {
             return (w->GetState() == WindowState::Closed && w->GetConfig().deleteOnClose);
         });
 
-        for (auto it = windows.begin(); it != windows.end(); it++) {
-            auto window = it->get();
-            if (window->IsVisible()) {
-                window->UpdateAndRender();
-            }
+        if (frameDue) {
+            RenderFrame(iterationStart);
+        } else if (std::any_of(windows.begin(), windows.end(),
+                               [](const auto& w) { return w->IsVisible() && w->NeedsRender(); })) {
+            // Nothing to draw, nothing pending: an idle loop sleeps until
+            // the next event instead of waking for an empty frame.
+            framePending_ = true;
         }
+        workDeadline_ = std::chrono::steady_clock::time_point::max();
 
         // Clean up stale modal windows (expired weak_ptrs)
         activeModalWindows.erase(
@@ -586,6 +609,8 @@ namespace UltraCanvas {
         ShutdownClipboard();
         ShutdownNative();
 
+        // Decode workers use libvips: stop them before it goes away.
+        UCImageDecodeService::GetInstance().Shutdown();
         UCImage::ShutdownImageSubsysterm();
     }
 
@@ -619,6 +644,45 @@ namespace UltraCanvas {
         WakeUpEventLoop();
     }
 
+    namespace {
+        // Consecutive events that a later one makes redundant: pointer moves
+        // and resizes (only the last position / size matters). Wheel events
+        // are never merged: most handlers step once per event by the sign of
+        // wheelDelta, so a summed delta would drop notches.
+        bool CanCoalesce(const UCEvent& last, const UCEvent& next) {
+            if (last.type != next.type || last.nativeWindowHandle != next.nativeWindowHandle) return false;
+            if (last.shift != next.shift || last.ctrl != next.ctrl ||
+                last.alt != next.alt || last.meta != next.meta) {
+                return false;
+            }
+            switch (next.type) {
+                case UCEventType::MouseMove:
+                case UCEventType::WindowResize:
+                    return true;
+                default:
+                    return false;
+            }
+        }
+    }
+
+    void UltraCanvasApplicationBase::PushEventCoalesced(const UCEvent& event) {
+        {
+            std::lock_guard<std::mutex> lock(eventQueueMutex);
+            if (eventCoalescing_ && !eventQueue.empty() && CanCoalesce(eventQueue.back(), event)) {
+                UCEvent& last = eventQueue.back();
+                const auto firstTimestamp = last.timestamp;
+                last = event;
+                // Latency counts from the first of the merged events.
+                last.timestamp = firstTimestamp;
+                frameStats_.coalescedEvents++;
+            } else {
+                eventQueue.push_back(event);
+            }
+        }
+        eventCondition.notify_one();
+        WakeUpEventLoop();
+    }
+
     bool UltraCanvasApplicationBase::PopEvent(UCEvent& event) {
         std::lock_guard<std::mutex> lock(eventQueueMutex);
         if (eventQueue.empty()) {
@@ -639,6 +703,9 @@ namespace UltraCanvas {
             if (!running) {
                 break;
             }
+            if (event.IsMouseEvent() || event.IsKeyboardEvent()) {
+                pendingInputSince_ = std::min(pendingInputSince_, event.timestamp);
+            }
             DispatchEvent(event);
 
             if (event.type == UCEventType::MouseUp && capturedMouseButtonDown == event.button) {
@@ -1354,68 +1421,38 @@ namespace UltraCanvas {
         timer.active = true;
         timer.nextFire = std::chrono::steady_clock::now() + timer.interval;
         timer.callback = std::move(callback);
-        timers_.push_back(std::move(timer));
+        timers_.Add(std::move(timer));
         WakeUpEventLoop();
-        return timers_.back().id;
+        return nextTimerId_ - 1;
     }
 
     void UltraCanvasApplicationBase::StopTimer(TimerId id) {
         std::lock_guard<std::mutex> lock(timersMutex_);
-        for (auto& timer : timers_) {
-            if (timer.id == id) {
-                timer.active = false;
-                return;
-            }
-        }
+        timers_.Remove(id);
+    }
+
+    void UltraCanvasApplicationBase::SetTimerCoalescingSlack(unsigned int milliseconds) {
+        std::lock_guard<std::mutex> lock(timersMutex_);
+        timers_.SetCoalescingSlack(std::chrono::milliseconds(milliseconds));
     }
 
     void UltraCanvasApplicationBase::ProcessTimers() {
         auto now = std::chrono::steady_clock::now();
 
-        // Collect the work to run for timers that are due. We must NOT invoke
-        // callbacks (or touch a timers_ element) while iterating: callbacks are
-        // documented to call StartTimer()/StopTimer() from any thread, and
-        // StartTimer() does timers_.push_back() which can reallocate the vector.
-        // So we snapshot each due timer's id + callback under the lock, advance
-        // or deactivate the timer in place (still under the lock), and only run
-        // the callbacks after the lock is released. A null callback means push a
-        // Timer UCEvent instead. Timers added during callbacks appear next round.
-        std::vector<std::pair<TimerId, std::function<void(TimerId)>>> due;
+        // Collect the work to run for timers that are due, under the lock, and
+        // run it only after the lock is released: callbacks are documented to
+        // call StartTimer()/StopTimer() from any thread. The queue re-arms
+        // periodic timers and drops one-shots while collecting; a callback
+        // that stops its own periodic timer removes it from the queue, so it
+        // never fires again. A null callback means push a Timer UCEvent
+        // instead. Timers added during callbacks appear next round.
+        UltraCanvasTimerQueue::DueList due;
         {
             std::lock_guard<std::mutex> lock(timersMutex_);
-            for (auto& timer : timers_) {
-                if (!timer.active) continue;
-                if (timer.nextFire > now) continue;
-
-                due.emplace_back(timer.id, timer.callback);
-
-                // Advance (periodic) or deactivate (one-shot). If a collected
-                // callback later calls StopTimer() on its own periodic timer, it
-                // marks active=false and the timer is cleaned up next round, so a
-                // self-stopped timer never fires again.
-                if (timer.periodic) {
-                    timer.nextFire += timer.interval;
-                    // If we fell behind, skip to next future fire time
-                    if (timer.nextFire <= now) {
-                        auto elapsed = now - timer.nextFire;
-                        auto periods = elapsed / timer.interval + 1;
-                        timer.nextFire += timer.interval * periods;
-                    }
-                } else {
-                    timer.active = false;
-                }
-            }
-
-            // Clean up inactive timers (safe: everything needed is already in `due`)
-            timers_.erase(
-                std::remove_if(timers_.begin(), timers_.end(),
-                               [](const UltraCanvasTimer& t) { return !t.active; }),
-                timers_.end());
+            if (timers_.NextDeadline() > now + timers_.GetCoalescingSlack()) return;
+            timers_.CollectDue(now, due);
         }
 
-        // Run callbacks / push events without holding timersMutex_, so a callback
-        // is free to call StartTimer()/StopTimer() without deadlocking, and no
-        // timers_ element is accessed across a callback.
         for (auto& [id, callback] : due) {
             if (callback) {
                 callback(id);
@@ -1430,14 +1467,118 @@ namespace UltraCanvas {
         }
     }
 
-    std::chrono::milliseconds UltraCanvasApplicationBase::GetTimeUntilNextTimer() const {
-        std::lock_guard<std::mutex> lock(timersMutex_);
-        auto earliest = std::chrono::steady_clock::time_point::max();
-        for (const auto& timer : timers_) {
-            if (timer.active && timer.nextFire < earliest) {
-                earliest = timer.nextFire;
+    std::chrono::milliseconds UltraCanvasApplicationBase::GetEventLoopTimeout() {
+        {
+            // ProcessEvents handles a bounded number of events per pass, and
+            // posted tasks may have been deferred by the frame budget.
+            std::lock_guard<std::mutex> lock(eventQueueMutex);
+            if (!eventQueue.empty()) return std::chrono::milliseconds(0);
+        }
+        {
+            std::lock_guard<std::mutex> lock(postedTasksMutex_);
+            if (!postedTasks_.empty()) return std::chrono::milliseconds(0);
+        }
+        auto timeout = GetTimeUntilNextTimer();
+        if (framePacing_ && framePending_) {
+            auto now = std::chrono::steady_clock::now();
+            auto untilFrame = nextFrameTime_ <= now
+                              ? std::chrono::milliseconds(0)
+                              : std::chrono::ceil<std::chrono::milliseconds>(nextFrameTime_ - now);
+            timeout = std::min(timeout, untilFrame);
+        }
+        return timeout;
+    }
+
+    // ===== FRAME SCHEDULER =====
+
+    void UltraCanvasApplicationBase::SetFramePacing(bool enabled) {
+        framePacing_ = enabled;
+        if (!enabled) framePending_ = false;
+    }
+
+    void UltraCanvasApplicationBase::SetFrameRate(double hz) {
+        if (hz <= 0) return;
+        frameInterval_ = std::chrono::nanoseconds(static_cast<int64_t>(1e9 / hz));
+        if (frameBudgetAuto_) {
+            frameBudget_ = std::chrono::duration_cast<std::chrono::microseconds>(frameInterval_ * 3 / 4);
+        }
+    }
+
+    double UltraCanvasApplicationBase::GetFrameRate() const {
+        return 1e9 / static_cast<double>(frameInterval_.count());
+    }
+
+    void UltraCanvasApplicationBase::SetFrameBudget(std::chrono::microseconds budget) {
+        frameBudgetAuto_ = budget.count() <= 0;
+        frameBudget_ = frameBudgetAuto_
+                       ? std::chrono::duration_cast<std::chrono::microseconds>(frameInterval_ * 3 / 4)
+                       : budget;
+    }
+
+    void UltraCanvasApplicationBase::RenderFrame(std::chrono::steady_clock::time_point frameStart) {
+        using Clock = std::chrono::steady_clock;
+        framePending_ = false;
+
+        // Round-robin start, so a window that keeps blowing the budget
+        // cannot starve the ones after it.
+        const size_t count = windows.size();
+        const size_t first = count ? renderCursor_ % count : 0;
+        size_t rendered = 0;
+        for (size_t i = 0; i < count; i++) {
+            const size_t index = (first + i) % count;
+            auto* window = windows[index].get();
+            if (!window->IsVisible() || !window->NeedsRender()) continue;
+            if (framePacing_ && rendered > 0 && Clock::now() > frameStart + frameBudget_) {
+                // Over budget: the remaining windows draw first next frame.
+                frameStats_.deferredWindows += count - i;
+                renderCursor_ = index;
+                framePending_ = true;
+                break;
             }
+            window->UpdateAndRender();
+            rendered++;
+        }
+
+        if (rendered == 0) {
+            // Not a frame: the stats stay as they are, and an input that
+            // changed nothing on screen has no latency to report. The next
+            // frame is not held back by this one's interval.
+            pendingInputSince_ = Clock::time_point::max();
+            return;
+        }
+
+        // Layout and scroll positions are settled now: decodes queued for
+        // elements that left the screen are dropped before a worker takes
+        // them.
+        UCImageDecodeService::GetInstance().CancelOffscreen();
+
+        const auto frameEnd = Clock::now();
+        const double frameMs = std::chrono::duration<double, std::milli>(frameEnd - frameStart).count();
+        auto& st = frameStats_;
+        st.frames++;
+        st.lastFrameMs = frameMs;
+        st.avgFrameMs = st.frames == 1 ? frameMs : st.avgFrameMs * 0.9 + frameMs * 0.1;
+        st.maxFrameMs = std::max(st.maxFrameMs, frameMs);
+        if (frameEnd - frameStart > frameInterval_) {
+            st.droppedFrames += static_cast<uint64_t>((frameEnd - frameStart) / frameInterval_);
+        }
+
+        if (pendingInputSince_ != Clock::time_point::max()) {
+            const double latencyMs =
+                    std::chrono::duration<double, std::milli>(frameEnd - pendingInputSince_).count();
+            const bool firstSample = st.avgInputLatencyMs == 0;
+            st.lastInputLatencyMs = latencyMs;
+            st.avgInputLatencyMs = firstSample ? latencyMs : st.avgInputLatencyMs * 0.9 + latencyMs * 0.1;
+            st.maxInputLatencyMs = std::max(st.maxInputLatencyMs, latencyMs);
+            pendingInputSince_ = Clock::time_point::max();
         }
+
+        nextFrameTime_ = frameStart + frameInterval_;
+    }
+
+    std::chrono::milliseconds UltraCanvasApplicationBase::GetTimeUntilNextTimer() const {
+        std::lock_guard<std::mutex> lock(timersMutex_);
+        auto earliest = timers_.NextDeadline();
         if (earliest == std::chrono::steady_clock::time_point::max()) {
             return std::chrono::milliseconds::max(); // No active timers
         }
@@ -1445,6 +1586,8 @@ namespace UltraCanvas {
         if (earliest <= now) {
             return std::chrono::milliseconds(0);
         }
+        // Rounded down: waking up to a millisecond early is covered by the
+        // coalescing slack, so the timer still fires on that wake-up.
         return std::chrono::duration_cast<std::chrono::milliseconds>(earliest - now);
     }
 }
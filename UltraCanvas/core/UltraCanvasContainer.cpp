@@ -2,14 +2,15 @@
 // Container with scrollbars and child management. Child storage lives on
 // CSSLayout::Element (via UltraCanvasUIElement); we iterate it through
 // Children() and static_pointer_cast each element to UltraCanvasUIElement.
-// Version: 4.2.0
-// Last Modified: 2026-08-09
+// Version: 4.3.0 - per-child frame profiler scopes
+// Last Modified: 2026-10-18
 // Author: UltraCanvas Framework
 
 #include "UltraCanvasContainer.h"
 #include "UltraCanvasRenderContext.h"
 #include "UltraCanvasApplication.h"
 #include "UltraCanvasElementDebug.h"
+#include "UltraCanvasFrameProfiler.h"
 #include <algorithm>
 #include <cmath>
 
@@ -102,7 +103,10 @@ namespace UltraCanvas {
             Rect2Di childDirty(dirtyRect.x - adjustedChildBounds.x,
                                dirtyRect.y - adjustedChildBounds.y,
                                dirtyRect.width, dirtyRect.height);
-            child->Render(ctx, childDirty);
+            {
+                UCProfileScope profileScope(ProfileKind::Render, child, &child->GetIdentifier());
+                child->RenderWithLayer(ctx, childDirty);
+            }
             ctx->PopState();
         }
 
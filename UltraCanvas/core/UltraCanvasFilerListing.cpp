@@ -0,0 +1,106 @@
+// core/UltraCanvasFilerListing.cpp
+// Listing order, watch delta merge and burst coalescing for the filer.
+// Version: 1.0.0
+// Last Modified: 2026-10-18
+// Author: UltraCanvas Framework
+
+#include "UltraCanvasFilerListing.h"
+#include <algorithm>
+#include <cctype>
+
+namespace UltraCanvas {
+
+    int FilerCompareNoCase(const std::string& a, const std::string& b) {
+        size_t n = std::min(a.size(), b.size());
+        for (size_t i = 0; i < n; ++i) {
+            int ca = std::tolower(static_cast<unsigned char>(a[i]));
+            int cb = std::tolower(static_cast<unsigned char>(b[i]));
+            if (ca != cb) return ca < cb ? -1 : 1;
+        }
+        if (a.size() == b.size()) return 0;
+        return a.size() < b.size() ? -1 : 1;
+    }
+
+    bool FilerEntrySortsBefore(const FilerEntry& a, const FilerEntry& b,
+                               FilerSortField field, bool ascending) {
+        // Folders always list before files, regardless of direction.
+        if (a.isDirectory != b.isDirectory) return a.isDirectory;
+        int cmp = 0;
+        switch (field) {
+            case FilerSortField::Name:
+                cmp = FilerCompareNoCase(a.name, b.name);
+                break;
+            case FilerSortField::Size:
+                cmp = a.size < b.size ? -1 : (a.size > b.size ? 1 : 0);
+                break;
+            case FilerSortField::Type:
+                cmp = FilerCompareNoCase(a.typeName, b.typeName);
+                break;
+            case FilerSortField::ModifiedDate:
+                cmp = a.modifiedTime < b.modifiedTime ? -1
+                    : (a.modifiedTime > b.modifiedTime ? 1 : 0);
+                break;
+            case FilerSortField::CreatedDate:
+                cmp = a.createdTime < b.createdTime ? -1
+                    : (a.createdTime > b.createdTime ? 1 : 0);
+                break;
+        }
+        if (cmp == 0) cmp = FilerCompareNoCase(a.name, b.name);
+        return ascending ? cmp < 0 : cmp > 0;
+    }
+
+    size_t MergeFilerWatchDelta(std::vector<FilerEntry>& entries,
+                                const std::unordered_set<std::string>& touched,
+                                const FilerRestatFunc& restat,
+                                FilerSortField field, bool ascending) {
+        // 1. Drop every touched entry in one pass — deleted ones stay gone,
+        //    the others come back re-stat-ed below at their new position.
+        entries.erase(std::remove_if(entries.begin(), entries.end(),
+                                     [&touched](const FilerEntry& e) {
+                                         return touched.count(e.path) != 0;
+                                     }),
+                      entries.end());
+
+        // 2. Re-stat only the touched names and binary-insert the survivors.
+        size_t inserted = 0;
+        for (const std::string& path : touched) {
+            FilerEntry e;
+            if (!restat(path, e)) continue;
+            auto pos = std::upper_bound(entries.begin(), entries.end(), e,
+                    [field, ascending](const FilerEntry& a, const FilerEntry& b) {
+                        return FilerEntrySortsBefore(a, b, field, ascending);
+                    });
+            entries.insert(pos, std::move(e));
+            ++inserted;
+        }
+        return inserted;
+    }
+
+    void FilerWatchBurst::Touch(Clock::time_point now) {
+        lastEvent = now;
+        if (!open) {
+            open = true;
+            burstStart = now;
+        }
+    }
+
+    FilerWatchBurst::Clock::time_point FilerWatchBurst::DueAt() const {
+        return std::min(lastEvent + quietDelay, burstStart + maxLatency);
+    }
+
+    int FilerWatchBurst::PollTimeoutMs(Clock::time_point now) const {
+        if (!open) return -1;
+        const auto due = DueAt();
+        if (due <= now) return 0;
+        // Rounded up: waking a hair early would only loop once more.
+        return int(std::chrono::duration_cast<std::chrono::milliseconds>(
+                due - now).count()) + 1;
+    }
+
+    bool FilerWatchBurst::TakeDue(Clock::time_point now) {
+        if (!open || now < DueAt()) return false;
+        open = false;
+        return true;
+    }
+
+} // namespace UltraCanvas
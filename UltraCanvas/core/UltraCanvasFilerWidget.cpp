@@ -40,8 +40,10 @@
 // file's own text for text, documents and spreadsheets. Each kind can be
 // switched off individually (Display > Preview), which drops its entries back
 // to the plain type glyph and stops the widget from reading those files.
-// Version: 1.15.0
-// Last Modified: 2026-08-20
+// On Linux an inotify watch on the shown folder feeds changes made by other
+// programs into the listing as coalesced deltas (see LIVE FOLDER WATCH).
+// Version: 1.16.0
+// Last Modified: 2026-10-18
 // Author: UltraCanvas Framework
 
 // VirtualFS + bridge must be included before the UI headers: X11 (pulled in
@@ -60,8 +62,10 @@
 #include "UltraCanvasNativeFileIcons.h"
 #include "UltraCanvasImage.h"
 #include "UltraCanvasSupportedFormats.h"
+#include "UltraCanvasThumbnailStore.h"
 #include "UltraCanvasUtils.h"
 #include "../libspecific/Cairo/QoiPixmapCodec.h"
+#include "../libspecific/Cairo/PngPixmapCodec.h"
 #include "UltraCanvasMenu.h"
 #include "UltraCanvasWindow.h"
 #include "UltraCanvasTooltipManager.h"
@@ -73,6 +77,7 @@
 #include "UltraCanvasTextInput.h"
 #include "UltraCanvasButton.h"
 #include "UltraCanvasVideoThumbnail.h"
+#include "UltraCanvasVideoDevices.h"
 #include "UltraCanvasZipPackage.h"
 #include "Models/STL/UltraCanvasSTLLoader.h"
 #include "Plugins/Documents/Word/UltraCanvasWordDocumentIO.h"
@@ -80,6 +85,7 @@
 #include "Plugins/Documents/UltraCanvasPDF.h"
 #endif
 #include <algorithm>
+#include <cerrno>
 #include <cmath>
 #include <cstdio>
 #include <cstdlib>
@@ -93,6 +99,12 @@
 #if defined(_WIN32) || defined(_WIN64)
 #include <windows.h>   // GetFileAttributesExW: the attribute bits ::stat cannot see
 #endif
+#ifdef __linux__
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
 
 // X11 (pulled in via UltraCanvasApplication.h) #defines Success and None,
 // which collide with the VirtualFS::VirtualFSResult enumerators used below.
@@ -152,17 +164,6 @@ namespace UltraCanvas {
 
         std::string LowerExtension(const std::string& name);   // defined below
 
-        int CompareNoCase(const std::string& a, const std::string& b) {
-            size_t n = std::min(a.size(), b.size());
-            for (size_t i = 0; i < n; ++i) {
-                int ca = std::tolower(static_cast<unsigned char>(a[i]));
-                int cb = std::tolower(static_cast<unsigned char>(b[i]));
-                if (ca != cb) return ca < cb ? -1 : 1;
-            }
-            if (a.size() == b.size()) return 0;
-            return a.size() < b.size() ? -1 : 1;
-        }
-
         // Extension -> (type label, category). The label is completed to
         // "<LABEL> <category noun>" ("PNG Image") in ApplyEntryTypeInfo.
         struct TypeInfo {
@@ -480,14 +481,19 @@ namespace UltraCanvas {
         // Rendered on the thumbnail workers, so a folder of PDFs pages in the
         // same way a folder of photos does. Each call opens its own document
         // (and with it its own engine context), which is what makes it safe to
-        // run several of them on different threads at once.
+        // run several of them on different threads at once. `rejected` is set
+        // when an engine was there and refused the file.
         std::shared_ptr<UCPixmap> RenderPdfPreviewPixmap(const std::string& path,
-                                                         int w, int h, float scale) {
+                                                         int w, int h, float scale,
+                                                         bool* rejected = nullptr) {
 #ifdef ULTRACANVAS_PLUGIN_PDF
             const int maxDim = std::max(16, static_cast<int>(std::lround(
                     std::max(w, h) * std::max(1.0f, scale))));
             std::unique_ptr<IPDFDocument> doc = OpenPDF(path);
-            if (!doc || doc->GetPageCount() < 1) return nullptr;
+            if (!doc || doc->GetPageCount() < 1) {
+                if (rejected) *rejected = PdfPreviewAvailable();
+                return nullptr;
+            }
             PDFRenderedPage page = doc->RenderThumbnail(1, maxDim);
             if (!page.IsValid() || page.colorMode != PDFColorMode::RGBA) return nullptr;
             auto pm = PixmapFromRGBA(page.pixels.data(), page.width, page.height,
@@ -509,7 +515,7 @@ namespace UltraCanvas {
             }
             return pm;
 #else
-            (void)path; (void)w; (void)h; (void)scale;
+            (void)path; (void)w; (void)h; (void)scale; (void)rejected;
             return nullptr;
 #endif
         }
@@ -520,14 +526,19 @@ namespace UltraCanvas {
         // context, neither of which a background decode has. Flat shading off
         // the triangle geometry (STL facet normals are often wrong or absent)
         // with a single head-light, drawn onto a transparent background so the
-        // tile keeps the widget's colour behind the model.
+        // tile keeps the widget's colour behind the model. `rejected` is set
+        // when the loader refused the file (not for meshes over the cap).
         constexpr size_t kModelPreviewTriangleCap = 2000000;
 
         std::shared_ptr<UCPixmap> RenderModelPreviewPixmap(const std::string& path,
-                                                           int w, int h, float scale) {
+                                                           int w, int h, float scale,
+                                                           bool* rejected = nullptr) {
             if (!UltraCanvasSTLLoader::HasSTLExtension(path)) return nullptr;
             Mesh3D mesh;
-            if (!UltraCanvasSTLLoader::Load(path, mesh) || mesh.Empty()) return nullptr;
+            if (!UltraCanvasSTLLoader::Load(path, mesh) || mesh.Empty()) {
+                if (rejected) *rejected = true;
+                return nullptr;
+            }
             if (mesh.TriangleCount() > kModelPreviewTriangleCap) return nullptr;
             if (!mesh.bounds.IsValid()) mesh.ComputeBounds();
 
@@ -1724,6 +1735,7 @@ namespace UltraCanvas {
         StopThumbnailWorkers();
         StopFolderStatsWorker();
         StopFolderPrefetchWorker();
+        StopFolderWatch();
     }
 
     // ===== FOLDER =====
@@ -2019,28 +2031,7 @@ namespace UltraCanvas {
         }
 #endif
 
-        for (FilerEntry& e : entries) {
-            e.effectiveSize = e.size;
-
-            std::string attr;
-            if (e.isDirectory) attr += 'D';
-            if (e.isSymlink)   attr += 'L';
-            if (e.isReadOnly)  attr += 'R';
-            if (e.isHidden)    attr += 'H';
-            if (e.isArchive)   attr += 'A';
-            e.attributes = attr;
-
-            if (e.compressedSize > 0 && e.size > 0 && e.compressedSize <= e.size) {
-                char buf[32];
-                snprintf(buf, sizeof(buf), "%.0f%% compressed",
-                         100.0 * (1.0 - double(e.compressedSize) / double(e.size)));
-                e.info = buf;
-            }
-            if (infoProvider) {
-                std::string s = infoProvider(e);
-                if (!s.empty()) e.info = s;
-            }
-        }
+        for (FilerEntry& e : entries) FinishScannedEntry(e);
 
         SortEntries();
 
@@ -2099,6 +2090,10 @@ namespace UltraCanvas {
         // worker so entering one of them can skip the cold scan.
         if (!fileListMode && isRealDir) QueueFolderPrefetch();
 
+        // From here on, changes other programs make to the folder arrive as
+        // deltas through the watch instead of needing another full scan.
+        ArmFolderWatch(!fileListMode && isRealDir ? currentPath : std::string());
+
         // And its distinct file extensions for the "Open with >" prewarm, so
         // a right-click finds the OS application lists already resolved.
         if (systemOpenWith) {
@@ -2116,6 +2111,29 @@ namespace UltraCanvas {
         if (onFolderRefreshed) onFolderRefreshed();
     }
 
+    void UltraCanvasFilerWidget::FinishScannedEntry(FilerEntry& e) const {
+        e.effectiveSize = e.size;
+
+        std::string attr;
+        if (e.isDirectory) attr += 'D';
+        if (e.isSymlink)   attr += 'L';
+        if (e.isReadOnly)  attr += 'R';
+        if (e.isHidden)    attr += 'H';
+        if (e.isArchive)   attr += 'A';
+        e.attributes = attr;
+
+        if (e.compressedSize > 0 && e.size > 0 && e.compressedSize <= e.size) {
+            char buf[32];
+            snprintf(buf, sizeof(buf), "%.0f%% compressed",
+                     100.0 * (1.0 - double(e.compressedSize) / double(e.size)));
+            e.info = buf;
+        }
+        if (infoProvider) {
+            std::string s = infoProvider(e);
+            if (!s.empty()) e.info = s;
+        }
+    }
+
     void UltraCanvasFilerWidget::SortEntries() {
         // A file list whose order is the information it carries (see
         // SetFileListOrderPreserved) is left exactly as it was handed over.
@@ -2124,30 +2142,7 @@ namespace UltraCanvas {
         const bool asc = sortAscending;
         std::stable_sort(entries.begin(), entries.end(),
                          [field, asc](const FilerEntry& a, const FilerEntry& b) {
-            // Folders always list before files, regardless of direction.
-            if (a.isDirectory != b.isDirectory) return a.isDirectory;
-            int cmp = 0;
-            switch (field) {
-                case FilerSortField::Name:
-                    cmp = CompareNoCase(a.name, b.name);
-                    break;
-                case FilerSortField::Size:
-                    cmp = a.size < b.size ? -1 : (a.size > b.size ? 1 : 0);
-                    break;
-                case FilerSortField::Type:
-                    cmp = CompareNoCase(a.typeName, b.typeName);
-                    break;
-                case FilerSortField::ModifiedDate:
-                    cmp = a.modifiedTime < b.modifiedTime ? -1
-                        : (a.modifiedTime > b.modifiedTime ? 1 : 0);
-                    break;
-                case FilerSortField::CreatedDate:
-                    cmp = a.createdTime < b.createdTime ? -1
-                        : (a.createdTime > b.createdTime ? 1 : 0);
-                    break;
-            }
-            if (cmp == 0) cmp = CompareNoCase(a.name, b.name);
-            return asc ? cmp < 0 : cmp > 0;
+            return FilerEntrySortsBefore(a, b, field, asc);
         });
     }
 
@@ -6130,6 +6125,11 @@ namespace UltraCanvas {
         RequestRedraw();
     }
 
+    void UltraCanvasFilerWidget::SetPersistentThumbnails(bool enabled) {
+        // Only where future decodes look first changes; finished tiles stay.
+        persistentThumbs.store(enabled);
+    }
+
     void UltraCanvasFilerWidget::SetFlexibleTileWidths(bool enabled) {
         if (flexibleTileWidths == enabled) return;
         flexibleTileWidths = enabled;
@@ -6200,6 +6200,93 @@ namespace UltraCanvas {
         return st;
     }
 
+    // The preview of one file at the request's size, by whichever producer
+    // the file calls for. With persistent thumbnails on, the XDG store is
+    // consulted first and a miss renders at the store's flavor size, so the
+    // next launch (or another application) finds it: the tile pixmap is then
+    // derived from that stored thumbnail, except for photos whose decoded
+    // original is at hand anyway.
+    std::shared_ptr<UCPixmap> UltraCanvasFilerWidget::ProduceThumbnailPixmap(
+            const ThumbRequest& req) {
+        const FilerPreviewType kind = PreviewTypeForPath(req.path);
+        // `rejected` tells a file the decoder refused from a producer that is
+        // not there (no video backend, no PDF engine): only the former is
+        // worth a failure mark in the shared cache.
+        auto produce = [&](int w, int h, ImageFitMode fit, float scale,
+                           std::shared_ptr<UCImage>* decoded,
+                           bool* rejected) -> std::shared_ptr<UCPixmap> {
+            switch (kind) {
+                case FilerPreviewType::Videos: {
+                    // Poster frame of a video (may block for a few seconds on
+                    // a cold file — that is exactly what these workers are
+                    // for).
+                    VideoThumbnailRequest vreq;
+                    vreq.maxWidth = std::max(1, static_cast<int>(std::lround(w * scale)));
+                    vreq.maxHeight = std::max(1, static_cast<int>(std::lround(h * scale)));
+                    auto pm = CaptureVideoThumbnailPixmap(req.path, vreq);
+                    if (!pm && rejected) *rejected = UltraCanvasVideoDevices::IsAvailable();
+                    return pm;
+                }
+                case FilerPreviewType::PDF:
+                    return RenderPdfPreviewPixmap(req.path, w, h, scale, rejected);
+                case FilerPreviewType::Models3D:
+                    return RenderModelPreviewPixmap(req.path, w, h, scale, rejected);
+                default: {
+                    auto img = UCImage::Get(req.path);
+                    if (!img || img->GetWidth() <= 0 || img->GetHeight() <= 0) {
+                        if (rejected) *rejected = true;
+                        return nullptr;
+                    }
+                    if (decoded) *decoded = img;
+                    return img->GetPixmap(w, h, fit, scale);
+                }
+            }
+        };
+
+        const int rawEdge = std::max(1, static_cast<int>(std::lround(
+                std::max(req.w, req.h) * req.scale)));
+        ThumbnailStore::Flavor flavor;
+        if (!persistentThumbs.load() || !ThumbnailStore::IsEnabled() ||
+            !ThumbnailStore::FlavorForEdge(rawEdge, flavor)) {
+            return produce(req.w, req.h, req.fit, req.scale, nullptr, nullptr);
+        }
+
+        // Stored thumbnails are decoded with CreatePixmap, not GetPixmap: their
+        // in-memory images are one-shot and must not fill the shared pixmap
+        // cache with keys nothing will ever ask for again.
+        std::vector<uint8_t> png;
+        if (ThumbnailStore::Lookup(req.path, rawEdge, png)) {
+            auto stored = UCImage::LoadFromMemory(png);
+            if (stored && stored->IsValid()) {
+                if (auto pm = stored->CreatePixmap(req.w, req.h, req.fit, req.scale)) return pm;
+            }
+        }
+        if (ThumbnailStore::HasFailed(req.path)) return nullptr;
+
+        const int bucket = ThumbnailStore::FlavorEdge(flavor);
+        std::shared_ptr<UCImage> decoded;
+        bool rejected = false;
+        auto flavorPm = produce(bucket, bucket, ImageFitMode::Contain, 1.0f, &decoded, &rejected);
+        if (!flavorPm) {
+            if (rejected) ThumbnailStore::MarkFailed(req.path);
+            return nullptr;
+        }
+        png = PngEncodePixmap(*flavorPm);
+        if (!png.empty()) {
+            ThumbnailStore::Store(req.path, flavor, png,
+                                  decoded ? decoded->GetWidth() : 0,
+                                  decoded ? decoded->GetHeight() : 0);
+        }
+        if (decoded) return decoded->GetPixmap(req.w, req.h, req.fit, req.scale);
+        if (!png.empty()) {
+            auto stored = UCImage::LoadFromMemory(png);
+            if (stored && stored->IsValid()) {
+                if (auto pm = stored->CreatePixmap(req.w, req.h, req.fit, req.scale)) return pm;
+            }
+        }
+        return produce(req.w, req.h, req.fit, req.scale, nullptr, nullptr);
+    }
+
     void UltraCanvasFilerWidget::ThumbnailWorkerMain() {
         // Keeps the retained pixmap bytes bounded: browsing a huge folder in a
         // big tile size cannot grow without limit. On overflow the finished
@@ -6296,32 +6383,8 @@ namespace UltraCanvas {
                 const int edge = std::max(1, static_cast<int>(std::lround(
                         std::max(req.w, req.h) * req.scale)));
                 pm = LoadNativeFileIconPixmap(req.path, edge);
-            } else switch (PreviewTypeForPath(req.path)) {
-                case FilerPreviewType::Videos: {
-                    // Poster frame of a video (may block for a few seconds on
-                    // a cold file — that is exactly what these workers are
-                    // for).
-                    VideoThumbnailRequest vreq;
-                    vreq.maxWidth = std::max(
-                            1, static_cast<int>(std::lround(req.w * req.scale)));
-                    vreq.maxHeight = std::max(
-                            1, static_cast<int>(std::lround(req.h * req.scale)));
-                    pm = CaptureVideoThumbnailPixmap(req.path, vreq);
-                    break;
-                }
-                case FilerPreviewType::PDF:
-                    pm = RenderPdfPreviewPixmap(req.path, req.w, req.h, req.scale);
-                    break;
-                case FilerPreviewType::Models3D:
-                    pm = RenderModelPreviewPixmap(req.path, req.w, req.h, req.scale);
-                    break;
-                default: {
-                    auto img = UCImage::Get(req.path);
-                    if (img && img->GetWidth() > 0 && img->GetHeight() > 0) {
-                        pm = img->GetPixmap(req.w, req.h, req.fit, req.scale);
-                    }
-                    break;
-                }
+            } else {
+                pm = ProduceThumbnailPixmap(req);
             }
 
             // "Compressed thumbnails": deflate here on the worker so the UI
@@ -7418,8 +7481,9 @@ namespace UltraCanvas {
         // replace the queue without any wasted scans, and the folder the user
         // is looking at gets the disk first (thumbnails, stats).
         constexpr auto kPrefetchGraceDelay = std::chrono::milliseconds(300);
-        // A cached listing older than this is discarded on use — there is no
-        // change watcher, so age bounds how stale a served listing can be.
+        // A cached listing older than this is discarded on use — only the
+        // shown folder is watched, so age bounds how stale a served listing
+        // of a neighbouring one can be.
         constexpr auto kPrefetchMaxAge = std::chrono::seconds(60);
         constexpr size_t kPrefetchMaxFolders = 24;     // cached listings
         constexpr size_t kPrefetchMaxEntries = 50000;  // entries across them
@@ -7574,6 +7638,334 @@ namespace UltraCanvas {
         }
     }
 
+    // ===== LIVE FOLDER WATCH =====
+
+    namespace {
+        // A burst is delivered once the folder has been quiet this long...
+        constexpr auto kWatchQuietDelay = std::chrono::milliseconds(120);
+        // ...or after this much latency while events keep streaming in (a
+        // build writing continuously), so the listing still keeps up.
+        constexpr auto kWatchMaxLatency = std::chrono::milliseconds(500);
+        // Retry delay for a delta held back by an interaction in progress.
+        constexpr unsigned int kWatchRetryMs = 250;
+        // Past this many touched names in one burst, a rescan (one readdir,
+        // one sort) is cheaper than per-name stats and vector insertions.
+        constexpr size_t kWatchMaxDeltaNames = 4096;
+#ifdef __linux__
+        constexpr uint32_t kWatchMask =
+                IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO |
+                IN_MODIFY | IN_CLOSE_WRITE | IN_ATTRIB |
+                IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR | IN_EXCL_UNLINK;
+#endif
+    }
+
+    void UltraCanvasFilerWidget::SetFolderWatchEnabled(bool enabled) {
+        if (folderWatchEnabled == enabled) return;
+        folderWatchEnabled = enabled;
+        if (!enabled) {
+            StopFolderWatch();
+            return;
+        }
+        // Whatever changed while unwatched is unknown: rescan, which also
+        // arms the watch on the shown folder.
+        if (!fileListMode && !currentPath.empty()) Refresh();
+    }
+
+    void UltraCanvasFilerWidget::ArmFolderWatch(const std::string& path) {
+#ifdef __linux__
+        std::lock_guard<std::mutex> lk(watchMutex);
+        // The worker gave up on an error (see FolderWatchWorkerMain): reap it
+        // and its descriptors so whatever is armed below starts from scratch.
+        // It takes no lock once it has flagged the failure, so joining under
+        // watchMutex cannot deadlock.
+        if (watchFailed) {
+            if (watchWorker.joinable()) watchWorker.join();
+            if (watchFd >= 0) ::close(watchFd);
+            if (watchWakeFd >= 0) ::close(watchWakeFd);
+            watchFd = watchWakeFd = watchWd = -1;
+            watchedPath.clear();
+            watchFailed = false;
+        }
+        if (path.empty() || !folderWatchEnabled) {
+            if (watchFd >= 0 && watchWd >= 0) inotify_rm_watch(watchFd, watchWd);
+            watchWd = -1;
+            watchedPath.clear();
+            watchPendingNames.clear();
+            watchOverflow = false;
+            return;
+        }
+        // Same folder rescanned: keep the watch and whatever it collected —
+        // an event that raced the scan is re-applied harmlessly (re-stat).
+        if (path == watchedPath && watchWd >= 0) return;
+
+        if (watchFd < 0) {
+            watchFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+            // Out of inotify instances: the listing just stays manual.
+            if (watchFd < 0) return;
+            watchWakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+            if (watchWakeFd < 0) {
+                ::close(watchFd);
+                watchFd = -1;
+                return;
+            }
+        }
+        // Events still queued for the old descriptor are dropped by the
+        // worker's wd check; names collected for the old folder are void.
+        if (watchWd >= 0) inotify_rm_watch(watchFd, watchWd);
+        watchPendingNames.clear();
+        watchOverflow = false;
+        watchWd = inotify_add_watch(watchFd, path.c_str(), kWatchMask);
+        if (watchWd < 0) {
+            watchedPath.clear();   // e.g. max_user_watches reached
+            return;
+        }
+        watchedPath = path;
+        if (!watchWorker.joinable())
+            watchWorker = std::thread([this]() { FolderWatchWorkerMain(); });
+#else
+        (void)path;
+#endif
+    }
+
+    void UltraCanvasFilerWidget::StopFolderWatch() {
+#ifdef __linux__
+        {
+            std::lock_guard<std::mutex> lk(watchMutex);
+            watchShutdown = true;
+            if (watchWakeFd >= 0) {
+                uint64_t one = 1;
+                (void)!::write(watchWakeFd, &one, sizeof(one));
+            }
+        }
+        if (watchWorker.joinable()) watchWorker.join();
+        std::lock_guard<std::mutex> lk(watchMutex);
+        if (watchFd >= 0) ::close(watchFd);
+        if (watchWakeFd >= 0) ::close(watchWakeFd);
+        watchFd = watchWakeFd = watchWd = -1;
+        watchedPath.clear();
+        watchPendingNames.clear();
+        watchOverflow = false;
+        watchFailed = false;
+        watchShutdown = false;   // a later ArmFolderWatch may start over
+#endif
+        if (watchRetryTimer != InvalidTimerId) {
+            if (auto* app = UltraCanvasApplication::GetInstance())
+                app->StopTimer(watchRetryTimer);
+            watchRetryTimer = InvalidTimerId;
+        }
+    }
+
+    void UltraCanvasFilerWidget::FolderWatchWorkerMain() {
+#ifdef __linux__
+        // The descriptors live as long as this thread: they are created
+        // before it starts and closed only after StopFolderWatch joined it.
+        const int inotifyFd = watchFd;
+        const int wakeFd = watchWakeFd;
+        alignas(struct inotify_event) char buf[16384];
+        using Clock = FilerWatchBurst::Clock;
+        FilerWatchBurst burst(kWatchQuietDelay, kWatchMaxLatency);
+        for (;;) {
+            pollfd fds[2] = {{inotifyFd, POLLIN, 0}, {wakeFd, POLLIN, 0}};
+            int ready = ::poll(fds, 2, burst.PollTimeoutMs(Clock::now()));
+            if (ready < 0 && errno != EINTR) {
+                // Nothing more will be read from this instance. Leaving
+                // quietly would keep the listing believing it is watched:
+                // ask the UI for a rescan instead, which also re-arms a fresh
+                // watch (ArmFolderWatch reaps this thread first).
+                {
+                    std::lock_guard<std::mutex> lk(watchMutex);
+                    if (watchShutdown) return;
+                    watchFailed = true;
+                    watchOverflow = true;
+                }
+                PostFolderWatchChanges();
+                return;
+            }
+            if (ready > 0 && (fds[1].revents & POLLIN)) {
+                uint64_t drained;
+                (void)!::read(wakeFd, &drained, sizeof(drained));
+            }
+            {
+                std::lock_guard<std::mutex> lk(watchMutex);
+                if (watchShutdown) return;
+            }
+
+            if (ready > 0 && (fds[0].revents & POLLIN)) {
+                bool touched = false;
+                for (;;) {
+                    ssize_t n = ::read(inotifyFd, buf, sizeof(buf));
+                    if (n <= 0) break;   // EAGAIN: drained
+                    std::lock_guard<std::mutex> lk(watchMutex);
+                    for (char* p = buf; p < buf + n; ) {
+                        auto* ev = reinterpret_cast<inotify_event*>(p);
+                        p += sizeof(inotify_event) + ev->len;
+                        if (ev->mask & IN_Q_OVERFLOW) {
+                            watchOverflow = true;   // events lost: rescan
+                            touched = true;
+                            continue;
+                        }
+                        if (ev->wd != watchWd) continue;   // a folder left behind
+                        if (ev->mask & (IN_DELETE_SELF | IN_MOVE_SELF | IN_UNMOUNT)) {
+                            watchOverflow = true;   // ScanFolder sorts it out
+                            touched = true;
+                            continue;
+                        }
+                        if (ev->len == 0 || ev->name[0] == '\0') continue;
+                        watchPendingNames.insert(ev->name);
+                        touched = true;
+                    }
+                }
+                if (touched) burst.Touch(Clock::now());
+            }
+
+            if (burst.TakeDue(Clock::now())) PostFolderWatchChanges();
+        }
+#endif
+    }
+
+    void UltraCanvasFilerWidget::PostFolderWatchChanges() {
+        // One queued UI task takes everything collected up to the moment it
+        // runs; names arriving later start the next burst.
+        if (watchApplyPosted.exchange(true)) return;
+        UltraCanvasApplicationBase* app = UltraCanvasApplicationBase::GetCurrent();
+        if (!app) {
+            watchApplyPosted.store(false);
+            return;
+        }
+        auto alive = thumbAlive;
+        app->PostToUIThread([this, alive]() {
+            if (!alive->load()) return;   // widget destroyed meanwhile
+            watchApplyPosted.store(false);
+            ApplyFolderWatchChanges();
+        });
+    }
+
+    void UltraCanvasFilerWidget::ForgetEntryCaches(
+            const std::unordered_set<std::string>& paths) {
+        // Thumbnail keys are "path|geometry": compare the prefix up to '|'.
+        auto keyPath = [](const std::string& key) {
+            size_t bar = key.find('|');
+            return bar == std::string::npos ? key : key.substr(0, bar);
+        };
+        {
+            std::lock_guard<std::mutex> lk(thumbMutex);
+            for (auto it = thumbSlots.begin(); it != thumbSlots.end(); ) {
+                if (!paths.count(keyPath(it->first))) { ++it; continue; }
+                thumbBytes -= std::min(thumbBytes, it->second.bytes);
+                it = thumbSlots.erase(it);
+            }
+            for (auto it = thumbHot.begin(); it != thumbHot.end(); ) {
+                if (!paths.count(keyPath(it->first))) { ++it; continue; }
+                thumbHotBytes -= std::min(thumbHotBytes, it->second.bytes);
+                it = thumbHot.erase(it);
+            }
+            for (const std::string& p : paths) textSlots.erase(p);
+        }
+        {
+            std::lock_guard<std::mutex> lk(statsMutex);
+            for (const std::string& p : paths) {
+                folderStatsCache.erase(p);
+                aspectCache.erase(p);
+                mediaInfoCache.erase(p);
+            }
+        }
+        // A rewritten image must not be served from the shared decode cache.
+        for (const std::string& p : paths) UCImage::RemoveFromCache(p);
+    }
+
+    void UltraCanvasFilerWidget::ApplyFolderWatchChanges() {
+        // Interactions that hold entry indices across events (the rename
+        // editor, a press that may become a drag / marquee / delayed select,
+        // a paste / delete / extract walking its list, the compress dialog)
+        // must not see the rows shift under them: hold the delta back and
+        // look again shortly.
+        const bool busy = renamingIndex >= 0 || pendingRenameIndex >= 0 ||
+                          draggingItems || dragPressIndex >= 0 ||
+                          marqueeArmed || marqueeActive ||
+                          pendingSelectIndex >= 0 || pendingPaste ||
+                          pendingDelete || pendingExtract || compressDlg.active;
+        if (busy) {
+            auto* app = UltraCanvasApplication::GetInstance();
+            if (app && watchRetryTimer == InvalidTimerId) {
+                watchRetryTimer = app->StartTimer(kWatchRetryMs, false,
+                                                  [this](TimerId) {
+                    watchRetryTimer = InvalidTimerId;
+                    ApplyFolderWatchChanges();
+                });
+            }
+            return;
+        }
+
+        std::unordered_set<std::string> names;
+        bool rescan = false;
+        {
+            std::lock_guard<std::mutex> lk(watchMutex);
+            // The watch belongs to a folder no longer shown (or a file list
+            // replaced it): its names mean nothing to this listing.
+            if (fileListMode || watchedPath != currentPath) {
+                watchPendingNames.clear();
+                watchOverflow = false;
+                return;
+            }
+            names.swap(watchPendingNames);
+            rescan = watchOverflow;
+            watchOverflow = false;
+        }
+        if (!rescan && names.empty()) return;
+        if (rescan || names.size() > kWatchMaxDeltaNames) {
+            ScanFolder();
+            return;
+        }
+
+        std::unordered_set<std::string> touched;
+        touched.reserve(names.size());
+        for (const std::string& name : names)
+            touched.insert((fs::path(currentPath) / name).string());
+
+        // Indices are about to shift: remember what they pointed at by path.
+        std::unordered_set<std::string> selectedPaths;
+        for (size_t idx : selection)
+            if (idx < entries.size()) selectedPaths.insert(entries[idx].path);
+        auto pathAt = [this](int idx) {
+            return idx >= 0 && idx < (int)entries.size() ? entries[idx].path
+                                                         : std::string();
+        };
+        const std::string anchorPath = pathAt(lastClickedIndex);
+        const std::string revealPath = pathAt(pendingRevealEntry);
+
+        // Drop the touched entries, re-stat them, binary-insert the survivors.
+        ForgetEntryCaches(touched);
+        MergeFilerWatchDelta(entries, touched,
+                             [this](const std::string& path, FilerEntry& e) {
+                                 if (!StatEntryForPath(path, e)) return false;
+                                 if (e.isHidden && !showHiddenFiles) return false;
+                                 FinishScannedEntry(e);
+                                 return true;
+                             },
+                             sortField, sortAscending);
+
+        // Map the remembered paths back onto the new indices.
+        // 3. Map the remembered paths back onto the new indices.
+        std::vector<size_t> restored;
+        lastClickedIndex = -1;
+        pendingRevealEntry = -1;
+        for (size_t i = 0; i < entries.size(); ++i) {
+            const std::string& p = entries[i].path;
+            if (selectedPaths.count(p)) restored.push_back(i);
+            if (p == anchorPath) lastClickedIndex = static_cast<int>(i);
+            if (p == revealPath) pendingRevealEntry = static_cast<int>(i);
+        }
+        const bool selectionChanged = restored.size() != selectedPaths.size();
+        selection.swap(restored);
+        hoveredIndex = -1;
+        effectiveSizesValid = false;
+        InvalidateFilerLayout();
+        RequestRedraw();
+
+        if (selectionChanged) FireSelectionChanged();
+        if (onFolderRefreshed) onFolderRefreshed();
+    }
+
     // ===== SELECTION INFO BAR =====
 
     std::string UltraCanvasFilerWidget::EntryExtraInfo(const FilerEntry& e) {
@@ -1,21 +1,26 @@
 // core/UltraCanvasGitRepository.cpp
 // On-disk Git repository reader: refs, loose objects, packfiles and delta
-// chains. Uses the vendored miniz for zlib inflate.
+// chains, plus the commit-graph file. Uses the vendored miniz for zlib inflate.
 //
-// Version: 1.0.0
-// Last Modified: 2026-07-30
+// Version: 1.1.0
+// Last Modified: 2026-10-18
 // Author: UltraCanvas Framework
 
 #include "UltraCanvasGitRepository.h"
+#include "UltraCanvasMappedFile.h"
 
 #include "miniz.h"
 
 #include <algorithm>
+#include <array>
+#include <climits>
 #include <cstdint>
 #include <cstring>
 #include <filesystem>
 #include <fstream>
+#include <list>
 #include <map>
+#include <mutex>
 #include <queue>
 #include <sstream>
 #include <unordered_map>
@@ -29,6 +34,9 @@ namespace fs = std::filesystem;
 
 constexpr int kMaxDeltaDepth = 64;
 
+// git's own core.deltaBaseCacheLimit default.
+constexpr size_t kDefaultDeltaBaseCacheLimit = size_t(96) << 20;
+
 std::string Trim(const std::string& text) {
     const size_t first = text.find_first_not_of(" \t\r\n");
     if (first == std::string::npos) return std::string();
@@ -88,8 +96,10 @@ bool InflateBuffer(const uint8_t* data, size_t size, size_t expectedSize, std::s
     mz_stream stream{};
     if (mz_inflateInit(&stream) != MZ_OK) return false;
 
+    // A mapped pack hands over everything from the entry to the end of the
+    // file; the stream stops at its own end marker well before that.
     stream.next_in  = data;
-    stream.avail_in = static_cast<unsigned int>(size);
+    stream.avail_in = static_cast<unsigned int>(std::min<size_t>(size, UINT_MAX));
 
     std::string result;
     result.resize(expectedSize > 0 ? expectedSize : std::max<size_t>(size * 4, 1024));
@@ -185,13 +195,57 @@ const char* ObjectTypeName(int type) {
     }
 }
 
-// One packfile: the whole .idx in memory (24 bytes per object) plus a handle on
-// the .pack, which is read on demand so a multi-gigabyte pack is never
-// slurped into RAM.
+// A read-only view of a whole file: mapped through UltraCanvasMappedFile,
+// or read into memory when that fails or the file is empty (nothing to map).
+struct MappedFile {
+    const uint8_t*        data = nullptr;
+    size_t                size = 0;
+    UltraCanvasMappedFile mapping;
+    std::string           buffer;
+
+    bool Open(const fs::path& path) {
+        Close();
+        const std::u8string name = path.u8string();
+        if (mapping.Open(std::string(name.begin(), name.end())) && mapping.Size() > 0) {
+            data = mapping.Data();
+            size = mapping.Size();
+            return true;
+        }
+        mapping.Close();
+        if (!ReadWholeFile(path, buffer)) return false;
+        data = reinterpret_cast<const uint8_t*>(buffer.data());
+        size = buffer.size();
+        return true;
+    }
+
+    void Close() {
+        mapping.Close();
+        buffer.clear();
+        data = nullptr;
+        size = 0;
+    }
+};
+
+// A fanout table: 256 big-endian counts of names whose first byte is <= i.
+// Lookups take their search range from it unchecked, so it must never
+// decrease and must end at `count`, the number of names that follow.
+bool ValidFanout(const uint8_t* fanout, uint32_t count) {
+    uint32_t previous = 0;
+    for (size_t i = 0; i < 256; ++i) {
+        const uint32_t value = ReadBigEndian32(fanout + i * 4);
+        if (value < previous) return false;
+        previous = value;
+    }
+    return previous == count;
+}
+
+// One packfile: the .idx (24 bytes per object) and the .pack, both mapped, so
+// a multi-gigabyte pack costs address space rather than RAM and an object
+// read is a pointer offset instead of a seek and a copy.
 struct PackFile {
-    std::string           idx;
-    mutable std::ifstream pack;
-    uint32_t              objectCount = 0;
+    MappedFile idx;
+    MappedFile pack;
+    uint32_t   objectCount = 0;
 
     // Offsets into `idx` of the sections of a v2 index.
     size_t namesOffset       = 0;
@@ -199,32 +253,35 @@ struct PackFile {
     size_t largeOffsetsBase  = 0;
 
     bool Load(const fs::path& idxPath, const fs::path& packPath) {
-        if (!ReadWholeFile(idxPath, idx)) return false;
-        if (idx.size() < 8 + 256 * 4) return false;
+        if (!idx.Open(idxPath)) return false;
+        if (idx.size < 8 + 256 * 4) return false;
 
-        const uint8_t* raw = reinterpret_cast<const uint8_t*>(idx.data());
+        const uint8_t* raw = idx.data;
         static const uint8_t magic[4] = {0xFF, 0x74, 0x4F, 0x63};
         if (std::memcmp(raw, magic, 4) != 0) return false;          // v1 unsupported
         if (ReadBigEndian32(raw + 4) != 2) return false;
 
         const size_t fanoutBase = 8;
         objectCount = ReadBigEndian32(raw + fanoutBase + 255 * 4);
+        if (!ValidFanout(raw + fanoutBase, objectCount)) return false;
 
         namesOffset      = fanoutBase + 256 * 4;
         smallOffsetsBase = namesOffset + static_cast<size_t>(objectCount) * 20
                                        + static_cast<size_t>(objectCount) * 4;   // names + crc
         largeOffsetsBase = smallOffsetsBase + static_cast<size_t>(objectCount) * 4;
 
-        if (idx.size() < largeOffsetsBase) return false;
+        if (idx.size < largeOffsetsBase) return false;
 
-        pack.open(packPath, std::ios::binary);
-        return pack.is_open();
+        // "PACK", version, object count, ..., 20-byte trailer.
+        if (!pack.Open(packPath) || pack.size < 12 + 20) return false;
+        return std::memcmp(pack.data, "PACK", 4) == 0 &&
+               ReadBigEndian32(pack.data + 8) == objectCount;
     }
 
     // Binary search the sorted name table.
     bool FindOffset(const uint8_t* sha, uint64_t& outOffset) const {
         if (objectCount == 0) return false;
-        const uint8_t* raw = reinterpret_cast<const uint8_t*>(idx.data());
+        const uint8_t* raw = idx.data;
         const uint8_t* names = raw + namesOffset;
 
         const size_t bucket = sha[0];
@@ -240,32 +297,254 @@ struct PackFile {
                 if (small & 0x80000000u) {
                     const size_t largeIndex = small & 0x7FFFFFFFu;
                     const size_t at = largeOffsetsBase + largeIndex * 8;
-                    if (at + 8 > idx.size()) return false;
+                    if (at + 8 > idx.size) return false;
                     outOffset = ReadBigEndian64(raw + at);
                 } else {
                     outOffset = small;
                 }
-                return true;
+                return outOffset < pack.size;
             }
             if (cmp < 0) high = mid; else low = mid + 1;
         }
         return false;
     }
+};
+
+// Resolved delta bases, least recently used evicted first. Bodies are shared
+// so a hit hands the base to ApplyDelta without copying it.
+struct DeltaBaseCache {
+    struct Key {
+        const PackFile* pack;
+        uint64_t        offset;
+        bool operator==(const Key& other) const {
+            return pack == other.pack && offset == other.offset;
+        }
+    };
+    struct KeyHash {
+        size_t operator()(const Key& key) const {
+            return std::hash<uint64_t>()(key.offset) ^
+                   (std::hash<const void*>()(key.pack) << 1);
+        }
+    };
+    struct Entry {
+        std::string                        type;
+        std::shared_ptr<const std::string> body;
+        std::list<Key>::iterator           position;
+    };
+
+    size_t limit = kDefaultDeltaBaseCacheLimit;
+    size_t bytes = 0;
+    std::list<Key> order;                                   // Most recent first
+    std::unordered_map<Key, Entry, KeyHash> entries;
+
+    bool Find(const Key& key, std::string& type, std::shared_ptr<const std::string>& body) {
+        auto it = entries.find(key);
+        if (it == entries.end()) return false;
+        order.splice(order.begin(), order, it->second.position);
+        type = it->second.type;
+        body = it->second.body;
+        return true;
+    }
+
+    void Insert(const Key& key, const std::string& type,
+                const std::shared_ptr<const std::string>& body) {
+        if (body->size() > limit || entries.count(key)) return;
+        bytes += body->size();
+        order.push_front(key);
+        entries[key] = Entry{type, body, order.begin()};
+        Trim();
+    }
+
+    void Trim() {
+        while (bytes > limit && !order.empty()) {
+            auto it = entries.find(order.back());
+            bytes -= it->second.body->size();
+            entries.erase(it);
+            order.pop_back();
+        }
+    }
+
+    void Clear() {
+        entries.clear();
+        order.clear();
+        bytes = 0;
+    }
+};
+
+// One commit-graph file. Chunks used: OIDF (fanout), OIDL (sorted ids), CDAT
+// (tree, two parent slots, generation and commit time) and EDGE (the extra
+// parents of octopus merges).
+struct CommitGraphLayer {
+    MappedFile     file;
+    uint32_t       count  = 0;
+    const uint8_t* fanout = nullptr;
+    const uint8_t* ids    = nullptr;
+    const uint8_t* data   = nullptr;
+    const uint8_t* edges  = nullptr;
+    size_t         edgeCount = 0;
+
+    bool Load(const fs::path& path) {
+        if (!file.Open(path) || file.size < 8 + 12) return false;
+        const uint8_t* raw = file.data;
+        if (std::memcmp(raw, "CGPH", 4) != 0) return false;
+        if (raw[4] != 1 || raw[5] != 1) return false;        // Version 1, SHA-1
+
+        const size_t chunkCount = raw[6];
+        const size_t tableEnd = 8 + (chunkCount + 1) * 12;
+        if (file.size < tableEnd) return false;
+
+        size_t fanoutSize = 0, idsSize = 0, dataSize = 0;
+        for (size_t i = 0; i < chunkCount; ++i) {
+            const uint8_t* entry = raw + 8 + i * 12;
+            const uint64_t begin = ReadBigEndian64(entry + 4);
+            const uint64_t end   = ReadBigEndian64(entry + 12 + 4);
+            if (begin > end || end > file.size) return false;
+
+            const uint8_t* chunk = raw + begin;
+            const size_t   size  = static_cast<size_t>(end - begin);
+            if      (std::memcmp(entry, "OIDF", 4) == 0) { fanout = chunk; fanoutSize = size; }
+            else if (std::memcmp(entry, "OIDL", 4) == 0) { ids    = chunk; idsSize    = size; }
+            else if (std::memcmp(entry, "CDAT", 4) == 0) { data   = chunk; dataSize   = size; }
+            else if (std::memcmp(entry, "EDGE", 4) == 0) { edges  = chunk; edgeCount  = size / 4; }
+        }
+
+        if (!fanout || !ids || !data || fanoutSize != 256 * 4) return false;
+        count = ReadBigEndian32(fanout + 255 * 4);
+        return ValidFanout(fanout, count) &&
+               idsSize == static_cast<size_t>(count) * 20 &&
+               dataSize == static_cast<size_t>(count) * 36;
+    }
+
+    bool Find(const uint8_t* sha, uint32_t& outIndex) const {
+        uint32_t low  = (sha[0] == 0) ? 0 : ReadBigEndian32(fanout + (sha[0] - 1) * 4);
+        uint32_t high = ReadBigEndian32(fanout + sha[0] * 4);
+        while (low < high) {
+            const uint32_t mid = low + (high - low) / 2;
+            const int cmp = std::memcmp(sha, ids + static_cast<size_t>(mid) * 20, 20);
+            if (cmp == 0) { outIndex = mid; return true; }
+            if (cmp < 0) high = mid; else low = mid + 1;
+        }
+        return false;
+    }
+};
+
+// The commit-graph: a single file, or a split chain of layers (base first)
+// whose positions continue from one layer to the next. Parent references are
+// positions in that combined numbering.
+struct CommitGraph {
+    static constexpr uint32_t kNoParent = 0x70000000u;
+
+    std::vector<std::unique_ptr<CommitGraphLayer>> layers;
+    std::vector<uint32_t> layerStart;       // Position of each layer's first commit
+    uint32_t total = 0;
+
+    bool Load(const fs::path& objectsDirectory) {
+        Clear();
+        const fs::path info = objectsDirectory / "info";
+        std::error_code ec;
 
-    bool ReadRange(uint64_t offset, size_t length, std::string& out) const {
-        pack.clear();
-        pack.seekg(static_cast<std::streamoff>(offset), std::ios::beg);
-        if (!pack) return false;
-        out.resize(length);
-        pack.read(&out[0], static_cast<std::streamsize>(length));
-        out.resize(static_cast<size_t>(pack.gcount()));
-        return !out.empty();
+        if (fs::exists(info / "commit-graph", ec)) {
+            if (AddLayer(info / "commit-graph")) return true;
+            Clear();
+        }
+
+        std::string chain;
+        if (!ReadWholeFile(info / "commit-graphs" / "commit-graph-chain", chain)) return false;
+        std::istringstream stream(chain);
+        std::string hash;
+        while (std::getline(stream, hash)) {
+            hash = Trim(hash);
+            if (hash.empty()) continue;
+            if (!AddLayer(info / "commit-graphs" / ("graph-" + hash + ".graph"))) {
+                // A broken upper layer leaves the lower ones usable.
+                break;
+            }
+        }
+        return total > 0;
     }
 
-    uint64_t Size() const {
-        pack.clear();
-        pack.seekg(0, std::ios::end);
-        return static_cast<uint64_t>(pack.tellg());
+    void Clear() {
+        layers.clear();
+        layerStart.clear();
+        total = 0;
+    }
+
+    bool Find(const uint8_t* sha, uint32_t& outPosition) const {
+        for (size_t i = 0; i < layers.size(); ++i) {
+            uint32_t index = 0;
+            if (layers[i]->Find(sha, index)) {
+                outPosition = layerStart[i] + index;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    const uint8_t* IdAt(uint32_t position) const {
+        const size_t layer = LayerOf(position);
+        return layers[layer]->ids + static_cast<size_t>(position - layerStart[layer]) * 20;
+    }
+
+    // Parents (as positions), commit time and topological level of one entry.
+    // Returns false on a corrupt parent reference.
+    bool Read(uint32_t position, std::vector<uint32_t>& parents, int64_t& commitDate,
+              uint32_t& generation) const {
+        const size_t layerIndex = LayerOf(position);
+        const CommitGraphLayer& layer = *layers[layerIndex];
+        const uint8_t* entry = layer.data
+                             + static_cast<size_t>(position - layerStart[layerIndex]) * 36;
+
+        parents.clear();
+        const uint32_t first  = ReadBigEndian32(entry + 20);
+        const uint32_t second = ReadBigEndian32(entry + 24);
+        if (first != kNoParent) parents.push_back(first);
+        if (second & 0x80000000u) {
+            // Octopus: the rest of the parents are a run in EDGE whose last
+            // element has the top bit set.
+            for (size_t edge = second & 0x7FFFFFFFu; ; ++edge) {
+                if (!layer.edges || edge >= layer.edgeCount) return false;
+                const uint32_t value = ReadBigEndian32(layer.edges + edge * 4);
+                parents.push_back(value & 0x7FFFFFFFu);
+                if (value & 0x80000000u) break;
+            }
+        } else if (second != kNoParent) {
+            parents.push_back(second);
+        }
+        for (uint32_t parent : parents) {
+            if (parent >= total) return false;
+        }
+
+        const uint32_t high = ReadBigEndian32(entry + 28);
+        const uint32_t low  = ReadBigEndian32(entry + 32);
+        generation = high >> 2;
+        commitDate = static_cast<int64_t>((static_cast<uint64_t>(high & 0x03u) << 32) | low);
+        return true;
+    }
+
+private:
+    bool AddLayer(const fs::path& path) {
+        auto layer = std::make_unique<CommitGraphLayer>();
+        if (!layer->Load(path)) return false;
+        layerStart.push_back(total);
+        total += layer->count;
+        layers.push_back(std::move(layer));
+        return true;
+    }
+
+    size_t LayerOf(uint32_t position) const {
+        size_t layer = layers.size() - 1;
+        while (layer > 0 && position < layerStart[layer]) --layer;
+        return layer;
+    }
+};
+
+using ObjectId = std::array<uint8_t, 20>;
+
+struct ObjectIdHash {
+    size_t operator()(const ObjectId& id) const {
+        size_t hash = 0;
+        std::memcpy(&hash, id.data(), sizeof(hash));     // Already uniformly distributed
+        return hash;
     }
 };
 
@@ -276,6 +555,11 @@ struct PackFile {
 // =============================================================================
 
 struct UltraCanvasGitRepository::Impl {
+    // Every public entry point takes this, so a walk on a worker thread and a
+    // single-object read on the UI thread never interleave. Recursive because
+    // public methods call each other (WalkMore seeds from ReadRefs).
+    mutable std::recursive_mutex mutex;
+
     std::string gitDirectory;
     std::string lastError;
     bool open = false;
@@ -283,10 +567,20 @@ struct UltraCanvasGitRepository::Impl {
     std::vector<std::unique_ptr<PackFile>> packs;
     bool packsLoaded = false;
 
+    DeltaBaseCache deltaBases;
+    GitRepositoryStats stats;
+
+    CommitGraph commitGraph;
+    bool commitGraphLoaded = false;
+    bool useCommitGraph = true;
+
     // Walk state (newest commit first).
+    static constexpr uint32_t kNotInGraph = UINT32_MAX;
     struct WalkEntry {
         int64_t     date;
         std::string sha;
+        uint32_t    graphPosition = kNotInGraph;
+        std::shared_ptr<GitGraphCommit> commit;     // Set when already inflated
         bool operator<(const WalkEntry& other) const {
             // std::priority_queue is a max-heap: newest date wins, sha breaks ties.
             if (date != other.date) return date < other.date;
@@ -294,7 +588,7 @@ struct UltraCanvasGitRepository::Impl {
         }
     };
     std::priority_queue<WalkEntry> frontier;
-    std::unordered_set<std::string> seen;
+    std::unordered_set<ObjectId, ObjectIdHash> seen;
     bool walkStarted = false;
 
     // ----- object access -------------------------------------------------
@@ -324,9 +618,6 @@ struct UltraCanvasGitRepository::Impl {
         if (sha.size() < 3) return false;
         const fs::path path = fs::path(gitDirectory) / "objects" / sha.substr(0, 2)
                                                      / sha.substr(2);
-        std::error_code ec;
-        if (!fs::exists(path, ec)) return false;
-
         std::string raw;
         if (!ReadWholeFile(path, raw)) return false;
 
@@ -335,6 +626,7 @@ struct UltraCanvasGitRepository::Impl {
                            inflated)) {
             return false;
         }
+        ++stats.objectsInflated;
 
         // "<type> <size>\0<body>"
         const size_t nul = inflated.find('\0');
@@ -348,77 +640,79 @@ struct UltraCanvasGitRepository::Impl {
         return true;
     }
 
+    // A delta base, from the cache or resolved and then cached.
+    bool ReadPackedBase(const PackFile& pack, uint64_t offset, int depth, std::string& type,
+                        std::shared_ptr<const std::string>& body) {
+        const DeltaBaseCache::Key key{&pack, offset};
+        if (deltaBases.limit > 0 && deltaBases.Find(key, type, body)) {
+            ++stats.deltaBaseHits;
+            return true;
+        }
+        ++stats.deltaBaseMisses;
+
+        auto resolved = std::make_shared<std::string>();
+        if (!ReadPackedObjectAt(pack, offset, depth, type, *resolved)) return false;
+        body = resolved;
+        if (deltaBases.limit > 0) deltaBases.Insert(key, type, body);
+        return true;
+    }
+
     // Reads one object out of a pack, resolving OFS_DELTA / REF_DELTA chains.
     bool ReadPackedObjectAt(const PackFile& pack, uint64_t offset, int depth,
                             std::string& type, std::string& body) {
         if (depth > kMaxDeltaDepth) return false;
+        if (offset >= pack.pack.size) return false;
 
-        std::string header;
-        if (!pack.ReadRange(offset, 32, header)) return false;
+        const uint8_t* entry = pack.pack.data + offset;
+        const size_t   available = static_cast<size_t>(pack.pack.size - offset);
 
         size_t pos = 0;
-        uint8_t byte = static_cast<uint8_t>(header[pos++]);
+        uint8_t byte = entry[pos++];
         int objectType = (byte >> 4) & 0x07;
         uint64_t size = byte & 0x0F;
         int shift = 4;
         while (byte & 0x80) {
-            if (pos >= header.size()) return false;
-            byte = static_cast<uint8_t>(header[pos++]);
+            if (pos >= available || shift > 57) return false;
+            byte = entry[pos++];
             size |= static_cast<uint64_t>(byte & 0x7F) << shift;
             shift += 7;
         }
 
-        std::string baseType, baseBody;
-        uint64_t dataOffset = offset + pos;
+        std::string baseType;
+        std::shared_ptr<const std::string> baseBody;
 
         if (objectType == 6) {                  // OFS_DELTA
-            if (pos >= header.size()) return false;
-            byte = static_cast<uint8_t>(header[pos++]);
+            if (pos >= available) return false;
+            byte = entry[pos++];
             uint64_t relative = byte & 0x7F;
             while (byte & 0x80) {
-                if (pos >= header.size()) return false;
-                byte = static_cast<uint8_t>(header[pos++]);
+                if (pos >= available) return false;
+                byte = entry[pos++];
                 relative = ((relative + 1) << 7) | (byte & 0x7F);
             }
-            if (relative > offset) return false;
-            if (!ReadPackedObjectAt(pack, offset - relative, depth + 1, baseType, baseBody)) {
+            if (relative == 0 || relative > offset) return false;
+            if (!ReadPackedBase(pack, offset - relative, depth + 1, baseType, baseBody)) {
                 return false;
             }
-            dataOffset = offset + pos;
         } else if (objectType == 7) {           // REF_DELTA
-            if (pos + 20 > header.size()) return false;
-            const std::string baseSha =
-                ToHex(reinterpret_cast<const uint8_t*>(header.data()) + pos, 20);
+            if (pos + 20 > available) return false;
+            const uint8_t* baseId = entry + pos;
             pos += 20;
-            dataOffset = offset + pos;
-            if (!ReadAnyObject(baseSha, baseType, baseBody, depth + 1)) return false;
+            if (!ReadBaseById(baseId, depth + 1, baseType, baseBody)) return false;
         }
 
-        // Inflate the entry payload. The compressed length is unknown, so feed
-        // the inflater a window that certainly covers it.
-        const uint64_t packSize = pack.Size();
-        const uint64_t available = (packSize > dataOffset) ? (packSize - dataOffset) : 0;
-        const size_t window = static_cast<size_t>(
-            std::min<uint64_t>(available, std::max<uint64_t>(size * 2 + 4096, 65536)));
-
-        std::string compressed;
-        if (!pack.ReadRange(dataOffset, window, compressed)) return false;
-
+        // The compressed length is not recorded; inflate straight out of the
+        // mapping and let the stream end where it ends.
         std::string payload;
-        if (!InflateBuffer(reinterpret_cast<const uint8_t*>(compressed.data()),
-                           compressed.size(), static_cast<size_t>(size), payload)) {
-            // Retry with everything left in the pack for pathological ratios.
-            if (window >= available ||
-                !pack.ReadRange(dataOffset, static_cast<size_t>(available), compressed) ||
-                !InflateBuffer(reinterpret_cast<const uint8_t*>(compressed.data()),
-                               compressed.size(), static_cast<size_t>(size), payload)) {
-                return false;
-            }
+        if (pos >= available ||
+            !InflateBuffer(entry + pos, available - pos, static_cast<size_t>(size), payload)) {
+            return false;
         }
+        ++stats.objectsInflated;
 
         if (objectType == 6 || objectType == 7) {
             std::string resolved;
-            if (!ApplyDelta(baseBody, payload, resolved)) return false;
+            if (!ApplyDelta(*baseBody, payload, resolved)) return false;
             type = baseType;
             body.swap(resolved);
             return true;
@@ -431,21 +725,61 @@ struct UltraCanvasGitRepository::Impl {
         return true;
     }
 
+    // REF_DELTA base: normally in the same or another pack (and then cached
+    // like any base), loose in a thin-pack fix-up.
+    bool ReadBaseById(const uint8_t* id, int depth, std::string& type,
+                      std::shared_ptr<const std::string>& body) {
+        for (const std::unique_ptr<PackFile>& pack : packs) {
+            uint64_t offset = 0;
+            if (!pack->FindOffset(id, offset)) continue;
+            if (ReadPackedBase(*pack, offset, depth, type, body)) return true;
+        }
+        auto loose = std::make_shared<std::string>();
+        if (!ReadLooseObject(ToHex(id, 20), type, *loose)) return false;
+        body = loose;
+        return true;
+    }
+
+    // Packs first, as git does: nearly everything in a large repository is
+    // packed, and probing the loose directory first costs a failed open() per
+    // object.
     bool ReadAnyObject(const std::string& sha, std::string& type, std::string& body,
                        int depth = 0) {
         if (sha.size() != 40) return false;
-        if (ReadLooseObject(sha, type, body)) return true;
-
-        LoadPacks();
         uint8_t raw[20];
         if (!FromHex(sha, raw, 20)) return false;
 
+        LoadPacks();
         for (const std::unique_ptr<PackFile>& pack : packs) {
             uint64_t offset = 0;
             if (!pack->FindOffset(raw, offset)) continue;
             if (ReadPackedObjectAt(*pack, offset, depth, type, body)) return true;
         }
-        return false;
+        return ReadLooseObject(sha, type, body);
+    }
+
+    // ----- commit-graph ---------------------------------------------------
+
+    // Null when there is no usable graph. Grafts and a shallow boundary
+    // rewrite parents, so git ignores the graph then and so do we.
+    const CommitGraph* Graph() {
+        if (!useCommitGraph) return nullptr;
+        if (!commitGraphLoaded) {
+            commitGraphLoaded = true;
+            const fs::path directory(gitDirectory);
+            std::error_code ec;
+            if (!fs::exists(directory / "shallow", ec) &&
+                !fs::exists(directory / "info" / "grafts", ec)) {
+                commitGraph.Load(directory / "objects");
+            }
+        }
+        return commitGraph.total > 0 ? &commitGraph : nullptr;
+    }
+
+    bool FindInGraph(const std::string& sha, uint32_t& position) {
+        const CommitGraph* graph = Graph();
+        uint8_t raw[20];
+        return graph && FromHex(sha, raw, 20) && graph->Find(raw, position);
     }
 
     // Follows tag objects down to the commit they point at.
@@ -666,6 +1000,79 @@ struct UltraCanvasGitRepository::Impl {
         return std::string();
     }
 
+    // ----- walk -----------------------------------------------------------
+
+    // Adds `sha` to the frontier unless already seen. Its date comes from the
+    // commit-graph when it is covered; otherwise the commit is inflated once
+    // and kept on the entry so emitting it later costs nothing more.
+    void Enqueue(const std::string& sha) {
+        ObjectId id;
+        if (sha.size() != 40 || !FromHex(sha, id.data(), 20)) return;
+        if (seen.count(id)) return;
+
+        uint32_t position = 0;
+        if (FindInGraph(sha, position)) {
+            EnqueueFromGraph(position, id, sha);
+            return;
+        }
+
+        auto commit = std::make_shared<GitGraphCommit>();
+        if (!LoadCommit(sha, *commit)) return;
+        seen.insert(id);
+        frontier.push({commit->commitDate, sha, kNotInGraph, std::move(commit)});
+    }
+
+    void EnqueueFromGraph(uint32_t position, const ObjectId& id, const std::string& sha) {
+        std::vector<uint32_t> parents;
+        int64_t date = 0;
+        uint32_t generation = 0;
+        if (!commitGraph.Read(position, parents, date, generation)) return;
+        if (!seen.insert(id).second) return;
+        ++stats.commitGraphHits;
+        frontier.push({date, sha, position, nullptr});
+    }
+
+    // The next commit, newest first, with its parents queued. False once the
+    // frontier is empty.
+    bool WalkNext(GitWalkDetail detail, GitGraphCommit& commit) {
+        while (!frontier.empty()) {
+            WalkEntry entry = frontier.top();
+            frontier.pop();
+
+            std::vector<uint32_t> graphParents;
+            bool fromGraph = false;
+            if (entry.commit) {
+                commit = std::move(*entry.commit);
+            } else if (detail == GitWalkDetail::Topology && entry.graphPosition != kNotInGraph) {
+                int64_t date = 0;
+                uint32_t generation = 0;
+                if (!commitGraph.Read(entry.graphPosition, graphParents, date, generation)) continue;
+                commit = GitGraphCommit();
+                commit.sha = entry.sha;
+                commit.commitDate = entry.date;
+                for (uint32_t parent : graphParents) {
+                    commit.parents.push_back(ToHex(commitGraph.IdAt(parent), 20));
+                }
+                fromGraph = true;
+            } else if (!LoadCommit(entry.sha, commit)) {
+                continue;
+            }
+
+            if (fromGraph) {
+                // Parents are graph positions already: no id search needed.
+                for (size_t i = 0; i < graphParents.size(); ++i) {
+                    ObjectId id;
+                    std::memcpy(id.data(), commitGraph.IdAt(graphParents[i]), 20);
+                    if (!seen.count(id)) EnqueueFromGraph(graphParents[i], id, commit.parents[i]);
+                }
+            } else {
+                for (const std::string& parent : commit.parents) Enqueue(parent);
+            }
+            return true;
+        }
+        return false;
+    }
+
     // ----- refs -----------------------------------------------------------
 
     void CollectRefsFromDirectory(const fs::path& base, const std::string& prefix,
@@ -728,6 +1135,7 @@ UltraCanvasGitRepository::UltraCanvasGitRepository() : impl(std::make_unique<Imp
 UltraCanvasGitRepository::~UltraCanvasGitRepository() = default;
 
 bool UltraCanvasGitRepository::Open(const std::string& path) {
+    std::lock_guard<std::recursive_mutex> lock(impl->mutex);
     Close();
 
     std::error_code ec;
@@ -779,20 +1187,30 @@ bool UltraCanvasGitRepository::Open(const std::string& path) {
 }
 
 void UltraCanvasGitRepository::Close() {
+    std::lock_guard<std::recursive_mutex> lock(impl->mutex);
     impl->gitDirectory.clear();
     impl->open = false;
+    impl->deltaBases.Clear();            // Keys point into the packs
     impl->packs.clear();
     impl->packsLoaded = false;
+    impl->commitGraph.Clear();
+    impl->commitGraphLoaded = false;
+    impl->stats = GitRepositoryStats();
     impl->seen.clear();
     impl->walkStarted = false;
     while (!impl->frontier.empty()) impl->frontier.pop();
 }
 
-bool UltraCanvasGitRepository::IsOpen() const { return impl->open; }
+bool UltraCanvasGitRepository::IsOpen() const {
+    std::lock_guard<std::recursive_mutex> lock(impl->mutex);
+    return impl->open;
+}
+
 const std::string& UltraCanvasGitRepository::GetGitDirectory() const { return impl->gitDirectory; }
 const std::string& UltraCanvasGitRepository::GetLastError() const { return impl->lastError; }
 
 std::string UltraCanvasGitRepository::ReadCurrentBranch() {
+    std::lock_guard<std::recursive_mutex> lock(impl->mutex);
     if (!impl->open) return std::string();
 
     std::string content;
@@ -806,6 +1224,7 @@ std::string UltraCanvasGitRepository::ReadCurrentBranch() {
 }
 
 std::string UltraCanvasGitRepository::ReadHeadSha() {
+    std::lock_guard<std::recursive_mutex> lock(impl->mutex);
     if (!impl->open) return std::string();
 
     std::string content;
@@ -826,6 +1245,7 @@ std::string UltraCanvasGitRepository::ReadHeadSha() {
 }
 
 std::vector<GitGraphRef> UltraCanvasGitRepository::ReadRefs() {
+    std::lock_guard<std::recursive_mutex> lock(impl->mutex);
     std::vector<GitGraphRef> result;
     if (!impl->open) return result;
 
@@ -890,18 +1310,21 @@ std::vector<GitGraphRef> UltraCanvasGitRepository::ReadRefs() {
 bool UltraCanvasGitRepository::ReadObject(const std::string& sha,
                                           const std::string& expectedType,
                                           std::string& outData, std::string& outType) {
+    std::lock_guard<std::recursive_mutex> lock(impl->mutex);
     if (!impl->open) return false;
     if (!impl->ReadAnyObject(sha, outType, outData)) return false;
     return expectedType.empty() || outType == expectedType;
 }
 
 bool UltraCanvasGitRepository::ReadCommit(const std::string& sha, GitGraphCommit& outCommit) {
+    std::lock_guard<std::recursive_mutex> lock(impl->mutex);
     if (!impl->open) return false;
     return impl->LoadCommit(sha, outCommit);
 }
 
 std::vector<GitGraphFileChange> UltraCanvasGitRepository::ReadChangedFiles(
         const std::string& sha, size_t maxFiles) {
+    std::lock_guard<std::recursive_mutex> lock(impl->mutex);
     std::vector<GitGraphFileChange> changes;
     if (!impl->open) return changes;
 
@@ -926,16 +1349,20 @@ std::vector<GitGraphFileChange> UltraCanvasGitRepository::ReadChangedFiles(
 }
 
 void UltraCanvasGitRepository::RestartWalk() {
+    std::lock_guard<std::recursive_mutex> lock(impl->mutex);
     while (!impl->frontier.empty()) impl->frontier.pop();
     impl->seen.clear();
     impl->walkStarted = false;
 }
 
 bool UltraCanvasGitRepository::IsWalkComplete() const {
+    std::lock_guard<std::recursive_mutex> lock(impl->mutex);
     return impl->walkStarted && impl->frontier.empty();
 }
 
-std::vector<GitGraphCommit> UltraCanvasGitRepository::WalkMore(size_t count) {
+std::vector<GitGraphCommit> UltraCanvasGitRepository::WalkMore(size_t count,
+                                                             GitWalkDetail detail) {
+    std::lock_guard<std::recursive_mutex> lock(impl->mutex);
     std::vector<GitGraphCommit> result;
     if (!impl->open || count == 0) return result;
 
@@ -947,43 +1374,18 @@ std::vector<GitGraphCommit> UltraCanvasGitRepository::WalkMore(size_t count) {
         const std::string head = ReadHeadSha();
         if (!head.empty()) tips.push_back(head);
 
-        for (const std::string& tip : tips) {
-            if (tip.size() != 40) continue;
-            if (!impl->seen.insert(tip).second) continue;
-            GitGraphCommit commit;
-            if (!impl->LoadCommit(tip, commit)) {
-                impl->seen.erase(tip);
-                continue;
-            }
-            impl->frontier.push({commit.commitDate, tip});
-        }
+        for (const std::string& tip : tips) impl->Enqueue(tip);
     }
 
-    while (result.size() < count && !impl->frontier.empty()) {
-        const Impl::WalkEntry entry = impl->frontier.top();
-        impl->frontier.pop();
-
-        GitGraphCommit commit;
-        if (!impl->LoadCommit(entry.sha, commit)) continue;
-        result.push_back(commit);
-
-        for (const std::string& parent : commit.parents) {
-            if (parent.size() != 40) continue;
-            if (!impl->seen.insert(parent).second) continue;
-
-            GitGraphCommit parentCommit;
-            if (!impl->LoadCommit(parent, parentCommit)) {
-                impl->seen.erase(parent);
-                continue;
-            }
-            impl->frontier.push({parentCommit.commitDate, parent});
-        }
+    GitGraphCommit commit;
+    while (result.size() < count && impl->WalkNext(detail, commit)) {
+        result.push_back(std::move(commit));
     }
-
     return result;
 }
 
 std::vector<GitGraphCommit> UltraCanvasGitRepository::ReadCommits(size_t limit) {
+    std::lock_guard<std::recursive_mutex> lock(impl->mutex);
     RestartWalk();
     if (limit > 0) return WalkMore(limit);
 
@@ -996,13 +1398,69 @@ std::vector<GitGraphCommit> UltraCanvasGitRepository::ReadCommits(size_t limit)
     return all;
 }
 
+bool UltraCanvasGitRepository::HasCommitGraph() {
+    std::lock_guard<std::recursive_mutex> lock(impl->mutex);
+    return impl->open && impl->Graph() != nullptr;
+}
+
+size_t UltraCanvasGitRepository::GetCommitGraphSize() {
+    std::lock_guard<std::recursive_mutex> lock(impl->mutex);
+    return (impl->open && impl->Graph()) ? impl->commitGraph.total : 0;
+}
+
+bool UltraCanvasGitRepository::ReadCommitGraphEntry(const std::string& sha,
+                                                    GitCommitGraphEntry& outEntry) {
+    std::lock_guard<std::recursive_mutex> lock(impl->mutex);
+    uint32_t position = 0;
+    if (!impl->open || !impl->FindInGraph(sha, position)) return false;
+
+    std::vector<uint32_t> parents;
+    GitCommitGraphEntry entry;
+    if (!impl->commitGraph.Read(position, parents, entry.commitDate, entry.generation)) {
+        return false;
+    }
+    for (uint32_t parent : parents) {
+        entry.parents.push_back(ToHex(impl->commitGraph.IdAt(parent), 20));
+    }
+    outEntry = std::move(entry);
+    return true;
+}
+
+void UltraCanvasGitRepository::SetUseCommitGraph(bool use) {
+    std::lock_guard<std::recursive_mutex> lock(impl->mutex);
+    impl->useCommitGraph = use;
+}
+
+void UltraCanvasGitRepository::SetDeltaBaseCacheLimit(size_t bytes) {
+    std::lock_guard<std::recursive_mutex> lock(impl->mutex);
+    impl->deltaBases.limit = bytes;
+    impl->deltaBases.Trim();
+}
+
+size_t UltraCanvasGitRepository::GetDeltaBaseCacheLimit() const {
+    std::lock_guard<std::recursive_mutex> lock(impl->mutex);
+    return impl->deltaBases.limit;
+}
+
+GitRepositoryStats UltraCanvasGitRepository::GetStats() const {
+    std::lock_guard<std::recursive_mutex> lock(impl->mutex);
+    GitRepositoryStats stats = impl->stats;
+    stats.deltaBaseBytes = impl->deltaBases.bytes;
+    return stats;
+}
+
+void UltraCanvasGitRepository::ResetStats() {
+    std::lock_guard<std::recursive_mutex> lock(impl->mutex);
+    impl->stats = GitRepositoryStats();
+}
+
 // =============================================================================
 // DATA SOURCE ADAPTER
 // =============================================================================
 
 UltraCanvasGitRepositorySource::UltraCanvasGitRepositorySource(
-        std::shared_ptr<UltraCanvasGitRepository> repository)
-    : repository(std::move(repository)) {}
+        std::shared_ptr<UltraCanvasGitRepository> repository, GitWalkDetail detail)
+    : repository(std::move(repository)), detail(detail) {}
 
 std::vector<GitGraphCommit> UltraCanvasGitRepositorySource::FetchCommits(size_t offset,
                                                                         size_t count) {
@@ -1012,7 +1470,7 @@ std::vector<GitGraphCommit> UltraCanvasGitRepositorySource::FetchCommits(size_t
     // serve any offset from that cache.
     while (walked.size() < offset + count) {
         std::vector<GitGraphCommit> chunk =
-            repository->WalkMore(offset + count - walked.size());
+            repository->WalkMore(offset + count - walked.size(), detail);
         if (chunk.empty()) break;
         walked.insert(walked.end(), chunk.begin(), chunk.end());
     }
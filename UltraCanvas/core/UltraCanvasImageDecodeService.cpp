@@ -0,0 +1,109 @@
+// core/UltraCanvasImageDecodeService.cpp
+// Prioritized background image decode pool — see the header for the
+// scheduling and cancellation rules.
+// Version: 1.1.0
+// Last Modified: 2026-10-18
+// Author: UltraCanvas Framework
+
+#include "UltraCanvasImageDecodeService.h"
+#include "UltraCanvasApplication.h"
+
+namespace UltraCanvas {
+
+    namespace {
+        UCImageDecodeService::Result CancelledResult() {
+            UCImageDecodeService::Result r;
+            r.status = UCImageDecodeService::DecodeStatus::Cancelled;
+            return r;
+        }
+    }
+
+    UCImageDecodeService::UCImageDecodeService()
+            : scheduler(CancelledResult(),
+                        [](const Result& r) { return r.status == DecodeStatus::Ready; },
+                        [](std::function<void()> deliver) {
+                            UltraCanvasApplicationBase* app = UltraCanvasApplicationBase::GetCurrent();
+                            if (app) {
+                                app->PostToUIThread(std::move(deliver));
+                            } else {
+                                deliver();
+                            }
+                        }) {}
+
+    UCImageDecodeService& UCImageDecodeService::GetInstance() {
+        static UCImageDecodeService instance;
+        return instance;
+    }
+
+    UCImageDecodeService::~UCImageDecodeService() {
+        Shutdown();
+    }
+
+    UCImageDecodeService::Ticket UCImageDecodeService::Submit(const Request& request,
+                                                              Callback onDone) {
+        if (request.path.empty()) return InvalidTicket;
+        const bool loadOnly = request.width <= 0 || request.height <= 0;
+        // Load jobs share the path's image; raster jobs the exact pixmap key.
+        std::string key = loadOnly
+                ? request.path + (request.prepareAnimation ? "?load+anim" : "?load")
+                : UCImage::MakePixmapCacheKey(request.path, request.width, request.height,
+                                              request.fitMode, request.scale);
+        Request job = request;
+        job.isOnScreen = nullptr;               // the worker never sees UI state
+        if (loadOnly) job.width = job.height = 0;
+        return scheduler.Submit(key, request.path, static_cast<int>(request.priority),
+                                [job]() { return Decode(job); },
+                                std::move(onDone), request.isOnScreen);
+    }
+
+    void UCImageDecodeService::Cancel(Ticket ticket) {
+        scheduler.Cancel(ticket);
+    }
+
+    void UCImageDecodeService::Touch(Ticket ticket) {
+        scheduler.Touch(ticket);
+    }
+
+    void UCImageDecodeService::SetPriority(Ticket ticket, Priority priority) {
+        scheduler.SetPriority(ticket, static_cast<int>(priority));
+    }
+
+    void UCImageDecodeService::CancelOffscreen() {
+        scheduler.CancelOffscreen();
+    }
+
+    void UCImageDecodeService::SetWorkerCount(int count) {
+        scheduler.SetWorkerCount(count);
+    }
+
+    int UCImageDecodeService::GetWorkerCount() const {
+        return scheduler.GetWorkerCount();
+    }
+
+    UCImageDecodeService::Stats UCImageDecodeService::GetStats() const {
+        return scheduler.GetStats();
+    }
+
+    void UCImageDecodeService::Shutdown() {
+        scheduler.Shutdown();
+    }
+
+    UCImageDecodeService::Result UCImageDecodeService::Decode(const Request& req) {
+        Result result;
+        result.image = UCImage::Get(req.path);
+        const bool loaded = result.image && result.image->IsValid() &&
+                            result.image->GetWidth() > 0 && result.image->GetHeight() > 0;
+        if (loaded && req.width > 0 && req.height > 0) {
+            result.pixmap = result.image->GetPixmap(req.width, req.height,
+                                                    req.fitMode, req.scale);
+            result.status = result.pixmap ? DecodeStatus::Ready : DecodeStatus::Failed;
+        } else {
+            if (loaded && req.prepareAnimation && result.image->IsAnimated()) {
+                result.image->GetAnimation();   // lazy, cached on the image
+            }
+            result.status = loaded ? DecodeStatus::Ready : DecodeStatus::Failed;
+        }
+        return result;
+    }
+
+}
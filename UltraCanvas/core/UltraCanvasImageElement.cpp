@@ -1,11 +1,12 @@
 // core/UltraCanvasImageElement.cpp
 // Image display component with loading, caching, and transformation support
-// Version: 1.1.0
-// Last Modified: 2026-06-02
+// Version: 1.2.0
+// Last Modified: 2026-10-18
 // Author: UltraCanvas Framework
 
 #include "UltraCanvasImageElement.h"
 #include "UltraCanvasImage.h"
+#include "UltraCanvasContainer.h"
 #include "UltraCanvasFileError.h"
 #include "CSSLayout/LayoutUtils.h"
 #include <optional>
@@ -35,6 +36,17 @@ namespace UltraCanvas {
         animator.onFrameChanged = [this]() { RequestRedraw(); };
     }
 
+    UltraCanvasImageElement::~UltraCanvasImageElement() {
+        // Cancelled tickets never call back, so no result can reach a
+        // destroyed element.
+        CancelAsyncWork();
+    }
+
+    void UltraCanvasImageElement::SetWindow(UltraCanvasWindowBase* win) {
+        if (!win) CancelPendingDecodes();
+        UltraCanvasUIElement::SetWindow(win);
+    }
+
     void UltraCanvasImageElement::SetupAnimation() {
         animator.SetAnimation(nullptr);
         if (!animationEnabled || !loadedImage || !loadedImage->IsValid() ||
@@ -57,15 +69,29 @@ namespace UltraCanvas {
 
     bool UltraCanvasImageElement::LoadFromFile(const std::string &filePath, bool forceLoad) {
         errorMessage.clear();
+        CancelAsyncWork();
+        imagePath = filePath;
         if (forceLoad) {
             UCImage::RemoveFromCache(filePath);
         }
+        if (asyncLoading && !UCImage::PeekCached(filePath)) {
+            // Loaded at Prefetch priority: it is wanted, but until the element
+            // is drawn nothing says it is on screen.
+            loadedImage = nullptr;
+            animator.SetAnimation(nullptr);
+            loadState = ImageLoadState::Loading;
+            SubmitAsyncLoad(UCImageDecodeService::Priority::Prefetch);
+            InvalidateLayout();
+            RequestRedraw();
+            return loadTicket != UCImageDecodeService::InvalidTicket;
+        }
         loadedImage = UCImage::Get(filePath);
         SetupAnimation();
         // Intrinsic size changed — re-measure (for auto-sized elements) and repaint.
         InvalidateLayout();
         RequestRedraw();
         if (loadedImage && loadedImage->IsValid()) {
+            loadState = ImageLoadState::Loaded;
             if (onImageLoaded) onImageLoaded();
             return true;
         }
@@ -83,7 +109,10 @@ namespace UltraCanvas {
     }
 
     bool UltraCanvasImageElement::LoadFromImage(std::shared_ptr<UCImage> img) {
+        CancelAsyncWork();
+        imagePath.clear();      // not a file: drawn synchronously
         loadedImage = img;
+        loadState = (img && img->IsValid()) ? ImageLoadState::Loaded : ImageLoadState::NotLoaded;
         SetupAnimation();
         // Intrinsic size changed — re-measure (for auto-sized elements) and repaint.
         InvalidateLayout();
@@ -94,6 +123,139 @@ namespace UltraCanvas {
         return false;
     }
 
+    void UltraCanvasImageElement::SetAsyncLoading(bool enable) {
+        if (asyncLoading == enable) return;
+        asyncLoading = enable;
+        if (!enable && loadState == ImageLoadState::Loading) {
+            // Finish the pending load the synchronous way.
+            LoadFromFile(imagePath);
+            return;
+        }
+        if (!enable) CancelAsyncWork();
+        RequestRedraw();
+    }
+
+    void UltraCanvasImageElement::CancelPendingDecodes() {
+        auto& service = UCImageDecodeService::GetInstance();
+        service.Cancel(loadTicket);
+        service.Cancel(rasterTicket);
+        loadTicket = rasterTicket = UCImageDecodeService::InvalidTicket;
+        rasterKey.clear();
+    }
+
+    void UltraCanvasImageElement::CancelAsyncWork() {
+        CancelPendingDecodes();
+        rasterFailedKey.clear();
+        readyPixmap = nullptr;
+        readyKey.clear();
+    }
+
+    void UltraCanvasImageElement::SubmitAsyncLoad(UCImageDecodeService::Priority priority) {
+        UCImageDecodeService::Request req;
+        req.path = imagePath;
+        req.priority = priority;
+        // GIF / WebP frames are a full decode too — keep them off this thread.
+        req.prepareAnimation = animationEnabled;
+        // A prefetch is wanted off screen too; only a load asked for by a
+        // draw is dropped once the element leaves the viewport.
+        if (priority == UCImageDecodeService::Priority::Visible) {
+            req.isOnScreen = [this]() { return IsInViewport(); };
+        }
+        loadTicket = UCImageDecodeService::GetInstance().Submit(
+                req, [this](const UCImageDecodeService::Result& r) { OnAsyncLoaded(r); });
+    }
+
+    void UltraCanvasImageElement::OnAsyncLoaded(const UCImageDecodeService::Result& result) {
+        loadTicket = UCImageDecodeService::InvalidTicket;
+        if (result.status == UCImageDecodeService::DecodeStatus::Cancelled) {
+            // Left the viewport while queued; Render re-asks once it is
+            // drawn again, so there is nothing to repaint now.
+            return;
+        }
+        if (result.status == UCImageDecodeService::DecodeStatus::Ready) {
+            loadedImage = result.image;
+            loadState = ImageLoadState::Loaded;
+            SetupAnimation();
+            InvalidateLayout();
+            RequestRedraw();
+            if (onImageLoaded) onImageLoaded();
+            return;
+        }
+        std::string reason;
+        if (result.image && !result.image->errorMessage.empty()) {
+            reason = result.image->errorMessage;
+        }
+        if (reason.empty()) reason = DescribeFileReadError(imagePath);
+        if (reason.empty()) reason = "Could not load image: " + imagePath;
+        InvalidateLayout();
+        RequestRedraw();
+        SetError(reason);
+    }
+
+    std::shared_ptr<UCPixmap> UltraCanvasImageElement::AcquireAsyncPixmap(IRenderContext* ctx) {
+        // Same size / scale arithmetic as IRenderContext::DrawImage, so the
+        // pixmap is the one a synchronous draw would have produced and cached.
+        Rect2Df bounds = GetLocalBounds();
+        const int w = static_cast<int>(bounds.width);
+        const int h = static_cast<int>(bounds.height);
+        const float deviceScale = ctx->GetDeviceScale();
+        if (w <= 0 || h <= 0) return readyPixmap;
+        const std::string key = loadedImage->MakePixmapCacheKey(w, h, fitMode, deviceScale);
+        if (key == readyKey && readyPixmap) return readyPixmap;
+
+        if (auto cached = loadedImage->PeekPixmap(w, h, fitMode, deviceScale)) {
+            UCImageDecodeService::GetInstance().Cancel(rasterTicket);
+            rasterTicket = UCImageDecodeService::InvalidTicket;
+            rasterKey.clear();
+            readyPixmap = cached;
+            readyKey = key;
+            return readyPixmap;
+        }
+
+        auto& service = UCImageDecodeService::GetInstance();
+        if (key == rasterKey && rasterTicket != UCImageDecodeService::InvalidTicket) {
+            service.Touch(rasterTicket);        // still on screen, still waiting
+        } else if (key != rasterFailedKey) {
+            service.Cancel(rasterTicket);       // a size nobody draws any more
+            UCImageDecodeService::Request req;
+            req.path = imagePath;
+            req.width = w;
+            req.height = h;
+            req.fitMode = fitMode;
+            req.scale = deviceScale;
+            req.priority = UCImageDecodeService::Priority::Visible;
+            req.isOnScreen = [this]() { return IsInViewport(); };
+            rasterKey = key;
+            rasterTicket = service.Submit(req, [this, key](const UCImageDecodeService::Result& r) {
+                if (key != rasterKey) return;
+                rasterTicket = UCImageDecodeService::InvalidTicket;
+                rasterKey.clear();
+                if (r.status == UCImageDecodeService::DecodeStatus::Cancelled) return;
+                if (r.status == UCImageDecodeService::DecodeStatus::Ready && r.pixmap) {
+                    readyPixmap = r.pixmap;
+                    readyKey = key;
+                } else if (r.status == UCImageDecodeService::DecodeStatus::Failed) {
+                    rasterFailedKey = key;
+                }
+                RequestRedraw();
+            });
+        }
+        return readyPixmap;     // the previous size meanwhile (null on first show)
+    }
+
+    bool UltraCanvasImageElement::IsInViewport() {
+        if (!GetWindow() || !IsVisible()) return false;
+        // Each ancestor clips its children to its scrolled content area —
+        // the same test its Render uses to skip them.
+        UltraCanvasUIElement* child = this;
+        for (UltraCanvasContainer* parent = GetParentContainer(); parent;
+             child = parent, parent = parent->GetParentContainer()) {
+            if (!parent->IsVisible()) return false;
+            if (!parent->GetVisibleChildBounds(child->GetBounds()).IsValid()) return false;
+        }
+        return true;
+    }
+
     Size2Df UltraCanvasImageElement::NaturalImageSize() const {
         if (loadedImage && loadedImage->IsValid()) {
             return Size2Df((float)loadedImage->GetWidth(), (float)loadedImage->GetHeight());
@@ -142,8 +304,17 @@ namespace UltraCanvas {
 
         if (loadedImage && loadedImage->IsValid()) {
             DrawLoadedImage(ctx);
-//        } else if (loadedImage->IsLoading()) {
-//            DrawLoadingPlaceholder(ctx);
+        } else if (loadState == ImageLoadState::Loading) {
+            // Being drawn means being on screen: promote the load, or re-ask
+            // when it was cancelled while this element was scrolled away.
+            auto& service = UCImageDecodeService::GetInstance();
+            if (loadTicket == UCImageDecodeService::InvalidTicket) {
+                SubmitAsyncLoad(UCImageDecodeService::Priority::Visible);
+            } else {
+                service.SetPriority(loadTicket, UCImageDecodeService::Priority::Visible);
+                service.Touch(loadTicket);
+            }
+            DrawLoadingPlaceholder(ctx);
         } else if (loadedImage && !loadedImage->errorMessage.empty() && showErrorPlaceholder) {
             DrawErrorPlaceholder(ctx);
         }
@@ -175,7 +346,7 @@ namespace UltraCanvas {
 
     void UltraCanvasImageElement::SetError(const std::string &message) {
         errorMessage = message;
-//        loadState = ImageLoadState::Failed;
+        loadState = ImageLoadState::Failed;
         loadedImage = std::make_shared<UCImage>(); // Reset
         animator.SetAnimation(nullptr);
 
@@ -211,6 +382,13 @@ namespace UltraCanvas {
         if (auto framePm = animator.GetCurrentFramePixmap()) {
             // Animated image: draw the controller's current frame directly.
             ctx->DrawPixmap(*framePm, GetLocalBounds(), fitMode);
+        } else if (loadedImage->IsValid() && asyncLoading && !imagePath.empty()) {
+            // Decoded off-thread; the placeholder until the first size lands.
+            if (auto pm = AcquireAsyncPixmap(ctx)) {
+                ctx->DrawPixmap(*pm, GetLocalBounds(), fitMode);
+            } else {
+                DrawLoadingPlaceholder(ctx);
+            }
         } else if (loadedImage->IsValid()) {
             // Load from file path
             ctx->DrawImage(*loadedImage.get(), GetLocalBounds(), fitMode);
@@ -1,8 +1,12 @@
 // core/UltraCanvasImageViewer.cpp
 // Implementation of the reusable lightbox image viewer (zoom / pan image +
 // info panel in its own window). Shared by the markdown renderer and Album.
-// Version: 1.1.0
-// Last Modified: 2026-07-12
+// Version: 1.2.0
+// Last Modified: 2026-10-18
+// V1.2.0: Tiled mode — large images loaded from a file are drawn as the
+//   visible 256 x 256 tiles of a UCTiledImagePyramid level picked from the
+//   zoom, with coarser tiles / a fit-size preview standing in for tiles that
+//   are still being read.
 // V1.1.0: Animated images (GIF / animated WebP) now play in the lightbox — the
 //   zoom / pan surface steps them with a UCImageAnimationController and draws
 //   the controller's current frame, so zoom / pan apply to the live animation.
@@ -13,6 +17,7 @@
 #include "UltraCanvasLabel.h"
 #include "UltraCanvasApplication.h"
 #include <algorithm>
+#include <cmath>
 
 namespace UltraCanvas {
 
@@ -24,22 +29,68 @@ namespace UltraCanvas {
         animator.onFrameChanged = [this]() { RequestRedraw(); };
     }
 
+    UltraCanvasZoomPanImage::~UltraCanvasZoomPanImage() {
+        CancelPreview();
+    }
+
     void UltraCanvasZoomPanImage::SetImage(std::shared_ptr<UCImage> img) {
+        ApplyImage(std::move(img), std::string());
+    }
+
+    void UltraCanvasZoomPanImage::LoadFromFile(const std::string& path) {
+        ApplyImage(UCImage::Get(path), path);
+    }
+
+    void UltraCanvasZoomPanImage::ApplyImage(std::shared_ptr<UCImage> img,
+                                             const std::string& path) {
         image = std::move(img);
+        CancelPreview();
+        previewPixmap.reset();
+        previewFailed = false;
+        pyramid.reset();
         // Animated sources (GIF / animated WebP) auto-play, matching
         // UltraCanvasImageElement; stills clear any previous animation.
         animator.SetAnimation(nullptr);
+        bool animated = false;
         if (image && image->IsValid() && image->IsAnimated()) {
             auto anim = image->GetAnimation();   // lazy full decode, shared + cached
             if (anim && anim->GetFrameCount() > 1) {
                 animator.SetAnimation(anim);
                 animator.Play();
+                animated = true;
+            }
+        }
+        if (!path.empty() && !animated && image && image->IsValid() &&
+            tiledMode != TiledMode::Disabled) {
+            const int w = image->GetWidth();
+            const int h = image->GetHeight();
+            const bool large = static_cast<int64_t>(w) * h > kTiledAutoPixels ||
+                               std::max(w, h) > kTiledAutoEdge;
+            if (tiledMode == TiledMode::Enabled || large) {
+                pyramid = std::make_unique<UCTiledImagePyramid>(path, [this]() { RequestRedraw(); });
+                pyramid->SetCacheBudget(tileCacheBudget);
             }
         }
         needsFit = true;
         RequestRedraw();
     }
 
+    void UltraCanvasZoomPanImage::SetTileCacheBudgetMB(int megabytes) {
+        tileCacheBudget = static_cast<size_t>(std::max(1, megabytes)) * 1024 * 1024;
+        if (pyramid) pyramid->SetCacheBudget(tileCacheBudget);
+    }
+
+    UCTiledImagePyramid::Stats UltraCanvasZoomPanImage::GetTileStats() const {
+        return pyramid ? pyramid->GetStats() : UCTiledImagePyramid::Stats();
+    }
+
+    void UltraCanvasZoomPanImage::CancelPreview() {
+        if (previewTicket != UCImageDecodeService::InvalidTicket) {
+            UCImageDecodeService::GetInstance().Cancel(previewTicket);
+            previewTicket = UCImageDecodeService::InvalidTicket;
+        }
+    }
+
     void UltraCanvasZoomPanImage::Render(IRenderContext* ctx, const Rect2Df& /*dirtyRect*/) {
         if (!IsVisible()) return;
         const Rect2Df b = GetLocalBounds();
@@ -49,6 +100,11 @@ namespace UltraCanvas {
         ctx->ClipRect(Rect2Dd(b.x, b.y, b.width, b.height));
         ctx->DrawFilledRectangle(Rect2Dd(b.x, b.y, b.width, b.height), canvasColor, 0.0f);
 
+        // A source libvips cannot stream into a pyramid falls back to the
+        // whole-image path.
+        if (pyramid && pyramid->GetState() == UCTiledImagePyramid::PyramidState::Failed) {
+            pyramid.reset();
+        }
         if (image && image->IsValid()) {
             const double iw = std::max(1, image->GetWidth());
             const double ih = std::max(1, image->GetHeight());
@@ -64,6 +120,8 @@ namespace UltraCanvas {
                 // zoom / pan transform applies to the running animation.
                 ctx->DrawPixmap(*framePm, Rect2Dd(left, top, dispW, dispH),
                                 ImageFitMode::Fill);
+            } else if (pyramid) {
+                RenderTiled(ctx, b, left, top, s);
             } else {
                 ctx->DrawImage(*image, Rect2Dd(left, top, dispW, dispH), ImageFitMode::Fill);
             }
@@ -71,6 +129,135 @@ namespace UltraCanvas {
         ctx->PopState();
     }
 
+    void UltraCanvasZoomPanImage::RenderTiled(IRenderContext* ctx, const Rect2Df& b,
+                                              double left, double top, double s) {
+        const double iw = std::max(1, image->GetWidth());
+        const double ih = std::max(1, image->GetHeight());
+        const double dispW = iw * s;
+        const double dispH = ih * s;
+
+        // Fit-size preview underneath: all there is while the pyramid builds,
+        // and what shows through where tiles are still missing.
+        if (previewPixmap) {
+            ctx->DrawPixmap(*previewPixmap, Rect2Dd(left, top, dispW, dispH), ImageFitMode::Fill);
+        } else if (previewTicket != UCImageDecodeService::InvalidTicket) {
+            UCImageDecodeService::GetInstance().Touch(previewTicket);
+        } else if (!previewFailed) {
+            const double fit = std::min(b.width / iw, b.height / ih);
+            UCImageDecodeService::Request req;
+            req.path = pyramid->GetSourcePath();
+            req.width = std::max(1, static_cast<int>(std::lround(iw * fit)));
+            req.height = std::max(1, static_cast<int>(std::lround(ih * fit)));
+            req.scale = ctx->GetDeviceScale();
+            previewTicket = UCImageDecodeService::GetInstance().Submit(
+                    req, [this](const UCImageDecodeService::Result& result) {
+                        previewTicket = UCImageDecodeService::InvalidTicket;
+                        if (result.status == UCImageDecodeService::DecodeStatus::Ready) {
+                            previewPixmap = result.pixmap;
+                        } else if (result.status == UCImageDecodeService::DecodeStatus::Failed) {
+                            previewFailed = true;
+                        }
+                        RequestRedraw();
+                    });
+        }
+
+        const int levels = pyramid->GetLevelCount();
+        if (levels == 0) return;    // still building
+        const int level = pyramid->ChooseLevel(s * ctx->GetDeviceScale());
+        int lw = 0, lh = 0, cols = 0, rows = 0;
+        if (!pyramid->GetLevelSize(level, lw, lh) || !pyramid->GetTileGrid(level, cols, rows)) {
+            return;
+        }
+
+        // Element units per level pixel, and the tiles the view intersects.
+        const double T  = UCTiledImagePyramid::kTileSize;
+        const double px = dispW / lw;
+        const double py = dispH / lh;
+        const double viewL = std::max<double>(b.x, left);
+        const double viewT = std::max<double>(b.y, top);
+        const double viewR = std::min<double>(b.x + b.width, left + dispW);
+        const double viewB = std::min<double>(b.y + b.height, top + dispH);
+        if (viewR <= viewL || viewB <= viewT) return;
+        const int c0 = std::clamp(static_cast<int>(std::floor((viewL - left) / (T * px))), 0, cols - 1);
+        const int c1 = std::clamp(static_cast<int>(std::floor((viewR - left) / (T * px))), 0, cols - 1);
+        const int r0 = std::clamp(static_cast<int>(std::floor((viewT - top) / (T * py))), 0, rows - 1);
+        const int r1 = std::clamp(static_cast<int>(std::floor((viewB - top) / (T * py))), 0, rows - 1);
+
+        // Tile edges snapped to whole pixels so neighbours meet without seams.
+        auto tileRect = [&](int col, int row) {
+            const double x0 = std::round(left + col * T * px);
+            const double y0 = std::round(top + row * T * py);
+            const double x1 = std::round(left + std::min((col + 1) * T, static_cast<double>(lw)) * px);
+            const double y1 = std::round(top + std::min((row + 1) * T, static_cast<double>(lh)) * py);
+            return Rect2Dd(x0, y0, x1 - x0, y1 - y0);
+        };
+
+        std::vector<UCTiledImagePyramid::TileKey> missing;
+        for (int row = r0; row <= r1; ++row) {
+            for (int col = c0; col <= c1; ++col) {
+                const UCTiledImagePyramid::TileKey key{level, col, row};
+                const Rect2Dd dest = tileRect(col, row);
+                if (auto tile = pyramid->GetTile(key)) {
+                    ctx->DrawPixmap(*tile, dest, ImageFitMode::Fill);
+                    continue;
+                }
+                missing.push_back(key);
+                // Stand-in: the same area cut from the nearest coarser tile.
+                for (int up = level + 1; up < levels; ++up) {
+                    int aw = 0, ah = 0;
+                    if (!pyramid->GetLevelSize(up, aw, ah)) break;
+                    const double fx = static_cast<double>(aw) / lw;
+                    const double fy = static_cast<double>(ah) / lh;
+                    const double ax0 = col * T * fx;
+                    const double ay0 = row * T * fy;
+                    const int acol = static_cast<int>(ax0 / T);
+                    const int arow = static_cast<int>(ay0 / T);
+                    auto anc = pyramid->GetTile(UCTiledImagePyramid::TileKey{up, acol, arow});
+                    if (!anc) continue;
+                    const double ax1 = std::min({std::min((col + 1) * T, static_cast<double>(lw)) * fx,
+                                                 (acol + 1) * T, static_cast<double>(aw)});
+                    const double ay1 = std::min({std::min((row + 1) * T, static_cast<double>(lh)) * fy,
+                                                 (arow + 1) * T, static_cast<double>(ah)});
+                    if (ax1 > ax0 && ay1 > ay0) {
+                        ctx->DrawPartOfPixmap(*anc,
+                                              Rect2Dd(ax0 - acol * T, ay0 - arow * T, ax1 - ax0, ay1 - ay0),
+                                              dest);
+                    }
+                    break;
+                }
+            }
+        }
+
+        // Read order: missing visible tiles from the centre out, then a
+        // one-tile ring around the view, then the coarsest level (a cheap
+        // stand-in for any future view) when it is small.
+        const double midC = (c0 + c1) * 0.5;
+        const double midR = (r0 + r1) * 0.5;
+        std::sort(missing.begin(), missing.end(),
+                  [midC, midR](const UCTiledImagePyramid::TileKey& a,
+                               const UCTiledImagePyramid::TileKey& k) {
+                      const double da = (a.col - midC) * (a.col - midC) + (a.row - midR) * (a.row - midR);
+                      const double dk = (k.col - midC) * (k.col - midC) + (k.row - midR) * (k.row - midR);
+                      return da < dk;
+                  });
+        for (int row = std::max(0, r0 - 1); row <= std::min(rows - 1, r1 + 1); ++row) {
+            for (int col = std::max(0, c0 - 1); col <= std::min(cols - 1, c1 + 1); ++col) {
+                if (row >= r0 && row <= r1 && col >= c0 && col <= c1) continue;
+                missing.push_back(UCTiledImagePyramid::TileKey{level, col, row});
+            }
+        }
+        int topCols = 0, topRows = 0;
+        if (level != levels - 1 && pyramid->GetTileGrid(levels - 1, topCols, topRows) &&
+            topCols * topRows <= 4) {
+            for (int row = 0; row < topRows; ++row) {
+                for (int col = 0; col < topCols; ++col) {
+                    missing.push_back(UCTiledImagePyramid::TileKey{levels - 1, col, row});
+                }
+            }
+        }
+        pyramid->SetWanted(missing);
+    }
+
     bool UltraCanvasZoomPanImage::OnEvent(const UCEvent& event) {
         switch (event.type) {
             case UCEventType::MouseWheel:
@@ -132,10 +319,13 @@ namespace UltraCanvas {
         const double imgY = (event.pointer.y - topOld)  / sOld;
 
         const double step = (event.wheelDelta > 0) ? 1.15 : (1.0 / 1.15);
-        double newZoom = std::max(1.0, std::min(zoom * step, 40.0));
+        // Tiled images only ever draw a screenful, so they may zoom on to
+        // 4:1 of the original pixels.
+        const double maxZoom = pyramid ? std::max(40.0, 4.0 / fit) : 40.0;
+        double newZoom = std::max(1.0, std::min(zoom * step, maxZoom));
         // Cap the rasterized size so very large SVG zooms stay responsive.
         const double maxDim = 8000.0;
-        if (iw * fit * newZoom > maxDim || ih * fit * newZoom > maxDim) {
+        if (!pyramid && (iw * fit * newZoom > maxDim || ih * fit * newZoom > maxDim)) {
             newZoom = std::max(1.0, std::min(maxDim / (iw * fit), maxDim / (ih * fit)));
         }
         if (newZoom == zoom) return true;
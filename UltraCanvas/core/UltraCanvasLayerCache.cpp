@@ -0,0 +1,92 @@
+// core/UltraCanvasLayerCache.cpp
+// Retained offscreen layers for elements with layer caching switched on
+// Version: 1.0.0
+// Last Modified: 2026-10-18
+// Author: UltraCanvas Framework
+
+#include "UltraCanvasLayerCache.h"
+
+#include <cmath>
+
+namespace UltraCanvas {
+
+    UltraCanvasLayerCache& UltraCanvasLayerCache::GetInstance() {
+        static UltraCanvasLayerCache instance;
+        return instance;
+    }
+
+    UltraCanvasLayerCache::Layer* UltraCanvasLayerCache::Acquire(const UltraCanvasUIElement* owner,
+                                                                 const Size2Di& size, IRenderContext* target) {
+        if (!owner || !target || size.width <= 0 || size.height <= 0) return nullptr;
+
+        const float scale = target->GetDeviceScale();
+        const size_t bytes = static_cast<size_t>(std::ceil(size.width * scale)) *
+                             static_cast<size_t>(std::ceil(size.height * scale)) * 4u;
+
+        auto found = index.find(owner);
+        if (found != index.end()) {
+            Layer& layer = found->second->second;
+            if (layer.size == size && layer.scale == scale) {
+                lru.splice(lru.begin(), lru, found->second);
+                return &layer;
+            }
+            Erase(found->second);
+        }
+        if (bytes > budgetBytes) return nullptr;
+
+        auto context = CreateRenderContext(size, target->GetNativeSurface());
+        if (!context) return nullptr;
+
+        lru.emplace_front(owner, Layer());
+        Layer& layer = lru.front().second;
+        layer.context = std::move(context);
+        layer.size = size;
+        layer.scale = scale;
+        layer.bytes = bytes;
+        layer.dirty = Rect2Df(0, 0, static_cast<float>(size.width), static_cast<float>(size.height));
+        index[owner] = lru.begin();
+        bytesUsed += bytes;
+
+        EvictToBudget(&layer);
+        return &layer;
+    }
+
+    void UltraCanvasLayerCache::Invalidate(const UltraCanvasUIElement* owner, const Rect2Df& rect) {
+        auto found = index.find(owner);
+        if (found == index.end()) return;
+        Layer& layer = found->second->second;
+        const Rect2Df bounds(0, 0, static_cast<float>(layer.size.width), static_cast<float>(layer.size.height));
+        const Rect2Df clipped = rect.Intersection(bounds);
+        if (clipped.width <= 0 || clipped.height <= 0) return;
+        layer.dirty = layer.dirty.Union(clipped);
+    }
+
+    void UltraCanvasLayerCache::Release(const UltraCanvasUIElement* owner) {
+        auto found = index.find(owner);
+        if (found != index.end()) Erase(found->second);
+    }
+
+    void UltraCanvasLayerCache::SetBudget(size_t bytes) {
+        budgetBytes = bytes;
+        EvictToBudget(nullptr);
+    }
+
+    void UltraCanvasLayerCache::EvictToBudget(const Layer* keep) {
+        auto it = lru.end();
+        while (bytesUsed > budgetBytes && it != lru.begin()) {
+            --it;
+            const Layer& layer = it->second;
+            if (&layer == keep || layer.rasterizing) continue;
+            auto victim = it++;
+            Erase(victim);
+            stats.evictions++;
+        }
+    }
+
+    void UltraCanvasLayerCache::Erase(std::list<Entry>::iterator it) {
+        bytesUsed -= it->second.bytes;
+        index.erase(it->first);
+        lru.erase(it);
+    }
+
+} // namespace UltraCanvas
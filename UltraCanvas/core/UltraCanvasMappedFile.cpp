@@ -0,0 +1,144 @@
+// core/UltraCanvasMappedFile.cpp
+// Read-only memory mapping of a whole file (POSIX mmap / Win32 file mapping)
+// Version: 1.0.0
+// Last Modified: 2026-10-18
+// Author: UltraCanvas Framework
+
+#include "UltraCanvasMappedFile.h"
+
+#include <utility>
+
+#ifdef _WIN32
+    #ifndef NOMINMAX
+    #define NOMINMAX
+    #endif
+    #include <windows.h>
+#else
+    #include <cerrno>
+    #include <cstring>
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace UltraCanvas {
+
+    UltraCanvasMappedFile::UltraCanvasMappedFile(UltraCanvasMappedFile&& other) noexcept {
+        *this = std::move(other);
+    }
+
+    UltraCanvasMappedFile& UltraCanvasMappedFile::operator=(UltraCanvasMappedFile&& other) noexcept {
+        if (this == &other) return *this;
+        Close();
+        data = std::exchange(other.data, nullptr);
+        size = std::exchange(other.size, 0);
+        open = std::exchange(other.open, false);
+        lastError = std::move(other.lastError);
+#ifdef _WIN32
+        fileHandle = std::exchange(other.fileHandle, nullptr);
+        mappingHandle = std::exchange(other.mappingHandle, nullptr);
+#endif
+        return *this;
+    }
+
+#ifdef _WIN32
+
+    bool UltraCanvasMappedFile::Open(const std::string& path) {
+        Close();
+        const int wideLen = MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, nullptr, 0);
+        std::wstring widePath(wideLen > 0 ? wideLen - 1 : 0, L'\0');
+        if (wideLen > 1) MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, widePath.data(), wideLen);
+
+        HANDLE file = CreateFileW(widePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                  OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            lastError = "Cannot open file: " + path;
+            return false;
+        }
+        LARGE_INTEGER fileSize{};
+        if (!GetFileSizeEx(file, &fileSize)) {
+            CloseHandle(file);
+            lastError = "Cannot determine file size: " + path;
+            return false;
+        }
+        open = true;
+        if (fileSize.QuadPart == 0) {
+            CloseHandle(file);
+            return true;
+        }
+        HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+        if (!view) {
+            if (mapping) CloseHandle(mapping);
+            CloseHandle(file);
+            open = false;
+            lastError = "Cannot map file: " + path;
+            return false;
+        }
+        fileHandle = file;
+        mappingHandle = mapping;
+        data = static_cast<const uint8_t*>(view);
+        size = static_cast<size_t>(fileSize.QuadPart);
+        return true;
+    }
+
+    void UltraCanvasMappedFile::Close() {
+        if (data) UnmapViewOfFile(data);
+        if (mappingHandle) CloseHandle(static_cast<HANDLE>(mappingHandle));
+        if (fileHandle) CloseHandle(static_cast<HANDLE>(fileHandle));
+        data = nullptr;
+        mappingHandle = fileHandle = nullptr;
+        size = 0;
+        open = false;
+    }
+
+    void UltraCanvasMappedFile::AdviseSequential() const {}
+
+#else
+
+    bool UltraCanvasMappedFile::Open(const std::string& path) {
+        Close();
+        const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            lastError = "Cannot open file: " + path + " (" + std::strerror(errno) + ")";
+            return false;
+        }
+        struct stat st{};
+        if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+            ::close(fd);
+            lastError = "Not a regular file: " + path;
+            return false;
+        }
+        open = true;
+        if (st.st_size == 0) {
+            ::close(fd);
+            return true;
+        }
+        void* view = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        // The mapping keeps its own reference to the file.
+        ::close(fd);
+        if (view == MAP_FAILED) {
+            open = false;
+            lastError = "Cannot map file: " + path + " (" + std::strerror(errno) + ")";
+            return false;
+        }
+        data = static_cast<const uint8_t*>(view);
+        size = static_cast<size_t>(st.st_size);
+        return true;
+    }
+
+    void UltraCanvasMappedFile::Close() {
+        if (data) munmap(const_cast<uint8_t*>(data), size);
+        data = nullptr;
+        size = 0;
+        open = false;
+    }
+
+    void UltraCanvasMappedFile::AdviseSequential() const {
+        if (data) madvise(const_cast<uint8_t*>(data), size, MADV_SEQUENTIAL);
+    }
+
+#endif
+
+} // namespace UltraCanvas
@@ -0,0 +1,54 @@
+// core/UltraCanvasRasterTiles.cpp
+// Screen-tile partitioning for rasterizing one recorded frame on several threads
+// Version: 1.0.0
+// Last Modified: 2026-10-18
+// Author: UltraCanvas Framework
+
+#include "UltraCanvasRasterTiles.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace UltraCanvas {
+
+    Rect2Di LogicalToDeviceRect(const Rect2Di& logical, float deviceScale) {
+        const double s = deviceScale > 0.0f ? deviceScale : 1.0;
+        const int x0 = static_cast<int>(std::floor(logical.x * s));
+        const int y0 = static_cast<int>(std::floor(logical.y * s));
+        const int x1 = static_cast<int>(std::ceil((logical.x + logical.width) * s));
+        const int y1 = static_cast<int>(std::ceil((logical.y + logical.height) * s));
+        return Rect2Di(x0, y0, x1 - x0, y1 - y0);
+    }
+
+    std::vector<Rect2Di> BuildRasterTiles(const std::vector<Rect2Di>& logicalRegions, float deviceScale,
+                                          const Size2Di& surfacePixels, int tileSize) {
+        std::vector<Rect2Di> tiles;
+        if (surfacePixels.width <= 0 || surfacePixels.height <= 0 || tileSize <= 0) return tiles;
+
+        const int cols = (surfacePixels.width + tileSize - 1) / tileSize;
+        const int rows = (surfacePixels.height + tileSize - 1) / tileSize;
+        std::vector<char> touched(static_cast<size_t>(cols) * rows, 0);
+        const Rect2Di surfaceRect(0, 0, surfacePixels.width, surfacePixels.height);
+
+        for (const auto& region : logicalRegions) {
+            const Rect2Di r = LogicalToDeviceRect(region, deviceScale).Intersection(surfaceRect);
+            if (r.width <= 0 || r.height <= 0) continue;
+            const int c0 = r.x / tileSize, c1 = (r.x + r.width - 1) / tileSize;
+            const int r0 = r.y / tileSize, r1 = (r.y + r.height - 1) / tileSize;
+            for (int row = r0; row <= r1; row++) {
+                std::fill(touched.begin() + row * cols + c0, touched.begin() + row * cols + c1 + 1, 1);
+            }
+        }
+
+        for (int row = 0; row < rows; row++) {
+            for (int col = 0; col < cols; col++) {
+                if (!touched[static_cast<size_t>(row) * cols + col]) continue;
+                const int x = col * tileSize, y = row * tileSize;
+                tiles.emplace_back(x, y, std::min(tileSize, surfacePixels.width - x),
+                                   std::min(tileSize, surfacePixels.height - y));
+            }
+        }
+        return tiles;
+    }
+
+} // namespace UltraCanvas
@@ -0,0 +1,376 @@
+// core/UltraCanvasTableIndex.cpp
+// Columnar sort / filter keys and display-order builder for the table view.
+// Version: 1.1.0
+// Last Modified: 2026-10-18
+// Author: UltraCanvas Framework
+
+#include "UltraCanvasTableIndex.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+
+namespace UltraCanvas {
+
+    namespace {
+        constexpr size_t kCancelCheckRows = 4096;
+
+        struct IndexBuildCancelled {};
+
+        bool Cancelled(const std::atomic<bool>* cancel) {
+            return cancel && cancel->load(std::memory_order_relaxed);
+        }
+
+        // Same acceptance as the std::stod the table used to call per
+        // comparison: leading blanks, then any numeric prefix.
+        double ParseNumber(const std::string& s) {
+            const char* begin = s.c_str();
+            char* end = nullptr;
+            const double v = std::strtod(begin, &end);
+            if (end == begin || std::isnan(v)) return std::numeric_limits<double>::quiet_NaN();
+            return v;
+        }
+
+        // Numbers by value, before all text; text by bytes. (Comparing
+        // mixed pairs either way, as the old comparator did, is not a
+        // strict weak order and scrambles mixed columns.)
+        bool KeyLess(double numberA, std::string_view textA, double numberB, std::string_view textB) {
+            const bool numA = numberA == numberA;
+            const bool numB = numberB == numberB;
+            if (numA != numB) return numA;
+            if (numA) return numberA < numberB;
+            return textA < textB;
+        }
+    }
+
+    std::shared_ptr<TableColumnKeys::Chunk> TableColumnKeys::NewChunk() {
+        auto chunk = std::make_shared<Chunk>();
+        chunk->offsets.push_back(0);
+        return chunk;
+    }
+
+    // ===== TableColumnKeys =====
+
+    std::shared_ptr<TableColumnKeys> TableColumnKeys::Build(
+            size_t rowCount,
+            const std::function<std::string(size_t row)>& cellText,
+            const std::atomic<bool>* cancel) {
+        auto keys = std::make_shared<TableColumnKeys>();
+        keys->rowCount = rowCount;
+        for (size_t first = 0; first < rowCount; first += kChunkRows) {
+            if (Cancelled(cancel)) return nullptr;
+            const size_t last = std::min(rowCount, first + kChunkRows);
+            auto chunk = NewChunk();
+            chunk->numbers.reserve(last - first);
+            chunk->offsets.reserve(last - first + 1);
+            for (size_t row = first; row < last; ++row) {
+                const std::string cell = cellText(row);
+                chunk->numbers.push_back(ParseNumber(cell));
+                chunk->text += cell;
+                chunk->offsets.push_back(chunk->text.size());
+            }
+            chunk->text.shrink_to_fit();
+            keys->slots.push_back(Slot{std::move(chunk), first, false});
+        }
+        return keys;
+    }
+
+    size_t TableColumnKeys::Locate(size_t row) const {
+        auto it = std::upper_bound(slots.begin(), slots.end(), row,
+                                   [](size_t r, const Slot& slot) { return r < slot.firstRow; });
+        return static_cast<size_t>(it - slots.begin()) - 1;
+    }
+
+    std::string_view TableColumnKeys::Text(size_t row) const {
+        const Slot& slot = slots[Locate(row)];
+        return slot.chunk->Text(row - slot.firstRow);
+    }
+
+    double TableColumnKeys::Number(size_t row) const {
+        const Slot& slot = slots[Locate(row)];
+        return slot.chunk->numbers[row - slot.firstRow];
+    }
+
+    TableColumnKeys::Chunk& TableColumnKeys::Writable(size_t slot) {
+        if (slots[slot].shared) {
+            slots[slot].chunk = std::make_shared<Chunk>(*slots[slot].chunk);
+            slots[slot].shared = false;
+        }
+        return *slots[slot].chunk;
+    }
+
+    void TableColumnKeys::Set(size_t row, const std::string& text) {
+        if (row >= rowCount) return;
+        const size_t i = Locate(row);
+        Chunk& chunk = Writable(i);
+        const size_t local = row - slots[i].firstRow;
+        const uint64_t begin = chunk.offsets[local];
+        const uint64_t length = chunk.offsets[local + 1] - begin;
+        chunk.text.replace(begin, length, text);
+        for (size_t k = local + 1; k < chunk.offsets.size(); ++k) {
+            chunk.offsets[k] = chunk.offsets[k] - length + text.size();
+        }
+        chunk.numbers[local] = ParseNumber(text);
+    }
+
+    void TableColumnKeys::Insert(size_t row, const std::string& text) {
+        if (row > rowCount) return;
+        if (slots.empty()) slots.push_back(Slot{NewChunk(), 0, false});
+        const size_t i = row == rowCount ? slots.size() - 1 : Locate(row);
+        Chunk& chunk = Writable(i);
+        const size_t local = row - slots[i].firstRow;
+        const uint64_t at = chunk.offsets[local];
+        chunk.text.insert(at, text);
+        chunk.offsets.insert(chunk.offsets.begin() + local, at);
+        for (size_t k = local + 1; k < chunk.offsets.size(); ++k) chunk.offsets[k] += text.size();
+        chunk.numbers.insert(chunk.numbers.begin() + local, ParseNumber(text));
+        ++rowCount;
+        for (size_t k = i + 1; k < slots.size(); ++k) ++slots[k].firstRow;
+
+        // Split a chunk that doubled, so edits stay O(kChunkRows)
+        if (chunk.numbers.size() >= 2 * kChunkRows) {
+            const size_t half = chunk.numbers.size() / 2;
+            const uint64_t base = chunk.offsets[half];
+            auto tail = std::make_shared<Chunk>();
+            tail->numbers.assign(chunk.numbers.begin() + half, chunk.numbers.end());
+            tail->text = chunk.text.substr(base);
+            for (size_t k = half; k < chunk.offsets.size(); ++k) {
+                tail->offsets.push_back(chunk.offsets[k] - base);
+            }
+            chunk.numbers.resize(half);
+            chunk.offsets.resize(half + 1);
+            chunk.text.resize(base);
+            const size_t tailFirst = slots[i].firstRow + half;
+            slots.insert(slots.begin() + i + 1, Slot{std::move(tail), tailFirst, false});
+        }
+    }
+
+    void TableColumnKeys::Remove(size_t row) {
+        if (row >= rowCount) return;
+        const size_t i = Locate(row);
+        Chunk& chunk = Writable(i);
+        const size_t local = row - slots[i].firstRow;
+        const uint64_t begin = chunk.offsets[local];
+        const uint64_t length = chunk.offsets[local + 1] - begin;
+        chunk.text.erase(begin, length);
+        chunk.offsets.erase(chunk.offsets.begin() + local);
+        for (size_t k = local; k < chunk.offsets.size(); ++k) chunk.offsets[k] -= length;
+        chunk.numbers.erase(chunk.numbers.begin() + local);
+        --rowCount;
+        for (size_t k = i + 1; k < slots.size(); ++k) --slots[k].firstRow;
+        if (chunk.numbers.empty()) slots.erase(slots.begin() + i);
+    }
+
+    std::shared_ptr<const TableColumnKeys> TableColumnKeys::Snapshot() {
+        for (Slot& slot : slots) slot.shared = true;
+        return std::shared_ptr<const TableColumnKeys>(new TableColumnKeys(*this));
+    }
+
+    // ===== DISPLAY ORDER =====
+
+    bool BuildTableDisplayIndex(size_t rowCount,
+                                const TableColumnKeys* sortKeys, bool ascending,
+                                const std::string& filter,
+                                const std::vector<const TableColumnKeys*>& filterColumns,
+                                std::vector<int32_t>& out,
+                                const std::atomic<bool>* cancel) {
+        out.clear();
+        if (filter.empty()) {
+            out.resize(rowCount);
+            for (size_t row = 0; row < rowCount; ++row) out[row] = static_cast<int32_t>(row);
+        } else {
+            // Column by column, each a sequential walk over its chunks
+            std::vector<char> keep(rowCount, 0);
+            for (const TableColumnKeys* column : filterColumns) {
+                if (!column) continue;
+                const bool finished = column->ForEachRow(
+                        [&](size_t row, std::string_view text, double) {
+                            if (row < rowCount && !keep[row] &&
+                                text.find(filter) != std::string_view::npos) {
+                                keep[row] = 1;
+                            }
+                        }, cancel);
+                if (!finished) return false;
+            }
+            for (size_t row = 0; row < rowCount; ++row) {
+                if (keep[row]) out.push_back(static_cast<int32_t>(row));
+            }
+        }
+        if (!sortKeys || sortKeys->Size() < rowCount) return !Cancelled(cancel);
+
+        // Flatten the sort column once, so a comparison reads two plain
+        // arrays instead of looking up a chunk per row.
+        std::vector<double> numbers(rowCount);
+        std::vector<std::string_view> texts(rowCount);
+        const bool flattened = sortKeys->ForEachRow(
+                [&](size_t row, std::string_view text, double number) {
+                    if (row < rowCount) {
+                        numbers[row] = number;
+                        texts[row] = text;
+                    }
+                }, cancel);
+        if (!flattened) return false;
+
+        // The comparator polls the cancel flag now and then and unwinds the
+        // sort by throwing; a superseded 5M-row sort stops within
+        // milliseconds instead of running to completion.
+        size_t comparisons = 0;
+        auto less = [&numbers, &texts, cancel, &comparisons](int32_t a, int32_t b) {
+            if (++comparisons % (kCancelCheckRows * 16) == 0 && Cancelled(cancel)) {
+                throw IndexBuildCancelled();
+            }
+            return KeyLess(numbers[a], texts[a], numbers[b], texts[b]);
+        };
+        try {
+            if (ascending) {
+                std::stable_sort(out.begin(), out.end(), less);
+            } else {
+                std::stable_sort(out.begin(), out.end(),
+                                 [&less](int32_t a, int32_t b) { return less(b, a); });
+            }
+        } catch (const IndexBuildCancelled&) {
+            return false;
+        }
+        return !Cancelled(cancel);
+    }
+
+    bool BuildTableDisplayIndex(const TableIndexRequest& request, std::vector<int32_t>& out,
+                                const std::atomic<bool>* cancel) {
+        std::vector<const TableColumnKeys*> filterColumns;
+        for (const auto& column : request.filterColumns) filterColumns.push_back(column.get());
+        return BuildTableDisplayIndex(request.rowCount, request.sortKeys.get(), request.ascending,
+                                      request.filter, filterColumns, out, cancel);
+    }
+
+    // ===== TableIndexWorker =====
+
+    TableIndexWorker::~TableIndexWorker() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stop = true;
+            cancel = true;
+        }
+        cond.notify_all();
+        if (thread.joinable()) thread.join();
+    }
+
+    void TableIndexWorker::Submit(TableIndexRequest request, Callback done) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            cancel = true;              // stop the build in progress, if any
+            job = std::move(request);
+            jobDone = std::move(done);
+            pending = true;
+            busy = true;
+            if (!thread.joinable()) thread = std::thread(&TableIndexWorker::Run, this);
+        }
+        cond.notify_one();
+    }
+
+    void TableIndexWorker::Cancel() {
+        std::lock_guard<std::mutex> lock(mutex);
+        cancel = true;
+        pending = false;
+        jobDone = nullptr;
+        busy = false;
+    }
+
+    void TableIndexWorker::Run() {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            cond.wait(lock, [this] { return stop || pending; });
+            if (stop) return;
+            TableIndexRequest request = std::move(job);
+            Callback done = std::move(jobDone);
+            pending = false;
+            cancel = false;             // this is the newest request
+            lock.unlock();
+
+            auto index = std::make_shared<std::vector<int32_t>>();
+            const bool built = BuildTableDisplayIndex(request, *index, &cancel);
+            // Release the keys before reporting; the table may drop its
+            // cache copies next.
+            request = TableIndexRequest();
+            if (built && done) done(std::move(index));
+
+            lock.lock();
+            if (!pending) busy = false;
+        }
+    }
+
+    // ===== INDEX EDITS =====
+
+    bool TableIndexView::Passes(size_t sourceRow) const {
+        if (filter.empty()) return true;
+        for (const TableColumnKeys* column : filterColumns) {
+            if (column && sourceRow < column->Size() &&
+                column->Text(sourceRow).find(filter) != std::string_view::npos) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool TableIndexView::Before(int32_t a, int32_t b) const {
+        if (sortKeys) {
+            const int32_t x = ascending ? a : b;
+            const int32_t y = ascending ? b : a;
+            if (KeyLess(sortKeys->Number(x), sortKeys->Text(x), sortKeys->Number(y), sortKeys->Text(y))) {
+                return true;
+            }
+            if (KeyLess(sortKeys->Number(y), sortKeys->Text(y), sortKeys->Number(x), sortKeys->Text(x))) {
+                return false;
+            }
+        }
+        return a < b;
+    }
+
+    void TableIndexRowInserted(std::vector<int32_t>& index, int32_t sourceRow,
+                               const TableIndexView& view) {
+        for (int32_t& row : index) {
+            if (row >= sourceRow) ++row;
+        }
+        if (!view.Passes(static_cast<size_t>(sourceRow))) return;
+        auto before = [&view](int32_t a, int32_t b) { return view.Before(a, b); };
+        index.insert(std::lower_bound(index.begin(), index.end(), sourceRow, before), sourceRow);
+    }
+
+    void TableIndexRowRemoved(std::vector<int32_t>& index, int32_t sourceRow) {
+        // Drop + renumber in the same pass (no separate find / erase).
+        size_t kept = 0;
+        for (size_t i = 0; i < index.size(); ++i) {
+            const int32_t row = index[i];
+            if (row == sourceRow) continue;
+            index[kept++] = row > sourceRow ? row - 1 : row;
+        }
+        index.resize(kept);
+    }
+
+    void TableIndexRowChanged(std::vector<int32_t>& index, int32_t sourceRow,
+                              const TableIndexView& view) {
+        auto before = [&view](int32_t a, int32_t b) { return view.Before(a, b); };
+        const bool passes = view.Passes(static_cast<size_t>(sourceRow));
+        auto it = std::find(index.begin(), index.end(), sourceRow);
+        if (it == index.end()) {
+            if (passes) {
+                index.insert(std::lower_bound(index.begin(), index.end(), sourceRow, before),
+                             sourceRow);
+            }
+            return;
+        }
+        if (!passes) {
+            index.erase(it);
+            return;
+        }
+        // Both sides of the row are still in order; move it by the distance
+        // it travels rather than erasing and re-inserting.
+        auto left = std::lower_bound(index.begin(), it, sourceRow, before);
+        if (left != it) {
+            std::rotate(left, it, it + 1);
+            return;
+        }
+        auto right = std::lower_bound(it + 1, index.end(), sourceRow, before);
+        std::rotate(it, it + 1, right);
+    }
+
+}
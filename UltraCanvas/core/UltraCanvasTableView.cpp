@@ -0,0 +1,67 @@
+// core/UltraCanvasTableView.cpp
+// Legacy C-style table interface; compiles the header-only table view into the library
+// Version: 1.3.0
+// Last Modified: 2026-10-18
+// Author: UltraCanvas Framework
+
+#include "UltraCanvasTableView.h"
+
+namespace UltraCanvas {
+
+    // ===== LEGACY C-STYLE INTERFACE =====
+
+    namespace {
+        std::shared_ptr<UltraCanvasTableView> g_currentTableView;
+    }
+
+    void CreateTableView(int x, int y, int width, int height, const char** headers, int columnCount) {
+        g_currentTableView = CreateTableView("legacy_table", static_cast<float>(x), static_cast<float>(y),
+                                             static_cast<float>(width), static_cast<float>(height));
+        if (headers && columnCount > 0) {
+            for (int i = 0; i < columnCount; i++) {
+                if (headers[i]) g_currentTableView->AddColumn(headers[i]);
+            }
+        }
+    }
+
+    void CreateTableView(int x, int y, int width, int height) {
+        CreateTableView(x, y, width, height, nullptr, 0);
+    }
+
+    void AddTableRow(const char** rowData, int columnCount) {
+        if (!g_currentTableView || !rowData || columnCount <= 0) return;
+        std::vector<std::string> data;
+        for (int i = 0; i < columnCount; i++) {
+            data.push_back(rowData[i] ? rowData[i] : "");
+        }
+        g_currentTableView->AddRow(data);
+    }
+
+    void SetTableCell(int row, int col, const char* value) {
+        if (g_currentTableView && value) g_currentTableView->SetCellValue(row, col, std::string(value));
+    }
+
+    const char* GetTableCell(int row, int col) {
+        static std::string cellValue;
+        if (!g_currentTableView) return "";
+        cellValue = g_currentTableView->GetCellValue(row, col);
+        return cellValue.c_str();
+    }
+
+    void ClearTable() {
+        if (g_currentTableView) g_currentTableView->ClearRows();
+    }
+
+    int GetTableRowCount() {
+        return g_currentTableView ? g_currentTableView->GetRowCount() : 0;
+    }
+
+    int GetTableColumnCount() {
+        return g_currentTableView ? g_currentTableView->GetColumnCount() : 0;
+    }
+
+    void SortTableByColumn(int column, int ascending) {
+        if (g_currentTableView) g_currentTableView->SortByColumn(column, ascending != 0);
+    }
+
+} // namespace UltraCanvas
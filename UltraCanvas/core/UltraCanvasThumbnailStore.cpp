@@ -0,0 +1,556 @@
+// core/UltraCanvasThumbnailStore.cpp
+// Persistent on-disk thumbnail store (freedesktop.org Thumbnail Managing
+// Standard) — see the header for the layout and the validation rules.
+// Version: 1.0.0
+// Last Modified: 2026-10-18
+// Author: UltraCanvas Framework
+
+#include "UltraCanvasThumbnailStore.h"
+#include "miniz.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <sys/stat.h>
+#if defined(_WIN32) || defined(_WIN64)
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace UltraCanvas {
+namespace ThumbnailStore {
+
+    namespace {
+        std::atomic<bool> gEnabled{true};
+        std::mutex gRootMutex;
+        std::string gRootOverride;
+
+        constexpr const char* kFailDirectory = "fail/ultracanvas";
+        // A file modified this recently may still be being written (a
+        // download, a copy); a failed decode of it proves nothing yet.
+        constexpr std::time_t kFailSettleSeconds = 10;
+        constexpr uint8_t kPngSignature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+
+        // ===== MD5 (RFC 1321) =====
+        // Only used to name thumbnail files, so a compact implementation is
+        // plenty; no other part of the framework needs MD5.
+        struct Md5 {
+            uint32_t a = 0x67452301, b = 0xefcdab89, c = 0x98badcfe, d = 0x10325476;
+            uint64_t length = 0;
+            uint8_t buffer[64];
+            size_t buffered = 0;
+
+            static uint32_t Rotl(uint32_t x, int s) { return (x << s) | (x >> (32 - s)); }
+
+            void Block(const uint8_t* p) {
+                static const uint32_t K[64] = {
+                    0xd76aa478, 0xe8c7b756, 0x242070db, 0xc1bdceee, 0xf57c0faf, 0x4787c62a,
+                    0xa8304613, 0xfd469501, 0x698098d8, 0x8b44f7af, 0xffff5bb1, 0x895cd7be,
+                    0x6b901122, 0xfd987193, 0xa679438e, 0x49b40821, 0xf61e2562, 0xc040b340,
+                    0x265e5a51, 0xe9b6c7aa, 0xd62f105d, 0x02441453, 0xd8a1e681, 0xe7d3fbc8,
+                    0x21e1cde6, 0xc33707d6, 0xf4d50d87, 0x455a14ed, 0xa9e3e905, 0xfcefa3f8,
+                    0x676f02d9, 0x8d2a4c8a, 0xfffa3942, 0x8771f681, 0x6d9d6122, 0xfde5380c,
+                    0xa4beea44, 0x4bdecfa9, 0xf6bb4b60, 0xbebfbc70, 0x289b7ec6, 0xeaa127fa,
+                    0xd4ef3085, 0x04881d05, 0xd9d4d039, 0xe6db99e5, 0x1fa27cf8, 0xc4ac5665,
+                    0xf4292244, 0x432aff97, 0xab9423a7, 0xfc93a039, 0x655b59c3, 0x8f0ccc92,
+                    0xffeff47d, 0x85845dd1, 0x6fa87e4f, 0xfe2ce6e0, 0xa3014314, 0x4e0811a1,
+                    0xf7537e82, 0xbd3af235, 0x2ad7d2bb, 0xeb86d391};
+                static const int S[64] = {
+                    7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22,
+                    5, 9, 14, 20, 5, 9, 14, 20, 5, 9, 14, 20, 5, 9, 14, 20,
+                    4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23,
+                    6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21};
+                uint32_t m[16];
+                for (int i = 0; i < 16; ++i) {
+                    m[i] = uint32_t(p[i * 4]) | (uint32_t(p[i * 4 + 1]) << 8) |
+                           (uint32_t(p[i * 4 + 2]) << 16) | (uint32_t(p[i * 4 + 3]) << 24);
+                }
+                uint32_t A = a, B = b, C = c, D = d;
+                for (int i = 0; i < 64; ++i) {
+                    uint32_t f;
+                    int g;
+                    if (i < 16)      { f = (B & C) | (~B & D);  g = i; }
+                    else if (i < 32) { f = (D & B) | (~D & C);  g = (5 * i + 1) % 16; }
+                    else if (i < 48) { f = B ^ C ^ D;           g = (3 * i + 5) % 16; }
+                    else             { f = C ^ (B | ~D);        g = (7 * i) % 16; }
+                    uint32_t t = D;
+                    D = C;
+                    C = B;
+                    B = B + Rotl(A + f + K[i] + m[g], S[i]);
+                    A = t;
+                }
+                a += A; b += B; c += C; d += D;
+            }
+
+            void Update(const uint8_t* p, size_t n) {
+                length += n;
+                while (n > 0) {
+                    size_t take = std::min(n, size_t(64) - buffered);
+                    std::memcpy(buffer + buffered, p, take);
+                    buffered += take;
+                    p += take;
+                    n -= take;
+                    if (buffered == 64) {
+                        Block(buffer);
+                        buffered = 0;
+                    }
+                }
+            }
+
+            std::string HexDigest() {
+                const uint64_t bits = length * 8;
+                const uint8_t pad = 0x80;
+                Update(&pad, 1);
+                const uint8_t zero = 0;
+                while (buffered != 56) Update(&zero, 1);
+                uint8_t len[8];
+                for (int i = 0; i < 8; ++i) len[i] = uint8_t(bits >> (8 * i));
+                Update(len, 8);
+                static const char* hex = "0123456789abcdef";
+                std::string out;
+                for (uint32_t v : {a, b, c, d}) {
+                    for (int i = 0; i < 4; ++i) {
+                        uint8_t byte = uint8_t(v >> (8 * i));
+                        out += hex[byte >> 4];
+                        out += hex[byte & 15];
+                    }
+                }
+                return out;
+            }
+        };
+
+        uint32_t ReadBE32(const uint8_t* p) {
+            return (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) |
+                   (uint32_t(p[2]) << 8) | uint32_t(p[3]);
+        }
+
+        void AppendBE32(std::vector<uint8_t>& out, uint32_t v) {
+            out.push_back(uint8_t(v >> 24));
+            out.push_back(uint8_t(v >> 16));
+            out.push_back(uint8_t(v >> 8));
+            out.push_back(uint8_t(v));
+        }
+
+        bool HasPngSignature(const std::vector<uint8_t>& png) {
+            return png.size() >= 8 + 12 &&
+                   std::memcmp(png.data(), kPngSignature, 8) == 0;
+        }
+
+        // Walks the chunk stream: fn(type, data, length, chunkStart, chunkEnd)
+        // returns false to stop. False when the stream is truncated.
+        bool ForEachChunk(const std::vector<uint8_t>& png,
+                          const std::function<bool(const char*, const uint8_t*,
+                                                   uint32_t, size_t, size_t)>& fn) {
+            size_t pos = 8;
+            while (pos + 12 <= png.size()) {
+                const uint32_t len = ReadBE32(&png[pos]);
+                if (len > png.size() - pos - 12) return false;
+                const char* type = reinterpret_cast<const char*>(&png[pos + 4]);
+                const size_t end = pos + 12 + len;
+                if (!fn(type, &png[pos + 8], len, pos, end)) return true;
+                if (std::memcmp(type, "IEND", 4) == 0) return true;
+                pos = end;
+            }
+            return false;
+        }
+
+        std::vector<uint8_t> ReadWholeFile(const std::string& path) {
+            std::ifstream f(path, std::ios::binary);
+            if (!f) return {};
+            return std::vector<uint8_t>((std::istreambuf_iterator<char>(f)),
+                                        std::istreambuf_iterator<char>());
+        }
+
+        // Creates the directory (and parents) with owner-only access, as the
+        // spec asks: thumbnails can reveal the content of private files.
+        bool EnsurePrivateDirectory(const fs::path& dir) {
+            std::error_code ec;
+            if (fs::is_directory(dir, ec)) return true;
+            fs::create_directories(dir, ec);
+            if (ec) return false;
+            fs::permissions(dir, fs::perms::owner_all, fs::perm_options::replace, ec);
+            return true;
+        }
+
+        // Writes through a unique temp file in the same directory and renames
+        // it over the target, so a concurrent reader (another worker, another
+        // application) sees the old file or the new one, never a partial one.
+        // The cache directory is shared by every process of the user, so the
+        // temp name must be unique across processes, not just threads: on
+        // POSIX mkstemp picks it and creates the file 0600 from the start —
+        // the thumbnail is never readable by others, not even briefly.
+        bool WriteAtomically(const std::string& target, const std::vector<uint8_t>& data) {
+#if defined(_WIN32) || defined(_WIN64)
+            static std::atomic<uint64_t> counter{0};
+            const std::string temp = target + ".uc" + std::to_string(_getpid()) + "." +
+                    std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id())) +
+                    "." + std::to_string(counter.fetch_add(1));
+            {
+                std::ofstream f(temp, std::ios::binary | std::ios::trunc);
+                if (!f) return false;
+                f.write(reinterpret_cast<const char*>(data.data()),
+                        static_cast<std::streamsize>(data.size()));
+                if (!f) {
+                    f.close();
+                    std::remove(temp.c_str());
+                    return false;
+                }
+            }
+#else
+            std::string temp = target + ".XXXXXX";
+            const int fd = ::mkstemp(temp.data());
+            if (fd < 0) return false;
+            // mkstemp already uses 0600; say so explicitly rather than rely
+            // on the libc.
+            bool ok = ::fchmod(fd, S_IRUSR | S_IWUSR) == 0;
+            for (size_t done = 0; ok && done < data.size(); ) {
+                const ssize_t n = ::write(fd, data.data() + done, data.size() - done);
+                if (n < 0 && errno == EINTR) continue;
+                if (n <= 0) ok = false;
+                else done += static_cast<size_t>(n);
+            }
+            if (::close(fd) != 0) ok = false;
+            if (!ok) {
+                std::remove(temp.c_str());
+                return false;
+            }
+#endif
+            std::error_code ec;
+            fs::rename(temp, target, ec);
+            if (ec) {
+                std::remove(temp.c_str());
+                return false;
+            }
+            return true;
+        }
+
+        // The source file as the store sees it: absolute path, URI, stat.
+        struct SourceFile {
+            std::string uri;
+            std::string md5;
+            std::time_t mtime = 0;
+            uint64_t size = 0;
+        };
+
+        bool StatSource(const std::string& path, SourceFile& out) {
+            if (path.empty()) return false;
+            std::error_code ec;
+            fs::path abs = fs::absolute(fs::path(path), ec);
+            if (ec) return false;
+            struct stat st{};
+            if (::stat(abs.string().c_str(), &st) != 0) return false;
+            if ((st.st_mode & S_IFMT) != S_IFREG) return false;
+            out.uri = FileUri(abs.string());
+            out.md5 = Md5Hex(out.uri);
+            out.mtime = st.st_mtime;
+            out.size = static_cast<uint64_t>(st.st_size);
+            return true;
+        }
+
+        bool ParseInfo(const std::vector<uint8_t>& png, ThumbnailInfo& info) {
+            std::vector<std::pair<std::string, std::string>> text;
+            if (!ReadPngText(png, text)) return false;
+            bool haveMtime = false;
+            for (const auto& kv : text) {
+                if (kv.first == "Thumb::URI") {
+                    info.uri = kv.second;
+                } else if (kv.first == "Thumb::MTime") {
+                    info.mtime = static_cast<std::time_t>(std::strtoll(kv.second.c_str(), nullptr, 10));
+                    haveMtime = true;
+                } else if (kv.first == "Thumb::Size") {
+                    info.size = std::strtoull(kv.second.c_str(), nullptr, 10);
+                } else if (kv.first == "Thumb::Image::Width") {
+                    info.imageWidth = std::atoi(kv.second.c_str());
+                } else if (kv.first == "Thumb::Image::Height") {
+                    info.imageHeight = std::atoi(kv.second.c_str());
+                }
+            }
+            // Both keys are mandatory: without them nothing can be validated.
+            return !info.uri.empty() && haveMtime;
+        }
+
+        bool MatchesSource(const ThumbnailInfo& info, const SourceFile& src) {
+            if (info.uri != src.uri || info.mtime != src.mtime) return false;
+            return info.size == 0 || info.size == src.size;
+        }
+
+        std::vector<std::pair<std::string, std::string>> TextFor(
+                const SourceFile& src, int originalWidth, int originalHeight) {
+            std::vector<std::pair<std::string, std::string>> text = {
+                {"Thumb::URI", src.uri},
+                {"Thumb::MTime", std::to_string(static_cast<long long>(src.mtime))},
+                {"Thumb::Size", std::to_string(src.size)},
+                {"Software", "UltraCanvas"},
+            };
+            if (originalWidth > 0 && originalHeight > 0) {
+                text.emplace_back("Thumb::Image::Width", std::to_string(originalWidth));
+                text.emplace_back("Thumb::Image::Height", std::to_string(originalHeight));
+            }
+            return text;
+        }
+    }
+
+    int FlavorEdge(Flavor flavor) {
+        switch (flavor) {
+            case Flavor::Normal:  return 128;
+            case Flavor::Large:   return 256;
+            case Flavor::XLarge:  return 512;
+            case Flavor::XXLarge: return 1024;
+        }
+        return 128;
+    }
+
+    const char* FlavorDirectory(Flavor flavor) {
+        switch (flavor) {
+            case Flavor::Normal:  return "normal";
+            case Flavor::Large:   return "large";
+            case Flavor::XLarge:  return "x-large";
+            case Flavor::XXLarge: return "xx-large";
+        }
+        return "normal";
+    }
+
+    bool FlavorForEdge(int edgePx, Flavor& out) {
+        for (Flavor f : {Flavor::Normal, Flavor::Large, Flavor::XLarge, Flavor::XXLarge}) {
+            if (edgePx <= FlavorEdge(f)) {
+                out = f;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void SetEnabled(bool enabled) { gEnabled.store(enabled); }
+    bool IsEnabled() { return gEnabled.load(); }
+
+    void SetCacheRoot(const std::string& directory) {
+        std::lock_guard<std::mutex> lk(gRootMutex);
+        gRootOverride = directory;
+    }
+
+    std::string GetCacheRoot() {
+        {
+            std::lock_guard<std::mutex> lk(gRootMutex);
+            if (!gRootOverride.empty()) return gRootOverride;
+        }
+#if defined(_WIN32) || defined(_WIN64)
+        if (const char* local = std::getenv("LOCALAPPDATA"); local && *local)
+            return (fs::path(local) / "thumbnails").string();
+        return {};
+#else
+        if (const char* xdg = std::getenv("XDG_CACHE_HOME"); xdg && *xdg == '/')
+            return (fs::path(xdg) / "thumbnails").string();
+        if (const char* home = std::getenv("HOME"); home && *home)
+            return (fs::path(home) / ".cache" / "thumbnails").string();
+        return {};
+#endif
+    }
+
+    std::string FileUri(const std::string& absolutePath) {
+        std::string p = absolutePath;
+        std::replace(p.begin(), p.end(), '\\', '/');
+        // "C:/dir" -> "/C:/dir", as in file:///C:/dir
+        if (!p.empty() && p[0] != '/') p.insert(p.begin(), '/');
+        static const char* hex = "0123456789ABCDEF";
+        std::string uri = "file://";
+        for (unsigned char ch : p) {
+            // Same safe set as GLib's g_filename_to_uri, so the MD5 names
+            // match the thumbnails other desktop applications write.
+            const bool keep = (ch >= 'A' && ch <= 'Z') || (ch >= 'a' && ch <= 'z') ||
+                              (ch >= '0' && ch <= '9') ||
+                              (ch != 0 && std::strchr("-._~!$&'()*+,;=:@/", ch) != nullptr);
+            if (keep) {
+                uri += static_cast<char>(ch);
+            } else {
+                uri += '%';
+                uri += hex[ch >> 4];
+                uri += hex[ch & 15];
+            }
+        }
+        return uri;
+    }
+
+    std::string Md5Hex(const std::string& data) {
+        Md5 md5;
+        md5.Update(reinterpret_cast<const uint8_t*>(data.data()), data.size());
+        return md5.HexDigest();
+    }
+
+    std::string ThumbnailPathFor(const std::string& path, Flavor flavor) {
+        std::error_code ec;
+        fs::path abs = fs::absolute(fs::path(path), ec);
+        const std::string root = GetCacheRoot();
+        if (ec || root.empty()) return {};
+        return (fs::path(root) / FlavorDirectory(flavor) /
+                (Md5Hex(FileUri(abs.string())) + ".png")).string();
+    }
+
+    bool Lookup(const std::string& path, int edgePx,
+                std::vector<uint8_t>& pngOut, ThumbnailInfo* infoOut) {
+        if (!IsEnabled()) return false;
+        Flavor first;
+        if (!FlavorForEdge(std::max(1, edgePx), first)) return false;
+        const std::string root = GetCacheRoot();
+        SourceFile src;
+        if (root.empty() || !StatSource(path, src)) return false;
+        // Never thumbnail the thumbnails themselves.
+        if (src.uri.rfind(FileUri(root) + "/", 0) == 0) return false;
+
+        for (int f = static_cast<int>(first); f <= static_cast<int>(Flavor::XXLarge); ++f) {
+            const Flavor flavor = static_cast<Flavor>(f);
+            std::vector<uint8_t> png = ReadWholeFile(
+                    (fs::path(root) / FlavorDirectory(flavor) / (src.md5 + ".png")).string());
+            if (png.empty()) continue;
+            ThumbnailInfo info;
+            int w = 0, h = 0;
+            if (!ParseInfo(png, info) || !MatchesSource(info, src) ||
+                !ReadPngSize(png, w, h)) {
+                continue;   // stale or foreign: the producer overwrites it
+            }
+            // Sharp enough: it covers the edge, or it is the whole original.
+            const bool covers = std::max(w, h) >= edgePx;
+            const bool wholeOriginal = info.imageWidth > 0 && info.imageHeight > 0 &&
+                                       info.imageWidth <= w && info.imageHeight <= h;
+            if (!covers && !wholeOriginal) continue;
+            pngOut = std::move(png);
+            if (infoOut) *infoOut = info;
+            return true;
+        }
+        return false;
+    }
+
+    bool Store(const std::string& path, Flavor flavor,
+               const std::vector<uint8_t>& png,
+               int originalWidth, int originalHeight) {
+        if (!IsEnabled() || !HasPngSignature(png)) return false;
+        const std::string root = GetCacheRoot();
+        SourceFile src;
+        if (root.empty() || !StatSource(path, src)) return false;
+        if (src.uri.rfind(FileUri(root) + "/", 0) == 0) return false;
+
+        std::vector<uint8_t> stamped = WithPngText(png, TextFor(src, originalWidth, originalHeight));
+        if (stamped.empty()) return false;
+        const fs::path dir = fs::path(root) / FlavorDirectory(flavor);
+        if (!EnsurePrivateDirectory(dir)) return false;
+        return WriteAtomically((dir / (src.md5 + ".png")).string(), stamped);
+    }
+
+    void MarkFailed(const std::string& path) {
+        if (!IsEnabled()) return;
+        const std::string root = GetCacheRoot();
+        SourceFile src;
+        if (root.empty() || !StatSource(path, src)) return;
+        if (std::time(nullptr) - src.mtime < kFailSettleSeconds) return;
+        // The spec's failure marker is a PNG like any other thumbnail; a 1x1
+        // transparent pixel carries the keys.
+        const uint8_t pixel[4] = {0, 0, 0, 0};
+        size_t len = 0;
+        void* raw = tdefl_write_image_to_png_file_in_memory(pixel, 1, 1, 4, &len);
+        if (!raw) return;
+        std::vector<uint8_t> png(static_cast<uint8_t*>(raw), static_cast<uint8_t*>(raw) + len);
+        mz_free(raw);
+        std::vector<uint8_t> stamped = WithPngText(png, TextFor(src, 0, 0));
+        const fs::path dir = fs::path(root) / kFailDirectory;
+        if (stamped.empty() || !EnsurePrivateDirectory(dir)) return;
+        WriteAtomically((dir / (src.md5 + ".png")).string(), stamped);
+    }
+
+    bool HasFailed(const std::string& path) {
+        if (!IsEnabled()) return false;
+        const std::string root = GetCacheRoot();
+        SourceFile src;
+        if (root.empty() || !StatSource(path, src)) return false;
+        std::vector<uint8_t> png = ReadWholeFile(
+                (fs::path(root) / kFailDirectory / (src.md5 + ".png")).string());
+        ThumbnailInfo info;
+        return !png.empty() && ParseInfo(png, info) && MatchesSource(info, src);
+    }
+
+    void Remove(const std::string& path) {
+        const std::string root = GetCacheRoot();
+        std::error_code ec;
+        fs::path abs = fs::absolute(fs::path(path), ec);
+        if (root.empty() || ec) return;
+        const std::string name = Md5Hex(FileUri(abs.string())) + ".png";
+        for (Flavor f : {Flavor::Normal, Flavor::Large, Flavor::XLarge, Flavor::XXLarge})
+            fs::remove(fs::path(root) / FlavorDirectory(f) / name, ec);
+        fs::remove(fs::path(root) / kFailDirectory / name, ec);
+    }
+
+    bool ReadPngText(const std::vector<uint8_t>& png,
+                     std::vector<std::pair<std::string, std::string>>& out) {
+        if (!HasPngSignature(png)) return false;
+        return ForEachChunk(png, [&out](const char* type, const uint8_t* data,
+                                        uint32_t len, size_t, size_t) {
+            if (std::memcmp(type, "tEXt", 4) == 0) {
+                const uint8_t* sep = static_cast<const uint8_t*>(std::memchr(data, 0, len));
+                if (sep) {
+                    out.emplace_back(
+                            std::string(reinterpret_cast<const char*>(data), sep - data),
+                            std::string(reinterpret_cast<const char*>(sep + 1),
+                                        data + len - sep - 1));
+                }
+            }
+            // tEXt may follow the image data; stop only at IEND.
+            return true;
+        });
+    }
+
+    std::vector<uint8_t> WithPngText(
+            const std::vector<uint8_t>& png,
+            const std::vector<std::pair<std::string, std::string>>& text) {
+        if (!HasPngSignature(png)) return {};
+        std::vector<uint8_t> out(png.begin(), png.begin() + 8);
+        out.reserve(png.size() + 256);
+        bool wroteText = false;
+        const bool complete = ForEachChunk(png, [&](const char* type, const uint8_t* data,
+                                                    uint32_t len, size_t start, size_t end) {
+            if (std::memcmp(type, "tEXt", 4) == 0) {
+                const uint8_t* sep = static_cast<const uint8_t*>(std::memchr(data, 0, len));
+                const std::string key = sep ? std::string(reinterpret_cast<const char*>(data),
+                                                          sep - data)
+                                            : std::string();
+                for (const auto& kv : text)
+                    if (kv.first == key) return true;   // replaced below
+            }
+            out.insert(out.end(), png.begin() + start, png.begin() + end);
+            if (!wroteText && std::memcmp(type, "IHDR", 4) == 0) {
+                for (const auto& kv : text) {
+                    std::vector<uint8_t> chunk = {'t', 'E', 'X', 't'};
+                    chunk.insert(chunk.end(), kv.first.begin(), kv.first.end());
+                    chunk.push_back(0);
+                    chunk.insert(chunk.end(), kv.second.begin(), kv.second.end());
+                    AppendBE32(out, static_cast<uint32_t>(chunk.size() - 4));
+                    out.insert(out.end(), chunk.begin(), chunk.end());
+                    AppendBE32(out, static_cast<uint32_t>(
+                            mz_crc32(MZ_CRC32_INIT, chunk.data(), chunk.size())));
+                }
+                wroteText = true;
+            }
+            return true;
+        });
+        if (!complete || !wroteText) return {};
+        return out;
+    }
+
+    bool ReadPngSize(const std::vector<uint8_t>& png, int& width, int& height) {
+        // IHDR is always the first chunk: length(4) "IHDR" width height ...
+        if (!HasPngSignature(png) || std::memcmp(&png[12], "IHDR", 4) != 0) return false;
+        width = static_cast<int>(ReadBE32(&png[16]));
+        height = static_cast<int>(ReadBE32(&png[20]));
+        return width > 0 && height > 0;
+    }
+
+} // namespace ThumbnailStore
+} // namespace UltraCanvas
@@ -0,0 +1,415 @@
+// core/UltraCanvasTiledImage.cpp
+// Tiled resolution pyramid for very large raster images — see the header
+// for the build / read / cache stages.
+// Version: 1.0.0
+// Last Modified: 2026-10-18
+// Author: UltraCanvas Framework
+
+#include "UltraCanvasTiledImage.h"
+#include "UltraCanvasApplication.h"
+#include "UltraCanvasDebug.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+
+namespace UltraCanvas {
+
+    UCTiledImagePyramid::UCTiledImagePyramid(const std::string& path,
+                                             std::function<void()> changed)
+        : sourcePath(path), onChanged(std::move(changed)) {
+        builder = std::thread([this]() { BuildMain(); });
+    }
+
+    UCTiledImagePyramid::~UCTiledImagePyramid() {
+        alive->store(false);
+        cancelBuild.store(true);
+        std::vector<std::thread> joining;
+        {
+            std::lock_guard<std::mutex> lk(mutex);
+            stopping = true;
+            joining.swap(workers);
+        }
+        cond.notify_all();
+        if (builder.joinable()) builder.join();
+        for (auto& t : joining) {
+            if (t.joinable()) t.join();
+        }
+        if (!pyramidPath.empty()) {
+            std::error_code ec;
+            std::filesystem::remove(pyramidPath, ec);
+        }
+    }
+
+    uint64_t UCTiledImagePyramid::PackKey(const TileKey& key) {
+        return (static_cast<uint64_t>(key.level & 0xFFFF) << 48) |
+               (static_cast<uint64_t>(key.row & 0xFFFFFF) << 24) |
+               static_cast<uint64_t>(key.col & 0xFFFFFF);
+    }
+
+    UCTiledImagePyramid::TileKey UCTiledImagePyramid::UnpackKey(uint64_t packed) {
+        TileKey key;
+        key.level = static_cast<int>(packed >> 48);
+        key.row = static_cast<int>((packed >> 24) & 0xFFFFFF);
+        key.col = static_cast<int>(packed & 0xFFFFFF);
+        return key;
+    }
+
+    UCTiledImagePyramid::PyramidState UCTiledImagePyramid::GetState() const {
+        std::lock_guard<std::mutex> lk(mutex);
+        return state;
+    }
+
+    int UCTiledImagePyramid::GetLevelCount() const {
+        std::lock_guard<std::mutex> lk(mutex);
+        return state == PyramidState::Ready ? static_cast<int>(levelSizes.size()) : 0;
+    }
+
+    bool UCTiledImagePyramid::GetLevelSize(int level, int& w, int& h) const {
+        std::lock_guard<std::mutex> lk(mutex);
+        if (state != PyramidState::Ready || level < 0 ||
+            level >= static_cast<int>(levelSizes.size())) {
+            return false;
+        }
+        w = levelSizes[level].first;
+        h = levelSizes[level].second;
+        return true;
+    }
+
+    bool UCTiledImagePyramid::GetTileGrid(int level, int& cols, int& rows) const {
+        int w = 0, h = 0;
+        if (!GetLevelSize(level, w, h)) return false;
+        cols = (w + kTileSize - 1) / kTileSize;
+        rows = (h + kTileSize - 1) / kTileSize;
+        return true;
+    }
+
+    int UCTiledImagePyramid::ChooseLevel(double scale) const {
+        std::lock_guard<std::mutex> lk(mutex);
+        if (state != PyramidState::Ready || levelSizes.empty()) return 0;
+        const double fullW = std::max(1, levelSizes[0].first);
+        // Coarsest first; a hair of tolerance keeps an exact 1:2 view on the
+        // half-size level instead of reading four times the pixels.
+        for (int level = static_cast<int>(levelSizes.size()) - 1; level > 0; --level) {
+            if (levelSizes[level].first / fullW >= scale * 0.999) return level;
+        }
+        return 0;
+    }
+
+    std::shared_ptr<UCPixmap> UCTiledImagePyramid::GetTile(const TileKey& key) {
+        std::lock_guard<std::mutex> lk(mutex);
+        auto it = tiles.find(PackKey(key));
+        if (it == tiles.end()) {
+            ++stats.misses;
+            return nullptr;
+        }
+        ++stats.hits;
+        lru.splice(lru.begin(), lru, it->second.lruPos);
+        return it->second.pixmap;
+    }
+
+    void UCTiledImagePyramid::SetWanted(const std::vector<TileKey>& keys) {
+        std::lock_guard<std::mutex> lk(mutex);
+        wanted.clear();
+        std::deque<uint64_t> next;
+        std::unordered_set<uint64_t> nextSet;
+        for (const TileKey& key : keys) {
+            const uint64_t packed = PackKey(key);
+            wanted.insert(packed);
+            if (tiles.count(packed) || inFlight.count(packed) || nextSet.count(packed)) continue;
+            next.push_back(packed);
+            nextSet.insert(packed);
+        }
+        for (uint64_t packed : pending) {
+            if (!nextSet.count(packed)) ++stats.dropped;
+        }
+        pending.swap(next);
+        pendingSet.swap(nextSet);
+        if (!pending.empty()) cond.notify_all();
+    }
+
+    void UCTiledImagePyramid::SetCacheBudget(size_t bytes) {
+        std::lock_guard<std::mutex> lk(mutex);
+        cacheBudget = std::max<size_t>(bytes, static_cast<size_t>(kTileSize) * kTileSize * 4);
+        EvictToBudgetLocked();
+    }
+
+    size_t UCTiledImagePyramid::GetCacheBudget() const {
+        std::lock_guard<std::mutex> lk(mutex);
+        return cacheBudget;
+    }
+
+    void UCTiledImagePyramid::SetWorkerCount(int count) {
+        std::lock_guard<std::mutex> lk(mutex);
+        workerCount = std::max(0, count);
+    }
+
+    UCTiledImagePyramid::Stats UCTiledImagePyramid::GetStats() const {
+        std::lock_guard<std::mutex> lk(mutex);
+        Stats s = stats;
+        s.cachedTiles = tiles.size();
+        s.cachedBytes = cacheBytes;
+        s.queued = pending.size();
+        s.buildPercent = state == PyramidState::Ready ? 100 : buildPercent.load();
+        return s;
+    }
+
+    void UCTiledImagePyramid::EvictToBudgetLocked() {
+        // Least recently used first, sparing tiles the current frame still
+        // wants while anything else can go.
+        auto evict = [this](std::list<uint64_t>::iterator pos) {
+            auto it = tiles.find(*pos);
+            cacheBytes -= it->second.bytes;
+            tiles.erase(it);
+            ++stats.evicted;
+            return lru.erase(pos);
+        };
+        for (auto pos = lru.end(); cacheBytes > cacheBudget && pos != lru.begin();) {
+            --pos;
+            if (!wanted.count(*pos)) pos = evict(pos);
+        }
+        while (cacheBytes > cacheBudget && !lru.empty()) {
+            evict(std::prev(lru.end()));
+        }
+    }
+
+    void UCTiledImagePyramid::NotifyChanged() {
+        if (!onChanged) return;
+        UltraCanvasApplicationBase* app = UltraCanvasApplicationBase::GetCurrent();
+        if (!app) {
+            onChanged();
+            return;
+        }
+        if (changePosted->exchange(true)) return;
+        app->PostToUIThread([this, aliveFlag = alive, posted = changePosted]() {
+            posted->store(false);
+            if (aliveFlag->load() && onChanged) onChanged();
+        });
+    }
+
+    void UCTiledImagePyramid::StartWorkersLocked() {
+        int count = workerCount;
+        if (count <= 0) {
+            const int hw = static_cast<int>(std::thread::hardware_concurrency());
+            count = std::clamp(hw / 2, 1, 4);
+        }
+        while (static_cast<int>(workers.size()) < count) {
+            workers.emplace_back([this]() { WorkerMain(); });
+        }
+    }
+
+#ifdef HAS_LIBVIPS
+    void UCTiledImagePyramid::OnBuildEval(void* image, void* progress, void* self) {
+        auto* pyramid = static_cast<UCTiledImagePyramid*>(self);
+        pyramid->buildPercent.store(static_cast<VipsProgress*>(progress)->percent);
+        if (pyramid->cancelBuild.load()) {
+            vips_image_set_kill(static_cast<VipsImage*>(image), TRUE);
+        }
+    }
+
+    void UCTiledImagePyramid::BuildMain() {
+        static std::atomic<unsigned> serial{0};
+        const auto stamp = std::chrono::steady_clock::now().time_since_epoch().count();
+        std::error_code ec;
+        const std::string path = (std::filesystem::temp_directory_path(ec) /
+                ("ultracanvas-pyramid-" + std::to_string(stamp) + "-" +
+                 std::to_string(serial.fetch_add(1)) + ".tif")).string();
+
+        std::vector<std::pair<int, int>> sizes;
+        bool ok = false;
+        try {
+            vips::VImage src = vips::VImage::new_from_file(
+                    sourcePath.c_str(),
+                    vips::VImage::option()->set("access", VIPS_ACCESS_SEQUENTIAL));
+            // 8-bit sRGB + alpha, so tiles copy straight into ARGB32 pixmaps.
+            if (src.interpretation() != VIPS_INTERPRETATION_sRGB) {
+                src = src.colourspace(VIPS_INTERPRETATION_sRGB);
+            }
+            src = src.cast(VIPS_FORMAT_UCHAR);
+            if (src.bands() == 3) {
+                src = src.bandjoin(255);
+            } else if (src.bands() > 4) {
+                src = src.extract_band(0, vips::VImage::option()->set("n", 4));
+            }
+
+            {
+                std::lock_guard<std::mutex> lk(mutex);
+                pyramidPath = path;     // from here on the destructor removes it
+            }
+            // Progress + cancellation. The handler is disconnected again right
+            // after the save: libvips may hand the same image to later users
+            // through its operation cache.
+            vips_image_set_progress(src.get_image(), TRUE);
+            const gulong evalHandler = g_signal_connect(
+                    src.get_image(), "eval",
+                    G_CALLBACK(&UCTiledImagePyramid::OnBuildEval), this);
+            try {
+                src.tiffsave(path.c_str(), vips::VImage::option()
+                        ->set("tile", true)
+                        ->set("tile_width", kTileSize)
+                        ->set("tile_height", kTileSize)
+                        ->set("pyramid", true)
+                        ->set("bigtiff", true)
+                        ->set("compression", VIPS_FOREIGN_TIFF_COMPRESSION_DEFLATE));
+            } catch (...) {
+                g_signal_handler_disconnect(src.get_image(), evalHandler);
+                throw;
+            }
+            g_signal_handler_disconnect(src.get_image(), evalHandler);
+
+            if (!cancelBuild.load()) {
+                vips::VImage first = vips::VImage::new_from_file(path.c_str());
+                int pages = 1;
+                if (vips_image_get_typeof(first.get_image(), "n-pages")) {
+                    pages = std::max(1, first.get_int("n-pages"));
+                }
+                sizes.emplace_back(first.width(), first.height());
+                for (int page = 1; page < pages; ++page) {
+                    vips::VImage level = vips::VImage::new_from_file(
+                            path.c_str(), vips::VImage::option()->set("page", page));
+                    sizes.emplace_back(level.width(), level.height());
+                }
+                ok = true;
+            }
+        } catch (vips::VError& err) {
+            if (!cancelBuild.load()) {
+                debugOutput << "UCTiledImagePyramid: cannot build the pyramid for "
+                            << sourcePath << " Err:" << err.what() << std::endl;
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lk(mutex);
+            if (stopping) return;
+            if (ok) {
+                levelSizes = std::move(sizes);
+                state = PyramidState::Ready;
+                StartWorkersLocked();
+            } else {
+                state = PyramidState::Failed;
+            }
+        }
+        cond.notify_all();
+        NotifyChanged();
+    }
+
+    void UCTiledImagePyramid::WorkerMain() {
+        // One region per level and thread: a region is bound to the thread
+        // that made it, and keeping it keeps the loader's tile cache warm.
+        struct LevelReader {
+            vips::VImage image;
+            VipsRegion* region = nullptr;
+        };
+        std::vector<LevelReader> readers;
+        std::string path;
+        std::vector<std::pair<int, int>> sizes;
+        {
+            std::lock_guard<std::mutex> lk(mutex);
+            path = pyramidPath;
+            sizes = levelSizes;
+        }
+        readers.resize(sizes.size());
+
+        for (;;) {
+            uint64_t packed = 0;
+            {
+                std::unique_lock<std::mutex> lk(mutex);
+                cond.wait(lk, [this]() { return stopping || !pending.empty(); });
+                if (stopping) break;
+                packed = pending.front();
+                pending.pop_front();
+                pendingSet.erase(packed);
+                inFlight.insert(packed);
+            }
+
+            const TileKey key = UnpackKey(packed);
+            std::shared_ptr<UCPixmap> pixmap;
+            if (key.level >= 0 && key.level < static_cast<int>(sizes.size())) {
+                const int levelW = sizes[key.level].first;
+                const int levelH = sizes[key.level].second;
+                VipsRect rect;
+                rect.left = key.col * kTileSize;
+                rect.top = key.row * kTileSize;
+                rect.width = std::min(kTileSize, levelW - rect.left);
+                rect.height = std::min(kTileSize, levelH - rect.top);
+                try {
+                    LevelReader& reader = readers[key.level];
+                    if (!reader.region) {
+                        reader.image = vips::VImage::new_from_file(
+                                path.c_str(), vips::VImage::option()
+                                        ->set("page", key.level)
+                                        ->set("access", VIPS_ACCESS_RANDOM));
+                        reader.region = vips_region_new(reader.image.get_image());
+                    }
+                    if (rect.width > 0 && rect.height > 0 && reader.region &&
+                        vips_region_prepare(reader.region, &rect) == 0) {
+                        pixmap = std::make_shared<UCPixmap>(rect.width, rect.height);
+                        uint32_t* dst = pixmap->GetPixelData();
+                        if (dst) {
+                            // RGBA -> premultiplied native ARGB32.
+                            for (int y = 0; y < rect.height; ++y) {
+                                const VipsPel* p = VIPS_REGION_ADDR(reader.region, rect.left,
+                                                                    rect.top + y);
+                                uint32_t* row = dst + static_cast<size_t>(y) * rect.width;
+                                for (int x = 0; x < rect.width; ++x, p += 4) {
+                                    const uint32_t a = p[3];
+                                    uint32_t r = p[0], g = p[1], b = p[2];
+                                    if (a != 255) {
+                                        r = (r * a + 127) / 255;
+                                        g = (g * a + 127) / 255;
+                                        b = (b * a + 127) / 255;
+                                    }
+                                    row[x] = (a << 24) | (r << 16) | (g << 8) | b;
+                                }
+                            }
+                            pixmap->MarkDirty();
+                        } else {
+                            pixmap.reset();
+                        }
+                    }
+                } catch (vips::VError& err) {
+                    debugOutput << "UCTiledImagePyramid: tile " << key.level << "/" << key.col
+                                << "/" << key.row << " of " << sourcePath
+                                << " failed Err:" << err.what() << std::endl;
+                }
+            }
+
+            bool notify = false;
+            {
+                std::lock_guard<std::mutex> lk(mutex);
+                inFlight.erase(packed);
+                if (pixmap) {
+                    ++stats.generated;
+                    CacheEntry entry;
+                    entry.pixmap = pixmap;
+                    entry.bytes = static_cast<size_t>(pixmap->GetWidth()) * pixmap->GetHeight() * 4;
+                    lru.push_front(packed);
+                    entry.lruPos = lru.begin();
+                    cacheBytes += entry.bytes;
+                    tiles[packed] = std::move(entry);
+                    EvictToBudgetLocked();
+                    notify = wanted.count(packed) > 0;
+                }
+            }
+            if (notify) NotifyChanged();
+        }
+
+        for (LevelReader& reader : readers) {
+            if (reader.region) g_object_unref(reader.region);
+        }
+    }
+#else
+    void UCTiledImagePyramid::OnBuildEval(void*, void*, void*) {}
+
+    void UCTiledImagePyramid::BuildMain() {
+        {
+            std::lock_guard<std::mutex> lk(mutex);
+            state = PyramidState::Failed;
+        }
+        NotifyChanged();
+    }
+
+    void UCTiledImagePyramid::WorkerMain() {}
+#endif
+
+}
@@ -0,0 +1,132 @@
+// core/UltraCanvasTimer.cpp
+// Deadline-ordered timer queue behind UltraCanvasApplicationBase's timers
+// Version: 1.1.0
+// Last Modified: 2026-10-18
+// Author: UltraCanvas Framework
+
+#include "UltraCanvasTimer.h"
+
+namespace UltraCanvas {
+
+    void UltraCanvasTimerQueue::Add(UltraCanvasTimer timer) {
+        Remove(timer.id);
+        timer.active = true;
+        // A zero period would re-arm at the same instant forever.
+        if (timer.periodic && timer.interval.count() <= 0) {
+            timer.interval = std::chrono::milliseconds(1);
+        }
+
+        uint32_t slot;
+        if (!freeSlots.empty()) {
+            slot = freeSlots.back();
+            freeSlots.pop_back();
+            slots[slot] = std::move(timer);
+        } else {
+            slot = static_cast<uint32_t>(slots.size());
+            slots.push_back(std::move(timer));
+            heapPos.push_back(0);
+        }
+        slotOfId[slots[slot].id] = slot;
+        heap.push_back(slot);
+        heapPos[slot] = static_cast<uint32_t>(heap.size() - 1);
+        SiftUp(heap.size() - 1);
+    }
+
+    bool UltraCanvasTimerQueue::Remove(TimerId id) {
+        auto it = slotOfId.find(id);
+        if (it == slotOfId.end()) return false;
+        const uint32_t slot = it->second;
+        slotOfId.erase(it);
+        RemoveAt(heapPos[slot]);
+        slots[slot] = UltraCanvasTimer();       // drop the callback's captures now
+        freeSlots.push_back(slot);
+        return true;
+    }
+
+    void UltraCanvasTimerQueue::Clear() {
+        slots.clear();
+        heapPos.clear();
+        freeSlots.clear();
+        heap.clear();
+        slotOfId.clear();
+    }
+
+    UltraCanvasTimerQueue::Clock::time_point UltraCanvasTimerQueue::NextDeadline() const {
+        return heap.empty() ? Clock::time_point::max() : slots[heap.front()].nextFire;
+    }
+
+    void UltraCanvasTimerQueue::CollectDue(Clock::time_point now, DueList& due) {
+        const Clock::time_point horizon = now + coalescingSlack;
+        while (!heap.empty()) {
+            const uint32_t slot = heap.front();
+            UltraCanvasTimer& timer = slots[slot];
+            if (timer.nextFire > horizon) break;
+
+            if (!timer.periodic) {
+                due.emplace_back(timer.id, std::move(timer.callback));
+                Remove(timer.id);
+                continue;
+            }
+
+            due.emplace_back(timer.id, timer.callback);
+            timer.nextFire += timer.interval;
+            // If we fell behind, skip to the next future fire time.
+            if (timer.nextFire <= horizon) {
+                auto periods = (horizon - timer.nextFire) / timer.interval + 1;
+                timer.nextFire += timer.interval * periods;
+            }
+            SiftDown(0);
+        }
+    }
+
+    bool UltraCanvasTimerQueue::Earlier(uint32_t slotA, uint32_t slotB) const {
+        const UltraCanvasTimer& a = slots[slotA];
+        const UltraCanvasTimer& b = slots[slotB];
+        if (a.nextFire != b.nextFire) return a.nextFire < b.nextFire;
+        return a.id < b.id;
+    }
+
+    void UltraCanvasTimerQueue::Place(size_t pos, uint32_t slot) {
+        heap[pos] = slot;
+        heapPos[slot] = static_cast<uint32_t>(pos);
+    }
+
+    void UltraCanvasTimerQueue::SiftUp(size_t pos) {
+        const uint32_t slot = heap[pos];
+        while (pos > 0) {
+            const size_t parent = (pos - 1) / 2;
+            if (!Earlier(slot, heap[parent])) break;
+            Place(pos, heap[parent]);
+            pos = parent;
+        }
+        Place(pos, slot);
+    }
+
+    void UltraCanvasTimerQueue::SiftDown(size_t pos) {
+        const size_t count = heap.size();
+        const uint32_t slot = heap[pos];
+        while (true) {
+            size_t child = pos * 2 + 1;
+            if (child >= count) break;
+            if (child + 1 < count && Earlier(heap[child + 1], heap[child])) child++;
+            if (!Earlier(heap[child], slot)) break;
+            Place(pos, heap[child]);
+            pos = child;
+        }
+        Place(pos, slot);
+    }
+
+    void UltraCanvasTimerQueue::RemoveAt(size_t pos) {
+        const uint32_t last = heap.back();
+        heap.pop_back();
+        if (pos == heap.size()) return;
+        Place(pos, last);
+        // The moved element may belong above or below its new position.
+        if (pos > 0 && Earlier(last, heap[(pos - 1) / 2])) {
+            SiftUp(pos);
+        } else {
+            SiftDown(pos);
+        }
+    }
+
+} // namespace UltraCanvas
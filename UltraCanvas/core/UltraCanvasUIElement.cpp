@@ -1,21 +1,26 @@
 // UltraCanvasUIElement.cpp
 // UI base class implementation; geometry and box model live on
 // UltraCanvas::CSSLayout::Element (the new base).
-// Version: 4.1.2 - MapFromLocal/MapToLocal: with an explicit target parent, stop
-//                 the ancestor walk BEFORE folding in the target's own placement
-//                 offset (it was added one level too many). nullptr/window-frame
-//                 callers are byte-for-byte unchanged.
-// Last Modified: 2026-07-14
+// Version: 4.3.0 - Arrange opens a frame profiler scope.
+// Version: 4.2.0 - Opt-in retained layers: RenderWithLayer composites the
+//                 cached subtree, InvalidateRect dirties layered ancestors.
+// Last Modified: 2026-10-18
 // Author: UltraCanvas Framework
 #include "UltraCanvasUIElement.h"
 #include "UltraCanvasContainer.h"
 #include "UltraCanvasApplication.h"
 #include "UltraCanvasWindow.h"
+#include "UltraCanvasFrameProfiler.h"
+#include "UltraCanvasLayerCache.h"
 #include "UltraCanvasDebug.h"
+#include <cmath>
 
 namespace UltraCanvas {
 
     UltraCanvasUIElement::~UltraCanvasUIElement() {
+        if (layerCaching) {
+            UltraCanvasLayerCache::GetInstance().Release(this);
+        }
         // delete childs first
         if (!children.empty()) {
             children.clear();
@@ -94,6 +99,17 @@ namespace UltraCanvas {
 
         Point2Df posInWindow = GetPositionInWindow();
 
+        // Layered ancestors (and this element) must re-rasterize the area
+        // before their layer is composited again.
+        for (UltraCanvasUIElement* cur = this; cur && cur != window; cur = cur->GetParentContainer()) {
+            if (!cur->layerCaching) continue;
+            Point2Df layerPos = cur == this ? posInWindow : cur->GetPositionInWindow();
+            UltraCanvasLayerCache::GetInstance().Invalidate(
+                    cur, Rect2Df(localRect.x + posInWindow.x - layerPos.x,
+                                 localRect.y + posInWindow.y - layerPos.y,
+                                 localRect.width, localRect.height));
+        }
+
         if (popupAncestor) {
             Point2Df popupPosInWindow = popupAncestor->GetPositionInWindow();
             Rect2Df rectInPopup(localRect.x + posInWindow.x - popupPosInWindow.x,
@@ -196,6 +212,56 @@ namespace UltraCanvas {
         }
     }
 
+    void UltraCanvasUIElement::SetLayerCaching(bool enable) {
+        if (layerCaching == enable) return;
+        layerCaching = enable;
+        if (!enable) {
+            UltraCanvasLayerCache::GetInstance().Release(this);
+        }
+        RequestRedraw();
+    }
+
+    void UltraCanvasUIElement::RenderWithLayer(IRenderContext* ctx, const Rect2Df& dirtyRect) {
+        if (!layerCaching || !ctx) {
+            Render(ctx, dirtyRect);
+            return;
+        }
+
+        auto& cache = UltraCanvasLayerCache::GetInstance();
+        Size2Di size(static_cast<int>(std::ceil(GetWidth())), static_cast<int>(std::ceil(GetHeight())));
+        UltraCanvasLayerCache::Layer* layer = cache.Acquire(this, size, ctx);
+        if (!layer) {
+            Render(ctx, dirtyRect);
+            return;
+        }
+
+        if (layer->dirty.width > 0 && layer->dirty.height > 0) {
+            // Take the dirty area first: Render may invalidate again, which
+            // must land in the next pass rather than be cleared with this one.
+            const Rect2Df dirty = layer->dirty;
+            const bool full = dirty.width >= size.width && dirty.height >= size.height;
+            layer->dirty = Rect2Df();
+            layer->rasterizing = true;
+            IRenderContext* layerCtx = layer->context.get();
+            layerCtx->PushState();
+            layerCtx->ClipRect(Rect2Dd(dirty.x, dirty.y, dirty.width, dirty.height));
+            layerCtx->Clear(Colors::Transparent);
+            Render(layerCtx, dirty);
+            layerCtx->PopState();
+            layer->rasterizing = false;
+            cache.CountRaster(full);
+        }
+
+        if (ctx->DrawContextSurface(*layer->context, {0, 0})) {
+            cache.CountComposite();
+        } else {
+            // Backend can't composite this layer; stop trying.
+            cache.Release(this);
+            layerCaching = false;
+            Render(ctx, dirtyRect);
+        }
+    }
+
     Point2Df UltraCanvasUIElement::GetPositionInWindow() const {
         Point2Df pos;
         if (auto* parentCont = GetParentContainer()) {
@@ -329,6 +395,7 @@ namespace UltraCanvas {
     }
 
     void UltraCanvasUIElement::Arrange(const Rect2Df& newFinalRect, const CSSLayout::LayoutContext& ctx) {
+        UCProfileScope profileScope(ProfileKind::Arrange, this, &GetIdentifier());
         Rect2Df oldBounds = finalBounds;
         CSSLayout::Element::Arrange(newFinalRect, ctx);
 
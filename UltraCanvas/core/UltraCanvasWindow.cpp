@@ -1,7 +1,7 @@
 // UltraCanvasWindowBase.cpp
 // Fixed implementation of cross-platform window management system
-// Version: 1.3.3 - PerformClose() closes transient child windows so no orphaned modal survives its parent
-// Last Modified: 2026-07-21
+// Version: 1.5.0 - frame profiler hooks and overlay
+// Last Modified: 2026-10-18
 // Author: UltraCanvas Framework
 
 #include "UltraCanvasWindow.h"
@@ -9,6 +9,7 @@
 #include "UltraCanvasApplication.h"
 #include "UltraCanvasTooltipManager.h"
 #include "UltraCanvasCaret.h"
+#include "UltraCanvasFrameProfiler.h"
 
 #include <cairo/cairo.h>
 #include <iostream>
@@ -380,7 +381,8 @@ namespace UltraCanvas {
         // Rebuild the window render context from the NEW nativeSurface so it
         // inherits the new device scale. We cannot use renderContext->ResizeSurface()
         // here: it recreates similar to the context's OWN (old-scale) surface.
-        renderContext = CreateRenderContext(Size2Di(config_.width, config_.height), nativeSurface);
+        renderContext = CreateRenderContext(Size2Di(config_.width, config_.height), nativeSurface, tiledRasterization);
+        profilerOverlayContext.reset();
 
         // Drop popup contexts so the UpdateAndRender() popup loop lazily rebuilds
         // them against the new nativeSurface; re-seed their dirty rects.
@@ -435,6 +437,22 @@ namespace UltraCanvas {
     }
 
 
+    bool UltraCanvasWindowBase::NeedsRender() const {
+        if (!_created || !_windowVisible) return false;
+        if (_needsResize || _needsWindowComposition || _needsCaretComposition || _needsPopupGeometry) {
+            return true;
+        }
+        if (!IsLayoutValid() || dirtyRectManager.HasDirtyRects()) return true;
+        for (const auto& pe : popupElements) {
+            auto* p = pe.element;
+            if (!p || !p->IsVisible()) continue;
+            if (pe.dirtyRectManager.HasDirtyRects()) return true;
+            // First show or resize: UpdateAndRender() (re)creates its surface
+            if (!p->renderContext || p->renderContext->GetSurfaceSize() != p->GetSize()) return true;
+        }
+        return false;
+    }
+
     void UltraCanvasWindowBase::UpdateAndRender() {
         if (!_created || !_windowVisible) return;
         auto ctx = GetRenderContext();
@@ -442,6 +460,7 @@ namespace UltraCanvas {
             DoResize();
         }
         if (!ctx) return;
+        UCProfileFrame profileFrame;
 
         bool isLayoutValid = IsLayoutValid();
         if (!isLayoutValid) {
@@ -465,18 +484,20 @@ namespace UltraCanvas {
         // ---- Window content pass: loop once per optimised dirty rect ----
         if (dirtyRectManager.HasDirtyRects()) {
             const auto& rects = dirtyRectManager.GetOptimizedRectangles();
-            for (const auto& rect : rects) {
-                ctx->PushState();
-                ctx->ClipRect(Rect2Dd(rect.x, rect.y, rect.width, rect.height));
-                Render(ctx, rect);
-                RenderCustomContent(ctx, rect);
-                // Above every element: the drag overlay a widget handed over
-                // because it has to be visible outside that widget's bounds.
-                if (dragOverlayRenderer && dragOverlayRect.Intersects(rect)) {
-                    dragOverlayRenderer(ctx, dragOverlayRect);
+            UCProfileScope profileScope(ProfileKind::Render, this, &GetIdentifier());
+            // Tiled path: record once, replay per tile on the workers. A
+            // display list the recorder refuses to replay is dropped and the
+            // frame is rendered again the serial way.
+            IRenderContext* recorder = tiledRasterization ? ctx->BeginDisplayList() : nullptr;
+            if (recorder) {
+                RenderContent(recorder, rects);
+                if (!ctx->EndDisplayList(rects, tiledRasterThreads)) {
+                    RenderContent(ctx, rects);
                 }
-                ctx->PopState();
+            } else {
+                RenderContent(ctx, rects);
             }
+            frameDamage.insert(frameDamage.end(), rects.begin(), rects.end());
             dirtyRectManager.Clear();
             _needsWindowComposition = true;
         }
@@ -499,6 +520,7 @@ namespace UltraCanvas {
             }
 
             if (pe.dirtyRectManager.HasDirtyRects()) {
+                UCProfileScope profileScope(ProfileKind::Render, p, &p->GetIdentifier());
                 const auto& popupRects = pe.dirtyRectManager.GetOptimizedRectangles();
                 for (const auto& rect : popupRects) {
                     p->renderContext->PushState();
@@ -530,6 +552,7 @@ namespace UltraCanvas {
         // Composite popups, the caret and tooltips onto the native surface
         if (_needsWindowComposition) {
             renderContext->FlushToSurface(nativeSurface, {0, 0});
+            std::vector<Rect2Di> overlayRects;
 
             if (!popupElements.empty()) {
                 for (auto& pe : popupElements) {
@@ -538,21 +561,37 @@ namespace UltraCanvas {
                     auto pos = p->GetPositionInWindow();
                     p->renderContext->FlushToSurface(nativeSurface,
                                                      {(float)pos.x, (float)pos.y});
+                    const Size2Di ps = p->renderContext->GetSurfaceSize();
+                    overlayRects.emplace_back(pos.x, pos.y, ps.width, ps.height);
                 }
             }
 
             // Caret goes above the window content and popups (the focused
             // widget may live inside a popup), but below tooltips.
-            UltraCanvasCaret::GetInstance().Composite(this, nativeSurface);
+            auto& caret = UltraCanvasCaret::GetInstance();
+            caret.Composite(this, nativeSurface);
+            if (caret.IsOnWindow(this)) overlayRects.push_back(caret.GetRect());
 
             auto tooltipCtx = UltraCanvasTooltipManager::Render(this);
             if (tooltipCtx) {
                 // CompositeToSurface (not FlushToSurface): the tooltip surface
                 // has transparent soft-shadow margins that must blend OVER the
                 // window content instead of overwriting it.
-                tooltipCtx->CompositeToSurface(nativeSurface, UltraCanvasTooltipManager::GetCompositePosition());
+                const Point2Di tipPos = UltraCanvasTooltipManager::GetCompositePosition();
+                tooltipCtx->CompositeToSurface(nativeSurface, tipPos);
+                const Size2Di ts = tooltipCtx->GetSurfaceSize();
+                overlayRects.emplace_back(tipPos.x, tipPos.y, ts.width, ts.height);
             }
 
+            if (UltraCanvasFrameProfiler::IsActive() && UltraCanvasFrameProfiler::GetInstance().IsOverlayVisible()) {
+                CompositeProfilerOverlay(overlayRects);
+            }
+
+            // An overlay that moved or closed leaves its old area to repaint.
+            frameDamage.insert(frameDamage.end(), overlayRects.begin(), overlayRects.end());
+            frameDamage.insert(frameDamage.end(), lastOverlayRects.begin(), lastOverlayRects.end());
+            lastOverlayRects = std::move(overlayRects);
+
             InvalidateWindowNative();
         } else if (_needsCaretComposition) {
             // Blink-phase-only frame: no widget rendered anything. Restore the
@@ -565,10 +604,13 @@ namespace UltraCanvas {
                         Rect2Dd(r.x, r.y, r.width, r.height),
                         {(double)r.x, (double)r.y});
                 caret.Composite(this, nativeSurface);
+                frameDamage.push_back(r);
                 InvalidateWindowNative();
             }
         }
 
+        if (UltraCanvasFrameProfiler::IsActive()) UltraCanvasFrameProfiler::GetInstance().AddDirtyRects(frameDamage);
+        frameDamage.clear();
         _needsPopupGeometry = false;
         _needsWindowComposition = false;
         _needsCaretComposition = false;
@@ -596,6 +638,57 @@ namespace UltraCanvas {
         AddDirtyRectangle(dragOverlayRect);
     }
 
+    void UltraCanvasWindowBase::RenderContent(IRenderContext* ctx, const std::vector<Rect2Di>& rects) {
+        for (const auto& rect : rects) {
+            ctx->PushState();
+            ctx->ClipRect(Rect2Dd(rect.x, rect.y, rect.width, rect.height));
+            Render(ctx, rect);
+            RenderCustomContent(ctx, rect);
+            // Above every element: the drag overlay a widget handed over
+            // because it has to be visible outside that widget's bounds.
+            if (dragOverlayRenderer && dragOverlayRect.Intersects(rect)) {
+                dragOverlayRenderer(ctx, dragOverlayRect);
+            }
+            ctx->PopState();
+        }
+    }
+
+    void UltraCanvasWindowBase::CompositeProfilerOverlay(std::vector<Rect2Di>& overlayRects) {
+        // Shows the last finished frame. Drawing it does not schedule another
+        // frame, so an idle window stays idle with the overlay up.
+        const auto lines = UltraCanvasFrameProfiler::GetInstance().GetOverlayLines();
+        const int lineHeight = 14;
+        const Size2Di size(380, 8 + static_cast<int>(lines.size()) * lineHeight);
+        if (!profilerOverlayContext || profilerOverlayContext->GetSurfaceSize() != size) {
+            profilerOverlayContext = CreateRenderContext(size, nativeSurface);
+            if (!profilerOverlayContext) return;
+        }
+        IRenderContext* ctx = profilerOverlayContext.get();
+        ctx->Clear(Color(24, 26, 32, 215));
+        ctx->SetFontFace("monospace", FontWeight::Normal, FontSlant::Normal);
+        ctx->SetFontSize(10);
+        for (size_t i = 0; i < lines.size(); i++) {
+            ctx->SetTextPaint(i == 0 ? Color(255, 220, 120, 255) : Color(225, 228, 235, 255));
+            ctx->DrawText(lines[i], Point2Dd(6, 4 + static_cast<double>(i) * lineHeight));
+        }
+
+        const Point2Di pos(std::max(0, config_.width - size.width - 8), 8);
+        ctx->CompositeToSurface(nativeSurface, pos);
+        overlayRects.emplace_back(pos.x, pos.y, size.width, size.height);
+    }
+
+    void UltraCanvasWindowBase::SetTiledRasterization(bool enable, int threads) {
+        tiledRasterThreads = std::max(0, threads);
+        if (enable == tiledRasterization) return;
+        tiledRasterization = enable;
+        if (!_created) return;
+        // The content surface must be a plain image surface for the tiles to
+        // write into it; rebuild it with the right backing.
+        renderContext = CreateRenderContext(Size2Di(config_.width, config_.height), nativeSurface, tiledRasterization);
+        AddDirtyRectangle(Rect2Di(0, 0, config_.width, config_.height));
+        RequestWindowComposition();
+    }
+
     void UltraCanvasWindowBase::ClearDragOverlay(UltraCanvasUIElement* owner) {
         if (!dragOverlayRenderer || dragOverlayOwner != owner) return;
         AddDirtyRectangle(dragOverlayRect);
@@ -736,7 +829,7 @@ namespace UltraCanvas {
         SetBounds(Rect2Di(0, 0, config_.width, config_.height));
 
         if (CreateNative()) {
-            renderContext = CreateRenderContext(Size2Di(config_.width, config_.height), nativeSurface);
+            renderContext = CreateRenderContext(Size2Di(config_.width, config_.height), nativeSurface, tiledRasterization);
             if (renderContext) {
                 UltraCanvasApplication::GetInstance()->RegisterWindow(std::dynamic_pointer_cast<UltraCanvasWindowBase>(shared_from_this()));
                 _created = true;
@@ -8,14 +8,20 @@
 // fallback, which returned success while passing plaintext through). Nothing
 // here ever reports success without doing the work.
 //
-// Version: 0.1.0
+// Version: 0.2.0
 // Author: UltraCanvas Framework / ULTRA OS
 #include "UltraCrypt/UltraCryptCore.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <cstring>
+#include <filesystem>
 #include <fstream>
 #include <mutex>
 #include <new>
+#include <thread>
 
 #ifdef ULTRACRYPT_HAVE_SODIUM
 #include <sodium.h>
@@ -24,7 +30,10 @@
 #if defined(_WIN32)
 #include <windows.h>
 #else
+#include <fcntl.h>
 #include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #endif
 
 // ============================================================================
@@ -448,20 +457,121 @@ UltraCryptResult UltraCrypt_Hash(UltraCryptHashAlgorithm algorithm,
 #endif
 }
 
+namespace {
+
+// Read-only mapping of a whole file, kept local so UltraCrypt stays free of
+// the UI library (UltraCanvasMappedFile lives there).
+class MappedInput {
+public:
+    enum class Status { Mapped, Unmappable, Missing };
+
+    MappedInput() = default;
+    MappedInput(const MappedInput&) = delete;
+    MappedInput& operator=(const MappedInput&) = delete;
+    ~MappedInput() { Close(); }
+
+    // Unmappable: the file exists but is not a regular file, or mapping
+    // failed — callers fall back to buffered reads.
+    Status Open(const std::string& path) {
+        Close();
+#if defined(_WIN32)
+        const int wideLen = MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, nullptr, 0);
+        std::wstring widePath(wideLen > 0 ? wideLen - 1 : 0, L'\0');
+        if (wideLen > 1) MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, widePath.data(), wideLen);
+        HANDLE file = CreateFileW(widePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                  OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE) return Status::Missing;
+        LARGE_INTEGER fileSize{};
+        if (!GetFileSizeEx(file, &fileSize) ||
+            static_cast<unsigned long long>(fileSize.QuadPart) > SIZE_MAX) {
+            CloseHandle(file);
+            return Status::Unmappable;
+        }
+        if (fileSize.QuadPart == 0) {
+            CloseHandle(file);
+            return Status::Mapped;
+        }
+        HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+        if (mapping) CloseHandle(mapping);    // the view keeps the mapping alive
+        CloseHandle(file);
+        if (!view) return Status::Unmappable;
+        data_ = static_cast<const uint8_t*>(view);
+        size_ = static_cast<size_t>(fileSize.QuadPart);
+        return Status::Mapped;
+#else
+        const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) return Status::Missing;
+        struct stat st{};
+        if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) ||
+            static_cast<unsigned long long>(st.st_size) > SIZE_MAX) {
+            ::close(fd);
+            return Status::Unmappable;
+        }
+        if (st.st_size == 0) {
+            ::close(fd);
+            return Status::Mapped;
+        }
+        void* view = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);    // the mapping keeps its own reference
+        if (view == MAP_FAILED) return Status::Unmappable;
+        data_ = static_cast<const uint8_t*>(view);
+        size_ = static_cast<size_t>(st.st_size);
+        madvise(view, size_, MADV_SEQUENTIAL);
+        return Status::Mapped;
+#endif
+    }
+
+    void Close() {
+        if (data_) {
+#if defined(_WIN32)
+            UnmapViewOfFile(data_);
+#else
+            munmap(const_cast<uint8_t*>(data_), size_);
+#endif
+        }
+        data_ = nullptr;
+        size_ = 0;
+    }
+
+    const uint8_t* Data() const { return data_; }
+    size_t         Size() const { return size_; }
+
+private:
+    const uint8_t* data_ = nullptr;
+    size_t         size_ = 0;
+};
+
+} // namespace
+
 UltraCryptResult UltraCrypt_HashFile(UltraCryptHashAlgorithm algorithm,
                                      const std::string& filePath,
                                      std::vector<uint8_t>& outDigest) {
     if (!EnsureReady()) return NoBackend();
 
+    UltraCryptHasher hasher(algorithm);
+    if (!hasher.IsValid()) return NoBackend();
+
+    // Mapped: the hasher reads straight from the page cache, with kernel
+    // read-ahead, instead of copying through a stream buffer.
+    MappedInput mapped;
+    const MappedInput::Status status = mapped.Open(filePath);
+    if (status == MappedInput::Status::Missing) {
+        return UltraCryptResult::Error(UltraCryptResultCode::InvalidArgument,
+                                       "could not open file: " + filePath);
+    }
+    if (status == MappedInput::Status::Mapped) {
+        hasher.Update(mapped.Data(), mapped.Size());
+        outDigest = hasher.Final();
+        return UltraCryptResult::Ok();
+    }
+
     std::ifstream file(filePath, std::ios::binary);
     if (!file) {
         return UltraCryptResult::Error(UltraCryptResultCode::InvalidArgument,
                                        "could not open file: " + filePath);
     }
-    UltraCryptHasher hasher(algorithm);
-    if (!hasher.IsValid()) return NoBackend();
-
-    std::vector<char> chunk(64 * 1024);
+    std::vector<char> chunk(1024 * 1024);
     while (file.read(chunk.data(), static_cast<std::streamsize>(chunk.size())) ||
            file.gcount() > 0) {
         hasher.Update(chunk.data(), static_cast<size_t>(file.gcount()));
@@ -583,6 +693,305 @@ size_t UltraCryptHasher::GetDigestSize() const {
     return UltraCrypt_GetDigestSize(algorithm_);
 }
 
+// ============================================================================
+// Tree hashing
+// ============================================================================
+namespace {
+
+constexpr size_t kTreeLeafDigestSize = 32;
+constexpr size_t kTreeGrabBytes      = 4 * 1024 * 1024;    // leaves claimed per worker step
+const unsigned char kTreeLeafPersonal[16] = "UCTreeHash-leaf";
+const unsigned char kTreeRootPersonal[16] = "UCTreeHash-root";
+
+// Shared with UltraCrypt_HashFiles: bytes hashed so far, a cancel flag and a
+// callback run by workers between leaf batches.
+struct TreeHashHooks {
+    std::atomic<uint64_t>*       bytesDone = nullptr;
+    const std::atomic<bool>*     cancel    = nullptr;
+    const std::function<void()>* poll      = nullptr;
+};
+
+bool CheckTreeParams(const UltraCryptTreeHashParams& params, UltraCryptResult& error) {
+    if (params.leafSize < 1024) {
+        error = UltraCryptResult::Error(UltraCryptResultCode::InvalidArgument,
+                                        "tree hash leaf size must be at least 1 KiB");
+        return false;
+    }
+    if (params.digestSize < 16 || params.digestSize > 64) {
+        error = UltraCryptResult::Error(UltraCryptResultCode::InvalidArgument,
+                                        "tree hash digest size must be 16..64 bytes");
+        return false;
+    }
+    return true;
+}
+
+size_t TreeLeafCount(uint64_t size, size_t leafSize) {
+    return size == 0 ? 1 : static_cast<size_t>((size + leafSize - 1) / leafSize);
+}
+
+void StoreLE64(uint8_t* out, uint64_t value) {
+    for (int i = 0; i < 8; ++i) out[i] = static_cast<uint8_t>(value >> (8 * i));
+}
+
+#ifdef ULTRACRYPT_HAVE_SODIUM
+void HashTreeLeaf(const uint8_t* data, size_t size, uint64_t index, uint8_t* out) {
+    uint8_t salt[16] = {};
+    StoreLE64(salt, index);
+    crypto_generichash_blake2b_salt_personal(out, kTreeLeafDigestSize, data, size,
+                                             nullptr, 0, salt, kTreeLeafPersonal);
+}
+
+UltraCryptResult HashTreeRoot(uint64_t totalSize, size_t leafSize,
+                              std::vector<uint8_t>& leafDigests,
+                              size_t digestSize, std::vector<uint8_t>& outDigest) {
+    // leafDigests arrives with 16 spare bytes in front for the size header.
+    StoreLE64(leafDigests.data(), totalSize);
+    StoreLE64(leafDigests.data() + 8, leafSize);
+    const uint8_t salt[16] = {};
+    outDigest.assign(digestSize, 0);
+    if (crypto_generichash_blake2b_salt_personal(outDigest.data(), digestSize,
+                                                 leafDigests.data(), leafDigests.size(),
+                                                 nullptr, 0, salt, kTreeRootPersonal) != 0) {
+        outDigest.clear();
+        return UltraCryptResult::Error(UltraCryptResultCode::InternalError,
+                                       "hash computation failed");
+    }
+    return UltraCryptResult::Ok();
+}
+
+// Workers claim runs of consecutive leaves from a shared counter, so a slow
+// page fault on one core does not hold up the others.
+UltraCryptResult TreeHashBuffer(const uint8_t* data, size_t size,
+                                const UltraCryptTreeHashParams& params,
+                                std::vector<uint8_t>& outDigest,
+                                const TreeHashHooks& hooks) {
+    const size_t leafSize  = params.leafSize;
+    const size_t leafCount = TreeLeafCount(size, leafSize);
+    const size_t grab      = std::max<size_t>(1, kTreeGrabBytes / leafSize);
+    std::vector<uint8_t> digests(16 + leafCount * kTreeLeafDigestSize);
+
+    std::atomic<size_t> nextLeaf{0};
+    auto work = [&]() {
+        for (;;) {
+            if (hooks.cancel && hooks.cancel->load(std::memory_order_relaxed)) return;
+            const size_t first = nextLeaf.fetch_add(grab, std::memory_order_relaxed);
+            if (first >= leafCount) return;
+            const size_t last = std::min(leafCount, first + grab);
+            uint64_t bytes = 0;
+            for (size_t i = first; i < last; ++i) {
+                const size_t offset = i * leafSize;
+                const size_t length = std::min(leafSize, size - std::min(size, offset));
+                HashTreeLeaf(data + offset, length, i, digests.data() + 16 + i * kTreeLeafDigestSize);
+                bytes += length;
+            }
+            if (hooks.bytesDone) hooks.bytesDone->fetch_add(bytes, std::memory_order_relaxed);
+            if (hooks.poll) (*hooks.poll)();
+        }
+    };
+
+    unsigned threads = params.threads ? params.threads
+                                      : std::max(1u, std::thread::hardware_concurrency());
+    threads = static_cast<unsigned>(std::min<size_t>(threads, (leafCount + grab - 1) / grab));
+    std::vector<std::thread> pool;
+    pool.reserve(threads > 0 ? threads - 1 : 0);
+    for (unsigned t = 1; t < threads; ++t) pool.emplace_back(work);
+    work();
+    for (auto& t : pool) t.join();
+
+    if (hooks.cancel && hooks.cancel->load()) {
+        return UltraCryptResult::Error(UltraCryptResultCode::Cancelled, "hashing cancelled");
+    }
+    return HashTreeRoot(size, leafSize, digests, params.digestSize, outDigest);
+}
+
+// Fallback for inputs that cannot be mapped (pipes, special files): one
+// leaf at a time on the calling thread.
+UltraCryptResult TreeHashStream(std::istream& in,
+                                const UltraCryptTreeHashParams& params,
+                                std::vector<uint8_t>& outDigest,
+                                const TreeHashHooks& hooks) {
+    std::vector<uint8_t> leaf(params.leafSize);
+    std::vector<uint8_t> digests(16);
+    uint64_t total = 0;
+    for (uint64_t index = 0;; ++index) {
+        if (hooks.cancel && hooks.cancel->load(std::memory_order_relaxed)) {
+            return UltraCryptResult::Error(UltraCryptResultCode::Cancelled, "hashing cancelled");
+        }
+        in.read(reinterpret_cast<char*>(leaf.data()), static_cast<std::streamsize>(leaf.size()));
+        const size_t got = static_cast<size_t>(in.gcount());
+        if (in.bad()) {
+            return UltraCryptResult::Error(UltraCryptResultCode::InternalError, "read failed");
+        }
+        // A short or empty read after the first leaf means the input ended
+        // exactly on a leaf boundary; the tree has no trailing empty leaf.
+        if (got == 0 && index > 0) break;
+        digests.resize(digests.size() + kTreeLeafDigestSize);
+        HashTreeLeaf(leaf.data(), got, index, digests.data() + digests.size() - kTreeLeafDigestSize);
+        total += got;
+        if (hooks.bytesDone) hooks.bytesDone->fetch_add(got, std::memory_order_relaxed);
+        if (hooks.poll) (*hooks.poll)();
+        if (got < leaf.size()) break;
+    }
+    return HashTreeRoot(total, params.leafSize, digests, params.digestSize, outDigest);
+}
+#endif
+
+UltraCryptResult TreeHashFileImpl(const std::string& filePath,
+                                  const UltraCryptTreeHashParams& params,
+                                  std::vector<uint8_t>& outDigest,
+                                  const TreeHashHooks& hooks) {
+#ifdef ULTRACRYPT_HAVE_SODIUM
+    MappedInput mapped;
+    const MappedInput::Status status = mapped.Open(filePath);
+    if (status == MappedInput::Status::Missing) {
+        return UltraCryptResult::Error(UltraCryptResultCode::InvalidArgument,
+                                       "could not open file: " + filePath);
+    }
+    if (status == MappedInput::Status::Mapped) {
+        return TreeHashBuffer(mapped.Data(), mapped.Size(), params, outDigest, hooks);
+    }
+    std::ifstream file(filePath, std::ios::binary);
+    if (!file) {
+        return UltraCryptResult::Error(UltraCryptResultCode::InvalidArgument,
+                                       "could not open file: " + filePath);
+    }
+    return TreeHashStream(file, params, outDigest, hooks);
+#else
+    (void)filePath; (void)params; (void)outDigest; (void)hooks;
+    return NoBackend();
+#endif
+}
+
+} // namespace
+
+UltraCryptResult UltraCrypt_TreeHash(const void* data, size_t size,
+                                     std::vector<uint8_t>& outDigest,
+                                     const UltraCryptTreeHashParams& params) {
+    outDigest.clear();
+    if (!EnsureReady()) return NoBackend();
+    if (!data && size > 0) {
+        return UltraCryptResult::Error(UltraCryptResultCode::InvalidArgument, "null input");
+    }
+    UltraCryptResult error;
+    if (!CheckTreeParams(params, error)) return error;
+#ifdef ULTRACRYPT_HAVE_SODIUM
+    return TreeHashBuffer(static_cast<const uint8_t*>(data), size, params, outDigest, {});
+#else
+    return NoBackend();
+#endif
+}
+
+UltraCryptResult UltraCrypt_TreeHashFile(const std::string& filePath,
+                                         std::vector<uint8_t>& outDigest,
+                                         const UltraCryptTreeHashParams& params) {
+    outDigest.clear();
+    if (!EnsureReady()) return NoBackend();
+    UltraCryptResult error;
+    if (!CheckTreeParams(params, error)) return error;
+    return TreeHashFileImpl(filePath, params, outDigest, {});
+}
+
+UltraCryptResult UltraCrypt_HashFiles(const std::vector<std::string>& filePaths,
+                                      const UltraCryptHashBatchParams& params,
+                                      std::vector<UltraCryptFileDigest>& outDigests) {
+    outDigests.clear();
+    outDigests.resize(filePaths.size());
+    for (size_t i = 0; i < filePaths.size(); ++i) outDigests[i].path = filePaths[i];
+
+    UltraCryptResult error = UltraCryptResult::Ok();
+    if (!EnsureReady()) {
+        error = NoBackend();
+    } else if (params.maxConcurrentFiles == 0) {
+        error = UltraCryptResult::Error(UltraCryptResultCode::InvalidArgument,
+                                        "maxConcurrentFiles must be at least 1");
+    } else if (params.treeHash) {
+        CheckTreeParams(params.tree, error);
+    }
+    if (!error) {
+        for (auto& d : outDigests) d.result = error;
+        return error;
+    }
+
+    UltraCryptHashProgress progress;
+    progress.filesTotal = filePaths.size();
+    for (const auto& path : filePaths) {
+        std::error_code ec;
+        const auto size = std::filesystem::file_size(path, ec);
+        if (!ec) progress.bytesTotal += size;
+    }
+
+    const unsigned workers = static_cast<unsigned>(
+        std::min<size_t>(params.maxConcurrentFiles, std::max<size_t>(1, filePaths.size())));
+    UltraCryptTreeHashParams tree = params.tree;
+    if (tree.threads == 0) {
+        tree.threads = std::max(1u, std::thread::hardware_concurrency() / workers);
+    }
+
+    std::atomic<size_t>   nextFile{0};
+    std::atomic<size_t>   filesDone{0};
+    std::atomic<uint64_t> bytesDone{0};
+    std::atomic<bool>     cancel{false};
+    std::mutex            progressMutex;
+    auto                  lastReport = std::chrono::steady_clock::now();
+
+    // `force` reports are the per-file ones and always go through; the
+    // in-between ones are skipped when another thread is reporting or the
+    // last report is under 100 ms old.
+    auto report = [&](bool force) {
+        if (!params.onProgress || cancel.load(std::memory_order_relaxed)) return;
+        std::unique_lock<std::mutex> lock(progressMutex, std::defer_lock);
+        if (force) {
+            lock.lock();
+        } else if (!lock.try_lock()) {
+            return;
+        }
+        const auto now = std::chrono::steady_clock::now();
+        if (!force && now - lastReport < std::chrono::milliseconds(100)) return;
+        lastReport = now;
+        progress.filesDone = filesDone.load();
+        progress.bytesDone = bytesDone.load();
+        if (!params.onProgress(progress)) cancel.store(true);
+    };
+    const std::function<void()> poll = [&]() { report(false); };
+
+    auto work = [&]() {
+        for (;;) {
+            const size_t i = nextFile.fetch_add(1);
+            if (i >= filePaths.size()) return;
+            UltraCryptFileDigest& entry = outDigests[i];
+            if (cancel.load()) {
+                entry.result = UltraCryptResult::Error(UltraCryptResultCode::Cancelled,
+                                                       "hashing cancelled");
+                continue;
+            }
+            if (params.treeHash) {
+                TreeHashHooks hooks;
+                hooks.bytesDone = &bytesDone;
+                hooks.cancel = &cancel;
+                hooks.poll = &poll;
+                entry.result = TreeHashFileImpl(filePaths[i], tree, entry.digest, hooks);
+            } else {
+                entry.result = UltraCrypt_HashFile(params.algorithm, filePaths[i], entry.digest);
+                std::error_code ec;
+                const auto size = std::filesystem::file_size(filePaths[i], ec);
+                if (!ec && entry.result.success) bytesDone.fetch_add(size);
+            }
+            filesDone.fetch_add(1);
+            report(true);
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < workers; ++t) pool.emplace_back(work);
+    work();
+    for (auto& t : pool) t.join();
+
+    for (const auto& d : outDigests) {
+        if (!d.result.success) return d.result;
+    }
+    return UltraCryptResult::Ok();
+}
+
 // ============================================================================
 // HMAC
 // ============================================================================
@@ -816,6 +1225,431 @@ UltraCryptResult UltraCrypt_AeadOpen(const UltraCryptSecureBuffer& key,
 #endif
 }
 
+// ============================================================================
+// Streaming AEAD
+// ============================================================================
+// See the header for the stream layout. Chunks are processed in batches: while
+// the workers seal or open one batch, the calling thread writes out the
+// previous one and reads the next, so I/O overlaps the cipher work and at most
+// two batches are ever held.
+namespace {
+
+constexpr size_t   kStreamHeaderSize  = 28;
+constexpr size_t   kStreamPrefixSize  = 16;
+constexpr size_t   kStreamTagSize     = 16;
+constexpr uint8_t  kStreamVersion     = 1;
+constexpr uint8_t  kStreamAeadXChaCha = 1;
+constexpr uint32_t kStreamMaxChunk    = 64u * 1024u * 1024u;   // hostile-header guard
+const char kStreamMagic[4] = {'U', 'C', 'S', 'A'};
+
+struct StreamChunk {
+    std::vector<uint8_t> input;
+    std::vector<uint8_t> output;
+    uint64_t index = 0;
+    bool     final = false;
+    bool     ok    = false;
+};
+
+// Fixed set of workers for one stream call. Start() hands out a batch;
+// Wait() blocks until every item of it is done.
+class StreamWorkers {
+public:
+    explicit StreamWorkers(unsigned count) {
+        for (unsigned i = 0; i < count; ++i) threads_.emplace_back([this]() { Loop(); });
+    }
+
+    ~StreamWorkers() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        wake_.notify_all();
+        for (auto& t : threads_) t.join();
+    }
+
+    void Start(size_t count, std::function<void(size_t)> job) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        job_ = std::move(job);
+        count_ = count;
+        next_ = 0;
+        pending_ = count;
+        ++generation_;
+        wake_.notify_all();
+    }
+
+    void Wait() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_.wait(lock, [this]() { return pending_ == 0; });
+    }
+
+private:
+    void Loop() {
+        uint64_t seen = 0;
+        std::unique_lock<std::mutex> lock(mutex_);
+        for (;;) {
+            wake_.wait(lock, [&]() { return stop_ || (generation_ != seen && next_ < count_); });
+            if (stop_) return;
+            while (next_ < count_) {
+                const size_t item = next_++;
+                lock.unlock();
+                job_(item);
+                lock.lock();
+                if (--pending_ == 0) done_.notify_all();
+            }
+            seen = generation_;
+        }
+    }
+
+    std::vector<std::thread> threads_;
+    std::mutex               mutex_;
+    std::condition_variable  wake_;
+    std::condition_variable  done_;
+    std::function<void(size_t)> job_;
+    size_t   count_      = 0;
+    size_t   next_       = 0;
+    size_t   pending_    = 0;
+    uint64_t generation_ = 0;
+    bool     stop_       = false;
+};
+
+unsigned StreamThreadCount(const UltraCryptStreamParams& params) {
+    if (params.threads > 0) return params.threads;
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+size_t StreamBatchSize(const UltraCryptStreamParams& params, unsigned threads) {
+    const size_t inFlight = params.chunksInFlight > 0 ? params.chunksInFlight
+                                                      : static_cast<size_t>(threads) * 4;
+    return std::max<size_t>(1, inFlight / 2);
+}
+
+// Reads until `capacity` bytes arrived or the input ended.
+bool ReadFully(const UltraCryptStreamReader& read, uint8_t* buffer,
+               size_t capacity, size_t& outRead) {
+    outRead = 0;
+    while (outRead < capacity) {
+        size_t got = 0;
+        if (!read(buffer + outRead, capacity - outRead, got)) return false;
+        if (got == 0) break;
+        outRead += got;
+    }
+    return true;
+}
+
+void StreamChunkNonce(const uint8_t* prefix, uint64_t index, bool final,
+                      uint8_t nonce[24]) {
+    std::memcpy(nonce, prefix, kStreamPrefixSize);
+    for (int i = 0; i < 7; ++i) nonce[kStreamPrefixSize + i] = static_cast<uint8_t>(index >> (8 * i));
+    nonce[23] = final ? 1 : 0;
+}
+
+UltraCryptResult StreamAuthFailure() {
+    return UltraCryptResult::Error(
+        UltraCryptResultCode::AuthenticationFailed,
+        "authentication failed: wrong key, or the stream was altered or truncated");
+}
+
+UltraCryptResult StreamPreflight(const UltraCryptSecureBuffer& key,
+                                 const UltraCryptStreamParams& params) {
+    if (!EnsureReady()) return NoBackend();
+    if (params.algorithm != UltraCryptAeadAlgorithm::XChaCha20Poly1305) {
+        return UltraCryptResult::Error(UltraCryptResultCode::NotSupported,
+                                       "streaming AEAD supports XChaCha20-Poly1305 only");
+    }
+    if (key.GetSize() != UltraCrypt_GetKeySize(params.algorithm)) {
+        return UltraCryptResult::Error(UltraCryptResultCode::InvalidKeySize,
+                                       "AEAD key must be 32 bytes");
+    }
+    return UltraCryptResult::Ok();
+}
+
+#ifdef ULTRACRYPT_HAVE_SODIUM
+bool SealStreamChunk(const UltraCryptSecureBuffer& key, const uint8_t* prefix,
+                     const std::vector<uint8_t>& ad, StreamChunk& chunk) {
+    uint8_t nonce[24];
+    StreamChunkNonce(prefix, chunk.index, chunk.final, nonce);
+    chunk.output.resize(chunk.input.size() + kStreamTagSize);
+    unsigned long long written = 0;
+    chunk.ok = crypto_aead_xchacha20poly1305_ietf_encrypt(
+                   chunk.output.data(), &written, chunk.input.data(), chunk.input.size(),
+                   ad.data(), ad.size(), nullptr, nonce, key.Data()) == 0 &&
+               written == chunk.output.size();
+    return chunk.ok;
+}
+
+bool OpenStreamChunk(const UltraCryptSecureBuffer& key, const uint8_t* prefix,
+                     const std::vector<uint8_t>& ad, StreamChunk& chunk) {
+    uint8_t nonce[24];
+    StreamChunkNonce(prefix, chunk.index, chunk.final, nonce);
+    chunk.output.resize(chunk.input.size() - kStreamTagSize);
+    unsigned long long written = 0;
+    chunk.ok = crypto_aead_xchacha20poly1305_ietf_decrypt(
+                   chunk.output.data(), &written, nullptr, chunk.input.data(), chunk.input.size(),
+                   ad.data(), ad.size(), nonce, key.Data()) == 0 &&
+               written == chunk.output.size();
+    if (!chunk.ok) UltraCrypt_SecureZero(chunk.output.data(), chunk.output.size());
+    return chunk.ok;
+}
+#endif
+
+void WipeChunks(std::vector<StreamChunk>& chunks, bool inputIsSecret) {
+    for (auto& c : chunks) {
+        if (inputIsSecret) UltraCrypt_SecureZero(c.input.data(), c.input.size());
+        else UltraCrypt_SecureZero(c.output.data(), c.output.size());
+    }
+}
+
+// Drives both directions. `inputChunk` is the byte size of a full input chunk
+// (plaintext for Seal, plaintext + tag for Open).
+template <typename ChunkFn>
+UltraCryptResult RunStream(const UltraCryptStreamParams& params, size_t inputChunk,
+                           bool sealing, const UltraCryptStreamReader& read,
+                           const UltraCryptStreamWriter& write, ChunkFn process) {
+    const unsigned threads = StreamThreadCount(params);
+    const size_t batchSize = StreamBatchSize(params, threads);
+    std::vector<StreamChunk> batches[2];
+    batches[0].resize(batchSize);
+    batches[1].resize(batchSize);
+    size_t counts[2] = {0, 0};
+
+    StreamWorkers workers(threads);
+    uint64_t nextIndex = 0;
+    bool ended = false;          // final chunk read
+    bool running = false;        // a batch is with the workers
+    int current = 0;
+    UltraCryptResult result = UltraCryptResult::Ok();
+
+    // Sealing wipes plaintext inputs, opening wipes plaintext outputs.
+    auto finishBatch = [&](int b) -> bool {
+        bool ok = true;
+        for (size_t i = 0; i < counts[b] && ok; ++i) {
+            StreamChunk& c = batches[b][i];
+            if (!c.ok) {
+                result = sealing ? UltraCryptResult::Error(UltraCryptResultCode::InternalError,
+                                                           "AEAD encryption failed")
+                                 : StreamAuthFailure();
+                ok = false;
+            } else if (!write(c.output.data(), c.output.size())) {
+                result = UltraCryptResult::Error(UltraCryptResultCode::InvalidArgument,
+                                                 "could not write the output stream");
+                ok = false;
+            }
+        }
+        std::vector<StreamChunk>& chunks = batches[b];
+        WipeChunks(chunks, sealing);
+        counts[b] = 0;
+        return ok;
+    };
+
+    while (!ended) {
+        // Read the next batch while the workers process the previous one.
+        std::vector<StreamChunk>& batch = batches[current];
+        size_t n = 0;
+        while (n < batchSize && !ended) {
+            StreamChunk& c = batch[n];
+            c.input.resize(inputChunk);
+            size_t got = 0;
+            if (!ReadFully(read, c.input.data(), inputChunk, got)) {
+                result = UltraCryptResult::Error(UltraCryptResultCode::InvalidArgument,
+                                                 "could not read the input stream");
+                break;
+            }
+            c.input.resize(got);
+            c.index = nextIndex++;
+            c.ok = false;
+            // A full chunk is never the last: the last one is always shorter.
+            c.final = got < inputChunk;
+            if (!sealing && c.final && got < kStreamTagSize) {
+                result = StreamAuthFailure();    // cut at (or just after) a chunk boundary
+                break;
+            }
+            if (c.index >= (uint64_t(1) << 56)) {
+                result = UltraCryptResult::Error(UltraCryptResultCode::InvalidArgument,
+                                                 "stream exceeds the chunk counter range");
+                break;
+            }
+            ended = c.final;
+            ++n;
+        }
+        if (!result) break;
+        counts[current] = n;
+
+        if (running) {
+            workers.Wait();
+            running = false;
+            if (!finishBatch(1 - current)) break;
+        }
+        if (n > 0) {
+            workers.Start(n, [&batch, &process](size_t i) { process(batch[i]); });
+            running = true;
+        }
+        current = 1 - current;
+    }
+
+    if (running) {
+        workers.Wait();
+        const int last = 1 - current;
+        if (result) finishBatch(last);
+        else { WipeChunks(batches[last], sealing); counts[last] = 0; }
+    }
+    for (int b = 0; b < 2; ++b) WipeChunks(batches[b], sealing);
+    return result;
+}
+
+} // namespace
+
+size_t UltraCrypt_GetStreamHeaderSize() {
+    return kStreamHeaderSize;
+}
+
+size_t UltraCrypt_GetStreamSize(size_t plaintextSize, uint32_t chunkSize) {
+    if (chunkSize == 0) return 0;
+    const size_t chunks = plaintextSize / chunkSize + 1;   // the last is shorter
+    return kStreamHeaderSize + plaintextSize + chunks * kStreamTagSize;
+}
+
+UltraCryptResult UltraCrypt_AeadSealStream(const UltraCryptSecureBuffer& key,
+                                           const UltraCryptStreamParams& params,
+                                           const UltraCryptStreamReader& read,
+                                           const UltraCryptStreamWriter& write) {
+    auto pre = StreamPreflight(key, params);
+    if (!pre) return pre;
+    if (params.chunkSize == 0 || params.chunkSize > kStreamMaxChunk || !read || !write) {
+        return UltraCryptResult::Error(UltraCryptResultCode::InvalidArgument,
+                                       "chunk size must be 1 byte to 64 MiB, with a reader and a writer");
+    }
+#ifdef ULTRACRYPT_HAVE_SODIUM
+    uint8_t header[kStreamHeaderSize] = {};
+    std::memcpy(header, kStreamMagic, 4);
+    header[4] = kStreamVersion;
+    header[5] = kStreamAeadXChaCha;
+    for (int i = 0; i < 4; ++i) header[8 + i] = static_cast<uint8_t>(params.chunkSize >> (8 * i));
+    auto rr = UltraCrypt_RandomBytes(header + 12, kStreamPrefixSize);
+    if (!rr) return rr;
+    if (!write(header, kStreamHeaderSize)) {
+        return UltraCryptResult::Error(UltraCryptResultCode::InvalidArgument,
+                                       "could not write the output stream");
+    }
+
+    std::vector<uint8_t> ad(header, header + kStreamHeaderSize);
+    ad.insert(ad.end(), params.associatedData.begin(), params.associatedData.end());
+    const uint8_t* prefix = header + 12;
+    return RunStream(params, params.chunkSize, true, read, write,
+                     [&](StreamChunk& c) { SealStreamChunk(key, prefix, ad, c); });
+#else
+    return NoBackend();
+#endif
+}
+
+UltraCryptResult UltraCrypt_AeadOpenStream(const UltraCryptSecureBuffer& key,
+                                           const UltraCryptStreamParams& params,
+                                           const UltraCryptStreamReader& read,
+                                           const UltraCryptStreamWriter& write) {
+    auto pre = StreamPreflight(key, params);
+    if (!pre) return pre;
+    if (!read || !write) {
+        return UltraCryptResult::Error(UltraCryptResultCode::InvalidArgument,
+                                       "a reader and a writer are required");
+    }
+#ifdef ULTRACRYPT_HAVE_SODIUM
+    uint8_t header[kStreamHeaderSize];
+    size_t got = 0;
+    if (!ReadFully(read, header, kStreamHeaderSize, got)) {
+        return UltraCryptResult::Error(UltraCryptResultCode::InvalidArgument,
+                                       "could not read the input stream");
+    }
+    if (got < kStreamHeaderSize || std::memcmp(header, kStreamMagic, 4) != 0) {
+        return UltraCryptResult::Error(UltraCryptResultCode::InvalidArgument,
+                                       "not an UltraCrypt stream");
+    }
+    if (header[4] != kStreamVersion || header[5] != kStreamAeadXChaCha) {
+        return UltraCryptResult::Error(UltraCryptResultCode::NotSupported,
+                                       "unsupported stream version or algorithm");
+    }
+    uint32_t chunkSize = 0;
+    for (int i = 0; i < 4; ++i) chunkSize |= static_cast<uint32_t>(header[8 + i]) << (8 * i);
+    if (chunkSize == 0 || chunkSize > kStreamMaxChunk) {
+        // The header is authenticated with every chunk, but the allocation
+        // would happen before the first tag check.
+        return UltraCryptResult::Error(UltraCryptResultCode::InvalidArgument,
+                                       "stream declares an unreasonable chunk size");
+    }
+
+    std::vector<uint8_t> ad(header, header + kStreamHeaderSize);
+    ad.insert(ad.end(), params.associatedData.begin(), params.associatedData.end());
+    const uint8_t* prefix = header + 12;
+    return RunStream(params, static_cast<size_t>(chunkSize) + kStreamTagSize, false, read, write,
+                     [&](StreamChunk& c) { OpenStreamChunk(key, prefix, ad, c); });
+#else
+    return NoBackend();
+#endif
+}
+
+namespace {
+
+using StreamFn = UltraCryptResult (*)(const UltraCryptSecureBuffer&, const UltraCryptStreamParams&,
+                                      const UltraCryptStreamReader&, const UltraCryptStreamWriter&);
+
+UltraCryptResult StreamFile(StreamFn fn, const UltraCryptSecureBuffer& key,
+                            const UltraCryptStreamParams& params,
+                            const std::string& inputPath, const std::string& outputPath) {
+    std::ifstream in(inputPath, std::ios::binary);
+    if (!in) {
+        return UltraCryptResult::Error(UltraCryptResultCode::InvalidArgument,
+                                       "could not open file: " + inputPath);
+    }
+    const std::string partial = outputPath + ".partial";
+    UltraCryptResult result = UltraCryptResult::Ok();
+    {
+        std::ofstream out(partial, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            return UltraCryptResult::Error(UltraCryptResultCode::InvalidArgument,
+                                           "could not create file: " + partial);
+        }
+        UltraCryptStreamReader reader = [&in](uint8_t* buffer, size_t capacity, size_t& outRead) {
+            in.read(reinterpret_cast<char*>(buffer), static_cast<std::streamsize>(capacity));
+            outRead = static_cast<size_t>(in.gcount());
+            return !in.bad();
+        };
+        UltraCryptStreamWriter writer = [&out](const uint8_t* data, size_t size) {
+            out.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(size));
+            return static_cast<bool>(out);
+        };
+        result = fn(key, params, reader, writer);
+        out.flush();
+        if (result && !out) {
+            result = UltraCryptResult::Error(UltraCryptResultCode::InvalidArgument,
+                                             "could not write file: " + partial);
+        }
+    }
+    std::error_code ec;
+    if (result) {
+        std::filesystem::rename(partial, outputPath, ec);
+        if (ec) {
+            result = UltraCryptResult::Error(UltraCryptResultCode::InvalidArgument,
+                                             "could not replace file: " + outputPath);
+        }
+    }
+    if (!result) std::filesystem::remove(partial, ec);
+    return result;
+}
+
+} // namespace
+
+UltraCryptResult UltraCrypt_AeadSealFile(const UltraCryptSecureBuffer& key,
+                                         const UltraCryptStreamParams& params,
+                                         const std::string& inputPath,
+                                         const std::string& outputPath) {
+    return StreamFile(&UltraCrypt_AeadSealStream, key, params, inputPath, outputPath);
+}
+
+UltraCryptResult UltraCrypt_AeadOpenFile(const UltraCryptSecureBuffer& key,
+                                         const UltraCryptStreamParams& params,
+                                         const std::string& inputPath,
+                                         const std::string& outputPath) {
+    return StreamFile(&UltraCrypt_AeadOpenStream, key, params, inputPath, outputPath);
+}
+
 // ============================================================================
 // Key derivation
 // ============================================================================
@@ -1,38 +1,71 @@
 // core/UltraVault/UltraVaultCore.cpp
 // UltraVault implementation: memory and encrypted-file backends.
 //
-// File format v1 ("UVLT"):
-//   magic[4]="UVLT" | version u8=1 | kdfIterations u32 | kdfMemoryKiB u32 |
-//   saltLen u8 | salt | nonceLen u8 | nonce | ciphertext(+tag)
-// Integers are little-endian. Everything before the ciphertext is passed to
-// the AEAD as associated data, so editing the stored KDF cost parameters,
-// salt or nonce invalidates the tag instead of being obeyed.
+// File format v2 ("UVLT"), an append-only log:
+//   header: magic[4]="UVLT" | version u8=2 | kdfIterations u32 |
+//           kdfMemoryKiB u32 | saltLen u8 | salt | logIdLen u8 | logId
+//   then records: length u32 | nonce[24] | ciphertext(+tag)[length]
+// Record i is sealed with associated data header || i (u64), so records
+// cannot be edited, reordered, dropped from the middle or moved between
+// logs (compaction picks a fresh random logId). Record 0 is a snapshot of
+// the whole vault; each later record is one commit (Put, Delete or Batch).
+// A record cut short at the end of the file is the trace of a crash during
+// an append: it is ignored on load and cut off before the next append. A
+// complete record that fails authentication is tampering.
 //
-// Decrypted payload:
-//   count u32, then per record: key, mimeType, value, ownerAppId as
-//   u32-length-prefixed byte strings, readerCount u32 + readers,
-//   requiresUserPresence u8.
+// Record payload:
+//   count u32, then per operation: kind u8 (1 = put, 2 = delete), key;
+//   puts continue with mimeType, value, ownerAppId as u32-length-prefixed
+//   byte strings, readerCount u32 + readers, requiresUserPresence u8.
 //
-// Version: 0.1.0
+// v1 files (header, one nonce, one ciphertext of the v0.1 payload: count
+// u32, then the put fields per record without the kind byte) are still read
+// and are rewritten as v2 on the first change.
+//
+// Integers are little-endian.
+//
+// Version: 0.2.0
 // Author: UltraCanvas Framework / ULTRA OS
 
 #include "UltraVault/UltraVault.h"
 #include "UltraCrypt/UltraCryptCore.h"
 
+#include <algorithm>
 #include <cctype>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <filesystem>
 #include <map>
 #include <mutex>
+#include <optional>
+#include <thread>
 #include <utility>
 
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 namespace UltraVault {
 
 namespace {
 
 constexpr char    kMagic[4]  = {'U', 'V', 'L', 'T'};
-constexpr uint8_t kVersion   = 1;
+constexpr uint8_t kVersion   = 2;
+constexpr uint8_t kVersionV1 = 1;
+constexpr size_t  kLogIdSize = 16;
+
+// Background compaction starts once the log is this large and at least
+// twice its size after the previous compaction, so a steady stream of
+// commits costs amortised O(1) rewritten bytes each.
+constexpr uint64_t kCompactMinBytes = 64 * 1024;
+constexpr uint32_t kMaxRecordSize   = 1u << 30;
+
+constexpr uint8_t kOpPut    = 1;
+constexpr uint8_t kOpDelete = 2;
 
 struct StoredSecret {
     SecretValue value;
@@ -47,6 +80,25 @@ struct VaultState {
     UltraCryptSecureBuffer fileKey;      // derived once per session
     UltraCryptKdfParams    kdfParams;    // as stored in the file header
     std::map<std::string, StoredSecret> secrets;
+
+    // File backend log position.
+    bool                 fileExists    = false;
+    uint8_t              fileVersion   = kVersion;
+    std::vector<uint8_t> header;         // v2 header, the AAD prefix
+    uint64_t             recordCount   = 0;
+    uint64_t             logBytes      = 0;   // valid bytes; a torn tail may follow
+    uint64_t             compactedBytes = 0;  // log size after the last compaction
+    bool                 tornTail      = false;
+
+    // Background compaction. Commits made while it runs are kept here and
+    // re-sealed into the new log before it replaces the old one.
+    std::thread                       compactor;
+    bool                              compacting = false;
+    std::vector<std::vector<uint8_t>> compactDelta;
+
+    ~VaultState() {
+        if (compactor.joinable()) compactor.join();
+    }
 };
 
 VaultState& State() {
@@ -122,38 +174,108 @@ struct Reader {
     }
 };
 
-std::vector<uint8_t> SerializeSecrets(
+void PutSecretFields(std::vector<uint8_t>& out, const StoredSecret& stored) {
+    PutString(out, stored.value.mimeType);
+    PutBlob(out, stored.value.bytes.data(), stored.value.bytes.size());
+    PutString(out, stored.acl.ownerAppId);
+    PutU32(out, static_cast<uint32_t>(stored.acl.readers.size()));
+    for (const auto& reader : stored.acl.readers) PutString(out, reader);
+    out.push_back(stored.acl.requiresUserPresence ? 1 : 0);
+}
+
+StoredSecret ReadSecretFields(Reader& r) {
+    StoredSecret s;
+    s.value.mimeType = r.String();
+    s.value.bytes    = r.Blob();
+    s.acl.ownerAppId = r.String();
+    const uint32_t readers = r.U32();
+    for (uint32_t j = 0; j < readers && r.ok; ++j) {
+        s.acl.readers.push_back(r.String());
+    }
+    s.acl.requiresUserPresence = r.U8() != 0;
+    return s;
+}
+
+void WipeSecret(StoredSecret& stored) {
+    if (!stored.value.bytes.empty()) {
+        UltraCrypt_SecureZero(stored.value.bytes.data(), stored.value.bytes.size());
+    }
+}
+
+void WipeBytes(std::vector<uint8_t>& bytes) {
+    if (!bytes.empty()) UltraCrypt_SecureZero(bytes.data(), bytes.size());
+    bytes.clear();
+}
+
+// The whole vault as one record of puts (record 0 of a log).
+std::vector<uint8_t> EncodeSnapshot(
         const std::map<std::string, StoredSecret>& secrets) {
     std::vector<uint8_t> out;
     PutU32(out, static_cast<uint32_t>(secrets.size()));
     for (const auto& [key, stored] : secrets) {
+        out.push_back(kOpPut);
         PutString(out, key);
-        PutString(out, stored.value.mimeType);
-        PutBlob(out, stored.value.bytes.data(), stored.value.bytes.size());
-        PutString(out, stored.acl.ownerAppId);
-        PutU32(out, static_cast<uint32_t>(stored.acl.readers.size()));
-        for (const auto& reader : stored.acl.readers) PutString(out, reader);
-        out.push_back(stored.acl.requiresUserPresence ? 1 : 0);
+        PutSecretFields(out, stored);
+    }
+    return out;
+}
+
+std::vector<uint8_t> EncodeOperations(
+        const std::vector<Batch::Operation>& operations) {
+    std::vector<uint8_t> out;
+    PutU32(out, static_cast<uint32_t>(operations.size()));
+    for (const auto& op : operations) {
+        if (op.kind == Batch::Operation::Kind::Delete) {
+            out.push_back(kOpDelete);
+            PutString(out, op.key);
+        } else {
+            out.push_back(kOpPut);
+            PutString(out, op.key);
+            PutSecretFields(out, StoredSecret{op.value, op.acl});
+        }
     }
     return out;
 }
 
-bool DeserializeSecrets(const uint8_t* data, size_t size,
-                        std::map<std::string, StoredSecret>& outSecrets) {
+// Replays one record onto `secrets`. Parses completely before applying, so
+// a malformed record changes nothing.
+bool ApplyRecord(const uint8_t* data, size_t size,
+                 std::map<std::string, StoredSecret>& secrets) {
+    Reader r{data, size};
+    const uint32_t count = r.U32();
+    std::vector<std::pair<std::string, std::optional<StoredSecret>>> parsed;
+    for (uint32_t i = 0; i < count && r.ok; ++i) {
+        const uint8_t kind = r.U8();
+        std::string key = r.String();
+        if (kind == kOpPut) {
+            parsed.emplace_back(std::move(key), ReadSecretFields(r));
+        } else if (kind == kOpDelete) {
+            parsed.emplace_back(std::move(key), std::nullopt);
+        } else {
+            r.ok = false;
+        }
+    }
+    if (!r.ok || r.remaining != 0) return false;
+    for (auto& [key, secret] : parsed) {
+        if (secret) {
+            secrets[key] = std::move(*secret);
+        } else if (auto it = secrets.find(key); it != secrets.end()) {
+            WipeSecret(it->second);
+            secrets.erase(it);
+        }
+    }
+    return true;
+}
+
+// v1 payload: count, then key + put fields per record.
+bool DeserializeSecretsV1(const uint8_t* data, size_t size,
+                          std::map<std::string, StoredSecret>& outSecrets) {
     Reader r{data, size};
     const uint32_t count = r.U32();
     std::map<std::string, StoredSecret> parsed;
     for (uint32_t i = 0; i < count && r.ok; ++i) {
         const std::string key = r.String();
-        StoredSecret s;
-        s.value.mimeType = r.String();
-        s.value.bytes    = r.Blob();
-        s.acl.ownerAppId = r.String();
-        const uint32_t readers = r.U32();
-        for (uint32_t j = 0; j < readers && r.ok; ++j) {
-            s.acl.readers.push_back(r.String());
-        }
-        s.acl.requiresUserPresence = r.U8() != 0;
+        StoredSecret s = ReadSecretFields(r);
         if (r.ok) parsed.emplace(key, std::move(s));
     }
     if (!r.ok || r.remaining != 0) return false;
@@ -164,8 +286,11 @@ bool DeserializeSecrets(const uint8_t* data, size_t size,
 // --------------------------------------------------------------------------
 // File backend
 // --------------------------------------------------------------------------
+const char* const kOpenFailedMessage =
+    "vault cannot be opened: wrong passphrase or altered file";
+
 std::vector<uint8_t> BuildHeader(const UltraCryptKdfParams& kdf,
-                                 const std::vector<uint8_t>& nonce) {
+                                 const std::vector<uint8_t>& logId) {
     std::vector<uint8_t> h;
     h.insert(h.end(), kMagic, kMagic + 4);
     h.push_back(kVersion);
@@ -173,53 +298,368 @@ std::vector<uint8_t> BuildHeader(const UltraCryptKdfParams& kdf,
     PutU32(h, kdf.memoryKiB);
     h.push_back(static_cast<uint8_t>(kdf.salt.size()));
     h.insert(h.end(), kdf.salt.begin(), kdf.salt.end());
-    h.push_back(static_cast<uint8_t>(nonce.size()));
-    h.insert(h.end(), nonce.begin(), nonce.end());
+    h.push_back(static_cast<uint8_t>(logId.size()));
+    h.insert(h.end(), logId.begin(), logId.end());
     return h;
 }
 
-Result SaveFileLocked(VaultState& s) {
-    const std::vector<uint8_t> payload = SerializeSecrets(s.secrets);
+std::vector<uint8_t> RecordAad(const std::vector<uint8_t>& header, uint64_t index) {
+    std::vector<uint8_t> aad = header;
+    for (int i = 0; i < 8; ++i) aad.push_back(static_cast<uint8_t>(index >> (8 * i)));
+    return aad;
+}
 
-    UltraCryptAeadParams aead;                    // fresh random nonce
-    // Seal against provisional AAD-less params first is wrong — the nonce is
-    // needed inside the header before sealing. Generate it explicitly.
+Result SealRecord(const UltraCryptSecureBuffer& key,
+                  const std::vector<uint8_t>& header, uint64_t index,
+                  const std::vector<uint8_t>& payload,
+                  std::vector<uint8_t>& outRecord) {
+    UltraCryptAeadParams aead;
     aead.nonce.resize(UltraCrypt_GetNonceSize(aead.algorithm));
     if (!UltraCrypt_RandomBytes(aead.nonce.data(), aead.nonce.size())) {
         return Result::Error(ResultCode::BackendUnavailable,
                              "no entropy source for the vault nonce");
     }
-    const std::vector<uint8_t> header = BuildHeader(s.kdfParams, aead.nonce);
-    aead.associatedData = header;
-
+    aead.associatedData = RecordAad(header, index);
     std::vector<uint8_t> ciphertext;
     UltraCryptResult sealed = UltraCrypt_AeadSeal(
-        s.fileKey, aead, payload.data(), payload.size(), ciphertext);
+        key, aead, payload.data(), payload.size(), ciphertext);
     if (!sealed) {
         return Result::Error(ResultCode::BackendUnavailable,
                              "vault encryption failed: " + sealed.message);
     }
+    outRecord.clear();
+    PutU32(outRecord, static_cast<uint32_t>(ciphertext.size()));
+    outRecord.insert(outRecord.end(), aead.nonce.begin(), aead.nonce.end());
+    outRecord.insert(outRecord.end(), ciphertext.begin(), ciphertext.end());
+    return Result::Ok();
+}
+
+bool FlushToDisk(std::FILE* f) {
+    if (std::fflush(f) != 0) return false;
+#if defined(_WIN32)
+    return _commit(_fileno(f)) == 0;
+#else
+    return fsync(fileno(f)) == 0;
+#endif
+}
+
+// Makes a rename durable: on POSIX the new directory entry is only on disk
+// once the directory itself is synced.
+void SyncParentDirectory(const std::string& path) {
+#if !defined(_WIN32)
+    std::string dir = std::filesystem::path(path).parent_path().string();
+    if (dir.empty()) dir = ".";
+    const int fd = ::open(dir.c_str(), O_RDONLY);
+    if (fd >= 0) {
+        fsync(fd);
+        ::close(fd);
+    }
+#else
+    (void)path;
+#endif
+}
+
+// A new log written to `<path>.tmp` and renamed over the vault file by
+// Finish(). Records are numbered from 0, the snapshot.
+class LogFileWriter {
+public:
+    LogFileWriter() = default;
+    LogFileWriter(const LogFileWriter&) = delete;
+    LogFileWriter& operator=(const LogFileWriter&) = delete;
+    ~LogFileWriter() { Abandon(); }
+
+    Result Begin(const std::string& path, const UltraCryptKdfParams& kdf,
+                 const UltraCryptSecureBuffer& key,
+                 const std::vector<uint8_t>& snapshot) {
+        path_ = path;
+        tmpPath_ = path + ".tmp";
+        std::vector<uint8_t> logId(kLogIdSize);
+        if (!UltraCrypt_RandomBytes(logId.data(), logId.size())) {
+            return Result::Error(ResultCode::BackendUnavailable,
+                                 "no entropy source for the vault log id");
+        }
+        header_ = BuildHeader(kdf, logId);
+        file_ = std::fopen(tmpPath_.c_str(), "wb");
+        if (!file_) {
+            return Result::Error(ResultCode::IoError,
+                                 "cannot write vault file: " + tmpPath_);
+        }
+        if (!Write(header_)) return WriteError();
+        Result r = Append(key, snapshot);
+        snapshotBytes_ = bytes_;
+        return r;
+    }
+
+    Result Append(const UltraCryptSecureBuffer& key,
+                  const std::vector<uint8_t>& payload) {
+        std::vector<uint8_t> record;
+        if (Result sealed = SealRecord(key, header_, records_, payload, record);
+            !sealed.IsOk()) {
+            Abandon();
+            return sealed;
+        }
+        if (!Write(record)) return WriteError();
+        ++records_;
+        return Result::Ok();
+    }
 
-    const std::string tmpPath = s.filePath + ".tmp";
-    std::FILE* f = std::fopen(tmpPath.c_str(), "wb");
+    Result Finish() {
+        bool ok = FlushToDisk(file_);
+        ok = (std::fclose(file_) == 0) && ok;
+        file_ = nullptr;
+        if (!ok || std::rename(tmpPath_.c_str(), path_.c_str()) != 0) {
+            std::remove(tmpPath_.c_str());
+            return Result::Error(ResultCode::IoError,
+                                 "cannot update vault file: " + path_);
+        }
+        SyncParentDirectory(path_);
+        return Result::Ok();
+    }
+
+    void Abandon() {
+        if (!file_) return;
+        std::fclose(file_);
+        file_ = nullptr;
+        std::remove(tmpPath_.c_str());
+    }
+
+    std::vector<uint8_t>& GetHeader() { return header_; }
+    uint64_t GetBytes() const { return bytes_; }
+    uint64_t GetSnapshotBytes() const { return snapshotBytes_; }
+    uint64_t GetRecordCount() const { return records_; }
+
+private:
+    bool Write(const std::vector<uint8_t>& bytes) {
+        if (std::fwrite(bytes.data(), 1, bytes.size(), file_) != bytes.size()) return false;
+        bytes_ += bytes.size();
+        return true;
+    }
+    Result WriteError() {
+        Abandon();
+        return Result::Error(ResultCode::IoError,
+                             "cannot write vault file: " + tmpPath_);
+    }
+
+    std::string          path_, tmpPath_;
+    std::FILE*           file_ = nullptr;
+    std::vector<uint8_t> header_;
+    uint64_t             bytes_ = 0;
+    uint64_t             snapshotBytes_ = 0;
+    uint64_t             records_ = 0;
+};
+
+void AdoptLog(VaultState& s, LogFileWriter& log) {
+    s.fileExists     = true;
+    s.fileVersion    = kVersion;
+    s.header         = std::move(log.GetHeader());
+    s.recordCount    = log.GetRecordCount();
+    s.logBytes       = log.GetBytes();
+    s.compactedBytes = log.GetSnapshotBytes();
+    s.tornTail       = false;
+}
+
+// Synchronous full rewrite of the current state.
+Result CompactLocked(VaultState& s) {
+    std::vector<uint8_t> snapshot = EncodeSnapshot(s.secrets);
+    LogFileWriter log;
+    Result r = log.Begin(s.filePath, s.kdfParams, s.fileKey, snapshot);
+    WipeBytes(snapshot);
+    if (r.IsOk()) r = log.Finish();
+    if (r.IsOk()) AdoptLog(s, log);
+    return r;
+}
+
+// Appends one commit record and flushes it. A vault without a v2 log yet
+// (fresh, or still v1) gets a full rewrite instead; `s.secrets` already
+// holds the committed state at this point.
+Result AppendRecordLocked(VaultState& s, const std::vector<uint8_t>& payload) {
+    if (!s.fileExists || s.fileVersion != kVersion) return CompactLocked(s);
+
+    std::vector<uint8_t> record;
+    if (Result sealed = SealRecord(s.fileKey, s.header, s.recordCount, payload, record);
+        !sealed.IsOk()) {
+        return sealed;
+    }
+    if (s.tornTail) {
+        std::error_code ec;
+        std::filesystem::resize_file(s.filePath, s.logBytes, ec);
+        if (ec) {
+            return Result::Error(ResultCode::IoError,
+                                 "cannot repair vault file: " + s.filePath);
+        }
+        s.tornTail = false;
+    }
+    std::FILE* f = std::fopen(s.filePath.c_str(), "ab");
     if (!f) {
         return Result::Error(ResultCode::IoError,
-                             "cannot write vault file: " + tmpPath);
+                             "cannot write vault file: " + s.filePath);
     }
-    bool wrote =
-        std::fwrite(header.data(), 1, header.size(), f) == header.size() &&
-        std::fwrite(ciphertext.data(), 1, ciphertext.size(), f) ==
-            ciphertext.size();
+    bool wrote = std::fwrite(record.data(), 1, record.size(), f) == record.size();
+    wrote = FlushToDisk(f) && wrote;
     wrote = (std::fclose(f) == 0) && wrote;
-    if (!wrote || std::rename(tmpPath.c_str(), s.filePath.c_str()) != 0) {
-        std::remove(tmpPath.c_str());
+    if (!wrote) {
+        // Whatever reached the file is at most a torn record; cut it off
+        // before the next append.
+        s.tornTail = true;
         return Result::Error(ResultCode::IoError,
                              "cannot update vault file: " + s.filePath);
     }
+    ++s.recordCount;
+    s.logBytes += record.size();
+    if (s.compacting) s.compactDelta.push_back(payload);
+    return Result::Ok();
+}
+
+// Seals the snapshot outside the lock, then appends the commits that
+// arrived meanwhile and swaps the files under it. Only the swap blocks
+// Put / Delete, and its cost is those few commits, not the vault.
+void RunCompaction(std::vector<uint8_t> snapshot, UltraCryptSecureBuffer key,
+                   UltraCryptKdfParams kdf, std::string path) {
+    VaultState& s = State();
+    LogFileWriter log;
+    Result r = log.Begin(path, kdf, key, snapshot);
+    WipeBytes(snapshot);
+
+    std::lock_guard<std::mutex> lock(s.mutex);
+    for (size_t i = 0; r.IsOk() && i < s.compactDelta.size(); ++i) {
+        r = log.Append(key, s.compactDelta[i]);
+    }
+    if (r.IsOk() && s.open && s.filePath == path) r = log.Finish();
+    else log.Abandon();
+    if (r.IsOk() && s.open && s.filePath == path) {
+        AdoptLog(s, log);
+    } else {
+        s.compactedBytes = s.logBytes;      // back off until the log doubles again
+    }
+    for (auto& payload : s.compactDelta) WipeBytes(payload);
+    s.compactDelta.clear();
+    s.compacting = false;
+}
+
+// Starts a background compaction once the log has doubled since the last
+// one. The snapshot is encoded under the lock; sealing and writing it
+// happen on the compactor thread.
+void MaybeCompactLocked(VaultState& s) {
+    if (s.compacting || s.fileVersion != kVersion) return;
+    if (s.logBytes < kCompactMinBytes || s.logBytes < 2 * s.compactedBytes) return;
+    if (s.compactor.joinable()) s.compactor.join();     // finished: compacting is false
+    s.compacting = true;
+    s.compactDelta.clear();
+    s.compactor = std::thread(RunCompaction, EncodeSnapshot(s.secrets),
+                              s.fileKey.Clone(), s.kdfParams, s.filePath);
+}
+
+Result LoadV1Locked(VaultState& s, const std::vector<uint8_t>& raw, Reader& r,
+                    UltraCryptKdfParams& kdf, UltraCryptSecureBuffer& passphrase) {
+    const uint8_t nonceLen = r.U8();
+    UltraCryptAeadParams aead;
+    aead.nonce.resize(nonceLen);
+    r.Take(aead.nonce.data(), nonceLen);
+    if (!r.ok) {
+        return Result::Error(ResultCode::AccessDenied,
+                             "not a readable vault file: " + s.filePath);
+    }
+    const size_t headerSize = raw.size() - r.remaining;
+    aead.associatedData.assign(raw.begin(),
+                               raw.begin() + static_cast<long>(headerSize));
+
+    UltraCryptResult derived =
+        UltraCrypt_DeriveKeyFromPassword(passphrase, kdf, s.fileKey);
+    if (!derived) {
+        return Result::Error(ResultCode::BackendUnavailable,
+                             "key derivation failed: " + derived.message);
+    }
+    UltraCryptSecureBuffer payload;
+    UltraCryptResult opened =
+        UltraCrypt_AeadOpen(s.fileKey, aead, r.p, r.remaining, payload);
+    if (!opened || !DeserializeSecretsV1(payload.Data(), payload.GetSize(), s.secrets)) {
+        s.fileKey.Clear();
+        // Deliberately identical for wrong passphrase and tampered file.
+        return Result::Error(ResultCode::AccessDenied, kOpenFailedMessage);
+    }
+    s.fileVersion = kVersionV1;
+    s.logBytes    = raw.size();
+    return Result::Ok();
+}
+
+Result LoadLogLocked(VaultState& s, const std::vector<uint8_t>& raw, Reader& r,
+                     UltraCryptKdfParams& kdf, UltraCryptSecureBuffer& passphrase) {
+    const uint8_t idLen = r.U8();
+    std::vector<uint8_t> logId(idLen);
+    r.Take(logId.data(), idLen);
+    if (!r.ok || idLen != kLogIdSize) {
+        return Result::Error(ResultCode::AccessDenied,
+                             "not a readable vault file: " + s.filePath);
+    }
+    const size_t headerSize = raw.size() - r.remaining;
+    s.header.assign(raw.begin(), raw.begin() + static_cast<long>(headerSize));
+
+    UltraCryptResult derived =
+        UltraCrypt_DeriveKeyFromPassword(passphrase, kdf, s.fileKey);
+    if (!derived) {
+        return Result::Error(ResultCode::BackendUnavailable,
+                             "key derivation failed: " + derived.message);
+    }
+
+    const size_t nonceSize = UltraCrypt_GetNonceSize(UltraCryptAeadAlgorithm::XChaCha20Poly1305);
+    const size_t tagSize   = UltraCrypt_GetTagSize(UltraCryptAeadAlgorithm::XChaCha20Poly1305);
+    std::map<std::string, StoredSecret> secrets;
+    size_t offset = headerSize;
+    uint64_t index = 0;
+    uint64_t snapshotEnd = 0;
+    while (offset < raw.size()) {
+        const size_t remaining = raw.size() - offset;
+        Reader frame{raw.data() + offset, remaining};
+        const uint32_t length = frame.U32();
+        if (!frame.ok || remaining < 4 + nonceSize + static_cast<size_t>(length)) break;  // torn
+        if (length < tagSize || length > kMaxRecordSize) {
+            // A crash may leave the tail zero-filled; anything else is damage.
+            if (std::all_of(raw.begin() + static_cast<long>(offset), raw.end(),
+                            [](uint8_t b) { return b == 0; })) break;
+            s.fileKey.Clear();
+            return Result::Error(ResultCode::AccessDenied, kOpenFailedMessage);
+        }
+        UltraCryptAeadParams aead;
+        aead.nonce.assign(frame.p, frame.p + nonceSize);
+        aead.associatedData = RecordAad(s.header, index);
+        UltraCryptSecureBuffer payload;
+        UltraCryptResult opened =
+            UltraCrypt_AeadOpen(s.fileKey, aead, frame.p + nonceSize, length, payload);
+        if (!opened || !ApplyRecord(payload.Data(), payload.GetSize(), secrets)) {
+            for (auto& [key, stored] : secrets) WipeSecret(stored);
+            s.fileKey.Clear();
+            // Deliberately identical for wrong passphrase and tampered file.
+            return Result::Error(ResultCode::AccessDenied, kOpenFailedMessage);
+        }
+        offset += 4 + nonceSize + length;
+        if (index == 0) snapshotEnd = offset;
+        ++index;
+    }
+    if (index == 0) {
+        // The snapshot is written through a rename, so it is never torn.
+        s.fileKey.Clear();
+        return Result::Error(ResultCode::AccessDenied,
+                             "not a readable vault file: " + s.filePath);
+    }
+    s.secrets        = std::move(secrets);
+    s.fileVersion    = kVersion;
+    s.recordCount    = index;
+    s.logBytes       = offset;
+    s.compactedBytes = snapshotEnd;
+    s.tornTail       = offset < raw.size();
     return Result::Ok();
 }
 
 Result LoadFileLocked(VaultState& s, UltraCryptSecureBuffer& passphrase) {
+    s.fileExists = false;
+    s.fileVersion = kVersion;
+    s.header.clear();
+    s.recordCount = s.logBytes = s.compactedBytes = 0;
+    s.tornTail = false;
+
+    // A compaction interrupted by a crash leaves its unrenamed new log.
+    std::remove((s.filePath + ".tmp").c_str());
+
     std::FILE* f = std::fopen(s.filePath.c_str(), "rb");
     if (!f) {
         // A missing vault file is a fresh vault: derive with recommended
@@ -245,8 +685,9 @@ Result LoadFileLocked(VaultState& s, UltraCryptSecureBuffer& passphrase) {
 
     Reader r{raw.data(), raw.size()};
     char magic[4] = {};
-    if (!r.Take(magic, 4) || std::memcmp(magic, kMagic, 4) != 0 ||
-        r.U8() != kVersion) {
+    const bool magicOk = r.Take(magic, 4) && std::memcmp(magic, kMagic, 4) == 0;
+    const uint8_t version = r.U8();
+    if (!magicOk || (version != kVersion && version != kVersionV1)) {
         return Result::Error(ResultCode::AccessDenied,
                              "not a readable vault file: " + s.filePath);
     }
@@ -256,42 +697,63 @@ Result LoadFileLocked(VaultState& s, UltraCryptSecureBuffer& passphrase) {
     const uint8_t saltLen = r.U8();
     kdf.salt.resize(saltLen);
     r.Take(kdf.salt.data(), saltLen);
-    const uint8_t nonceLen = r.U8();
-    UltraCryptAeadParams aead;
-    aead.nonce.resize(nonceLen);
-    r.Take(aead.nonce.data(), nonceLen);
-    if (!r.ok) {
-        return Result::Error(ResultCode::AccessDenied,
-                             "not a readable vault file: " + s.filePath);
+
+    Result loaded = version == kVersionV1 ? LoadV1Locked(s, raw, r, kdf, passphrase)
+                                          : LoadLogLocked(s, raw, r, kdf, passphrase);
+    if (!loaded.IsOk()) return loaded;
+    s.kdfParams  = kdf;
+    s.fileExists = true;
+    return Result::Ok();
+}
+
+// Applies a batch to the in-memory map and, for the file backend, appends
+// it as one record. On any failure the map is restored.
+Result CommitLocked(VaultState& s, const std::vector<Batch::Operation>& operations) {
+    for (const auto& op : operations) {
+        if (op.kind == Batch::Operation::Kind::Put && !IsValidKey(op.key)) {
+            return Result::Error(ResultCode::InvalidKey,
+                                 "secret keys are non-empty printable ASCII "
+                                 "without whitespace, e.g. ai.anthropic.api_key");
+        }
     }
-    const size_t headerSize = raw.size() - r.remaining;
-    aead.associatedData.assign(raw.begin(),
-                               raw.begin() + static_cast<long>(headerSize));
 
-    UltraCryptResult derived =
-        UltraCrypt_DeriveKeyFromPassword(passphrase, kdf, s.fileKey);
-    if (!derived) {
-        return Result::Error(ResultCode::BackendUnavailable,
-                             "key derivation failed: " + derived.message);
+    std::vector<std::pair<std::string, std::optional<StoredSecret>>> undo;
+    undo.reserve(operations.size());
+    auto rollback = [&]() {
+        for (auto it = undo.rbegin(); it != undo.rend(); ++it) {
+            if (it->second) s.secrets[it->first] = std::move(*it->second);
+            else            s.secrets.erase(it->first);
+        }
+    };
+    for (const auto& op : operations) {
+        auto it = s.secrets.find(op.key);
+        if (op.kind == Batch::Operation::Kind::Delete && it == s.secrets.end()) {
+            rollback();
+            return Result::Error(ResultCode::NotFound,
+                                 "no secret stored under '" + op.key + "'");
+        }
+        if (it != s.secrets.end()) {
+            undo.emplace_back(op.key, std::move(it->second));
+        } else {
+            undo.emplace_back(op.key, std::nullopt);
+        }
+        if (op.kind == Batch::Operation::Kind::Delete) s.secrets.erase(it);
+        else s.secrets[op.key] = StoredSecret{op.value, op.acl};
     }
 
-    UltraCryptSecureBuffer payload;
-    UltraCryptResult opened =
-        UltraCrypt_AeadOpen(s.fileKey, aead, r.p, r.remaining, payload);
-    if (!opened) {
-        s.fileKey.Clear();
-        // Deliberately identical for wrong passphrase and tampered file.
-        return Result::Error(ResultCode::AccessDenied,
-                             "vault cannot be opened: wrong passphrase or "
-                             "altered file");
+    if (s.backend == Backend::File) {
+        std::vector<uint8_t> payload = EncodeOperations(operations);
+        Result saved = AppendRecordLocked(s, payload);
+        WipeBytes(payload);
+        if (!saved.IsOk()) {
+            rollback();
+            return saved;
+        }
+        MaybeCompactLocked(s);
     }
-    if (!DeserializeSecrets(payload.Data(), payload.GetSize(), s.secrets)) {
-        s.fileKey.Clear();
-        return Result::Error(ResultCode::AccessDenied,
-                             "vault cannot be opened: wrong passphrase or "
-                             "altered file");
+    for (auto& [key, previous] : undo) {
+        if (previous) WipeSecret(*previous);
     }
-    s.kdfParams = kdf;
     return Result::Ok();
 }
 
@@ -369,7 +831,14 @@ Result Initialize() {
 
 void Shutdown() {
     VaultState& s = State();
-    std::lock_guard<std::mutex> lock(s.mutex);
+    std::unique_lock<std::mutex> lock(s.mutex);
+    // A running compaction finishes its swap before the key goes away.
+    if (s.compactor.joinable()) {
+        std::thread running = std::move(s.compactor);
+        lock.unlock();
+        running.join();
+        lock.lock();
+    }
     for (auto& [key, stored] : s.secrets) {
         if (!stored.value.bytes.empty()) {
             UltraCrypt_SecureZero(stored.value.bytes.data(),
@@ -379,6 +848,8 @@ void Shutdown() {
     s.secrets.clear();
     s.fileKey.Clear();
     s.filePath.clear();
+    s.header.clear();
+    s.fileExists = false;
     s.open = false;
 }
 
@@ -400,29 +871,9 @@ std::string GetBackendName() {
 // ==========================================================================
 Result Put(const std::string& key, const SecretValue& value,
            const SecretAcl& acl) {
-    VaultState& s = State();
-    std::lock_guard<std::mutex> lock(s.mutex);
-    if (Result r = RequireOpenLocked(s); !r.IsOk()) return r;
-    if (!IsValidKey(key)) {
-        return Result::Error(ResultCode::InvalidKey,
-                             "secret keys are non-empty printable ASCII "
-                             "without whitespace, e.g. ai.anthropic.api_key");
-    }
-
-    StoredSecret previous;
-    const auto it = s.secrets.find(key);
-    const bool had = it != s.secrets.end();
-    if (had) previous = it->second;
-
-    s.secrets[key] = StoredSecret{value, acl};
-    if (s.backend == Backend::File) {
-        if (Result saved = SaveFileLocked(s); !saved.IsOk()) {
-            if (had) s.secrets[key] = std::move(previous);
-            else     s.secrets.erase(key);
-            return saved;
-        }
-    }
-    return Result::Ok();
+    Batch batch;
+    batch.Put(key, value, acl);
+    return Commit(batch);
 }
 
 Result Get(const std::string& key, SecretValue& outValue) {
@@ -442,27 +893,9 @@ Result Get(const std::string& key, SecretValue& outValue) {
 }
 
 Result Delete(const std::string& key) {
-    VaultState& s = State();
-    std::lock_guard<std::mutex> lock(s.mutex);
-    if (Result r = RequireOpenLocked(s); !r.IsOk()) return r;
-    auto it = s.secrets.find(key);
-    if (it == s.secrets.end()) {
-        return Result::Error(ResultCode::NotFound,
-                             "no secret stored under '" + key + "'");
-    }
-    StoredSecret removed = std::move(it->second);
-    s.secrets.erase(it);
-    if (s.backend == Backend::File) {
-        if (Result saved = SaveFileLocked(s); !saved.IsOk()) {
-            s.secrets.emplace(key, std::move(removed));
-            return saved;
-        }
-    }
-    if (!removed.value.bytes.empty()) {
-        UltraCrypt_SecureZero(removed.value.bytes.data(),
-                              removed.value.bytes.size());
-    }
-    return Result::Ok();
+    Batch batch;
+    batch.Delete(key);
+    return Commit(batch);
 }
 
 std::vector<std::string> List(const std::string& prefix) {
@@ -477,6 +910,66 @@ std::vector<std::string> List(const std::string& prefix) {
     return keys;   // std::map iteration is already sorted
 }
 
+// ==========================================================================
+// Batches
+// ==========================================================================
+Batch::~Batch() {
+    Clear();
+}
+
+void Batch::Put(const std::string& key, const SecretValue& value,
+                const SecretAcl& acl) {
+    Operation op;
+    op.kind  = Operation::Kind::Put;
+    op.key   = key;
+    op.value = value;
+    op.acl   = acl;
+    operations.push_back(std::move(op));
+}
+
+void Batch::Delete(const std::string& key) {
+    Operation op;
+    op.kind = Operation::Kind::Delete;
+    op.key  = key;
+    operations.push_back(std::move(op));
+}
+
+void Batch::Clear() {
+    for (auto& op : operations) {
+        if (!op.value.bytes.empty()) {
+            UltraCrypt_SecureZero(op.value.bytes.data(), op.value.bytes.size());
+        }
+    }
+    operations.clear();
+}
+
+Result Commit(Batch& batch) {
+    VaultState& s = State();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    if (Result r = RequireOpenLocked(s); !r.IsOk()) return r;
+    if (batch.IsEmpty()) return Result::Ok();
+    Result committed = CommitLocked(s, batch.GetOperations());
+    if (committed.IsOk()) batch.Clear();
+    return committed;
+}
+
+Result Compact() {
+    VaultState& s = State();
+    std::unique_lock<std::mutex> lock(s.mutex);
+    if (Result r = RequireOpenLocked(s); !r.IsOk()) return r;
+    if (s.backend != Backend::File) return Result::Ok();
+    // Let a background compaction finish first; both write `<path>.tmp`.
+    if (s.compactor.joinable()) {
+        std::thread running = std::move(s.compactor);
+        lock.unlock();
+        running.join();
+        lock.lock();
+        if (Result r = RequireOpenLocked(s); !r.IsOk()) return r;
+    }
+    if (!s.fileExists) return Result::Ok();     // nothing written yet
+    return CompactLocked(s);
+}
+
 // ==========================================================================
 // Bootstrap / migration — v0.1 stubs
 // ==========================================================================
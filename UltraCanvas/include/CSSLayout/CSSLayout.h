@@ -1,7 +1,7 @@
 // include/CSSLayout/CSSLayout.h
 // CSS-compliant layout engine: type model and Element base class.
-// Version: 4.8.1
-// Last Modified: 2026-06-01
+// Version: 4.9.0
+// Last Modified: 2026-10-18
 // Author: UltraCanvas Framework
 #pragma once
 
@@ -343,6 +343,26 @@ namespace UltraCanvas {
             int  recomputeCount = 0;   // bumps every cache miss; useful for tests/profiling
         };
 
+        class Element;
+
+        // Optional observer of measuring work (profilers). Element::Measure
+        // calls it around every measure that misses the cache, so the probe
+        // sees the real layout cost and nesting. None is installed by default;
+        // the Measure hot path then costs one pointer load.
+        class LayoutProbe {
+        public:
+            virtual ~LayoutProbe() = default;
+            // Return false to skip the matching EndMeasure.
+            virtual bool BeginMeasure(const Element& element) = 0;
+            virtual void EndMeasure(const Element& element) = 0;
+
+            static void Install(LayoutProbe* probe) { installed = probe; }
+            static LayoutProbe* Installed() { return installed; }
+
+        private:
+            static inline LayoutProbe* installed = nullptr;
+        };
+
         class Element {
         public:
             // identity
@@ -1,7 +1,7 @@
 // include/Plugins/Diagrams/UltraCanvasDiagramRouting.h
 // Shared orthogonal connection routing for the diagram family
-// Version: 1.0.0
-// Last Modified: 2026-07-30
+// Version: 1.1.0
+// Last Modified: 2026-10-18
 // Author: UltraCanvas Framework
 //
 // This header is the single home of the obstacle-aware orthogonal router that
@@ -15,6 +15,23 @@
 // into a list of DiagramObstacle rectangles and pre-filter the ones a path is
 // allowed to touch (normally the source and target nodes themselves).
 //
+// CHANGELOG 1.1.0:
+//  - NEW: Batch routing. DiagramObstacleIndex rasterises an obstacle list onto
+//         the A* grid once (a per-cell coverage count) and buckets it for the
+//         segment test, so routing N connections no longer re-tests every
+//         obstacle for every cell of every search. Connections name the
+//         obstacles they may pass through by index instead of receiving a
+//         filtered copy of the list. RouteBatch() routes a connection list on
+//         worker threads against one shared index.
+//  - NEW: DiagramBatchRouter keeps the index and the routed paths between
+//         calls. MoveObstacle() updates only the cells under the old and new
+//         rectangle, and the next Route() only re-routes the connections
+//         whose corridor (path bounding box plus a cell of slack) touches a
+//         moved obstacle, or whose endpoints changed.
+//  - The indexed entry points return exactly what ComputeOrthogonalPath()
+//    returns for the same obstacles with the excluded ones removed; A* now
+//    runs in one shared search routine for both.
+//
 // CHANGELOG 1.0.0:
 //  - Extracted from UltraCanvasFlowChart.cpp:
 //        ComputeCardinalPath, PathHasObstacles, RouteAStar,
@@ -51,6 +68,8 @@
 #pragma once
 
 #include "UltraCanvasCommonTypes.h"
+#include <cstdint>
+#include <unordered_map>
 #include <vector>
 
 namespace UltraCanvas {
@@ -98,6 +117,78 @@ struct DiagramRoutingOptions {
     double obstaclePaddingCells = 0.5;
 };
 
+// One connection of a batch. The obstacle indices name the boxes the path may
+// pass through - normally its own source and target - in the obstacle list the
+// index was built from; -1 means none.
+struct DiagramRouteRequest {
+    Point2Dd start;
+    Point2Dd end;
+    DiagramCardinalSide sourceSide = DiagramCardinalSide::Right;
+    DiagramCardinalSide targetSide = DiagramCardinalSide::Left;
+    int sourceObstacle = -1;
+    int targetObstacle = -1;
+};
+
+// =============================================================================
+// OBSTACLE INDEX
+// =============================================================================
+
+// An obstacle list prepared for routing many connections against it:
+//  * every cell of the A* grid stores how many padded obstacles cover its
+//    centre, so a blocked-cell test is one lookup plus at most two rectangle
+//    tests for the excluded source/target;
+//  * obstacles are bucketed on a coarse grid, so the cardinal-path collision
+//    test only looks at the obstacles along each segment.
+// Cell tests use exactly RouteAStar's predicate, so an indexed search finds
+// the same path as RouteAStar over the filtered list.
+//
+// Memory is 4 bytes per grid cell of the routing area. Queries are const and
+// may run concurrently; Build and UpdateObstacle may not overlap them.
+class DiagramObstacleIndex {
+public:
+    DiagramObstacleIndex() = default;
+    DiagramObstacleIndex(const std::vector<DiagramObstacle>& obstacles,
+                         const DiagramRoutingOptions& options) {
+        Build(obstacles, options);
+    }
+
+    void Build(const std::vector<DiagramObstacle>& obstacles,
+               const DiagramRoutingOptions& options);
+
+    // Moves obstacle `index` to `bounds`, touching only the cells and buckets
+    // under the old and the new rectangle.
+    void UpdateObstacle(size_t index, const Rect2Dd& bounds);
+
+    const DiagramRoutingOptions& Options() const { return options; }
+    const std::vector<DiagramObstacle>& Obstacles() const { return obstacles; }
+    int GridWidth() const { return gridW; }
+    int GridHeight() const { return gridH; }
+
+    // A* cell test: outside the routing area, or covered by an obstacle other
+    // than `excludeA` / `excludeB`.
+    bool IsCellBlocked(int cx, int cy, int excludeA = -1, int excludeB = -1) const;
+
+    // PathHasObstacles over the indexed list, skipping the excluded obstacles.
+    bool PathHasObstacles(const std::vector<Point2Dd>& path,
+                          int excludeA = -1, int excludeB = -1) const;
+
+private:
+    bool CoversCell(int obstacle, int cx, int cy) const;
+    void Rasterize(size_t index, int delta);
+    void Bucket(size_t index, bool add);
+
+    DiagramRoutingOptions options;
+    std::vector<DiagramObstacle> obstacles;
+    double gridSize = 20.0;
+    double pad = 0.0;
+    int gridW = 0;
+    int gridH = 0;
+    std::vector<uint32_t> coverage;     // gridW * gridH, row-major
+
+    double bucketSize = 160.0;
+    std::unordered_map<uint64_t, std::vector<uint32_t>> buckets;
+};
+
 // =============================================================================
 // ROUTER
 // =============================================================================
@@ -157,6 +248,24 @@ public:
         const std::vector<DiagramObstacle>& obstacles,
         const DiagramRoutingOptions& options);
 
+    // -------------------------------------------------------------------------
+    // Indexed / batch routing (NEW in 1.1.0)
+    // -------------------------------------------------------------------------
+
+    // ComputeOrthogonalPath / RouteAStar against a prepared index, with the
+    // routing options taken from the index.
+    static std::vector<Point2Dd> ComputeOrthogonalPath(
+        const DiagramRouteRequest& request, const DiagramObstacleIndex& index);
+    static std::vector<Point2Dd> RouteAStar(
+        const DiagramRouteRequest& request, const DiagramObstacleIndex& index);
+
+    // Routes every request against one index. `threads` 0 uses the hardware
+    // concurrency; 1 routes on the calling thread. Result i belongs to
+    // request i and does not depend on the thread count.
+    static std::vector<std::vector<Point2Dd>> RouteBatch(
+        const std::vector<DiagramRouteRequest>& requests,
+        const DiagramObstacleIndex& index, int threads = 0);
+
     // -------------------------------------------------------------------------
     // Geometry helpers
     // -------------------------------------------------------------------------
@@ -204,4 +313,57 @@ public:
                                                 double spreadFraction = 0.6);
 };
 
+// =============================================================================
+// INCREMENTAL BATCH ROUTER (NEW in 1.1.0)
+// =============================================================================
+
+// Keeps an obstacle index and the routed path of every connection between
+// calls, for components that re-route on every edit. Typical drag loop:
+//
+//     router.MoveObstacle(nodeIndex, newBounds);
+//     router.SetConnection(i, request);      // for each edge of that node
+//     router.Route();                        // re-routes only what changed
+//
+// A connection is re-routed when it was set or replaced since the last
+// Route(), when it attaches to a moved obstacle, or when its corridor - the
+// bounding box of its current path plus one grid cell - intersects a moved
+// obstacle's old or new rectangle. A path far from every moved obstacle keeps
+// its route even if the move opened up a slightly shorter one.
+class DiagramBatchRouter {
+public:
+    explicit DiagramBatchRouter(const DiagramRoutingOptions& options = DiagramRoutingOptions());
+
+    // Both rebuild the index and mark every connection for re-routing.
+    void SetOptions(const DiagramRoutingOptions& options);
+    void SetObstacles(const std::vector<DiagramObstacle>& obstacles);
+    void MoveObstacle(size_t index, const Rect2Dd& bounds);
+
+    void SetConnections(const std::vector<DiagramRouteRequest>& requests);
+    void SetConnection(size_t index, const DiagramRouteRequest& request);
+    size_t ConnectionCount() const { return requests.size(); }
+
+    // Routes the pending connections; returns how many were routed.
+    size_t Route(int threads = 0);
+
+    const std::vector<Point2Dd>& GetPath(size_t index) const { return paths[index]; }
+    const std::vector<std::vector<Point2Dd>>& GetPaths() const { return paths; }
+    const DiagramObstacleIndex& GetIndex() const { return index; }
+
+private:
+    Rect2Dd CorridorOf(const std::vector<Point2Dd>& path) const;
+
+    DiagramRoutingOptions options;
+    std::vector<DiagramObstacle> obstacles;
+    DiagramObstacleIndex index;
+
+    std::vector<DiagramRouteRequest> requests;
+    std::vector<std::vector<Point2Dd>> paths;
+    std::vector<Rect2Dd> corridors;
+    std::vector<uint8_t> pending;
+
+    std::vector<Rect2Dd> movedRegions;          // Since the last Route()
+    std::vector<uint8_t> movedObstacles;        // Per obstacle, same window
+    bool allPending = true;
+};
+
 } // namespace UltraCanvas
@@ -10,9 +10,17 @@
 //
 // Namespace: UltraCanvas
 // Base class: UltraCanvasUIElement
-// Version: 1.0.0
-// Last Modified: 2026-07-30
+// Version: 1.1.0
+// Last Modified: 2026-10-18
 // Author: UltraCanvas Framework
+//
+// CHANGELOG
+// 1.1.0 (2026-10-18)
+//   - SetAsyncLoading(): data-source chunks are fetched on a worker thread
+//     and appended on the UI thread, so walking a large repository never
+//     stalls a frame (IsLoadingCommits)
+//   - Data-source histories are laid out incrementally: each loaded chunk
+//     extends the lane layout instead of re-laying out every commit
 
 #pragma once
 
@@ -20,9 +28,11 @@
 #include "Plugins/Diagrams/UltraCanvasGitGraphLayout.h"
 #include "Plugins/Diagrams/UltraCanvasGitGraphTypes.h"
 
+#include <atomic>
 #include <functional>
 #include <memory>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
@@ -31,6 +41,7 @@ namespace UltraCanvas {
 class UltraCanvasGitGraph : public UltraCanvasUIElement {
 public:
     UltraCanvasGitGraph(const std::string& id, float x, float y, float w, float h);
+    ~UltraCanvasGitGraph() override;
 
     bool AcceptsFocus() const override { return true; }
 
@@ -74,6 +85,15 @@ public:
     bool   HasMoreCommits() const { return dataSource && !dataSourceExhausted; }
     bool   LoadMoreCommits();               // Fetch one more chunk on demand
     void   SetPrefetchRows(int rows);       // How close to the end triggers a fetch
+
+    // Fetch chunks on a worker thread and append them on the UI thread when
+    // they arrive; LoadMoreCommits() then returns false and the graph grows a
+    // frame or two later. Needs a running application - without one loading
+    // stays synchronous. The source is only ever called from one thread at a
+    // time.
+    void SetAsyncLoading(bool async) { asyncLoading = async; }
+    bool GetAsyncLoading() const { return asyncLoading; }
+    bool IsLoadingCommits() const { return fetchRunning; }
     std::function<void(size_t, size_t)> onChunkLoaded;   // (loaded, total or 0)
 
     const std::vector<GitGraphCommit>& GetCommits() const { return commits; }
@@ -304,6 +324,14 @@ private:
     bool   dataSourceExhausted = false;
     size_t chunkSize    = 500;
     int    prefetchRows = 40;
+
+    // Background fetch (SetAsyncLoading). The generation drops chunks fetched
+    // for a source or a history that has since been replaced.
+    bool        asyncLoading = false;
+    bool        fetchRunning = false;
+    uint64_t    fetchGeneration = 0;
+    std::thread fetchThread;
+    std::shared_ptr<std::atomic<bool>> alive = std::make_shared<std::atomic<bool>>(true);
     mutable std::string lastError;
 
     std::vector<GitGraphCommit>    commits;
@@ -315,6 +343,11 @@ private:
     GitGraphLayoutOptions   layoutOptions;
     GitGraphLayoutResult    layout;
     UltraCanvasGitGraphLayout layoutEngine;
+
+    // Lane layout carried over between data-source chunks. Valid while the
+    // commit list has only grown at the tail since `layout` was produced by it.
+    UltraCanvasGitGraphIncrementalLayout incrementalLayout;
+    bool incrementalLayoutValid = false;
     GitGraphOrientation     orientation = GitGraphOrientation::BottomToTop;
     bool rowsAreNewestFirst = true;
     bool needsLayout        = true;
@@ -459,6 +492,11 @@ private:
     bool HandleDoubleClick(const UCEvent& event);
     bool HandleKeyDown(const UCEvent& event);
 
+    // ===== LAZY LOADING =====
+    void StartBackgroundFetch();
+    void CancelBackgroundFetch();
+    bool AcceptChunk(const std::vector<GitGraphCommit>& chunk, size_t requested);
+
     // ===== HELPERS =====
     void RebuildCommitIndex();
     void ApplyThemeColors(GitGraphTheme theme);
@@ -4,9 +4,15 @@
 // space - no render context, no fonts, no window - so it can be unit-tested
 // on its own (see Tests/GitGraphLayoutTest.cpp).
 //
-// Version: 1.0.0
-// Last Modified: 2026-07-30
+// Version: 1.1.0
+// Last Modified: 2026-10-18
 // Author: UltraCanvas Framework
+//
+// CHANGELOG
+// 1.1.0 (2026-10-18)
+//   - Lane sweep works on integer parent indices instead of sha lookups
+//   - UltraCanvasGitGraphIncrementalLayout: extends a lane layout page by page
+//     as a lazily walked history grows, without revisiting earlier rows
 
 #pragma once
 
@@ -163,9 +169,13 @@ public:
 private:
     GitGraphLayoutOptions options;
 
+    // Parent lists resolved to commit indices once per Compute() (CSR layout;
+    // -1 for a parent outside the list).
+    struct ParentTable;
+
     void AssignLanes(const std::vector<GitGraphCommit>& commits,
                      const std::vector<size_t>& order,
-                     const std::unordered_map<std::string, size_t>& bySha,
+                     const ParentTable& parents,
                      const std::vector<bool>& onTrunk,
                      GitGraphLayoutResult& result) const;
 
@@ -202,4 +212,81 @@ private:
                            GitGraphLayoutResult& result) const;
 };
 
+// Lane layout for a history that only ever grows at the tail - the pages a
+// data source hands out as the user scrolls. The lane table, the trunk cursor
+// and the parents still being waited for are kept between calls, so each
+// Append() costs O(page) instead of re-laying out the whole history.
+//
+// Covers the append-only subset of the options (see Supports()). Within it the
+// result matches Compute() over the same commits, with two differences a
+// truncated history forces:
+//   - A parent that has not been loaded yet keeps its lane open and its child
+//     marked boundary; both resolve when the parent arrives.
+//   - The trunk is pinned only through a trunk branch ref (no branch-name
+//     fallback), and a branch is only known to fork from the trunk once its
+//     fork point has been loaded, so its lane runs on until then.
+class UltraCanvasGitGraphIncrementalLayout {
+public:
+    // AsGiven order, Lanes mode, and none of the passes that need the whole
+    // history (filtering, collapsing, parallel rows, column reordering).
+    static bool Supports(const GitGraphLayoutOptions& options);
+
+    // Starts a new layout. Keep the result passed to Append() empty as well.
+    void Reset(const GitGraphLayoutOptions& options, const std::vector<GitGraphRef>& refs);
+
+    // True when a layout started with `options` and `refs` would pin the same
+    // trunk and allocate lanes the same way - i.e. Append() may carry on.
+    bool IsCompatible(const GitGraphLayoutOptions& options,
+                      const std::vector<GitGraphRef>& refs) const;
+
+    // Lays out commits[first..] as the next rows of `result`, which must hold
+    // exactly the rows placed since Reset(). Earlier rows are only touched to
+    // attach edges to parents that arrive in this page.
+    void Append(const std::vector<GitGraphCommit>& commits, size_t first,
+                GitGraphLayoutResult& result);
+
+    size_t GetPlacedCount() const { return placedCount; }
+    size_t GetOpenLaneCount() const;
+    size_t GetAwaitedCount() const { return awaited.size(); }
+
+private:
+    struct Slot {
+        bool    active   = false;
+        bool    reserved = false;
+        int64_t expecting = 0;          // Row if placed, else a negative awaited id
+    };
+
+    // An edge whose parent end is not placed yet.
+    struct PendingEdge {
+        int  childRow    = 0;
+        int  parentIndex = 0;           // Position in the child's parent list
+        bool cherryPick  = false;
+    };
+
+    // A commit referenced by a placed child but not loaded yet. `lanes` lists
+    // the lanes set to wait for it (possibly stale - re-checked on use).
+    struct Awaited {
+        int64_t id = 0;
+        std::vector<PendingEdge> edges;
+        std::vector<int> lanes;
+    };
+
+    // The awaited entry for `sha`, created on first sight; nullptr when the
+    // commit is already placed.
+    Awaited* Await(const std::string& sha, const GitGraphLayoutResult& result);
+    void Expect(int lane, Awaited& parent);
+    std::vector<int> LanesWaitingFor(const Awaited& commit) const;
+
+    GitGraphLayoutOptions options;
+    std::string trunkTip;
+    std::string trunkNext;              // Next first-parent commit on the trunk
+    bool        trunkPinned = false;
+
+    std::vector<Slot> lanes;
+    std::unordered_map<std::string, Awaited> awaited;
+    std::unordered_map<int, int> missingParents;     // Row -> parents not yet placed
+    int64_t nextAwaitedId = -1;
+    size_t  placedCount = 0;
+};
+
 } // namespace UltraCanvas
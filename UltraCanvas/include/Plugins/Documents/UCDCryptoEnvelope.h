@@ -29,12 +29,26 @@
 // caller's own header bytes, so tampering with the declared costs, the salt or
 // the nonce is detected rather than obeyed.
 //
-// Version: 0.1.0
+// Streaming envelope (version 2), for documents too large to hold in memory
+// twice. Same first 32 bytes with version 2, then an UltraCrypt AEAD stream
+// (see UltraCrypt_AeadSealStream) in place of nonce and ciphertext:
+//
+//   offset size field
+//   0      32   as above, version byte = 2
+//   32     ...  UltraCrypt stream: its own header, then 64 KiB chunks
+//
+// The 32-byte envelope header plus the caller's header bytes are the
+// stream's associated data, so they are authenticated with every chunk.
+// Open() accepts both versions; Seal() keeps writing version 1.
+//
+// Version: 0.2.0
 // Author: UltraCanvas Framework / ULTRA OS
 #pragma once
 #ifndef UCDCRYPTOENVELOPE_H
 #define UCDCRYPTOENVELOPE_H
 
+#include "UltraCrypt/UltraCryptCore.h"
+
 #include <cstddef>
 #include <cstdint>
 #include <string>
@@ -67,6 +81,28 @@ bool Open(const std::vector<uint8_t>& envelope,
           std::vector<uint8_t>& output,
           std::string& error);
 
+// Size of the version 2 header that precedes the UltraCrypt stream.
+size_t GetStreamEnvelopeHeaderSize();
+
+// Streaming Seal: pulls the plaintext from `read` and pushes a version 2
+// envelope to `write`, chunk by chunk on a worker pool, never holding more
+// than a few chunks. Same password and associated-data rules as Seal.
+bool SealStream(const UltraCryptStreamReader& read,
+                const UltraCryptStreamWriter& write,
+                const std::string& password,
+                const std::vector<uint8_t>& associatedData,
+                std::string& error);
+
+// Streaming Open of a version 2 envelope. `write` receives verified
+// plaintext in order, but the envelope is only known to be intact — not
+// truncated or altered further on — when this returns true: on false, discard
+// everything written.
+bool OpenStream(const UltraCryptStreamReader& read,
+                const UltraCryptStreamWriter& write,
+                const std::string& password,
+                const std::vector<uint8_t>& associatedData,
+                std::string& error);
+
 } // namespace UCDCrypto
 } // namespace UltraCanvas
 
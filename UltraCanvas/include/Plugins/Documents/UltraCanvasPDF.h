@@ -1,8 +1,8 @@
 // include/Plugins/Documents/UltraCanvasPDF.h
 // PDF document interface — read, write, page operations, content editing.
 // Backed by MuPDF when ULTRACANVAS_PLUGIN_PDF is enabled.
-// Version: 1.1.0
-// Last Modified: 2026-06-19
+// Version: 1.2.0
+// Last Modified: 2026-10-18
 // Author: UltraCanvas Framework
 #pragma once
 #ifndef ULTRACANVAS_PDF_H
@@ -157,6 +157,8 @@ public:
     virtual PDFPageInfo     GetPageInfo(int pageNumber) const = 0;
 
     // ----- Rendering -----
+    // Both may be called from a background thread while the UI thread uses
+    // the rest of the interface (UltraCanvasPDFView renders pages off-thread).
     virtual PDFRenderedPage RenderPage(int pageNumber,
                                        const PDFRenderSettings& settings) = 0;
     virtual PDFRenderedPage RenderThumbnail(int pageNumber, int maxDim) = 0;
@@ -1,8 +1,8 @@
 // include/Plugins/Documents/UltraCanvasPDFView.h
 // UI element that displays a PDF document with a thumbnail strip,
 // scrollable page render, and search-hit overlay.
-// Version: 1.7.0
-// Last Modified: 2026-08-13
+// Version: 1.8.0
+// Last Modified: 2026-10-18
 // Author: UltraCanvas Framework
 #pragma once
 #ifndef ULTRACANVAS_PDF_VIEW_H
@@ -13,6 +13,7 @@
 #include "UltraCanvasImage.h"
 #include "Plugins/Documents/UltraCanvasPDF.h"
 
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <string>
@@ -209,7 +210,7 @@ private:
     int     ThumbSlotAdvance() const;
     Rect2Df ComputePageDrawRect(int pageW, int pageH,
                                 const Rect2Di& contentArea) const;
-    void   InvalidateCaches();      // page pixmaps only (zoom/viewport changes)
+    void   InvalidateCaches();      // scale may have changed (zoom/viewport): drop queued renders
     void   InvalidateAllCaches();   // pages + thumbnails (document changed)
     void   FireDocumentChanged();
     void   FirePageChanged();
@@ -225,9 +226,19 @@ private:
     // Effective scale (1.0 == actual size) that fits the page into contentW/H.
     // widthOnly fits to width; otherwise fits the whole page.
     float  ComputeFitScale(int contentW, int contentH, bool widthOnly) const;
-    std::shared_ptr<UCPixmapCairo> EnsurePageRendered(int page, float dpi);
+    // Pixmap to draw for `page` at `dpi`: the rendering at that dpi when it
+    // is cached (`exact`; null if the render failed), otherwise the page's
+    // last rendering at another dpi (or null) while the wanted one renders
+    // in the background.
+    std::shared_ptr<UCPixmapCairo> PageForDisplay(int page, float dpi, bool& exact);
+    // Queue background renders at `dpi`: the current page, then its
+    // neighbours (prefetch). Replaces whatever was still queued.
+    void   RequestPageRenders(float dpi);
+    void   OnPageRendered(int page, int dpiKey, uint64_t generation,
+                          std::shared_ptr<UCPixmapCairo> pixmap);
     std::shared_ptr<UCPixmapCairo> EnsureThumbnail(int page);
-    std::shared_ptr<UCPixmapCairo> MakePixmapFromRGBA(const PDFRenderedPage&);
+    // Thread-safe: also used by the background renderer.
+    static std::shared_ptr<UCPixmapCairo> MakePixmapFromRGBA(const PDFRenderedPage&);
     void   DrawThumbStrip(IRenderContext* ctx, const Rect2Di& strip);
     void   DrawPageWithOverlays(IRenderContext* ctx, const Rect2Di& contentArea);
     int    HitTestThumb(const Point2Di& p) const;  // returns 1-based page or 0
@@ -245,7 +256,9 @@ private:
     void   Repaint();
 
 private:
-    std::unique_ptr<IPDFDocument> doc_;
+    // Shared with queued background renders, so replacing the document never
+    // pulls it from under a render in progress.
+    std::shared_ptr<IPDFDocument> doc_;
     PDFViewStyle style_;
 
     int      currentPage_ = 1;
@@ -284,11 +297,22 @@ private:
     std::vector<CharLine>    pageLines_;   // line ranges over pageChars_
     int       pageCharsPage_ = -1;
 
-    // pageNumber → rendered pixmap. Keyed plain by page; on zoom/size change
-    // we wipe the cache.
-    std::unordered_map<int, std::shared_ptr<UCPixmapCairo>> pageCache_;
+    // pageNumber → its most recent rendering. A zoom change keeps it: until
+    // the page renders at the new dpi it is drawn scaled. Only pages around
+    // the current one are kept.
+    struct CachedPage {
+        std::shared_ptr<UCPixmapCairo> pixmap;
+        int dpiKey = 0;         // dpi * 100 of `pixmap`
+        int failedDpiKey = 0;   // dpi whose render failed (0 = none)
+    };
+    std::unordered_map<int, CachedPage> pageCache_;
     std::unordered_map<int, std::shared_ptr<UCPixmapCairo>> thumbCache_;
-    int     pageCacheDpiKey_ = 0;  // 0 = invalid
+    // Bumped when cached and in-flight renderings stop matching the document.
+    uint64_t renderGeneration_ = 0;
+    // Worker thread + job queue (defined in the .cpp); shared with the
+    // worker's UI-thread deliveries, which check it still has an owner.
+    struct PageRenderQueue;
+    std::shared_ptr<PageRenderQueue> renderQueue_;
 
     // pan / drag-thumb state
     bool    panning_ = false;
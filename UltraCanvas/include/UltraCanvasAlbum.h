@@ -2,8 +2,10 @@
 // Photo / video / music album widget: a self-rendered media grid with selectable
 // layout designs, per-item crop / zoom / stretch fitting, action icons and
 // visitor / user-edit / admin modes. A companion to UltraCanvasSlideshow.
-// Version: 1.7.0
-// Last Modified: 2026-08-11
+// Version: 1.8.0
+// Last Modified: 2026-10-18
+// V1.8.0: Extracted poster frames persist across launches in the shared XDG
+//   thumbnail cache (AlbumConfig::persistentVideoPosters, on by default).
 // V1.7.0: Automatic video poster frames (AlbumConfig::videoPosterFrames, on by
 //   default) — a Video item with no thumbnailPath now has its cover extracted
 //   from the clip itself on a background thread and cached in memory, so video
@@ -333,6 +335,12 @@ namespace UltraCanvas {
         int   videoPosterMaxSize = 640;    // longest edge of the cached frame, px
         float videoPosterTimeSec = -1.0f;  // where to grab; <0 = auto (~10% in,
                                            // capped at 1s, to skip a black intro)
+        // Auto-positioned poster frames are also kept in the shared XDG
+        // thumbnail cache (~/.cache/thumbnails, see UltraCanvasThumbnailStore.h)
+        // and read back from it first, so a relaunch shows the covers without
+        // decoding a single clip. A fixed videoPosterTimeSec bypasses it: the
+        // cache holds one frame per file.
+        bool  persistentVideoPosters = true;
     };
 
     // ===== THE ALBUM ELEMENT =====
@@ -483,6 +491,7 @@ namespace UltraCanvas {
             std::string path;
             int   maxSize = 640;    // config snapshot: the worker must not read
             float timeSec = -1.0f;  // config, which the UI thread may replace
+            bool  persistent = true;
         };
         mutable std::unordered_map<std::string, PosterSlot> posterSlots;
         mutable std::deque<PosterRequest> posterQueue;
@@ -510,6 +519,9 @@ namespace UltraCanvas {
         void StopPosterWorker();
         void DropVideoPosters();                // on a wholesale item change
         void PosterWorkerMain() const;
+        // Worker side of one request: the persistent store first, else the
+        // clip itself (storing the frame for the next launch).
+        std::shared_ptr<UCPixmap> ProducePosterPixmap(const PosterRequest& req) const;
         void PostPosterRedraw() const;          // coalesced reflow + repaint
 
         // Which action icon the cursor currently sits on, so a tooltip is shown
@@ -1,7 +1,7 @@
 // include/UltraCanvasBaseApplication.h
 // Main UltraCanvas Framework Entry Point - Unified System
-// Version: 1.6.0
-// Last Modified: 2026-08-03
+// Version: 1.7.0
+// Last Modified: 2026-10-18
 // Author: UltraCanvas Framework
 #pragma once
 
@@ -66,6 +66,23 @@ namespace UltraCanvas {
     enum class FdWatchType { Read, Write };
     using FdWatchId = std::uint64_t;
 
+    // ===== FRAME STATISTICS =====
+    // Counters kept by the event loop's frame scheduler (see
+    // UltraCanvasApplicationBase::SetFramePacing).
+    struct UCFrameStats {
+        uint64_t frames = 0;                // passes that drew at least one window
+        uint64_t droppedFrames = 0;         // refresh intervals missed by over-long frames
+        uint64_t deferredWindows = 0;       // window repaints pushed to the next frame
+        uint64_t deferredTasks = 0;         // PostToUIThread tasks pushed to the next frame
+        uint64_t coalescedEvents = 0;       // moves / resizes merged into a later one
+        double lastFrameMs = 0;
+        double avgFrameMs = 0;              // moving average
+        double maxFrameMs = 0;
+        double lastInputLatencyMs = 0;      // oldest input of a frame -> frame on screen
+        double avgInputLatencyMs = 0;
+        double maxInputLatencyMs = 0;
+    };
+
     class UltraCanvasApplicationBase {
     friend UltraCanvasWindowBase;
     protected:
@@ -78,11 +95,26 @@ namespace UltraCanvas {
         std::mutex eventQueueMutex;
         std::condition_variable eventCondition;
 
-        // Timer system
-        std::vector<UltraCanvasTimer> timers_;
+        // Timer system (deadline heap; see UltraCanvasTimerQueue)
+        UltraCanvasTimerQueue timers_;
         mutable std::mutex timersMutex_;
         TimerId nextTimerId_ = 1;
 
+        // Frame scheduler (see SetFramePacing)
+        bool framePacing_ = false;
+        bool frameBudgetAuto_ = true;
+        bool eventCoalescing_ = true;
+        bool framePending_ = false;         // a paced frame was skipped; render when due
+        std::chrono::nanoseconds frameInterval_{16'666'667};
+        std::chrono::microseconds frameBudget_{12'500};
+        std::chrono::steady_clock::time_point nextFrameTime_{};
+        // Posted tasks stop here and continue next frame (max = no budget).
+        std::chrono::steady_clock::time_point workDeadline_ = std::chrono::steady_clock::time_point::max();
+        // Oldest input event dispatched since the last frame (latency counter).
+        std::chrono::steady_clock::time_point pendingInputSince_ = std::chrono::steady_clock::time_point::max();
+        size_t renderCursor_ = 0;
+        UCFrameStats frameStats_;
+
         // PostToUIThread queue. Background threads push functions here and
         // call WakeUpEventLoop(); the main loop drains them via
         // ProcessPostedTasks() each iteration.
@@ -201,6 +233,34 @@ namespace UltraCanvas {
         TimerId StartTimer(unsigned int milliseconds_interval, bool periodic,
                            std::function<void(TimerId)> callback = nullptr);
         void StopTimer(TimerId id);
+        // Timers due within this many milliseconds of a loop wake-up fire on
+        // that wake-up instead of waking the loop again (default 1).
+        void SetTimerCoalescingSlack(unsigned int milliseconds);
+
+        // ===== FRAME PACING =====
+        // With pacing on, RunOnce repaints at most once per display refresh
+        // interval: events, timers and posted tasks are still handled as they
+        // arrive, but the windows are rendered when the next frame is due, so a
+        // burst of pointer moves costs one repaint per frame instead of one per
+        // event. Within a frame, work past the budget (posted tasks, further
+        // windows) is deferred to the next frame. The Linux backend turns
+        // pacing on at the monitor's refresh rate; elsewhere it is off.
+        void SetFramePacing(bool enabled);
+        bool GetFramePacing() const { return framePacing_; }
+        void SetFrameRate(double hz);
+        double GetFrameRate() const;
+        // Time per frame for posted tasks + rendering. Zero restores the
+        // default of three quarters of the refresh interval.
+        void SetFrameBudget(std::chrono::microseconds budget);
+        std::chrono::microseconds GetFrameBudget() const { return frameBudget_; }
+        UCFrameStats GetFrameStats() const { return frameStats_; }
+        void ResetFrameStats() { frameStats_ = UCFrameStats(); }
+        // Merge consecutive mouse moves and resizes of one window into a
+        // single queued event (on by default; used by backends that queue
+        // through PushEventCoalesced). Wheel events are always delivered
+        // one by one.
+        void SetEventCoalescing(bool enabled) { eventCoalescing_ = enabled; }
+        bool GetEventCoalescing() const { return eventCoalescing_; }
 
         // Watch `fd` for readability/writability from within the event loop. The
         // callback runs on the UI thread on each iteration the fd is ready. Returns
@@ -322,6 +382,16 @@ namespace UltraCanvas {
         // Timer processing - called from Run() each iteration
         void ProcessTimers();
         std::chrono::milliseconds GetTimeUntilNextTimer() const;
+        // How long the platform loop may block: until the next timer or paced
+        // frame, or zero while events or deferred tasks are already queued.
+        std::chrono::milliseconds GetEventLoopTimeout();
+
+        // PushEvent for the platform loop (UI thread): merges `event` into the
+        // last queued event when SetEventCoalescing allows it.
+        void PushEventCoalesced(const UCEvent& event);
+
+        // Renders the visible windows as one frame and updates the frame stats.
+        void RenderFrame(std::chrono::steady_clock::time_point frameStart);
 
         // Drains and runs anything PostToUIThread enqueued. Called from
         // Run() right after ProcessTimers().
@@ -0,0 +1,382 @@
+// include/UltraCanvasDecodeScheduler.h
+// Prioritized, de-duplicating job queue with a small worker pool: the
+// scheduling core of UCImageDecodeService, kept free of any image or
+// application type so it can be tested with a stub decode.
+// Version: 1.0.0
+// Last Modified: 2026-10-18
+// Author: UltraCanvas Framework
+#pragma once
+#ifndef ULTRACANVASDECODESCHEDULER_H
+#define ULTRACANVASDECODESCHEDULER_H
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace UltraCanvas {
+
+    // ===== DECODE SCHEDULER =====
+    // Jobs are keyed: a Submit whose key is already queued or running joins
+    // that job, and every requester gets its own callback with the one
+    // result. Jobs naming the same resource never run on two workers at once.
+    //
+    // Order: the lowest priority class first; within a class the job whose
+    // requester submitted or drew (Touch) most recently, ties FIFO.
+    //
+    // Cancellation is explicit. Cancel(ticket) forgets one request; a job
+    // with no requesters left is dropped before it runs. A request may carry
+    // an on-screen check: CancelOffscreen(), called on the UI thread after
+    // each rendered frame, asks every queued request's check and cancels the
+    // ones that answer false, handing them the cancelled result. Nothing is
+    // ever inferred from how long ago a requester drew.
+    //
+    // Results go through the poster given to the constructor (the UI thread
+    // for the image service); a null poster runs callbacks on the worker.
+    template <class Result>
+    class UCDecodeScheduler {
+    public:
+        using Ticket = uint64_t;
+        static constexpr Ticket InvalidTicket = 0;
+
+        using Work = std::function<Result()>;             // runs on a worker
+        using Callback = std::function<void(const Result&)>;
+        using OnScreenCheck = std::function<bool()>;      // UI thread
+        using Poster = std::function<void(std::function<void()>)>;
+        using SuccessTest = std::function<bool(const Result&)>;
+
+        struct Stats {
+            uint64_t requested = 0;     // Submit calls
+            uint64_t shared = 0;        // joined an already queued/running job
+            uint64_t decoded = 0;       // jobs run to a successful result
+            uint64_t failed = 0;        // jobs run to a failed result
+            uint64_t cancelled = 0;     // jobs dropped before running
+            uint64_t offscreen = 0;     // requests cancelled by CancelOffscreen
+            size_t queued = 0;
+            size_t running = 0;
+        };
+
+        UCDecodeScheduler(Result cancelledResult, SuccessTest succeeded, Poster poster)
+                : cancelledResult(std::move(cancelledResult)),
+                  succeeded(std::move(succeeded)), poster(std::move(poster)) {}
+
+        ~UCDecodeScheduler() { Shutdown(); }
+
+        UCDecodeScheduler(const UCDecodeScheduler&) = delete;
+        UCDecodeScheduler& operator=(const UCDecodeScheduler&) = delete;
+
+        // Queues `work` under `key` (or joins the job already holding it) and
+        // returns the request's ticket. `onDone` runs exactly once unless the
+        // ticket is cancelled first. InvalidTicket after Shutdown().
+        Ticket Submit(const std::string& key, const std::string& resource, int priority,
+                      Work work, Callback onDone, OnScreenCheck onScreen = {}) {
+            std::lock_guard<std::mutex> lk(mutex);
+            if (shutdown) return InvalidTicket;
+            const Ticket ticket = nextTicket++;
+            ++stats.requested;
+
+            auto it = jobs.find(key);
+            if (it == jobs.end()) {
+                Job job;
+                job.key = key;
+                job.resource = resource;
+                job.work = std::move(work);
+                job.priority = priority;
+                job.lastTouch = Clock::now();
+                job.seq = nextSeq++;
+                it = jobs.emplace(key, std::move(job)).first;
+            } else {
+                ++stats.shared;
+                it->second.priority = std::min(it->second.priority, priority);
+                it->second.lastTouch = Clock::now();
+            }
+            it->second.waiters.push_back(Waiter{ticket, std::move(onDone), std::move(onScreen)});
+            ticketKeys[ticket] = key;
+
+            StartWorkersLocked();
+            cond.notify_one();
+            return ticket;
+        }
+
+        // Forgets the request; its callback will not run. Safe with stale or
+        // invalid tickets.
+        void Cancel(Ticket ticket) {
+            if (ticket == InvalidTicket) return;
+            std::lock_guard<std::mutex> lk(mutex);
+            RemoveWaiterLocked(ticket);
+        }
+
+        // The requester drew again: its job moves ahead within its class.
+        void Touch(Ticket ticket) {
+            std::lock_guard<std::mutex> lk(mutex);
+            if (Job* job = JobOfLocked(ticket)) job->lastTouch = Clock::now();
+        }
+
+        // Moves a queued request to another priority class.
+        void SetPriority(Ticket ticket, int priority) {
+            std::lock_guard<std::mutex> lk(mutex);
+            Job* job = JobOfLocked(ticket);
+            if (!job || job->running) return;
+            // Shared jobs keep the most urgent class any of their requesters
+            // asked for; raising is always honoured.
+            if (job->waiters.size() == 1 || priority < job->priority) job->priority = priority;
+        }
+
+        // UI thread, once per rendered frame: cancels every queued request
+        // whose on-screen check answers false and runs its callback with the
+        // cancelled result. Running jobs are left alone — the work is paid for.
+        void CancelOffscreen() {
+            std::vector<std::pair<Ticket, OnScreenCheck>> checks;
+            {
+                std::lock_guard<std::mutex> lk(mutex);
+                if (shutdown) return;
+                for (const auto& kv : jobs) {
+                    if (kv.second.running) continue;
+                    for (const Waiter& w : kv.second.waiters) {
+                        if (w.onScreen) checks.emplace_back(w.ticket, w.onScreen);
+                    }
+                }
+            }
+            // The checks look at UI state: asked outside the lock.
+            std::vector<Ticket> offscreen;
+            for (const auto& check : checks) {
+                if (!check.second()) offscreen.push_back(check.first);
+            }
+            if (offscreen.empty()) return;
+
+            std::vector<Callback> gone;
+            {
+                std::lock_guard<std::mutex> lk(mutex);
+                for (Ticket t : offscreen) {
+                    Job* job = JobOfLocked(t);
+                    if (!job || job->running) continue;   // started meanwhile
+                    for (const Waiter& w : job->waiters) {
+                        if (w.ticket == t) gone.push_back(w.callback);
+                    }
+                    RemoveWaiterLocked(t);
+                    ++stats.offscreen;
+                }
+            }
+            for (const Callback& callback : gone) {
+                if (callback) callback(cancelledResult);
+            }
+        }
+
+        // Worker threads (default: half the hardware threads, 1..4). Takes
+        // effect for threads started afterwards.
+        void SetWorkerCount(int count) {
+            std::lock_guard<std::mutex> lk(mutex);
+            workerCount = std::max(0, count);
+        }
+
+        int GetWorkerCount() const {
+            std::lock_guard<std::mutex> lk(mutex);
+            return WantedWorkersLocked();
+        }
+
+        Stats GetStats() const {
+            std::lock_guard<std::mutex> lk(mutex);
+            Stats s = stats;
+            s.queued = 0;
+            s.running = 0;
+            for (const auto& kv : jobs) {
+                if (kv.second.running) ++s.running;
+                else ++s.queued;
+            }
+            return s;
+        }
+
+        // Stops the workers (the jobs in flight finish first) and drops the
+        // queue for good.
+        void Shutdown() {
+            std::vector<std::thread> joining;
+            {
+                std::lock_guard<std::mutex> lk(mutex);
+                shutdown = true;
+                joining.swap(workers);
+                // Queued jobs die with the pool; running ones are erased by
+                // their worker.
+                for (auto it = jobs.begin(); it != jobs.end();) {
+                    if (it->second.running) {
+                        ++it;
+                    } else {
+                        for (const Waiter& w : it->second.waiters) ticketKeys.erase(w.ticket);
+                        it = jobs.erase(it);
+                    }
+                }
+            }
+            cond.notify_all();
+            for (auto& t : joining) {
+                if (t.joinable()) t.join();
+            }
+        }
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        struct Waiter {
+            Ticket ticket = InvalidTicket;
+            Callback callback;
+            OnScreenCheck onScreen;
+        };
+        struct Job {
+            std::string key;
+            std::string resource;
+            Work work;
+            std::vector<Waiter> waiters;
+            int priority = 0;                   // best (lowest) class among waiters
+            Clock::time_point lastTouch;
+            uint64_t seq = 0;
+            bool running = false;
+        };
+
+        Job* JobOfLocked(Ticket ticket) {
+            auto tit = ticketKeys.find(ticket);
+            if (tit == ticketKeys.end()) return nullptr;
+            auto jit = jobs.find(tit->second);
+            return jit == jobs.end() ? nullptr : &jit->second;
+        }
+
+        void RemoveWaiterLocked(Ticket ticket) {
+            auto tit = ticketKeys.find(ticket);
+            if (tit == ticketKeys.end()) return;
+            const std::string key = std::move(tit->second);
+            ticketKeys.erase(tit);
+
+            auto jit = jobs.find(key);
+            if (jit == jobs.end()) return;      // finished; delivery checks ticketKeys
+            Job& job = jit->second;
+            job.waiters.erase(std::remove_if(job.waiters.begin(), job.waiters.end(),
+                                             [ticket](const Waiter& w) {
+                                                 return w.ticket == ticket;
+                                             }),
+                              job.waiters.end());
+            // Nobody wants it any more: drop it unless a worker is already on
+            // it (the work then just warms whatever caches it fills).
+            if (job.waiters.empty() && !job.running) {
+                jobs.erase(jit);
+                ++stats.cancelled;
+            }
+        }
+
+        int WantedWorkersLocked() const {
+            if (workerCount > 0) return workerCount;
+            const int hw = static_cast<int>(std::thread::hardware_concurrency());
+            return std::clamp(hw / 2, 1, 4);
+        }
+
+        void StartWorkersLocked() {
+            const int wanted = WantedWorkersLocked();
+            while (static_cast<int>(workers.size()) < wanted) {
+                workers.emplace_back([this]() { WorkerMain(); });
+            }
+        }
+
+        // Best runnable job; null when none.
+        Job* PickJobLocked() {
+            Job* best = nullptr;
+            for (auto& kv : jobs) {
+                Job& j = kv.second;
+                if (j.running || resourcesInFlight.count(j.resource)) continue;
+                const bool better = !best ||
+                        j.priority < best->priority ||
+                        (j.priority == best->priority &&
+                         (j.lastTouch > best->lastTouch ||
+                          (j.lastTouch == best->lastTouch && j.seq < best->seq)));
+                if (better) best = &j;
+            }
+            return best;
+        }
+
+        void WorkerMain() {
+            for (;;) {
+                Work work;
+                std::string key, resource;
+                {
+                    std::unique_lock<std::mutex> lk(mutex);
+                    Job* job = nullptr;
+                    for (;;) {
+                        if (shutdown) return;
+                        job = PickJobLocked();
+                        if (job) break;
+                        cond.wait(lk);
+                    }
+                    job->running = true;
+                    work = job->work;
+                    key = job->key;
+                    resource = job->resource;
+                    resourcesInFlight.insert(resource);
+                }
+
+                // The expensive part, outside the lock.
+                Result result = work();
+                const bool ok = !succeeded || succeeded(result);
+
+                std::vector<Waiter> waiters;
+                {
+                    std::lock_guard<std::mutex> lk(mutex);
+                    resourcesInFlight.erase(resource);
+                    auto it = jobs.find(key);
+                    if (it != jobs.end()) {
+                        waiters = std::move(it->second.waiters);
+                        jobs.erase(it);
+                    }
+                    if (ok) ++stats.decoded;
+                    else ++stats.failed;
+                }
+                // Another job for the same resource may have been waiting on it.
+                cond.notify_all();
+                if (!waiters.empty()) Deliver(std::move(waiters), std::move(result));
+            }
+        }
+
+        void Deliver(std::vector<Waiter> waiters, Result result) {
+            // A ticket cancelled between here and the posted task must stay
+            // silent, so liveness is checked (and the ticket retired) right
+            // before each callback runs.
+            auto run = [this, waiters = std::move(waiters), result = std::move(result)]() {
+                for (const Waiter& w : waiters) {
+                    {
+                        std::lock_guard<std::mutex> lk(mutex);
+                        auto tit = ticketKeys.find(w.ticket);
+                        if (tit == ticketKeys.end()) continue;
+                        ticketKeys.erase(tit);
+                    }
+                    if (w.callback) w.callback(result);
+                }
+            };
+            if (poster) {
+                poster(std::move(run));
+            } else {
+                run();
+            }
+        }
+
+        const Result cancelledResult;
+        const SuccessTest succeeded;
+        const Poster poster;
+
+        mutable std::mutex mutex;
+        std::condition_variable cond;
+        std::vector<std::thread> workers;
+        bool shutdown = false;
+        int workerCount = 0;                    // 0 = automatic
+
+        std::unordered_map<std::string, Job> jobs;          // by key
+        std::unordered_map<Ticket, std::string> ticketKeys; // live tickets
+        std::unordered_set<std::string> resourcesInFlight;
+        Ticket nextTicket = 1;
+        uint64_t nextSeq = 0;
+        Stats stats;
+    };
+
+}
+#endif // ULTRACANVASDECODESCHEDULER_H
@@ -0,0 +1,135 @@
+// include/UltraCanvasFilerListing.h
+// The filer's listing model without the widget: the entry record, the sort
+// order of the listing, and the pieces of the live folder watch that do not
+// touch the UI — merging a batch of touched names into a sorted listing and
+// coalescing a burst of inotify events into one delivery.
+// Version: 1.0.0
+// Last Modified: 2026-10-18
+// Author: UltraCanvas Framework
+#pragma once
+#ifndef ULTRACANVASFILERLISTING_H
+#define ULTRACANVASFILERLISTING_H
+
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <functional>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace UltraCanvas {
+
+    // ===== SORTABLE FIELDS =====
+    enum class FilerSortField {
+        Name,
+        Size,
+        Type,
+        ModifiedDate,
+        CreatedDate
+    };
+
+    // ===== COARSE FILE CATEGORY (drives icons / colors / type sorting) =====
+    enum class FilerFileCategory {
+        Folder,
+        Image,
+        Vector,
+        Model3D,       // 3D models (stl, obj, ply, gltf, ...)
+        Audio,
+        Video,
+        Document,
+        Text,
+        Spreadsheet,
+        Archive,
+        Executable,
+        Other
+    };
+
+    // ===== ONE ENTRY OF THE DISPLAYED FOLDER =====
+    struct FilerEntry {
+        std::string name;            // file / folder name (no path)
+        std::string path;            // full path
+        std::string extension;       // lowercase, without the leading dot
+        std::string typeName;        // "Folder", "PNG Image", "ZIP Archive", ...
+        FilerFileCategory category = FilerFileCategory::Other;
+
+        bool isDirectory = false;
+        bool isHidden    = false;
+        bool isReadOnly  = false;
+        bool isSymlink   = false;
+        bool isArchive   = false;    // browsable archive (zip / 7z / ...)
+
+        uint64_t size = 0;           // bytes (uncompressed)
+        uint64_t compressedSize = 0; // bytes inside an archive (0 = not compressed)
+        // Size used by the size-weighted views (BarSize / TreeMap): for
+        // directories this is a lazily computed recursive size, else == size.
+        uint64_t effectiveSize = 0;
+
+        std::time_t modifiedTime = 0;
+        std::time_t createdTime  = 0;
+
+        std::string attributes;      // compact attribute string, e.g. "D", "RH"
+        std::string info;            // extra info column: play duration of audio /
+                                     // video, compression factor of archives, ...
+        std::string thumbnailPath;   // explicit thumbnail; images fall back to path
+    };
+
+    // Case-insensitive (ASCII) three-way name comparison used by the listing.
+    int FilerCompareNoCase(const std::string& a, const std::string& b);
+
+    // The listing order, as a strict weak order: folders first, then `field`
+    // in the given direction, ties broken by name. The full sort and the
+    // watch's binary insertion both use it, so they agree exactly.
+    bool FilerEntrySortsBefore(const FilerEntry& a, const FilerEntry& b,
+                               FilerSortField field, bool ascending);
+
+    // ===== LIVE FOLDER WATCH: DELTA MERGE =====
+    // Re-reads one touched path into `out`; false when it is gone (deleted or
+    // moved out) or must not be listed (hidden while hidden files are off).
+    using FilerRestatFunc = std::function<bool(const std::string& path,
+                                               FilerEntry& out)>;
+
+    // Applies one coalesced watch delta to a listing sorted by
+    // (field, ascending): every entry whose path is in `touched` is removed
+    // in a single pass, then each touched path that still restats is
+    // binary-inserted at its sorted position. Entries not touched keep their
+    // relative order. Returns the number of entries re-inserted.
+    size_t MergeFilerWatchDelta(std::vector<FilerEntry>& entries,
+                                const std::unordered_set<std::string>& touched,
+                                const FilerRestatFunc& restat,
+                                FilerSortField field, bool ascending);
+
+    // ===== LIVE FOLDER WATCH: BURST COALESCING =====
+    // Events are not delivered one by one: a burst is delivered once the
+    // folder has been quiet for `quietDelay`, or `maxLatency` after it began
+    // while events keep streaming in. Times are passed in so the schedule can
+    // be driven by a test clock.
+    class FilerWatchBurst {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        FilerWatchBurst(Clock::duration quietDelay, Clock::duration maxLatency)
+                : quietDelay(quietDelay), maxLatency(maxLatency) {}
+
+        // An event arrived at `now` (starts a burst when none is open).
+        void Touch(Clock::time_point now);
+        bool IsOpen() const { return open; }
+        // How long the event loop may sleep, in ms: -1 while no burst is open.
+        int PollTimeoutMs(Clock::time_point now) const;
+        // True once the open burst is due at `now`; the burst is closed and
+        // the caller delivers it.
+        bool TakeDue(Clock::time_point now);
+
+    private:
+        Clock::time_point DueAt() const;
+
+        Clock::duration quietDelay;
+        Clock::duration maxLatency;
+        bool open = false;
+        Clock::time_point burstStart;
+        Clock::time_point lastEvent;
+    };
+
+} // namespace UltraCanvas
+
+#endif // ULTRACANVASFILERLISTING_H
@@ -53,8 +53,12 @@
 // background), the host's own entries, and an "Other application…" picker;
 // the host can extend the context menu's Extras submenu via
 // extrasMenuProvider.
-// Version: 1.15.0
-// Last Modified: 2026-08-20
+// On Linux the shown folder is watched with inotify (SetFolderWatchEnabled):
+// changes other programs make are applied to the listing as deltas — only the
+// touched entries are re-stat-ed and re-inserted at their sorted position —
+// instead of rescanning and re-sorting the whole folder.
+// Version: 1.16.0
+// Last Modified: 2026-10-18
 // Author: UltraCanvas Framework
 #pragma once
 
@@ -65,6 +69,7 @@
 #include "UltraCanvasMenu.h"
 #include "UltraCanvasSplitPane.h"
 #include "UltraCanvasTimer.h"
+#include "UltraCanvasFilerListing.h"
 #include <atomic>
 #include <chrono>
 #include <condition_variable>
@@ -112,15 +117,6 @@ namespace UltraCanvas {
         View3D               // 3D view — to be implemented
     };
 
-    // ===== SORTABLE FIELDS =====
-    enum class FilerSortField {
-        Name,
-        Size,
-        Type,
-        ModifiedDate,
-        CreatedDate
-    };
-
     // ===== DETAILS-VIEW COLUMNS =====
     // The columns of the Details table, left to right. Each one can be resized
     // by dragging the splitter on its right edge, or from code with
@@ -155,22 +151,6 @@ namespace UltraCanvas {
         Dimensions   = 1u << 5    // bitmap width × height
     };
 
-    // ===== COARSE FILE CATEGORY (drives icons / colors / type sorting) =====
-    enum class FilerFileCategory {
-        Folder,
-        Image,
-        Vector,
-        Model3D,       // 3D models (stl, obj, ply, gltf, ...)
-        Audio,
-        Video,
-        Document,
-        Text,
-        Spreadsheet,
-        Archive,
-        Executable,
-        Other
-    };
-
     // ===== PREVIEWABLE FILE KINDS =====
     // Which kinds of file are shown with a real content preview — a thumbnail
     // rendered from the file itself — instead of the generic type glyph.
@@ -198,35 +178,6 @@ namespace UltraCanvas {
     // Every previewable kind — the default of SetPreviewTypes().
     constexpr uint32_t kFilerAllPreviewTypes = 0xFFu;
 
-    // ===== ONE ENTRY OF THE DISPLAYED FOLDER =====
-    struct FilerEntry {
-        std::string name;            // file / folder name (no path)
-        std::string path;            // full path
-        std::string extension;       // lowercase, without the leading dot
-        std::string typeName;        // "Folder", "PNG Image", "ZIP Archive", ...
-        FilerFileCategory category = FilerFileCategory::Other;
-
-        bool isDirectory = false;
-        bool isHidden    = false;
-        bool isReadOnly  = false;
-        bool isSymlink   = false;
-        bool isArchive   = false;    // browsable archive (zip / 7z / ...)
-
-        uint64_t size = 0;           // bytes (uncompressed)
-        uint64_t compressedSize = 0; // bytes inside an archive (0 = not compressed)
-        // Size used by the size-weighted views (BarSize / TreeMap): for
-        // directories this is a lazily computed recursive size, else == size.
-        uint64_t effectiveSize = 0;
-
-        std::time_t modifiedTime = 0;
-        std::time_t createdTime  = 0;
-
-        std::string attributes;      // compact attribute string, e.g. "D", "RH"
-        std::string info;            // extra info column: play duration of audio /
-                                     // video, compression factor of archives, ...
-        std::string thumbnailPath;   // explicit thumbnail; images fall back to path
-    };
-
     // ===== "NEW >" DOCUMENT KINDS =====
     // The context menu's New submenu offers these; a default set (Text, Doc,
     // Spreadsheet, Bitmap, Vector, Audio, Video) is installed by the widget and
@@ -374,6 +325,15 @@ namespace UltraCanvas {
         void SetFolderPrefetchEnabled(bool enabled);
         bool IsFolderPrefetchEnabled() const { return folderPrefetchEnabled; }
 
+        // Live folder watch (Linux inotify): entries other programs create,
+        // delete, rename or modify in the shown folder are applied to the
+        // listing in place — a burst of events is coalesced, only the touched
+        // names are re-stat-ed and each is re-inserted at its sorted position
+        // by binary search. On by default; a no-op on other platforms and for
+        // archive interiors / file-list displays. See LIVE FOLDER WATCH.
+        void SetFolderWatchEnabled(bool enabled);
+        bool IsFolderWatchEnabled() const { return folderWatchEnabled; }
+
         // "Compressed thumbnails": hold finished thumbnails QOI-compressed in
         // memory (roughly 3-4x smaller for photos) instead of as raw ARGB32
         // pixmaps. Tiles being drawn are decompressed on demand into a small
@@ -382,6 +342,15 @@ namespace UltraCanvas {
         void SetCompressedThumbnails(bool enabled);
         bool GetCompressedThumbnails() const { return compressedThumbs.load(); }
 
+        // "Persistent thumbnails": finished previews of photos, videos, PDFs
+        // and 3D models are also written to the shared XDG thumbnail cache
+        // (~/.cache/thumbnails, see UltraCanvasThumbnailStore.h) and read
+        // back from it first, so reopening a folder — in this or another
+        // application — skips the decode. Files that could not be previewed
+        // are remembered there too. On by default.
+        void SetPersistentThumbnails(bool enabled);
+        bool GetPersistentThumbnails() const { return persistentThumbs.load(); }
+
         // "Shrink thumbnail rows": in the thumbnail grid views the tiles are
         // square (edge = the selected Small / Medium / Big / Maximized size), so
         // a row of landscape photos leaves a wide empty band above and below
@@ -1009,6 +978,7 @@ namespace UltraCanvas {
         size_t thumbHotBytes = 0;
         uint64_t thumbHotTick = 0;
         std::atomic<bool> compressedThumbs{false};
+        std::atomic<bool> persistentThumbs{true};
         mutable std::mutex thumbMutex;          // guards slots/queue/generation
         std::condition_variable thumbCond;
         std::vector<std::thread> thumbWorkers;
@@ -1031,6 +1001,9 @@ namespace UltraCanvas {
         void StartThumbnailWorkersLocked();
         void StopThumbnailWorkers();
         void ThumbnailWorkerMain();
+        // Runs the file's preview producer (or reads the persistent store);
+        // worker thread, outside the lock.
+        std::shared_ptr<UCPixmap> ProduceThumbnailPixmap(const ThumbRequest& req);
         void DropThumbnailCache();              // on rescan / view change
         void PostThumbnailRedraw();
         static std::string ThumbSlotKey(const std::string& path, int w, int h,
@@ -1177,7 +1150,10 @@ namespace UltraCanvas {
         // Fills `e` by stat-ing `path` (name, sizes, times, type info); false
         // when the path no longer exists. Used by the file-list display.
         bool StatEntryForPath(const std::string& path, FilerEntry& e) const;
-        void SortEntries();
+        // Fills the derived columns of a freshly listed entry (effective size,
+        // attribute letters, info text through infoProvider).
+        void FinishScannedEntry(FilerEntry& e) const;
+        void SortEntries();   // FilerEntrySortsBefore order
         void EnsureEffectiveSizes();   // dir weights from the async folder stats
         void ApplyEntryTypeInfo(FilerEntry& e) const;
 
@@ -1219,6 +1195,49 @@ namespace UltraCanvas {
         void StopFolderPrefetchWorker();
         void FolderPrefetchWorkerMain();
 
+        // ===== LIVE FOLDER WATCH =====
+        // A build writing into a 100k-entry output folder used to cost a full
+        // rescan + re-sort per refresh. With the watch on, a worker thread
+        // blocks on an inotify instance watching the shown (real) folder and
+        // collects the names of touched entries. A burst is coalesced — it is
+        // delivered once the folder has been quiet for a short moment, or
+        // after a latency cap while events keep streaming in — and posted to
+        // the UI thread as one delta: the touched entries are removed in a
+        // single pass, re-stat-ed, and the survivors binary-inserted at their
+        // sorted position, with only their caches (thumbnails, probes, stats)
+        // invalidated. A queue overflow or the folder itself going away falls
+        // back to a plain rescan. While an interaction holds entry indices
+        // (inline rename, item drag, marquee, a pending paste / delete) the
+        // delta is held back and retried shortly after. Should the worker's
+        // poll fail, it asks for a rescan before exiting; that rescan re-arms
+        // a fresh watch, so the listing never silently stops following the
+        // folder. The merge and the coalescing live in
+        // UltraCanvasFilerListing.h.
+        std::mutex watchMutex;                       // guards the fields below
+        std::unordered_set<std::string> watchPendingNames;  // touched names
+        std::string watchedPath;                     // folder being watched
+        bool watchOverflow = false;                  // events lost: rescan
+        bool watchFailed = false;                    // worker exited on an error
+        bool watchShutdown = false;
+        int watchFd = -1;                            // inotify instance
+        int watchWakeFd = -1;                        // eventfd: wakes the worker
+        int watchWd = -1;                            // current watch descriptor
+        std::thread watchWorker;
+        std::atomic<bool> watchApplyPosted{false};
+        TimerId watchRetryTimer = InvalidTimerId;
+        bool folderWatchEnabled = true;
+
+        // (Re)points the watch at `path`; an empty path disarms it.
+        void ArmFolderWatch(const std::string& path);
+        void StopFolderWatch();
+        void FolderWatchWorkerMain();
+        void PostFolderWatchChanges();
+        // UI thread: applies the coalesced names as a delta to `entries`.
+        void ApplyFolderWatchChanges();
+        // Forgets every per-path cache entry (thumbnails, text previews,
+        // aspects, media probes, folder stats) of the given paths.
+        void ForgetEntryCaches(const std::unordered_set<std::string>& paths);
+
         // ===== LAYOUT =====
         void InvalidateFilerLayout() { layoutValid = false; }
         void EnsureLayout();
@@ -0,0 +1,207 @@
+// include/UltraCanvasFrameProfiler.h
+// Opt-in frame profiler: per-frame and per-element render / layout timing
+// Version: 1.0.0
+// Last Modified: 2026-10-18
+// Author: UltraCanvas Framework
+#pragma once
+
+#ifndef ULTRACANVAS_FRAME_PROFILER_H
+#define ULTRACANVAS_FRAME_PROFILER_H
+
+#include "UltraCanvasCommonTypes.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace UltraCanvas {
+
+    enum class ProfileKind : uint8_t {
+        Frame,
+        Render,
+        Measure,
+        Arrange
+    };
+
+    // One element's share of a frame. Times and draw calls are SELF values:
+    // what the element itself spent, its children's scopes subtracted.
+    struct ProfileElementStats {
+        const void* element = nullptr;
+        std::string id;
+        double renderMs = 0;
+        double renderTotalMs = 0;       // including children
+        double layoutMs = 0;            // measure + arrange
+        uint64_t drawCalls = 0;
+        uint32_t renders = 0;
+        uint32_t measures = 0;
+        uint32_t arranges = 0;
+    };
+
+    struct ProfileFrameStats {
+        uint64_t frame = 0;
+        double frameMs = 0;             // whole UpdateAndRender
+        double renderMs = 0;            // outermost render scopes
+        double layoutMs = 0;            // outermost measure / arrange scopes
+        uint64_t drawCalls = 0;
+        uint64_t textLayoutHits = 0;
+        uint64_t textLayoutMisses = 0;
+        uint32_t dirtyRects = 0;
+        uint64_t dirtyArea = 0;         // logical px²
+        std::vector<ProfileElementStats> elements;     // most expensive first
+    };
+
+    // ===== FRAME PROFILER =====
+    // Off by default. When enabled, every UltraCanvasWindowBase::UpdateAndRender
+    // becomes a frame; the window's layout pass, UltraCanvasUIElement::Arrange,
+    // CSSLayout measuring and UltraCanvasContainer's per-child render open
+    // nested scopes, and the Cairo back-end counts draw calls and text layout
+    // cache lookups. Each finished frame yields a ProfileFrameStats, the
+    // on-screen overlay shows the last one, and the scopes are kept as Chrome
+    // trace events (chrome://tracing, Perfetto) up to a bounded count.
+    //
+    // Disabled cost is one load of a static flag per hook. Scopes and frames
+    // are UI thread only; scopes opened outside a frame or on another thread
+    // are ignored. The counters may be bumped from any thread.
+    class UltraCanvasFrameProfiler {
+    public:
+        static constexpr size_t kDefaultTraceCapacity = 200000;
+        static constexpr size_t kHistoryFrames = 120;
+
+        static UltraCanvasFrameProfiler& GetInstance();
+
+        // Hot-path gate for every hook.
+        static bool IsActive() { return active.load(std::memory_order_relaxed); }
+
+        void SetEnabled(bool enable);
+        bool IsEnabled() const { return IsActive(); }
+
+        // The overlay needs the profiler, so showing it also enables it.
+        void SetOverlayVisible(bool visible);
+        bool IsOverlayVisible() const { return overlayVisible; }
+
+        // ===== FRAME / SCOPE HOOKS =====
+        // False when a frame is already open (nested UpdateAndRender); that
+        // caller must then skip EndFrame().
+        bool BeginFrame();
+        void EndFrame();
+        void AddDirtyRects(const std::vector<Rect2Di>& rects);
+
+        // False when the scope is not recorded; EndScope() must then be skipped.
+        bool BeginScope(ProfileKind kind, const void* element, const std::string* id);
+        void EndScope();
+
+        static void CountDrawCall() { drawCalls.fetch_add(1, std::memory_order_relaxed); }
+        static void CountTextLayout(bool cacheHit) {
+            (cacheHit ? textLayoutHits : textLayoutMisses).fetch_add(1, std::memory_order_relaxed);
+        }
+
+        // ===== RESULTS =====
+        const ProfileFrameStats& GetLastFrame() const { return lastFrame; }
+        double GetAverageFrameMs() const;
+        double GetMaxFrameMs() const;
+        uint64_t GetFrameCount() const { return frameCounter; }
+
+        // Chrome trace-event JSON ("X" complete events, µs since the profiler
+        // was enabled) of the frames and scopes still held.
+        std::string ToChromeTraceJson() const;
+        bool ExportChromeTrace(const std::string& path) const;
+        void SetTraceCapacity(size_t events);
+        size_t GetTraceEventCount() const { return trace.size(); }
+        void ClearTrace() { trace.clear(); }
+
+        // Text of the on-screen overlay for the last frame: totals, then the
+        // `topElements` slowest elements. The window draws it.
+        std::vector<std::string> GetOverlayLines(size_t topElements = 8) const;
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        struct OpenScope {
+            ProfileKind kind;
+            const void* element;
+            const std::string* id;
+            Clock::time_point start;
+            double childMs = 0;
+            uint64_t drawStart = 0;
+            uint64_t childDraws = 0;
+        };
+
+        struct TraceEvent {
+            ProfileKind kind;
+            std::string name;
+            int64_t startUs;
+            int64_t durationUs;
+            uint64_t drawCalls;
+        };
+
+        int64_t MicrosSinceEpoch(Clock::time_point t) const;
+        void PushTrace(TraceEvent event);
+
+        static std::atomic<bool> active;
+        static std::atomic<uint64_t> drawCalls;
+        static std::atomic<uint64_t> textLayoutHits;
+        static std::atomic<uint64_t> textLayoutMisses;
+
+        bool overlayVisible = false;
+        bool inFrame = false;
+        std::thread::id frameThread;
+        Clock::time_point epoch;
+        Clock::time_point frameStart;
+        uint64_t frameDrawStart = 0;
+        uint64_t frameHitStart = 0;
+        uint64_t frameMissStart = 0;
+        uint64_t frameCounter = 0;
+
+        int renderDepth = 0;
+        int layoutDepth = 0;
+        ProfileFrameStats current;
+        std::unordered_map<const void*, size_t> elementIndex;
+        std::vector<OpenScope> stack;
+
+        ProfileFrameStats lastFrame;
+        std::deque<double> history;     // frameMs of recent frames
+        std::deque<TraceEvent> trace;
+        size_t traceCapacity = kDefaultTraceCapacity;
+    };
+
+    // RAII scope for the hooks: does nothing unless the profiler is active.
+    class UCProfileScope {
+    public:
+        UCProfileScope(ProfileKind kind, const void* element, const std::string* id)
+                : recorded(UltraCanvasFrameProfiler::IsActive() &&
+                           UltraCanvasFrameProfiler::GetInstance().BeginScope(kind, element, id)) {}
+        ~UCProfileScope() {
+            if (recorded) UltraCanvasFrameProfiler::GetInstance().EndScope();
+        }
+        UCProfileScope(const UCProfileScope&) = delete;
+        UCProfileScope& operator=(const UCProfileScope&) = delete;
+
+    private:
+        bool recorded;
+    };
+
+    // RAII frame bracket for UpdateAndRender.
+    class UCProfileFrame {
+    public:
+        UCProfileFrame()
+                : recorded(UltraCanvasFrameProfiler::IsActive() &&
+                           UltraCanvasFrameProfiler::GetInstance().BeginFrame()) {}
+        ~UCProfileFrame() {
+            if (recorded) UltraCanvasFrameProfiler::GetInstance().EndFrame();
+        }
+        UCProfileFrame(const UCProfileFrame&) = delete;
+        UCProfileFrame& operator=(const UCProfileFrame&) = delete;
+
+    private:
+        bool recorded;
+    };
+
+} // namespace UltraCanvas
+
+#endif // ULTRACANVAS_FRAME_PROFILER_H
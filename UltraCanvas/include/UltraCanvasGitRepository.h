@@ -8,21 +8,65 @@
 // element consumes, and ships an IGitGraphDataSource adapter so a large history
 // can be paged into the widget lazily.
 //
+// Pack indexes and packfiles are memory-mapped, resolved delta bases are kept
+// in a size-bounded LRU, and the commit-graph file (objects/info/commit-graph
+// or a split commit-graph chain) answers parent / date / generation lookups
+// without inflating commit objects. Public calls are serialised internally, so
+// one repository may be walked on a worker thread while the UI thread reads
+// single objects.
+//
 // Namespace: UltraCanvas
-// Version: 1.0.0
-// Last Modified: 2026-07-30
+// Version: 1.1.0
+// Last Modified: 2026-10-18
 // Author: UltraCanvas Framework
+//
+// CHANGELOG
+// 1.1.0 (2026-10-18)
+//   - .idx and .pack files are memory-mapped instead of read into strings /
+//     through std::ifstream
+//   - LRU delta-base cache (SetDeltaBaseCacheLimit), so a delta chain's bases
+//     are inflated once rather than once per object
+//   - commit-graph support: ReadCommitGraphEntry(), and WalkMore() takes
+//     parents and dates from the graph; GitWalkDetail::Topology skips
+//     inflating commits altogether
+//   - the walk no longer inflates each commit twice (once for its date, once
+//     when emitted)
+//   - public calls are thread-safe; GetStats() for cache / graph counters
 
 #pragma once
 
 #include "Plugins/Diagrams/UltraCanvasGitGraphTypes.h"
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
 
 namespace UltraCanvas {
 
+// How much of each commit WalkMore() fills in.
+enum class GitWalkDetail {
+    Full,           // Every field, from the commit object
+    Topology        // sha, parents and commitDate only - served from the
+                    // commit-graph without inflating, where it covers the commit
+};
+
+// One commit as recorded in the commit-graph file.
+struct GitCommitGraphEntry {
+    std::vector<std::string> parents;
+    int64_t  commitDate = 0;
+    uint32_t generation = 0;        // Topological level: 1 for a root commit
+};
+
+struct GitRepositoryStats {
+    size_t objectsInflated  = 0;    // Loose or packed objects decompressed
+    size_t deltaBaseHits    = 0;
+    size_t deltaBaseMisses  = 0;
+    size_t deltaBaseBytes   = 0;    // Currently held by the cache
+    size_t commitGraphHits  = 0;    // Walk lookups answered by the commit-graph
+};
+
 class UltraCanvasGitRepository {
 public:
     UltraCanvasGitRepository();
@@ -55,9 +99,11 @@ public:
     // Walk from every ref tip, newest commit first. `limit` 0 reads everything.
     std::vector<GitGraphCommit> ReadCommits(size_t limit = 0);
 
-    // Incremental walking, for paging a large history into the element.
+    // Incremental walking, for paging a large history into the element. Safe
+    // to call from a worker thread (see UltraCanvasGitGraph::SetAsyncLoading).
     void RestartWalk();
-    std::vector<GitGraphCommit> WalkMore(size_t count);
+    std::vector<GitGraphCommit> WalkMore(size_t count,
+                                         GitWalkDetail detail = GitWalkDetail::Full);
     bool IsWalkComplete() const;
 
     // Single-object access.
@@ -75,6 +121,29 @@ public:
     bool ReadObject(const std::string& sha, const std::string& expectedType,
                     std::string& outData, std::string& outType);
 
+    // ===== COMMIT-GRAPH =====
+
+    // Whether a commit-graph was found, and how many commits it covers. A
+    // graph older than the newest commits is fine: anything it does not cover
+    // is read from the object itself.
+    bool   HasCommitGraph();
+    size_t GetCommitGraphSize();
+
+    // False when `sha` is not in the graph (or there is no graph).
+    bool ReadCommitGraphEntry(const std::string& sha, GitCommitGraphEntry& outEntry);
+
+    // Off reads every commit from its object, as before 1.1.0. On by default.
+    void SetUseCommitGraph(bool use);
+
+    // ===== CACHING =====
+
+    // Bytes of resolved delta bases kept in memory. 0 disables the cache.
+    void   SetDeltaBaseCacheLimit(size_t bytes);
+    size_t GetDeltaBaseCacheLimit() const;
+
+    GitRepositoryStats GetStats() const;
+    void ResetStats();
+
 private:
     struct Impl;
     std::unique_ptr<Impl> impl;
@@ -84,7 +153,8 @@ private:
 // UltraCanvasGitGraph::SetDataSource() and commits arrive as the user scrolls.
 class UltraCanvasGitRepositorySource : public IGitGraphDataSource {
 public:
-    explicit UltraCanvasGitRepositorySource(std::shared_ptr<UltraCanvasGitRepository> repository);
+    explicit UltraCanvasGitRepositorySource(std::shared_ptr<UltraCanvasGitRepository> repository,
+                                            GitWalkDetail detail = GitWalkDetail::Full);
 
     size_t GetTotalCommitCount() override { return 0; }        // Unknown up front
     std::vector<GitGraphCommit> FetchCommits(size_t offset, size_t count) override;
@@ -92,6 +162,7 @@ public:
 
 private:
     std::shared_ptr<UltraCanvasGitRepository> repository;
+    GitWalkDetail detail;
     std::vector<GitGraphCommit> walked;        // Everything walked so far
 };
 
@@ -0,0 +1,133 @@
+// include/UltraCanvasImageDecodeService.h
+// Shared background decode service for images: loads and rasterizes through
+// the regular UCImage pipeline on a prioritized worker pool, so a frame never
+// waits for libvips.
+// Version: 1.1.0
+// Last Modified: 2026-10-18
+// Author: UltraCanvas Framework
+#pragma once
+#ifndef ULTRACANVASIMAGEDECODESERVICE_H
+#define ULTRACANVASIMAGEDECODESERVICE_H
+
+#include "UltraCanvasImage.h"
+#include "UltraCanvasDecodeScheduler.h"
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace UltraCanvas {
+
+    // ===== IMAGE DECODE SERVICE =====
+    // UCImage::Get reads and probes the file, GetPixmap decodes and scales it
+    // — both on the calling thread. Called from Render(), a page with dozens
+    // of images stalls its first paint until every one of them is done.
+    //
+    // The service runs the same two calls on a small pool of worker threads:
+    //  - a *load* job (w/h = 0) is UCImage::Get, plus the animation frames for
+    //    animated images when asked for;
+    //  - a *raster* job is UCImage::Get + GetPixmap(w, h, fit, scale), so the
+    //    result also lands in the shared pixmap cache for synchronous users.
+    // Jobs are keyed by UCImage::MakePixmapCacheKey: concurrent requests for
+    // the same key share one decode and each requester gets its callback. One
+    // file is never processed by two workers at once (UCImage instances are
+    // shared through the image cache and not safe against that).
+    //
+    // Scheduling (UCDecodeScheduler): the highest priority class first,
+    // within a class the job whose requester submitted or drew (Touch) most
+    // recently. Requests made from Render() use Visible, so what is on
+    // screen decodes before anything that was merely loaded or prefetched.
+    //
+    // Cancellation: Cancel(ticket) forgets a request; a job with no
+    // requesters left is dropped before it runs. Containers do not render
+    // children that scrolled out of view, so "not drawn lately" says nothing
+    // about visibility — an element outside the dirty rects is still on
+    // screen. Instead a request can carry an isOnScreen check; the
+    // application calls CancelOffscreen() after each rendered frame, and a
+    // queued request whose check answers false is cancelled with a Cancelled
+    // result. Requesters also cancel when they are detached.
+    //
+    // Results are delivered on the UI thread (PostToUIThread). Without a
+    // running application (tools, tests) callbacks run on the worker thread.
+    class UCImageDecodeService {
+    public:
+        using Ticket = uint64_t;
+        static constexpr Ticket InvalidTicket = 0;
+
+        enum class Priority {
+            Visible = 0,        // drawn this frame
+            Prefetch = 1,       // about to be drawn (loads, next screen)
+            Background = 2      // nobody is waiting on screen
+        };
+
+        enum class DecodeStatus { Ready, Failed, Cancelled };
+
+        struct Result {
+            DecodeStatus status = DecodeStatus::Failed;
+            std::shared_ptr<UCImage> image;     // loaded image (also on Failed, for its errorMessage)
+            std::shared_ptr<UCPixmap> pixmap;   // raster jobs only
+        };
+        using Callback = std::function<void(const Result&)>;
+
+        struct Request {
+            std::string path;
+            int width = 0;                      // 0 x 0 = load only, no pixmap
+            int height = 0;
+            ImageFitMode fitMode = ImageFitMode::Contain;
+            float scale = 1.0f;                 // device scale of the target
+            Priority priority = Priority::Visible;
+            bool prepareAnimation = false;      // decode GIF/WebP frames too
+            // UI thread, asked after each rendered frame while the request
+            // is queued: false = the requester left the screen, cancel it.
+            std::function<bool()> isOnScreen;
+        };
+
+        using Scheduler = UCDecodeScheduler<Result>;
+        using Stats = Scheduler::Stats;
+
+        static UCImageDecodeService& GetInstance();
+
+        // Queues the request (or joins an identical one) and returns its
+        // ticket. `onDone` runs exactly once unless the ticket is cancelled
+        // first. InvalidTicket (and no callback) after Shutdown().
+        Ticket Submit(const Request& request, Callback onDone);
+        // Forgets the request; its callback will not run. Safe with stale or
+        // invalid tickets.
+        void Cancel(Ticket ticket);
+        // The requester drew again while waiting: its job moves ahead of
+        // others in the same class.
+        void Touch(Ticket ticket);
+        // Moves a queued request to another priority class.
+        void SetPriority(Ticket ticket, Priority priority);
+        // UI thread, after each rendered frame: cancels the queued requests
+        // whose isOnScreen check answers false (their callbacks get
+        // Cancelled).
+        void CancelOffscreen();
+
+        // Worker threads (default: half the hardware threads, 1..4). Takes
+        // effect for threads started afterwards.
+        void SetWorkerCount(int count);
+        int GetWorkerCount() const;
+
+        Stats GetStats() const;
+
+        // Stops the workers (the job in flight finishes first) and drops the
+        // queue for good. Called by the application before the image
+        // subsystem shuts down.
+        void Shutdown();
+
+        ~UCImageDecodeService();
+
+    private:
+        UCImageDecodeService();
+        UCImageDecodeService(const UCImageDecodeService&) = delete;
+        UCImageDecodeService& operator=(const UCImageDecodeService&) = delete;
+
+        // UCImage::Get (+ GetPixmap) for one request, on a worker.
+        static Result Decode(const Request& request);
+
+        Scheduler scheduler;
+    };
+
+}
+#endif // ULTRACANVASIMAGEDECODESERVICE_H
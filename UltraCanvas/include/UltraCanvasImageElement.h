@@ -1,7 +1,7 @@
 // include/UltraCanvasImageElement.h
 // Image display component with loading, caching, and transformation support
-// Version: 1.1.0
-// Last Modified: 2026-05-11
+// Version: 1.2.0
+// Last Modified: 2026-10-18
 // Author: UltraCanvas Framework
 #pragma once
 
@@ -9,6 +9,7 @@
 #include "UltraCanvasRenderContext.h"
 #include "UltraCanvasEvent.h"
 #include "UltraCanvasImageAnimation.h"
+#include "UltraCanvasImageDecodeService.h"
 #include <string>
 #include <vector>
 #include <functional>
@@ -69,6 +70,19 @@ private:
     bool cacheEnabled = true;
     bool asyncLoading = false;
 
+    // Async pipeline (asyncLoading): the file is loaded and every size it is
+    // drawn at is rasterized by UCImageDecodeService; Render only draws what
+    // is ready. The last delivered pixmap is held here (not only in the
+    // shared LRU, which may evict it before the next frame) and keeps being
+    // drawn, scaled, while a new size decodes after a resize.
+    std::string imagePath;                          // file LoadFromFile was given
+    UCImageDecodeService::Ticket loadTicket = UCImageDecodeService::InvalidTicket;
+    UCImageDecodeService::Ticket rasterTicket = UCImageDecodeService::InvalidTicket;
+    std::string rasterKey;                          // pixmap key rasterTicket decodes
+    std::string rasterFailedKey;                    // not retried until the size changes
+    std::shared_ptr<UCPixmap> readyPixmap;
+    std::string readyKey;
+
     // Animation (GIF / animated WebP). Frames come from the loaded image's
     // shared UCImageAnimation; the controller paces them on the app timer.
     UCImageAnimationController animator;
@@ -89,6 +103,10 @@ public:
                             float w, float h);
 
     UltraCanvasImageElement(const std::string& identifier = "ImageElement");
+    ~UltraCanvasImageElement() override;
+
+    // Detaching cancels the queued decodes.
+    void SetWindow(UltraCanvasWindowBase* win) override;
 
     // ===== IMAGE LOADING =====
     bool LoadFromFile(const std::string& filePath, bool forceLoad = false);
@@ -98,6 +116,16 @@ public:
     // file was locked, missing, or the format is unsupported). Empty on success.
     const std::string& GetLastError() const { return errorMessage; }
 
+    // Async loading: LoadFromFile returns at once (true = queued) and the
+    // file is loaded, then rasterized at the drawn size, on the shared
+    // UCImageDecodeService workers — visible elements first. The loading
+    // placeholder shows until the pixmap is ready; onImageLoaded /
+    // onImageLoadFailed fire when the load finishes. A file already in the
+    // image cache is taken synchronously. Off by default.
+    void SetAsyncLoading(bool enable);
+    bool IsAsyncLoading() const { return asyncLoading; }
+    ImageLoadState GetLoadState() const { return loadState; }
+
     // ===== IMAGE PROPERTIES =====
     void SetFitMode(ImageFitMode mode) { fitMode = mode; RequestRedraw(); }
     
@@ -174,6 +202,20 @@ private:
     // Decode + start (or clear) the frame animation for the loaded image.
     void SetupAnimation();
 
+    // Async pipeline steps (UI thread).
+    void SubmitAsyncLoad(UCImageDecodeService::Priority priority);
+    void OnAsyncLoaded(const UCImageDecodeService::Result& result);
+    // The pixmap to draw at the current size: ready, or the previous size
+    // while this one decodes (queued here), or null.
+    std::shared_ptr<UCPixmap> AcquireAsyncPixmap(IRenderContext* ctx);
+    // Drops the queued decodes but keeps what was delivered: the element is
+    // detached or scrolled away and re-asks when it is drawn again.
+    void CancelPendingDecodes();
+    void CancelAsyncWork();
+    // Attached, shown, and not clipped away by any ancestor's viewport —
+    // the isOnScreen check of Visible decode requests.
+    bool IsInViewport();
+
     void DrawLoadedImage(IRenderContext* ctx);
     void DrawErrorPlaceholder(IRenderContext* ctx);
     void DrawLoadingPlaceholder(IRenderContext* ctx);
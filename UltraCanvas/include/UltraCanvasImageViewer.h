@@ -2,8 +2,11 @@
 // Reusable lightbox image viewer: a zoomable / pannable image above a dark
 // info panel, opened in its own window. Shared by the markdown renderer's
 // image-click action and the Album photo viewer.
-// Version: 1.1.0
-// Last Modified: 2026-07-12
+// Version: 1.2.0
+// Last Modified: 2026-10-18
+// V1.2.0: Tiled mode for very large images — the zoom / pan surface draws
+//   256 x 256 tiles from a UCTiledImagePyramid instead of rasterizing the
+//   whole image at the displayed size.
 // V1.1.0: Animated images (GIF / animated WebP) now play in the lightbox — the
 //   zoom / pan surface steps them with a UCImageAnimationController, matching
 //   UltraCanvasImageElement.
@@ -14,6 +17,8 @@
 #include "UltraCanvasWindow.h"
 #include "UltraCanvasImage.h"
 #include "UltraCanvasImageAnimation.h"
+#include "UltraCanvasImageDecodeService.h"
+#include "UltraCanvasTiledImage.h"
 #include <string>
 #include <memory>
 
@@ -26,24 +31,64 @@ namespace UltraCanvas {
 // each frame, so vector sources (SVG) stay crisp at any zoom. A solid canvas is
 // painted behind the image first, so artwork that uses transparency composites
 // over a known colour instead of whatever sits behind the element.
+//
+// Tiled mode: for images loaded from a file that are too large to rasterize
+// whole (see TiledMode), the surface instead draws only the 256 x 256 tiles of
+// a UCTiledImagePyramid that intersect the view, from the pyramid level
+// matching the zoom. Tiles are read on background threads; until one arrives
+// its area shows the nearest coarser cached tile, or a fit-size preview
+// decoded through UCImageDecodeService while the pyramid is being built.
+// Memory stays at the tile budget however large the image is, and the zoom
+// is no longer capped by a rasterization limit.
 class UltraCanvasZoomPanImage : public UltraCanvasUIElement {
 public:
+    enum class TiledMode {
+        Auto,       // tiled above kTiledAutoPixels or kTiledAutoEdge
+        Enabled,    // every still image loaded from a file
+        Disabled    // always rasterize the whole image
+    };
+    static constexpr int64_t kTiledAutoPixels = 40'000'000;
+    static constexpr int kTiledAutoEdge = 8000;
+
     explicit UltraCanvasZoomPanImage(const std::string& elemId = "ZoomPanImage");
+    ~UltraCanvasZoomPanImage() override;
 
+    // Images set directly have no file for the pyramid and are never tiled.
     void SetImage(std::shared_ptr<UCImage> img);
-    void LoadFromFile(const std::string& path) { SetImage(UCImage::Get(path)); }
+    void LoadFromFile(const std::string& path);
     // Backdrop painted behind the image (default white) so transparent artwork
     // reads correctly.
     void SetCanvasColor(const Color& c) { canvasColor = c; RequestRedraw(); }
     void ResetView() { needsFit = true; RequestRedraw(); }
 
+    // Applies to the next LoadFromFile.
+    void SetTiledMode(TiledMode mode) { tiledMode = mode; }
+    TiledMode GetTiledMode() const { return tiledMode; }
+    // Byte budget of the tile cache, in MB (default 64).
+    void SetTileCacheBudgetMB(int megabytes);
+    bool IsTiled() const { return pyramid != nullptr; }
+    // Tile cache / reader counters; all zero when not tiled.
+    UCTiledImagePyramid::Stats GetTileStats() const;
+
     void Render(IRenderContext* ctx, const Rect2Df& dirtyRect) override;
     bool OnEvent(const UCEvent& event) override;
 
 private:
+    void ApplyImage(std::shared_ptr<UCImage> img, const std::string& path);
     bool HandleZoom(const UCEvent& event);
+    void RenderTiled(IRenderContext* ctx, const Rect2Df& b,
+                     double left, double top, double s);
+    void CancelPreview();
 
     std::shared_ptr<UCImage> image;
+    // Tiled mode state: the pyramid, and the fit-size preview shown under
+    // the tiles while they (or the pyramid itself) are still being made.
+    TiledMode tiledMode = TiledMode::Auto;
+    size_t tileCacheBudget = UCTiledImagePyramid::kDefaultCacheBudget;
+    std::unique_ptr<UCTiledImagePyramid> pyramid;
+    std::shared_ptr<UCPixmap> previewPixmap;
+    bool previewFailed = false;
+    UCImageDecodeService::Ticket previewTicket = UCImageDecodeService::InvalidTicket;
     // Steps animated images (GIF / animated WebP) on the app timer; zoom and
     // pan apply to the running animation. Holds no animation for stills.
     UCImageAnimationController animator;
@@ -0,0 +1,100 @@
+// include/UltraCanvasLayerCache.h
+// Retained offscreen layers for elements with layer caching switched on
+// Version: 1.0.0
+// Last Modified: 2026-10-18
+// Author: UltraCanvas Framework
+#pragma once
+
+#ifndef ULTRACANVAS_LAYER_CACHE_H
+#define ULTRACANVAS_LAYER_CACHE_H
+
+#include "UltraCanvasCommonTypes.h"
+#include "UltraCanvasRenderContext.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <unordered_map>
+
+namespace UltraCanvas {
+
+    class UltraCanvasUIElement;
+
+    // ===== LAYER CACHE =====
+    // One offscreen surface per layered element (SetLayerCaching), holding
+    // the element's whole subtree rasterized at the window's device scale.
+    // A repaint that only passes over the element — a tooltip, a hover
+    // highlight on a sibling — composites the surface instead of replaying
+    // the subtree's drawing commands. Invalidations inside the subtree mark
+    // the matching part of the layer dirty; only that part is re-rasterized
+    // on the next paint.
+    //
+    // Layer memory is bounded by a byte budget. When it is exceeded the least
+    // recently painted layers are dropped; their elements rasterize again the
+    // next time they are painted. A layer larger than the whole budget is
+    // never kept — that element simply renders directly.
+    //
+    // UI thread only.
+    class UltraCanvasLayerCache {
+    public:
+        static constexpr size_t kDefaultBudgetBytes = 64u * 1024u * 1024u;
+
+        struct Layer {
+            std::unique_ptr<IRenderContext> context;
+            Size2Di size;                   // logical size
+            float scale = 1.0f;             // device scale it was created at
+            size_t bytes = 0;
+            Rect2Df dirty;                  // layer-local; empty when up to date
+            bool rasterizing = false;       // never evicted while set
+        };
+
+        struct Stats {
+            uint64_t composites = 0;        // paints served from a layer
+            uint64_t fullRasters = 0;
+            uint64_t partialRasters = 0;
+            uint64_t evictions = 0;
+        };
+
+        static UltraCanvasLayerCache& GetInstance();
+
+        // Layer for `owner` at `size`, created (fully dirty) or re-created
+        // when the size or `target`'s device scale changed, and marked most
+        // recently used. nullptr when it can't be allocated or would exceed
+        // the budget on its own.
+        Layer* Acquire(const UltraCanvasUIElement* owner, const Size2Di& size, IRenderContext* target);
+
+        // Marks `rect` (owner-local) for re-rasterization. No-op for an
+        // element without a layer.
+        void Invalidate(const UltraCanvasUIElement* owner, const Rect2Df& rect);
+        void Release(const UltraCanvasUIElement* owner);
+        bool Has(const UltraCanvasUIElement* owner) const { return index.count(owner) != 0; }
+
+        void SetBudget(size_t bytes);
+        size_t GetBudget() const { return budgetBytes; }
+        size_t GetBytesUsed() const { return bytesUsed; }
+        size_t GetLayerCount() const { return lru.size(); }
+
+        const Stats& GetStats() const { return stats; }
+        void ResetStats() { stats = Stats(); }
+
+        // Counters are bumped by the element paint path.
+        void CountComposite() { stats.composites++; }
+        void CountRaster(bool full) { (full ? stats.fullRasters : stats.partialRasters)++; }
+
+    private:
+        using Entry = std::pair<const UltraCanvasUIElement*, Layer>;
+
+        void EvictToBudget(const Layer* keep);
+        void Erase(std::list<Entry>::iterator it);
+
+        std::list<Entry> lru;               // most recently painted first
+        std::unordered_map<const UltraCanvasUIElement*, std::list<Entry>::iterator> index;
+        size_t budgetBytes = kDefaultBudgetBytes;
+        size_t bytesUsed = 0;
+        Stats stats;
+    };
+
+} // namespace UltraCanvas
+
+#endif // ULTRACANVAS_LAYER_CACHE_H
@@ -0,0 +1,61 @@
+// include/UltraCanvasMappedFile.h
+// Read-only memory mapping of a whole file (POSIX mmap / Win32 file mapping)
+// Version: 1.0.0
+// Last Modified: 2026-10-18
+// Author: UltraCanvas Framework
+#pragma once
+
+#ifndef ULTRACANVAS_MAPPED_FILE_H
+#define ULTRACANVAS_MAPPED_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace UltraCanvas {
+
+    // ===== MAPPED FILE =====
+    // Maps a file read-only so large inputs (multi-GB meshes, archives) are
+    // parsed straight from the page cache instead of being copied into a
+    // buffer first. Pages are faulted in on demand and shared with the OS
+    // cache, so the mapping costs address space, not resident memory. The
+    // data stays valid until Close() / destruction; another process
+    // truncating the file meanwhile is undefined behaviour (SIGBUS on POSIX),
+    // as with any mapping. Empty files open successfully with Size() == 0.
+    // Move-only.
+    class UltraCanvasMappedFile {
+    public:
+        UltraCanvasMappedFile() = default;
+        ~UltraCanvasMappedFile() { Close(); }
+
+        UltraCanvasMappedFile(UltraCanvasMappedFile&& other) noexcept;
+        UltraCanvasMappedFile& operator=(UltraCanvasMappedFile&& other) noexcept;
+        UltraCanvasMappedFile(const UltraCanvasMappedFile&) = delete;
+        UltraCanvasMappedFile& operator=(const UltraCanvasMappedFile&) = delete;
+
+        // False (with GetLastError() set) when the file can't be opened or mapped.
+        bool Open(const std::string& path);
+        void Close();
+
+        bool IsOpen() const { return open; }
+        const uint8_t* Data() const { return data; }
+        size_t Size() const { return size; }
+        const std::string& GetLastError() const { return lastError; }
+
+        // Tells the OS the mapping will be read front to back (read-ahead).
+        void AdviseSequential() const;
+
+    private:
+        const uint8_t* data = nullptr;
+        size_t size = 0;
+        bool open = false;
+        std::string lastError;
+#ifdef _WIN32
+        void* fileHandle = nullptr;
+        void* mappingHandle = nullptr;
+#endif
+    };
+
+} // namespace UltraCanvas
+
+#endif // ULTRACANVAS_MAPPED_FILE_H
@@ -0,0 +1,38 @@
+// include/UltraCanvasRasterTiles.h
+// Screen-tile partitioning for rasterizing one recorded frame on several threads
+// Version: 1.0.0
+// Last Modified: 2026-10-18
+// Author: UltraCanvas Framework
+#pragma once
+
+#ifndef ULTRACANVAS_RASTER_TILES_H
+#define ULTRACANVAS_RASTER_TILES_H
+
+#include "UltraCanvasCommonTypes.h"
+
+#include <vector>
+
+namespace UltraCanvas {
+
+    // ===== RASTER TILES =====
+    // Tiles sit on a fixed grid of `tileSize` device pixels anchored at the
+    // surface origin. Every tile origin is therefore a whole pixel, so
+    // replaying a frame into a tile is an integer translation of the serial
+    // raster and yields the same pixels. Keep `tileSize` a multiple of 64 so
+    // ordered dithering patterns line up across tile seams too.
+    constexpr int kDefaultRasterTileSize = 256;
+
+    // Device-pixel bounds of a logical rectangle at `deviceScale`, rounded
+    // outwards.
+    Rect2Di LogicalToDeviceRect(const Rect2Di& logical, float deviceScale);
+
+    // Grid cells touched by any of `logicalRegions`, clipped to the surface
+    // (`surfacePixels`, device px), in row-major order. Cells are disjoint, so
+    // each one can be written by a different thread.
+    std::vector<Rect2Di> BuildRasterTiles(const std::vector<Rect2Di>& logicalRegions, float deviceScale,
+                                          const Size2Di& surfacePixels,
+                                          int tileSize = kDefaultRasterTileSize);
+
+} // namespace UltraCanvas
+
+#endif // ULTRACANVAS_RASTER_TILES_H
@@ -1,7 +1,7 @@
 // include/UltraCanvasRenderContext.h
 // Cross-platform rendering interface with improved context management
-// Version: 2.6.0
-// Last Modified: 2026-08-03
+// Version: 2.8.0
+// Last Modified: 2026-10-18
 // Author: UltraCanvas Framework
 #pragma once
 
@@ -183,6 +183,33 @@ namespace UltraCanvas {
         // stay crisp on HiDPI). Default 1.0 keeps non-HiDPI back-ends working.
         virtual float GetDeviceScale() const { return 1.0f; }
 
+        // Backend surface this context draws into, for creating compatible
+        // offscreen contexts (CreateRenderContext's similarTo). nullptr when
+        // the backend has no such handle.
+        virtual NativeSurfacePtr GetNativeSurface() const { return nullptr; }
+
+        // Paint `source`'s whole surface with its top-left at `pos` (OVER),
+        // through this context's current transform and clip — unlike
+        // CompositeToSurface, which bypasses both. Used to composite retained
+        // element layers. Returns false when the backend can't paint that
+        // source; callers then render directly.
+        virtual bool DrawContextSurface(IRenderContext& source, const Point2Dd& pos) { return false; }
+
+        // ===== DISPLAY LISTS =====
+        // Tiled rasterization: the frame is drawn into the context returned by
+        // BeginDisplayList, which records the calls instead of rasterizing
+        // them; EndDisplayList then replays the recording over `regions`
+        // (logical coordinates) in screen tiles on up to `threads` workers and
+        // writes the result into this context's surface. Nothing else may
+        // draw on this context in between.
+        //
+        // BeginDisplayList returns nullptr when the backend (or this surface)
+        // can't record. EndDisplayList returns false when the recording can't
+        // be replayed faithfully — e.g. a caller took the native context — and
+        // nothing was drawn: the caller then renders the frame directly.
+        virtual IRenderContext* BeginDisplayList() { return nullptr; }
+        virtual bool EndDisplayList(const std::vector<Rect2Di>& regions, int threads) { return false; }
+
         // ===== STATE MANAGEMENT =====
         virtual void PushState() = 0;
         virtual void PopState() = 0;
@@ -820,7 +847,11 @@ namespace UltraCanvas {
     }
 
     // factory
-    std::unique_ptr<IRenderContext> CreateRenderContext(const Size2Di& sz, NativeSurfacePtr similarTo);
+    // imageBacked: keep the pixels in client memory (an image surface
+    // similar to `similarTo`) rather than in a native surface, which
+    // BeginDisplayList requires.
+    std::unique_ptr<IRenderContext> CreateRenderContext(const Size2Di& sz, NativeSurfacePtr similarTo,
+                                                        bool imageBacked = false);
 } // namespace UltraCanvas
 
 #endif
\ No newline at end of file
@@ -0,0 +1,189 @@
+// include/UltraCanvasTableIndex.h
+// Columnar sort / filter keys and display-order builder behind
+// UltraCanvasTableView's background sorting and filtering.
+// Version: 1.1.0
+// Last Modified: 2026-10-18
+// Author: UltraCanvas Framework
+#pragma once
+#ifndef ULTRACANVASTABLEINDEX_H
+#define ULTRACANVASTABLEINDEX_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace UltraCanvas {
+
+    // ===== COLUMN KEYS =====
+    // One table column flattened for comparisons: every cell's text back to
+    // back plus its numeric value, parsed once. The old per-comparison
+    // std::stod made a sort O(n log n) string parses with an exception per
+    // non-number; here a comparison is two array reads.
+    //
+    // Rows live in chunks of kChunkRows. An edit rewrites only the chunk it
+    // touches, so the UI thread keeps a column in step with single-row
+    // changes instead of re-reading the whole table. Snapshot() hands a
+    // background build a read-only copy that costs one pointer per chunk;
+    // the next edit to a chunk the snapshot shares copies that chunk first.
+    class TableColumnKeys {
+    public:
+        static constexpr size_t kChunkRows = 4096;
+
+        TableColumnKeys() = default;
+
+        // Reads `rowCount` cells through `cellText`. Returns null when
+        // `cancel` is raised on the way (checked every few thousand rows).
+        static std::shared_ptr<TableColumnKeys> Build(
+                size_t rowCount,
+                const std::function<std::string(size_t row)>& cellText,
+                const std::atomic<bool>* cancel = nullptr);
+
+        size_t Size() const { return rowCount; }
+        std::string_view Text(size_t row) const;
+        double Number(size_t row) const;        // NaN = cell is not a number
+        bool IsNumber(size_t row) const { const double v = Number(row); return v == v; }
+
+        // Visits every row in order as visit(row, text, number); returns
+        // false when `cancel` was raised on the way.
+        template <class Visit>
+        bool ForEachRow(Visit&& visit, const std::atomic<bool>* cancel = nullptr) const {
+            size_t row = 0;
+            for (const Slot& slot : slots) {
+                if (cancel && cancel->load(std::memory_order_relaxed)) return false;
+                const Chunk& chunk = *slot.chunk;
+                for (size_t i = 0; i < chunk.numbers.size(); ++i, ++row) {
+                    visit(row, chunk.Text(i), chunk.numbers[i]);
+                }
+            }
+            return true;
+        }
+
+        // Single-row edits, O(kChunkRows) each plus one step per chunk
+        void Set(size_t row, const std::string& text);
+        void Insert(size_t row, const std::string& text);
+        void Remove(size_t row);
+
+        std::shared_ptr<const TableColumnKeys> Snapshot();
+
+    private:
+        struct Chunk {
+            std::vector<double> numbers;
+            std::vector<uint64_t> offsets;  // numbers.size() + 1 offsets into text
+            std::string text;
+
+            std::string_view Text(size_t i) const {
+                return std::string_view(text).substr(offsets[i], offsets[i + 1] - offsets[i]);
+            }
+        };
+        struct Slot {
+            std::shared_ptr<Chunk> chunk;
+            size_t firstRow = 0;
+            bool shared = false;            // also held by a snapshot: copy before writing
+        };
+
+        TableColumnKeys(const TableColumnKeys&) = default;
+        size_t Locate(size_t row) const;    // slot holding `row`
+        Chunk& Writable(size_t slot);
+        static std::shared_ptr<Chunk> NewChunk();
+
+        std::vector<Slot> slots;
+        size_t rowCount = 0;
+    };
+
+    // ===== DISPLAY ORDER =====
+    // Display row -> source row for a sort and / or a filter:
+    //  - a row is kept when `filter` is empty or occurs (case-sensitively) in
+    //    the text of any column in `filterColumns`;
+    //  - kept rows are ordered by `sortKeys` when given: numbers by value
+    //    ahead of text, text bytewise; stably, so equal keys keep source
+    //    order (also when descending).
+    // Returns false (leaving `out` unspecified) when `cancel` was raised.
+    bool BuildTableDisplayIndex(size_t rowCount,
+                                const TableColumnKeys* sortKeys, bool ascending,
+                                const std::string& filter,
+                                const std::vector<const TableColumnKeys*>& filterColumns,
+                                std::vector<int32_t>& out,
+                                const std::atomic<bool>* cancel = nullptr);
+
+    // Everything one display index is built from. The table fills it on the
+    // UI thread (snapshots of its key cache); a background build sees only
+    // these immutable keys and never reads the table or its model.
+    struct TableIndexRequest {
+        size_t rowCount = 0;
+        std::shared_ptr<const TableColumnKeys> sortKeys;
+        bool ascending = true;
+        std::string filter;
+        std::vector<std::shared_ptr<const TableColumnKeys>> filterColumns;
+    };
+
+    bool BuildTableDisplayIndex(const TableIndexRequest& request, std::vector<int32_t>& out,
+                                const std::atomic<bool>* cancel = nullptr);
+
+    // ===== BACKGROUND BUILDS =====
+    // One worker thread (started on first Submit) building one request at a
+    // time. A new Submit or Cancel stops the build in progress; a stopped
+    // build never calls its callback. `done` runs on the worker thread.
+    class TableIndexWorker {
+    public:
+        using Callback = std::function<void(std::shared_ptr<std::vector<int32_t>>)>;
+
+        TableIndexWorker() = default;
+        ~TableIndexWorker();
+        TableIndexWorker(const TableIndexWorker&) = delete;
+        TableIndexWorker& operator=(const TableIndexWorker&) = delete;
+
+        void Submit(TableIndexRequest request, Callback done);
+        void Cancel();
+        bool IsBusy() const { return busy.load(); }
+
+    private:
+        void Run();
+
+        std::thread thread;
+        std::mutex mutex;
+        std::condition_variable cond;
+        bool stop = false;
+        bool pending = false;
+        TableIndexRequest job;
+        Callback jobDone;
+        std::atomic<bool> cancel{false};
+        std::atomic<bool> busy{false};
+    };
+
+    // ===== INDEX EDITS =====
+    // The order a display index shows, over keys the caller keeps current
+    // (the table's key cache). Row edits patch an index against it in place
+    // of a rebuild; each expects the keys to be edited first.
+    struct TableIndexView {
+        const TableColumnKeys* sortKeys = nullptr;
+        bool ascending = true;
+        std::string_view filter;
+        std::vector<const TableColumnKeys*> filterColumns;
+
+        bool Passes(size_t sourceRow) const;
+        // Display order: by key (numbers before text), ties by source row,
+        // the order BuildTableDisplayIndex produces
+        bool Before(int32_t a, int32_t b) const;
+    };
+
+    // A row was inserted at `sourceRow`: later rows are renumbered and the
+    // new row, if it passes the filter, is binary-inserted where a rebuild
+    // would put it.
+    void TableIndexRowInserted(std::vector<int32_t>& index, int32_t sourceRow,
+                               const TableIndexView& view);
+    // A row was removed: dropped, later rows renumbered, in one pass.
+    void TableIndexRowRemoved(std::vector<int32_t>& index, int32_t sourceRow);
+    // A row's cells changed: it moves to where its new keys sort, or leaves
+    // / joins the display as it now fails / passes the filter.
+    void TableIndexRowChanged(std::vector<int32_t>& index, int32_t sourceRow,
+                              const TableIndexView& view);
+
+}
+#endif // ULTRACANVASTABLEINDEX_H
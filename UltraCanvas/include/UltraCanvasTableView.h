@@ -1,13 +1,23 @@
 // include/UltraCanvasTableView.h
 // Interactive table view component with sorting, filtering, and selection capabilities
-// Version: 1.1.0
-// Last Modified: 2026-05-29
+// Version: 1.3.0
+// Last Modified: 2026-10-18
+// V1.3.0: Row inserts, removes and cell edits update the cached keys and
+//   patch the display index in place instead of re-sorting the table.
+// V1.2.0: Rows can come from any IListModel (SetModel); cells are read only
+//   for the rows on screen. Sort / filter build a display index from
+//   columnar keys (UltraCanvasTableIndex.h), on a worker thread for large
+//   tables.
 // Author: UltraCanvas Framework
 #pragma once
 
 #include "UltraCanvasUIElement.h"
 #include "UltraCanvasRenderContext.h"
 #include "UltraCanvasEvent.h"
+#include "UltraCanvasApplication.h"
+#include "UltraCanvasListModel.h"
+#include "UltraCanvasTableIndex.h"
+#include <atomic>
 #include <string>
 #include <vector>
 #include <functional>
@@ -82,13 +92,27 @@ struct SelectionInfo {
 };
 
 // ===== MAIN TABLE VIEW COMPONENT =====
+// Sorting and filtering show the rows through a display index (display row
+// -> row). The keys it is built from are read from the rows on the UI
+// thread once per column and cached; for tables over kSyncIndexRows the
+// sort / filter itself then runs on a worker thread that sees only
+// snapshots of those keys, and the finished index is swapped in on the UI
+// thread. The worker never reads the rows or the model, so either can be
+// changed at any time. A single-row change (insert, remove, cell edit, the
+// model's onRowChanged) updates that row in the cached keys and moves it
+// within the index by binary search; only a wholesale change
+// (onDataChanged, SetTableData, column insert / remove) reads the keys
+// again.
 class UltraCanvasTableView : public UltraCanvasUIElement {
 private:
 
     // Data storage
     std::vector<TableColumn> columns;
     std::vector<std::vector<TableCell>> rows;
-    std::vector<int> sortedRowIndices; // For maintaining original data while showing sorted view
+    // External data source (SetModel); replaces `rows` while set
+    std::shared_ptr<IListModel> model;
+    // Display row -> row while a sort or filter is active; null = row order
+    std::shared_ptr<std::vector<int32_t>> displayIndex;
     
     // Visual properties
     int headerHeight = 30;
@@ -135,8 +159,16 @@ private:
     
     // Filtering
     std::string filterText;
-    std::vector<int> filteredRowIndices;
     bool hasFilter = false;
+
+    // Background sort / filter
+    static constexpr int kSyncIndexRows = 20000;
+    std::vector<std::shared_ptr<TableColumnKeys>> keyCache;  // per column
+    TableIndexWorker indexWorker;
+    uint64_t indexSerial = 0;           // bumped by every request and data change
+    bool indexBuildPending = false;     // a background build's result is to come
+    bool indexRebuildPosted = false;
+    std::shared_ptr<std::atomic<bool>> alive = std::make_shared<std::atomic<bool>>(true);
     
 public:
     // ===== EVENTS =====
@@ -162,6 +194,29 @@ public:
     explicit UltraCanvasTableView(const std::string& identifier)
         : UltraCanvasTableView(identifier, -1, -1, -1, -1) {}
 
+    ~UltraCanvasTableView() override {
+        alive->store(false);
+        if (model) DisconnectModelSignals();
+    }
+
+    // ===== DATA SOURCE =====
+    // Shows `source` (e.g. a database query result) instead of the table's
+    // own rows; null goes back to them. Columns are kept: add one
+    // TableColumn per model column. The row API below edits own rows only.
+    void SetModel(std::shared_ptr<IListModel> source) {
+        if (source == model) return;
+        if (model) DisconnectModelSignals();
+        model = std::move(source);
+        if (model) ConnectModelSignals();
+        selection.Clear();
+        StopEditing(false);
+        scrollOffsetY = 0;
+        displayIndex.reset();
+        MarkDataChanged();
+    }
+
+    IListModel* GetModel() const { return model.get(); }
+
     // ===== COLUMN MANAGEMENT =====
     void AddColumn(const TableColumn& column) {
         columns.push_back(column);
@@ -183,7 +238,7 @@ public:
                 }
             }
             
-            UpdateScrollBounds();
+            MarkDataChanged();
         }
     }
     
@@ -198,7 +253,7 @@ public:
                 }
             }
             
-            UpdateScrollBounds();
+            MarkDataChanged();
         }
     }
     
@@ -218,25 +273,18 @@ public:
     
     // ===== ROW MANAGEMENT =====
     int AddRow() {
-        std::vector<TableCell> newRow(columns.size());
-        rows.push_back(newRow);
-        
-        int newIndex = static_cast<int>(rows.size()) - 1;
-        sortedRowIndices.push_back(newIndex);
-        
-        UpdateScrollBounds();
+        return AddRow(std::vector<std::string>());
+    }
+    
+    int AddRow(const std::vector<std::string>& rowData) {
+        int newIndex = static_cast<int>(rows.size());
+        InsertRow(newIndex, rowData);
         
         if (onRowAdded) onRowAdded(newIndex);
         
         return newIndex;
     }
     
-    int AddRow(const std::vector<std::string>& rowData) {
-        int rowIndex = AddRow();
-        SetRowData(rowIndex, rowData);
-        return rowIndex;
-    }
-    
     void InsertRow(int index, const std::vector<std::string>& rowData = {}) {
         if (index >= 0 && index <= static_cast<int>(rows.size())) {
             std::vector<TableCell> newRow(columns.size());
@@ -248,13 +296,7 @@ public:
             
             rows.insert(rows.begin() + index, newRow);
             
-            // Update sorted indices
-            for (int& idx : sortedRowIndices) {
-                if (idx >= index) idx++;
-            }
-            sortedRowIndices.insert(sortedRowIndices.begin() + index, index);
-            
-            UpdateScrollBounds();
+            if (!model) OnRowInserted(index);
         }
     }
     
@@ -262,17 +304,7 @@ public:
         if (index >= 0 && index < static_cast<int>(rows.size())) {
             rows.erase(rows.begin() + index);
             
-            // Update sorted indices
-            auto it = std::find(sortedRowIndices.begin(), sortedRowIndices.end(), index);
-            if (it != sortedRowIndices.end()) {
-                sortedRowIndices.erase(it);
-            }
-            
-            for (int& idx : sortedRowIndices) {
-                if (idx > index) idx--;
-            }
-            
-            UpdateScrollBounds();
+            if (!model) OnRowRemoved(index);
             
             if (onRowRemoved) onRowRemoved(index);
         }
@@ -280,9 +312,11 @@ public:
     
     void ClearRows() {
         rows.clear();
-        sortedRowIndices.clear();
         selection.Clear();
-        UpdateScrollBounds();
+        if (!model) {
+            if (displayIndex) displayIndex->clear();
+            MarkDataChanged();
+        }
     }
     
     void SetRowData(int rowIndex, const std::vector<std::string>& rowData) {
@@ -290,12 +324,19 @@ public:
             for (size_t col = 0; col < rowData.size() && col < rows[rowIndex].size(); col++) {
                 rows[rowIndex][col].text = rowData[col];
             }
+            if (!model) OnRowChanged(rowIndex);
         }
     }
     
     std::vector<std::string> GetRowData(int rowIndex) const {
         std::vector<std::string> rowData;
-        if (rowIndex >= 0 && rowIndex < static_cast<int>(rows.size())) {
+        if (model) {
+            if (rowIndex >= 0 && rowIndex < model->GetRowCount()) {
+                for (int col = 0; col < model->GetColumnCount(); col++) {
+                    rowData.push_back(CellText(rowIndex, col));
+                }
+            }
+        } else if (rowIndex >= 0 && rowIndex < static_cast<int>(rows.size())) {
             for (const auto& cell : rows[rowIndex]) {
                 rowData.push_back(cell.text);
             }
@@ -305,27 +346,30 @@ public:
     
     // ===== CELL MANAGEMENT =====
     void SetCellValue(int row, int col, const std::string& value) {
-        if (IsValidCell(row, col)) {
+        if (IsOwnCell(row, col)) {
             rows[row][col].text = value;
+            if (!model) OnCellChanged(row, col);
         }
     }
     
     void SetCellValue(int row, int col, const TableCell& cell) {
-        if (IsValidCell(row, col)) {
+        if (IsOwnCell(row, col)) {
             rows[row][col] = cell;
+            if (!model) OnCellChanged(row, col);
         }
     }
     
     std::string GetCellValue(int row, int col) const {
         if (IsValidCell(row, col)) {
-            return rows[row][col].text;
+            return CellText(row, col);
         }
         return "";
     }
     
+    // Own rows only; an external model supplies text (GetCellValue)
     const TableCell& GetCell(int row, int col) const {
         static TableCell emptyCell;
-        if (IsValidCell(row, col)) {
+        if (!model && IsOwnCell(row, col)) {
             return rows[row][col];
         }
         return emptyCell;
@@ -371,51 +415,29 @@ public:
         currentSort.columnIndex = columnIndex;
         currentSort.ascending = ascending;
         
-        // Get indices to sort (either all rows or filtered rows)
-        std::vector<int>& indicesToSort = hasFilter ? filteredRowIndices : sortedRowIndices;
-        
-        std::sort(indicesToSort.begin(), indicesToSort.end(),
-            [this, columnIndex, ascending](int a, int b) {
-                const std::string& valueA = rows[a][columnIndex].text;
-                const std::string& valueB = rows[b][columnIndex].text;
-                
-                // Try numeric comparison first
-                try {
-                    double numA = std::stod(valueA);
-                    double numB = std::stod(valueB);
-                    return ascending ? (numA < numB) : (numA > numB);
-                } catch (...) {
-                    // Fall back to string comparison
-                    return ascending ? (valueA < valueB) : (valueA > valueB);
-                }
-            });
-        
-        if (onColumnSorted) onColumnSorted(columnIndex, ascending);
+        // onColumnSorted fires once the new order is on screen (ApplyIndex)
+        RequestIndexRebuild();
     }
     
     void ClearSort() {
         currentSort.columnIndex = -1;
-        
-        // Reset to original order
-        sortedRowIndices.clear();
-        for (int i = 0; i < static_cast<int>(rows.size()); i++) {
-            sortedRowIndices.push_back(i);
-        }
-        
-        ApplyFilter(); // Reapply filter if active
+        RequestIndexRebuild(); // Keeps the filter if active
     }
     
     // ===== FILTERING =====
     void SetFilter(const std::string& filter) {
         filterText = filter;
         hasFilter = !filter.empty();
-        ApplyFilter();
+        RequestIndexRebuild();
     }
     
     void ClearFilter() {
-        filterText.clear();
-        hasFilter = false;
-        filteredRowIndices.clear();
+        SetFilter(std::string());
+    }
+    
+    // A sort / filter is being built in the background
+    bool IsIndexing() const {
+        return indexWorker.IsBusy();
     }
     
     // ===== SCROLLING =====
@@ -426,7 +448,7 @@ public:
     
     void ScrollToRow(int row) {
         int targetY = row * rowHeight;
-        int visibleHeight = GetHeight() - (showHeader ? headerHeight : 0);
+        int visibleHeight = static_cast<int>(GetHeight()) - (showHeader ? headerHeight : 0);
         
         if (targetY < scrollOffsetY) {
             scrollOffsetY = targetY;
@@ -439,7 +461,7 @@ public:
     
     void ScrollToColumn(int col) {
         int targetX = GetColumnOffset(col);
-        int visibleWidth = GetWidth();
+        int visibleWidth = static_cast<int>(GetWidth());
         
         if (targetX < scrollOffsetX) {
             scrollOffsetX = targetX;
@@ -452,7 +474,7 @@ public:
     
     // ===== EDITING =====
     void StartEditing(int row, int col) {
-        if (IsValidCell(row, col) && rows[row][col].editable) {
+        if (!model && IsOwnCell(row, col) && rows[row][col].editable) {
             editingRow = row;
             editingCol = col;
             editingText = rows[row][col].text;
@@ -462,8 +484,9 @@ public:
     
     void StopEditing(bool saveChanges = true) {
         if (isEditing) {
-            if (saveChanges && IsValidCell(editingRow, editingCol)) {
+            if (saveChanges && IsOwnCell(editingRow, editingCol)) {
                 rows[editingRow][editingCol].text = editingText;
+                if (!model) OnCellChanged(editingRow, editingCol);
                 
                 if (onCellEdited) {
                     onCellEdited(editingRow, editingCol, editingText);
@@ -516,7 +539,9 @@ public:
         // Clear existing data
         columns.clear();
         rows.clear();
-        sortedRowIndices.clear();
+        // Re-sort once at the end rather than patching the index per row
+        displayIndex.reset();
+        keyCache.clear();
         
         // Add columns
         for (const auto& header : headers) {
@@ -528,18 +553,14 @@ public:
             AddRow(rowData);
         }
         
-        UpdateScrollBounds();
+        MarkDataChanged();
     }
     
     std::vector<std::vector<std::string>> GetTableData() const {
         std::vector<std::vector<std::string>> data;
         
-        for (const auto& row : rows) {
-            std::vector<std::string> rowData;
-            for (const auto& cell : row) {
-                rowData.push_back(cell.text);
-            }
-            data.push_back(rowData);
+        for (int row = 0; row < GetRowCount(); row++) {
+            data.push_back(GetRowData(row));
         }
         
         return data;
@@ -552,14 +573,14 @@ public:
             needsScrollUpdate = false;
         }
 
+        // Element-local coordinates (ctx is translated to element origin)
         ctx->PushState();
-        
 
         // Draw background
-        ctx->DrawFilledRectangle(GetBounds(), Colors::White, 1.0f, gridLineColor);
+        ctx->DrawFilledRectangle(GetLocalBounds(), Colors::White, 1.0f, gridLineColor);
         
         // Set clipping to table bounds
-        ctx->ClipRect(GetBounds());
+        ctx->ClipRect(GetLocalBounds());
 
         // Draw header
         if (showHeader) {
@@ -574,6 +595,8 @@ public:
         
         // Draw resize indicator
         DrawResizeIndicator(ctx);
+
+        ctx->PopState();
     }
     
     // ===== EVENT HANDLING =====
@@ -604,13 +627,16 @@ public:
             case UCEventType::KeyDown:
                 HandleKeyDown(event);
                 break;
+
+            default:
+                break;
         }
         return false;
     }
     
     // ===== UTILITY FUNCTIONS =====
     int GetRowCount() const {
-        return static_cast<int>(rows.size());
+        return model ? model->GetRowCount() : static_cast<int>(rows.size());
     }
     
     int GetColumnCount() const {
@@ -618,22 +644,33 @@ public:
     }
     
     int GetDisplayRowCount() const {
-        return hasFilter ? static_cast<int>(filteredRowIndices.size()) : static_cast<int>(rows.size());
+        return displayIndex ? static_cast<int>(displayIndex->size()) : GetRowCount();
     }
     
 private:
     bool IsValidCell(int row, int col) const {
-        return row >= 0 && row < static_cast<int>(rows.size()) && 
+        return row >= 0 && row < GetRowCount() && 
                col >= 0 && col < static_cast<int>(columns.size());
     }
     
+    bool IsOwnCell(int row, int col) const {
+        return row >= 0 && row < static_cast<int>(rows.size()) &&
+               col >= 0 && col < static_cast<int>(rows[row].size());
+    }
+    
+    std::string CellText(int row, int col) const {
+        if (model) {
+            return GetStringValue(model->GetData(ListIndex{row, col}, ListDataRole::DisplayRole));
+        }
+        return IsOwnCell(row, col) ? rows[row][col].text : std::string();
+    }
+    
     int GetActualRowIndex(int displayRow) const {
-        if (hasFilter) {
-            return (displayRow >= 0 && displayRow < static_cast<int>(filteredRowIndices.size())) ?
-                   filteredRowIndices[displayRow] : -1;
+        if (displayIndex) {
+            return (displayRow >= 0 && displayRow < static_cast<int>(displayIndex->size())) ?
+                   (*displayIndex)[displayRow] : -1;
         } else {
-            return (displayRow >= 0 && displayRow < static_cast<int>(sortedRowIndices.size())) ?
-                   sortedRowIndices[displayRow] : -1;
+            return (displayRow >= 0 && displayRow < GetRowCount()) ? displayRow : -1;
         }
     }
     
@@ -659,57 +696,249 @@ private:
         int totalHeight = GetDisplayRowCount() * rowHeight;
         
         // Calculate scroll bounds
-        maxScrollX = std::max(0, totalWidth - GetWidth());
-        maxScrollY = std::max(0, totalHeight - (GetHeight() - (showHeader ? headerHeight : 0)));
+        maxScrollX = std::max(0, totalWidth - static_cast<int>(GetWidth()));
+        maxScrollY = std::max(0, totalHeight - (static_cast<int>(GetHeight()) - (showHeader ? headerHeight : 0)));
         
         // Clamp current scroll offsets
         scrollOffsetX = std::max(0, std::min(scrollOffsetX, maxScrollX));
         scrollOffsetY = std::max(0, std::min(scrollOffsetY, maxScrollY));
     }
     
-    void ApplyFilter() {
-        filteredRowIndices.clear();
+    // ===== MODEL SIGNALS =====
+    void ConnectModelSignals() {
+        model->onDataChanged = [this]() { OnModelDataChanged(); };
+        model->onRowChanged = [this](int row) { OnRowChanged(row); };
+        model->onRowInserted = [this](int row) { OnRowInserted(row); };
+        model->onRowRemoved = [this](int row) { OnRowRemoved(row); };
+    }
+    
+    void DisconnectModelSignals() {
+        model->onDataChanged = nullptr;
+        model->onRowChanged = nullptr;
+        model->onRowInserted = nullptr;
+        model->onRowRemoved = nullptr;
+    }
+    
+    // ===== ROW EDITS =====
+    // The row is updated in every cached key column first; the index patch
+    // then places it by those keys.
+    void OnRowInserted(int row) {
+        for (size_t col = 0; col < keyCache.size(); col++) {
+            if (keyCache[col]) {
+                keyCache[col]->Insert(static_cast<size_t>(row), CellText(row, static_cast<int>(col)));
+            }
+        }
+        TableIndexView view;
+        const bool exact = displayIndex && GetIndexView(view);
+        if (displayIndex) {
+            // Without the keys: renumber now, the rebuild places the row
+            TableIndexRowInserted(*displayIndex, row, exact ? view : TableIndexView());
+        }
+        FinishRowEdit(exact);
+    }
+    
+    void OnRowRemoved(int row) {
+        for (auto& keys : keyCache) {
+            if (keys) keys->Remove(static_cast<size_t>(row));
+        }
+        if (displayIndex) TableIndexRowRemoved(*displayIndex, row);
+        FinishRowEdit(displayIndex != nullptr);
+    }
+    
+    void OnRowChanged(int row) {
+        if (row < 0 || row >= GetRowCount()) return;
+        for (size_t col = 0; col < keyCache.size(); col++) {
+            if (keyCache[col]) {
+                keyCache[col]->Set(static_cast<size_t>(row), CellText(row, static_cast<int>(col)));
+            }
+        }
+        TableIndexView view;
+        const bool exact = displayIndex && GetIndexView(view);
+        if (exact) TableIndexRowChanged(*displayIndex, row, view);
+        FinishRowEdit(exact);
+    }
+    
+    void OnCellChanged(int row, int col) {
+        if (col < static_cast<int>(keyCache.size()) && keyCache[col]) {
+            keyCache[col]->Set(static_cast<size_t>(row), CellText(row, col));
+        }
+        TableIndexView view;
+        const bool exact = displayIndex && GetIndexView(view);
+        // Only the sort column and the filter decide where a row shows
+        if (exact && (col == currentSort.columnIndex || hasFilter)) {
+            TableIndexRowChanged(*displayIndex, row, view);
+        }
+        FinishRowEdit(exact);
+    }
+    
+    void FinishRowEdit(bool patched) {
+        if ((currentSort.IsValid() || hasFilter) && (!patched || indexBuildPending)) {
+            indexSerial++; // A build that has not seen this edit is stale
+            ScheduleIndexRebuild();
+        }
+        UpdateScrollBounds();
+        RequestRedraw();
+    }
+    
+    // The order on screen over the live key cache; false when a key column
+    // it needs is not cached (the next rebuild reads it)
+    bool GetIndexView(TableIndexView& view) const {
+        const int sortColumn = currentSort.columnIndex < static_cast<int>(columns.size()) ?
+                               currentSort.columnIndex : -1;
+        auto cached = [this](int col) {
+            return col < static_cast<int>(keyCache.size()) ? keyCache[col].get() : nullptr;
+        };
+        if (sortColumn >= 0) {
+            view.sortKeys = cached(sortColumn);
+            view.ascending = currentSort.ascending;
+            if (!view.sortKeys) return false;
+        }
+        if (hasFilter) {
+            view.filter = filterText;
+            for (int col = 0; col < static_cast<int>(columns.size()); col++) {
+                if (!cached(col)) return false;
+                view.filterColumns.push_back(cached(col));
+            }
+        }
+        return true;
+    }
+    
+    void OnModelDataChanged() {
+        if (displayIndex) {
+            // Rows may be gone; keep the rest in order until the re-sort
+            const int32_t rowCount = GetRowCount();
+            auto& index = *displayIndex;
+            index.erase(std::remove_if(index.begin(), index.end(),
+                                       [rowCount](int32_t r) { return r >= rowCount; }),
+                        index.end());
+        }
+        MarkDataChanged();
+    }
+    
+    // ===== SORT / FILTER INDEX =====
+    // Wholesale change: every cached key column is read again
+    void MarkDataChanged() {
+        keyCache.clear();
+        indexSerial++; // Results of builds started before the change are stale
+        if (currentSort.IsValid() || hasFilter || displayIndex) {
+            ScheduleIndexRebuild();
+        }
+        UpdateScrollBounds();
+    }
+    
+    void ScheduleIndexRebuild() {
+        // Changes come in bursts (a loop of AddRow); re-sort once when the
+        // UI queue drains
+        auto* app = UltraCanvasApplicationBase::GetCurrent();
+        if (!app) {
+            RequestIndexRebuild();
+            return;
+        }
+        if (indexRebuildPosted) return;
+        indexRebuildPosted = true;
+        app->PostToUIThread([this, aliveFlag = alive]() {
+            if (!aliveFlag->load()) return;
+            indexRebuildPosted = false;
+            RequestIndexRebuild();
+        });
+    }
+    
+    std::shared_ptr<TableColumnKeys> GetColumnKeys(int col) {
+        if (keyCache.size() < columns.size()) keyCache.resize(columns.size());
+        if (!keyCache[col]) {
+            keyCache[col] = TableColumnKeys::Build(static_cast<size_t>(GetRowCount()),
+                [this, col](size_t row) { return CellText(static_cast<int>(row), col); });
+        }
+        return keyCache[col];
+    }
+    
+    void RequestIndexRebuild() {
+        const uint64_t serial = ++indexSerial;
+        const int sortColumn = currentSort.columnIndex < static_cast<int>(columns.size()) ?
+                               currentSort.columnIndex : -1;
         
-        if (!hasFilter) return;
+        if (sortColumn < 0 && !hasFilter) {
+            // Row order: no index, and no keys to keep in step with edits
+            indexWorker.Cancel();
+            indexBuildPending = false;
+            displayIndex.reset();
+            keyCache.clear();
+            UpdateScrollBounds();
+            return;
+        }
         
-        for (int i = 0; i < static_cast<int>(rows.size()); i++) {
-            bool matches = false;
-            
-            // Check if any cell in the row contains the filter text
-            for (const auto& cell : rows[i]) {
-                if (cell.text.find(filterText) != std::string::npos) {
-                    matches = true;
-                    break;
-                }
-            }
-            
-            if (matches) {
-                filteredRowIndices.push_back(i);
+        // Keys are read here, on the UI thread; a background build gets
+        // snapshots, so the cache keeps taking edits meanwhile
+        TableIndexRequest request;
+        request.rowCount = static_cast<size_t>(GetRowCount());
+        request.ascending = currentSort.ascending;
+        const bool background = request.rowCount > kSyncIndexRows &&
+                                UltraCanvasApplicationBase::GetCurrent();
+        auto keysFor = [this, background](int col) -> std::shared_ptr<const TableColumnKeys> {
+            auto keys = GetColumnKeys(col);
+            if (background) return keys->Snapshot();
+            return keys;
+        };
+        if (sortColumn >= 0) request.sortKeys = keysFor(sortColumn);
+        if (hasFilter) {
+            request.filter = filterText;
+            for (int col = 0; col < static_cast<int>(columns.size()); col++) {
+                request.filterColumns.push_back(keysFor(col));
             }
         }
         
-        // Apply current sort to filtered results
-        if (currentSort.IsValid()) {
-            SortByColumn(currentSort.columnIndex, currentSort.ascending);
+        if (!background) {
+            indexWorker.Cancel();
+            indexBuildPending = false;
+            auto index = std::make_shared<std::vector<int32_t>>();
+            BuildTableDisplayIndex(request, *index);
+            ApplyIndex(serial, std::move(index));
+            return;
+        }
+        
+        // The previous order stays on screen until the new one is ready
+        indexBuildPending = true;
+        indexWorker.Submit(std::move(request),
+            [this, aliveFlag = alive, serial](std::shared_ptr<std::vector<int32_t>> index) {
+                auto* app = UltraCanvasApplicationBase::GetCurrent();
+                if (!app) return;
+                app->PostToUIThread([this, aliveFlag, serial, index]() {
+                    if (!aliveFlag->load()) return;
+                    ApplyIndex(serial, index);
+                });
+            });
+    }
+    
+    void ApplyIndex(uint64_t serial, std::shared_ptr<std::vector<int32_t>> index) {
+        if (serial != indexSerial) return; // Superseded
+        indexBuildPending = false;
+        displayIndex = std::move(index);
+        UpdateScrollBounds();
+        RequestRedraw();
+        
+        if (currentSort.IsValid() && onColumnSorted) {
+            onColumnSorted(currentSort.columnIndex, currentSort.ascending);
         }
     }
     
-    void DrawHeader() {
+    void DrawHeader(IRenderContext* ctx) {
         if (!showHeader) return;
         
-        Rect2D headerRect(GetX(), GetY(), GetWidth(), headerHeight);
-        UltraCanvas::DrawFilledRect(headerRect, headerBackgroundColor, gridLineColor, 1.0f);
+        Rect2Di headerRect(0, 0, static_cast<int>(GetWidth()), headerHeight);
+        ctx->DrawFilledRectangle(headerRect, headerBackgroundColor, 1.0f, gridLineColor);
         
-        ctx->PaintWidthColorheaderTextColor);
+        ctx->SetTextPaint(headerTextColor);
         ctx->SetFontSize(11.0f);
+        ctx->SetTextVerticalAlignment(VerticalAlignment::Middle);
+        ctx->SetTextWrap(TextWrap::WrapNone);
         
-        int x = GetX() - scrollOffsetX;
+        int x = -scrollOffsetX;
         
         for (int col = 0; col < static_cast<int>(columns.size()); col++) {
             if (!columns[col].visible) continue;
             
             int colWidth = columns[col].width;
-            Rect2D colRect(x, GetY(), colWidth, headerHeight);
+            Rect2Di colRect(x, 0, colWidth, headerHeight);
             
             // Draw column background
             if (currentSort.columnIndex == col) {
@@ -717,22 +946,25 @@ private:
                 sortedColor.r = std::max(0, static_cast<int>(sortedColor.r) - 20);
                 sortedColor.g = std::max(0, static_cast<int>(sortedColor.g) - 20);
                 sortedColor.b = std::max(0, static_cast<int>(sortedColor.b) - 20);
-                UltraCanvas::DrawFilledRect(colRect, sortedColor);
+                ctx->DrawFilledRectangle(colRect, sortedColor);
             }
             
             // Draw column text
-            Point2D textPos(x + cellPadding, GetY() + (headerHeight + 11) / 2);
-            ctx->DrawText(columns[col].title, textPos);
+            ctx->SetTextPaint(headerTextColor);
+            ctx->SetTextAlignment(TextAlignment::Left);
+            ctx->DrawTextInRect(columns[col].title,
+                                Rect2Di(x + cellPadding, 0, colWidth - cellPadding * 2, headerHeight));
             
             // Draw sort indicator
             if (currentSort.columnIndex == col) {
-                DrawSortIndicator(x + colWidth - 15, GetY() + headerHeight / 2, currentSort.ascending);
+                DrawSortIndicator(ctx, x + colWidth - 15, headerHeight / 2, currentSort.ascending);
             }
             
             // Draw column separator
             if (showGridLines) {
-                ctx->PaintWidthColorgridLineColor);
-                ctx->DrawLine(Point2D(x + colWidth, GetY()), Point2D(x + colWidth, GetY() + headerHeight));
+                ctx->SetStrokePaint(gridLineColor);
+                ctx->SetStrokeWidth(gridLineWidth);
+                ctx->DrawLine(Point2Di(x + colWidth, 0), Point2Di(x + colWidth, headerHeight));
             }
             
             x += colWidth;
@@ -740,15 +972,21 @@ private:
     }
     
     void DrawRows(IRenderContext *ctx) {
-        int startY = GetY() + (showHeader ? headerHeight : 0);
-        int visibleHeight = GetHeight() - (showHeader ? headerHeight : 0);
+        int startY = showHeader ? headerHeight : 0;
+        int visibleHeight = static_cast<int>(GetHeight()) - startY;
+        int width = static_cast<int>(GetWidth());
         
         // Calculate visible row range
         int firstVisibleRow = scrollOffsetY / rowHeight;
         int lastVisibleRow = std::min(static_cast<int>(GetDisplayRowCount()),
                                      firstVisibleRow + (visibleHeight / rowHeight) + 2);
         
+        // Rows scrolled up must not paint over the header
+        ctx->PushState();
+        ctx->ClipRect(Rect2Di(0, startY, width, visibleHeight));
         ctx->SetFontSize(10.0f);
+        ctx->SetTextVerticalAlignment(VerticalAlignment::Middle);
+        ctx->SetTextWrap(TextWrap::WrapNone);
         
         for (int displayRow = firstVisibleRow; displayRow < lastVisibleRow; displayRow++) {
             int actualRow = GetActualRowIndex(displayRow);
@@ -762,58 +1000,60 @@ private:
                 rowColor = alternateRowColor;
             }
             
-            Rect2D rowRect(GetX(), y, GetWidth(), rowHeight);
-            UltraCanvas::DrawFilledRect(rowRect, rowColor);
+            ctx->DrawFilledRectangle(Rect2Di(0, y, width, rowHeight), rowColor);
             
             // Draw cells
-            DrawRowCells(actualRow, y);
+            DrawRowCells(ctx, actualRow, y);
             
             // Draw horizontal grid line
             if (showGridLines) {
-                ctx->PaintWidthColorgridLineColor);
-                ctx->DrawLine(Point2D(GetX(), y + rowHeight), Point2D(GetX() + GetWidth(), y + rowHeight));
+                ctx->SetStrokePaint(gridLineColor);
+                ctx->SetStrokeWidth(gridLineWidth);
+                ctx->DrawLine(Point2Di(0, y + rowHeight), Point2Di(width, y + rowHeight));
             }
         }
+        ctx->PopState();
     }
     
     void DrawRowCells(IRenderContext *ctx, int row, int y) {
-        int x = GetX() - scrollOffsetX;
+        int x = -scrollOffsetX;
         
         for (int col = 0; col < static_cast<int>(columns.size()); col++) {
             if (!columns[col].visible) continue;
             
             int colWidth = columns[col].width;
-            const TableCell& cell = rows[row][col];
+            // Read only for the rows on screen
+            const TableCell cell = model ? TableCell(CellText(row, col)) : GetCell(row, col);
             
             // Draw cell background
             if (cell.backgroundColor.a > 0) {
-                Rect2D cellRect(x, y, colWidth, rowHeight);
-                ctx->DrawFilledRect(cellRect, cell.backgroundColor);
+                ctx->DrawFilledRectangle(Rect2Di(x, y, colWidth, rowHeight), cell.backgroundColor);
             }
             
-            // Draw cell text
-            ctx->SetTextPaint(cell.textColor);
-            
-            Rect2D textRect(x + cellPadding, y, colWidth - cellPadding * 2, rowHeight);
-            Point2D textPos(x + cellPadding, y + (rowHeight + 10) / 2);
-            
-            // Clip text to cell bounds
+            // Draw cell text, clipped to the cell
+            Rect2Di textRect(x + cellPadding, y, colWidth - cellPadding * 2, rowHeight);
+            ctx->PushState();
             ctx->ClipRect(textRect);
+            ctx->SetTextPaint(cell.textColor);
+            switch (columns[col].alignment) {
+                case TableColumn::Alignment::Center: ctx->SetTextAlignment(TextAlignment::Center); break;
+                case TableColumn::Alignment::Right:  ctx->SetTextAlignment(TextAlignment::Right); break;
+                default:                             ctx->SetTextAlignment(TextAlignment::Left); break;
+            }
             
             if (isEditing && editingRow == row && editingCol == col) {
                 // Draw editing text
-                ctx->DrawText(editingText + "|", textPos); // Simple cursor
+                ctx->DrawTextInRect(editingText + "|", textRect); // Simple cursor
             } else {
-                ctx->DrawText(cell.text, textPos);
+                ctx->DrawTextInRect(cell.text, textRect);
             }
-            
-            // Reset clipping
-            ctx->ClipRect(GetBounds());
+            ctx->PopState();
             
             // Draw vertical grid line
             if (showGridLines) {
-                ctx->SetTextPaint(gridLineColor);
-                ctx->DrawLine(Point2D(x + colWidth, y), Point2D(x + colWidth, y + rowHeight));
+                ctx->SetStrokePaint(gridLineColor);
+                ctx->SetStrokeWidth(gridLineWidth);
+                ctx->DrawLine(Point2Di(x + colWidth, y), Point2Di(x + colWidth, y + rowHeight));
             }
             
             x += colWidth;
@@ -823,7 +1063,9 @@ private:
     void DrawSelection(IRenderContext* ctx) {
         if (!selection.IsValid()) return;
         
-        int startY = GetY() + (showHeader ? headerHeight : 0);
+        int startY = showHeader ? headerHeight : 0;
+        int width = static_cast<int>(GetWidth());
+        int height = static_cast<int>(GetHeight());
         
         int minRow = std::min(selection.startRow, selection.endRow);
         int maxRow = std::max(selection.startRow, selection.endRow);
@@ -832,16 +1074,17 @@ private:
         
         for (int row = minRow; row <= maxRow; row++) {
             for (int col = minCol; col <= maxCol; col++) {
-                if (!IsValidCell(row, col) || !columns[col].visible) continue;
+                if (row < 0 || row >= GetDisplayRowCount() || col < 0 ||
+                    col >= static_cast<int>(columns.size()) || !columns[col].visible) continue;
                 
-                int x = GetX() + GetColumnOffset(col) - scrollOffsetX;
+                int x = GetColumnOffset(col) - scrollOffsetX;
                 int y = startY + row * rowHeight - scrollOffsetY;
                 
-                Rect2D cellRect(x, y, columns[col].width, rowHeight);
+                Rect2Di cellRect(x, y, columns[col].width, rowHeight);
                 
                 // Only draw if visible
-                if (cellRect.x + cellRect.width > GetX() && cellRect.x < GetX() + GetWidth() &&
-                    cellRect.y + cellRect.height > startY && cellRect.y < GetY() + GetHeight()) {
+                if (cellRect.x + cellRect.width > 0 && cellRect.x < width &&
+                    cellRect.y + cellRect.height > startY && cellRect.y < height) {
                     
                     ctx->DrawFilledRectangle(cellRect, selectedCellColor, 2.0f, focusColor);
                 }
@@ -850,29 +1093,28 @@ private:
     }
     
     void DrawSortIndicator(IRenderContext* ctx, int x, int y, bool ascending) {
-        ctx->PaintWidthColorheaderTextColor);
+        ctx->SetStrokePaint(headerTextColor);
         ctx->SetStrokeWidth(1.0f);
         
         int size = 4;
         if (ascending) {
             // Up arrow
-            ctx->DrawLine(Point2D(x - size, y + size), Point2D(x, y - size));
-            ctx->DrawLine(Point2D(x, y - size), Point2D(x + size, y + size));
+            ctx->DrawLine(Point2Di(x - size, y + size), Point2Di(x, y - size));
+            ctx->DrawLine(Point2Di(x, y - size), Point2Di(x + size, y + size));
         } else {
             // Down arrow
-            ctx->DrawLine(Point2D(x - size, y - size), Point2D(x, y + size));
-            ctx->DrawLine(Point2D(x, y + size), Point2D(x + size, y - size));
+            ctx->DrawLine(Point2Di(x - size, y - size), Point2Di(x, y + size));
+            ctx->DrawLine(Point2Di(x, y + size), Point2Di(x + size, y - size));
         }
     }
     
-    void DrawResizeIndicator() {
+    void DrawResizeIndicator(IRenderContext* ctx) {
         if (resizingColumn >= 0) {
-            ctx->PaintWidthColorfocusColor);
+            ctx->SetStrokePaint(focusColor);
             ctx->SetStrokeWidth(2.0f);
 
-            // Element-local coordinates (ctx translated to element origin)
             int x = GetColumnOffset(resizingColumn + 1) - scrollOffsetX;
-            ctx->DrawLine(Point2D(x, 0), Point2D(x, GetHeight()));
+            ctx->DrawLine(Point2Di(x, 0), Point2Di(x, static_cast<int>(GetHeight())));
         }
     }
 
@@ -880,7 +1122,7 @@ private:
         if (!Contains(event.pointer)) return;
 
         // Check for column resize (event.pointer is element-local)
-        if (CheckColumnResize(event.pointer.x, event.pointer.y)) return;
+        if (CheckColumnResize(static_cast<int>(event.pointer.x), static_cast<int>(event.pointer.y))) return;
 
         // Check header click
         if (showHeader && event.pointer.y < headerHeight) {
@@ -919,8 +1161,9 @@ private:
     }
     
     void HandleMouseWheel(const UCEvent& event) {
-        int scrollAmount = event.delta * 3; // 3 rows per wheel notch
+        int scrollAmount = event.wheelDelta * 3; // 3 rows per wheel notch
         ScrollTo(scrollOffsetX, scrollOffsetY - scrollAmount * rowHeight);
+        RequestRedraw();
     }
     
     void HandleKeyDown(const UCEvent& event) {
@@ -936,6 +1179,7 @@ private:
                     if (!editingText.empty()) {
                         editingText.pop_back();
                     }
+                    break;
                 default:
                     return HandleKeyChar(event);
             }
@@ -986,9 +1230,9 @@ private:
     }
     
     bool CheckColumnResize(int x, int y) {
-        if (!showHeader || y > GetY() + headerHeight) return false;
+        if (!showHeader || y > headerHeight) return false;
         
-        int currentX = GetX() - scrollOffsetX;
+        int currentX = -scrollOffsetX;
         
         for (int col = 0; col < static_cast<int>(columns.size()); col++) {
             if (!columns[col].visible) continue;
@@ -1008,7 +1252,7 @@ private:
     }
     
     void HandleHeaderClick(int x) {
-        int currentX = GetX() - scrollOffsetX;
+        int currentX = -scrollOffsetX;
         
         for (int col = 0; col < static_cast<int>(columns.size()); col++) {
             if (!columns[col].visible) continue;
@@ -1043,11 +1287,12 @@ private:
     }
     
     std::pair<int, int> GetCellFromPosition(int x, int y) {
-        // Convert to display row/col
-        int startY = GetY() + (showHeader ? headerHeight : 0);
+        // Convert to display row/col (x, y are element-local)
+        int startY = showHeader ? headerHeight : 0;
+        if (y < startY) return std::make_pair(-1, -1);
         int row = (y - startY + scrollOffsetY) / rowHeight;
         
-        int currentX = GetX() - scrollOffsetX;
+        int currentX = -scrollOffsetX;
         int col = -1;
         
         for (int c = 0; c < static_cast<int>(columns.size()); c++) {
@@ -1076,9 +1321,8 @@ inline std::shared_ptr<UltraCanvasTableView> CreateTableView(
 }
 
 inline std::shared_ptr<UltraCanvasTableView> CreateTableView(
-    const std::string& identifier, const Rect2D& bounds) {
-    return CreateTableView(identifier, static_cast<long>(bounds.x), static_cast<long>(bounds.y),
-                          static_cast<long>(bounds.width), static_cast<long>(bounds.height));
+    const std::string& identifier, const Rect2Df& bounds) {
+    return CreateTableView(identifier, bounds.x, bounds.y, bounds.width, bounds.height);
 }
 
 // ===== CONVENIENCE FUNCTIONS =====
@@ -1091,69 +1335,16 @@ inline std::shared_ptr<UltraCanvasTableView> CreateTableWithData(
 }
 
 // ===== LEGACY C-STYLE INTERFACE =====
-extern "C" {
-    static UltraCanvasTableView* g_currentTableView = nullptr;
-    
-    void CreateTableView(int x, int y, int width, int height, const char** headers, int columnCount) {
-        g_currentTableView = new UltraCanvasTableView("legacy_table", (float)x, (float)y, (float)width, (float)height);
-        
-        if (headers && columnCount > 0) {
-            for (int i = 0; i < columnCount; i++) {
-                if (headers[i]) {
-                    g_currentTableView->AddColumn(headers[i]);
-                }
-            }
-        }
-    }
-    
-    void CreateTableView(int x, int y, int width, int height) {
-        CreateTableView(x, y, width, height, nullptr, 0);
-    }
-    
-    void AddTableRow(const char** rowData, int columnCount) {
-        if (g_currentTableView && rowData && columnCount > 0) {
-            std::vector<std::string> data;
-            for (int i = 0; i < columnCount; i++) {
-                data.push_back(rowData[i] ? rowData[i] : "");
-            }
-            g_currentTableView->AddRow(data);
-        }
-    }
-    
-    void SetTableCell(int row, int col, const char* value) {
-        if (g_currentTableView && value) {
-            g_currentTableView->SetCellValue(row, col, value);
-        }
-    }
-    
-    const char* GetTableCell(int row, int col) {
-        static std::string cellValue;
-        if (g_currentTableView) {
-            cellValue = g_currentTableView->GetCellValue(row, col);
-            return cellValue.c_str();
-        }
-        return "";
-    }
-    
-    void ClearTable() {
-        if (g_currentTableView) {
-            g_currentTableView->ClearRows();
-        }
-    }
-    
-    int GetTableRowCount() {
-        return g_currentTableView ? g_currentTableView->GetRowCount() : 0;
-    }
-    
-    int GetTableColumnCount() {
-        return g_currentTableView ? g_currentTableView->GetColumnCount() : 0;
-    }
-    
-    void SortTableByColumn(int column, int ascending) {
-        if (g_currentTableView) {
-            g_currentTableView->SortByColumn(column, ascending != 0);
-        }
-    }
-}
+// Operates on one implicit "current" table (created by CreateTableView).
+// Plain C++ functions: the CreateTableView overloads cannot have C linkage.
+void CreateTableView(int x, int y, int width, int height, const char** headers, int columnCount);
+void CreateTableView(int x, int y, int width, int height);
+void AddTableRow(const char** rowData, int columnCount);
+void SetTableCell(int row, int col, const char* value);
+const char* GetTableCell(int row, int col);
+void ClearTable();
+int GetTableRowCount();
+int GetTableColumnCount();
+void SortTableByColumn(int column, int ascending);
 
 } // namespace UltraCanvas
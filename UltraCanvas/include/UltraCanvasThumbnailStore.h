@@ -0,0 +1,131 @@
+// include/UltraCanvasThumbnailStore.h
+// Persistent on-disk thumbnail store following the freedesktop.org
+// Thumbnail Managing Standard, shared by the Filer widget, the Album and the
+// video poster extraction.
+// Version: 1.0.0
+// Last Modified: 2026-10-18
+// Author: UltraCanvas Framework
+#pragma once
+#ifndef ULTRACANVASTHUMBNAILSTORE_H
+#define ULTRACANVASTHUMBNAILSTORE_H
+
+#include <cstdint>
+#include <ctime>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace UltraCanvas {
+
+// ===== PERSISTENT THUMBNAILS =====
+//
+// Decoding a photo, a PDF page or a video frame for a thumbnail is the
+// expensive part of opening a folder, and the in-memory caches of the widgets
+// die with the process — so every launch used to re-decode everything. The
+// store keeps finished thumbnails on disk in the XDG layout other desktop
+// applications (Nautilus, Dolphin, Thunar, ...) read and write too:
+//
+//   $XDG_CACHE_HOME/thumbnails/{normal,large,x-large,xx-large}/<md5>.png
+//
+// where <md5> is the lowercase hex MD5 of the file's canonical "file://" URI
+// and the flavor caps the longer edge at 128 / 256 / 512 / 1024 px. Each PNG
+// carries the spec's tEXt keys Thumb::URI and Thumb::MTime (plus
+// Thumb::Size and Thumb::Image::Width/Height when known); a thumbnail whose
+// MTime no longer matches the file is stale and treated as a miss. Files that
+// could not be thumbnailed are remembered under fail/ultracanvas/ so they are
+// not retried on every launch.
+//
+// The store only moves PNG bytes; producers encode their pixmap first (see
+// PngEncodePixmap in libspecific/Cairo/PngPixmapCodec.h) and consumers decode
+// the returned bytes through the regular image pipeline
+// (UCImage::LoadFromMemory + GetPixmap). All functions are thread-safe and
+// meant for worker threads: a lookup reads one small file, a store writes one
+// through a temp file + rename so readers never see a partial PNG.
+namespace ThumbnailStore {
+
+    enum class Flavor {
+        Normal,     // 128 px
+        Large,      // 256 px
+        XLarge,     // 512 px
+        XXLarge     // 1024 px
+    };
+
+    // Longest edge of a flavor, and its directory name under the root.
+    int FlavorEdge(Flavor flavor);
+    const char* FlavorDirectory(Flavor flavor);
+    // The smallest flavor whose edge covers `edgePx` (raw pixels); false when
+    // the request is larger than the largest flavor — such tiles are decoded
+    // from the original every time.
+    bool FlavorForEdge(int edgePx, Flavor& out);
+
+    // On by default. Off makes Lookup miss and Store do nothing.
+    void SetEnabled(bool enabled);
+    bool IsEnabled();
+
+    // $XDG_CACHE_HOME/thumbnails, or ~/.cache/thumbnails when unset (on
+    // Windows %LOCALAPPDATA%\thumbnails). Overridable, e.g. for tests.
+    void SetCacheRoot(const std::string& directory);
+    std::string GetCacheRoot();
+
+    // Canonical "file://" URI of an absolute path, percent-encoding the
+    // same characters GLib's g_filename_to_uri does (so the MD5 names match).
+    std::string FileUri(const std::string& absolutePath);
+    // Lowercase hex MD5 digest of `data`.
+    std::string Md5Hex(const std::string& data);
+    // Where the thumbnail of `path` in `flavor` lives (it may not exist).
+    std::string ThumbnailPathFor(const std::string& path, Flavor flavor);
+
+    // What a stored thumbnail says about its source (the tEXt keys).
+    struct ThumbnailInfo {
+        std::string uri;
+        std::time_t mtime = 0;
+        uint64_t size = 0;          // 0 = not recorded
+        int imageWidth = 0;         // original dimensions, 0 = not recorded
+        int imageHeight = 0;
+    };
+
+    // Reads a valid thumbnail of `path` that is sharp enough for a tile whose
+    // longer edge is `edgePx` raw pixels: the flavor covering the edge first,
+    // then larger ones. Valid = URI and MTime match the file as it is now.
+    // A smaller-than-flavor thumbnail still qualifies when it is the whole
+    // original (recorded image dimensions not larger than the thumbnail).
+    // Fills `pngOut` with the file's bytes and returns true on a hit.
+    bool Lookup(const std::string& path, int edgePx,
+                std::vector<uint8_t>& pngOut, ThumbnailInfo* infoOut = nullptr);
+
+    // Writes `png` (already scaled to fit the flavor's edge) as the
+    // `flavor` thumbnail of `path`, stamping the tEXt keys from the file's
+    // current metadata. originalWidth/Height record the source dimensions
+    // when known. Returns false when the store is off, the path is not a
+    // local file, or the write fails.
+    bool Store(const std::string& path, Flavor flavor,
+               const std::vector<uint8_t>& png,
+               int originalWidth = 0, int originalHeight = 0);
+
+    // Failure cache: a file that could not be thumbnailed is recorded (with
+    // its MTime) so it is skipped until it changes. Only for files a decoder
+    // rejected - not when no producer was available - and ignored for files
+    // modified in the last few seconds, which may still be being written.
+    void MarkFailed(const std::string& path);
+    bool HasFailed(const std::string& path);
+
+    // Drops every flavor (and the failure mark) of `path` — after the file
+    // was deleted or rewritten by the application itself.
+    void Remove(const std::string& path);
+
+    // ===== PNG tEXt helpers (exposed for tests) =====
+    // Reads the tEXt chunks of a PNG; false when `png` is not a PNG.
+    bool ReadPngText(const std::vector<uint8_t>& png,
+                     std::vector<std::pair<std::string, std::string>>& out);
+    // Returns `png` with the given tEXt chunks inserted after IHDR (existing
+    // chunks with the same keys are dropped). Empty when `png` is not a PNG.
+    std::vector<uint8_t> WithPngText(
+            const std::vector<uint8_t>& png,
+            const std::vector<std::pair<std::string, std::string>>& text);
+    // Pixel dimensions from the IHDR chunk; false when `png` is not a PNG.
+    bool ReadPngSize(const std::vector<uint8_t>& png, int& width, int& height);
+
+} // namespace ThumbnailStore
+} // namespace UltraCanvas
+
+#endif // ULTRACANVASTHUMBNAILSTORE_H
@@ -0,0 +1,165 @@
+// include/UltraCanvasTiledImage.h
+// Tiled resolution pyramid for very large raster images: 256 x 256 tiles read
+// through libvips regions on background threads and kept in a byte-budgeted
+// LRU. Backs the tiled mode of UltraCanvasZoomPanImage.
+// Version: 1.0.0
+// Last Modified: 2026-10-18
+// Author: UltraCanvas Framework
+#pragma once
+#ifndef ULTRACANVASTILEDIMAGE_H
+#define ULTRACANVASTILEDIMAGE_H
+
+#include "UltraCanvasImage.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace UltraCanvas {
+
+    // ===== TILED IMAGE PYRAMID =====
+    // Rasterizing a 40 000 px photo or a scanned map at the displayed size
+    // needs the whole decoded image — gigabytes — and a zoom into one corner
+    // still pays for all of it. The pyramid never holds more than a screenful
+    // of tiles:
+    //  - Building: one background pass streams the source (sequential access,
+    //    so JPEG / PNG / strip TIFF decode in constant memory) into a
+    //    temporary tiled, pyramidal TIFF — 8-bit RGBA, 256 x 256 tiles, every
+    //    level half the size of the one below, level 0 = the original.
+    //  - Ready: worker threads read single tiles out of that file through a
+    //    VipsRegion per level; only the requested rectangle is decoded.
+    //  - Tiles live in an LRU bounded in bytes (SetCacheBudget). The owner
+    //    asks for tiles with GetTile (cache only, never blocks) and lists what
+    //    it needs with SetWanted each frame; queued tiles that fell off the
+    //    list (scrolled or zoomed away) are dropped unread.
+    // The temporary file is removed with the pyramid.
+    class UCTiledImagePyramid {
+    public:
+        static constexpr int kTileSize = 256;
+        static constexpr size_t kDefaultCacheBudget = 64 * 1024 * 1024;
+
+        enum class PyramidState { Building, Ready, Failed };
+
+        struct TileKey {
+            int level = 0;
+            int col = 0;
+            int row = 0;
+            bool operator==(const TileKey& o) const {
+                return level == o.level && col == o.col && row == o.row;
+            }
+        };
+
+        struct Stats {
+            uint64_t generated = 0;     // tiles read from the pyramid file
+            uint64_t hits = 0;          // GetTile served from the LRU
+            uint64_t misses = 0;
+            uint64_t evicted = 0;
+            uint64_t dropped = 0;       // queued, then no longer wanted
+            size_t cachedTiles = 0;
+            size_t cachedBytes = 0;
+            size_t queued = 0;
+            int buildPercent = 0;
+        };
+
+        // Starts building on a background thread right away. `onChanged`
+        // runs on the UI thread after the state changed or wanted tiles
+        // arrived (coalesced to one call per UI-queue drain); without a
+        // running application it runs on the background thread.
+        explicit UCTiledImagePyramid(const std::string& path,
+                                     std::function<void()> onChanged = nullptr);
+        // Cancels the build, joins the workers and removes the pyramid file.
+        ~UCTiledImagePyramid();
+
+        UCTiledImagePyramid(const UCTiledImagePyramid&) = delete;
+        UCTiledImagePyramid& operator=(const UCTiledImagePyramid&) = delete;
+
+        const std::string& GetSourcePath() const { return sourcePath; }
+        PyramidState GetState() const;
+        // 0 until Ready.
+        int GetLevelCount() const;
+        // Pixel size of `level` (level 0 = the original).
+        bool GetLevelSize(int level, int& w, int& h) const;
+        // Tile columns / rows of `level`.
+        bool GetTileGrid(int level, int& cols, int& rows) const;
+        // Level to draw when one source pixel covers `scale` device pixels:
+        // the coarsest level that still has at least that much detail.
+        int ChooseLevel(double scale) const;
+
+        // The cached tile, or null. Never touches libvips.
+        std::shared_ptr<UCPixmap> GetTile(const TileKey& key);
+        // Replaces the wish list. Missing tiles are read in list order (put
+        // the most important first); queued tiles not on the list are dropped.
+        void SetWanted(const std::vector<TileKey>& keys);
+
+        // Byte budget of the tile LRU; shrinking evicts immediately. It
+        // should hold at least a screenful (about 50 MB for a 4K display).
+        void SetCacheBudget(size_t bytes);
+        size_t GetCacheBudget() const;
+        // Tile reader threads (default: half the hardware threads, 1..4).
+        // Takes effect when the pyramid becomes ready.
+        void SetWorkerCount(int count);
+
+        Stats GetStats() const;
+
+    private:
+        struct CacheEntry {
+            std::shared_ptr<UCPixmap> pixmap;
+            std::list<uint64_t>::iterator lruPos;
+            size_t bytes = 0;
+        };
+
+        static uint64_t PackKey(const TileKey& key);
+        static TileKey UnpackKey(uint64_t packed);
+        // libvips "eval" signal handler (image, progress, this).
+        static void OnBuildEval(void* image, void* progress, void* self);
+
+        void BuildMain();
+        void WorkerMain();
+        void StartWorkersLocked();
+        void EvictToBudgetLocked();
+        void NotifyChanged();
+
+        const std::string sourcePath;
+        const std::function<void()> onChanged;
+        std::string pyramidPath;
+
+        mutable std::mutex mutex;
+        std::condition_variable cond;
+        std::thread builder;
+        std::vector<std::thread> workers;
+        int workerCount = 0;                    // 0 = automatic
+        bool stopping = false;
+        std::atomic<bool> cancelBuild{false};
+        std::atomic<int> buildPercent{0};
+
+        PyramidState state = PyramidState::Building;
+        std::vector<std::pair<int, int>> levelSizes;
+
+        std::unordered_map<uint64_t, CacheEntry> tiles;
+        std::list<uint64_t> lru;                // front = most recently used
+        size_t cacheBytes = 0;
+        size_t cacheBudget = kDefaultCacheBudget;
+
+        std::deque<uint64_t> pending;
+        std::unordered_set<uint64_t> pendingSet;
+        std::unordered_set<uint64_t> inFlight;
+        std::unordered_set<uint64_t> wanted;
+        Stats stats;
+
+        // Guards posted onChanged calls against a destroyed pyramid, and
+        // coalesces them while one is still queued.
+        std::shared_ptr<std::atomic<bool>> alive = std::make_shared<std::atomic<bool>>(true);
+        std::shared_ptr<std::atomic<bool>> changePosted = std::make_shared<std::atomic<bool>>(false);
+    };
+
+}
+#endif // ULTRACANVASTILEDIMAGE_H
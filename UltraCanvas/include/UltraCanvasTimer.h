@@ -1,6 +1,11 @@
 // include/UltraCanvasTimer.h
 // Cross-platform timer system for UltraCanvas Framework
 // Supports one-shot and periodic timers with callback or event-based firing
+// Version: 1.1.0
+// Last Modified: 2026-10-18
+// V1.1.0: UltraCanvasTimerQueue — indexed min-heap behind the application's
+//   timers (O(log n) start / stop, O(1) next deadline, slack coalescing).
+// Author: UltraCanvas Framework
 #pragma once
 
 #ifndef ULTRACANVAS_TIMER_H
@@ -9,6 +14,9 @@
 #include <cstdint>
 #include <chrono>
 #include <functional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace UltraCanvas {
 
@@ -26,6 +34,65 @@ namespace UltraCanvas {
         std::function<void(TimerId)> callback;
     };
 
+    // ===== TIMER QUEUE =====
+    // Pending timers ordered by deadline in a binary min-heap that also
+    // records each timer's heap position, so Stop is a sift from a known
+    // slot rather than a search. Costs for n timers:
+    //  - Add / Remove / re-arming a periodic timer: O(log n)
+    //  - NextDeadline: O(1) (the heap top)
+    //  - CollectDue: O(k log n) for the k timers that fire
+    // An idle loop therefore pays nothing per timer, however many animations,
+    // pollers and carets are registered.
+    //
+    // Coalescing: CollectDue also fires timers due within `slack` of now, so
+    // deadlines a fraction of a millisecond apart run in one loop wake-up
+    // instead of one each. Timers fire in deadline order (ties by id).
+    //
+    // Not thread-safe; UltraCanvasApplicationBase guards it with its timer
+    // mutex.
+    class UltraCanvasTimerQueue {
+    public:
+        using Clock = std::chrono::steady_clock;
+        using DueList = std::vector<std::pair<TimerId, std::function<void(TimerId)>>>;
+
+        static constexpr std::chrono::milliseconds kDefaultSlack{1};
+
+        // Adds (or replaces) `timer`; `nextFire` must already be set.
+        void Add(UltraCanvasTimer timer);
+        // False when no such timer is pending.
+        bool Remove(TimerId id);
+        bool Contains(TimerId id) const { return slotOfId.count(id) != 0; }
+        size_t Size() const { return heap.size(); }
+        bool Empty() const { return heap.empty(); }
+        void Clear();
+
+        // Deadline of the earliest timer; time_point::max() when empty.
+        Clock::time_point NextDeadline() const;
+
+        // Appends (id, callback) for every timer due at `now` (plus the
+        // slack) to `due`, earliest first. One-shot timers are removed;
+        // periodic ones are re-armed one interval after their previous
+        // deadline, skipping periods missed while the loop was busy.
+        void CollectDue(Clock::time_point now, DueList& due);
+
+        void SetCoalescingSlack(std::chrono::milliseconds slack) { coalescingSlack = slack; }
+        std::chrono::milliseconds GetCoalescingSlack() const { return coalescingSlack; }
+
+    private:
+        bool Earlier(uint32_t slotA, uint32_t slotB) const;
+        void SiftUp(size_t pos);
+        void SiftDown(size_t pos);
+        void Place(size_t pos, uint32_t slot);
+        void RemoveAt(size_t pos);
+
+        std::vector<UltraCanvasTimer> slots;        // timer storage, reused via freeSlots
+        std::vector<uint32_t> heapPos;              // slot -> position in heap
+        std::vector<uint32_t> freeSlots;
+        std::vector<uint32_t> heap;                 // slots, min-heap on (nextFire, id)
+        std::unordered_map<TimerId, uint32_t> slotOfId;
+        std::chrono::milliseconds coalescingSlack = kDefaultSlack;
+    };
+
 } // namespace UltraCanvas
 
 #endif // ULTRACANVAS_TIMER_H
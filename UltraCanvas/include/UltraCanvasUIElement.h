@@ -5,8 +5,9 @@
 // border *visual* properties, render context, window, tooltip) stay on
 // this class; geometry, box model, identifier, parent link, z-index live
 // on the engine base.
-// Version: 4.0.1
-// Last Modified: 2026-07-13
+// Version: 4.1.0
+// Last Modified: 2026-10-18
+// V4.1.0: opt-in retained layer (SetLayerCaching / RenderWithLayer).
 // Author: UltraCanvas Framework
 #pragma once
 
@@ -109,6 +110,7 @@ namespace UltraCanvas {
         bool isPopup = false;
 
         std::unique_ptr<IRenderContext> renderContext = nullptr;
+        bool layerCaching = false;
         UCMouseCursor mouseCursor = UCMouseCursor::Default;
         std::string tooltip;
         std::shared_ptr<TooltipContent> tooltipContent;  // structured tooltip; wins over `tooltip`
@@ -504,6 +506,20 @@ namespace UltraCanvas {
         // dirtyRect is in element-local coordinates (matches the translated ctx).
         virtual void Render(IRenderContext* ctx, const Rect2Df& dirtyRect);
 
+        // Render through the element's retained layer when layer caching is
+        // on, plain Render otherwise. Containers paint their children with
+        // this; call Render directly to bypass the layer.
+        void RenderWithLayer(IRenderContext* ctx, const Rect2Df& dirtyRect);
+
+        // Layer caching: the subtree is rasterized once into an offscreen
+        // surface (UltraCanvasLayerCache) and composited on later paints,
+        // re-rasterizing only the parts a descendant invalidates. Worth it
+        // for expensive, mostly static content (charts, diagrams, toolbars)
+        // that gets repainted because something nearby changed. Content that
+        // changes without InvalidateRect/RequestRedraw would go stale.
+        void SetLayerCaching(bool enable);
+        bool IsLayerCaching() const { return layerCaching; }
+
         void Arrange(const Rect2Df& newFinalRect, const CSSLayout::LayoutContext& ctx) override;
 
         // ===== EVENT HANDLING =====
@@ -1,7 +1,7 @@
 // include/UltraCanvasWindowBase.h
 // Enhanced abstract base window interface inheriting from UltraCanvasContainer
-// Version: 2.2.0 - window drag overlay (content drawn above all elements)
-// Last Modified: 2026-08-08
+// Version: 2.4.0 - frame profiler overlay
+// Last Modified: 2026-10-18
 // Author: UltraCanvas Framework
 
 #pragma once
@@ -122,6 +122,22 @@ namespace UltraCanvas {
         Rect2Di dragOverlayRect;
         WindowOverlayRenderer dragOverlayRenderer;
 
+        // Window-coordinate areas of nativeSurface the current UpdateAndRender()
+        // changed: dirty content, plus every overlay (popups, caret, tooltip)
+        // where it is now and where it was last frame. Back-ends that upload
+        // pixels to the display server read it in InvalidateWindowNative() to
+        // send only those areas; cleared at the end of every frame.
+        std::vector<Rect2Di> frameDamage;
+        std::vector<Rect2Di> lastOverlayRects;
+
+        // Tiled rasterization (see SetTiledRasterization).
+        bool tiledRasterization = false;
+        int tiledRasterThreads = 0;
+
+        // Panel of the frame profiler's overlay (UltraCanvasFrameProfiler),
+        // built on first use against nativeSurface.
+        std::unique_ptr<IRenderContext> profilerOverlayContext;
+
         UltraCanvasUIElement* _focusedElement = nullptr;  // Current focused element in this window
 
         // True while _focusedElement has been sent FocusGained more recently
@@ -314,6 +330,16 @@ namespace UltraCanvas {
         void ClearDragOverlay(UltraCanvasUIElement* owner);
         bool HasDragOverlay() const { return dragOverlayRenderer != nullptr; }
 
+        // ===== TILED RASTERIZATION =====
+        // Records each frame's content pass into a display list and replays it
+        // into screen tiles on `threads` workers (0 = one per core, at most 8),
+        // each tile rasterizing straight into its part of the window's content
+        // surface. The result is pixel-identical to the serial path. Frames the
+        // recorder can't replay (an element grabbed the native cairo context)
+        // are rendered serially. Pays off on large, busy HiDPI windows.
+        void SetTiledRasterization(bool enable, int threads = 0);
+        bool IsTiledRasterization() const { return tiledRasterization; }
+
         // Overlay elements
         void OpenPopup(const Point2Di& pos, UltraCanvasUIElement& element, const PopupElementSettings& settings);
         bool ClosePopup(UltraCanvasUIElement& element, ClosePopupReason reason=ClosePopupReason::Manual);
@@ -380,6 +406,9 @@ namespace UltraCanvas {
         void RequestWindowComposition() { _needsWindowComposition = true; }
         void RequestCaretComposition() { _needsCaretComposition = true; }
         void UpdateAndRender();
+        // UpdateAndRender() would draw or composite something: dirty rects,
+        // a pending layout / resize / composition, or a popup to repaint.
+        bool NeedsRender() const;
 
         bool IsNeedsResize() const { return _needsResize; }
 
@@ -424,6 +453,14 @@ namespace UltraCanvas {
         void HandleMoveEvent(int x, int y);
 
         // ===== PROTECTED HELPER METHODS =====
+        // One content pass: element tree, custom content and drag overlay,
+        // clipped to each dirty rectangle in turn.
+        void RenderContent(IRenderContext* ctx, const std::vector<Rect2Di>& rects);
+
+        // Draws the frame profiler's overlay top-right onto nativeSurface
+        // and records its area in overlayRects.
+        void CompositeProfilerOverlay(std::vector<Rect2Di>& overlayRects);
+
         virtual void RenderWindowBackground(IRenderContext* ctx) {
             // Default implementation - clear to background color
             // OS-specific implementations can override
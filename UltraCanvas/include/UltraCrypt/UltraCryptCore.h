@@ -23,7 +23,7 @@
 // keyed with Argon2id. AES-256-GCM exists only to read foreign data and is
 // hardware-gated.
 //
-// Version: 0.1.0
+// Version: 0.2.0
 // Author: UltraCanvas Framework / ULTRA OS
 #pragma once
 #ifndef ULTRACRYPTCORE_H
@@ -31,6 +31,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <string>
 #include <vector>
 
@@ -46,7 +47,8 @@ enum class UltraCryptResultCode : uint8_t {
     AuthenticationFailed,  // AEAD tag mismatch: ciphertext, AAD or nonce altered
     EntropyFailure,        // CSPRNG unavailable; never falls back to a PRNG
     BackendUnavailable,    // built without libsodium
-    InternalError
+    InternalError,
+    Cancelled              // a progress callback asked to stop
 };
 
 // Returned by every blocking UltraCrypt_* call. operator bool() reports success
@@ -156,6 +158,10 @@ UltraCryptResult UltraCrypt_Hash(UltraCryptHashAlgorithm algorithm,
                                  const UltraCryptHashOptions& options =
                                      UltraCryptHashOptions());
 
+// Reads the file through a memory mapping (falling back to buffered reads
+// for pipes and other unmappable files). SHA-2 is inherently sequential, so
+// this stays on one core; use UltraCrypt_TreeHashFile where the digest does
+// not have to be a plain SHA-2.
 UltraCryptResult UltraCrypt_HashFile(UltraCryptHashAlgorithm algorithm,
                                      const std::string& filePath,
                                      std::vector<uint8_t>& outDigest);
@@ -185,6 +191,77 @@ private:
     void* state_ = nullptr;
 };
 
+// ============================================================================
+// Tree hashing
+// ============================================================================
+// A parallel content hash for large files (deduplication, integrity checks).
+// Two-level BLAKE2b tree: the input is split into fixed-size leaves that are
+// hashed independently on all cores, and the root hashes the leaf digests:
+//
+//   leaf[i] = BLAKE2b-256(leaf bytes,
+//                         salt = LE64(i) || 0^8, personal = "UCTreeHash-leaf\0")
+//   digest  = BLAKE2b-N(LE64(total size) || LE64(leaf size) || leaf[0] || ...,
+//                       salt = 0^16, personal = "UCTreeHash-root\0")
+//
+// Empty input is one empty leaf. The leaf size is part of the digest, so
+// digests are comparable only between identical parameters — store them
+// with the digest. This is NOT SHA-2 and not interchangeable with
+// UltraCrypt_Hash output.
+struct UltraCryptTreeHashParams {
+    size_t   leafSize   = 1024 * 1024;  // bytes per leaf, at least 1 KiB
+    size_t   digestSize = 32;           // 16..64
+    unsigned threads    = 0;            // 0 = one per hardware thread
+};
+
+UltraCryptResult UltraCrypt_TreeHash(const void* data, size_t size,
+                                     std::vector<uint8_t>& outDigest,
+                                     const UltraCryptTreeHashParams& params =
+                                         UltraCryptTreeHashParams());
+
+// Memory-maps the file and hashes its leaves on all cores.
+UltraCryptResult UltraCrypt_TreeHashFile(const std::string& filePath,
+                                         std::vector<uint8_t>& outDigest,
+                                         const UltraCryptTreeHashParams& params =
+                                             UltraCryptTreeHashParams());
+
+// ----- Batch -----
+struct UltraCryptHashProgress {
+    size_t   filesDone  = 0;
+    size_t   filesTotal = 0;
+    uint64_t bytesDone  = 0;
+    uint64_t bytesTotal = 0;     // sizes as of the start of the batch
+};
+
+struct UltraCryptHashBatchParams {
+    // Tree hash (default) or a plain digest per file via UltraCrypt_HashFile.
+    bool                     treeHash  = true;
+    UltraCryptHashAlgorithm  algorithm = UltraCryptHashAlgorithm::SHA256;
+    UltraCryptTreeHashParams tree;       // tree.threads = 0 splits the cores
+                                         // between the concurrent files
+
+    // Files read at the same time. Bounds I/O parallelism: more helps on
+    // SSDs and with many small files, fewer on spinning disks.
+    unsigned maxConcurrentFiles = 2;
+
+    // Called from worker threads, one call at a time, after each file and
+    // at most every ~100 ms in between. Return false to cancel: files not
+    // finished yet then report Cancelled.
+    std::function<bool(const UltraCryptHashProgress&)> onProgress;
+};
+
+struct UltraCryptFileDigest {
+    std::string          path;
+    std::vector<uint8_t> digest;
+    UltraCryptResult     result;
+};
+
+// Hashes every path; `outDigests` has one entry per path, in order. Returns
+// Success when all files hashed, otherwise the first failure (each entry
+// carries its own result).
+UltraCryptResult UltraCrypt_HashFiles(const std::vector<std::string>& filePaths,
+                                      const UltraCryptHashBatchParams& params,
+                                      std::vector<UltraCryptFileDigest>& outDigests);
+
 // ============================================================================
 // HMAC
 // ============================================================================
@@ -245,6 +322,92 @@ UltraCryptResult UltraCrypt_AeadOpen(const UltraCryptSecureBuffer& key,
                                      const void* ciphertext, size_t size,
                                      UltraCryptSecureBuffer& outPlaintext);
 
+// ============================================================================
+// Streaming AEAD
+// ============================================================================
+// For payloads too large to hold twice in memory (documents, backups). The
+// plaintext is cut into fixed-size chunks, each sealed on its own, so memory
+// stays bounded and chunks are sealed/opened on several threads at once.
+//
+// Stream layout (integers little-endian):
+//
+//   offset size field
+//   0      4    magic "UCSA"
+//   4      1    format version (1)
+//   5      1    AEAD id (1 = XChaCha20-Poly1305)
+//   6      2    reserved (0)
+//   8      4    chunk size, plaintext bytes
+//   12     16   random nonce prefix
+//   28     ...  chunks: ciphertext || 16-byte tag
+//
+// Every chunk but the last carries exactly `chunk size` plaintext bytes; the
+// last carries fewer (possibly none), so it is always shorter. Chunk i is
+// sealed with nonce = prefix || i (7 bytes) || final flag (1 byte) and with
+// the 28-byte header plus the caller's associated data as AAD. Reordering,
+// dropping or duplicating chunks, cutting the stream at a chunk boundary or
+// splicing chunks from another stream all fail authentication: the counter
+// and the final flag are bound into each tag.
+//
+// Only XChaCha20-Poly1305 is supported — the stream is an UltraCanvas-written
+// format, and the 16-byte random prefix needs the 24-byte nonce.
+
+// Pulls input. Fill `buffer` with up to `capacity` bytes and report the count
+// in `outRead`; 0 means end of input. Return false on an I/O error.
+using UltraCryptStreamReader =
+    std::function<bool(uint8_t* buffer, size_t capacity, size_t& outRead)>;
+
+// Pushes output, in order. Return false on an I/O error.
+using UltraCryptStreamWriter =
+    std::function<bool(const uint8_t* data, size_t size)>;
+
+struct UltraCryptStreamParams {
+    UltraCryptAeadAlgorithm algorithm =
+        UltraCryptAeadAlgorithm::XChaCha20Poly1305;
+
+    // Plaintext bytes per chunk. Seal only — Open takes it from the header.
+    uint32_t chunkSize = 64 * 1024;
+
+    // Worker threads; 0 = one per hardware thread.
+    unsigned threads = 0;
+
+    // Chunks held in memory at once, input and output together counted once
+    // (0 = four per worker). Memory use is about 2 x chunksInFlight x chunk
+    // size, whatever the stream length.
+    size_t chunksInFlight = 0;
+
+    // Authenticated with every chunk, never written to the stream.
+    std::vector<uint8_t> associatedData;
+};
+
+size_t UltraCrypt_GetStreamHeaderSize();                 // 28
+size_t UltraCrypt_GetStreamSize(size_t plaintextSize,    // header + chunks
+                                uint32_t chunkSize);
+
+UltraCryptResult UltraCrypt_AeadSealStream(const UltraCryptSecureBuffer& key,
+                                           const UltraCryptStreamParams& params,
+                                           const UltraCryptStreamReader& read,
+                                           const UltraCryptStreamWriter& write);
+
+// The writer only ever receives chunks that verified, in order — but a
+// stream can be cut or altered after chunks that did. Anything written must
+// be discarded unless this returns Success; AuthenticationFailed covers a
+// wrong key, altered data and truncation alike.
+UltraCryptResult UltraCrypt_AeadOpenStream(const UltraCryptSecureBuffer& key,
+                                           const UltraCryptStreamParams& params,
+                                           const UltraCryptStreamReader& read,
+                                           const UltraCryptStreamWriter& write);
+
+// File-to-file conveniences. The output is written next to `outputPath` and
+// renamed into place on success only; on failure nothing is left behind.
+UltraCryptResult UltraCrypt_AeadSealFile(const UltraCryptSecureBuffer& key,
+                                         const UltraCryptStreamParams& params,
+                                         const std::string& inputPath,
+                                         const std::string& outputPath);
+UltraCryptResult UltraCrypt_AeadOpenFile(const UltraCryptSecureBuffer& key,
+                                         const UltraCryptStreamParams& params,
+                                         const std::string& inputPath,
+                                         const std::string& outputPath);
+
 // ============================================================================
 // Key derivation
 // ============================================================================
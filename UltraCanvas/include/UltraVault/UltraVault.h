@@ -12,7 +12,9 @@
 //  - File: a single encrypted vault file. Argon2id-derived key (parameters
 //    stored in the header) and XChaCha20-Poly1305 AEAD via UltraCrypt; the
 //    file header is authenticated as associated data, so tampering with the
-//    stored cost parameters is detected rather than obeyed.
+//    stored cost parameters is detected rather than obeyed. The file is an
+//    append-only log: each Put, Delete or Commit appends one sealed record
+//    and flushes once, and the log is compacted in the background.
 // Platform-native backends (libsecret / Keychain / Credential Manager) are
 // planned and slot in behind this same surface.
 //
@@ -23,7 +25,7 @@
 //  - Secret bytes live in memory only as long as the store is open;
 //    Shutdown() wipes the decrypted state and the derived key.
 //
-// Version: 0.1.0
+// Version: 0.2.0
 // Author: UltraCanvas Framework / ULTRA OS
 #pragma once
 #ifndef ULTRAVAULT_H
@@ -149,6 +151,54 @@ Result Delete(const std::string& key);
 // Keys matching the prefix (all keys for ""), sorted. Empty when closed.
 std::vector<std::string> List(const std::string& prefix = "");
 
+// ============================================================================
+// Batches
+// ============================================================================
+// Stages puts and deletes and commits them as one unit: the file backend
+// appends a single record and flushes to disk once, however many operations
+// the batch holds. Either every operation applies or none does. Operations
+// apply in staging order, so a Delete may follow a Put of the same key.
+class Batch {
+public:
+    struct Operation {
+        enum class Kind : uint8_t { Put, Delete };
+        Kind        kind = Kind::Put;
+        std::string key;
+        SecretValue value;              // Put only
+        SecretAcl   acl;                // Put only
+    };
+
+    Batch() = default;
+    Batch(Batch&&) = default;
+    Batch& operator=(Batch&&) = default;
+    Batch(const Batch&) = delete;
+    Batch& operator=(const Batch&) = delete;
+    ~Batch();                           // wipes staged secret bytes
+
+    void Put(const std::string& key, const SecretValue& value,
+             const SecretAcl& acl = {});
+    void Delete(const std::string& key);
+    void Clear();
+
+    size_t GetSize() const { return operations.size(); }
+    bool   IsEmpty() const { return operations.empty(); }
+    const std::vector<Operation>& GetOperations() const { return operations; }
+
+private:
+    std::vector<Operation> operations;
+};
+
+// Same validation and errors as Put / Delete (InvalidKey, NotFound for a
+// Delete of a key absent at that point of the batch). Clears the batch on
+// success; leaves it untouched on failure.
+Result Commit(Batch& batch);
+
+// Rewrites the vault file as a single snapshot record. The file backend
+// does this on its own, off the calling thread, once the log has grown to
+// twice its compacted size; call it directly before a backup or to reclaim
+// space right away. A no-op for the memory backend.
+Result Compact();
+
 // ============================================================================
 // Bootstrap / migration — not implemented in v0.1
 // ============================================================================
@@ -195,6 +195,10 @@ namespace UltraCanvas {
         return im;
     }
 
+    std::shared_ptr<UCImageRaster> UCImageRaster::PeekCached(const std::string &path) {
+        return g_ImagesCache.GetFromCache(path);
+    }
+
     void UCImageRaster::RemoveFromCache(const std::string &path) {
         // Loaded raster (keyed by the exact path).
         g_ImagesCache.RemoveFromCache(path);
@@ -464,6 +468,11 @@ namespace UltraCanvas {
 #endif
 
     std::string UCImageRaster::MakePixmapCacheKey(int w, int h, ImageFitMode fitMode, float scale) {
+        return MakePixmapCacheKey(fileName, w, h, fitMode, scale);
+    }
+
+    std::string UCImageRaster::MakePixmapCacheKey(const std::string& fileName, int w, int h,
+                                                  ImageFitMode fitMode, float scale) {
         char key[300];
         // Including `scale` prevents 1x and 2x rasterizations of the same
         // file/size from colliding in the shared cache (would otherwise show
@@ -473,6 +482,22 @@ namespace UltraCanvas {
         return std::string(key);
     }
 
+    std::shared_ptr<UCPixmapCairo> UCImageRaster::PeekPixmap(int w, int h, ImageFitMode fitMode, float scale) {
+        if (!errorMessage.empty() || fileName.empty()) {
+            return nullptr;
+        }
+        if (!w || !h) {
+            w = width;
+            h = height;
+        }
+        if (scale <= 0.0f) scale = 1.0f;
+#if HAS_PIXMAPS_CACHE
+        return g_PixmapsCache.GetFromCache(MakePixmapCacheKey(w, h, fitMode, scale));
+#else
+        return nullptr;
+#endif
+    }
+
     std::shared_ptr<UCPixmapCairo> UCImageRaster::GetPixmap(int w, int h, ImageFitMode fitMode, float scale) {
         if (!errorMessage.empty() || fileName.empty()) {
             return nullptr;
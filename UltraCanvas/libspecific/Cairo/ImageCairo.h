@@ -142,6 +142,8 @@ namespace UltraCanvas {
         ~UCImageRaster();
 
         static std::shared_ptr<UCImageRaster> Get(const std::string &path);
+        // Get without the load: the cached image for `path`, or null.
+        static std::shared_ptr<UCImageRaster> PeekCached(const std::string &path);
         // Evict every cached artifact for `path`: the loaded raster, all of its
         // derived pixmaps (every requested size/fit/scale) and, for SVG
         // sources, the parsed document. Use after a file on disk changes so the
@@ -169,6 +171,16 @@ namespace UltraCanvas {
                                                     ImageFitMode fitMode = ImageFitMode::Contain,
                                                     float scale = 1.0f);
         std::string MakePixmapCacheKey(int w, int h, ImageFitMode fitMode, float scale);
+        // The same key for an image that is not loaded yet (file images are
+        // named by their path), e.g. to de-duplicate queued decodes.
+        static std::string MakePixmapCacheKey(const std::string& fileName, int w, int h,
+                                              ImageFitMode fitMode, float scale);
+        // GetPixmap without the decode: the cached pixmap for these
+        // parameters, or null. Never touches libvips, so it is safe to call
+        // from a frame that must not block (see UCImageDecodeService).
+        std::shared_ptr<UCPixmapCairo> PeekPixmap(int width = 0, int height = 0,
+                                                  ImageFitMode fitMode = ImageFitMode::Contain,
+                                                  float scale = 1.0f);
 
         // Get aspect ratio
         float GetAspectRatio() const {
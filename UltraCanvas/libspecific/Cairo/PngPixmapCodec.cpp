@@ -0,0 +1,35 @@
+// libspecific/Cairo/PngPixmapCodec.cpp
+// In-memory PNG encoding of Cairo pixmaps — see the header.
+// Version: 1.0.0
+// Last Modified: 2026-10-18
+// Author: UltraCanvas Framework
+#include "PngPixmapCodec.h"
+#include <cairo/cairo.h>
+
+namespace UltraCanvas {
+
+    namespace {
+        cairo_status_t AppendToVector(void* closure, const unsigned char* data,
+                                      unsigned int length) {
+            auto* out = static_cast<std::vector<uint8_t>*>(closure);
+            out->insert(out->end(), data, data + length);
+            return CAIRO_STATUS_SUCCESS;
+        }
+    }
+
+    std::vector<uint8_t> PngEncodePixmap(UCPixmapCairo& pixmap) {
+        std::vector<uint8_t> out;
+        cairo_surface_t* surface = pixmap.GetSurface();
+        if (!surface || pixmap.GetRawWidth() <= 0 || pixmap.GetRawHeight() <= 0) {
+            return out;
+        }
+        // Cairo un-premultiplies and reorders to RGBA on the way out.
+        pixmap.Flush();
+        if (cairo_surface_write_to_png_stream(surface, AppendToVector, &out)
+                != CAIRO_STATUS_SUCCESS) {
+            out.clear();
+        }
+        return out;
+    }
+
+}
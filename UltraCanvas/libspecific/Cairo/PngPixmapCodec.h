@@ -0,0 +1,26 @@
+// libspecific/Cairo/PngPixmapCodec.h
+// PNG encoding of Cairo ARGB32 pixmaps into memory, for producers that hand
+// finished thumbnails to the persistent thumbnail store
+// (UltraCanvasThumbnailStore.h). Decoding goes the regular way —
+// UCImage::LoadFromMemory on the bytes.
+// Version: 1.0.0
+// Last Modified: 2026-10-18
+// Author: UltraCanvas Framework
+#pragma once
+#ifndef PNGPIXMAPCODEC_H
+#define PNGPIXMAPCODEC_H
+// UltraCanvasImage.h pulls in ImageCairo.h in the correct order (including
+// ImageCairo.h directly here would recurse into a half-parsed header).
+#include "UltraCanvasImage.h"
+#include <cstdint>
+#include <vector>
+
+namespace UltraCanvas {
+
+    // Encode the pixmap's raw pixels (device scale is not recorded) as a
+    // straight-alpha RGBA PNG. Returns an empty vector on failure. Thread-safe
+    // for distinct pixmaps; the pixmap must not be mutated concurrently.
+    std::vector<uint8_t> PngEncodePixmap(UCPixmapCairo& pixmap);
+
+}
+#endif // PNGPIXMAPCODEC_H
@@ -1,13 +1,15 @@
 // libspecific/Cairo/RenderContextCairo.cpp
 // Cairo support implementation for UltraCanvas Framework
-// Version: 1.0.10 - Text/circle/arc primitives no longer leak or inherit a cairo current point (stray connecting lines)
-// Last Modified: 2026-07-10
+// Version: 1.0.13 - frame profiler draw-call and text-layout counters
+// Version: 1.0.12 - display lists (BeginDisplayList/EndDisplayList) with tiled parallel replay; image-backed surfaces
+// Last Modified: 2026-10-18
 // Author: UltraCanvas Framework
 
 #include "UltraCanvasApplication.h"
 #include "UltraCanvasUtils.h"
 #include "UCTextLayout.h"
 #include "../libspecific/Cairo/RenderContextCairo.h"
+#include "../libspecific/Cairo/RenderContextCairoRecorder.h"
 #include <cstring>
 #include <cmath>
 #include <sstream>
@@ -153,8 +155,6 @@ namespace UltraCanvas {
 
 
     bool RenderContextCairo::CreateSurface(const Size2Di & sz, NativeSurfacePtr createSimilarToSurface) {
-        auto oldCairoSurface = surface;
-
         // If we are creating sub-surface (e.g. popup) similar to a HiDPI parent
         // (Retina backing scale 2.0+), inherit that scale so the sub-surface
         // also rasterizes at backing pixel resolution and composes back onto
@@ -168,29 +168,40 @@ namespace UltraCanvas {
             if (parentSy <= 0.0) parentSy = 1.0;
         }
 
+        cairo_surface_t* newSurface = nullptr;
         if (createSimilarToSurface) {
             // cairo_surface_create_similar takes raw (device-pixel) dimensions.
             // We want the new surface to present `sz.width × sz.height` user
             // units at the parent's scale — so allocate sz * scale raw pixels.
             const int rawW = static_cast<int>(sz.width * parentSx);
             const int rawH = static_cast<int>(sz.height * parentSy);
-            surface = cairo_surface_create_similar(static_cast<cairo_surface_t *>(createSimilarToSurface),
+            newSurface = imageBacked
+                    ? cairo_surface_create_similar_image(static_cast<cairo_surface_t *>(createSimilarToSurface),
+                                                         CAIRO_FORMAT_ARGB32, rawW, rawH)
+                    : cairo_surface_create_similar(static_cast<cairo_surface_t *>(createSimilarToSurface),
                                                    CAIRO_CONTENT_COLOR_ALPHA, rawW, rawH);
         } else {
-            surface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, sz.width, sz.height);
+            newSurface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, sz.width, sz.height);
         }
 
-        if (cairo_surface_status(surface) != CAIRO_STATUS_SUCCESS) {
+        if (cairo_surface_status(newSurface) != CAIRO_STATUS_SUCCESS) {
             debugOutput << "RenderContextCairo::CreateSurface: Can't create surface" << std::endl;
+            cairo_surface_destroy(newSurface);
             return false;
         }
 
         // Cairo versions differ on whether create_similar inherits device_scale;
         // set it explicitly so the new surface always presents `sz` user units.
         if (createSimilarToSurface && (parentSx != 1.0 || parentSy != 1.0)) {
-            cairo_surface_set_device_scale(surface, parentSx, parentSy);
+            cairo_surface_set_device_scale(newSurface, parentSx, parentSy);
         }
 
+        return AdoptSurface(newSurface, sz);
+    }
+
+    bool RenderContextCairo::AdoptSurface(cairo_surface_t* newSurface, const Size2Di& sz) {
+        auto oldCairoSurface = surface;
+        surface = newSurface;
         surfaceSize = sz;
 
         if (pangoContext) {
@@ -265,7 +276,9 @@ namespace UltraCanvas {
         // Apply configurable text rendering font options
         ApplyPangoFontOptions();
 
-        g_Instances.push_back(this);
+        if (std::find(g_Instances.begin(), g_Instances.end(), this) == g_Instances.end()) {
+            g_Instances.push_back(this);
+        }
 
         // Initialize default state
         debugOutput << "RenderContextCairo: Initialization complete" << std::endl;
@@ -275,6 +288,9 @@ namespace UltraCanvas {
     RenderContextCairo::~RenderContextCairo() {
         debugOutput << "RenderContextCairo: Destroying..." << std::endl;
 
+        // Stops the replay workers and releases the tile contexts first.
+        recorder.reset();
+
         g_Instances.erase(std::remove(g_Instances.begin(), g_Instances.end(), this), g_Instances.end());
 
         // Clear the state stack to prevent any pending cairo operations
@@ -723,6 +739,7 @@ namespace UltraCanvas {
 
         // Try to get from cache first
         auto cached = g_TextLayoutsCache.GetFromCache(cacheKey);
+        if (profiled && UltraCanvasFrameProfiler::IsActive()) UltraCanvasFrameProfiler::CountTextLayout(cached != nullptr);
         if (cached) {
             return cached;
         }
@@ -759,9 +776,15 @@ namespace UltraCanvas {
     void RenderContextCairo::DrawTextLayout(ITextLayout &layout, const Point2Dd &pos) {
         auto extents = layout.GetLayoutExtents();
 //        debugOutput << "RenderContextCairo::DrawTextLayout txt=" << layout.GetText() << " pos=" << pos.x << "," << pos.y << " offset=" << layout.GetLayoutVerticalOffset() <<  " extents=" << extents.logical.x << "," << extents.logical.y << " " << extents.logical.width << "x" << extents.logical.height << " ink=" << extents.ink.x << "," << extents.ink.y << " " << extents.ink.width << "x" << extents.ink.height << std::endl;
-        cairo_move_to(cairo, pos.x, pos.y + layout.GetLayoutVerticalOffset());
+        DrawPangoLayout(static_cast<PangoLayout *>(layout.GetHandle()),
+                        {pos.x, pos.y + layout.GetLayoutVerticalOffset()});
+    }
+
+    void RenderContextCairo::DrawPangoLayout(PangoLayout* layout, const Point2Dd& pos) {
+        CountDraw();
+        cairo_move_to(cairo, pos.x, pos.y);
         ApplySourceToCairo(cairo, currentState.textSourceColor, currentState.textSourcePattern);
-        pango_cairo_show_layout(cairo, static_cast<PangoLayout *>(layout.GetHandle()));
+        pango_cairo_show_layout(cairo, layout);
         // Drop the current point set by cairo_move_to; otherwise a following
         // cairo_arc-based primitive connects it to the arc with a stray line.
         cairo_new_path(cairo);
@@ -846,6 +869,7 @@ namespace UltraCanvas {
 
 // ===== UTILITY FUNCTIONS =====
     void RenderContextCairo::Clear(const Color &color) {
+        CountDraw();
         cairo_save(cairo);
         cairo_set_operator(cairo, CAIRO_OPERATOR_SOURCE);
         SetCairoColor(color);
@@ -1655,6 +1679,7 @@ namespace UltraCanvas {
     }
 
     void RenderContextCairo::FillText(const std::string& text, double x, double y) {
+        CountDraw();
         ApplyFillSource();
         cairo_select_font_face(cairo, currentState.fontStyle.fontFamily.c_str(),
                                currentState.fontStyle.fontSlant == FontSlant::Oblique ? CAIRO_FONT_SLANT_OBLIQUE : (currentState.fontStyle.fontSlant == FontSlant::Italic ? CAIRO_FONT_SLANT_ITALIC : CAIRO_FONT_SLANT_NORMAL),
@@ -1668,6 +1693,7 @@ namespace UltraCanvas {
     }
 
     void RenderContextCairo::StrokeText(const std::string& text, double x, double y) {
+        CountDraw();
         ApplyStrokeSource();
         cairo_select_font_face(cairo, currentState.fontStyle.fontFamily.c_str(),
                                currentState.fontStyle.fontSlant == FontSlant::Oblique ? CAIRO_FONT_SLANT_OBLIQUE : (currentState.fontStyle.fontSlant == FontSlant::Italic ? CAIRO_FONT_SLANT_ITALIC : CAIRO_FONT_SLANT_NORMAL),
@@ -1783,16 +1809,19 @@ namespace UltraCanvas {
     }
 
     void RenderContextCairo::DrawPixmap(UCPixmap& pixmap, const Rect2Dd& rect, ImageFitMode fitMode) {
+        CountDraw();
         DrawPixmapOrMask(cairo, pixmap, rect.x, rect.y, rect.width, rect.height, fitMode,
                          currentState.globalAlpha, false, Colors::Transparent);
     }
 
     void RenderContextCairo::DrawMask(const Color& c, UCPixmap& mask, const Rect2Dd& rect, ImageFitMode fitMode) {
+        CountDraw();
         DrawPixmapOrMask(cairo, mask, rect.x, rect.y, rect.width, rect.height, fitMode,
                          currentState.globalAlpha, true, c);
     }
 
     void RenderContextCairo::DrawPartOfPixmap(UCPixmap & pixmap, const Rect2Dd &srcRect, const Rect2Dd &destRect) {
+        CountDraw();
         try {
             // Validate source rectangle bounds
             if (srcRect.x < 0 || srcRect.y < 0 ||
@@ -1838,6 +1867,7 @@ namespace UltraCanvas {
     }
 
     void RenderContextCairo::DrawImageTiled(std::shared_ptr<UCImage> image, float x, float y, float w, float h) {
+        CountDraw();
         try {
             if (!image->IsValid()) return;
             auto pixmap = image->GetPixmap();
@@ -1900,21 +1930,25 @@ namespace UltraCanvas {
     }
 
     void RenderContextCairo::FillPathPreserve() {
+        CountDraw();
         ApplySource(currentState.fillSourceColor, currentState.fillSourcePattern);
         cairo_fill_preserve(cairo);
     }
 
     void RenderContextCairo::StrokePathPreserve() {
+        CountDraw();
         ApplySource(currentState.strokeSourceColor, currentState.strokeSourcePattern);
         cairo_stroke_preserve(cairo);
     }
 
     void RenderContextCairo::Stroke() {
+        CountDraw();
         ApplySource(currentState.strokeSourceColor, currentState.strokeSourcePattern);
         cairo_stroke(cairo);
     }
 
     void RenderContextCairo::Fill() {
+        CountDraw();
         ApplySource(currentState.fillSourceColor, currentState.fillSourcePattern);
         cairo_fill(cairo);
     }
@@ -1978,10 +2012,71 @@ namespace UltraCanvas {
         cairo_destroy(toCtx);
     }
 
+    bool RenderContextCairo::DrawContextSurface(IRenderContext& source, const Point2Dd& pos) {
+        auto* src = dynamic_cast<RenderContextCairo*>(&source);
+        if (!src || !src->surface || src == this) return false;
+        return DrawCairoSurface(src->surface, src->surfaceSize, pos);
+    }
+
+    bool RenderContextCairo::DrawCairoSurface(cairo_surface_t* source, const Size2Di& size, const Point2Dd& pos) {
+        CountDraw();
+        if (!source || source == surface) return false;
+        cairo_surface_flush(source);
+        cairo_save(cairo);
+        cairo_rectangle(cairo, pos.x, pos.y, size.width, size.height);
+        cairo_clip(cairo);
+        cairo_set_source_surface(cairo, source, pos.x, pos.y);
+        cairo_set_operator(cairo, CAIRO_OPERATOR_OVER);
+        cairo_paint_with_alpha(cairo, currentState.globalAlpha);
+        cairo_restore(cairo);
+        return true;
+    }
+
+    // ===== DISPLAY LISTS =====
+    IRenderContext* RenderContextCairo::BeginDisplayList() {
+        if (!surface || cairo_surface_get_type(surface) != CAIRO_SURFACE_TYPE_IMAGE) return nullptr;
+        if (!recorder) recorder = std::make_unique<RenderContextCairoRecorder>(*this);
+        return recorder->Begin() ? recorder.get() : nullptr;
+    }
+
+    bool RenderContextCairo::EndDisplayList(const std::vector<Rect2Di>& regions, int threads) {
+        return recorder && recorder->Rasterize(regions, threads);
+    }
+
+    void RenderContextCairo::InheritState(const RenderContextCairo& from) {
+        currentState = from.currentState;
+        stateStack.clear();
+        if (!cairo || !from.cairo) return;
+
+        cairo_matrix_t matrix;
+        cairo_get_matrix(from.cairo, &matrix);
+        cairo_set_matrix(cairo, &matrix);
+        cairo_reset_clip(cairo);
+        cairo_new_path(cairo);
+        cairo_set_source(cairo, cairo_get_source(from.cairo));
+        cairo_set_operator(cairo, cairo_get_operator(from.cairo));
+        cairo_set_antialias(cairo, cairo_get_antialias(from.cairo));
+        cairo_set_tolerance(cairo, cairo_get_tolerance(from.cairo));
+        cairo_set_fill_rule(cairo, cairo_get_fill_rule(from.cairo));
+        cairo_set_line_width(cairo, cairo_get_line_width(from.cairo));
+        cairo_set_line_cap(cairo, cairo_get_line_cap(from.cairo));
+        cairo_set_line_join(cairo, cairo_get_line_join(from.cairo));
+        cairo_set_miter_limit(cairo, cairo_get_miter_limit(from.cairo));
+        const int dashes = cairo_get_dash_count(from.cairo);
+        std::vector<double> dash(static_cast<size_t>(dashes));
+        double dashOffset = 0.0;
+        if (dashes > 0) cairo_get_dash(from.cairo, dash.data(), &dashOffset);
+        cairo_set_dash(cairo, dash.data(), dashes, dashOffset);
+        cairo_matrix_t fontMatrix;
+        cairo_get_font_matrix(from.cairo, &fontMatrix);
+        cairo_set_font_matrix(cairo, &fontMatrix);
+    }
 
     // factory
-    std::unique_ptr<IRenderContext> CreateRenderContext(const Size2Di& sz, NativeSurfacePtr similarToSurface) {
+    std::unique_ptr<IRenderContext> CreateRenderContext(const Size2Di& sz, NativeSurfacePtr similarToSurface,
+                                                        bool imageBacked) {
         auto ctx = std::make_unique<RenderContextCairo>();
+        ctx->SetImageBacked(imageBacked);
         if (ctx->CreateSurface(sz, similarToSurface)) {
             return ctx;
         } else {
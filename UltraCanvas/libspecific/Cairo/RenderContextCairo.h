@@ -1,7 +1,7 @@
 // libspecific/Cairo/RenderContextCairo.h
 // Cairo support implementation for UltraCanvas Framework
-// Version: 1.0.5 - Rect-based DrawPixmap/DrawMask
-// Last Modified: 2026-04-11
+// Version: 1.0.8 - draw-call and text-layout counters for the frame profiler
+// Last Modified: 2026-10-18
 // Author: UltraCanvas Framework
 //
 
@@ -13,6 +13,7 @@
 // ===== CORE INCLUDES =====
 #include "UltraCanvasRenderContext.h"
 #include "UltraCanvasEvent.h"
+#include "UltraCanvasFrameProfiler.h"
 
 #include <cairo/cairo.h>
 #include <pango/pangocairo.h>
@@ -46,6 +47,8 @@ namespace UltraCanvas {
         void* GetHandle() override { return pattern; };
     };
 
+    class RenderContextCairoRecorder;
+
     class RenderContextCairo : public IRenderContext {
     private:
         cairo_t *cairo = nullptr;
@@ -85,10 +88,36 @@ namespace UltraCanvas {
 
         std::string GenerateTextCacheKey(const std::string& text, const Size2Di &sz, bool isMarkup);
 
+        // Surfaces similar to a native surface are created as client-memory
+        // image surfaces (see CreateRenderContext's imageBacked).
+        bool imageBacked = false;
+        // Created by the first BeginDisplayList.
+        std::unique_ptr<RenderContextCairoRecorder> recorder;
+
+        // Whether draws on this context count toward the frame profiler's
+        // totals. Off for contexts whose work is already counted elsewhere
+        // (display-list shadow and tile replay contexts).
+        bool profiled = true;
+        void CountDraw() const {
+            if (profiled && UltraCanvasFrameProfiler::IsActive()) UltraCanvasFrameProfiler::CountDrawCall();
+        }
+
     public:
         ~RenderContextCairo() override;
 
         bool CreateSurface(const Size2Di & sz, NativeSurfacePtr createSimilarToSurface) override;
+        void SetImageBacked(bool backed) { imageBacked = backed; }
+        void SetProfiled(bool enable) { profiled = enable; }
+        // Render into `newSurface` (ownership is taken, also on failure),
+        // presenting `sz` logical units.
+        bool AdoptSurface(cairo_surface_t* newSurface, const Size2Di& sz);
+        // Start drawing with `from`'s render state and cairo drawing
+        // parameters, no clip and an empty path.
+        void InheritState(const RenderContextCairo& from);
+        const RenderState& GetRenderState() const { return currentState; }
+
+        IRenderContext* BeginDisplayList() override;
+        bool EndDisplayList(const std::vector<Rect2Di>& regions, int threads) override;
 
         bool ResizeSurface(const Size2Di& sz) override;
         Size2Di GetSurfaceSize() const override { return surfaceSize; }
@@ -102,6 +131,10 @@ namespace UltraCanvas {
             cairo_surface_get_device_scale(surface, &sx, &sy);
             return static_cast<float>(sx > 0.0 ? sx : 1.0);
         }
+        NativeSurfacePtr GetNativeSurface() const override { return surface; }
+        bool DrawContextSurface(IRenderContext& source, const Point2Dd& pos) override;
+        // DrawContextSurface for a raw surface presenting `size` logical units.
+        bool DrawCairoSurface(cairo_surface_t* source, const Size2Di& size, const Point2Dd& pos);
 
         // ===== INHERITED FROM IRenderContext =====
         // State management
@@ -228,6 +261,8 @@ namespace UltraCanvas {
         std::shared_ptr<ITextLayout> GetOrCreateTextLayout(const std::string& text, const Size2Di& sz, bool isMarkup) override;
 
         void DrawTextLayout(ITextLayout &layout, const Point2Dd &pos) override;
+        // DrawTextLayout with the layout's vertical offset already applied.
+        void DrawPangoLayout(PangoLayout* layout, const Point2Dd& pos);
         void DrawText(const std::string &text, const Point2Dd &pos) override;
         void DrawTextInRect(const std::string &text, const Rect2Dd &rect) override;
         void DrawTextInRect(const std::string &text, const Rect2Dd &rect, bool isMarkup) override;
@@ -0,0 +1,808 @@
+// libspecific/Cairo/RenderContextCairoRecorder.cpp
+// Display-list recording and tiled parallel replay for the Cairo backend
+// Version: 1.1.0 - draw calls are counted for the frame profiler when recorded
+// Last Modified: 2026-10-18
+// Author: UltraCanvas Framework
+
+#include "RenderContextCairoRecorder.h"
+#include "UltraCanvasRasterTiles.h"
+#include "UltraCanvasDebug.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace UltraCanvas {
+
+    // Held by every replay of a serial command, across all windows: the text
+    // layout cache and Pango are process-wide.
+    static std::mutex g_SerialReplayMutex;
+
+    // Attached to alias surfaces so the parent's pixel memory outlives them.
+    static cairo_user_data_key_t g_AliasParentKey;
+
+    // An image surface over `px` (device pixels) of `parent`'s memory that
+    // presents the parent's logical coordinates: drawing at a given user
+    // position lands on the same parent pixel as it would on the parent.
+    static cairo_surface_t* CreateAliasSurface(cairo_surface_t* parent, const Rect2Di& px) {
+        unsigned char* data = cairo_image_surface_get_data(parent);
+        const int stride = cairo_image_surface_get_stride(parent);
+        const cairo_format_t format = cairo_image_surface_get_format(parent);
+        if (!data || format != CAIRO_FORMAT_ARGB32) return nullptr;
+
+        cairo_surface_t* alias = cairo_image_surface_create_for_data(
+                data + static_cast<size_t>(px.y) * stride + static_cast<size_t>(px.x) * 4,
+                format, px.width, px.height, stride);
+        if (cairo_surface_status(alias) != CAIRO_STATUS_SUCCESS) {
+            cairo_surface_destroy(alias);
+            return nullptr;
+        }
+        double sx = 1.0, sy = 1.0;
+        cairo_surface_get_device_scale(parent, &sx, &sy);
+        cairo_surface_set_device_scale(alias, sx, sy);
+        cairo_surface_set_device_offset(alias, -px.x, -px.y);
+        cairo_surface_set_user_data(alias, &g_AliasParentKey, cairo_surface_reference(parent),
+                                    reinterpret_cast<cairo_destroy_func_t>(cairo_surface_destroy));
+        return alias;
+    }
+
+    static bool Overlaps(const Rect2Di& a, const Rect2Di& b) {
+        return a.x < b.x + b.width && b.x < a.x + a.width &&
+               a.y < b.y + b.height && b.y < a.y + a.height;
+    }
+
+    // ===== TILE WORKERS =====
+    CairoTileWorkers::CairoTileWorkers(int threads) {
+        for (int i = 1; i < threads; i++) {
+            workers.emplace_back([this]() { WorkerMain(); });
+        }
+    }
+
+    CairoTileWorkers::~CairoTileWorkers() {
+        {
+            std::lock_guard<std::mutex> lk(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (auto& t : workers) t.join();
+    }
+
+    void CairoTileWorkers::Run(int count, const std::function<void(int)>& fn) {
+        if (count <= 0) return;
+        {
+            std::lock_guard<std::mutex> lk(mutex);
+            job = &fn;
+            jobCount = count;
+            nextIndex.store(0);
+            busy = static_cast<int>(workers.size());
+            generation++;
+        }
+        wake.notify_all();
+        Drain();
+
+        std::unique_lock<std::mutex> lk(mutex);
+        done.wait(lk, [this]() { return busy == 0; });
+        job = nullptr;
+    }
+
+    void CairoTileWorkers::Drain() {
+        for (int i = nextIndex.fetch_add(1); i < jobCount; i = nextIndex.fetch_add(1)) {
+            (*job)(i);
+        }
+    }
+
+    void CairoTileWorkers::WorkerMain() {
+        uint64_t seen = 0;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lk(mutex);
+                wake.wait(lk, [&]() { return stopping || generation != seen; });
+                if (stopping) return;
+                seen = generation;
+            }
+            Drain();
+            {
+                std::lock_guard<std::mutex> lk(mutex);
+                busy--;
+            }
+            done.notify_one();
+        }
+    }
+
+    // ===== RECORDER =====
+    RenderContextCairoRecorder::RenderContextCairoRecorder(RenderContextCairo& target)
+            : target(target) {
+    }
+
+    RenderContextCairoRecorder::~RenderContextCairoRecorder() {
+        Discard();
+        tileContexts.clear();
+        if (tileSurfaceOwner) cairo_surface_destroy(tileSurfaceOwner);
+    }
+
+    bool RenderContextCairoRecorder::Begin() {
+        Discard();
+        cairo_surface_t* surface = target.GetCairoSurface();
+        if (!surface || cairo_surface_get_type(surface) != CAIRO_SURFACE_TYPE_IMAGE) return false;
+
+        // The shadow aliases the target's memory: same surface type, font
+        // options and bounds, so queries match the target exactly. Nothing is
+        // ever drawn through it.
+        if (!shadow || shadow->GetCairoSurface() == nullptr || shadowOwner != surface) {
+            shadow.reset();
+            const Rect2Di whole(0, 0, cairo_image_surface_get_width(surface),
+                                cairo_image_surface_get_height(surface));
+            cairo_surface_t* alias = CreateAliasSurface(surface, whole);
+            if (!alias) return false;
+            auto ctx = std::make_unique<RenderContextCairo>();
+            if (!ctx->AdoptSurface(alias, target.GetSurfaceSize())) return false;
+            shadow = std::move(ctx);
+            shadowOwner = surface;
+        }
+        shadow->InheritState(target);
+
+        const RenderState& state = target.GetRenderState();
+        paint.fillSurface = state.fillSourceColor.a == 0 && IsSurfacePattern(state.fillSourcePattern);
+        paint.strokeSurface = state.strokeSourceColor.a == 0 && IsSurfacePattern(state.strokeSourcePattern);
+        paint.textSurface = state.textSourceColor.a == 0 && IsSurfacePattern(state.textSourcePattern);
+        return true;
+    }
+
+    void RenderContextCairoRecorder::Discard() {
+        layouts.clear();
+        commands.clear();
+        paint = PaintState();
+        paintStack.clear();
+        replayable = true;
+    }
+
+    Rect2Di RenderContextCairoRecorder::CurrentClipBounds() const {
+        cairo_t* cr = shadow->GetCairo();
+        double x1, y1, x2, y2;
+        cairo_clip_extents(cr, &x1, &y1, &x2, &y2);
+        if (x2 <= x1 || y2 <= y1) return Rect2Di();
+
+        double minX = HUGE_VAL, minY = HUGE_VAL, maxX = -HUGE_VAL, maxY = -HUGE_VAL;
+        const double xs[] = {x1, x2, x1, x2};
+        const double ys[] = {y1, y1, y2, y2};
+        for (int i = 0; i < 4; i++) {
+            double x = xs[i], y = ys[i];
+            cairo_user_to_device(cr, &x, &y);
+            minX = std::min(minX, x); maxX = std::max(maxX, x);
+            minY = std::min(minY, y); maxY = std::max(maxY, y);
+        }
+        // The CTM excludes the surface's device scale.
+        const double s = target.GetDeviceScale();
+        const int left = static_cast<int>(std::floor(minX * s)) - 1;
+        const int top = static_cast<int>(std::floor(minY * s)) - 1;
+        const int right = static_cast<int>(std::ceil(maxX * s)) + 1;
+        const int bottom = static_cast<int>(std::ceil(maxY * s)) + 1;
+        return Rect2Di(left, top, right - left, bottom - top);
+    }
+
+    void RenderContextCairoRecorder::RecordState(Op op) {
+        op(*shadow);
+        commands.push_back({std::move(op), Rect2Di(), Effect::State, false});
+    }
+
+    void RenderContextCairoRecorder::RecordDraw(Op op, Effect effect, bool serial) {
+        if (UltraCanvasFrameProfiler::IsActive()) UltraCanvasFrameProfiler::CountDrawCall();
+        const Rect2Di bounds = CurrentClipBounds();
+        if (effect == Effect::DrawClearsPath) shadow->ClearPath();
+        if (bounds.width <= 0 || bounds.height <= 0) {
+            // Fully clipped: only the path effect remains.
+            if (effect == Effect::DrawClearsPath) {
+                commands.push_back({[](RenderContextCairo& c) { c.ClearPath(); }, Rect2Di(), Effect::State, false});
+            }
+            return;
+        }
+        commands.push_back({std::move(op), bounds, effect, serial});
+    }
+
+    bool RenderContextCairoRecorder::IsSurfacePattern(const std::shared_ptr<IPaintPattern>& pattern) {
+        if (!pattern) return false;
+        auto handle = static_cast<cairo_pattern_t*>(pattern->GetHandle());
+        if (!handle) return false;
+        const cairo_pattern_type_t type = cairo_pattern_get_type(handle);
+        return type == CAIRO_PATTERN_TYPE_SURFACE || type == CAIRO_PATTERN_TYPE_RASTER_SOURCE;
+    }
+
+    std::shared_ptr<UCPixmap> RenderContextCairoRecorder::RetainPixmap(UCPixmap& pixmap) {
+        if (!pixmap.GetSurface()) return nullptr;
+        auto retained = std::make_shared<UCPixmap>(cairo_surface_reference(pixmap.GetSurface()));
+        if (pixmap.GetDeviceScale() != 1.0) retained->SetDeviceScale(pixmap.GetDeviceScale());
+        return retained;
+    }
+
+    void RenderContextCairoRecorder::PrepareTiles(const std::vector<Rect2Di>& tiles) {
+        cairo_surface_t* surface = target.GetCairoSurface();
+        if (tileSurfaceOwner != surface) {
+            tileContexts.clear();
+            if (tileSurfaceOwner) cairo_surface_destroy(tileSurfaceOwner);
+            tileSurfaceOwner = cairo_surface_reference(surface);
+        }
+        for (const auto& tile : tiles) {
+            const uint64_t key = (static_cast<uint64_t>(static_cast<uint32_t>(tile.x)) << 32) |
+                                 static_cast<uint32_t>(tile.y);
+            auto& ctx = tileContexts[key];
+            if (!ctx) {
+                cairo_surface_t* alias = CreateAliasSurface(surface, tile);
+                if (!alias) continue;
+                ctx = std::make_unique<RenderContextCairo>();
+                if (!ctx->AdoptSurface(alias, target.GetSurfaceSize())) {
+                    ctx.reset();
+                    continue;
+                }
+                // Counted once in RecordDraw, not again per tile.
+                ctx->SetProfiled(false);
+            }
+            ctx->InheritState(target);
+        }
+    }
+
+    bool RenderContextCairoRecorder::Rasterize(const std::vector<Rect2Di>& regions, int threads) {
+        if (!replayable) {
+            Discard();
+            return false;
+        }
+        // A layout edited after it was drawn would replay its new content.
+        for (const auto& [layout, serial] : layouts) {
+            if (pango_layout_get_serial(layout) != serial) {
+                Discard();
+                return false;
+            }
+        }
+
+        cairo_surface_t* surface = target.GetCairoSurface();
+        const Size2Di pixels(cairo_image_surface_get_width(surface), cairo_image_surface_get_height(surface));
+        const std::vector<Rect2Di> tiles = BuildRasterTiles(regions, target.GetDeviceScale(), pixels);
+
+        if (threads <= 0) {
+            threads = std::clamp(static_cast<int>(std::thread::hardware_concurrency()), 1, 8);
+        }
+        threads = std::min<int>(threads, static_cast<int>(std::max<size_t>(tiles.size(), 1)));
+        if (!workers || workers->GetThreadCount() != threads) {
+            workers = std::make_unique<CairoTileWorkers>(threads);
+        }
+
+        cairo_surface_flush(surface);
+        PrepareTiles(tiles);
+
+        std::vector<RenderContextCairo*> contexts(tiles.size(), nullptr);
+        bool complete = true;
+        for (size_t i = 0; i < tiles.size(); i++) {
+            const uint64_t key = (static_cast<uint64_t>(static_cast<uint32_t>(tiles[i].x)) << 32) |
+                                 static_cast<uint32_t>(tiles[i].y);
+            auto found = tileContexts.find(key);
+            if (found == tileContexts.end() || !found->second) {
+                complete = false;
+                break;
+            }
+            contexts[i] = found->second.get();
+        }
+        if (!complete) {
+            Discard();
+            return false;
+        }
+
+        workers->Run(static_cast<int>(tiles.size()), [&](int index) {
+            RenderContextCairo& ctx = *contexts[index];
+            const Rect2Di& tile = tiles[index];
+            for (const Command& cmd : commands) {
+                if (cmd.effect != Effect::State && !Overlaps(cmd.bounds, tile)) {
+                    if (cmd.effect == Effect::DrawClearsPath) ctx.ClearPath();
+                    continue;
+                }
+                if (cmd.serial) {
+                    std::lock_guard<std::mutex> lk(g_SerialReplayMutex);
+                    cmd.op(ctx);
+                } else {
+                    cmd.op(ctx);
+                }
+            }
+            cairo_surface_flush(ctx.GetCairoSurface());
+        });
+
+        cairo_surface_mark_dirty(surface);
+        Discard();
+        return true;
+    }
+
+    // ===== SURFACE =====
+    bool RenderContextCairoRecorder::CreateSurface(const Size2Di&, NativeSurfacePtr) {
+        return false;
+    }
+
+    bool RenderContextCairoRecorder::ResizeSurface(const Size2Di&) {
+        return false;
+    }
+
+    // Immediate copies can't be ordered against the recording.
+    void RenderContextCairoRecorder::FlushToSurface(NativeSurfacePtr, const Point2Dd&) {
+        replayable = false;
+    }
+
+    void RenderContextCairoRecorder::CompositeToSurface(NativeSurfacePtr, const Point2Dd&) {
+        replayable = false;
+    }
+
+    void RenderContextCairoRecorder::FlushRegionToSurface(NativeSurfacePtr, const Rect2Dd&, const Point2Dd&) {
+        replayable = false;
+    }
+
+    bool RenderContextCairoRecorder::DrawContextSurface(IRenderContext& source, const Point2Dd& pos) {
+        auto* src = dynamic_cast<RenderContextCairo*>(&source);
+        if (!src || !src->GetCairoSurface() || src == &target) return false;
+        std::shared_ptr<cairo_surface_t> retained(cairo_surface_reference(src->GetCairoSurface()),
+                                                  cairo_surface_destroy);
+        const Size2Di size = src->GetSurfaceSize();
+        RecordDraw([retained, size, pos](RenderContextCairo& c) { c.DrawCairoSurface(retained.get(), size, pos); },
+                   Effect::DrawClearsPath, true);
+        return true;
+    }
+
+    // ===== STATE =====
+    void RenderContextCairoRecorder::PushState() {
+        paintStack.push_back(paint);
+        RecordState([](RenderContextCairo& c) { c.PushState(); });
+    }
+
+    void RenderContextCairoRecorder::PopState() {
+        if (!paintStack.empty()) {
+            paint = paintStack.back();
+            paintStack.pop_back();
+        }
+        RecordState([](RenderContextCairo& c) { c.PopState(); });
+    }
+
+    void RenderContextCairoRecorder::ResetState() {
+        paint = PaintState();
+        paintStack.clear();
+        RecordState([](RenderContextCairo& c) { c.ResetState(); });
+    }
+
+    void RenderContextCairoRecorder::Translate(double x, double y) {
+        RecordState([x, y](RenderContextCairo& c) { c.Translate(x, y); });
+    }
+
+    void RenderContextCairoRecorder::Rotate(double angle) {
+        RecordState([angle](RenderContextCairo& c) { c.Rotate(angle); });
+    }
+
+    void RenderContextCairoRecorder::Scale(double sx, double sy) {
+        RecordState([sx, sy](RenderContextCairo& c) { c.Scale(sx, sy); });
+    }
+
+    void RenderContextCairoRecorder::SetTransform(double a, double b, double c, double d, double e, double f) {
+        RecordState([=](RenderContextCairo& ctx) { ctx.SetTransform(a, b, c, d, e, f); });
+    }
+
+    void RenderContextCairoRecorder::Transform(double a, double b, double c, double d, double e, double f) {
+        RecordState([=](RenderContextCairo& ctx) { ctx.Transform(a, b, c, d, e, f); });
+    }
+
+    void RenderContextCairoRecorder::ResetTransform() {
+        RecordState([](RenderContextCairo& c) { c.ResetTransform(); });
+    }
+
+    void RenderContextCairoRecorder::ClearClipRect() {
+        RecordState([](RenderContextCairo& c) { c.ClearClipRect(); });
+    }
+
+    void RenderContextCairoRecorder::ClipRect(const Rect2Dd& rect) {
+        RecordState([rect](RenderContextCairo& c) { c.ClipRect(rect); });
+    }
+
+    void RenderContextCairoRecorder::ClipPath() {
+        RecordState([](RenderContextCairo& c) { c.ClipPath(); });
+    }
+
+    void RenderContextCairoRecorder::ClipRoundedRectangle(const Rect2Dd& rect,
+                                                          double borderTopLeftRadius, double borderTopRightRadius,
+                                                          double borderBottomRightRadius, double borderBottomLeftRadius) {
+        RecordState([=](RenderContextCairo& c) {
+            c.ClipRoundedRectangle(rect, borderTopLeftRadius, borderTopRightRadius,
+                                   borderBottomRightRadius, borderBottomLeftRadius);
+        });
+    }
+
+    // ===== BASIC DRAWING =====
+    void RenderContextCairoRecorder::DrawLine(const Point2Dd& from, const Point2Dd& to) {
+        RecordDraw([from, to](RenderContextCairo& c) { c.DrawLine(from, to); },
+                   Effect::DrawClearsPath, paint.strokeSurface);
+    }
+
+    void RenderContextCairoRecorder::DrawRectangle(const Rect2Dd& rect) {
+        RecordDraw([rect](RenderContextCairo& c) { c.DrawRectangle(rect); },
+                   Effect::DrawClearsPath, paint.strokeSurface);
+    }
+
+    void RenderContextCairoRecorder::FillRectangle(const Rect2Dd& rect) {
+        RecordDraw([rect](RenderContextCairo& c) { c.FillRectangle(rect); },
+                   Effect::DrawClearsPath, paint.fillSurface);
+    }
+
+    void RenderContextCairoRecorder::DrawRoundedRectangle(const Rect2Dd& rect, double radius) {
+        RecordDraw([rect, radius](RenderContextCairo& c) { c.DrawRoundedRectangle(rect, radius); },
+                   Effect::DrawClearsPath, paint.strokeSurface);
+    }
+
+    void RenderContextCairoRecorder::FillRoundedRectangle(const Rect2Dd& rect, double radius) {
+        RecordDraw([rect, radius](RenderContextCairo& c) { c.FillRoundedRectangle(rect, radius); },
+                   Effect::DrawClearsPath, paint.fillSurface);
+    }
+
+    void RenderContextCairoRecorder::DrawRoundedRectangleWidthBorders(
+            const Rect2Dd& rect, bool fill,
+            double borderLeftWidth, double borderRightWidth,
+            double borderTopWidth, double borderBottomWidth,
+            const Color& borderLeftColor, const Color& borderRightColor,
+            const Color& borderTopColor, const Color& borderBottomColor,
+            double borderTopLeftRadius, double borderTopRightRadius,
+            double borderBottomRightRadius, double borderBottomLeftRadius,
+            const UCDashPattern& borderLeftPattern, const UCDashPattern& borderRightPattern,
+            const UCDashPattern& borderTopPattern, const UCDashPattern& borderBottomPattern) {
+        RecordDraw([=](RenderContextCairo& c) {
+            c.DrawRoundedRectangleWidthBorders(rect, fill,
+                                               borderLeftWidth, borderRightWidth, borderTopWidth, borderBottomWidth,
+                                               borderLeftColor, borderRightColor, borderTopColor, borderBottomColor,
+                                               borderTopLeftRadius, borderTopRightRadius,
+                                               borderBottomRightRadius, borderBottomLeftRadius,
+                                               borderLeftPattern, borderRightPattern,
+                                               borderTopPattern, borderBottomPattern);
+        }, Effect::DrawClearsPath, paint.AnySurface());
+    }
+
+    void RenderContextCairoRecorder::DrawCircle(const Point2Dd& center, double radius) {
+        RecordDraw([center, radius](RenderContextCairo& c) { c.DrawCircle(center, radius); },
+                   Effect::DrawClearsPath, paint.strokeSurface);
+    }
+
+    void RenderContextCairoRecorder::FillCircle(const Point2Dd& center, double radius) {
+        RecordDraw([center, radius](RenderContextCairo& c) { c.FillCircle(center, radius); },
+                   Effect::DrawClearsPath, paint.fillSurface);
+    }
+
+    void RenderContextCairoRecorder::DrawEllipse(const Rect2Dd& rect) {
+        RecordDraw([rect](RenderContextCairo& c) { c.DrawEllipse(rect); },
+                   Effect::DrawClearsPath, paint.strokeSurface);
+    }
+
+    void RenderContextCairoRecorder::FillEllipse(const Rect2Dd& rect) {
+        RecordDraw([rect](RenderContextCairo& c) { c.FillEllipse(rect); },
+                   Effect::DrawClearsPath, paint.fillSurface);
+    }
+
+    void RenderContextCairoRecorder::DrawArc(double x, double y, double radius, double startAngle, double endAngle) {
+        RecordDraw([=](RenderContextCairo& c) { c.DrawArc(x, y, radius, startAngle, endAngle); },
+                   Effect::DrawClearsPath, paint.strokeSurface);
+    }
+
+    void RenderContextCairoRecorder::FillArc(double x, double y, double radius, double startAngle, double endAngle) {
+        RecordDraw([=](RenderContextCairo& c) { c.FillArc(x, y, radius, startAngle, endAngle); },
+                   Effect::DrawClearsPath, paint.fillSurface);
+    }
+
+    void RenderContextCairoRecorder::DrawBezierCurve(const Point2Dd& start, const Point2Dd& cp1,
+                                                     const Point2Dd& cp2, const Point2Dd& end) {
+        RecordDraw([=](RenderContextCairo& c) { c.DrawBezierCurve(start, cp1, cp2, end); },
+                   Effect::DrawClearsPath, paint.strokeSurface);
+    }
+
+    void RenderContextCairoRecorder::DrawLinePath(const std::vector<Point2Dd>& points, bool closePath) {
+        if (points.empty()) return;
+        RecordDraw([points, closePath](RenderContextCairo& c) { c.DrawLinePath(points, closePath); },
+                   Effect::DrawClearsPath, paint.strokeSurface);
+    }
+
+    void RenderContextCairoRecorder::FillLinePath(const std::vector<Point2Dd>& points) {
+        if (points.empty()) return;
+        RecordDraw([points](RenderContextCairo& c) { c.FillLinePath(points); },
+                   Effect::DrawClearsPath, paint.fillSurface);
+    }
+
+    // ===== PATHS =====
+    void RenderContextCairoRecorder::ClearPath() {
+        RecordState([](RenderContextCairo& c) { c.ClearPath(); });
+    }
+
+    void RenderContextCairoRecorder::ClosePath() {
+        RecordState([](RenderContextCairo& c) { c.ClosePath(); });
+    }
+
+    void RenderContextCairoRecorder::MoveTo(double x, double y) {
+        RecordState([x, y](RenderContextCairo& c) { c.MoveTo(x, y); });
+    }
+
+    void RenderContextCairoRecorder::RelMoveTo(double x, double y) {
+        RecordState([x, y](RenderContextCairo& c) { c.RelMoveTo(x, y); });
+    }
+
+    void RenderContextCairoRecorder::LineTo(double x, double y) {
+        RecordState([x, y](RenderContextCairo& c) { c.LineTo(x, y); });
+    }
+
+    void RenderContextCairoRecorder::RelLineTo(double x, double y) {
+        RecordState([x, y](RenderContextCairo& c) { c.RelLineTo(x, y); });
+    }
+
+    void RenderContextCairoRecorder::QuadraticCurveTo(double cpx, double cpy, double x, double y) {
+        RecordState([=](RenderContextCairo& c) { c.QuadraticCurveTo(cpx, cpy, x, y); });
+    }
+
+    void RenderContextCairoRecorder::BezierCurveTo(double cp1x, double cp1y, double cp2x, double cp2y,
+                                                   double x, double y) {
+        RecordState([=](RenderContextCairo& c) { c.BezierCurveTo(cp1x, cp1y, cp2x, cp2y, x, y); });
+    }
+
+    void RenderContextCairoRecorder::RelBezierCurveTo(double cp1x, double cp1y, double cp2x, double cp2y,
+                                                      double x, double y) {
+        RecordState([=](RenderContextCairo& c) { c.RelBezierCurveTo(cp1x, cp1y, cp2x, cp2y, x, y); });
+    }
+
+    void RenderContextCairoRecorder::Arc(double cx, double cy, double radius, double startAngle, double endAngle) {
+        RecordState([=](RenderContextCairo& c) { c.Arc(cx, cy, radius, startAngle, endAngle); });
+    }
+
+    void RenderContextCairoRecorder::ArcTo(double x1, double y1, double x2, double y2, double radius) {
+        RecordState([=](RenderContextCairo& c) { c.ArcTo(x1, y1, x2, y2, radius); });
+    }
+
+    void RenderContextCairoRecorder::Circle(double x, double y, double radius) {
+        RecordState([=](RenderContextCairo& c) { c.Circle(x, y, radius); });
+    }
+
+    void RenderContextCairoRecorder::Ellipse(double cx, double cy, double rx, double ry, double rotation) {
+        RecordState([=](RenderContextCairo& c) { c.Ellipse(cx, cy, rx, ry, rotation); });
+    }
+
+    void RenderContextCairoRecorder::Rect(double x, double y, double width, double height) {
+        RecordState([=](RenderContextCairo& c) { c.Rect(x, y, width, height); });
+    }
+
+    void RenderContextCairoRecorder::RoundedRect(double x, double y, double width, double height, double radius) {
+        RecordState([=](RenderContextCairo& c) { c.RoundedRect(x, y, width, height, radius); });
+    }
+
+    void RenderContextCairoRecorder::FillPathPreserve() {
+        RecordDraw([](RenderContextCairo& c) { c.FillPathPreserve(); }, Effect::Draw, paint.fillSurface);
+    }
+
+    void RenderContextCairoRecorder::StrokePathPreserve() {
+        RecordDraw([](RenderContextCairo& c) { c.StrokePathPreserve(); }, Effect::Draw, paint.strokeSurface);
+    }
+
+    Rect2Dd RenderContextCairoRecorder::GetPathExtents() {
+        return shadow->GetPathExtents();
+    }
+
+    void RenderContextCairoRecorder::Fill() {
+        RecordDraw([](RenderContextCairo& c) { c.Fill(); }, Effect::DrawClearsPath, paint.fillSurface);
+    }
+
+    void RenderContextCairoRecorder::Stroke() {
+        RecordDraw([](RenderContextCairo& c) { c.Stroke(); }, Effect::DrawClearsPath, paint.strokeSurface);
+    }
+
+    // ===== PAINTS =====
+    std::shared_ptr<IPaintPattern> RenderContextCairoRecorder::CreateLinearGradientPattern(
+            double x1, double y1, double x2, double y2, const std::vector<GradientStop>& stops) {
+        return shadow->CreateLinearGradientPattern(x1, y1, x2, y2, stops);
+    }
+
+    std::shared_ptr<IPaintPattern> RenderContextCairoRecorder::CreateRadialGradientPattern(
+            double cx1, double cy1, double r1, double cx2, double cy2, double r2,
+            const std::vector<GradientStop>& stops) {
+        return shadow->CreateRadialGradientPattern(cx1, cy1, r1, cx2, cy2, r2, stops);
+    }
+
+    std::shared_ptr<IPaintPattern> RenderContextCairoRecorder::CreateImagePattern(
+            const std::string& imagePath, const Rect2Dd& anchorRect, ImageFitMode fitMode, bool repeat) {
+        return shadow->CreateImagePattern(imagePath, anchorRect, fitMode, repeat);
+    }
+
+    void RenderContextCairoRecorder::SetFillPaint(std::shared_ptr<IPaintPattern> pattern) {
+        paint.fillSurface = IsSurfacePattern(pattern);
+        RecordState([pattern](RenderContextCairo& c) { c.SetFillPaint(pattern); });
+    }
+
+    void RenderContextCairoRecorder::SetFillPaint(const Color& color) {
+        paint.fillSurface = false;
+        RecordState([color](RenderContextCairo& c) { c.SetFillPaint(color); });
+    }
+
+    void RenderContextCairoRecorder::SetStrokePaint(std::shared_ptr<IPaintPattern> pattern) {
+        paint.strokeSurface = IsSurfacePattern(pattern);
+        RecordState([pattern](RenderContextCairo& c) { c.SetStrokePaint(pattern); });
+    }
+
+    void RenderContextCairoRecorder::SetStrokePaint(const Color& color) {
+        paint.strokeSurface = false;
+        RecordState([color](RenderContextCairo& c) { c.SetStrokePaint(color); });
+    }
+
+    void RenderContextCairoRecorder::SetTextPaint(std::shared_ptr<IPaintPattern> pattern) {
+        paint.textSurface = IsSurfacePattern(pattern);
+        RecordState([pattern](RenderContextCairo& c) { c.SetTextPaint(pattern); });
+    }
+
+    void RenderContextCairoRecorder::SetTextPaint(const Color& color) {
+        paint.textSurface = false;
+        RecordState([color](RenderContextCairo& c) { c.SetTextPaint(color); });
+    }
+
+    void RenderContextCairoRecorder::SetCurrentPaint(const Color& color) {
+        paint.textSurface = false;
+        RecordState([color](RenderContextCairo& c) { c.SetCurrentPaint(color); });
+    }
+
+    void RenderContextCairoRecorder::SetCurrentPaint(std::shared_ptr<IPaintPattern> pattern) {
+        paint.textSurface = IsSurfacePattern(pattern);
+        RecordState([pattern](RenderContextCairo& c) { c.SetCurrentPaint(pattern); });
+    }
+
+    void RenderContextCairoRecorder::SetAlpha(double alpha) {
+        RecordState([alpha](RenderContextCairo& c) { c.SetAlpha(alpha); });
+    }
+
+    void RenderContextCairoRecorder::SetStrokeWidth(double width) {
+        RecordState([width](RenderContextCairo& c) { c.SetStrokeWidth(width); });
+    }
+
+    void RenderContextCairoRecorder::SetLineCap(LineCap cap) {
+        RecordState([cap](RenderContextCairo& c) { c.SetLineCap(cap); });
+    }
+
+    void RenderContextCairoRecorder::SetLineJoin(LineJoin join) {
+        RecordState([join](RenderContextCairo& c) { c.SetLineJoin(join); });
+    }
+
+    void RenderContextCairoRecorder::SetMiterLimit(double limit) {
+        RecordState([limit](RenderContextCairo& c) { c.SetMiterLimit(limit); });
+    }
+
+    void RenderContextCairoRecorder::SetLineDash(const UCDashPattern& pattern) {
+        RecordState([pattern](RenderContextCairo& c) { c.SetLineDash(pattern); });
+    }
+
+    // ===== TEXT =====
+    std::unique_ptr<ITextLayout> RenderContextCairoRecorder::CreateTextLayout(const std::string& text, bool isMarkup) {
+        return shadow->CreateTextLayout(text, isMarkup);
+    }
+
+    std::shared_ptr<ITextLayout> RenderContextCairoRecorder::GetOrCreateTextLayout(const std::string& text,
+                                                                                   const Size2Di& sz, bool isMarkup) {
+        return shadow->GetOrCreateTextLayout(text, sz, isMarkup);
+    }
+
+    void RenderContextCairoRecorder::DrawTextLayout(ITextLayout& layout, const Point2Dd& pos) {
+        auto* handle = static_cast<PangoLayout*>(layout.GetHandle());
+        if (!handle) return;
+        // By reference: the caller's ITextLayout may be gone by replay time,
+        // the PangoLayout is kept alive here.
+        std::shared_ptr<PangoLayout> retained(static_cast<PangoLayout*>(g_object_ref(handle)),
+                                              [](PangoLayout* l) { g_object_unref(l); });
+        const Point2Dd at(pos.x, pos.y + layout.GetLayoutVerticalOffset());
+        layouts.emplace_back(handle, pango_layout_get_serial(handle));
+        RecordDraw([retained, at](RenderContextCairo& c) { c.DrawPangoLayout(retained.get(), at); },
+                   Effect::DrawClearsPath, true);
+    }
+
+    void RenderContextCairoRecorder::SetFontFace(const std::string& family, FontWeight fw, FontSlant fs) {
+        RecordState([family, fw, fs](RenderContextCairo& c) { c.SetFontFace(family, fw, fs); });
+    }
+
+    void RenderContextCairoRecorder::SetFontFamily(const std::string& family) {
+        RecordState([family](RenderContextCairo& c) { c.SetFontFamily(family); });
+    }
+
+    void RenderContextCairoRecorder::SetFontSize(double size) {
+        RecordState([size](RenderContextCairo& c) { c.SetFontSize(size); });
+    }
+
+    void RenderContextCairoRecorder::SetFontWeight(FontWeight fw) {
+        RecordState([fw](RenderContextCairo& c) { c.SetFontWeight(fw); });
+    }
+
+    void RenderContextCairoRecorder::SetFontSlant(FontSlant fs) {
+        RecordState([fs](RenderContextCairo& c) { c.SetFontSlant(fs); });
+    }
+
+    void RenderContextCairoRecorder::SetTextLineHeight(double height) {
+        RecordState([height](RenderContextCairo& c) { c.SetTextLineHeight(height); });
+    }
+
+    void RenderContextCairoRecorder::SetTextWrap(TextWrap wrap) {
+        RecordState([wrap](RenderContextCairo& c) { c.SetTextWrap(wrap); });
+    }
+
+    void RenderContextCairoRecorder::SetTextStyle(const TextStyle& style) {
+        RecordState([style](RenderContextCairo& c) { c.SetTextStyle(style); });
+    }
+
+    void RenderContextCairoRecorder::SetTextAlignment(TextAlignment align) {
+        RecordState([align](RenderContextCairo& c) { c.SetTextAlignment(align); });
+    }
+
+    void RenderContextCairoRecorder::SetTextVerticalAlignment(VerticalAlignment align) {
+        RecordState([align](RenderContextCairo& c) { c.SetTextVerticalAlignment(align); });
+    }
+
+    void RenderContextCairoRecorder::SetTextIsMarkup(bool isMarkup) {
+        RecordState([isMarkup](RenderContextCairo& c) { c.SetTextIsMarkup(isMarkup); });
+    }
+
+    void RenderContextCairoRecorder::FillText(const std::string& text, double x, double y) {
+        RecordDraw([text, x, y](RenderContextCairo& c) { c.FillText(text, x, y); },
+                   Effect::DrawClearsPath, true);
+    }
+
+    void RenderContextCairoRecorder::StrokeText(const std::string& text, double x, double y) {
+        RecordDraw([text, x, y](RenderContextCairo& c) { c.StrokeText(text, x, y); },
+                   Effect::DrawClearsPath, true);
+    }
+
+    void RenderContextCairoRecorder::DrawText(const std::string& text, const Point2Dd& pos) {
+        if (text.empty()) return;
+        RecordDraw([text, pos](RenderContextCairo& c) { c.DrawText(text, pos); },
+                   Effect::DrawClearsPath, true);
+    }
+
+    void RenderContextCairoRecorder::DrawTextInRect(const std::string& text, const Rect2Dd& rect) {
+        DrawTextInRect(text, rect, false);
+    }
+
+    void RenderContextCairoRecorder::DrawTextInRect(const std::string& text, const Rect2Dd& rect, bool isMarkup) {
+        if (text.empty()) return;
+        RecordDraw([text, rect, isMarkup](RenderContextCairo& c) { c.DrawTextInRect(text, rect, isMarkup); },
+                   Effect::DrawClearsPath, true);
+    }
+
+    Size2Di RenderContextCairoRecorder::GetTextDimensions(const std::string& text, const Size2Di& explicitSize) {
+        return shadow->GetTextDimensions(text, explicitSize);
+    }
+
+    int RenderContextCairoRecorder::GetTextIndexForXY(const std::string& text, int x, int y, int w, int h) {
+        return shadow->GetTextIndexForXY(text, x, y, w, h);
+    }
+
+    // ===== IMAGES =====
+    void RenderContextCairoRecorder::DrawPartOfPixmap(UCPixmap& pixmap, const Rect2Dd& srcRect, const Rect2Dd& destRect) {
+        // Mirrors the target's bounds check: a rejected call draws nothing.
+        if (srcRect.x < 0 || srcRect.y < 0 ||
+            srcRect.x + srcRect.width > pixmap.GetWidth() ||
+            srcRect.y + srcRect.height > pixmap.GetHeight()) {
+            return;
+        }
+        auto retained = RetainPixmap(pixmap);
+        if (!retained) return;
+        RecordDraw([retained, srcRect, destRect](RenderContextCairo& c) {
+            c.DrawPartOfPixmap(*retained, srcRect, destRect);
+        }, Effect::DrawClearsPath, true);
+    }
+
+    void RenderContextCairoRecorder::DrawPixmap(UCPixmap& pixmap, const Rect2Dd& rect, ImageFitMode fitMode) {
+        auto retained = RetainPixmap(pixmap);
+        if (!retained) return;
+        RecordDraw([retained, rect, fitMode](RenderContextCairo& c) { c.DrawPixmap(*retained, rect, fitMode); },
+                   Effect::DrawClearsPath, true);
+    }
+
+    void RenderContextCairoRecorder::DrawMask(const Color& drawColor, UCPixmap& mask, const Rect2Dd& rect,
+                                              ImageFitMode fitMode) {
+        auto retained = RetainPixmap(mask);
+        if (!retained) return;
+        RecordDraw([drawColor, retained, rect, fitMode](RenderContextCairo& c) {
+            c.DrawMask(drawColor, *retained, rect, fitMode);
+        }, Effect::DrawClearsPath, true);
+    }
+
+    void RenderContextCairoRecorder::Clear(const Color& color) {
+        RecordDraw([color](RenderContextCairo& c) { c.Clear(color); }, Effect::Draw, false);
+    }
+
+    void* RenderContextCairoRecorder::GetNativeContext() {
+        replayable = false;
+        return shadow->GetNativeContext();
+    }
+
+} // namespace UltraCanvas
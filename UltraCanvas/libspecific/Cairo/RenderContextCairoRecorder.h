@@ -0,0 +1,280 @@
+// libspecific/Cairo/RenderContextCairoRecorder.h
+// Display-list recording and tiled parallel replay for the Cairo backend
+// Version: 1.0.0
+// Last Modified: 2026-10-18
+// Author: UltraCanvas Framework
+#pragma once
+
+#ifndef ULTRACANVAS_RENDER_CONTEXT_CAIRO_RECORDER_H
+#define ULTRACANVAS_RENDER_CONTEXT_CAIRO_RECORDER_H
+
+#include "RenderContextCairo.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace UltraCanvas {
+
+    // ===== TILE WORKERS =====
+    // Fork-join pool: Run(n, fn) calls fn(0..n-1) spread over the workers and
+    // the calling thread, and returns once every call has finished.
+    class CairoTileWorkers {
+    public:
+        explicit CairoTileWorkers(int threads);
+        ~CairoTileWorkers();
+
+        void Run(int count, const std::function<void(int)>& fn);
+        int GetThreadCount() const { return static_cast<int>(workers.size()) + 1; }
+
+    private:
+        void WorkerMain();
+        void Drain();
+
+        std::vector<std::thread> workers;
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::condition_variable done;
+        const std::function<void(int)>* job = nullptr;
+        int jobCount = 0;
+        std::atomic<int> nextIndex{0};
+        int busy = 0;
+        uint64_t generation = 0;
+        bool stopping = false;
+    };
+
+    // ===== DISPLAY LIST RECORDER =====
+    // The context handed out by RenderContextCairo::BeginDisplayList. Every
+    // drawing call is appended to a list of closures over RenderContextCairo;
+    // state, transform, clip and path calls are also applied to a "shadow"
+    // context over the target's own pixels that never receives any drawing,
+    // so queries (text metrics, path extents, the current clip) answer exactly
+    // as they would on the target.
+    //
+    // Rasterize replays the list once per screen tile, each tile rendering
+    // through its own cairo context into its slice of the target's image
+    // memory. Tiles are disjoint and start on whole device pixels, so the
+    // result is the serial raster, pixel for pixel. Commands that touch
+    // process-wide state — Pango and the shared text layout cache, and any
+    // source surface (pixmaps, image patterns, layers), whose pixman images
+    // are not reference-counted atomically — replay under one lock; the rest
+    // run concurrently. A drawing command is skipped in tiles outside the clip
+    // it was recorded under.
+    //
+    // UI thread only, apart from the replay workers it owns.
+    class RenderContextCairoRecorder : public IRenderContext {
+    public:
+        explicit RenderContextCairoRecorder(RenderContextCairo& target);
+        ~RenderContextCairoRecorder() override;
+
+        // Start a recording for the target's current surface.
+        bool Begin();
+        // Replay into the target over `regions` (logical) and drop the
+        // recording. False, with nothing drawn, when the recording can't be
+        // replayed faithfully.
+        bool Rasterize(const std::vector<Rect2Di>& regions, int threads);
+
+        size_t GetCommandCount() const { return commands.size(); }
+
+        // ===== IRenderContext =====
+        bool CreateSurface(const Size2Di& sz, NativeSurfacePtr similarToSurface) override;
+        bool ResizeSurface(const Size2Di& sz) override;
+        Size2Di GetSurfaceSize() const override { return target.GetSurfaceSize(); }
+        void FlushToSurface(NativeSurfacePtr flushToSurface, const Point2Dd& pos) override;
+        void CompositeToSurface(NativeSurfacePtr flushToSurface, const Point2Dd& pos) override;
+        void FlushRegionToSurface(NativeSurfacePtr flushToSurface,
+                                  const Rect2Dd& region, const Point2Dd& destPos) override;
+        float GetDeviceScale() const override { return target.GetDeviceScale(); }
+        NativeSurfacePtr GetNativeSurface() const override { return target.GetNativeSurface(); }
+        bool DrawContextSurface(IRenderContext& source, const Point2Dd& pos) override;
+
+        void PushState() override;
+        void PopState() override;
+        void ResetState() override;
+
+        void Translate(double x, double y) override;
+        void Rotate(double angle) override;
+        void Scale(double sx, double sy) override;
+        void SetTransform(double a, double b, double c, double d, double e, double f) override;
+        void Transform(double a, double b, double c, double d, double e, double f) override;
+        void ResetTransform() override;
+
+        void ClearClipRect() override;
+        void ClipRect(const Rect2Dd& rect) override;
+        void ClipPath() override;
+        void ClipRoundedRectangle(const Rect2Dd& rect,
+                                  double borderTopLeftRadius, double borderTopRightRadius,
+                                  double borderBottomRightRadius, double borderBottomLeftRadius) override;
+
+        void DrawLine(const Point2Dd& from, const Point2Dd& to) override;
+        void DrawRectangle(const Rect2Dd& rect) override;
+        void FillRectangle(const Rect2Dd& rect) override;
+        void DrawRoundedRectangle(const Rect2Dd& rect, double radius) override;
+        void FillRoundedRectangle(const Rect2Dd& rect, double radius) override;
+        void DrawRoundedRectangleWidthBorders(const Rect2Dd& rect,
+                                              bool fill,
+                                              double borderLeftWidth, double borderRightWidth,
+                                              double borderTopWidth, double borderBottomWidth,
+                                              const Color& borderLeftColor, const Color& borderRightColor,
+                                              const Color& borderTopColor, const Color& borderBottomColor,
+                                              double borderTopLeftRadius, double borderTopRightRadius,
+                                              double borderBottomRightRadius, double borderBottomLeftRadius,
+                                              const UCDashPattern& borderLeftPattern,
+                                              const UCDashPattern& borderRightPattern,
+                                              const UCDashPattern& borderTopPattern,
+                                              const UCDashPattern& borderBottomPattern) override;
+        void DrawCircle(const Point2Dd& center, double radius) override;
+        void FillCircle(const Point2Dd& center, double radius) override;
+        void DrawEllipse(const Rect2Dd& rect) override;
+        void FillEllipse(const Rect2Dd& rect) override;
+        void DrawArc(double x, double y, double radius, double startAngle, double endAngle) override;
+        void FillArc(double x, double y, double radius, double startAngle, double endAngle) override;
+        void DrawBezierCurve(const Point2Dd& start, const Point2Dd& cp1, const Point2Dd& cp2, const Point2Dd& end) override;
+        void DrawLinePath(const std::vector<Point2Dd>& points, bool closePath) override;
+        void FillLinePath(const std::vector<Point2Dd>& points) override;
+
+        void ClearPath() override;
+        void ClosePath() override;
+        void MoveTo(double x, double y) override;
+        void RelMoveTo(double x, double y) override;
+        void LineTo(double x, double y) override;
+        void RelLineTo(double x, double y) override;
+        void QuadraticCurveTo(double cpx, double cpy, double x, double y) override;
+        void BezierCurveTo(double cp1x, double cp1y, double cp2x, double cp2y, double x, double y) override;
+        void RelBezierCurveTo(double cp1x, double cp1y, double cp2x, double cp2y, double x, double y) override;
+        void Arc(double cx, double cy, double radius, double startAngle, double endAngle) override;
+        void ArcTo(double x1, double y1, double x2, double y2, double radius) override;
+        void Circle(double x, double y, double radius) override;
+        void Ellipse(double cx, double cy, double rx, double ry, double rotation) override;
+        void Rect(double x, double y, double width, double height) override;
+        void RoundedRect(double x, double y, double width, double height, double radius) override;
+
+        void FillPathPreserve() override;
+        void StrokePathPreserve() override;
+        Rect2Dd GetPathExtents() override;
+
+        std::shared_ptr<IPaintPattern> CreateLinearGradientPattern(double x1, double y1, double x2, double y2,
+                                                                   const std::vector<GradientStop>& stops) override;
+        std::shared_ptr<IPaintPattern> CreateRadialGradientPattern(double cx1, double cy1, double r1,
+                                                                   double cx2, double cy2, double r2,
+                                                                   const std::vector<GradientStop>& stops) override;
+        std::shared_ptr<IPaintPattern> CreateImagePattern(const std::string& imagePath,
+                                                          const Rect2Dd& anchorRect,
+                                                          ImageFitMode fitMode,
+                                                          bool repeat) override;
+        void SetFillPaint(std::shared_ptr<IPaintPattern> pattern) override;
+        void SetFillPaint(const Color& color) override;
+        void SetStrokePaint(std::shared_ptr<IPaintPattern> pattern) override;
+        void SetStrokePaint(const Color& color) override;
+        void SetTextPaint(std::shared_ptr<IPaintPattern> pattern) override;
+        void SetTextPaint(const Color& color) override;
+        void SetCurrentPaint(const Color& color) override;
+        void SetCurrentPaint(std::shared_ptr<IPaintPattern> pattern) override;
+
+        void Fill() override;
+        void Stroke() override;
+
+        void SetAlpha(double alpha) override;
+        double GetAlpha() const override { return shadow ? shadow->GetAlpha() : 1.0; }
+
+        void SetStrokeWidth(double width) override;
+        void SetLineCap(LineCap cap) override;
+        void SetLineJoin(LineJoin join) override;
+        void SetMiterLimit(double limit) override;
+        void SetLineDash(const UCDashPattern& pattern) override;
+
+        std::unique_ptr<ITextLayout> CreateTextLayout(const std::string& text, bool isMarkup) override;
+        std::shared_ptr<ITextLayout> GetOrCreateTextLayout(const std::string& text, const Size2Di& sz, bool isMarkup) override;
+        void DrawTextLayout(ITextLayout& layout, const Point2Dd& pos) override;
+
+        void SetFontFace(const std::string& family, FontWeight fw, FontSlant fs) override;
+        void SetFontFamily(const std::string& family) override;
+        void SetFontSize(double size) override;
+        void SetFontWeight(FontWeight fw) override;
+        void SetFontSlant(FontSlant fs) override;
+        void SetTextLineHeight(double height) override;
+        void SetTextWrap(TextWrap wrap) override;
+        const TextStyle& GetTextStyle() const override { return shadow->GetTextStyle(); }
+        void SetTextStyle(const TextStyle& style) override;
+        void SetTextAlignment(TextAlignment align) override;
+        void SetTextVerticalAlignment(VerticalAlignment align) override;
+        void SetTextIsMarkup(bool isMarkup) override;
+
+        void FillText(const std::string& text, double x, double y) override;
+        void StrokeText(const std::string& text, double x, double y) override;
+        void DrawText(const std::string& text, const Point2Dd& pos) override;
+        void DrawTextInRect(const std::string& text, const Rect2Dd& rect) override;
+        void DrawTextInRect(const std::string& text, const Rect2Dd& rect, bool isMarkup) override;
+        Size2Di GetTextDimensions(const std::string& text, const Size2Di& explicitSize) override;
+        int GetTextIndexForXY(const std::string& text, int x, int y, int w = 0, int h = 0) override;
+
+        void DrawPartOfPixmap(UCPixmap& pixmap, const Rect2Dd& srcRect, const Rect2Dd& destRect) override;
+        void DrawPixmap(UCPixmap& pixmap, const Rect2Dd& rect, ImageFitMode fitMode) override;
+        void DrawMask(const Color& drawColor, UCPixmap& mask, const Rect2Dd& rect, ImageFitMode fitMode) override;
+
+        void Clear(const Color& color) override;
+
+        // Raw cairo drawing can't be recorded: the frame falls back to direct
+        // rendering.
+        void* GetNativeContext() override;
+
+    private:
+        using Op = std::function<void(RenderContextCairo&)>;
+
+        enum class Effect : uint8_t {
+            State,          // replayed in every tile
+            Draw,           // may be skipped outside its clip; leaves the path as is
+            DrawClearsPath  // may be skipped; its only lasting effect is an empty path
+        };
+
+        struct Command {
+            Op op;
+            Rect2Di bounds;         // device px the command can touch (Draw effects)
+            Effect effect = Effect::State;
+            bool serial = false;    // replayed under the shared lock
+        };
+
+        // Source paints, tracked so commands that sample a surface replay
+        // under the lock.
+        struct PaintState {
+            bool fillSurface = false;
+            bool strokeSurface = false;
+            bool textSurface = false;
+            bool AnySurface() const { return fillSurface || strokeSurface || textSurface; }
+        };
+
+        void RecordState(Op op);
+        void RecordDraw(Op op, Effect effect, bool serial);
+        Rect2Di CurrentClipBounds() const;
+        static bool IsSurfacePattern(const std::shared_ptr<IPaintPattern>& pattern);
+        static std::shared_ptr<UCPixmap> RetainPixmap(UCPixmap& pixmap);
+        void PrepareTiles(const std::vector<Rect2Di>& tiles);
+        void Discard();
+
+        RenderContextCairo& target;
+        std::unique_ptr<RenderContextCairo> shadow;
+        cairo_surface_t* shadowOwner = nullptr;     // target surface the shadow aliases
+
+        std::vector<Command> commands;
+        // Pango layouts drawn by reference, with their serial at record time;
+        // a layout changed after it was drawn invalidates the recording.
+        std::vector<std::pair<PangoLayout*, guint>> layouts;
+        PaintState paint;
+        std::vector<PaintState> paintStack;
+        bool replayable = true;
+
+        std::unique_ptr<CairoTileWorkers> workers;
+        // One context per grid cell (keyed by its origin), bound to the
+        // target's pixel memory; dropped when the target surface changes.
+        std::unordered_map<uint64_t, std::unique_ptr<RenderContextCairo>> tileContexts;
+        cairo_surface_t* tileSurfaceOwner = nullptr;    // referenced
+    };
+
+} // namespace UltraCanvas
+
+#endif // ULTRACANVAS_RENDER_CONTEXT_CAIRO_RECORDER_H